@@ -0,0 +1,263 @@
+#[macro_use]
+extern crate criterion;
+
+#[macro_use]
+extern crate serde_json;
+
+extern crate base64;
+
+extern crate indystrgpostgres;
+
+use std::env;
+use std::ffi::CString;
+use std::thread;
+
+use criterion::{Benchmark, Criterion};
+
+use indystrgpostgres::PostgresWallet;
+use indystrgpostgres::libindy::ErrorCode;
+use indystrgpostgres::wql::storage::{EncryptedValue, ENCRYPTED_KEY_LEN};
+
+// Benchmarks need the local Postgres used by unit tests (see README.md).
+// Wallet scheme is chosen with WALLET_SCHEME variable the same way as for tests.
+
+fn _config() -> CString {
+    let config = match env::var("WALLET_SCHEME") {
+        Ok(ref scheme) if scheme == "MultiWalletSingleTable" => json!({
+            "url": "localhost:5432",
+            "wallet_scheme": "MultiWalletSingleTable",
+            "database_name": "multi_wallet_db"
+        }),
+        Ok(ref scheme) if scheme == "MultiWalletSingleTableSharedPool" => json!({
+            "url": "localhost:5432",
+            "wallet_scheme": "MultiWalletSingleTableSharedPool"
+        }),
+        _ => json!({
+            "url": "localhost:5432"
+        })
+    };
+
+    CString::new(config.to_string()).unwrap()
+}
+
+fn _credentials() -> CString {
+    CString::new(json!({
+        "account": "postgres",
+        "password": "mysecretpassword",
+        "admin_account": "postgres",
+        "admin_password": "mysecretpassword"
+    }).to_string()).unwrap()
+}
+
+fn _metadata() -> CString {
+    CString::new(vec![1u8; 64]).unwrap()
+}
+
+fn _type() -> CString {
+    CString::new("bench_type").unwrap()
+}
+
+fn _value() -> Vec<u8> {
+    EncryptedValue::new(vec![1, 2, 3, 4, 5, 6, 7, 8], vec![9; ENCRYPTED_KEY_LEN]).to_bytes()
+}
+
+fn _fetch_options() -> CString {
+    CString::new(json!({
+        "retrieveType": true,
+        "retrieveValue": true,
+        "retrieveTags": true,
+    }).to_string()).unwrap()
+}
+
+fn _init() {
+    let err = PostgresWallet::init(_config().as_ptr(), _credentials().as_ptr());
+    assert_eq!(err, ErrorCode::Success);
+}
+
+fn _create_and_open_wallet(id: &str) -> i32 {
+    let id = CString::new(id).unwrap();
+    let (config, credentials) = (_config(), _credentials());
+
+    let _ = PostgresWallet::delete(id.as_ptr(), config.as_ptr(), credentials.as_ptr());
+
+    let err = PostgresWallet::create(id.as_ptr(), config.as_ptr(), credentials.as_ptr(), _metadata().as_ptr());
+    assert_eq!(err, ErrorCode::Success);
+
+    let mut handle: i32 = -1;
+    let err = PostgresWallet::open(id.as_ptr(), config.as_ptr(), credentials.as_ptr(), &mut handle);
+    assert_eq!(err, ErrorCode::Success);
+
+    handle
+}
+
+fn _close_and_delete_wallet(id: &str, handle: i32) {
+    let id = CString::new(id).unwrap();
+
+    let err = PostgresWallet::close(handle);
+    assert_eq!(err, ErrorCode::Success);
+
+    let err = PostgresWallet::delete(id.as_ptr(), _config().as_ptr(), _credentials().as_ptr());
+    assert_eq!(err, ErrorCode::Success);
+}
+
+mod concurrent_wallets {
+    use super::*;
+
+    pub const WALLETS_COUNT: usize = 16;
+    pub const RECORDS_COUNT: usize = 100;
+
+    fn _id(i: usize) -> String {
+        format!("bench_concurrent_{}", i)
+    }
+
+    // Every wallet is used by its own thread, so operations of different wallets overlap
+    fn add_and_get_records(handles: &[i32], round: usize) {
+        let threads: Vec<thread::JoinHandle<()>> = handles.iter().map(|&handle| {
+            thread::spawn(move || {
+                let type_ = _type();
+                let value = _value();
+                let tags = CString::new("{}").unwrap();
+                let options = _fetch_options();
+
+                for i in 0..RECORDS_COUNT {
+                    let id = CString::new(format!("id_{}_{}", round, i)).unwrap();
+
+                    let err = PostgresWallet::add_record(handle, type_.as_ptr(), id.as_ptr(), value.as_ptr(), value.len(), tags.as_ptr());
+                    assert_eq!(err, ErrorCode::Success);
+
+                    let mut record_handle: i32 = -1;
+                    let err = PostgresWallet::get_record(handle, type_.as_ptr(), id.as_ptr(), options.as_ptr(), &mut record_handle);
+                    assert_eq!(err, ErrorCode::Success);
+
+                    let err = PostgresWallet::free_record(handle, record_handle);
+                    assert_eq!(err, ErrorCode::Success);
+                }
+            })
+        }).collect();
+
+        for thread in threads {
+            thread.join().unwrap();
+        }
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        _init();
+
+        let handles: Vec<i32> = (0..WALLETS_COUNT).map(|i| _create_and_open_wallet(&_id(i))).collect();
+
+        let bench_handles = handles.clone();
+        let mut round = 0;
+
+        c.bench(
+            "postgres_concurrent_wallets",
+            Benchmark::new("add_and_get_records_16_wallets", move |b|
+                b.iter(|| {
+                    round += 1;
+                    add_and_get_records(&bench_handles, round)
+                }))
+                .sample_size(10));
+
+        for (i, handle) in handles.into_iter().enumerate() {
+            _close_and_delete_wallet(&_id(i), handle);
+        }
+    }
+}
+
+mod search_first_record {
+    use super::*;
+
+    pub const RECORDS_COUNT: usize = 10_000;
+
+    const WALLET_ID: &str = "bench_search_first_record";
+
+    // Time to the first record doesn't depend on the wallet size as rows are read through a cursor
+    fn search_and_fetch_first_record(handle: i32) {
+        let mut search_handle: i32 = -1;
+        let err = PostgresWallet::search_all_records(handle, &mut search_handle);
+        assert_eq!(err, ErrorCode::Success);
+
+        let mut record_handle: i32 = -1;
+        let err = PostgresWallet::fetch_search_next_record(handle, search_handle, &mut record_handle);
+        assert_eq!(err, ErrorCode::Success);
+
+        let err = PostgresWallet::free_search(handle, search_handle);
+        assert_eq!(err, ErrorCode::Success);
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        _init();
+
+        let handle = _create_and_open_wallet(WALLET_ID);
+
+        let type_ = _type();
+        let value = _value();
+        let tags = CString::new("{}").unwrap();
+
+        for i in 0..RECORDS_COUNT {
+            let id = CString::new(format!("id_{}", i)).unwrap();
+            let err = PostgresWallet::add_record(handle, type_.as_ptr(), id.as_ptr(), value.as_ptr(), value.len(), tags.as_ptr());
+            assert_eq!(err, ErrorCode::Success);
+        }
+
+        c.bench(
+            "postgres_search",
+            Benchmark::new("search_and_fetch_first_of_10000_records", move |b|
+                b.iter(|| search_and_fetch_first_record(handle)))
+                .sample_size(10));
+
+        _close_and_delete_wallet(WALLET_ID, handle);
+    }
+}
+
+mod bulk_load {
+    use super::*;
+
+    pub const RECORDS_COUNT: usize = 1_000_000;
+    // the same batch size as wallet import uses
+    pub const BATCH_SIZE: usize = 1000;
+
+    const WALLET_ID: &str = "bench_bulk_load";
+
+    fn _records_json(round: usize, batch: usize) -> CString {
+        let value = base64::encode(&_value());
+        // base64 encoded names of an encrypted and a plain tag
+        let tags = json!({"dGFnX25hbWVfMQ==": "dGFnX3ZhbHVlXzE=", "~dGFnX25hbWVfMg==": "tag_value_2"});
+
+        let records: Vec<serde_json::Value> = (batch * BATCH_SIZE..(batch + 1) * BATCH_SIZE)
+            .map(|i| json!({"type": "YmVuY2hfdHlwZQ==", "id": format!("id_{}_{}", round, i), "value": value, "tags": tags}))
+            .collect();
+
+        CString::new(serde_json::to_string(&records).unwrap()).unwrap()
+    }
+
+    // Loads records in batches through add_records as wallet import does
+    fn add_records(handle: i32, round: usize) {
+        for batch in 0..RECORDS_COUNT / BATCH_SIZE {
+            let records = _records_json(round, batch);
+            let err = PostgresWallet::add_records(handle, records.as_ptr());
+            assert_eq!(err, ErrorCode::Success);
+        }
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        _init();
+
+        let handle = _create_and_open_wallet(WALLET_ID);
+
+        let mut round = 0;
+
+        c.bench(
+            "postgres_bulk_load",
+            Benchmark::new("add_records_1m_records", move |b|
+                b.iter(|| {
+                    round += 1;
+                    add_records(handle, round)
+                }))
+                .sample_size(10));
+
+        _close_and_delete_wallet(WALLET_ID, handle);
+    }
+}
+
+criterion_group!(benches, concurrent_wallets::bench, search_first_record::bench, bulk_load::bench);
+criterion_main!(benches);
@@ -46,7 +46,7 @@ use self::libc::c_char;
 
 use std::collections::HashMap;
 use std::ffi::CString;
-use std::sync::Mutex;
+use std::sync::{Arc, Mutex, RwLock};
 use std::str;
 
 pub static POSTGRES_STORAGE_NAME: &str = "postgres_storage";
@@ -60,7 +60,7 @@ pub extern fn postgresstorage_init() -> libindy::ErrorCode {
         return err;
     }
 
-    libindy::wallet::register_wallet_storage(
+    let err = libindy::wallet::register_wallet_storage(
         postgres_storage_name.as_ptr(),
         PostgresWallet::create,
         PostgresWallet::open,
@@ -86,6 +86,24 @@ pub extern fn postgresstorage_init() -> libindy::ErrorCode {
         PostgresWallet::get_search_total_count,
         PostgresWallet::fetch_search_next_record,
         PostgresWallet::free_search,
+    );
+
+    if err != ErrorCode::Success {
+        return err;
+    }
+
+    let err = libindy::wallet::register_wallet_storage_add_records(
+        postgres_storage_name.as_ptr(),
+        PostgresWallet::add_records,
+    );
+
+    if err != ErrorCode::Success {
+        return err;
+    }
+
+    libindy::wallet::register_wallet_storage_delete_records(
+        postgres_storage_name.as_ptr(),
+        PostgresWallet::delete_records,
     )
 }
 
@@ -100,7 +118,10 @@ struct PostgresStorageContext {
     id: String,          // wallet name
     _config: String,      // wallet config
     _credentials: String, // wallet credentials
-    phandle: Box<::postgres_storage::PostgresStorage>  // reference to a postgres database connection
+    phandle: Box<::postgres_storage::PostgresStorage>,  // reference to a postgres database connection
+    metadatas: Mutex<HashMap<i32, CString>>,  // metadata fetched from the wallet
+    records: Mutex<HashMap<i32, PostgresWalletRecord>>,  // cache of fetched records
+    searches: Mutex<HashMap<i32, Arc<PostgresWalletSearch>>>  // active searches
 }
 
 #[derive(Debug, Clone)]
@@ -111,33 +132,25 @@ struct PostgresWalletRecord {
     tags: CString
 }
 
-#[derive(Debug, Clone)]
-struct PostgresWalletRecordSet {
-    idx: usize,
-    records: Vec<PostgresWalletRecord>,
+// records are read from the database as fetch_search_next_record is called
+struct PostgresWalletSearch {
+    iter: Mutex<Box<dyn StorageIterator>>,
     count: usize
 }
 
 lazy_static! {
-    // store a PostgresStorage object (contains a connection) 
-    static ref POSTGRES_OPEN_WALLETS: Mutex<HashMap<i32, PostgresStorageContext>> = Default::default();
+    // store a PostgresStorage object (contains a connection pool) for every open wallet.
+    // The lock is only held to look up or change the set of open wallets, never while talking to the database,
+    // so different wallets (and different calls to the same wallet) run concurrently on their pools.
+    static ref POSTGRES_OPEN_WALLETS: RwLock<HashMap<i32, Arc<PostgresStorageContext>>> = Default::default();
 }
 
-lazy_static! {
-    // metadata for active wallets
-    static ref POSTGRES_ACTIVE_METADATAS: Mutex<HashMap<i32, CString>> = Default::default();
+fn _wallet_context(xhandle: i32) -> Option<Arc<PostgresStorageContext>> {
+    POSTGRES_OPEN_WALLETS.read().unwrap().get(&xhandle).cloned()
 }
 
-lazy_static! {
-    // cache of Postgres fetched records
-    static ref POSTGRES_ACTIVE_RECORDS: Mutex<HashMap<i32, PostgresWalletRecord>> = Default::default();
-}
-
-lazy_static! {
-    // cache of active Postgres searches
-    // TODO figure out  athread-safe PostgresStorageIterator
-    // static ref POSTGRES_ACTIVE_SEARCHES: Mutex<HashMap<i32, Box<::postgres_storage::PostgresStorageIterator>>> = Default::default();
-    static ref POSTGRES_ACTIVE_SEARCHES: Mutex<HashMap<i32, PostgresWalletRecordSet>> = Default::default();
+fn _is_wallet_open(id: &str) -> bool {
+    POSTGRES_OPEN_WALLETS.read().unwrap().values().any(|context| context.id == id)
 }
 
 pub struct PostgresWallet {}
@@ -206,13 +219,10 @@ impl PostgresWallet {
 
         // open wallet and return handle
         // PostgresStorageType::open_storage(), returns a PostgresStorage that goes into the handle
-        let mut handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
 
         // check if we have opened this wallet already
-        for (_key, value) in &*handles {
-            if value.id == id {
-                return ErrorCode::WalletAlreadyOpenedError;
-            }
+        if _is_wallet_open(&id) {
+            return ErrorCode::WalletAlreadyOpenedError;
         }
 
         // open the wallet
@@ -226,17 +236,27 @@ impl PostgresWallet {
         // get a handle (to use to identify wallet for subsequent calls)
         let xhandle = SequenceUtils::get_next_id();
 
+        // storage was opened without holding the lock, so check again that the same wallet wasn't opened meanwhile
+        let mut handles = POSTGRES_OPEN_WALLETS.write().unwrap();
+
+        if handles.values().any(|context| context.id == id) {
+            return ErrorCode::WalletAlreadyOpenedError;
+        }
+
         // create a storage context (keep all info in case we need to recycle wallet connection)
         let context = PostgresStorageContext {
             _xhandle: xhandle,      // reference returned to client to track open wallet connection
             id,           // wallet name
             _config: config,       // wallet config
             _credentials: credentials,  // wallet credentials
-            phandle       // reference to a postgres database connection
+            phandle,       // reference to a postgres database connection
+            metadatas: Default::default(),
+            records: Default::default(),
+            searches: Default::default()
         };
 
         // add to our open wallet list
-        handles.insert(xhandle, context);
+        handles.insert(xhandle, Arc::new(context));
 
         // return handle = index into our collection of open wallets
         unsafe { *handle = xhandle };
@@ -255,16 +275,14 @@ impl PostgresWallet {
         check_useful_c_byte_array!(value, value_len, ErrorCode::CommonInvalidState, ErrorCode::CommonInvalidState);
         check_useful_c_str!(tags_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         let value = EncryptedValue::from_bytes(&value).unwrap();
         let tags = _tags_from_json(&tags_json).unwrap();
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -285,6 +303,43 @@ impl PostgresWallet {
     }
 
 
+    pub extern fn add_records(xhandle: i32,
+                                  records_json: *const c_char) -> ErrorCode {
+        check_useful_c_str!(records_json, ErrorCode::CommonInvalidState);
+
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
+
+        let records = match _records_from_json(&records_json) {
+            Ok(records) => records,
+            Err(err) => {
+                error!("Error parsing records to add. Error details: {:?}", err);
+                return ErrorCode::CommonInvalidState;
+            }
+        };
+
+        let wallet_box = &wallet_context.phandle;
+        let storage = &*wallet_box;
+
+        let res = storage.add_records(&records);
+
+        match res {
+            Ok(_) => ErrorCode::Success,
+            Err(err) => {
+                match err {
+                    WalletStorageError::ItemAlreadyExists => ErrorCode::WalletItemAlreadyExists,
+                    _ => {
+                        error!("Error adding records. Error details: {:?}", err);
+                        ErrorCode::WalletStorageError
+                    }
+                }
+            }
+        }
+    }
+
+
     pub extern fn update_record_value(xhandle: i32,
                                           type_: *const c_char,
                                           id: *const c_char,
@@ -294,15 +349,13 @@ impl PostgresWallet {
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
         check_useful_c_byte_array!(joined_value, joined_value_len, ErrorCode::CommonInvalidState, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         let value = EncryptedValue::from_bytes(&joined_value).unwrap();
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -332,13 +385,11 @@ impl PostgresWallet {
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
         check_useful_c_str!(options_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -349,7 +400,7 @@ impl PostgresWallet {
                 let record_handle = SequenceUtils::get_next_id();
                 let p_rec = _storagerecord_to_postgresrecord(&record).unwrap();
 
-                let mut handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+                let mut handles = wallet_context.records.lock().unwrap();
                 handles.insert(record_handle, p_rec);
 
                 unsafe { *handle = record_handle };
@@ -371,13 +422,12 @@ impl PostgresWallet {
     pub extern fn get_record_id(xhandle: i32,
                                     record_handle: i32,
                                     id_ptr: *mut *const c_char) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+        let handles = wallet_context.records.lock().unwrap();
 
         if !handles.contains_key(&record_handle) {
             return ErrorCode::CommonInvalidState;
@@ -394,13 +444,12 @@ impl PostgresWallet {
     pub extern fn get_record_type(xhandle: i32,
                                       record_handle: i32,
                                       type_ptr: *mut *const c_char) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+        let handles = wallet_context.records.lock().unwrap();
 
         if !handles.contains_key(&record_handle) {
             return ErrorCode::CommonInvalidState;
@@ -418,13 +467,12 @@ impl PostgresWallet {
                                        record_handle: i32,
                                        value_ptr: *mut *const u8,
                                        value_len: *mut usize) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+        let handles = wallet_context.records.lock().unwrap();
 
         if !handles.contains_key(&record_handle) {
             return ErrorCode::CommonInvalidState;
@@ -442,13 +490,12 @@ impl PostgresWallet {
     pub extern fn get_record_tags(xhandle: i32,
                                       record_handle: i32,
                                       tags_json_ptr: *mut *const c_char) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+        let handles = wallet_context.records.lock().unwrap();
 
         if !handles.contains_key(&record_handle) {
             return ErrorCode::CommonInvalidState;
@@ -464,13 +511,12 @@ impl PostgresWallet {
 
 
     pub extern fn free_record(xhandle: i32, record_handle: i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let mut handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
+        let mut handles = wallet_context.records.lock().unwrap();
 
         if !handles.contains_key(&record_handle) {
             return ErrorCode::CommonInvalidState;
@@ -489,15 +535,13 @@ impl PostgresWallet {
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
         check_useful_c_str!(tags_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         let tags = _tags_from_json(&tags_json).unwrap();
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -526,15 +570,13 @@ impl PostgresWallet {
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
         check_useful_c_str!(tags_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         let tags = _tags_from_json(&tags_json).unwrap();
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -563,16 +605,14 @@ impl PostgresWallet {
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
         check_useful_c_str!(tag_names_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         // convert to [TagName]
         let tag_names = _tag_names_from_json(&tag_names_json).unwrap();
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -599,13 +639,11 @@ impl PostgresWallet {
         check_useful_c_str!(type_, ErrorCode::CommonInvalidState);
         check_useful_c_str!(id, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -626,14 +664,50 @@ impl PostgresWallet {
     }
 
 
-    pub extern fn get_storage_metadata(xhandle: i32, metadata_ptr: *mut *const c_char, metadata_handle: *mut i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
+    pub extern fn delete_records(xhandle: i32,
+                                     type_: *const c_char,
+                                     query_json: *const c_char,
+                                     deleted_count: *mut usize) -> ErrorCode {
+        check_useful_c_str!(type_, ErrorCode::CommonInvalidState);
+        check_useful_c_str!(query_json, ErrorCode::CommonInvalidState);
 
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
+
+        let query = match language::parse_from_json_encrypted(&query_json) {
+            Ok(query) => query,
+            Err(err) => {
+                error!("Error parsing query of records to delete. Error details: {:?}", err);
+                return ErrorCode::WalletQueryError;
+            }
+        };
+
+        let wallet_box = &wallet_context.phandle;
+        let storage = &*wallet_box;
+
+        let res = storage.delete_records(&type_.as_bytes(), &query);
+
+        match res {
+            Ok(count) => {
+                unsafe { *deleted_count = count };
+                ErrorCode::Success
+            }
+            Err(err) => {
+                error!("Error deleting records. Error details: {:?}", err);
+                ErrorCode::WalletStorageError
+            }
         }
+    }
+
+
+    pub extern fn get_storage_metadata(xhandle: i32, metadata_ptr: *mut *const c_char, metadata_handle: *mut i32) -> ErrorCode {
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -646,7 +720,7 @@ impl PostgresWallet {
 
                 let handle = SequenceUtils::get_next_id();
 
-                let mut metadatas = POSTGRES_ACTIVE_METADATAS.lock().unwrap();
+                let mut metadatas = wallet_context.metadatas.lock().unwrap();
                 metadatas.insert(handle, metadata);
 
                 unsafe { *metadata_ptr = metadata_pointer; }
@@ -665,13 +739,11 @@ impl PostgresWallet {
     pub extern fn set_storage_metadata(xhandle: i32, metadata: *const c_char) -> ErrorCode {
         check_useful_c_str!(metadata, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -693,13 +765,12 @@ impl PostgresWallet {
 
 
     pub extern fn free_storage_metadata(xhandle: i32, metadata_handler: i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let mut handles = POSTGRES_ACTIVE_METADATAS.lock().unwrap();
+        let mut handles = wallet_context.metadatas.lock().unwrap();
 
         if !handles.contains_key(&metadata_handler) {
             return ErrorCode::CommonInvalidState;
@@ -715,14 +786,12 @@ impl PostgresWallet {
         check_useful_c_str!(query_json, ErrorCode::CommonInvalidState);
         check_useful_c_str!(options_json, ErrorCode::CommonInvalidState);
 
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
         let query = language::parse_from_json_encrypted(&query_json).unwrap();
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -731,30 +800,19 @@ impl PostgresWallet {
         match res {
             Ok(iter) => {
                 // iter: Box<StorageIterator>
-                let total_count = iter.get_total_count();
-                let search_records = _iterator_to_record_set(iter).unwrap();
-                let total_count = match total_count {
-                    Ok(count) => {
-                        match count {
-                            Some(ct) => ct,
-                            None => 0
-                        }
-                    },
-                    _ => search_records.len()
+                let total_count = match iter.get_total_count() {
+                    Ok(Some(count)) => count,
+                    _ => 0
                 };
-                let search_set = PostgresWalletRecordSet {
-                    idx: 0,
-                    records: search_records,
+                let search = PostgresWalletSearch {
+                    iter: Mutex::new(iter),
                     count: total_count
                 };
 
                 let search_handle = SequenceUtils::get_next_id();
 
-                let mut searches = POSTGRES_ACTIVE_SEARCHES.lock().unwrap();
-
-                // TODO store the iterator rather than the fetched records
-                // searches.insert(search_handle, iter);
-                searches.insert(search_handle, search_set);
+                let mut searches = wallet_context.searches.lock().unwrap();
+                searches.insert(search_handle, Arc::new(search));
 
                 unsafe { *handle = search_handle };
                 return ErrorCode::Success
@@ -768,13 +826,11 @@ impl PostgresWallet {
 
 
     pub extern fn search_all_records(xhandle: i32, handle: *mut i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let wallet_context = handles.get(&xhandle).unwrap();
         let wallet_box = &wallet_context.phandle;
         let storage = &*wallet_box;
 
@@ -783,30 +839,19 @@ impl PostgresWallet {
         match res {
             Ok(iter) => {
                 // iter: Box<StorageIterator>
-                let total_count = iter.get_total_count();
-                let search_records = _iterator_to_record_set(iter).unwrap();
-                let total_count = match total_count {
-                    Ok(count) => {
-                        match count {
-                            Some(ct) => ct,
-                            None => 0
-                        }
-                    },
-                    _ => search_records.len()
+                let total_count = match iter.get_total_count() {
+                    Ok(Some(count)) => count,
+                    _ => 0
                 };
-                let search_set = PostgresWalletRecordSet {
-                    idx: 0,
-                    records: search_records,
+                let search = PostgresWalletSearch {
+                    iter: Mutex::new(iter),
                     count: total_count
                 };
 
                 let search_handle = SequenceUtils::get_next_id();
 
-                let mut searches = POSTGRES_ACTIVE_SEARCHES.lock().unwrap();
-
-                // TODO store the iterator rather than the fetched records
-                // searches.insert(search_handle, iter);
-                searches.insert(search_handle, search_set);
+                let mut searches = wallet_context.searches.lock().unwrap();
+                searches.insert(search_handle, Arc::new(search));
 
                 unsafe { *handle = search_handle };
                 return ErrorCode::Success
@@ -820,17 +865,16 @@ impl PostgresWallet {
 
 
     pub extern fn get_search_total_count(xhandle: i32, search_handle: i32, count: *mut usize) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let searches = POSTGRES_ACTIVE_SEARCHES.lock().unwrap();
+        let searches = wallet_context.searches.lock().unwrap();
 
         match searches.get(&search_handle) {
-            Some(records) => {
-                unsafe { *count = records.count };
+            Some(search) => {
+                unsafe { *count = search.count };
             }
             None => return ErrorCode::CommonInvalidState
         }
@@ -840,42 +884,45 @@ impl PostgresWallet {
 
 
     pub extern fn fetch_search_next_record(xhandle: i32, search_handle: i32, record_handle: *mut i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let search = match wallet_context.searches.lock().unwrap().get(&search_handle) {
+            Some(search) => search.clone(),
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let mut searches = POSTGRES_ACTIVE_SEARCHES.lock().unwrap();
+        // only this search is locked while the next batch is fetched from the database
+        let res = search.iter.lock().unwrap().next();
 
-        match searches.get_mut(&search_handle) {
-            Some(records) => {
-                if records.idx < records.records.len() {
-                    let handle = SequenceUtils::get_next_id();
+        match res {
+            Ok(Some(record)) => {
+                let handle = SequenceUtils::get_next_id();
 
-                    let mut handles = POSTGRES_ACTIVE_RECORDS.lock().unwrap();
-                    handles.insert(handle, records.records.get(records.idx).unwrap().clone());
-                    records.idx = records.idx + 1;
+                let mut handles = wallet_context.records.lock().unwrap();
+                handles.insert(handle, _storagerecord_to_postgresrecord(&record).unwrap());
 
-                    unsafe { *record_handle = handle };
-                    ErrorCode::Success
-                } else {
-                    ErrorCode::WalletItemNotFound
-                }
+                unsafe { *record_handle = handle };
+                ErrorCode::Success
             },
-            None => ErrorCode::CommonInvalidState
+            Ok(None) => ErrorCode::WalletItemNotFound,
+            Err(err) => {
+                error!("Error fetching search record. Error details: {:?}", err);
+                ErrorCode::WalletStorageError
+            }
         }
     }
 
 
     pub extern fn free_search(xhandle: i32, search_handle: i32) -> ErrorCode {
-        let handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
+        let wallet_context = match _wallet_context(xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let mut handles = POSTGRES_ACTIVE_SEARCHES.lock().unwrap();
+        let mut handles = wallet_context.searches.lock().unwrap();
 
         if !handles.contains_key(&search_handle) {
             return ErrorCode::CommonInvalidState;
@@ -887,17 +934,19 @@ impl PostgresWallet {
 
 
     pub extern fn close(xhandle: i32) -> ErrorCode {
-        let mut handles = POSTGRES_OPEN_WALLETS.lock().unwrap();
-
-        if !handles.contains_key(&xhandle) {
-            return ErrorCode::CommonInvalidState;
-        }
-
-        let wallet_context = handles.remove(&xhandle).unwrap();
-
-        let mut storage = *wallet_context.phandle;
+        let wallet_context = match POSTGRES_OPEN_WALLETS.write().unwrap().remove(&xhandle) {
+            Some(wallet_context) => wallet_context,
+            None => return ErrorCode::CommonInvalidState
+        };
 
-        let res = storage.close();
+        // calls that are still running on this wallet keep their own reference, storage is dropped with the last one
+        let res = match Arc::try_unwrap(wallet_context) {
+            Ok(wallet_context) => {
+                let mut storage = *wallet_context.phandle;
+                storage.close()
+            },
+            Err(_) => Ok(())
+        };
 
         match res {
             Ok(_) => ErrorCode::Success,
@@ -944,31 +993,6 @@ fn _storagerecord_to_postgresrecord(in_rec: &StorageRecord) -> Result<PostgresWa
     Ok(out_rec)
 }
 
-fn _iterator_to_record_set(mut iter: Box<dyn StorageIterator>) -> Result<Vec<PostgresWalletRecord>, ErrorCode> {
-    let mut search_continue: bool = true;
-    let mut search_records = Vec::new();
-    while search_continue {
-        let rec = iter.next();
-        match rec {
-            Ok(record) => {
-                match record {
-                    Some(record) => {
-                        // record: StorageRecord
-                        search_records.push(_storagerecord_to_postgresrecord(&record).unwrap());
-                    },
-                    None => {
-                        search_continue = false;
-                    }
-                };
-            },
-            Err(_err) => {
-                return Err(ErrorCode::WalletStorageError);
-            }
-        };
-    }
-    Ok(search_records)
-}
-
 fn _tags_to_json(tags: &[Tag]) -> Result<String, WalletStorageError> {
     let mut string_tags = HashMap::new();
     for tag in tags {
@@ -980,8 +1004,40 @@ fn _tags_to_json(tags: &[Tag]) -> Result<String, WalletStorageError> {
     serde_json::to_string(&string_tags).map_err(|err| WalletStorageError::IOError(err.to_string()))
 }
 
+#[derive(Deserialize)]
+struct PostgresWalletJSONRecord {
+    #[serde(rename = "type")]
+    type_: String,
+    id: String,
+    value: String,
+    tags: HashMap<String, String>,
+}
+
+// type and id are kept base64 encoded, the same way as add_record stores them
+fn _records_from_json(json: &str) -> Result<Vec<StorageRecord>, WalletStorageError> {
+    let json_records: Vec<PostgresWalletJSONRecord> = serde_json::from_str(json).map_err(|err| WalletStorageError::IOError(err.to_string()))?;
+    let mut records = Vec::with_capacity(json_records.len());
+
+    for record in json_records {
+        let value = util_base64::decode(&record.value).map_err(|err| WalletStorageError::IOError(err.to_string()))?;
+        let value = EncryptedValue::from_bytes(&value)?;
+
+        records.push(StorageRecord::new(
+            record.id.into_bytes(),
+            Some(value),
+            Some(record.type_.into_bytes()),
+            Some(_tags_from_map(record.tags)?),
+        ));
+    }
+    Ok(records)
+}
+
 fn _tags_from_json(json: &str) -> Result<Vec<Tag>, WalletStorageError> {
     let string_tags: HashMap<String, String> = serde_json::from_str(json).map_err(|err| WalletStorageError::IOError(err.to_string()))?;
+    _tags_from_map(string_tags)
+}
+
+fn _tags_from_map(string_tags: HashMap<String, String>) -> Result<Vec<Tag>, WalletStorageError> {
     let mut tags = Vec::new();
 
     for (k, v) in string_tags {
@@ -1176,6 +1232,51 @@ mod tests {
         _close_and_delete_wallet(handle);
     }
 
+    #[test]
+    fn postgres_wallet_add_records_works() {
+        _cleanup();
+
+        let handle = _create_and_open_wallet();
+        let type_ = _type1();
+
+        let records = CString::new(_records_json(0, 3)).unwrap();
+        let err = PostgresWallet::add_records(handle, records.as_ptr());
+        assert_match!(ErrorCode::Success, err);
+
+        let id = CString::new("id_1").unwrap();
+        let mut rec_handle: i32 = -1;
+        let err = PostgresWallet::get_record(handle,
+                                type_.as_ptr(),
+                                id.as_ptr(),
+                                _fetch_options(true, true, true).as_ptr(),
+                                &mut rec_handle);
+        assert_match!(ErrorCode::Success, err);
+
+        let mut tags_ptr: *const c_char = ptr::null_mut();
+        let err = PostgresWallet::get_record_tags(handle, rec_handle, &mut tags_ptr);
+        assert_match!(ErrorCode::Success, err);
+        let tags_json = unsafe { CStr::from_ptr(tags_ptr).to_str().unwrap() };
+        assert_eq!(_sort_tags(_tags()), _sort_tags(_tags_from_json(tags_json).unwrap()));
+
+        let err = PostgresWallet::free_record(handle, rec_handle);
+        assert_match!(ErrorCode::Success, err);
+
+        // the whole batch is rejected if any of the records exists
+        let records = CString::new(_records_json(2, 5)).unwrap();
+        let err = PostgresWallet::add_records(handle, records.as_ptr());
+        assert_match!(ErrorCode::WalletItemAlreadyExists, err);
+
+        let id = CString::new("id_4").unwrap();
+        let err = PostgresWallet::get_record(handle,
+                                type_.as_ptr(),
+                                id.as_ptr(),
+                                _fetch_options(true, true, true).as_ptr(),
+                                &mut rec_handle);
+        assert_match!(ErrorCode::WalletItemNotFound, err);
+
+        _close_and_delete_wallet(handle);
+    }
+
     #[test]
     fn postgres_wallet_get_record_works() {
         _cleanup();
@@ -1586,6 +1687,142 @@ mod tests {
 
         _close_and_delete_wallet(handle);
     }
+
+    #[test]
+    fn postgres_wallet_works_for_concurrent_wallets() {
+        _cleanup();
+
+        const WALLETS_COUNT: usize = 16;
+        const RECORDS_COUNT: usize = 100;
+
+        let config = _wallet_config();
+        let credentials = _wallet_credentials();
+        let metadata = _metadata_cstring();
+
+        let ids: Vec<CString> = (0..WALLETS_COUNT).map(|i| CString::new(format!("walle1_concurrent_{}", i)).unwrap()).collect();
+
+        let handles: Vec<i32> = ids.iter().map(|id| {
+            let _err = PostgresWallet::delete(id.as_ptr(),
+                                              config.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                              credentials.as_ref().map_or(ptr::null(), |x| x.as_ptr()));
+
+            let err = PostgresWallet::create(id.as_ptr(),
+                                             config.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                             credentials.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                             metadata.as_ptr());
+            assert_eq!(err, ErrorCode::Success);
+
+            let mut handle: i32 = -1;
+            let err = PostgresWallet::open(id.as_ptr(),
+                                           config.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                           credentials.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                           &mut handle);
+            assert_eq!(err, ErrorCode::Success);
+            handle
+        }).collect();
+
+        let threads: Vec<thread::JoinHandle<()>> = handles.iter().map(|&handle| {
+            thread::spawn(move || {
+                let type_ = _type1();
+                let joined_value = _value1().to_bytes();
+                let tags = _tags_json(&_tags());
+
+                for i in 0..RECORDS_COUNT {
+                    let id = CString::new(format!("id_{}", i)).unwrap();
+
+                    let err = PostgresWallet::add_record(handle,
+                                                         type_.as_ptr(),
+                                                         id.as_ptr(),
+                                                         joined_value.as_ptr(),
+                                                         joined_value.len(),
+                                                         tags.as_ptr());
+                    assert_match!(ErrorCode::Success, err);
+
+                    let mut rec_handle: i32 = -1;
+                    let err = PostgresWallet::get_record(handle,
+                                                         type_.as_ptr(),
+                                                         id.as_ptr(),
+                                                         _fetch_options(true, true, true).as_ptr(),
+                                                         &mut rec_handle);
+                    assert_match!(ErrorCode::Success, err);
+
+                    let err = PostgresWallet::free_record(handle, rec_handle);
+                    assert_match!(ErrorCode::Success, err);
+                }
+            })
+        }).collect();
+
+        for thread in threads {
+            thread.join().unwrap();
+        }
+
+        for (id, handle) in ids.iter().zip(handles.into_iter()) {
+            let err = PostgresWallet::close(handle);
+            assert_eq!(err, ErrorCode::Success);
+
+            let err = PostgresWallet::delete(id.as_ptr(),
+                                             config.as_ref().map_or(ptr::null(), |x| x.as_ptr()),
+                                             credentials.as_ref().map_or(ptr::null(), |x| x.as_ptr()));
+            assert_eq!(err, ErrorCode::Success);
+        }
+    }
+
+    #[test]
+    fn postgres_wallet_get_all_works_for_several_fetch_batches() {
+        _cleanup();
+
+        // more than two batches read from the search cursor
+        const RECORDS_COUNT: usize = 250;
+
+        let handle = _create_and_open_wallet();
+
+        let type_ = _type1();
+        let joined_value = _value1().to_bytes();
+        let tags = _tags_json(&_tags());
+
+        for i in 0..RECORDS_COUNT {
+            let id = CString::new(format!("id_{}", i)).unwrap();
+            let err = PostgresWallet::add_record(handle,
+                                                 type_.as_ptr(),
+                                                 id.as_ptr(),
+                                                 joined_value.as_ptr(),
+                                                 joined_value.len(),
+                                                 tags.as_ptr());
+            assert_match!(ErrorCode::Success, err);
+        }
+
+        let mut search_handle: i32 = -1;
+        let err = PostgresWallet::search_all_records(handle, &mut search_handle);
+        assert_match!(ErrorCode::Success, err);
+
+        let mut rec_count: usize = 0;
+        loop {
+            let mut rec_handle = -1;
+            let err = PostgresWallet::fetch_search_next_record(handle, search_handle, &mut rec_handle);
+            if err == ErrorCode::WalletItemNotFound {
+                break;
+            }
+            assert_match!(ErrorCode::Success, err);
+
+            rec_count = rec_count + 1;
+
+            let mut tags_ptr: *const c_char = ptr::null_mut();
+            let err = PostgresWallet::get_record_tags(handle, rec_handle, &mut tags_ptr);
+            assert_match!(ErrorCode::Success, err);
+            let tags_json = unsafe { CStr::from_ptr(tags_ptr).to_str().unwrap() };
+            assert_eq!(_sort_tags(_tags()), _sort_tags(_tags_from_json(tags_json).unwrap()));
+
+            let err = PostgresWallet::free_record(handle, rec_handle);
+            assert_match!(ErrorCode::Success, err);
+        }
+        assert_eq!(RECORDS_COUNT, rec_count);
+
+        let err = PostgresWallet::free_search(handle, search_handle);
+        assert_match!(ErrorCode::Success, err);
+
+        _close_and_delete_wallet(handle);
+    }
+
 /* TODO unit test for wallet search
     #[test]
     fn postgres_wallet_search_records_works() {
@@ -1625,7 +1862,6 @@ mod tests {
         assert_match!(ErrorCode::Success, err);
 
         // search the records and verify
-        println!("Setting up search query");
         let mut search_handle: i32 = -1;
         //let tag_name = String::from_utf8(vec![1, 5, 8]).unwrap();
         //let tag_value = String::from_utf8(vec![3, 5, 6]).unwrap();
@@ -1633,9 +1869,7 @@ mod tests {
         let tag_value = format!("{:?}", vec![3, 5, 6]);
         let query_json = format!(r#"{{{}:{}}}"#, tag_name, tag_value);
         let query_json = CString::new(query_json.to_string()).unwrap();
-        println!("query_json {:?}", query_json);
         let options_json = _search_options(true, true, true, true, true);
-        println!("Options {:?}", options_json);
         let err = PostgresWallet::search_records(handle,
                                 type1_.as_ptr(),
                                 query_json.as_ptr(),
@@ -1922,6 +2156,18 @@ mod tests {
         CString::new(_tag_names_to_json(tag_names_).unwrap()).unwrap()
     }
 
+    fn _records_json(from: usize, to: usize) -> String {
+        let type_ = _type1().into_string().unwrap();
+        let value = util_base64::encode(&_value1().to_bytes());
+        let tags: serde_json::Value = serde_json::from_str(_tags_json(&_tags()).to_str().unwrap()).unwrap();
+
+        let records: Vec<serde_json::Value> = (from..to)
+            .map(|i| json!({"type": type_, "id": format!("id_{}", i), "value": value, "tags": tags}))
+            .collect();
+
+        serde_json::to_string(&records).unwrap()
+    }
+
     fn _tags_json(tags_: &Vec<Tag>) -> CString {
         CString::new(_tags_to_json(tags_).unwrap()).unwrap()
     }
@@ -70,6 +70,32 @@ pub type WalletAddRecord = extern fn(storage_handle: IndyHandle,
                                      value_len: usize,
                                      tags_json: *const c_char) -> ErrorCode;
 
+/// Create a batch of new records in the wallet storage (all of them or none)
+///
+/// #Params
+/// storage_handle: opened storage handle (See open handler)
+/// records_json: the records to add as json array:
+///   [{
+///     "type": string, // the same as type_ param of add record handler
+///     "id": string, // the same as id param of add record handler
+///     "value": string, // base64 encoded value of record
+///     "tags": {} // the same as tags_json param of add record handler
+///   }]
+pub type WalletAddRecords = extern fn(storage_handle: IndyHandle,
+                                      records_json: *const c_char) -> ErrorCode;
+
+/// Delete all records of the type matching the query (optional handler, see indy_register_wallet_storage_delete_records)
+///
+/// #Params
+/// storage_handle: opened storage handle (See open handler)
+/// type_: record type
+/// query_json: encrypted query, the same as query_json param of search records handler
+/// deleted_count_p: pointer to store the number of deleted records
+pub type WalletDeleteRecords = extern fn(storage_handle: IndyHandle,
+                                         type_: *const c_char,
+                                         query_json: *const c_char,
+                                         deleted_count_p: *mut usize) -> ErrorCode;
+
 /// Update a record value
 ///
 /// #Params
@@ -394,6 +420,50 @@ pub fn register_wallet_storage(
     receiver.recv().unwrap()
 }
 
+pub fn register_wallet_storage_add_records(wallet_storage_name: *const c_char,
+                                           add_records: WalletAddRecords) -> ErrorCode {
+    let (sender, receiver) = channel();
+
+    let closure: Box<dyn FnMut(ErrorCode) + Send> = Box::new(move |err| {
+        sender.send(err).unwrap();
+    });
+
+    let (cmd_handle, cb) = callbacks::closure_to_cb_ec(closure);
+
+    unsafe {
+        indy_register_wallet_storage_add_records(
+            cmd_handle,
+            wallet_storage_name,
+            Some(add_records),
+            cb,
+        );
+    }
+
+    receiver.recv().unwrap()
+}
+
+pub fn register_wallet_storage_delete_records(wallet_storage_name: *const c_char,
+                                              delete_records: WalletDeleteRecords) -> ErrorCode {
+    let (sender, receiver) = channel();
+
+    let closure: Box<dyn FnMut(ErrorCode) + Send> = Box::new(move |err| {
+        sender.send(err).unwrap();
+    });
+
+    let (cmd_handle, cb) = callbacks::closure_to_cb_ec(closure);
+
+    unsafe {
+        indy_register_wallet_storage_delete_records(
+            cmd_handle,
+            wallet_storage_name,
+            Some(delete_records),
+            cb,
+        );
+    }
+
+    receiver.recv().unwrap()
+}
+
 extern {
     #[no_mangle]
     pub fn indy_register_wallet_storage(command_handle: IndyHandle,
@@ -424,6 +494,20 @@ extern {
                                             free_search: Option<WalletFreeSearch>,
                                             cb: Option<extern fn(command_handle_: IndyHandle,
                                                                     err: ErrorCode)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_register_wallet_storage_add_records(command_handle: IndyHandle,
+                                                        type_: *const c_char,
+                                                        add_records: Option<WalletAddRecords>,
+                                                        cb: Option<extern fn(command_handle_: IndyHandle,
+                                                                                err: ErrorCode)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_register_wallet_storage_delete_records(command_handle: IndyHandle,
+                                                           type_: *const c_char,
+                                                           delete_records: Option<WalletDeleteRecords>,
+                                                           cb: Option<extern fn(command_handle_: IndyHandle,
+                                                                                   err: ErrorCode)>) -> ErrorCode;
 }
 
 
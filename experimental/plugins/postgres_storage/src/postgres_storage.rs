@@ -1,4 +1,3 @@
-extern crate owning_ref;
 extern crate sodiumoxide;
 extern crate r2d2;
 extern crate r2d2_postgres;
@@ -10,8 +9,7 @@ use postgres;
 use self::r2d2_postgres::{TlsMode, PostgresConnectionManager};
 use serde_json;
 
-use self::owning_ref::OwningHandle;
-use std::rc::Rc;
+use std::collections::{HashMap, VecDeque};
 use std::time::Duration;
 
 use self::percent_encoding::{utf8_percent_encode, NON_ALPHANUMERIC};
@@ -117,10 +115,20 @@ impl Default for SearchOptions {
 
 const _POSTGRES_DB: &str = "postgres";
 const _WALLETS_DB: &str = "wallets";
-const _PLAIN_TAGS_QUERY: &str = "SELECT name, value from tags_plaintext where item_id = $1";
-const _ENCRYPTED_TAGS_QUERY: &str = "SELECT name, value from tags_encrypted where item_id = $1";
-const _PLAIN_TAGS_QUERY_MULTI: &str = "SELECT name, value from tags_plaintext where item_id = $1 and wallet_id = $2";
-const _ENCRYPTED_TAGS_QUERY_MULTI: &str = "SELECT name, value from tags_encrypted where item_id = $1 and wallet_id = $2";
+const _PLAIN_TAGS_QUERY: &str = "SELECT item_id, name, value from tags_plaintext where item_id = ANY($1)";
+const _ENCRYPTED_TAGS_QUERY: &str = "SELECT item_id, name, value from tags_encrypted where item_id = ANY($1)";
+const _PLAIN_TAGS_QUERY_MULTI: &str = "SELECT item_id, name, value from tags_plaintext where item_id = ANY($1) and wallet_id = $2";
+const _ENCRYPTED_TAGS_QUERY_MULTI: &str = "SELECT item_id, name, value from tags_encrypted where item_id = ANY($1) and wallet_id = $2";
+// Searches read rows from a server side cursor in batches of this size
+const _SEARCH_FETCH_SIZE: usize = 100;
+const _SEARCH_CURSOR: &str = "search_cursor";
+const _RESERVE_ITEM_IDS: &str = "SELECT nextval(pg_get_serial_sequence('items', 'id')) FROM generate_series(1, $1)";
+const _COPY_ITEMS: &str = "COPY items (id, type, name, value, key) FROM STDIN";
+const _COPY_ITEMS_MULTI: &str = "COPY items (id, type, name, value, key, wallet_id) FROM STDIN";
+const _COPY_ENCRYPTED_TAGS: &str = "COPY tags_encrypted (item_id, name, value) FROM STDIN";
+const _COPY_ENCRYPTED_TAGS_MULTI: &str = "COPY tags_encrypted (item_id, name, value, wallet_id) FROM STDIN";
+const _COPY_PLAIN_TAGS: &str = "COPY tags_plaintext (item_id, name, value) FROM STDIN";
+const _COPY_PLAIN_TAGS_MULTI: &str = "COPY tags_plaintext (item_id, name, value, wallet_id) FROM STDIN";
 const _CREATE_WALLET_DATABASE: &str = "CREATE DATABASE \"$1\"";
 const _CREATE_WALLETS_DATABASE: &str = "CREATE DATABASE wallets";
 // Note: wallet id length was constrained before by postgres database name length to 64 characters, keeping the same restrictions
@@ -228,140 +236,173 @@ const _DELETE_WALLET_MULTI: [&str; 4] = [
 ];
 
 
-#[derive(Debug)]
-struct TagRetriever<'a> {
-    plain_tags_stmt: postgres::stmt::Statement<'a>,
-    encrypted_tags_stmt: postgres::stmt::Statement<'a>,
-    wallet_id: Option<String>,
+// Appends bytea column in COPY text format (hex bytea input, with the backslash escaped for COPY)
+fn _copy_bytea(row: &mut String, data: &[u8]) {
+    const HEX: &[u8; 16] = b"0123456789abcdef";
+
+    row.push_str("\\\\x");
+    for byte in data {
+        row.push(HEX[(byte >> 4) as usize] as char);
+        row.push(HEX[(byte & 0x0f) as usize] as char);
+    }
 }
 
-type TagRetrieverOwned = OwningHandle<Rc<r2d2::PooledConnection<PostgresConnectionManager>>, Box<TagRetriever<'static>>>;
-
-impl<'a> TagRetriever<'a> {
-    fn new_owned(conn: Rc<r2d2::PooledConnection<PostgresConnectionManager>>, wallet_id: Option<String>) -> Result<TagRetrieverOwned, WalletStorageError> {
-        OwningHandle::try_new(conn.clone(), |conn| -> Result<_, postgres::Error> {
-            let (plain_tags_stmt, encrypted_tags_stmt) = unsafe {
-                match wallet_id {
-                    Some(_) => ((*conn).prepare(_PLAIN_TAGS_QUERY_MULTI)?,
-                                (*conn).prepare(_ENCRYPTED_TAGS_QUERY_MULTI)?),
-                    None => ((*conn).prepare(_PLAIN_TAGS_QUERY)?,
-                             (*conn).prepare(_ENCRYPTED_TAGS_QUERY)?)
-                }
-            };
-            let tr = TagRetriever {
-                plain_tags_stmt,
-                encrypted_tags_stmt,
-                wallet_id,
-            };
-            Ok(Box::new(tr))
-        }).map_err(WalletStorageError::from)
+// Appends text column in COPY text format
+fn _copy_text(row: &mut String, data: &str) {
+    for c in data.chars() {
+        match c {
+            '\\' => row.push_str("\\\\"),
+            '\n' => row.push_str("\\n"),
+            '\r' => row.push_str("\\r"),
+            '\t' => row.push_str("\\t"),
+            c => row.push(c)
+        }
     }
+}
 
-    fn retrieve(&mut self, id: i64) -> Result<Vec<Tag>, WalletStorageError> {
-        let mut tags = Vec::new();
+// Appends wallet_id column (if wallets share tables) and finishes the COPY row
+fn _copy_end_row(row: &mut String, wallet_id: Option<&String>) {
+    if let Some(wallet_id) = wallet_id {
+        row.push('\t');
+        _copy_text(row, wallet_id);
+    }
+    row.push('\n');
+}
 
-        let plain_results = match self.wallet_id {
-            Some(ref w_id) => self.plain_tags_stmt.query(&[&id, &w_id])?,
-            None => self.plain_tags_stmt.query(&[&id])?
-        };
-        let mut iter_plain = plain_results.iter();
-        while let Some(res) = iter_plain.next() {
-            let row = res;
-            tags.push(Tag::PlainText(row.get(0), row.get(1)));
-        }
+// Reads tags of the batch of items with two queries instead of two queries per item
+fn _retrieve_tags(conn: &postgres::Connection, ids: &Vec<i64>, wallet_id: Option<&String>) -> Result<HashMap<i64, Vec<Tag>>, WalletStorageError> {
+    let mut tags: HashMap<i64, Vec<Tag>> = HashMap::new();
 
-        let encrypted_results = match self.wallet_id {
-            Some(ref w_id) => self.encrypted_tags_stmt.query(&[&id, &w_id])?,
-            None => self.encrypted_tags_stmt.query(&[&id])?
-        };
-        let mut iter_encrypted = encrypted_results.iter();
-        while let Some(res) = iter_encrypted.next() {
-            let row = res;
-            tags.push(Tag::Encrypted(row.get(0), row.get(1)));
-        }
+    let plain_results = match wallet_id {
+        Some(w_id) => conn.query(_PLAIN_TAGS_QUERY_MULTI, &[ids, w_id])?,
+        None => conn.query(_PLAIN_TAGS_QUERY, &[ids])?
+    };
+    for row in plain_results.iter() {
+        tags.entry(row.get(0)).or_insert_with(Vec::new).push(Tag::PlainText(row.get(1), row.get(2)));
+    }
 
-        Ok(tags)
+    let encrypted_results = match wallet_id {
+        Some(w_id) => conn.query(_ENCRYPTED_TAGS_QUERY_MULTI, &[ids, w_id])?,
+        None => conn.query(_ENCRYPTED_TAGS_QUERY, &[ids])?
+    };
+    for row in encrypted_results.iter() {
+        tags.entry(row.get(0)).or_insert_with(Vec::new).push(Tag::Encrypted(row.get(1), row.get(2)));
     }
+
+    Ok(tags)
 }
 
+// Waits for a free pooled connection. Fails instead of panicking when none is freed in time,
+// e.g. when open searches hold all max_connections of the pool.
+fn _get_connection(pool: &r2d2::Pool<PostgresConnectionManager>) -> Result<r2d2::PooledConnection<PostgresConnectionManager>, WalletStorageError> {
+    pool.get()
+        .map_err(|err| WalletStorageError::IOError(format!("Error retrieving connection from connection pool: {}", err)))
+}
+
+// Search results are read through a server side cursor declared in its own transaction
+// on a dedicated pooled connection. Rows are fetched in batches of _SEARCH_FETCH_SIZE as the
+// caller iterates, so memory use doesn't depend on the size of the result set.
+// The connection goes back to the pool when the iterator is dropped, so every open search
+// takes one of max_connections until it is freed.
 struct PostgresStorageIterator {
-    rows: Option<
-        OwningHandle<
-            OwningHandle<
-                Rc<r2d2::PooledConnection<PostgresConnectionManager>>,
-                Box<postgres::stmt::Statement<'static>>>,
-            Box<postgres::rows::Rows<>>>>,
-    tag_retriever: Option<TagRetrieverOwned>,
+    conn: Option<r2d2::PooledConnection<PostgresConnectionManager>>,
+    wallet_id: Option<String>,
     options: RecordOptions,
     total_count: Option<usize>,
-    iter_count: usize,
+    records: VecDeque<StorageRecord>,
+    exhausted: bool,
 }
 
 impl PostgresStorageIterator {
-    fn new(stmt: Option<OwningHandle<Rc<r2d2::PooledConnection<PostgresConnectionManager>>, Box<postgres::stmt::Statement<'static>>>>,
+    fn new(conn: r2d2::PooledConnection<PostgresConnectionManager>,
+           query: &str,
            args: &[&dyn postgres::types::ToSql],
            options: RecordOptions,
-           tag_retriever: Option<TagRetrieverOwned>,
+           wallet_id: Option<String>,
            total_count: Option<usize>) -> Result<PostgresStorageIterator, WalletStorageError> {
-        let mut iter = PostgresStorageIterator {
-            rows: None,
-            tag_retriever,
+        conn.batch_execute("BEGIN")?;
+
+        if let Err(err) = conn.execute(&format!("DECLARE {} NO SCROLL CURSOR FOR {}", _SEARCH_CURSOR, query), args) {
+            conn.batch_execute("ROLLBACK").ok();
+            return Err(WalletStorageError::from(err));
+        }
+
+        Ok(PostgresStorageIterator {
+            conn: Some(conn),
+            wallet_id,
             options,
             total_count,
-            iter_count: 0,
+            records: VecDeque::new(),
+            exhausted: false,
+        })
+    }
+
+    // Iterator for search without records requested
+    fn empty(total_count: Option<usize>) -> PostgresStorageIterator {
+        PostgresStorageIterator {
+            conn: None,
+            wallet_id: None,
+            options: RecordOptions::default(),
+            total_count,
+            records: VecDeque::new(),
+            exhausted: true,
+        }
+    }
+
+    fn _fetch(&mut self) -> Result<(), WalletStorageError> {
+        let conn = match self.conn {
+            Some(ref conn) => conn,
+            None => {
+                self.exhausted = true;
+                return Ok(());
+            }
         };
 
-        if let Some(stmt) = stmt {
-            iter.rows = Some(OwningHandle::try_new(
-                stmt, |stmt|
-                    unsafe {
-                        (*(stmt as *mut postgres::stmt::Statement)).query(args).map(Box::new)
-                    },
-            )?);
+        let rows = conn.query(&format!("FETCH {} FROM {}", _SEARCH_FETCH_SIZE, _SEARCH_CURSOR), &[])?;
+
+        if rows.len() < _SEARCH_FETCH_SIZE {
+            self.exhausted = true;
         }
 
-        Ok(iter)
+        let mut tags = if self.options.retrieve_tags {
+            let ids: Vec<i64> = rows.iter().map(|row| row.get(0)).collect();
+            _retrieve_tags(conn, &ids, self.wallet_id.as_ref())?
+        } else {
+            HashMap::new()
+        };
+
+        for row in rows.iter() {
+            let id: i64 = row.get(0);
+            let name = row.get(1);
+            let value = if self.options.retrieve_value {
+                Some(EncryptedValue::new(row.get(2), row.get(3)))
+            } else {
+                None
+            };
+            let tags = if self.options.retrieve_tags {
+                Some(tags.remove(&id).unwrap_or_default())
+            } else {
+                None
+            };
+            let type_ = if self.options.retrieve_type {
+                Some(row.get(4))
+            } else {
+                None
+            };
+            self.records.push_back(StorageRecord::new(name, value, type_, tags));
+        }
+
+        Ok(())
     }
 }
 
 impl StorageIterator for PostgresStorageIterator {
     fn next(&mut self) -> Result<Option<StorageRecord>, WalletStorageError> {
-        // if records are not requested.
-        if self.rows.is_none() {
-            return Ok(None);
+        if self.records.is_empty() && !self.exhausted {
+            self._fetch()?;
         }
 
-        // TODO not sure if iter().nth() is the most efficient way to iterate through the result set
-        // TODO investigate if the Iter object can be cached between calls to next()
-        match self.rows.as_mut().unwrap().iter().nth(self.iter_count) {
-            Some(row) => {
-                self.iter_count = self.iter_count + 1;
-                let name = row.get(1);
-                let value = if self.options.retrieve_value {
-                    Some(EncryptedValue::new(row.get(2), row.get(3)))
-                } else {
-                    None
-                };
-                let tags = if self.options.retrieve_tags {
-                    match self.tag_retriever {
-                        Some(ref mut tag_retriever) => Some(tag_retriever.retrieve(row.get(0))?),
-                        None => return Err(WalletStorageError::CommonError(
-                            CommonError::InvalidState("Fetch tags option set and tag retriever is None".to_string())
-                        ))
-                    }
-                } else {
-                    None
-                };
-                let type_ = if self.options.retrieve_type {
-                    Some(row.get(4))
-                } else {
-                    None
-                };
-                Ok(Some(StorageRecord::new(name, value, type_, tags)))
-            }
-            //Some(Err(err)) => Err(WalletStorageError::from(err)),
-            None => Ok(None)
-        }
+        Ok(self.records.pop_front())
     }
 
     fn get_total_count(&self) -> Result<Option<usize>, WalletStorageError> {
@@ -369,6 +410,15 @@ impl StorageIterator for PostgresStorageIterator {
     }
 }
 
+impl Drop for PostgresStorageIterator {
+    fn drop(&mut self) {
+        // closes the cursor and leaves connection clean for the pool
+        if let Some(ref conn) = self.conn {
+            conn.batch_execute("ROLLBACK").ok();
+        }
+    }
+}
+
 #[derive(Deserialize, Debug)]
 pub struct PostgresConfig {
     url: String,
@@ -1121,7 +1171,7 @@ impl WalletStorage for PostgresStorage {
             serde_json::from_str(options)?
         };
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let res: Result<(i64, Vec<u8>, Vec<u8>), WalletStorageError> = {
             let mut rows = match query_qualifier {
@@ -1223,7 +1273,7 @@ impl WalletStorage for PostgresStorage {
     ///
     fn add(&self, type_: &[u8], id: &[u8], value: &EncryptedValue, tags: &[Tag]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let tx: transaction::Transaction = transaction::Transaction::new(&conn)?;
         let res = match query_qualifier {
@@ -1313,9 +1363,98 @@ impl WalletStorage for PostgresStorage {
         Ok(())
     }
 
+    ///
+    /// Adds a batch of records in one transaction with COPY instead of an INSERT per item and tag.
+    /// Item ids are reserved from the items sequence up front so that tag rows can reference them.
+    ///
+    /// # Errors
+    ///
+    ///  * `WalletStorageError::ItemAlreadyExists` - Any of the items already exists (nothing is added)
+    ///  * `IOError("IO error during storage operation:...")` - Failed connection or SQL query
+    ///
+    fn add_records(&self, records: &[StorageRecord]) -> Result<(), WalletStorageError> {
+        if records.is_empty() {
+            return Ok(());
+        }
+
+        let pool = self.pool.clone();
+        let conn = _get_connection(&pool)?;
+        let wallet_id = match get_wallet_strategy_qualifier() {
+            Some(_) => Some(&self.wallet_id),
+            None => None
+        };
+        let tx: transaction::Transaction = transaction::Transaction::new(&conn)?;
+
+        let item_ids: Vec<i64> = tx.prepare_cached(_RESERVE_ITEM_IDS)?
+            .query(&[&(records.len() as i64)])?
+            .iter()
+            .map(|row| row.get(0))
+            .collect();
+
+        let mut items = String::new();
+        let mut tags_encrypted = String::new();
+        let mut tags_plaintext = String::new();
+
+        for (record, item_id) in records.iter().zip(item_ids.iter()) {
+            let (type_, value) = match (record.type_.as_ref(), record.value.as_ref()) {
+                (Some(type_), Some(value)) => (type_, value),
+                _ => return Err(WalletStorageError::GenericError("Record to add must contain type and value".to_string()))
+            };
+
+            items.push_str(&item_id.to_string());
+            items.push('\t');
+            _copy_bytea(&mut items, type_);
+            items.push('\t');
+            _copy_bytea(&mut items, &record.id);
+            items.push('\t');
+            _copy_bytea(&mut items, &value.data);
+            items.push('\t');
+            _copy_bytea(&mut items, &value.key);
+            _copy_end_row(&mut items, wallet_id);
+
+            for tag in record.tags.as_ref().map(Vec::as_slice).unwrap_or(&[]) {
+                match tag {
+                    &Tag::Encrypted(ref tag_name, ref tag_data) => {
+                        tags_encrypted.push_str(&item_id.to_string());
+                        tags_encrypted.push('\t');
+                        _copy_bytea(&mut tags_encrypted, tag_name);
+                        tags_encrypted.push('\t');
+                        _copy_bytea(&mut tags_encrypted, tag_data);
+                        _copy_end_row(&mut tags_encrypted, wallet_id);
+                    }
+                    &Tag::PlainText(ref tag_name, ref tag_data) => {
+                        tags_plaintext.push_str(&item_id.to_string());
+                        tags_plaintext.push('\t');
+                        _copy_bytea(&mut tags_plaintext, tag_name);
+                        tags_plaintext.push('\t');
+                        _copy_text(&mut tags_plaintext, tag_data);
+                        _copy_end_row(&mut tags_plaintext, wallet_id);
+                    }
+                }
+            }
+        }
+
+        let (copy_items, copy_tags_encrypted, copy_tags_plaintext) = match wallet_id {
+            Some(_) => (_COPY_ITEMS_MULTI, _COPY_ENCRYPTED_TAGS_MULTI, _COPY_PLAIN_TAGS_MULTI),
+            None => (_COPY_ITEMS, _COPY_ENCRYPTED_TAGS, _COPY_PLAIN_TAGS)
+        };
+
+        tx.prepare(copy_items)?.copy_in(&[], &mut items.as_bytes())?;
+        if !tags_encrypted.is_empty() {
+            tx.prepare(copy_tags_encrypted)?.copy_in(&[], &mut tags_encrypted.as_bytes())?;
+        }
+        if !tags_plaintext.is_empty() {
+            tx.prepare(copy_tags_plaintext)?.copy_in(&[], &mut tags_plaintext.as_bytes())?;
+        }
+
+        tx.commit()?;
+
+        Ok(())
+    }
+
     fn update(&self, type_: &[u8], id: &[u8], value: &EncryptedValue) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let res = match query_qualifier {
             Some(_) => conn.prepare_cached("UPDATE items SET value = $1, key = $2 WHERE type = $3 AND name = $4 AND wallet_id = $5")?
@@ -1334,7 +1473,7 @@ impl WalletStorage for PostgresStorage {
 
     fn add_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let tx: transaction::Transaction = transaction::Transaction::new(&conn)?;
 
@@ -1423,7 +1562,7 @@ impl WalletStorage for PostgresStorage {
 
     fn update_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let tx: transaction::Transaction = transaction::Transaction::new(&conn)?;
 
@@ -1497,7 +1636,7 @@ impl WalletStorage for PostgresStorage {
 
     fn delete_tags(&self, type_: &[u8], id: &[u8], tag_names: &[TagName]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let res = match query_qualifier {
             Some(_) => {
@@ -1583,7 +1722,7 @@ impl WalletStorage for PostgresStorage {
     ///
     fn delete(&self, type_: &[u8], id: &[u8]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let row_count = match query_qualifier {
             Some(_) => conn.execute(
@@ -1602,9 +1741,52 @@ impl WalletStorage for PostgresStorage {
         }
     }
 
+    /// Deletes all items of the type matching the query with one statement, tags are deleted by cascade.
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> Result<usize, WalletStorageError> {
+        let type_ = type_.to_vec();
+
+        let pool = self.pool.clone();
+        let conn = _get_connection(&pool)?;
+        let query_qualifier = get_wallet_strategy_qualifier();
+        let wallet_id_arg = self.wallet_id.to_owned();
+        let (query_string, query_arguments) = match query_qualifier {
+            Some(_) => {
+                let (mut query_string, mut query_arguments) = query::wql_to_sql_ids(&type_, query)?;
+                query_arguments.push(&wallet_id_arg);
+                query_string = format!("DELETE FROM items WHERE wallet_id = ${0} AND id IN ({1} AND i.wallet_id = ${0})", query_arguments.len(), query_string);
+                let mut with_clause = false;
+                if query_string.contains("tags_plaintext") {
+                    query_arguments.push(&wallet_id_arg);
+                    query_string = format!("tags_plaintext as (select * from tags_plaintext where wallet_id = ${}) {}", query_arguments.len(), query_string);
+                    with_clause = true;
+                }
+                if query_string.contains("tags_encrypted") {
+                    if with_clause {
+                        query_string = format!(", {}", query_string);
+                    }
+                    query_arguments.push(&wallet_id_arg);
+                    query_string = format!("tags_encrypted as (select * from tags_encrypted where wallet_id = ${}) {}", query_arguments.len(), query_string);
+                    with_clause = true;
+                }
+                if with_clause {
+                    query_string = format!("WITH {}", query_string);
+                }
+                (query_string, query_arguments)
+            }
+            None => {
+                let (query_string, query_arguments) = query::wql_to_sql_ids(&type_, query)?;
+                (format!("DELETE FROM items WHERE id IN ({})", query_string), query_arguments)
+            }
+        };
+
+        let row_count = conn.execute(&query_string, &query_arguments[..])?;
+
+        Ok(row_count as usize)
+    }
+
     fn get_storage_metadata(&self) -> Result<Vec<u8>, WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let res: Result<Vec<u8>, WalletStorageError> = {
             let mut rows = match query_qualifier {
@@ -1630,7 +1812,7 @@ impl WalletStorage for PostgresStorage {
 
     fn set_storage_metadata(&self, metadata: &[u8]) -> Result<(), WalletStorageError> {
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let res = match query_qualifier {
             Some(_) => conn.execute("UPDATE metadata SET value = $1 WHERE wallet_id = $2", &[&metadata.to_vec(), &self.wallet_id]),
@@ -1646,24 +1828,16 @@ impl WalletStorage for PostgresStorage {
 
     fn get_all(&self) -> Result<Box<dyn StorageIterator>, WalletStorageError> {
         let query_qualifier = get_wallet_strategy_qualifier();
-        let statement = match query_qualifier {
-            Some(_) => self._prepare_statement("SELECT id, name, value, key, type FROM items WHERE wallet_id = $1")?,
-            None => self._prepare_statement("SELECT id, name, value, key, type FROM items")?
-        };
         let fetch_options = RecordOptions {
             retrieve_type: true,
             retrieve_value: true,
             retrieve_tags: true,
         };
         let pool = self.pool.clone();
-        let tag_retriever = match query_qualifier {
-            Some(_) => Some(TagRetriever::new_owned(Rc::new(pool.get().unwrap()).clone(), Some(self.wallet_id.clone()))?),
-            None => Some(TagRetriever::new_owned(Rc::new(pool.get().unwrap()).clone(), None)?)
-        };
 
         let storage_iterator = match query_qualifier {
-            Some(_) => PostgresStorageIterator::new(Some(statement), &[&self.wallet_id], fetch_options, tag_retriever, None)?,
-            None => PostgresStorageIterator::new(Some(statement), &[], fetch_options, tag_retriever, None)?
+            Some(_) => PostgresStorageIterator::new(_get_connection(&pool)?, "SELECT id, name, value, key, type FROM items WHERE wallet_id = $1", &[&self.wallet_id], fetch_options, Some(self.wallet_id.clone()), None)?,
+            None => PostgresStorageIterator::new(_get_connection(&pool)?, "SELECT id, name, value, key, type FROM items", &[], fetch_options, None, None)?
         };
         Ok(Box::new(storage_iterator))
     }
@@ -1677,7 +1851,7 @@ impl WalletStorage for PostgresStorage {
         };
 
         let pool = self.pool.clone();
-        let conn = pool.get().unwrap();
+        let conn = _get_connection(&pool)?;
         let query_qualifier = get_wallet_strategy_qualifier();
         let wallet_id_arg = self.wallet_id.to_owned();
         let total_count: Option<usize> = if search_options.retrieve_total_count {
@@ -1756,20 +1930,11 @@ impl WalletStorage for PostgresStorage {
                 None => query::wql_to_sql(&type_, query, options)?
             };
 
-            let statement = self._prepare_statement(&query_string)?;
-            let tag_retriever = if fetch_options.retrieve_tags {
-                let pool = self.pool.clone();
-                match query_qualifier {
-                    Some(_) => Some(TagRetriever::new_owned(Rc::new(pool.get().unwrap()).clone(), Some(self.wallet_id.clone()))?),
-                    None => Some(TagRetriever::new_owned(Rc::new(pool.get().unwrap()).clone(), None)?)
-                }
-            } else {
-                None
-            };
-            let storage_iterator = PostgresStorageIterator::new(Some(statement), &query_arguments[..], fetch_options, tag_retriever, total_count)?;
+            let wallet_id = query_qualifier.map(|_| self.wallet_id.clone());
+            let storage_iterator = PostgresStorageIterator::new(conn, &query_string, &query_arguments[..], fetch_options, wallet_id, total_count)?;
             Ok(Box::new(storage_iterator))
         } else {
-            let storage_iterator = PostgresStorageIterator::new(None, &[], RecordOptions::default(), None, total_count)?;
+            let storage_iterator = PostgresStorageIterator::empty(total_count);
             Ok(Box::new(storage_iterator))
         }
     }
@@ -1780,17 +1945,6 @@ impl WalletStorage for PostgresStorage {
     }
 }
 
-impl PostgresStorage {
-    fn _prepare_statement(&self, sql: &str) -> Result<
-        OwningHandle<Rc<r2d2::PooledConnection<PostgresConnectionManager>>, Box<postgres::stmt::Statement<'static>>>,
-        WalletStorageError> {
-        let pool = self.pool.clone();
-        OwningHandle::try_new(Rc::new(pool.get().unwrap()).clone(), |conn| {
-            unsafe { (*conn).prepare(sql) }.map(Box::new).map_err(WalletStorageError::from)
-        })
-    }
-}
-
 fn create_connection_pool(config: &PostgresConfig, credentials: &PostgresCredentials) -> Result<Pool<PostgresConnectionManager>, WalletStorageError> {
     let _url_base = PostgresStorageType::_admin_postgres_url(&config, &credentials);
     let url = PostgresStorageType::_postgres_url(_WALLETS_DB, &config, &credentials);
@@ -2223,6 +2377,31 @@ mod tests {
         assert_match!(Err(WalletStorageError::ItemNotFound), res);
     }
 
+    #[test]
+    fn postgres_storage_delete_records_works() {
+        _cleanup();
+
+        let storage = _storage();
+        storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+        storage.add(&_type1(), &_id2(), &_value2(), &_new_tags()).unwrap();
+        storage.add(&_type2(), &_id1(), &_value1(), &_tags()).unwrap();
+
+        let query = language::Operator::Eq(language::TagName::PlainTagName(vec![1, 5, 8, 1]),
+                                           language::TargetValue::Unencrypted("Plain value 1".to_string()));
+
+        let deleted_count = storage.delete_records(&_type1(), &query).unwrap();
+        assert_eq!(1, deleted_count);
+
+        let res = storage.get(&_type1(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##);
+        assert_match!(Err(WalletStorageError::ItemNotFound), res);
+
+        storage.get(&_type1(), &_id2(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+        storage.get(&_type2(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+
+        let deleted_count = storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap();
+        assert_eq!(1, deleted_count);
+    }
+
     #[test]
     fn postgres_storage_delete_works_for_non_existing() {
         _cleanup();
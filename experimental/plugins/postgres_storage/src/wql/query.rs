@@ -32,6 +32,19 @@ pub fn wql_to_sql_count<'a>(class: &'a Vec<u8>, op: &'a Operator) -> Result<(Str
     Ok((convert_query_to_psql_args(&query_string), arguments))
 }
 
+// Select of ids of items matching the query, used as subquery of delete by query
+pub fn wql_to_sql_ids<'a>(class: &'a Vec<u8>, op: &'a Operator) -> Result<(String, Vec<&'a dyn ToSql>), WalletQueryError> {
+    let mut arguments: Vec<&dyn ToSql> = Vec::new();
+    arguments.push(class);
+    let clause_string = operator_to_sql(op, &mut arguments)?;
+    let mut query_string = "SELECT i.id FROM items as i WHERE i.type = $$".to_string();
+    if !clause_string.is_empty() {
+        query_string.push_str(" AND ");
+        query_string.push_str(&clause_string);
+    }
+    Ok((convert_query_to_psql_args(&query_string), arguments))
+}
+
 fn convert_query_to_psql_args(query: &str) -> String {
     let mut index = 1;
     let mut s: String = query.to_owned();
@@ -29,8 +29,9 @@ impl EncryptedValue {
 
     pub fn from_bytes(joined_data: &[u8]) -> Result<Self, CommonError> {
         // value_key is stored as NONCE || CYPHERTEXT. Lenth of CYPHERTHEXT is length of DATA + length of TAG.
+        // Single AEAD values have no value_key and can be shorter, they are stored as is
         if joined_data.len() < ENCRYPTED_KEY_LEN {
-            return Err(CommonError::InvalidStructure(format!("Unable to split value_key from value: value too short")));
+            return Ok(EncryptedValue { data: joined_data.to_owned(), key: Vec::new() });
         }
 
         let value_key = joined_data[..ENCRYPTED_KEY_LEN].to_owned();
@@ -71,7 +72,7 @@ impl StorageRecord {
     }
 }
 
-pub trait StorageIterator {
+pub trait StorageIterator: Send {
     fn next(&mut self) -> Result<Option<StorageRecord>, WalletStorageError>;
     fn get_total_count(&self) -> Result<Option<usize>, WalletStorageError>;
 }
@@ -79,11 +80,13 @@ pub trait StorageIterator {
 pub trait WalletStorage {
     fn get(&self, type_: &[u8], id: &[u8], options: &str) -> Result<StorageRecord, WalletStorageError>;
     fn add(&self, type_: &[u8], id: &[u8], value: &EncryptedValue, tags: &[Tag]) -> Result<(), WalletStorageError>;
+    fn add_records(&self, records: &[StorageRecord]) -> Result<(), WalletStorageError>;
     fn update(&self, type_: &[u8], id: &[u8], value: &EncryptedValue) -> Result<(), WalletStorageError>;
     fn add_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> Result<(), WalletStorageError>;
     fn update_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> Result<(), WalletStorageError>;
     fn delete_tags(&self, type_: &[u8], id: &[u8], tag_names: &[TagName]) -> Result<(), WalletStorageError>;
     fn delete(&self, type_: &[u8], id: &[u8]) -> Result<(), WalletStorageError>;
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> Result<usize, WalletStorageError>;
     fn get_storage_metadata(&self) -> Result<Vec<u8>, WalletStorageError>;
     fn set_storage_metadata(&self, metadata: &[u8]) -> Result<(), WalletStorageError>;
     fn get_all(&self) -> Result<Box<dyn StorageIterator>, WalletStorageError>;
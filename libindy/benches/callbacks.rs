@@ -0,0 +1,111 @@
+#[macro_use]
+extern crate criterion;
+
+#[macro_use]
+extern crate lazy_static;
+
+extern crate futures;
+extern crate indy;
+extern crate indyrs;
+extern crate indy_sys;
+
+use criterion::{Criterion, Benchmark};
+
+use futures::Future;
+
+use std::thread;
+
+const TARGET_DID: &str = "VsKV7grR1BUE29mG2Fm2kX";
+const THREADS_COUNT: usize = 8;
+const COMMANDS_PER_THREAD: usize = 50;
+
+// Callback routing the Rust wrapper used before command slots: one global map of senders
+// per result shape, locked on submit and again on completion
+mod mutex_map {
+    use super::*;
+
+    use std::collections::HashMap;
+    use std::ffi::{CStr, CString};
+    use std::os::raw::c_char;
+    use std::ptr;
+    use std::sync::Mutex;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    use futures::sync::oneshot;
+    use indy_sys::{CommandHandle, Error};
+    use indyrs::ErrorCode;
+
+    lazy_static! {
+        static ref CALLBACKS: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<String, ErrorCode>>>> = Default::default();
+        static ref IDS_COUNTER: AtomicUsize = AtomicUsize::new(1);
+    }
+
+    extern fn callback(command_handle: CommandHandle, err: Error, str1: *const c_char) {
+        let tx = CALLBACKS.lock().unwrap().remove(&command_handle).unwrap();
+
+        let res = if err != 0 {
+            Err(ErrorCode::from(err))
+        } else {
+            Ok(unsafe { CStr::from_ptr(str1) }.to_str().unwrap().to_string())
+        };
+
+        tx.send(res).unwrap();
+    }
+
+    pub fn build_get_nym_request(target_did: &str) -> Result<String, ErrorCode> {
+        let (tx, rx) = oneshot::channel();
+        let command_handle = (IDS_COUNTER.fetch_add(1, Ordering::SeqCst) + 1) as CommandHandle;
+        CALLBACKS.lock().unwrap().insert(command_handle, tx);
+
+        let target_did = CString::new(target_did).unwrap();
+
+        let err = unsafe {
+            indy_sys::ledger::indy_build_get_nym_request(command_handle, ptr::null(), target_did.as_ptr(), Some(callback))
+        };
+
+        if err != 0 {
+            CALLBACKS.lock().unwrap().remove(&command_handle);
+            return Err(ErrorCode::from(err));
+        }
+
+        rx.wait().unwrap()
+    }
+}
+
+fn build_get_nym_request_slots() {
+    indyrs::ledger::build_get_nym_request(None, TARGET_DID).wait().unwrap();
+}
+
+fn build_get_nym_request_mutex_map() {
+    mutex_map::build_get_nym_request(TARGET_DID).unwrap();
+}
+
+fn concurrent(build: fn()) {
+    let threads: Vec<_> = (0..THREADS_COUNT).map(|_| {
+        thread::spawn(move || {
+            for _ in 0..COMMANDS_PER_THREAD {
+                build();
+            }
+        })
+    }).collect();
+
+    for thread in threads {
+        thread.join().unwrap();
+    }
+}
+
+fn bench(c: &mut Criterion) {
+    c.bench(
+        "callback_routing",
+        Benchmark::new("build_get_nym_request_slots", |b| b.iter(build_get_nym_request_slots))
+            .with_function("build_get_nym_request_mutex_map", |b| b.iter(build_get_nym_request_mutex_map)));
+
+    c.bench(
+        "callback_routing_concurrent",
+        Benchmark::new("build_get_nym_request_slots", |b| b.iter(|| concurrent(build_get_nym_request_slots)))
+            .with_function("build_get_nym_request_mutex_map", |b| b.iter(|| concurrent(build_get_nym_request_mutex_map)))
+            .sample_size(20));
+}
+
+criterion_group!(benches, bench);
+criterion_main!(benches);
@@ -0,0 +1,444 @@
+#[macro_use]
+extern crate criterion;
+
+#[macro_use]
+extern crate lazy_static;
+
+#[macro_use]
+extern crate named_type_derive;
+
+#[macro_use]
+extern crate derivative;
+
+#[macro_use]
+extern crate serde_derive;
+
+#[macro_use]
+extern crate serde_json;
+
+extern crate byteorder;
+extern crate indy;
+extern crate ursa;
+extern crate uuid;
+extern crate named_type;
+extern crate rmp_serde;
+extern crate rust_base58;
+extern crate time;
+extern crate serde;
+extern crate rand;
+extern crate futures;
+extern crate indyrs;
+extern crate indy_utils;
+extern crate zmq;
+
+// Workaround to share some utils code based on indy sdk types between tests and indy sdk
+use indy::api as api;
+
+#[path = "../tests/utils/mod.rs"]
+#[macro_use]
+mod utils;
+
+use crate::utils::test::TestUtils;
+use crate::utils::constants::*;
+
+use criterion::{Criterion, Benchmark};
+
+mod simulated_nodes {
+    use super::*;
+
+    use std::sync::Arc;
+    use std::sync::atomic::{AtomicBool, Ordering};
+    use std::thread;
+
+    use futures::Future;
+    use indyrs::PoolHandle;
+    use indy_utils::crypto::ed25519_sign;
+    use rust_base58::ToBase58;
+
+    pub const NODES_COUNT: usize = 4;
+    // Period the nodes thread checks whether it should stop
+    const POLL_TIMEOUT_MS: i64 = 100;
+
+    /// Simulated nodes: ROUTER sockets with their own keys bound to free local ports that confirm ledger
+    /// status of the client and give the same reply on every request, so read requests reach consensus.
+    ///
+    /// Nodes are stopped when dropped.
+    pub struct SimulatedNodes {
+        pub txns: String,
+        stop: Arc<AtomicBool>,
+        thread: Option<thread::JoinHandle<()>>,
+    }
+
+    impl SimulatedNodes {
+        pub fn start() -> SimulatedNodes {
+            let ctx = zmq::Context::new();
+
+            let (txns, sockets): (Vec<String>, Vec<zmq::Socket>) = (0..NODES_COUNT).map(|i| {
+                let (vk, sk) = ed25519_sign::create_key_pair_for_signature(None).unwrap();
+                let curve_sk = ed25519_sign::sk_to_curve25519(&sk).unwrap();
+
+                let socket = ctx.socket(zmq::SocketType::ROUTER).unwrap();
+                socket.set_curve_server(true).unwrap();
+                socket.set_curve_secretkey(&curve_sk[..]).unwrap();
+                socket.bind("tcp://127.0.0.1:*").unwrap();
+
+                let endpoint = socket.get_last_endpoint().unwrap().unwrap();
+                let port: u16 = endpoint[endpoint.rfind(':').unwrap() + 1..].parse().unwrap();
+
+                let txn = json!({
+                    "reqSignature": {},
+                    "txn": {
+                        "data": {
+                            "data": {
+                                "alias": format!("Node{}", i + 1),
+                                "client_ip": "127.0.0.1",
+                                "client_port": port,
+                                "node_ip": "127.0.0.1",
+                                "node_port": port,
+                                "services": ["VALIDATOR"]
+                            },
+                            "dest": vk[..].to_base58()
+                        },
+                        "metadata": {"from": "Th7MpTaRZVRYnPiabds81Y"},
+                        "type": "0"
+                    },
+                    "txnMetadata": {"seqNo": i + 1},
+                    "ver": "1"
+                }).to_string();
+
+                (txn, socket)
+            }).unzip();
+
+            let stop = Arc::new(AtomicBool::new(false));
+            let thread_stop = stop.clone();
+
+            let thread = thread::spawn(move || {
+                let _ctx = ctx;
+                simulate_nodes(sockets, &thread_stop)
+            });
+
+            SimulatedNodes { txns: txns.join("\n"), stop, thread: Some(thread) }
+        }
+    }
+
+    impl Drop for SimulatedNodes {
+        fn drop(&mut self) {
+            self.stop.store(true, Ordering::SeqCst);
+
+            if let Some(thread) = self.thread.take() {
+                thread.join().unwrap();
+            }
+        }
+    }
+
+    fn simulate_nodes(sockets: Vec<zmq::Socket>, stop: &AtomicBool) {
+        while !stop.load(Ordering::SeqCst) {
+            let readable: Vec<bool> = {
+                let mut poll_items: Vec<zmq::PollItem> = sockets.iter().map(|socket| socket.as_poll_item(zmq::POLLIN)).collect();
+                zmq::poll(&mut poll_items, POLL_TIMEOUT_MS).unwrap();
+                poll_items.iter().map(|item| item.is_readable()).collect()
+            };
+
+            for (socket, _) in sockets.iter().zip(readable).filter(|&(_, readable)| readable) {
+                while let Ok(parts) = socket.recv_multipart(zmq::DONTWAIT) {
+                    if let Some(reply) = node_reply(&String::from_utf8_lossy(&parts[1])) {
+                        socket.send_multipart(&[parts[0].as_slice(), reply.as_bytes()], zmq::DONTWAIT).unwrap();
+                    }
+                }
+            }
+        }
+    }
+
+    fn node_reply(msg: &str) -> Option<String> {
+        if msg == "pi" {
+            return Some("po".to_string());
+        }
+
+        let msg: serde_json::Value = serde_json::from_str(msg).ok()?;
+
+        if msg["op"] == "LEDGER_STATUS" {
+            return Some(msg.to_string());
+        }
+
+        Some(json!({
+            "op": "REPLY",
+            "result": {
+                "reqId": msg["reqId"].as_u64()?,
+                "identifier": msg["identifier"],
+                "type": msg["operation"]["type"],
+                "dest": msg["operation"]["dest"],
+                "data": null,
+                "seqNo": null,
+                "txnTime": null
+            }
+        }).to_string())
+    }
+
+    pub fn get_nym(pool_handle: PoolHandle, request: &str) {
+        indyrs::ledger::submit_request(pool_handle, request).wait().unwrap();
+    }
+}
+
+mod shared_pool_io {
+    use super::*;
+
+    use std::ffi::CString;
+
+    use futures::Future;
+    use indyrs::PoolHandle;
+
+    use crate::utils::pool::{create_genesis_txn_file, create_pool_ledger_config, pool_config_json};
+    use super::simulated_nodes::{SimulatedNodes, get_nym};
+
+    pub const POOLS_COUNT: usize = 50;
+    pub const IO_THREADS_COUNT: usize = 4;
+
+    fn set_io_threads_count(count: usize) {
+        let config = CString::new(json!({"pool_io_threads_count": count}).to_string()).unwrap();
+        api::indy_set_runtime_config(config.as_ptr());
+    }
+
+    fn open_pools(mode: &str, txns: &str) -> Vec<PoolHandle> {
+        (0..POOLS_COUNT).map(|i| {
+            let pool_name = format!("shared_pool_io_{}_{}", mode, i);
+            let txn_file_path = create_genesis_txn_file(&pool_name, txns, None);
+            create_pool_ledger_config(&pool_name, Some(&pool_config_json(&txn_file_path))).unwrap();
+            indyrs::pool::open_pool_ledger(&pool_name, None).wait().unwrap()
+        }).collect()
+    }
+
+    #[cfg(target_os = "linux")]
+    fn threads_count() -> usize {
+        ::std::fs::read_to_string("/proc/self/status").unwrap()
+            .lines()
+            .find(|line| line.starts_with("Threads:"))
+            .and_then(|line| line["Threads:".len()..].trim().parse().ok())
+            .unwrap()
+    }
+
+    // Dedicated mode starts a thread per pool while shared mode uses a fixed set of I/O threads
+    #[cfg(target_os = "linux")]
+    fn check_threads_count(io_threads_count: usize, threads_before: usize) {
+        if io_threads_count == 0 {
+            assert!(threads_count() >= threads_before + POOLS_COUNT);
+        } else {
+            assert!(threads_count() <= threads_before + io_threads_count);
+        }
+    }
+
+    #[cfg(not(target_os = "linux"))]
+    fn threads_count() -> usize { 0 }
+
+    #[cfg(not(target_os = "linux"))]
+    fn check_threads_count(_io_threads_count: usize, _threads_before: usize) {}
+
+    pub fn bench(c: &mut Criterion) {
+        TestUtils::cleanup_storage();
+
+        let nodes = SimulatedNodes::start();
+        crate::utils::pool::set_protocol_version(2).unwrap();
+
+        let request = indyrs::ledger::build_get_nym_request(None, DID_TRUSTEE).wait().unwrap();
+
+        for &(mode, io_threads_count) in [("dedicated", 0), ("shared", IO_THREADS_COUNT)].iter() {
+            set_io_threads_count(io_threads_count);
+
+            let threads_before = threads_count();
+            let pools = open_pools(mode, &nodes.txns);
+            check_threads_count(io_threads_count, threads_before);
+
+            let bench_pools = pools.clone();
+            let bench_request = request.clone();
+            let mut i = 0;
+
+            c.bench(
+                "pool_io_50_pools",
+                Benchmark::new(format!("pool_io_get_nym_{}", mode), move |b|
+                    b.iter(|| {
+                        i += 1;
+                        get_nym(bench_pools[i % bench_pools.len()], &bench_request)
+                    }))
+                    .sample_size(20));
+
+            for pool_handle in pools {
+                crate::utils::pool::close(pool_handle).unwrap();
+            }
+        }
+
+        set_io_threads_count(0);
+    }
+}
+
+mod pool_socket_reuse {
+    use super::*;
+
+    use std::collections::HashMap;
+    use std::sync::Arc;
+    use std::sync::atomic::{AtomicBool, Ordering};
+    use std::thread;
+
+    use futures::Future;
+    use indyrs::PoolHandle;
+    use serde_json::Value;
+
+    use crate::utils::pool::{create_genesis_txn_file, create_pool_ledger_config, pool_config_json};
+    use super::simulated_nodes::{SimulatedNodes, get_nym};
+
+    pub const CONN_ACTIVE_TIMEOUT: i64 = 1;
+    pub const CONN_IDLE_TIMEOUT: i64 = 10;
+    pub const CLIENTS_COUNT: usize = 8;
+
+    // Short active timeout retires pool connections every second, so sustained load goes through many generations
+    fn open_pool(mode: &str, txns: &str, conn_idle_timeout: i64) -> PoolHandle {
+        let pool_name = format!("pool_socket_reuse_{}", mode);
+        let txn_file_path = create_genesis_txn_file(&pool_name, txns, None);
+        create_pool_ledger_config(&pool_name, Some(&pool_config_json(&txn_file_path))).unwrap();
+
+        let config = json!({
+            "conn_active_timeout": CONN_ACTIVE_TIMEOUT,
+            "conn_idle_timeout": conn_idle_timeout,
+        }).to_string();
+
+        indyrs::pool::open_pool_ledger(&pool_name, Some(&config)).wait().unwrap()
+    }
+
+    fn sockets_count(label: &str) -> usize {
+        let metrics = crate::utils::metrics::collect_metrics().unwrap();
+        let metrics = serde_json::from_str::<HashMap<String, Value>>(&metrics).unwrap();
+
+        metrics["pool_sockets_count"].as_array().unwrap()
+            .iter()
+            .find(|metric| metric["tags"]["label"] == label)
+            .unwrap()["value"].as_u64().unwrap() as usize
+    }
+
+    /// Clients that send the next request as soon as they get the reply to the previous one.
+    ///
+    /// Clients are stopped when dropped.
+    struct Load {
+        stop: Arc<AtomicBool>,
+        clients: Vec<thread::JoinHandle<()>>,
+    }
+
+    impl Load {
+        fn start(pool_handle: PoolHandle, request: &str) -> Load {
+            let stop = Arc::new(AtomicBool::new(false));
+
+            let clients = (0..CLIENTS_COUNT).map(|_| {
+                let request = request.to_string();
+                let stop = stop.clone();
+                thread::spawn(move || {
+                    while !stop.load(Ordering::SeqCst) {
+                        get_nym(pool_handle, &request);
+                    }
+                })
+            }).collect();
+
+            Load { stop, clients }
+        }
+    }
+
+    impl Drop for Load {
+        fn drop(&mut self) {
+            self.stop.store(true, Ordering::SeqCst);
+
+            for client in self.clients.drain(..) {
+                client.join().unwrap();
+            }
+        }
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        TestUtils::cleanup_storage();
+
+        let nodes = SimulatedNodes::start();
+        crate::utils::pool::set_protocol_version(2).unwrap();
+
+        let request = indyrs::ledger::build_get_nym_request(None, DID_TRUSTEE).wait().unwrap();
+
+        let mut opened_by_mode = Vec::new();
+
+        for &(mode, conn_idle_timeout) in [("fresh_sockets", 0), ("reused_sockets", CONN_IDLE_TIMEOUT)].iter() {
+            let pool_handle = open_pool(mode, &nodes.txns, conn_idle_timeout);
+
+            let opened = sockets_count("opened");
+            let reused = sockets_count("reused");
+
+            let load = Load::start(pool_handle, &request);
+            let bench_request = request.clone();
+
+            // Latency of a request sent while other clients keep the pool busy
+            c.bench(
+                "pool_socket_reuse",
+                Benchmark::new(format!("pool_get_nym_under_load_{}", mode), move |b|
+                    b.iter(|| get_nym(pool_handle, &bench_request)))
+                    .sample_size(20));
+
+            drop(load);
+
+            let reused = sockets_count("reused") - reused;
+            assert_eq!(conn_idle_timeout > 0, reused > 0);
+
+            opened_by_mode.push(sockets_count("opened") - opened);
+
+            crate::utils::pool::close(pool_handle).unwrap();
+        }
+
+        // Reused sockets save reconnects on every connection generation
+        assert!(opened_by_mode[1] < opened_by_mode[0]);
+    }
+}
+
+mod request_handles {
+    use super::*;
+
+    use indyrs::{PoolHandle, WalletHandle};
+
+    use crate::utils::{did, ledger, wallet};
+    use crate::utils::pool::{create_genesis_txn_file, create_pool_ledger_config, pool_config_json};
+    use super::simulated_nodes::SimulatedNodes;
+
+    // JSON flow parses and serializes the request on every step, handle flow keeps it inside libindy
+    fn build_sign_submit_json(pool_handle: PoolHandle, wallet_handle: WalletHandle, did: &str) {
+        let request = ledger::build_nym_request(did, DID_MY1, Some(VERKEY_MY1), None, None).unwrap();
+        ledger::sign_and_submit_request(pool_handle, wallet_handle, did, &request).unwrap();
+    }
+
+    fn build_sign_submit_handle(pool_handle: PoolHandle, wallet_handle: WalletHandle, did: &str) {
+        let request_handle = ledger::build_nym_request_handle(did, DID_MY1, Some(VERKEY_MY1), None, None).unwrap();
+        ledger::sign_and_submit_request_handle(pool_handle, wallet_handle, did, request_handle).unwrap();
+        ledger::release_request_handle(request_handle).unwrap();
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        TestUtils::cleanup_storage();
+
+        let nodes = SimulatedNodes::start();
+        crate::utils::pool::set_protocol_version(2).unwrap();
+
+        let pool_name = "request_handles";
+        let txn_file_path = create_genesis_txn_file(pool_name, &nodes.txns, None);
+        create_pool_ledger_config(pool_name, Some(&pool_config_json(&txn_file_path))).unwrap();
+        let pool_handle = crate::utils::pool::open_pool_ledger(pool_name, None).unwrap();
+
+        let (wallet_handle, wallet_config) = wallet::create_and_open_default_wallet("request_handles").unwrap();
+        let (did, _) = did::create_and_store_my_did(wallet_handle, Some(TRUSTEE_SEED)).unwrap();
+
+        let json_did = did.clone();
+        let handle_did = did;
+
+        c.bench(
+            "ledger_build_sign_submit",
+            Benchmark::new("build_sign_submit_nym_json", move |b|
+                b.iter(|| build_sign_submit_json(pool_handle, wallet_handle, &json_did)))
+                .with_function("build_sign_submit_nym_handle", move |b|
+                    b.iter(|| build_sign_submit_handle(pool_handle, wallet_handle, &handle_did)))
+                .sample_size(20));
+
+        wallet::close_and_delete_wallet(wallet_handle, &wallet_config).unwrap();
+        crate::utils::pool::close(pool_handle).unwrap();
+    }
+}
+
+criterion_group!(benches, shared_pool_io::bench, pool_socket_reuse::bench, request_handles::bench);
+criterion_main!(benches);
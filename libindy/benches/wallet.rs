@@ -26,6 +26,10 @@ extern crate rust_base58;
 extern crate time;
 extern crate serde;
 extern crate rand;
+extern crate futures;
+extern crate indyrs;
+extern crate indy_utils;
+extern crate zmq;
 
 // Workaround to share some utils code based on indy sdk types between tests and indy sdk
 use indy::api as api;
@@ -447,6 +451,539 @@ mod search_records {
     }
 }
 
+mod create_key {
+    use super::*;
+
+    use std::ffi::CString;
+    use std::thread;
+    use std::time::Duration;
+
+    pub const BURST_SIZE: usize = 100;
+
+    fn set_key_pool_depth(depth: usize) {
+        let config = CString::new(json!({"key_pool_depth": depth}).to_string()).unwrap();
+        api::indy_set_runtime_config(config.as_ptr());
+    }
+
+    fn setup() {
+        // give background refill time to catch up between bursts
+        thread::sleep(Duration::from_millis(200));
+    }
+
+    fn create_keys(wallet_handle: WalletHandle) {
+        for _ in 0..BURST_SIZE {
+            crate::utils::crypto::create_key(wallet_handle, None).unwrap();
+        }
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        set_key_pool_depth(0);
+        let wallet_handle = init_wallet();
+
+        c.bench(
+            "wallet_create_key",
+            Benchmark::new("wallet_create_key_burst", move |b|
+                b.iter_with_setup(setup, |()| create_keys(wallet_handle)))
+                .sample_size(10));
+
+        set_key_pool_depth(BURST_SIZE);
+        let wallet_handle = init_wallet();
+
+        c.bench(
+            "wallet_create_key",
+            Benchmark::new("wallet_create_key_burst_key_pool", move |b|
+                b.iter_with_setup(setup, |()| create_keys(wallet_handle)))
+                .sample_size(10));
+
+        set_key_pool_depth(0);
+    }
+}
+
+mod pack_message {
+    use super::*;
+
+    use std::ffi::CString;
+
+    pub const RELATIONSHIPS_COUNT: usize = 100;
+    pub const MESSAGES_COUNT: usize = 10_000;
+
+    fn set_box_key_cache_size(size: usize) {
+        let config = CString::new(json!({"box_key_cache_size": size}).to_string()).unwrap();
+        api::indy_set_runtime_config(config.as_ptr());
+    }
+
+    // Both sides of every pairwise relationship live in the same wallet, so it packs and unpacks
+    fn setup(wallet_handle: WalletHandle) -> Vec<(String, String)> {
+        (0..RELATIONSHIPS_COUNT)
+            .map(|_| (crate::utils::crypto::create_key(wallet_handle, None).unwrap(),
+                      crate::utils::crypto::create_key(wallet_handle, None).unwrap()))
+            .collect()
+    }
+
+    fn exchange_messages(wallet_handle: WalletHandle, relationships: &[(String, String)]) {
+        for i in 0..MESSAGES_COUNT {
+            let (my_vk, their_vk) = &relationships[i % relationships.len()];
+            let receivers = json!([their_vk]).to_string();
+
+            let jwe = crate::utils::crypto::pack_message(wallet_handle, MESSAGE.as_bytes(), &receivers, Some(my_vk)).unwrap();
+            crate::utils::crypto::unpack_message(wallet_handle, &jwe).unwrap();
+        }
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        for &(name, size) in [("pack_message_authcrypt", 0), ("pack_message_authcrypt_box_key_cache", RELATIONSHIPS_COUNT)].iter() {
+            set_box_key_cache_size(size);
+            let wallet_handle = init_wallet();
+            let relationships = setup(wallet_handle);
+
+            c.bench(
+                "pack_message_10k_messages_100_relationships",
+                Benchmark::new(name, move |b|
+                    b.iter(|| exchange_messages(wallet_handle, &relationships)))
+                    .sample_size(10));
+        }
+
+        set_box_key_cache_size(0);
+    }
+}
+
+mod export {
+    use super::*;
+
+    use std::fs;
+
+    pub const RECORDS_COUNT: usize = 1_000_000;
+    // 1% of records is changed between exports
+    pub const CHURN_COUNT: usize = RECORDS_COUNT / 100;
+
+    fn _export_config(name: &str, base_path: Option<&str>) -> String {
+        let path = crate::utils::wallet::export_wallet_path(name);
+        let _ = fs::remove_file(&path);
+
+        json!({
+            "path": path.to_str().unwrap(),
+            "key": "export_key",
+            "key_derivation_method": "ARGON2I_INT",
+            "base_path": base_path,
+        }).to_string()
+    }
+
+    fn pre_setup() -> WalletHandle {
+        TestUtils::cleanup_storage();
+
+        let config = json!({"id": "wallet_export", "storage_config": {"track_changes": true}}).to_string();
+
+        WalletUtils::create_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+        let wallet_handle = WalletUtils::open_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+
+        for i in 0..RECORDS_COUNT {
+            NonSecretsUtils::add_wallet_record(wallet_handle, &_type(i), &_id(i), &_value(i), Some(&_tags(i))).unwrap();
+        }
+
+        wallet_handle
+    }
+
+    // Differential export must be based on the latest export of the wallet, so a fresh full export is made first
+    fn setup(wallet_handle: WalletHandle) -> String {
+        crate::utils::wallet::export_wallet(wallet_handle, &_export_config("wallet_export_full", None)).unwrap();
+
+        for _ in 0..CHURN_COUNT {
+            let i = rand::thread_rng().gen_range(0, RECORDS_COUNT);
+            NonSecretsUtils::update_wallet_record_value(wallet_handle, &_type(i), &_id(i), &_value(i + RECORDS_COUNT)).unwrap();
+        }
+
+        let base_path = crate::utils::wallet::export_wallet_path("wallet_export_full");
+        _export_config("wallet_export_diff", Some(base_path.to_str().unwrap()))
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        let wallet_handle = pre_setup();
+
+        c.bench(
+            "wallet_export",
+            Benchmark::new("wallet_export_full", move |b|
+                b.iter_with_setup(|| _export_config("wallet_export_full", None),
+                                  |config| crate::utils::wallet::export_wallet(wallet_handle, &config).unwrap()))
+                .sample_size(10));
+
+        c.bench(
+            "wallet_export",
+            Benchmark::new("wallet_export_differential", move |b|
+                b.iter_with_setup(|| setup(wallet_handle),
+                                  |config| crate::utils::wallet::export_wallet(wallet_handle, &config).unwrap()))
+                .sample_size(10));
+    }
+}
+
+mod open_wallets {
+    use super::*;
+
+    pub const WALLETS_COUNT: usize = 1_000;
+
+    fn _config(i: usize) -> String {
+        json!({"id": format!("wallet_open_many_{}", i)}).to_string()
+    }
+
+    fn pre_setup() {
+        TestUtils::cleanup_storage();
+
+        for i in 0..WALLETS_COUNT {
+            crate::utils::wallet::create_wallet(&_config(i), WALLET_CREDENTIALS_ARGON2I_INT).unwrap();
+        }
+    }
+
+    // Wallets are closed on drop which isn't measured
+    struct OpenedWallets(Vec<WalletHandle>);
+
+    impl Drop for OpenedWallets {
+        fn drop(&mut self) {
+            for wallet_handle in self.0.iter() {
+                crate::utils::wallet::close_wallet(*wallet_handle).unwrap();
+            }
+        }
+    }
+
+    fn open_one_by_one() -> Vec<WalletHandle> {
+        (0..WALLETS_COUNT)
+            .map(|i| crate::utils::wallet::open_wallet(&_config(i), WALLET_CREDENTIALS_ARGON2I_INT).unwrap())
+            .collect()
+    }
+
+    fn open_bulk() -> Vec<WalletHandle> {
+        let credentials: serde_json::Value = serde_json::from_str(WALLET_CREDENTIALS_ARGON2I_INT).unwrap();
+
+        let params: Vec<serde_json::Value> = (0..WALLETS_COUNT)
+            .map(|i| json!({"config": {"id": format!("wallet_open_many_{}", i)}, "credentials": credentials}))
+            .collect();
+
+        let results = crate::utils::wallet::open_wallets(&json!(params).to_string()).unwrap();
+        let results: Vec<serde_json::Value> = serde_json::from_str(&results).unwrap();
+
+        results.iter()
+            .map(|result| WalletHandle(result["wallet_handle"].as_i64().unwrap() as i32))
+            .collect()
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        pre_setup();
+
+        c.bench(
+            "wallet_open_many",
+            Benchmark::new("wallet_open_one_by_one", |b|
+                b.iter_with_large_drop(|| OpenedWallets(open_one_by_one())))
+                .sample_size(10));
+
+        c.bench(
+            "wallet_open_many",
+            Benchmark::new("wallet_open_bulk", |b|
+                b.iter_with_large_drop(|| OpenedWallets(open_bulk())))
+                .sample_size(10));
+    }
+}
+
+mod record_format {
+    use super::*;
+
+    pub const RECORDS_COUNT: usize = 1_000_000;
+
+    static mut INDEX: usize = RECORDS_COUNT;
+
+    fn pre_setup(record_format: &str) -> WalletHandle {
+        let config = json!({"id": format!("wallet_record_format_{}", record_format), "record_format": record_format}).to_string();
+
+        WalletUtils::create_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+        let wallet_handle = WalletUtils::open_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+
+        for i in 0..RECORDS_COUNT {
+            NonSecretsUtils::add_wallet_record(wallet_handle, &_type(i), &_id(i), &_value(i), None).unwrap();
+        }
+
+        wallet_handle
+    }
+
+    fn next_index() -> usize {
+        unsafe {
+            INDEX = INDEX + 1;
+            INDEX
+        }
+    }
+
+    fn bench_format(c: &mut Criterion, record_format: &'static str) {
+        let wallet_handle = pre_setup(record_format);
+
+        c.bench(
+            "wallet_record_format",
+            Benchmark::new(format!("wallet_get_record_{}", record_format), move |b|
+                b.iter_with_setup(|| {
+                    let i = rand::thread_rng().gen_range(0, RECORDS_COUNT);
+                    (_type(i), _id(i))
+                }, |(type_, id)| NonSecretsUtils::get_wallet_record(wallet_handle, &type_, &id, "{}").unwrap()))
+                .sample_size(50));
+
+        c.bench(
+            "wallet_record_format",
+            Benchmark::new(format!("wallet_add_record_{}", record_format), move |b|
+                b.iter_with_setup(|| {
+                    let i = next_index();
+                    (_type(i), _id(i), _value(i))
+                }, |(type_, id, value)| NonSecretsUtils::add_wallet_record(wallet_handle, &type_, &id, &value, None).unwrap()))
+                .sample_size(10));
+
+        c.bench(
+            "wallet_record_format",
+            Benchmark::new(format!("wallet_update_record_value_{}", record_format), move |b|
+                b.iter_with_setup(|| {
+                    let i = rand::thread_rng().gen_range(0, RECORDS_COUNT);
+                    (_type(i), _id(i), _value(i + RECORDS_COUNT))
+                }, |(type_, id, value)| NonSecretsUtils::update_wallet_record_value(wallet_handle, &type_, &id, &value).unwrap()))
+                .sample_size(10));
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        TestUtils::cleanup_storage();
+
+        bench_format(c, "KEY_WRAPPED");
+        bench_format(c, "SINGLE_AEAD");
+    }
+}
+
+mod purge_records {
+    use super::*;
+
+    use std::fs;
+
+    pub const RECORDS_COUNT: usize = 500_000;
+    pub const PURGE_TYPE: &'static str = "purge_type";
+    pub const PURGE_QUERY: &'static str = r#"{"~timestamp": {"$lt": "2"}}"#;
+
+    static mut LAST_WALLET: Option<(WalletHandle, usize)> = None;
+
+    fn _config(i: usize) -> String {
+        json!({"id": format!("wallet_purge_{}", i)}).to_string()
+    }
+
+    fn _export_config() -> String {
+        json!({
+            "path": crate::utils::wallet::export_wallet_path("wallet_purge").to_str().unwrap(),
+            "key": "export_key",
+            "key_derivation_method": "ARGON2I_INT",
+        }).to_string()
+    }
+
+    // Every iteration purges a fresh copy of the wallet imported from the export made once
+    fn pre_setup() {
+        TestUtils::cleanup_storage();
+        let _ = fs::remove_file(crate::utils::wallet::export_wallet_path("wallet_purge"));
+
+        let config = json!({"id": "wallet_purge"}).to_string();
+
+        crate::utils::wallet::create_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+        let wallet_handle = crate::utils::wallet::open_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+
+        let tags = json!({"~timestamp": "1"}).to_string();
+
+        for i in 0..RECORDS_COUNT {
+            crate::utils::non_secrets::add_wallet_record(wallet_handle, PURGE_TYPE, &_id(i), &_value(i), Some(&tags)).unwrap();
+        }
+
+        crate::utils::wallet::export_wallet(wallet_handle, &_export_config()).unwrap();
+        crate::utils::wallet::close_wallet(wallet_handle).unwrap();
+    }
+
+    fn setup() -> WalletHandle {
+        unsafe {
+            if let Some((wallet_handle, i)) = LAST_WALLET.take() {
+                crate::utils::wallet::close_wallet(wallet_handle).unwrap();
+                crate::utils::wallet::delete_wallet(&_config(i), WALLET_CREDENTIALS_RAW).unwrap();
+            }
+        }
+
+        let i = SequenceUtils::get_next_id() as usize;
+
+        crate::utils::wallet::import_wallet(&_config(i), WALLET_CREDENTIALS_RAW, &_export_config()).unwrap();
+        let wallet_handle = crate::utils::wallet::open_wallet(&_config(i), WALLET_CREDENTIALS_RAW).unwrap();
+
+        unsafe { LAST_WALLET = Some((wallet_handle, i)); }
+
+        wallet_handle
+    }
+
+    // The way purge was done before storage level delete by query
+    fn search_and_delete(wallet_handle: WalletHandle) {
+        let options = json!({"retrieveType": false, "retrieveValue": false, "retrieveTags": false}).to_string();
+        let search_handle = crate::utils::non_secrets::open_wallet_search(wallet_handle, PURGE_TYPE, PURGE_QUERY, &options).unwrap();
+
+        loop {
+            let records = crate::utils::non_secrets::fetch_wallet_search_next_records(wallet_handle, search_handle, 1000).unwrap();
+            let records: serde_json::Value = serde_json::from_str(&records).unwrap();
+
+            let records = match records["records"].as_array() {
+                Some(records) if !records.is_empty() => records.clone(),
+                _ => break
+            };
+
+            for record in records {
+                crate::utils::non_secrets::delete_wallet_record(wallet_handle, PURGE_TYPE, record["id"].as_str().unwrap()).unwrap();
+            }
+        }
+
+        crate::utils::non_secrets::close_wallet_search(search_handle).unwrap();
+    }
+
+    fn delete_records(wallet_handle: WalletHandle) {
+        let deleted_count = crate::utils::non_secrets::delete_wallet_records(wallet_handle, PURGE_TYPE, PURGE_QUERY).unwrap();
+        assert_eq!(RECORDS_COUNT, deleted_count as usize);
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        pre_setup();
+
+        c.bench(
+            "wallet_purge_records",
+            Benchmark::new("wallet_purge_search_and_delete", |b|
+                b.iter_with_setup(setup, search_and_delete))
+                .sample_size(10));
+
+        c.bench(
+            "wallet_purge_records",
+            Benchmark::new("wallet_purge_delete_records", |b|
+                b.iter_with_setup(setup, delete_records))
+                .sample_size(10));
+    }
+}
+
+mod credential_definition_key_pool {
+    use super::*;
+
+    // Every iteration uses its own set of attributes, so it never gets keys from the pool filled for another one.
+    // Background refill started by the warm iterations keeps running while the next one is measured.
+    fn schema(prefix: &str) -> String {
+        let i = SequenceUtils::get_next_id();
+        let attrs = json!(["name", "age", format!("{}_{}", prefix, i)]).to_string();
+        let (_, schema_json) = crate::utils::anoncreds::issuer_create_schema(ISSUER_DID, &format!("{}_{}", prefix, i), "1.0", &attrs).unwrap();
+        schema_json
+    }
+
+    fn setup_warm(wallet_handle: WalletHandle) -> String {
+        let schema_json = schema("warm");
+        crate::utils::anoncreds::issuer_fill_credential_def_key_pool(wallet_handle, &schema_json, &json!({"size": 1}).to_string()).unwrap();
+        schema_json
+    }
+
+    fn create_cred_def(wallet_handle: WalletHandle, schema_json: &str) {
+        crate::utils::anoncreds::issuer_create_credential_definition(wallet_handle, ISSUER_DID, schema_json, TAG_1, None, None).unwrap();
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        let wallet_handle = init_wallet();
+
+        c.bench(
+            "credential_definition_create",
+            Benchmark::new("credential_definition_create_cold", move |b|
+                b.iter_with_setup(|| schema("cold"), |schema_json| create_cred_def(wallet_handle, &schema_json)))
+                .sample_size(10));
+
+        c.bench(
+            "credential_definition_create",
+            Benchmark::new("credential_definition_create_warm_key_pool", move |b|
+                b.iter_with_setup(|| setup_warm(wallet_handle), |schema_json| create_cred_def(wallet_handle, &schema_json)))
+                .sample_size(10));
+    }
+}
+
+mod compaction {
+    use super::*;
+
+    pub const ROUNDS: usize = 20;
+    pub const LIVE_PER_ROUND: usize = 1_000;
+    pub const CHURN_PER_LIVE: usize = 10;
+    pub const GROUPS_COUNT: usize = 100;
+    pub const LIVE_TYPE: &'static str = "compaction_live";
+    pub const CHURN_TYPE: &'static str = "compaction_churn";
+
+    // Records that stay in the wallet are added between records that are deleted soon after,
+    // so after aging they are scattered across pages that are mostly free
+    fn pre_setup() -> WalletHandle {
+        TestUtils::cleanup_storage();
+
+        let config = json!({"id": "wallet_compaction"}).to_string();
+
+        crate::utils::wallet::create_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+        let wallet_handle = crate::utils::wallet::open_wallet(&config, WALLET_CREDENTIALS_RAW).unwrap();
+
+        let value = "v".repeat(512);
+
+        for round in 0..ROUNDS {
+            for i in 0..LIVE_PER_ROUND {
+                let id = round * LIVE_PER_ROUND + i;
+                let tags = json!({"group": format!("{}", id % GROUPS_COUNT)}).to_string();
+                crate::utils::non_secrets::add_wallet_record(wallet_handle, LIVE_TYPE, &_id(id), &value, Some(&tags)).unwrap();
+
+                for j in 0..CHURN_PER_LIVE {
+                    let id = id * CHURN_PER_LIVE + j;
+                    crate::utils::non_secrets::add_wallet_record(wallet_handle, CHURN_TYPE, &_id(id), &value, Some(&_tags(id))).unwrap();
+                }
+            }
+
+            crate::utils::non_secrets::delete_wallet_records(wallet_handle, CHURN_TYPE, "{}").unwrap();
+        }
+
+        wallet_handle
+    }
+
+    fn search_group(wallet_handle: WalletHandle) {
+        let query = json!({"group": format!("{}", rand::thread_rng().gen_range(0, GROUPS_COUNT))}).to_string();
+        let search_handle = crate::utils::non_secrets::open_wallet_search(wallet_handle, LIVE_TYPE, &query, "{}").unwrap();
+
+        crate::utils::non_secrets::fetch_wallet_search_next_records(wallet_handle, search_handle, ROUNDS * LIVE_PER_ROUND / GROUPS_COUNT).unwrap();
+        crate::utils::non_secrets::close_wallet_search(search_handle).unwrap();
+    }
+
+    fn compact(wallet_handle: WalletHandle) {
+        loop {
+            let progress = crate::utils::wallet::compact_wallet(wallet_handle, None).unwrap();
+            let progress: serde_json::Value = serde_json::from_str(&progress).unwrap();
+
+            if progress["done"].as_bool().unwrap() {
+                break;
+            }
+        }
+    }
+
+    fn storage_size(label: &str) -> u64 {
+        let metrics = crate::utils::metrics::collect_metrics().unwrap();
+        let metrics: serde_json::Value = serde_json::from_str(&metrics).unwrap();
+
+        metrics["wallet_storage_size"].as_array().unwrap()
+            .iter()
+            .find(|metric| metric["tags"]["label"] == label)
+            .unwrap()["value"].as_u64().unwrap()
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        let wallet_handle = pre_setup();
+
+        let free = storage_size("free");
+        assert!(free > 0);
+
+        c.bench(
+            "wallet_compaction",
+            Benchmark::new("wallet_search_aged", move |b|
+                b.iter(|| search_group(wallet_handle)))
+                .sample_size(20));
+
+        compact(wallet_handle);
+
+        assert!(storage_size("free") < free);
+
+        c.bench(
+            "wallet_compaction",
+            Benchmark::new("wallet_search_compacted", move |b|
+                b.iter(|| search_group(wallet_handle)))
+                .sample_size(20));
+    }
+}
+
 pub const COUNT: usize = 1000;
 pub const TYPE_1: &'static str = "type_1";
 pub const TYPE_2: &'static str = "type_2";
@@ -508,5 +1045,13 @@ criterion_group!(benches, create::bench,
                           add_record::bench,
                           add_record_tags::bench,
                           delete_record_tags::bench,
-                          search_records::bench);
+                          search_records::bench,
+                          create_key::bench,
+                          pack_message::bench,
+                          export::bench,
+                          open_wallets::bench,
+                          record_format::bench,
+                          purge_records::bench,
+                          credential_definition_key_pool::bench,
+                          compaction::bench);
 criterion_main!(benches);
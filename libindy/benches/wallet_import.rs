@@ -0,0 +1,164 @@
+#[macro_use]
+extern crate criterion;
+
+#[macro_use]
+extern crate lazy_static;
+
+#[macro_use]
+extern crate named_type_derive;
+
+#[macro_use]
+extern crate derivative;
+
+#[macro_use]
+extern crate serde_derive;
+
+#[macro_use]
+extern crate serde_json;
+
+extern crate byteorder;
+extern crate indy;
+extern crate ursa;
+extern crate uuid;
+extern crate named_type;
+extern crate rmp_serde;
+extern crate rust_base58;
+extern crate time;
+extern crate serde;
+extern crate rand;
+extern crate futures;
+extern crate indyrs;
+extern crate indy_utils;
+extern crate zmq;
+extern crate indy_api_types;
+
+// Workaround to share some utils code based on indy sdk types between tests and indy sdk
+use indy::api as api;
+
+#[path = "../tests/utils/mod.rs"]
+#[macro_use]
+mod utils;
+
+use crate::utils::constants::*;
+
+use criterion::{Criterion, Benchmark};
+
+// Import of a large export is slow, so it has its own bench target
+mod import_load {
+    use super::*;
+
+    use std::collections::HashMap;
+    use std::fs::File;
+    use std::io::{BufWriter, Write};
+
+    use byteorder::{LittleEndian, WriteBytesExt};
+    use indy_api_types::domain::wallet::Record;
+    use indy_utils::crypto::chacha20poly1305_ietf;
+    use indy_utils::crypto::hash::hash;
+    use rust_base58::FromBase58;
+
+    pub const RECORDS_COUNT: usize = 10_000_000;
+
+    const EXPORT_NAME: &'static str = "wallet_import_load_export";
+    const EXPORT_KEY: &'static str = "8dvfYSt5d1taSd6yJdpjq4emkwsPDDLYxkNFysFD2cZY";
+    const CHUNK_SIZE: usize = 1024;
+
+    // The same layout as the header of wallet export file, only the raw key variant is written
+    #[allow(dead_code)]
+    #[derive(Serialize)]
+    enum EncryptionMethod {
+        ChaCha20Poly1305IETF { salt: Vec<u8>, nonce: Vec<u8>, chunk_size: usize },
+        ChaCha20Poly1305IETFInteractive { salt: Vec<u8>, nonce: Vec<u8>, chunk_size: usize },
+        ChaCha20Poly1305IETFRaw { nonce: Vec<u8>, chunk_size: usize },
+    }
+
+    #[derive(Serialize)]
+    struct Header {
+        encryption_method: EncryptionMethod,
+        time: u64,
+        version: u32,
+    }
+
+    fn _import_config() -> String {
+        json!({
+            "path": crate::utils::wallet::export_wallet_path(EXPORT_NAME).to_str().unwrap(),
+            "key": EXPORT_KEY,
+            "key_derivation_method": "RAW",
+        }).to_string()
+    }
+
+    fn _config(shards: usize) -> String {
+        json!({"id": format!("wallet_import_load_{}", shards), "storage_config": {"shards": shards}}).to_string()
+    }
+
+    fn _record(i: usize) -> Record {
+        let mut tags = HashMap::new();
+        tags.insert("tag_id_1".to_string(), format!("tag_value_{}_1", i));
+        tags.insert("tag_id_2".to_string(), format!("tag_value_{}_2", i));
+        tags.insert("~tag_id_3".to_string(), format!("{}", i));
+
+        Record { type_: format!("type_{}", i % 2 + 1), id: format!("id_{}", i), value: format!("value_{}", i), tags }
+    }
+
+    // Adding 10M records one by one takes hours, so the export file is written directly
+    // and kept between runs
+    fn pre_setup() {
+        let path = crate::utils::wallet::export_wallet_path(EXPORT_NAME);
+
+        if path.exists() {
+            return;
+        }
+
+        let key = chacha20poly1305_ietf::Key::from_slice(&EXPORT_KEY.from_base58().unwrap()).unwrap();
+        let nonce = chacha20poly1305_ietf::gen_nonce();
+
+        let header = rmp_serde::to_vec(&Header {
+            encryption_method: EncryptionMethod::ChaCha20Poly1305IETFRaw { nonce: nonce[..].to_vec(), chunk_size: CHUNK_SIZE },
+            time: 0,
+            version: 0,
+        }).unwrap();
+
+        let mut writer = BufWriter::new(File::create(&path).unwrap());
+        writer.write_u32::<LittleEndian>(header.len() as u32).unwrap();
+        writer.write_all(&header).unwrap();
+
+        let mut writer = chacha20poly1305_ietf::Writer::new(writer, key, nonce, CHUNK_SIZE);
+        writer.write_all(&hash(&header).unwrap()).unwrap();
+
+        for i in 0..RECORDS_COUNT {
+            let record = rmp_serde::to_vec(&_record(i)).unwrap();
+            writer.write_u32::<LittleEndian>(record.len() as u32).unwrap();
+            writer.write_all(&record).unwrap();
+        }
+
+        writer.write_u32::<LittleEndian>(0).unwrap();
+        writer.flush().unwrap();
+    }
+
+    fn setup(config: &str) {
+        let _ = crate::utils::wallet::delete_wallet(config, WALLET_CREDENTIALS_RAW);
+    }
+
+    fn import_wallet(config: &str) {
+        crate::utils::wallet::import_wallet(config, WALLET_CREDENTIALS_RAW, &_import_config()).unwrap();
+    }
+
+    pub fn bench(c: &mut Criterion) {
+        pre_setup();
+
+        for &shards in [1, 4].iter() {
+            let config = _config(shards);
+
+            c.bench(
+                "wallet_import_load",
+                Benchmark::new(format!("wallet_import_10m_records_{}_shards", shards), move |b|
+                    b.iter_with_setup(|| setup(&config), |()| import_wallet(&config)))
+                    .sample_size(10));
+
+            crate::utils::wallet::delete_wallet(&_config(shards), WALLET_CREDENTIALS_RAW).unwrap();
+        }
+    }
+}
+
+criterion_group!(benches, import_load::bench);
+criterion_main!(benches);
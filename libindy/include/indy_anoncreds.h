@@ -31,6 +31,15 @@ extern "C" {
                                                                                          const char*   cred_def_json)
                                                                     );
 
+    extern indy_error_t indy_issuer_fill_credential_def_key_pool(indy_handle_t command_handle,
+                                                                 indy_handle_t wallet_handle,
+                                                                 const char *  schema_json,
+                                                                 const char *  config_json,
+
+                                                                 void           (*cb)(indy_handle_t command_handle_,
+                                                                                      indy_error_t  err)
+                                                                 );
+
     extern indy_error_t indy_issuer_rotate_credential_def_start(indy_handle_t command_handle,
                                                                 indy_handle_t wallet_handle,
                                                                 const char *  cred_def_id,
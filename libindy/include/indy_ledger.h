@@ -576,7 +576,8 @@ extern "C" {
     /// ledger_type: (Optional) type of the ledger the requested transaction belongs to:
     ///     DOMAIN - used default,
     ///     POOL,
-    ///     CONFIG
+    ///     CONFIG,
+    ///     AUDIT
     ///     any number
     /// seq_no: seq_no of transaction in ledger.
     /// cb: Callback that takes command result as parameter.
@@ -1405,6 +1406,294 @@ extern "C" {
                                                                           const char*   out_request_json)
                                                      );
 
+    /// Builds a NYM request and keeps it in libindy as an opaque request handle.
+    ///
+    /// Request handles allow to build, sign, multi-sign and submit a request without passing request json
+    /// through the FFI and parsing it again on every step.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// submitter_did, target_did, verkey, alias, role: the same as for indy_build_nym_request.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request handle.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_build_nym_request_handle(indy_handle_t command_handle,
+                                                      const char *  submitter_did,
+                                                      const char *  target_did,
+                                                      const char *  verkey,
+                                                      const char *  alias,
+                                                      const char *  role,
+
+                                                      void           (*cb)(indy_handle_t command_handle_,
+                                                                           indy_error_t  err,
+                                                                           indy_handle_t request_handle)
+                                                      );
+
+    /// Builds an ATTRIB request and keeps it in libindy as an opaque request handle.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// submitter_did, target_did, hash, raw, enc: the same as for indy_build_attrib_request.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request handle.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_build_attrib_request_handle(indy_handle_t command_handle,
+                                                         const char *  submitter_did,
+                                                         const char *  target_did,
+                                                         const char *  hash,
+                                                         const char *  raw,
+                                                         const char *  enc,
+
+                                                         void           (*cb)(indy_handle_t command_handle_,
+                                                                              indy_error_t  err,
+                                                                              indy_handle_t request_handle)
+                                                         );
+
+    /// Parses request json once and keeps it in libindy as an opaque request handle.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// request_json: Request data json.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request handle.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_request_handle_from_json(indy_handle_t command_handle,
+                                                      const char *  request_json,
+
+                                                      void           (*cb)(indy_handle_t command_handle_,
+                                                                           indy_error_t  err,
+                                                                           indy_handle_t request_handle)
+                                                      );
+
+    /// Returns json representation of the request kept by request handle.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request json.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_request_handle_to_json(indy_handle_t command_handle,
+                                                    indy_handle_t request_handle,
+
+                                                    void           (*cb)(indy_handle_t command_handle_,
+                                                                         indy_error_t  err,
+                                                                         const char*   request_json)
+                                                    );
+
+    /// Signs the request kept by request handle in place.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// wallet_handle: wallet handle (created by open_wallet).
+    /// submitter_did: Id of Identity stored in secured Wallet.
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Errors
+    /// Common*
+    /// Wallet*
+    /// Ledger*
+    /// Crypto*
+    extern indy_error_t indy_sign_request_handle(indy_handle_t command_handle,
+                                                 indy_handle_t wallet_handle,
+                                                 const char *  submitter_did,
+                                                 indy_handle_t request_handle,
+
+                                                 void           (*cb)(indy_handle_t command_handle_,
+                                                                      indy_error_t  err)
+                                                 );
+
+    /// Multi signs the request kept by request handle in place.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// wallet_handle: wallet handle (created by open_wallet).
+    /// submitter_did: Id of Identity stored in secured Wallet.
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Errors
+    /// Common*
+    /// Wallet*
+    /// Ledger*
+    /// Crypto*
+    extern indy_error_t indy_multi_sign_request_handle(indy_handle_t command_handle,
+                                                       indy_handle_t wallet_handle,
+                                                       const char *  submitter_did,
+                                                       indy_handle_t request_handle,
+
+                                                       void           (*cb)(indy_handle_t command_handle_,
+                                                                            indy_error_t  err)
+                                                       );
+
+    /// Publishes the request kept by request handle to validator pool.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// pool_handle: pool handle (created by open_pool_ledger).
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request result as json.
+    ///
+    /// #Errors
+    /// Common*
+    /// Ledger*
+    extern indy_error_t indy_submit_request_handle(indy_handle_t command_handle,
+                                                   indy_handle_t pool_handle,
+                                                   indy_handle_t request_handle,
+
+                                                   void           (*cb)(indy_handle_t command_handle_,
+                                                                        indy_error_t  err,
+                                                                        const char*   request_result_json)
+                                                   );
+
+    /// Signs the request kept by request handle and submits it to validator pool.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// pool_handle: pool handle (created by open_pool_ledger).
+    /// wallet_handle: wallet handle (created by open_wallet).
+    /// submitter_did: Id of Identity stored in secured Wallet.
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Request result as json.
+    ///
+    /// #Errors
+    /// Common*
+    /// Wallet*
+    /// Ledger*
+    /// Crypto*
+    extern indy_error_t indy_sign_and_submit_request_handle(indy_handle_t command_handle,
+                                                            indy_handle_t pool_handle,
+                                                            indy_handle_t wallet_handle,
+                                                            const char *  submitter_did,
+                                                            indy_handle_t request_handle,
+
+                                                            void           (*cb)(indy_handle_t command_handle_,
+                                                                                 indy_error_t  err,
+                                                                                 const char*   request_result_json)
+                                                            );
+
+    /// Releases the request kept by request handle.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// request_handle: request handle.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_release_request_handle(indy_handle_t command_handle,
+                                                    indy_handle_t request_handle,
+
+                                                    void           (*cb)(indy_handle_t command_handle_,
+                                                                         indy_error_t  err)
+                                                    );
+
+    /// Opens a range of transactions of the ledger to fetch it by pages (with indy_fetch_ledger_txns_range).
+    ///
+    /// Size and root hash of the ledger are taken from the consistency proof returned by f+1 nodes.
+    /// Every fetched page is verified by consistency proof against this root hash,
+    /// so the transactions are the same as f+1 nodes store.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// pool_handle: pool handle (created by open_pool_ledger).
+    /// ledger_type: (Optional) type of the ledger the requested transactions belong to:
+    ///     DOMAIN - used default,
+    ///     POOL,
+    ///     CONFIG,
+    ///     AUDIT
+    ///     any number
+    /// from: sequence number of the first transaction of the range (starts from 1).
+    /// to: sequence number of the last transaction of the range.
+    ///     The range is truncated to the current size of the ledger.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// txns_range_handle: Handle of the range that can be used later
+    ///   to fetch transactions by pages (with indy_fetch_ledger_txns_range)
+    ///
+    /// #Errors
+    /// Common*
+    /// Ledger*
+    /// Pool*
+    extern indy_error_t indy_open_ledger_txns_range(indy_handle_t command_handle,
+                                                    indy_handle_t pool_handle,
+                                                    const char *  ledger_type,
+                                                    indy_i32_t    from,
+                                                    indy_i32_t    to,
+
+                                                    void           (*cb)(indy_handle_t command_handle_,
+                                                                         indy_error_t  err,
+                                                                         indy_handle_t txns_range_handle)
+                                                    );
+
+    /// Fetches next page of transactions of the range opened by indy_open_ledger_txns_range.
+    ///
+    /// Page can contain less transactions than requested if nodes limit the size of the reply.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// txns_range_handle: ledger transactions range handle (created by indy_open_ledger_txns_range).
+    /// count: maximal count of transactions to fetch.
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Returns
+    /// Transactions json ordered by sequence number:
+    /// [<ledger transaction>, ...]
+    /// Empty list means that all transactions of the range are fetched.
+    ///
+    /// #Errors
+    /// Common*
+    /// Ledger*
+    /// Pool*
+    extern indy_error_t indy_fetch_ledger_txns_range(indy_handle_t command_handle,
+                                                     indy_handle_t txns_range_handle,
+                                                     indy_u32_t    count,
+
+                                                     void           (*cb)(indy_handle_t command_handle_,
+                                                                          indy_error_t  err,
+                                                                          const char*   txns_json)
+                                                     );
+
+    /// Closes ledger transactions range (make range handle invalid).
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context.
+    /// txns_range_handle: ledger transactions range handle (created by indy_open_ledger_txns_range).
+    /// cb: Callback that takes command result as parameter.
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_close_ledger_txns_range(indy_handle_t command_handle,
+                                                     indy_handle_t txns_range_handle,
+
+                                                     void           (*cb)(indy_handle_t command_handle_,
+                                                                          indy_error_t  err)
+                                                     );
+
 #ifdef __cplusplus
 }
 #endif
@@ -144,6 +144,35 @@ extern "C" {
                                                                        indy_error_t err)
                                                  );
 
+    /// Delete all wallet records of the type matching the query
+    ///
+    /// Matching records are deleted by wallet storage at once (in one statement or transaction if storage supports it)
+    /// instead of searching and deleting records one by one.
+    ///
+    /// #Params
+    /// command_handle: command handle to map callback to caller context
+    /// wallet_handle: wallet handle (created by open_wallet)
+    /// type_: allows to separate different record types collections
+    /// query_json: MongoDB style query to wallet record tags (the same as query_json of indy_open_wallet_search):
+    ///  {
+    ///    "tagName": "tagValue",
+    ///    $or: {
+    ///      "tagName2": { $regex: 'pattern' },
+    ///      "tagName3": { $gte: '123' },
+    ///    },
+    ///  }
+    /// #Returns
+    /// deleted_count: the number of deleted records
+
+    extern indy_error_t indy_delete_wallet_records(indy_handle_t  command_handle,
+                                                   indy_handle_t  wallet_handle,
+                                                   const char*    type_,
+                                                   const char*    query_json,
+                                                   void           (*fn)(indy_handle_t command_handle_,
+                                                                        indy_error_t err,
+                                                                        indy_u32_t deleted_count)
+                                                  );
+
     /// Get an wallet record by id
     ///
     /// #Params
@@ -144,6 +144,54 @@ extern "C" {
                                                   void         (*fn)(indy_handle_t command_handle_, indy_error_t err)
                                                   );
 
+    /// Register optional bulk add handler of custom wallet storage implementation.
+    ///
+    /// If registered, libindy passes batches of records to this handler instead of calling add_record
+    /// handler for every record (for example, on wallet import). The storage type must be registered
+    /// with indy_register_wallet_storage call before.
+    ///
+    /// #Params
+    /// command_handle: Command handle to map callback to caller context.
+    /// type_: Wallet type name.
+    /// add_records: WalletType add records operation handler. records_json is a json array:
+    ///   [{"type": string, "id": string, "value": <base64 encoded value>, "tags": {}}]
+    ///
+    /// #Returns
+    /// Error code
+
+    extern indy_error_t indy_register_wallet_storage_add_records(indy_handle_t  command_handle,
+                                                                 const char*    type_,
+                                                                 indy_error_t (*addRecordsFn)(indy_handle_t handle,
+                                                                                              const char* records_json),
+
+                                                                 void         (*fn)(indy_handle_t command_handle_, indy_error_t err)
+                                                                 );
+
+    /// Register optional delete by query handler of custom wallet storage implementation.
+    ///
+    /// If registered, libindy passes the query to this handler to delete all matching records at once
+    /// (for example, on indy_delete_wallet_records call) instead of searching and deleting records one
+    /// by one. The storage type must be registered with indy_register_wallet_storage call before.
+    ///
+    /// #Params
+    /// command_handle: Command handle to map callback to caller context.
+    /// type_: Wallet type name.
+    /// delete_records: WalletType delete records operation handler. query_json has the same format
+    ///   as query_json of search records handler, the number of deleted records is stored to deleted_count_p.
+    ///
+    /// #Returns
+    /// Error code
+
+    extern indy_error_t indy_register_wallet_storage_delete_records(indy_handle_t  command_handle,
+                                                                    const char*    type_,
+                                                                    indy_error_t (*deleteRecordsFn)(indy_handle_t handle,
+                                                                                                    const char* type_,
+                                                                                                    const char* query_json,
+                                                                                                    indy_u32_t* deleted_count_p),
+
+                                                                    void         (*fn)(indy_handle_t command_handle_, indy_error_t err)
+                                                                    );
+
     /// Create a new secure wallet.
     ///
     /// #Params
@@ -161,7 +209,18 @@ extern "C" {
     ///     "path": optional<string>, Path to the directory with wallet files.
     ///             Defaults to $HOME/.indy_client/wallet.
     ///             Wallet will be stored in the file {path}/{id}/sqlite.db
+    ///     "shards": optional<int>, Number of files to spread wallet records across. Defaults to 1.
+    ///               Sharded wallet is stored in the files {path}/{id}/shard_{n}.db, its records are written
+    ///               to shards in parallel. Sharded wallets can't be exported differentially.
+    ///     "shard_by": optional<string>, 'id' (default) spreads records of every type across all shards,
+    ///                 'type' keeps all records of a type in one shard, so searches read one shard only.
+    ///     "track_changes": optional<bool>, Keep a log of changed records needed for differential export.
+    ///                      Defaults to false. Once enabled, it stays enabled for the wallet.
     ///   }
+    ///   "record_format": optional<string>, Format of wallet records: 'KEY_WRAPPED' or 'SINGLE_AEAD'. Defaults to 'KEY_WRAPPED'.
+    ///                    'KEY_WRAPPED' encrypts every value with its own random key stored next to the value.
+    ///                    'SINGLE_AEAD' encrypts every value once with the key derived from the record name (smaller and faster).
+    ///                    Format is chosen on wallet creation, wallets can be migrated by export and import.
     /// }
     /// credentials: Wallet credentials json
     /// {
@@ -246,6 +305,39 @@ extern "C" {
                                          void           (*fn)(indy_handle_t command_handle_, indy_error_t err, indy_handle_t handle)
                                         );
 
+    /// Open the set of wallets.
+    ///
+    /// Intended for services that serve many wallets and open them all at start. Storages are opened
+    /// one by one, but wallet keys are derived in parallel on the dedicated thread pool
+    /// (see "open_wallets_thread_pool_size" of indy_set_runtime_config), so it doesn't compete
+    /// with other expensive crypto operations.
+    ///
+    /// #Params
+    /// wallets: List of wallets to open.
+    ///   [
+    ///       {
+    ///           "config": Wallet configuration json (see indy_open_wallet),
+    ///           "credentials": Wallet credentials json (see indy_open_wallet),
+    ///       },
+    ///       ...
+    ///   ]
+    ///
+    /// #Returns
+    /// err: Error code
+    /// results_json: Result for every wallet in the same order as in the request:
+    ///   [
+    ///       { "wallet_handle": int } - handle of opened wallet,
+    ///       { "error_code": int, "message": string } - wallet wasn't opened,
+    ///       ...
+    ///   ]
+    ///
+    /// #Errors
+    /// Common*
+    extern indy_error_t indy_open_wallets(indy_handle_t  command_handle,
+                                          const char*    wallets,
+                                          void           (*fn)(indy_handle_t command_handle_, indy_error_t err, const char* results_json)
+                                         );
+
     /// Exports opened wallet
     ///
     /// #Params:
@@ -260,6 +352,11 @@ extern "C" {
     ///                              ARGON2I_INT - derive secured export key (less secured but faster)
     ///                              RAW - raw export key provided (skip derivation).
     ///                                RAW keys can be generated with indy_generate_wallet_key call
+    ///     "base_path": optional<string> Path of the previous export of this wallet. If set only records
+    ///                  changed since that export are exported (differential export). Key derivation method and salt
+    ///                  of the base export are reused, so the same key must be provided.
+    ///                  Supported only for wallets with default storage created with "track_changes".
+    ///                  Every export prunes deleted records from the log, so the base must be the latest export.
     ///   }
     ///
     /// #Returns
@@ -295,7 +392,18 @@ extern "C" {
     ///     "path": optional<string>, Path to the directory with wallet files.
     ///             Defaults to $HOME/.indy_client/wallet.
     ///             Wallet will be stored in the file {path}/{id}/sqlite.db
+    ///     "shards": optional<int>, Number of files to spread wallet records across. Defaults to 1.
+    ///               Sharded wallet is stored in the files {path}/{id}/shard_{n}.db, its records are written
+    ///               to shards in parallel. Sharded wallets can't be exported differentially.
+    ///     "shard_by": optional<string>, 'id' (default) spreads records of every type across all shards,
+    ///                 'type' keeps all records of a type in one shard, so searches read one shard only.
+    ///     "track_changes": optional<bool>, Keep a log of changed records needed for differential export.
+    ///                      Defaults to false. Once enabled, it stays enabled for the wallet.
     ///   }
+    ///   "record_format": optional<string>, Format of wallet records: 'KEY_WRAPPED' or 'SINGLE_AEAD'. Defaults to 'KEY_WRAPPED'.
+    ///                    'KEY_WRAPPED' encrypts every value with its own random key stored next to the value.
+    ///                    'SINGLE_AEAD' encrypts every value once with the key derived from the record name (smaller and faster).
+    ///                    Format is chosen on wallet creation, wallets can be migrated by export and import.
     /// }
     /// credentials: Wallet credentials json
     /// {
@@ -314,6 +422,8 @@ extern "C" {
     /// {
     ///   "path": <string>, path of the file that contains exported wallet content
     ///   "key": <string>, key used for export of the wallet
+    ///   "differential_paths": optional<array<string>> paths of differential exports based on the export from "path".
+    ///                         They are applied in order of export and must form a chain without gaps.
     /// }
     ///
     /// #Returns
@@ -393,6 +503,47 @@ extern "C" {
                                            void           (*fn)(indy_handle_t command_handle_, indy_error_t err)
                                           );
 
+    /// Runs one step of online compaction of opened wallet storage.
+    ///
+    /// Long-lived wallets that add and delete many records keep the space of deleted records and
+    /// their indexes become fragmented. Compaction pass rebuilds indexes and returns free space to
+    /// the file system in bounded steps, so the wallet stays open and other commands run between steps.
+    /// Call it until "done" is true, the next call starts a new pass.
+    ///
+    /// Steps that rebuild an index aren't bounded by "max_pages", one such step takes time
+    /// proportional to the size of the index.
+    ///
+    /// Only default storage supports compaction. The first step for a wallet created by the previous
+    /// versions of libindy converts its storage to allow incremental compaction. Conversion rewrites
+    /// the whole storage once and isn't bounded by "max_pages".
+    /// Conversion can't run while searches of the wallet are open and fails with CommonInvalidState,
+    /// close them and call it again.
+    ///
+    /// #Params
+    /// wallet_handle: wallet handle (created by open_wallet).
+    /// config: (optional) compaction step configuration json.
+    /// {
+    ///   "max_pages": int, (optional) Max number of free storage pages reclaimed by a step, 1024 by default.
+    /// }
+    ///
+    /// #Returns
+    /// err: Error code
+    /// progress_json: State of the storage after the step:
+    /// {
+    ///   "done": bool, Compaction pass is finished,
+    ///   "size": int, Size of the storage in bytes,
+    ///   "free": int, Size of free space still to be reclaimed in bytes,
+    /// }
+    ///
+    /// #Errors
+    /// Common*
+    /// Wallet*
+    extern indy_error_t indy_compact_wallet(indy_handle_t  command_handle,
+                                            indy_handle_t  wallet_handle,
+                                            const char*    config,
+                                            void           (*fn)(indy_handle_t command_handle_, indy_error_t err, const char* progress_json)
+                                           );
+
     /// Generate wallet master key.
     /// Returned key is compatible with "RAW" key derivation method.
     /// It allows to avoid expensive key derivation for use cases when wallet keys can be stored in a secure enclave.
@@ -8,6 +8,24 @@ pub struct Config {
     pub id: String,
     pub storage_type: Option<String>,
     pub storage_config: Option<Value>,
+    // Format of records of the wallet. Only used when the wallet is created or imported
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub record_format: Option<RecordFormat>,
+}
+
+#[allow(non_camel_case_types)]
+#[derive(Debug, Serialize, Deserialize, Clone, Copy, PartialEq)]
+pub enum RecordFormat {
+    // Value is encrypted with random item key that is stored encrypted with wallet value key
+    KEY_WRAPPED,
+    // Value is encrypted once with the key derived from wallet value key and encrypted item name
+    SINGLE_AEAD,
+}
+
+impl Default for RecordFormat {
+    fn default() -> Self {
+        RecordFormat::KEY_WRAPPED
+    }
 }
 
 #[derive(Debug, Serialize, Deserialize, Clone)]
@@ -33,12 +51,25 @@ fn default_key_derivation_method() -> KeyDerivationMethod {
     KeyDerivationMethod::ARGON2I_MOD
 }
 
+// Single entry of indy_open_wallets request
+#[derive(Debug, Deserialize)]
+pub struct OpenWalletParams {
+    pub config: Config,
+    pub credentials: Credentials,
+}
+
 #[derive(Debug, Serialize, Deserialize, Clone)]
 pub struct ExportConfig {
     pub key: String,
     pub path: String,
     #[serde(default = "default_key_derivation_method")]
-    pub key_derivation_method: KeyDerivationMethod
+    pub key_derivation_method: KeyDerivationMethod,
+    // Export: previous export of the wallet. Only changes made after it are exported
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub base_path: Option<String>,
+    // Import: differential exports applied in order after the full export from `path`
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    pub differential_paths: Vec<String>,
 }
 
 #[derive(Debug, Deserialize)]
@@ -46,6 +77,23 @@ pub struct KeyConfig {
     pub seed: Option<String>
 }
 
+#[derive(Debug, Deserialize)]
+pub struct CompactConfig {
+    // Max number of free pages reclaimed by a single compaction step
+    #[serde(default = "default_compact_max_pages")]
+    pub max_pages: usize,
+}
+
+fn default_compact_max_pages() -> usize {
+    1024
+}
+
+impl Default for CompactConfig {
+    fn default() -> Self {
+        CompactConfig { max_pages: default_compact_max_pages() }
+    }
+}
+
 #[derive(Debug, Serialize, Deserialize)]
 pub struct Record {
     // Wallet record type
@@ -70,3 +118,24 @@ impl Validatable for Config {
     }
 }
 
+impl Validatable for Vec<OpenWalletParams> {
+    fn validate(&self) -> Result<(), String> {
+        if self.is_empty() {
+            return Err("List of wallets to open is empty".to_string());
+        }
+        for params in self {
+            params.config.validate()?;
+        }
+        Ok(())
+    }
+}
+
+
+impl Validatable for CompactConfig {
+    fn validate(&self) -> Result<(), String> {
+        if self.max_pages == 0 {
+            return Err("Max pages of compaction step must be greater than 0".to_string());
+        }
+        Ok(())
+    }
+}
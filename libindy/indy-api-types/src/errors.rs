@@ -33,6 +33,8 @@ pub enum IndyErrorKind {
     InvalidParam(u32),
     #[fail(display = "IO error")]
     IOError,
+    #[fail(display = "Command queue is full")]
+    CommandQueueFull,
     // Anoncreds errors
     #[fail(display = "Duplicated master secret")]
     MasterSecretDuplicateName,
@@ -329,6 +331,7 @@ impl From<IndyErrorKind> for ErrorCode {
                     _ => ErrorCode::CommonInvalidState
                 },
             IndyErrorKind::IOError => ErrorCode::CommonIOError,
+            IndyErrorKind::CommandQueueFull => ErrorCode::CommonCommandQueueFull,
             IndyErrorKind::MasterSecretDuplicateName => ErrorCode::AnoncredsMasterSecretDuplicateNameError,
             IndyErrorKind::ProofRejected => ErrorCode::AnoncredsProofRejected,
             IndyErrorKind::RevocationRegistryFull => ErrorCode::AnoncredsRevocationRegistryFullError,
@@ -419,6 +422,7 @@ impl From<ErrorCode> for IndyErrorKind {
             ErrorCode::CommonInvalidParam26 => IndyErrorKind::InvalidParam(26),
             ErrorCode::CommonInvalidParam27 => IndyErrorKind::InvalidParam(27),
             ErrorCode::CommonIOError => IndyErrorKind::IOError,
+            ErrorCode::CommonCommandQueueFull => IndyErrorKind::CommandQueueFull,
             ErrorCode::AnoncredsMasterSecretDuplicateNameError => IndyErrorKind::MasterSecretDuplicateName,
             ErrorCode::AnoncredsProofRejected => IndyErrorKind::ProofRejected,
             ErrorCode::AnoncredsRevocationRegistryFullError => IndyErrorKind::RevocationRegistryFull,
@@ -29,6 +29,9 @@ pub const INVALID_COMMAND_HANDLE : CommandHandle = 0;
 
 pub type StorageHandle = i32;
 
+pub type RequestHandle = i32;
+pub const INVALID_REQUEST_HANDLE : RequestHandle = 0;
+
 #[repr(transparent)]
 #[derive(Debug, Hash, PartialEq, Eq, Copy, Clone, Serialize, Deserialize)]
 pub struct SearchHandle(pub i32);
@@ -144,6 +147,9 @@ pub enum ErrorCode
     // Caller passed invalid value as param 27 (null, invalid json and etc..)
     CommonInvalidParam27 = 129,
 
+    // Command was rejected because the command queue is full
+    CommonCommandQueueFull = 130,
+
     // Wallet errors
     // Caller passed invalid wallet handle
     WalletInvalidHandle = 200,
@@ -332,6 +338,22 @@ pub mod wallet {
                                          value_len: usize,
                                          tags_json: *const c_char) -> ErrorCode;
 
+    /// Create a batch of new records in the wallet storage (optional handler, see indy_register_wallet_storage_add_records)
+    ///
+    /// Either all records are added or none of them.
+    ///
+    /// #Params
+    /// storage_handle: opened storage handle (See open handler)
+    /// records_json: the records to add as json array:
+    ///   [{
+    ///     "type": string, // the same as type_ param of add record handler
+    ///     "id": string, // the same as id param of add record handler
+    ///     "value": string, // base64 encoded value of record
+    ///     "tags": {} // the same as tags_json param of add record handler
+    ///   }]
+    pub type WalletAddRecords = extern fn(storage_handle: StorageHandle,
+                                          records_json: *const c_char) -> ErrorCode;
+
     /// Update a record value
     ///
     /// #Params
@@ -407,6 +429,20 @@ pub mod wallet {
                                             type_: *const c_char,
                                             id: *const c_char) -> ErrorCode;
 
+    /// Delete all records of the type matching the query (optional handler, see indy_register_wallet_storage_delete_records)
+    ///
+    /// Either all matching records are deleted or none of them.
+    ///
+    /// #Params
+    /// storage_handle: opened storage handle (See open handler)
+    /// type_: record type
+    /// query_json: MongoDB style query to wallet record tags (the same as query_json param of search records handler)
+    /// deleted_count_p: pointer to store the number of deleted records
+    pub type WalletDeleteRecords = extern fn(storage_handle: StorageHandle,
+                                             type_: *const c_char,
+                                             query_json: *const c_char,
+                                             deleted_count_p: *mut usize) -> ErrorCode;
+
     /// Get an wallet storage record by id
     ///
     /// #Params
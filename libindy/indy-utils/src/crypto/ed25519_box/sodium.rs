@@ -7,10 +7,12 @@ use self::sodiumoxide::crypto::box_;
 pub const NONCEBYTES: usize = box_::curve25519xsalsa20poly1305::NONCEBYTES;
 pub const PUBLICKEYBYTES: usize = box_::curve25519xsalsa20poly1305::PUBLICKEYBYTES;
 pub const SECRETKEYBYTES: usize = box_::curve25519xsalsa20poly1305::SECRETKEYBYTES;
+pub const PRECOMPUTEDKEYBYTES: usize = box_::curve25519xsalsa20poly1305::PRECOMPUTEDKEYBYTES;
 
 sodium_type!(Nonce, box_::Nonce, NONCEBYTES);
 sodium_type!(PublicKey, box_::PublicKey, PUBLICKEYBYTES);
 sodium_type!(SecretKey, box_::SecretKey, SECRETKEYBYTES);
+sodium_type!(PrecomputedKey, box_::PrecomputedKey, PRECOMPUTEDKEYBYTES);
 
 pub fn encrypt(secret_key: &SecretKey, public_key: &PublicKey, doc: &[u8], nonce: &Nonce) -> Result<Vec<u8>, IndyError> {
     Ok(box_::seal(
@@ -31,6 +33,27 @@ pub fn decrypt(secret_key: &SecretKey, public_key: &PublicKey, doc: &[u8], nonce
         .map_err(|_| IndyError::from_msg(IndyErrorKind::InvalidStructure, "Unable to open sodium _box"))
 }
 
+pub fn precompute(secret_key: &SecretKey, public_key: &PublicKey) -> PrecomputedKey {
+    PrecomputedKey(box_::precompute(&public_key.0, &secret_key.0))
+}
+
+pub fn encrypt_precomputed(key: &PrecomputedKey, doc: &[u8], nonce: &Nonce) -> Result<Vec<u8>, IndyError> {
+    Ok(box_::seal_precomputed(
+        doc,
+        &nonce.0,
+        &key.0,
+    ))
+}
+
+pub fn decrypt_precomputed(key: &PrecomputedKey, doc: &[u8], nonce: &Nonce) -> Result<Vec<u8>, IndyError> {
+    box_::open_precomputed(
+        doc,
+        &nonce.0,
+        &key.0,
+    )
+        .map_err(|_| IndyError::from_msg(IndyErrorKind::InvalidStructure, "Unable to open sodium _box"))
+}
+
 pub fn gen_nonce() -> Nonce {
     Nonce(box_::gen_nonce())
 }
@@ -66,4 +89,28 @@ mod tests {
         assert!(alice_decrypted_text.is_ok());
         assert_eq!(text, alice_decrypted_text.unwrap());
     }
+
+    #[test]
+    fn encrypt_decrypt_precomputed_works() {
+        let text = randombytes(16);
+        let nonce = gen_nonce();
+
+        let (alice_ver_key, alice_sign_key) = ed25519_sign::create_key_pair_for_signature(None).unwrap();
+        let alice_pk = ed25519_sign::vk_to_curve25519(&alice_ver_key).unwrap();
+        let alice_sk = ed25519_sign::sk_to_curve25519(&alice_sign_key).unwrap();
+
+        let (bob_ver_key, bob_sign_key) = ed25519_sign::create_key_pair_for_signature(None).unwrap();
+        let bob_pk = ed25519_sign::vk_to_curve25519(&bob_ver_key).unwrap();
+        let bob_sk = ed25519_sign::sk_to_curve25519(&bob_sign_key).unwrap();
+
+        let alice_key = precompute(&alice_sk, &bob_pk);
+        let bob_key = precompute(&bob_sk, &alice_pk);
+        assert_eq!(alice_key, bob_key);
+
+        let alice_encrypted_text = encrypt_precomputed(&alice_key, &text, &nonce).unwrap();
+        assert_eq!(alice_encrypted_text, encrypt(&alice_sk, &bob_pk, &text, &nonce).unwrap());
+
+        let bob_decrypted_text = decrypt_precomputed(&bob_key, &alice_encrypted_text, &nonce).unwrap();
+        assert_eq!(text, bob_decrypted_text);
+    }
 }
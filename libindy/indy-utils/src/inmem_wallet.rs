@@ -174,6 +174,60 @@ impl InmemWallet {
         ErrorCode::Success
     }
 
+    pub extern "C" fn add_records(xhandle: i32,
+                                  records_json: *const c_char) -> ErrorCode {
+        check_useful_c_str!(records_json, ErrorCode::CommonInvalidStructure);
+
+        let records: Vec<serde_json::Value> = match serde_json::from_str(&records_json) {
+            Ok(records) => records,
+            Err(_) => return ErrorCode::CommonInvalidStructure
+        };
+
+        let mut new_records = Vec::with_capacity(records.len());
+
+        for record in records {
+            let (type_, id, value) = match (record["type"].as_str(), record["id"].as_str(), record["value"].as_str()) {
+                (Some(type_), Some(id), Some(value)) => (type_, id, value),
+                _ => return ErrorCode::CommonInvalidStructure
+            };
+
+            let value = match openssl::base64::decode_block(value) {
+                Ok(value) => value,
+                Err(_) => return ErrorCode::CommonInvalidStructure
+            };
+
+            new_records.push(InmemWalletRecord {
+                type_: CString::new(type_).unwrap(),
+                id: CString::new(id).unwrap(),
+                value,
+                tags: CString::new(record["tags"].to_string()).unwrap(),
+            });
+        }
+
+        let handles = INMEM_OPEN_WALLETS.lock().unwrap();
+
+        if !handles.contains_key(&xhandle) {
+            return ErrorCode::CommonInvalidState;
+        }
+
+        let wallet_context = handles.get(&xhandle).unwrap();
+
+        let mut wallets = INMEM_WALLETS.lock().unwrap();
+
+        if !wallets.contains_key(&wallet_context.id) {
+            return ErrorCode::CommonInvalidState;
+        }
+
+        let wallet = wallets.get_mut(&wallet_context.id).unwrap();
+
+        for record in new_records {
+            let key = InmemWallet::build_record_id(record.type_.to_str().unwrap(), record.id.to_str().unwrap());
+            wallet.records.insert(key, record);
+        }
+
+        ErrorCode::Success
+    }
+
     pub extern "C" fn update_record_value(xhandle: i32,
                                           type_: *const c_char,
                                           id: *const c_char,
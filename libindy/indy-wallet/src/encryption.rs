@@ -189,7 +189,7 @@ pub(super) fn decrypt_storage_record(record: &StorageRecord, keys: &Keys) -> Ind
         .to_indy(IndyErrorKind::WalletEncryptionError, "Record is invalid utf8")?;
 
     let decrypted_value = match record.value {
-        Some(ref value) => Some(value.decrypt(&keys.value_key)?),
+        Some(ref value) => Some(keys.decrypt_value(&record.id, value)?),
         None => None
     };
 
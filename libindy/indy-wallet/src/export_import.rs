@@ -4,6 +4,7 @@ use std::time::{SystemTime, UNIX_EPOCH};
 
 use byteorder::{LittleEndian, ReadBytesExt, WriteBytesExt};
 use rmp_serde;
+use rust_base58::ToBase58;
 
 use indy_api_types::domain::wallet::Record;
 use indy_api_types::domain::wallet::KeyDerivationMethod;
@@ -11,10 +12,14 @@ use indy_api_types::errors::prelude::*;
 use crate::encryption::KeyDerivationData;
 use indy_utils::crypto::{chacha20poly1305_ietf, pwhash_argon2i13};
 use indy_utils::crypto::hash::{hash, HASHBYTES};
+use indy_utils::crypto::randombytes::randombytes;
 
 use super::{Wallet, WalletRecord};
+use super::iterator::WalletChange;
 
 const CHUNK_SIZE: usize = 1024;
+// Number of imported records passed to storage at once
+const IMPORT_BATCH_SIZE: usize = 1000;
 
 #[derive(Debug, Serialize, Deserialize)]
 pub enum EncryptionMethod {
@@ -52,7 +57,27 @@ pub struct Header {
     // Export time in seconds from UNIX Epoch
     pub time: u64,
     // Version of header
-    pub version: u32
+    pub version: u32,
+    // Range of wallet changes covered by export. Absent if wallet storage doesn't track changes
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub changes: Option<Changes>,
+}
+
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct Changes {
+    // Random id shared by full export and all differential exports based on it
+    pub chain_id: String,
+    // Sequence number of the change differential export starts after. None for full export
+    pub since: Option<u64>,
+    // Sequence number of the latest change included into export
+    pub until: u64,
+}
+
+// Entry of differential export stream. Full export stream contains plain records
+#[derive(Debug, Serialize, Deserialize)]
+enum ChangeRecord {
+    Upsert(Record),
+    Delete { type_: String, id: String },
 }
 
 // Note that we use externally tagged enum serialization and header will be represented as:
@@ -67,9 +92,17 @@ pub struct Header {
 //   },
 //   "time": ..,
 //   "version": ..,
+//   "changes": {
+//     "chain_id": ..,
+//     "since": ..,
+//     "until": ..,
+//   },
 // }
+//
+// Differential export is encrypted with the same key as the full export it is based on,
+// so import of full export with all its differential exports derives the key only once.
 
-pub(super) fn export_continue(wallet: &Wallet, writer: &mut dyn Write, version: u32, key: chacha20poly1305_ietf::Key, key_data: &KeyDerivationData) -> IndyResult<()> {
+pub(super) fn export_continue(wallet: &Wallet, writer: &mut dyn Write, version: u32, key: chacha20poly1305_ietf::Key, key_data: &KeyDerivationData, base: Option<&Header>) -> IndyResult<()> {
     let nonce = chacha20poly1305_ietf::gen_nonce();
     let chunk_size = CHUNK_SIZE;
 
@@ -90,12 +123,39 @@ pub(super) fn export_continue(wallet: &Wallet, writer: &mut dyn Write, version:
         }
     };
 
+    let changes = match base {
+        Some(base) => {
+            let base_changes = base.changes.as_ref()
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Base export doesn't contain changes range"))?;
+
+            let until = wallet.get_change_seq()?
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "Wallet storage doesn't track changes"))?;
+
+            if until < base_changes.until {
+                return Err(err_msg(IndyErrorKind::InvalidStructure, "Base export doesn't belong to the wallet"));
+            }
+
+            Some(Changes { chain_id: base_changes.chain_id.clone(), since: Some(base_changes.until), until })
+        }
+        None => wallet.get_change_seq()?
+            .map(|until| Changes { chain_id: randombytes(16).to_base58(), since: None, until })
+    };
+
+    let differential = base.is_some();
+
     let header = Header {
         encryption_method,
         time: SystemTime::now().duration_since(UNIX_EPOCH).unwrap().as_secs(),
-        version
+        version,
+        changes,
     };
 
+    let (since, until) = header.changes.as_ref()
+        .map(|changes| (changes.since.unwrap_or(0), changes.until))
+        .unwrap_or((0, 0));
+
+    let tracks_changes = header.changes.is_some();
+
     let header = rmp_serde::to_vec(&header)
         .to_indy(IndyErrorKind::InvalidState, "Can't serialize wallet export file header")?;
 
@@ -112,28 +172,55 @@ pub(super) fn export_continue(wallet: &Wallet, writer: &mut dyn Write, version:
 
     writer.write_all(&hash(&header)?)?;
 
-    let mut records = wallet.get_all()?;
+    if differential {
+        let mut changes = wallet.get_changes(since, until)?;
 
-    while let Some(WalletRecord { type_, id, value, tags }) = records.next()? {
-        let record = Record {
-            type_: type_.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No type fetched for exported record"))?,
-            id,
-            value: value.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No value fetched for exported record"))?,
-            tags: tags.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No tags fetched for exported record"))?,
-        };
+        while let Some(change) = changes.next()? {
+            let change = match change {
+                WalletChange::Upserted(record) => ChangeRecord::Upsert(_export_record(record)?),
+                WalletChange::Deleted { type_, id } => ChangeRecord::Delete { type_, id },
+            };
 
-        let record = rmp_serde::to_vec(&record)
-            .to_indy(IndyErrorKind::InvalidState, "Can't serialize record")?;
+            let change = rmp_serde::to_vec(&change)
+                .to_indy(IndyErrorKind::InvalidState, "Can't serialize record change")?;
 
-        writer.write_u32::<LittleEndian>(record.len() as u32)?;
-        writer.write_all(&record)?;
+            writer.write_u32::<LittleEndian>(change.len() as u32)?;
+            writer.write_all(&change)?;
+        }
+    } else {
+        let mut records = wallet.get_all()?;
+
+        while let Some(record) = records.next()? {
+            let record = rmp_serde::to_vec(&_export_record(record)?)
+                .to_indy(IndyErrorKind::InvalidState, "Can't serialize record")?;
+
+            writer.write_u32::<LittleEndian>(record.len() as u32)?;
+            writer.write_all(&record)?;
+        }
     }
 
     writer.write_u32::<LittleEndian>(0)?; // END message
     writer.flush()?;
+
+    // Deleted items up to this export are in the export file now, so their log rows aren't needed
+    if tracks_changes {
+        wallet.prune_changes(until)?;
+    }
+
     Ok(())
 }
 
+fn _export_record(record: WalletRecord) -> IndyResult<Record> {
+    let WalletRecord { type_, id, value, tags } = record;
+
+    Ok(Record {
+        type_: type_.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No type fetched for exported record"))?,
+        id,
+        value: value.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No value fetched for exported record"))?,
+        tags: tags.ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No tags fetched for exported record"))?,
+    })
+}
+
 #[cfg(test)]
 fn import<T>(wallet: &Wallet, reader: T, passphrase: &str) -> IndyResult<()> where T: Read {
     let (reader, import_key_derivation_data, nonce, chunk_size, header_bytes) = preparse_file_to_import(reader, passphrase)?;
@@ -141,10 +228,8 @@ fn import<T>(wallet: &Wallet, reader: T, passphrase: &str) -> IndyResult<()> whe
     finish_import(wallet, reader, import_key, nonce, chunk_size, header_bytes)
 }
 
-pub(super) fn preparse_file_to_import<T>(reader: T, passphrase: &str) -> IndyResult<(BufReader<T>, KeyDerivationData, chacha20poly1305_ietf::Nonce, usize, Vec<u8>)> where T: Read {
-    // Reads plain
-    let mut reader = BufReader::new(reader);
-
+/// Reads plain header of export file.
+pub(super) fn read_header<T>(reader: &mut T) -> IndyResult<(Header, Vec<u8>)> where T: Read {
     let header_len = reader.read_u32::<LittleEndian>().map_err(_map_io_err)? as usize;
 
     if header_len == 0 {
@@ -154,13 +239,77 @@ pub(super) fn preparse_file_to_import<T>(reader: T, passphrase: &str) -> IndyRes
     let mut header_bytes = vec![0u8; header_len];
     reader.read_exact(&mut header_bytes).map_err(_map_io_err)?;
 
-    let header: Header = rmp_serde::from_slice(&header_bytes)
+    let header = _parse_header(&header_bytes)?;
+
+    Ok((header, header_bytes))
+}
+
+fn _parse_header(header_bytes: &[u8]) -> IndyResult<Header> {
+    let header: Header = rmp_serde::from_slice(header_bytes)
         .to_indy(IndyErrorKind::InvalidStructure, "Header is malformed json")?;
 
     if header.version != 0 {
         return Err(err_msg(IndyErrorKind::InvalidStructure, "Unsupported version"));
     }
 
+    Ok(header)
+}
+
+/// Checks that differential exports continue the full export one after another without gaps
+/// and are encrypted with the same key. The first header must belong to the full export.
+pub(super) fn check_import_chain(headers: &[Vec<u8>]) -> IndyResult<()> {
+    let headers = headers.iter()
+        .map(|header_bytes| _parse_header(header_bytes))
+        .collect::<IndyResult<Vec<Header>>>()?;
+
+    let (full, diffs) = match headers.split_first() {
+        Some((full, diffs)) if !diffs.is_empty() => (full, diffs),
+        Some((full, _)) if full.changes.as_ref().and_then(|changes| changes.since).is_some() =>
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Differential export can't be imported without full export")),
+        _ => return Ok(())
+    };
+
+    let mut prev = match full.changes {
+        Some(ref changes) if changes.since.is_none() => changes,
+        _ => return Err(err_msg(IndyErrorKind::InvalidStructure, "Base export for differential exports must be full export with changes range"))
+    };
+
+    for diff in diffs {
+        let changes = diff.changes.as_ref()
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Export doesn't contain changes range"))?;
+
+        if changes.chain_id != prev.chain_id {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Differential export is based on another full export"));
+        }
+
+        if changes.since != Some(prev.until) {
+            return Err(err_msg(IndyErrorKind::InvalidStructure,
+                               format!("Differential exports don't form a chain: expected export since {}, got {:?}", prev.until, changes.since)));
+        }
+
+        if _salt(&diff.encryption_method) != _salt(&full.encryption_method) {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Differential export is encrypted with another key"));
+        }
+
+        prev = changes;
+    }
+
+    Ok(())
+}
+
+fn _salt(encryption_method: &EncryptionMethod) -> Option<&[u8]> {
+    match encryption_method {
+        EncryptionMethod::ChaCha20Poly1305IETF { salt, .. } | EncryptionMethod::ChaCha20Poly1305IETFInteractive { salt, .. } => Some(&salt[..]),
+        EncryptionMethod::ChaCha20Poly1305IETFRaw { .. } => None
+    }
+}
+
+pub(super) fn preparse_file_to_import<T>(reader: T, passphrase: &str) -> IndyResult<(BufReader<T>, KeyDerivationData, chacha20poly1305_ietf::Nonce, usize, Vec<u8>)> where T: Read {
+    // Reads plain
+    let mut reader = BufReader::new(reader);
+
+    let (header, header_bytes) = read_header(&mut reader)?;
+
     let key_derivation_method = match header.encryption_method {
         EncryptionMethod::ChaCha20Poly1305IETF { .. } => KeyDerivationMethod::ARGON2I_MOD,
         EncryptionMethod::ChaCha20Poly1305IETFInteractive { .. } => KeyDerivationMethod::ARGON2I_INT,
@@ -211,6 +360,12 @@ pub(super) fn finish_import<T>(wallet: &Wallet, reader: BufReader<T>, key: chach
         return Err(err_msg(IndyErrorKind::InvalidStructure, "Invalid header hash"));
     }
 
+    let differential = _parse_header(&header_bytes)?.changes
+        .map(|changes| changes.since.is_some())
+        .unwrap_or(false);
+
+    let mut batch: Vec<Record> = Vec::with_capacity(IMPORT_BATCH_SIZE);
+
     loop {
         let record_len = reader.read_u32::<LittleEndian>().map_err(_map_io_err)? as usize;
 
@@ -221,15 +376,45 @@ pub(super) fn finish_import<T>(wallet: &Wallet, reader: BufReader<T>, key: chach
         let mut record = vec![0u8; record_len];
         reader.read_exact(&mut record).map_err(_map_io_err)?;
 
-        let record: Record = rmp_serde::from_slice(&record)
-            .to_indy(IndyErrorKind::InvalidStructure, "Record is malformed msgpack")?;
+        if !differential {
+            let record: Record = rmp_serde::from_slice(&record)
+                .to_indy(IndyErrorKind::InvalidStructure, "Record is malformed msgpack")?;
+
+            batch.push(record);
 
-        wallet.add(&record.type_, &record.id, &record.value, &record.tags)?;
+            if batch.len() == IMPORT_BATCH_SIZE {
+                wallet.add_records(&batch)?;
+                batch.clear();
+            }
+            continue;
+        }
+
+        let change: ChangeRecord = rmp_serde::from_slice(&record)
+            .to_indy(IndyErrorKind::InvalidStructure, "Record change is malformed msgpack")?;
+
+        match change {
+            ChangeRecord::Upsert(record) => {
+                _delete_if_exists(wallet, &record.type_, &record.id)?;
+                wallet.add(&record.type_, &record.id, &record.value, &record.tags)?;
+            }
+            ChangeRecord::Delete { type_, id } => _delete_if_exists(wallet, &type_, &id)?
+        }
+    }
+
+    if !batch.is_empty() {
+        wallet.add_records(&batch)?;
     }
 
     Ok(())
 }
 
+fn _delete_if_exists(wallet: &Wallet, type_: &str, id: &str) -> IndyResult<()> {
+    match wallet.delete(type_, id) {
+        Err(ref err) if err.kind() == IndyErrorKind::WalletItemNotFound => Ok(()),
+        res => res
+    }
+}
+
 fn _map_io_err(e: io::Error) -> IndyError {
     match e {
         ref e if e.kind() == io::ErrorKind::UnexpectedEof
@@ -263,7 +448,31 @@ mod tests {
         let key_data = KeyDerivationData::from_passphrase_with_new_salt(passphrase, key_derivation_method);
         let key = key_data.calc_master_key()?;
 
-        export_continue(wallet, writer, version, key, &key_data)
+        export_continue(wallet, writer, version, key, &key_data, None)
+    }
+
+    fn _export_with_diffs(wallet: &Wallet, changes: &[&dyn Fn(&Wallet)]) -> Vec<Vec<u8>> {
+        let key_data = KeyDerivationData::from_passphrase_with_new_salt(_passphrase(), &KeyDerivationMethod::ARGON2I_INT);
+        let key = key_data.calc_master_key().unwrap();
+
+        let mut outputs: Vec<Vec<u8>> = vec![Vec::new()];
+        export_continue(wallet, &mut outputs[0], 0, key.clone(), &key_data, None).unwrap();
+
+        for change in changes {
+            change(wallet);
+
+            let (base, _) = read_header(&mut outputs.last().unwrap().as_slice()).unwrap();
+
+            let mut output: Vec<u8> = Vec::new();
+            export_continue(wallet, &mut output, 0, key.clone(), &key_data, Some(&base)).unwrap();
+            outputs.push(output);
+        }
+
+        outputs
+    }
+
+    fn _header_bytes(output: &[u8]) -> Vec<u8> {
+        read_header(&mut &output[..]).unwrap().1
     }
 
     #[test]
@@ -291,6 +500,85 @@ mod tests {
         test::cleanup_wallet("export_import_works_for_empty_wallet2");
     }
 
+    #[test]
+    fn export_import_works_for_differential_exports() {
+        _cleanup("export_import_works_for_differential_exports1");
+        _cleanup("export_import_works_for_differential_exports2");
+        {
+            let wallet1 = _add_2_records(_wallet("export_import_works_for_differential_exports1"));
+
+            let outputs = _export_with_diffs(&wallet1, &[
+                &|wallet: &Wallet| {
+                    wallet.update(&_type1(), &_id1(), &_value2()).unwrap();
+                    wallet.delete(&_type2(), &_id2()).unwrap();
+                },
+                &|wallet: &Wallet| {
+                    wallet.add(&_type2(), &_id2(), &_value2(), &_tags2()).unwrap();
+                    wallet.add(&_type(3), &_id(3), &_value(3), &_tags(3)).unwrap();
+                },
+            ]);
+
+            check_import_chain(&outputs.iter().map(|output| _header_bytes(output)).collect::<Vec<_>>()).unwrap();
+
+            let wallet = _wallet("export_import_works_for_differential_exports2");
+
+            import(&wallet, &mut outputs[0].as_slice(), _passphrase()).unwrap();
+            _assert_has_2_records(&wallet);
+
+            import(&wallet, &mut outputs[1].as_slice(), _passphrase()).unwrap();
+            assert_eq!(wallet.get(&_type1(), &_id1(), _options()).unwrap().value.unwrap(), _value2());
+            assert_eq!(wallet.get(&_type2(), &_id2(), _options()).unwrap_err().kind(), IndyErrorKind::WalletItemNotFound);
+
+            import(&wallet, &mut outputs[2].as_slice(), _passphrase()).unwrap();
+            assert_eq!(wallet.get(&_type2(), &_id2(), _options()).unwrap().tags.unwrap(), _tags2());
+            assert_eq!(wallet.get(&_type(3), &_id(3), _options()).unwrap().value.unwrap(), _value(3));
+        }
+        _cleanup("export_import_works_for_differential_exports1");
+        _cleanup("export_import_works_for_differential_exports2");
+    }
+
+    #[test]
+    fn export_works_for_differential_export_based_on_pruned_export() {
+        _cleanup("export_works_for_differential_export_based_on_pruned_export");
+        {
+            let wallet = _add_2_records(_wallet("export_works_for_differential_export_based_on_pruned_export"));
+
+            let outputs = _export_with_diffs(&wallet, &[
+                &|wallet: &Wallet| wallet.delete(&_type2(), &_id2()).unwrap(),
+            ]);
+
+            // The differential export has pruned the deletion, so the full export can't be a base anymore
+            let (base, _) = read_header(&mut outputs[0].as_slice()).unwrap();
+            let key_data = KeyDerivationData::from_passphrase_with_new_salt(_passphrase(), &KeyDerivationMethod::ARGON2I_INT);
+            let key = key_data.calc_master_key().unwrap();
+
+            let mut output: Vec<u8> = Vec::new();
+            let res = export_continue(&wallet, &mut output, 0, key, &key_data, Some(&base));
+            assert_kind!(IndyErrorKind::InvalidState, res);
+        }
+        _cleanup("export_works_for_differential_export_based_on_pruned_export");
+    }
+
+    #[test]
+    fn check_import_chain_fails_for_gap() {
+        _cleanup("check_import_chain_fails_for_gap");
+        {
+            let wallet = _add_2_records(_wallet("check_import_chain_fails_for_gap"));
+
+            let outputs = _export_with_diffs(&wallet, &[
+                &|wallet: &Wallet| wallet.delete(&_type1(), &_id1()).unwrap(),
+                &|wallet: &Wallet| wallet.delete(&_type2(), &_id2()).unwrap(),
+            ]);
+
+            let res = check_import_chain(&[_header_bytes(&outputs[0]), _header_bytes(&outputs[2])]);
+            assert_eq!(IndyErrorKind::InvalidStructure, res.unwrap_err().kind());
+
+            let res = check_import_chain(&[_header_bytes(&outputs[1])]);
+            assert_eq!(IndyErrorKind::InvalidStructure, res.unwrap_err().kind());
+        }
+        _cleanup("check_import_chain_fails_for_gap");
+    }
+
     #[test]
     fn export_import_works_for_2_items() {
         _cleanup("export_import_works_for_2_items1");
@@ -486,12 +774,14 @@ mod tests {
                 .to_indy(IndyErrorKind::InvalidState, "Cannot serialize wallet metadata").unwrap()
         };
 
+        let config = json!({"track_changes": true}).to_string();
+
         storage_type.create_storage(id,
-                                    None,
+                                    Some(&config),
                                     None,
                                     &metadata).unwrap();
 
-        let storage = storage_type.open_storage(id, None, None).unwrap();
+        let storage = storage_type.open_storage(id, Some(&config), None).unwrap();
 
         Wallet::new(id.to_string(), storage, Rc::new(keys))
     }
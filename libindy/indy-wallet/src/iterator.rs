@@ -1,11 +1,11 @@
 use std::rc::Rc;
 
-use indy_api_types::errors::IndyError;
+use indy_api_types::errors::prelude::*;
 
 use super::WalletRecord;
 use super::wallet::Keys;
-use super::storage::StorageIterator;
-use super::encryption::{decrypt_storage_record};
+use super::storage::{StorageChange, StorageChangeIterator, StorageIterator};
+use super::encryption::{decrypt_merged, decrypt_storage_record};
 
 pub(super) struct WalletIterator {
     storage_iterator: Box<dyn StorageIterator>,
@@ -33,4 +33,43 @@ impl WalletIterator {
         let total_count = self.storage_iterator.get_total_count()?;
         Ok(total_count)
     }
-}
\ No newline at end of file
+}
+
+pub(super) enum WalletChange {
+    Upserted(WalletRecord),
+    Deleted { type_: String, id: String },
+}
+
+pub(super) struct WalletChangeIterator {
+    storage_iterator: Box<dyn StorageChangeIterator>,
+    keys: Rc<Keys>,
+}
+
+
+impl WalletChangeIterator {
+    pub fn new(storage_iter: Box<dyn StorageChangeIterator>, keys: Rc<Keys>) -> Self {
+        WalletChangeIterator {
+            storage_iterator: storage_iter,
+            keys,
+        }
+    }
+
+    pub fn next(&mut self) -> Result<Option<WalletChange>, IndyError> {
+        let change = match self.storage_iterator.next()? {
+            Some(StorageChange::Upserted(record)) =>
+                WalletChange::Upserted(decrypt_storage_record(&record, &self.keys)?),
+            Some(StorageChange::Deleted { type_, id }) => {
+                let type_ = String::from_utf8(decrypt_merged(&type_, &self.keys.type_key)?)
+                    .to_indy(IndyErrorKind::WalletEncryptionError, "Record type is invalid utf8")?;
+
+                let id = String::from_utf8(decrypt_merged(&id, &self.keys.name_key)?)
+                    .to_indy(IndyErrorKind::WalletEncryptionError, "Record is invalid utf8")?;
+
+                WalletChange::Deleted { type_, id }
+            }
+            None => return Ok(None)
+        };
+
+        Ok(Some(change))
+    }
+}
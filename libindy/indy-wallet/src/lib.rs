@@ -25,10 +25,11 @@ use indy_api_types::wallet::*;
 use indy_api_types::domain::wallet::{Config, Credentials, ExportConfig, Tags};
 use indy_api_types::errors::prelude::*;
 pub use crate::encryption::KeyDerivationData;
+pub use crate::storage::{CompactionProgress, StorageSize};
 use indy_utils::crypto::chacha20poly1305_ietf;
 use indy_utils::crypto::chacha20poly1305_ietf::Key as MasterKey;
 
-use self::export_import::{export_continue, finish_import, preparse_file_to_import};
+use self::export_import::{check_import_chain, export_continue, finish_import, preparse_file_to_import, read_header};
 use self::storage::{WalletStorage, WalletStorageType};
 use self::storage::default::SQLiteStorageType;
 use self::storage::plugged::PluggedStorageType;
@@ -49,9 +50,12 @@ pub struct WalletService {
     wallets: RefCell<HashMap<WalletHandle, Box<Wallet>>>,
     wallet_ids: RefCell<HashSet<String>>,
     pending_for_open: RefCell<HashMap<WalletHandle, (String /* id */, Box<dyn WalletStorage>, Metadata, Option<KeyDerivationData>)>>,
-    pending_for_import: RefCell<HashMap<WalletHandle, (BufReader<::std::fs::File>, chacha20poly1305_ietf::Nonce, usize, Vec<u8>, KeyDerivationData)>>,
+    pending_for_import: RefCell<HashMap<WalletHandle, (Vec<ImportFile>, KeyDerivationData)>>,
 }
 
+// Export file with already read plain header: reader, nonce, chunk size and header bytes
+type ImportFile = (BufReader<::std::fs::File>, chacha20poly1305_ietf::Nonce, usize, Vec<u8>);
+
 impl WalletService {
     pub fn new() -> WalletService {
         let storage_types = {
@@ -119,6 +123,34 @@ impl WalletService {
         Ok(())
     }
 
+    pub fn register_wallet_storage_add_records(&self, type_: &str, add_records: WalletAddRecords) -> IndyResult<()> {
+        trace!("register_wallet_storage_add_records >>> type_: {:?}", type_);
+
+        let storage_types = self.storage_types.borrow();
+
+        let storage_type = storage_types.get(type_)
+            .ok_or_else(|| err_msg(IndyErrorKind::UnknownWalletStorageType, format!("Unknown wallet storage type: {}", type_)))?;
+
+        storage_type.set_add_records_handler(add_records)?;
+
+        trace!("register_wallet_storage_add_records <<<");
+        Ok(())
+    }
+
+    pub fn register_wallet_storage_delete_records(&self, type_: &str, delete_records: WalletDeleteRecords) -> IndyResult<()> {
+        trace!("register_wallet_storage_delete_records >>> type_: {:?}", type_);
+
+        let storage_types = self.storage_types.borrow();
+
+        let storage_type = storage_types.get(type_)
+            .ok_or_else(|| err_msg(IndyErrorKind::UnknownWalletStorageType, format!("Unknown wallet storage type: {}", type_)))?;
+
+        storage_type.set_delete_records_handler(delete_records)?;
+
+        trace!("register_wallet_storage_delete_records <<<");
+        Ok(())
+    }
+
     pub fn create_wallet(&self,
                          config: &Config,
                          credentials: &Credentials,
@@ -136,7 +168,7 @@ impl WalletService {
 
         let (storage_type, storage_config, storage_credentials) = WalletService::_get_config_and_cred_for_storage(config, credentials, &storage_types)?;
 
-        let keys = Keys::new();
+        let keys = Keys::with_record_format(config.record_format.unwrap_or_default());
         let metadata = self._prepare_metadata(master_key, key_data, &keys)?;
 
         storage_type.create_storage(&config.id,
@@ -230,6 +262,10 @@ impl WalletService {
         Ok(wallet_handle)
     }
 
+    pub fn open_wallet_cancel(&self, wallet_handle: WalletHandle) {
+        self.pending_for_open.borrow_mut().remove(&wallet_handle);
+    }
+
     fn _open_storage_and_fetch_metadata(&self, config: &Config, credentials: &Credentials) -> IndyResult<(Box<dyn WalletStorage>, Metadata, KeyDerivationData)> {
         let storage = self._open_storage(config, credentials)?;
         let metadata: Metadata = {
@@ -344,6 +380,13 @@ impl WalletService {
         self.delete_record(wallet_handle, &self.add_prefix(short_type_name::<T>()), name)
     }
 
+    pub fn delete_records(&self, wallet_handle: WalletHandle, type_: &str, query_json: &str) -> IndyResult<usize> {
+        match self.wallets.borrow().get(&wallet_handle) {
+            Some(wallet) => wallet.delete_records(type_, query_json),
+            None => Err(err_msg(IndyErrorKind::InvalidWalletHandle, "Unknown wallet handle"))
+        }
+    }
+
     pub fn get_record(&self, wallet_handle: WalletHandle, type_: &str, name: &str, options_json: &str) -> IndyResult<WalletRecord> {
         match self.wallets.borrow().get(&wallet_handle) {
             Some(wallet) =>
@@ -436,6 +479,22 @@ impl WalletService {
         }
     }
 
+    /// Key derivation data for the export. Differential export reuses the salt of its base export,
+    /// so the whole chain is imported with a single key derivation.
+    pub fn export_key_derivation_data(&self, export_config: &ExportConfig) -> IndyResult<KeyDerivationData> {
+        match export_config.base_path {
+            Some(ref base_path) => {
+                let base_file = fs::OpenOptions::new()
+                    .read(true)
+                    .open(base_path)?;
+
+                let (_, key_data, _, _, _) = preparse_file_to_import(base_file, &export_config.key)?;
+                Ok(key_data)
+            }
+            None => Ok(KeyDerivationData::from_passphrase_with_new_salt(&export_config.key, &export_config.key_derivation_method))
+        }
+    }
+
     pub fn export_wallet(&self, wallet_handle: WalletHandle, export_config: &ExportConfig, version: u32, key: (&KeyDerivationData, &MasterKey)) -> IndyResult<()> {
         trace!("export_wallet >>> wallet_handle: {:?}, export_config: {:?}, version: {:?}", wallet_handle, secret!(export_config), version);
 
@@ -450,6 +509,17 @@ impl WalletService {
             .get(&wallet_handle)
             .ok_or_else(|| err_msg(IndyErrorKind::InvalidWalletHandle, "Unknown wallet handle"))?;
 
+        let base_header = match export_config.base_path {
+            Some(ref base_path) => {
+                let mut base_file = fs::OpenOptions::new()
+                    .read(true)
+                    .open(base_path)?;
+
+                Some(read_header(&mut base_file)?.0)
+            }
+            None => None
+        };
+
         let path = PathBuf::from(&export_config.path);
 
         if let Some(parent_path) = path.parent() {
@@ -464,38 +534,59 @@ impl WalletService {
                 .create_new(true)
                 .open(export_config.path.clone())?;
 
-        let res = export_continue(wallet, &mut export_file, version, key.clone(), key_data);
+        let res = export_continue(wallet, &mut export_file, version, key.clone(), key_data, base_header.as_ref());
 
         trace!("export_wallet <<<");
 
         res
     }
 
-    pub fn import_wallet_prepare(&self,
-                                 config: &Config,
-                                 credentials: &Credentials,
-                                 export_config: &ExportConfig) -> IndyResult<(WalletHandle, KeyDerivationData, KeyDerivationData)> {
-        trace!("import_wallet_prepare >>> config: {:?}, credentials: {:?}, export_config: {:?}", config, secret!(export_config), secret!(export_config));
-
+    fn _prepare_import_files(export_config: &ExportConfig) -> IndyResult<(Vec<ImportFile>, KeyDerivationData)> {
         let exported_file_to_import =
             fs::OpenOptions::new()
                 .read(true)
                 .open(&export_config.path)?;
 
         let (reader, import_key_derivation_data, nonce, chunk_size, header_bytes) = preparse_file_to_import(exported_file_to_import, &export_config.key)?;
+
+        let mut files = vec![(reader, nonce, chunk_size, header_bytes)];
+
+        for path in export_config.differential_paths.iter() {
+            let differential_file =
+                fs::OpenOptions::new()
+                    .read(true)
+                    .open(path)?;
+
+            // the key is checked to be the same as for the full export, so derivation data is dropped
+            let (reader, _, nonce, chunk_size, header_bytes) = preparse_file_to_import(differential_file, &export_config.key)?;
+            files.push((reader, nonce, chunk_size, header_bytes));
+        }
+
+        check_import_chain(&files.iter().map(|file| file.3.clone()).collect::<Vec<Vec<u8>>>())?;
+
+        Ok((files, import_key_derivation_data))
+    }
+
+    pub fn import_wallet_prepare(&self,
+                                 config: &Config,
+                                 credentials: &Credentials,
+                                 export_config: &ExportConfig) -> IndyResult<(WalletHandle, KeyDerivationData, KeyDerivationData)> {
+        trace!("import_wallet_prepare >>> config: {:?}, credentials: {:?}, export_config: {:?}", config, secret!(export_config), secret!(export_config));
+
+        let (files, import_key_derivation_data) = WalletService::_prepare_import_files(export_config)?;
         let key_data = KeyDerivationData::from_passphrase_with_new_salt(&credentials.key, &credentials.key_derivation_method);
 
         let wallet_handle = indy_utils::next_wallet_handle();
 
         let stashed_key_data = key_data.clone();
 
-        self.pending_for_import.borrow_mut().insert(wallet_handle, (reader, nonce, chunk_size, header_bytes, stashed_key_data));
+        self.pending_for_import.borrow_mut().insert(wallet_handle, (files, stashed_key_data));
 
         Ok((wallet_handle, key_data, import_key_derivation_data))
     }
 
     pub fn import_wallet_continue(&self, wallet_handle: WalletHandle, config: &Config, credentials: &Credentials, key: (MasterKey, MasterKey)) -> IndyResult<()> {
-        let (reader, nonce, chunk_size, header_bytes, key_data) = self.pending_for_import.borrow_mut().remove(&wallet_handle).unwrap();
+        let (files, key_data) = self.pending_for_import.borrow_mut().remove(&wallet_handle).unwrap();
 
         let (import_key, master_key) = key;
 
@@ -508,7 +599,9 @@ impl WalletService {
         let res = {
             let wallet = Wallet::new(WalletService::_get_wallet_id(&config), storage, Rc::new(keys));
 
-            finish_import(&wallet, reader, import_key, nonce, chunk_size, header_bytes)
+            files.into_iter()
+                .map(|(reader, nonce, chunk_size, header_bytes)| finish_import(&wallet, reader, import_key.clone(), nonce, chunk_size, header_bytes))
+                .collect::<IndyResult<()>>()
         };
 
         if res.is_err() {
@@ -524,6 +617,28 @@ impl WalletService {
         res
     }
 
+    pub fn compact_wallet(&self, wallet_handle: WalletHandle, max_pages: usize) -> IndyResult<CompactionProgress> {
+        match self.wallets.borrow().get(&wallet_handle) {
+            Some(wallet) => wallet.compact(max_pages)?
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "Wallet storage doesn't support compaction")),
+            None => Err(err_msg(IndyErrorKind::InvalidWalletHandle, "Unknown wallet handle"))
+        }
+    }
+
+    /// Summed size of storages of opened wallets. Storages that don't report size are skipped.
+    pub fn get_storage_size(&self) -> IndyResult<StorageSize> {
+        let mut size = StorageSize::default();
+
+        for wallet in self.wallets.borrow().values() {
+            if let Some(wallet_size) = wallet.get_storage_size()? {
+                size.size += wallet_size.size;
+                size.free += wallet_size.free;
+            }
+        }
+
+        Ok(size)
+    }
+
     pub fn get_wallets_count(&self) -> usize {
         self.wallets.borrow().len()
     }
@@ -823,7 +938,7 @@ mod tests {
 
     use indy_api_types::INVALID_WALLET_HANDLE;
 
-    use indy_api_types::domain::wallet::KeyDerivationMethod;
+    use indy_api_types::domain::wallet::{KeyDerivationMethod, RecordFormat};
     use indy_utils::environment;
     use indy_utils::inmem_wallet::InmemWallet;
     use indy_utils::test;
@@ -863,12 +978,7 @@ mod tests {
                              export_config: &ExportConfig) -> IndyResult<()> {
             trace!("import_wallet_prepare >>> config: {:?}, credentials: {:?}, export_config: {:?}", config, secret!(export_config), secret!(export_config));
 
-            let exported_file_to_import =
-                fs::OpenOptions::new()
-                    .read(true)
-                    .open(&export_config.path)?;
-
-            let (reader, import_key_derivation_data, nonce, chunk_size, header_bytes) = preparse_file_to_import(exported_file_to_import, &export_config.key)?;
+            let (files, import_key_derivation_data) = WalletService::_prepare_import_files(export_config)?;
             let key_data = KeyDerivationData::from_passphrase_with_new_salt(&credentials.key, &credentials.key_derivation_method);
 
             let wallet_handle = next_wallet_handle();
@@ -876,7 +986,7 @@ mod tests {
             let import_key = import_key_derivation_data.calc_master_key()?;
             let master_key = key_data.calc_master_key()?;
 
-            self.pending_for_import.borrow_mut().insert(wallet_handle, (reader, nonce, chunk_size, header_bytes, key_data));
+            self.pending_for_import.borrow_mut().insert(wallet_handle, (files, key_data));
 
             self.import_wallet_continue(wallet_handle, config, credentials, (import_key, master_key))
         }
@@ -1163,6 +1273,7 @@ mod tests {
             id: String::from("same_id"),
             storage_type: None,
             storage_config: None,
+            record_format: None,
         };
 
         wallet_service.create_wallet(&config_1, &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
@@ -1174,6 +1285,7 @@ mod tests {
             storage_config: Some(json!({
                 "path": _custom_path("wallet_service_open_wallet_works_for_two_wallets_with_same_ids_but_different_paths")
             })),
+            record_format: None,
         };
 
         wallet_service.create_wallet(&config_2, &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
@@ -1311,6 +1423,48 @@ mod tests {
         wallet_service.get_record(wallet_handle, "type", "key1", "{}").unwrap();
     }
 
+    #[test]
+    fn wallet_service_add_record_works_for_single_aead_format() {
+        test::cleanup_wallet("wallet_service_add_record_works_for_single_aead_format");
+        {
+            let config = _config_single_aead("wallet_service_add_record_works_for_single_aead_format");
+            let wallet_service = WalletService::new();
+            wallet_service.create_wallet(&config, &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
+            let wallet_handle = wallet_service.open_wallet(&config, &RAW_CREDENTIAL).unwrap();
+
+            wallet_service.add_record(wallet_handle, "type", "key1", "value1", &HashMap::new()).unwrap();
+            let record = wallet_service.get_record(wallet_handle, "type", "key1", &_fetch_options(false, true, false)).unwrap();
+            assert_eq!("value1", record.get_value().unwrap());
+
+            wallet_service.update_record_value(wallet_handle, "type", "key1", "value2").unwrap();
+            let record = wallet_service.get_record(wallet_handle, "type", "key1", &_fetch_options(false, true, false)).unwrap();
+            assert_eq!("value2", record.get_value().unwrap());
+
+            wallet_service.close_wallet(wallet_handle).unwrap();
+
+            let wallet_handle = wallet_service.open_wallet(&config, &RAW_CREDENTIAL).unwrap();
+            let record = wallet_service.get_record(wallet_handle, "type", "key1", &_fetch_options(false, true, false)).unwrap();
+            assert_eq!("value2", record.get_value().unwrap());
+        }
+        test::cleanup_wallet("wallet_service_add_record_works_for_single_aead_format");
+    }
+
+    #[test]
+    fn wallet_service_add_record_works_for_plugged_and_single_aead_format() {
+        _cleanup("wallet_service_add_record_works_for_plugged_and_single_aead_format");
+
+        let wallet_service = WalletService::new();
+        _register_inmem_wallet(&wallet_service);
+
+        let config = Config { record_format: Some(RecordFormat::SINGLE_AEAD), .._config_inmem() };
+        wallet_service.create_wallet(&config, &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
+        let wallet_handle = wallet_service.open_wallet(&config, &RAW_CREDENTIAL).unwrap();
+
+        wallet_service.add_record(wallet_handle, "type", "key1", "value1", &HashMap::new()).unwrap();
+        let record = wallet_service.get_record(wallet_handle, "type", "key1", &_fetch_options(false, true, false)).unwrap();
+        assert_eq!("value1", record.get_value().unwrap());
+    }
+
     #[test]
     fn wallet_service_get_record_works_for_id_only() {
         test::cleanup_wallet("wallet_service_get_record_works_for_id_only");
@@ -1788,6 +1942,53 @@ mod tests {
         assert!(search.fetch_next_record().unwrap().is_none());
     }
 
+    #[test]
+    fn wallet_service_delete_records_works() {
+        test::cleanup_wallet("wallet_service_delete_records_works");
+        {
+            let wallet_service = WalletService::new();
+            wallet_service.create_wallet(&_config("wallet_service_delete_records_works"), &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
+            let wallet_handle = wallet_service.open_wallet(&_config("wallet_service_delete_records_works"), &RAW_CREDENTIAL).unwrap();
+
+            wallet_service.add_record(wallet_handle, "type", "key1", "value1", &serde_json::from_str(r#"{"~age":"10"}"#).unwrap()).unwrap();
+            wallet_service.add_record(wallet_handle, "type", "key2", "value2", &serde_json::from_str(r#"{"~age":"20"}"#).unwrap()).unwrap();
+            wallet_service.add_record(wallet_handle, "type3", "key3", "value3", &serde_json::from_str(r#"{"~age":"10"}"#).unwrap()).unwrap();
+
+            let deleted_count = wallet_service.delete_records(wallet_handle, "type", r#"{"~age": {"$lt": "15"}}"#).unwrap();
+            assert_eq!(1, deleted_count);
+
+            let res = wallet_service.get_record(wallet_handle, "type", "key1", "{}");
+            assert_kind!(IndyErrorKind::WalletItemNotFound, res);
+
+            wallet_service.get_record(wallet_handle, "type", "key2", "{}").unwrap();
+            wallet_service.get_record(wallet_handle, "type3", "key3", "{}").unwrap();
+        }
+        test::cleanup_wallet("wallet_service_delete_records_works");
+    }
+
+    #[test]
+    fn wallet_service_delete_records_works_for_plugged_wallet() {
+        _cleanup("wallet_service_delete_records_works_for_plugged_wallet");
+
+        let wallet_service = WalletService::new();
+        _register_inmem_wallet(&wallet_service);
+
+        wallet_service.create_wallet(&_config_inmem(), &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
+        let wallet_handle = wallet_service.open_wallet(&_config_inmem(), &RAW_CREDENTIAL).unwrap();
+
+        wallet_service.add_record(wallet_handle, "type", "key1", "value1", &HashMap::new()).unwrap();
+        wallet_service.add_record(wallet_handle, "type", "key2", "value2", &HashMap::new()).unwrap();
+        wallet_service.add_record(wallet_handle, "type3", "key3", "value3", &HashMap::new()).unwrap();
+
+        let deleted_count = wallet_service.delete_records(wallet_handle, "type", "{}").unwrap();
+        assert_eq!(2, deleted_count);
+
+        let mut search = wallet_service.search_records(wallet_handle, "type", "{}", &_fetch_options(true, true, true)).unwrap();
+        assert!(search.fetch_next_record().unwrap().is_none());
+
+        wallet_service.get_record(wallet_handle, "type3", "key3", "{}").unwrap();
+    }
+
     /**
         Key rotation test
     */
@@ -2059,6 +2260,35 @@ mod tests {
         test::cleanup_wallet("wallet_service_export_import_wallet_1_item");
     }
 
+    #[test]
+    fn wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format() {
+        test::cleanup_wallet("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format");
+        let export_config = _export_config_raw("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format");
+        {
+            let wallet_service = WalletService::new();
+            wallet_service.create_wallet(&_config("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format"), &RAW_CREDENTIAL, (&RAW_KDD, &RAW_MASTER_KEY)).unwrap();
+            let wallet_handle = wallet_service.open_wallet(&_config("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format"), &RAW_CREDENTIAL).unwrap();
+
+            wallet_service.add_record(wallet_handle, "type", "key1", "value1", &HashMap::new()).unwrap();
+
+            let (kdd, master_key) = _export_key_raw("key_wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format");
+            let export_path = remove_exported_wallet(&export_config);
+            wallet_service.export_wallet(wallet_handle, &export_config, 0, (&kdd, &master_key)).unwrap();
+            assert!(export_path.exists());
+
+            wallet_service.close_wallet(wallet_handle).unwrap();
+            wallet_service.delete_wallet(&_config("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format"), &RAW_CREDENTIAL).unwrap();
+
+            let config = _config_single_aead("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format");
+            wallet_service.import_wallet(&config, &RAW_CREDENTIAL, &export_config).unwrap();
+            let wallet_handle = wallet_service.open_wallet(&config, &RAW_CREDENTIAL).unwrap();
+            let record = wallet_service.get_record(wallet_handle, "type", "key1", &_fetch_options(false, true, false)).unwrap();
+            assert_eq!("value1", record.get_value().unwrap());
+        }
+        let _export_path = remove_exported_wallet(&export_config);
+        test::cleanup_wallet("wallet_service_export_import_wallet_1_item_for_migration_to_single_aead_format");
+    }
+
     #[test]
     fn wallet_service_export_import_wallet_1_item_for_interactive_method() {
         test::cleanup_wallet("wallet_service_export_import_wallet_1_item_for_interactive_method");
@@ -2227,6 +2457,7 @@ mod tests {
             id: name.to_string(),
             storage_type: None,
             storage_config: None,
+            record_format: None,
         }
     }
 
@@ -2235,6 +2466,16 @@ mod tests {
             id: name.to_string(),
             storage_type: Some("default".to_string()),
             storage_config: None,
+            record_format: None,
+        }
+    }
+
+    fn _config_single_aead(name: &str) -> Config {
+        Config {
+            id: name.to_string(),
+            storage_type: None,
+            storage_config: None,
+            record_format: Some(RecordFormat::SINGLE_AEAD),
         }
     }
 
@@ -2243,6 +2484,7 @@ mod tests {
             id: "w1".to_string(),
             storage_type: Some("inmem".to_string()),
             storage_config: None,
+            record_format: None,
         }
     }
 
@@ -2251,6 +2493,7 @@ mod tests {
             id: name.to_string(),
             storage_type: Some("unknown".to_string()),
             storage_config: None,
+            record_format: None,
         }
     }
 
@@ -2399,6 +2642,8 @@ mod tests {
             key: "export_key".to_string(),
             path: _export_file_path(name).to_str().unwrap().to_string(),
             key_derivation_method: KeyDerivationMethod::ARGON2I_MOD,
+            base_path: None,
+            differential_paths: Vec::new(),
         }
     }
 
@@ -2417,6 +2662,8 @@ mod tests {
             key: "export_key".to_string(),
             path: _export_file_path(name).to_str().unwrap().to_string(),
             key_derivation_method: KeyDerivationMethod::ARGON2I_INT,
+            base_path: None,
+            differential_paths: Vec::new(),
         }
     }
 
@@ -2429,6 +2676,8 @@ mod tests {
             key: "6nxtSiXFvBd593Y2DCed2dYvRY1PGK9WMtxCBjLzKgbw".to_string(),
             path: _export_file_path(name).to_str().unwrap().to_string(),
             key_derivation_method: KeyDerivationMethod::RAW,
+            base_path: None,
+            differential_paths: Vec::new(),
         }
     }
 
@@ -1,30 +1,39 @@
 extern crate owning_ref;
 
 use std;
+use std::cell::Cell;
 use std::fs;
+use std::path::{Path, PathBuf};
 use std::rc::Rc;
 
 use rusqlite;
+use rusqlite::OptionalExtension;
 use serde_json;
 
 use indy_api_types::errors::prelude::*;
 use crate::language;
 use indy_utils::environment;
 
-use super::{EncryptedValue, StorageIterator, StorageRecord, Tag, TagName, WalletStorage, WalletStorageType};
+use super::{CompactionProgress, EncryptedValue, StorageChange, StorageChangeIterator, StorageIterator, StorageRecord, StorageSize, Tag, TagName, WalletStorage, WalletStorageType};
 use super::super::{RecordOptions, SearchOptions};
 
 use self::owning_ref::OwningHandle;
+use self::sharded::ShardBy;
 
 mod query;
+mod sharded;
 mod transaction;
 
 const _SQLITE_DB: &str = "sqlite.db";
 const _PLAIN_TAGS_QUERY: &str = "SELECT name, value from tags_plaintext where item_id = ?";
 const _ENCRYPTED_TAGS_QUERY: &str = "SELECT name, value from tags_encrypted where item_id = ?";
+// Incremental auto vacuum lets compaction reclaim free pages in bounded steps. It can be enabled
+// only before the first table is created, existing wallets are converted by compaction.
+const _AUTO_VACUUM_INCREMENTAL: i64 = 2;
 const _CREATE_SCHEMA: &str = "
     PRAGMA locking_mode=EXCLUSIVE;
     PRAGMA foreign_keys=ON;
+    PRAGMA auto_vacuum=INCREMENTAL;
 
     BEGIN EXCLUSIVE TRANSACTION;
 
@@ -86,6 +95,54 @@ const _CREATE_SCHEMA: &str = "
     END TRANSACTION;
 ";
 
+// Every change of an item or its tags moves the item to the end of item_changes log, so the log
+// keeps one row per live item plus rows of items deleted after the latest export.
+// Rows of deleted items are pruned by export, item_changes_pruned keeps the latest pruned sequence number.
+// Tracking is enabled with track_changes key of storage config and stays enabled for the wallet.
+const _CREATE_CHANGE_TRACKING: &str = "
+    CREATE TABLE IF NOT EXISTS item_changes(
+        seq INTEGER PRIMARY KEY AUTOINCREMENT,
+        type NOT NULL,
+        name NOT NULL,
+        deleted INTEGER NOT NULL
+    );
+
+    CREATE TABLE IF NOT EXISTS item_changes_pruned(
+        id INTEGER PRIMARY KEY CHECK (id = 0),
+        seq INTEGER NOT NULL
+    );
+
+    CREATE UNIQUE INDEX IF NOT EXISTS ux_item_changes_type_name ON item_changes(type, name);
+
+    CREATE TRIGGER IF NOT EXISTS tr_items_insert AFTER INSERT ON items BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) VALUES(NEW.type, NEW.name, 0);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_items_update AFTER UPDATE ON items BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) VALUES(NEW.type, NEW.name, 0);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_items_delete AFTER DELETE ON items BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) VALUES(OLD.type, OLD.name, 1);
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_tags_encrypted_insert AFTER INSERT ON tags_encrypted BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) SELECT type, name, 0 FROM items WHERE id = NEW.item_id;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_tags_encrypted_delete AFTER DELETE ON tags_encrypted BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) SELECT type, name, 0 FROM items WHERE id = OLD.item_id;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_tags_plaintext_insert AFTER INSERT ON tags_plaintext BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) SELECT type, name, 0 FROM items WHERE id = NEW.item_id;
+    END;
+
+    CREATE TRIGGER IF NOT EXISTS tr_tags_plaintext_delete AFTER DELETE ON tags_plaintext BEGIN
+        INSERT OR REPLACE INTO item_changes(type, name, deleted) SELECT type, name, 0 FROM items WHERE id = OLD.item_id;
+    END;
+";
+
 
 #[derive(Debug)]
 struct TagRetriever<'a> {
@@ -215,14 +272,72 @@ impl StorageIterator for SQLiteStorageIterator {
     }
 }
 
+struct SQLiteChangeIterator {
+    rows: OwningHandle<
+        OwningHandle<
+            Rc<rusqlite::Connection>,
+            Box<rusqlite::Statement<'static>>>,
+        Box<rusqlite::Rows<'static>>>,
+    tag_retriever: TagRetrieverOwned,
+}
+
+
+impl SQLiteChangeIterator {
+    fn new(stmt: OwningHandle<Rc<rusqlite::Connection>, Box<rusqlite::Statement<'static>>>,
+           args: &[&dyn rusqlite::types::ToSql],
+           tag_retriever: TagRetrieverOwned) -> IndyResult<SQLiteChangeIterator> {
+        let rows = OwningHandle::try_new(
+            stmt, |stmt|
+                unsafe {
+                    (*(stmt as *mut rusqlite::Statement)).query(args).map(Box::new)
+                },
+        )?;
+
+        Ok(SQLiteChangeIterator { rows, tag_retriever })
+    }
+}
+
+
+impl StorageChangeIterator for SQLiteChangeIterator {
+    fn next(&mut self) -> IndyResult<Option<StorageChange>> {
+        match self.rows.next() {
+            Ok(None) => Ok(None),
+            Ok(Some(row)) => {
+                let type_: Vec<u8> = row.get(0)?;
+                let name: Vec<u8> = row.get(1)?;
+                let item_id: Option<i64> = row.get(2)?;
+
+                let change = match item_id {
+                    Some(item_id) => {
+                        let value = EncryptedValue::new(row.get(3)?, row.get(4)?);
+                        let tags = self.tag_retriever.retrieve(item_id)?;
+                        StorageChange::Upserted(StorageRecord::new(name, Some(value), Some(type_), Some(tags)))
+                    }
+                    None => StorageChange::Deleted { type_, id: name }
+                };
+
+                Ok(Some(change))
+            }
+            Err(err) => Err(err.into()),
+        }
+    }
+}
+
 #[derive(Deserialize, Debug)]
 struct Config {
     path: Option<String>,
+    shards: Option<usize>,
+    #[serde(default)]
+    shard_by: ShardBy,
+    #[serde(default)]
+    track_changes: bool,
 }
 
 #[derive(Debug)]
 struct SQLiteStorage {
     conn: Rc<rusqlite::Connection>,
+    // Number of indexes rebuilt by the current compaction pass
+    reindexed: Cell<usize>,
 }
 
 pub struct SQLiteStorageType {}
@@ -233,18 +348,101 @@ impl SQLiteStorageType {
         SQLiteStorageType {}
     }
 
-    fn _db_path(id: &str, config: Option<&Config>) -> std::path::PathBuf {
+    fn _wallet_path(id: &str, config: Option<&Config>) -> PathBuf {
         let mut path = match config {
-            Some(Config { path: Some(ref path) }) => std::path::PathBuf::from(path),
+            Some(Config { path: Some(ref path), .. }) => PathBuf::from(path),
             _ => environment::wallet_home_path()
         };
 
         path.push(id);
+        path
+    }
+
+    fn _db_path(id: &str, config: Option<&Config>) -> PathBuf {
+        let mut path = SQLiteStorageType::_wallet_path(id, config);
         path.push(_SQLITE_DB);
         path
     }
 }
 
+fn _create_db(db_path: &Path, metadata: &[u8], track_changes: bool) -> IndyResult<()> {
+    let conn = rusqlite::Connection::open(db_path)?;
+
+    let res = conn.execute_batch(_CREATE_SCHEMA)
+        .and_then(|_| if track_changes { conn.execute_batch(_CREATE_CHANGE_TRACKING) } else { Ok(()) })
+        .and_then(|_| conn.execute("INSERT OR REPLACE INTO metadata(value) VALUES(?1)", &[&metadata.to_vec()]));
+
+    match res {
+        Ok(_) => Ok(()),
+        Err(error) => {
+            std::fs::remove_file(db_path)?;
+            Err(error.into())
+        }
+    }
+}
+
+fn _open_connection(db_path: &Path, track_changes: bool) -> IndyResult<rusqlite::Connection> {
+    let conn = rusqlite::Connection::open(db_path)?;
+
+    // set journal mode to WAL, because it provides better performance.
+    let journal_mode: String = conn.query_row(
+        "PRAGMA journal_mode = WAL",
+        [],
+        |row| { row.get(0) },
+    )?;
+
+    // if journal mode is set to WAL, set synchronous to FULL for safety reasons.
+    // (synchronous = NORMAL with journal_mode = WAL does not guaranties durability).
+    if journal_mode.to_lowercase() == "wal" {
+        conn.execute("PRAGMA synchronous = FULL", [])?;
+    }
+
+    if track_changes && !_tracks_changes(&conn)? {
+        conn.execute_batch(_CREATE_CHANGE_TRACKING)?;
+    }
+
+    Ok(conn)
+}
+
+fn _tracks_changes(conn: &rusqlite::Connection) -> IndyResult<bool> {
+    let count: i64 = conn.query_row(
+        "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'item_changes_pruned'",
+        [],
+        |row| row.get(0),
+    )?;
+
+    Ok(count > 0)
+}
+
+fn _add_records(conn: &rusqlite::Connection, records: &[StorageRecord]) -> IndyResult<()> {
+    let tx: transaction::Transaction = transaction::Transaction::new(conn, rusqlite::TransactionBehavior::Deferred)?;
+
+    {
+        let mut stmt_i = tx.prepare_cached("INSERT INTO items (type, name, value, key) VALUES (?1, ?2, ?3, ?4)")?;
+        let mut stmt_e = tx.prepare_cached("INSERT INTO tags_encrypted (item_id, name, value) VALUES (?1, ?2, ?3)")?;
+        let mut stmt_p = tx.prepare_cached("INSERT INTO tags_plaintext (item_id, name, value) VALUES (?1, ?2, ?3)")?;
+
+        for record in records {
+            let (type_, value) = match (record.type_.as_ref(), record.value.as_ref()) {
+                (Some(type_), Some(value)) => (type_, value),
+                _ => return Err(err_msg(IndyErrorKind::InvalidStructure, "Record to add must contain type and value"))
+            };
+
+            let id = stmt_i.insert(&[type_, &record.id, &value.data, &value.key])?;
+
+            for tag in record.tags.as_ref().map(Vec::as_slice).unwrap_or(&[]) {
+                match *tag {
+                    Tag::Encrypted(ref tag_name, ref tag_data) => stmt_e.execute(rusqlite::params![&id, tag_name, tag_data])?,
+                    Tag::PlainText(ref tag_name, ref tag_data) => stmt_p.execute(rusqlite::params![&id, tag_name, tag_data])?
+                };
+            }
+        }
+    }
+
+    tx.commit()?;
+    Ok(())
+}
+
 impl WalletStorage for SQLiteStorage {
     ///
     /// Tries to fetch values and/or tags from the storage.
@@ -373,6 +571,10 @@ impl WalletStorage for SQLiteStorage {
         Ok(())
     }
 
+    fn add_records(&self, records: &[StorageRecord]) -> IndyResult<()> {
+        _add_records(&self.conn, records)
+    }
+
     fn update(&self, type_: &[u8], id: &[u8], value: &EncryptedValue) -> IndyResult<()> {
         let res = self.conn.prepare_cached("UPDATE items SET value = ?1, key = ?2 WHERE type = ?3 AND name = ?4")?
             .execute(rusqlite::params![&value.data, &value.key, &type_.to_vec(), &id.to_vec()]);
@@ -492,6 +694,16 @@ impl WalletStorage for SQLiteStorage {
         }
     }
 
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> IndyResult<usize> {
+        let type_ = type_.to_vec();
+
+        // Tags are deleted by cascade and item_changes triggers run for every row in the same statement
+        let (query_string, query_arguments) = query::wql_to_sql_delete(&type_, query)?;
+        let row_count = self.conn.execute(&query_string, &*query_arguments)?;
+
+        Ok(row_count)
+    }
+
     fn get_storage_metadata(&self) -> IndyResult<Vec<u8>> {
         self.conn.query_row(
             "SELECT value FROM metadata",
@@ -570,9 +782,152 @@ impl WalletStorage for SQLiteStorage {
     fn close(&mut self) -> IndyResult<()> {
         Ok(())
     }
+
+    fn get_change_seq(&self) -> IndyResult<Option<u64>> {
+        if !_tracks_changes(&self.conn)? {
+            return Ok(None);
+        }
+
+        // Rows of deleted items may be pruned, so the latest issued sequence number is used
+        let seq: i64 = self.conn.query_row(
+            "SELECT COALESCE((SELECT seq FROM sqlite_sequence WHERE name = 'item_changes'), 0)",
+            [],
+            |row| row.get(0),
+        )?;
+
+        Ok(Some(seq as u64))
+    }
+
+    fn get_changes(&self, since: u64, until: u64) -> IndyResult<Box<dyn StorageChangeIterator>> {
+        if !_tracks_changes(&self.conn)? {
+            return Err(err_msg(IndyErrorKind::InvalidState, "Wallet storage doesn't track changes"));
+        }
+
+        let pruned: i64 = self.conn.query_row(
+            "SELECT COALESCE((SELECT seq FROM item_changes_pruned), 0)",
+            [],
+            |row| row.get(0),
+        )?;
+
+        if since < pruned as u64 {
+            return Err(err_msg(IndyErrorKind::InvalidState,
+                               format!("Deleted items up to {} were pruned by a later export, use the latest export as a base", pruned)));
+        }
+
+        // Deleted items are reported by the log row only, items that were re-added are joined
+        let statement = self._prepare_statement(
+            "SELECT c.type, c.name, i.id, i.value, i.key FROM item_changes c \
+             LEFT JOIN items i ON c.deleted = 0 AND i.type = c.type AND i.name = c.name \
+             WHERE c.seq > ?1 AND c.seq <= ?2 ORDER BY c.seq;")?;
+
+        let tag_retriever = TagRetriever::new_owned(self.conn.clone())?;
+        let storage_iterator = SQLiteChangeIterator::new(statement, &[&(since as i64), &(until as i64)], tag_retriever)?;
+
+        Ok(Box::new(storage_iterator))
+    }
+
+    fn prune_changes(&self, until: u64) -> IndyResult<()> {
+        if !_tracks_changes(&self.conn)? {
+            return Ok(());
+        }
+
+        let tx: transaction::Transaction = transaction::Transaction::new(&self.conn, rusqlite::TransactionBehavior::Deferred)?;
+
+        tx.execute("DELETE FROM item_changes WHERE deleted = 1 AND seq <= ?1", &[&(until as i64)])?;
+        tx.execute("INSERT OR REPLACE INTO item_changes_pruned(id, seq) \
+                    VALUES(0, MAX(?1, COALESCE((SELECT seq FROM item_changes_pruned), 0)))", &[&(until as i64)])?;
+
+        tx.commit()?;
+        Ok(())
+    }
+
+    ///
+    /// Runs one step of the compaction pass. A step either rebuilds one index, so its pages are
+    /// packed and ordered again, or moves at most `max_pages` pages from the end of the file into
+    /// free pages. The pass is done when all indexes are rebuilt and no free pages are left.
+    ///
+    /// Rebuilding of one index isn't bounded by `max_pages` and takes time proportional to the
+    /// index size.
+    ///
+    /// Wallets created before incremental auto vacuum was enabled are converted by the first
+    /// step. Conversion rewrites the whole database once and isn't bounded by `max_pages`.
+    /// SQLite can't vacuum while statements are active, so conversion fails with InvalidState
+    /// while searches of the storage are open.
+    ///
+    fn compact(&self, max_pages: usize) -> IndyResult<Option<CompactionProgress>> {
+        let auto_vacuum: i64 = self.conn.query_row("PRAGMA auto_vacuum", [], |row| row.get(0))?;
+
+        if auto_vacuum != _AUTO_VACUUM_INCREMENTAL {
+            // Every open search holds the connection with its statements
+            if Rc::strong_count(&self.conn) > 1 {
+                return Err(err_msg(IndyErrorKind::InvalidState,
+                                   "Wallet storage can't be converted for compaction while searches are open"));
+            }
+
+            self.conn.execute_batch("PRAGMA auto_vacuum=INCREMENTAL; VACUUM;")?;
+            return self._finish_compaction().map(Some);
+        }
+
+        let index: Option<String> = self.conn.query_row(
+            "SELECT name FROM sqlite_master WHERE type = 'index' ORDER BY name LIMIT 1 OFFSET ?1",
+            &[&(self.reindexed.get() as i64)],
+            |row| row.get(0),
+        ).optional()?;
+
+        if let Some(index) = index {
+            self.conn.execute_batch(&format!("REINDEX \"{}\";", index.replace('"', "\"\"")))?;
+            self.reindexed.set(self.reindexed.get() + 1);
+
+            return Ok(Some(CompactionProgress { done: false, size: self._storage_size()? }));
+        }
+
+        // The pragma returns a row for every reclaimed page, so it must be stepped to the end.
+        // 0 means the whole free list, so at least one page is reclaimed per step
+        {
+            let mut stmt = self.conn.prepare(&format!("PRAGMA incremental_vacuum({})", max_pages.max(1)))?;
+            let mut rows = stmt.query([])?;
+            while rows.next()?.is_some() {}
+        }
+
+        let size = self._storage_size()?;
+
+        if size.free > 0 {
+            return Ok(Some(CompactionProgress { done: false, size }));
+        }
+
+        self._finish_compaction().map(Some)
+    }
+
+    fn get_storage_size(&self) -> IndyResult<Option<StorageSize>> {
+        self._storage_size().map(Some)
+    }
 }
 
 impl SQLiteStorage {
+    fn new(conn: rusqlite::Connection) -> SQLiteStorage {
+        SQLiteStorage { conn: Rc::new(conn), reindexed: Cell::new(0) }
+    }
+
+    fn _storage_size(&self) -> IndyResult<StorageSize> {
+        let page_size: i64 = self.conn.query_row("PRAGMA page_size", [], |row| row.get(0))?;
+        let page_count: i64 = self.conn.query_row("PRAGMA page_count", [], |row| row.get(0))?;
+        let freelist_count: i64 = self.conn.query_row("PRAGMA freelist_count", [], |row| row.get(0))?;
+
+        Ok(StorageSize {
+            size: (page_count * page_size) as u64,
+            free: (freelist_count * page_size) as u64,
+        })
+    }
+
+    // Finishes the pass: the file is truncated by the checkpoint, so the reclaimed space is
+    // returned to the file system. Checkpoint is partial if a search is open, that is fine.
+    fn _finish_compaction(&self) -> IndyResult<CompactionProgress> {
+        self.reindexed.set(0);
+        self.conn.query_row("PRAGMA wal_checkpoint(TRUNCATE)", [], |_| Ok(()))?;
+
+        Ok(CompactionProgress { done: true, size: self._storage_size()? })
+    }
+
     fn _prepare_statement(&self, sql: &str) -> IndyResult<OwningHandle<Rc<rusqlite::Connection>, Box<rusqlite::Statement<'static>>>> {
         OwningHandle::try_new(self.conn.clone(), |conn| {
             unsafe { (*conn).prepare(sql) }.map(Box::new).map_err(IndyError::from)
@@ -613,12 +968,13 @@ impl WalletStorageType for SQLiteStorageType {
             .to_indy(IndyErrorKind::InvalidStructure, "Malformed config json")?;
 
         let db_file_path = SQLiteStorageType::_db_path(id, config.as_ref());
+        let wallet_path = db_file_path.parent().unwrap();
 
-        if !db_file_path.exists() {
+        if !db_file_path.exists() && !sharded::exists(wallet_path) {
             return Err(err_msg(IndyErrorKind::WalletNotFound, format!("Wallet storage file isn't found: {:?}", db_file_path)));
         }
 
-        std::fs::remove_dir_all(db_file_path.parent().unwrap())?;
+        std::fs::remove_dir_all(wallet_path)?;
         Ok(())
     }
 
@@ -657,29 +1013,24 @@ impl WalletStorageType for SQLiteStorageType {
             .to_indy(IndyErrorKind::InvalidStructure, "Malformed config json")?;
 
         let db_path = SQLiteStorageType::_db_path(id, config.as_ref());
+        let wallet_path = db_path.parent().unwrap();
 
-        if db_path.exists() {
+        if db_path.exists() || sharded::exists(wallet_path) {
             return Err(err_msg(IndyErrorKind::WalletAlreadyExists, format!("Wallet database file already exists: {:?}", db_path)));
         }
 
         fs::DirBuilder::new()
             .recursive(true)
-            .create(db_path.parent().unwrap())?;
+            .create(wallet_path)?;
 
-        let conn = rusqlite::Connection::open(db_path.as_path())?;
+        let track_changes = config.as_ref().map(|config| config.track_changes).unwrap_or(false);
 
-        match conn.execute_batch(_CREATE_SCHEMA) {
-            Ok(_) => match conn.execute("INSERT OR REPLACE INTO metadata(value) VALUES(?1)", &[&metadata.to_vec()]) {
-                Ok(_) => Ok(()),
-                Err(error) => {
-                    std::fs::remove_file(db_path)?;
-                    Err(error.into())
-                }
-            },
-            Err(error) => {
-                std::fs::remove_file(db_path)?;
-                Err(error.into())
-            }
+        match config.as_ref() {
+            Some(&Config { shards: Some(shards), track_changes: true, .. }) if shards > 1 =>
+                Err(err_msg(IndyErrorKind::InvalidStructure, "Sharded wallets don't track changes")),
+            Some(&Config { shards: Some(shards), shard_by, .. }) if shards > 1 =>
+                sharded::create(wallet_path, shards, shard_by, metadata),
+            _ => _create_db(&db_path, metadata, track_changes)
         }
     }
 
@@ -717,27 +1068,21 @@ impl WalletStorageType for SQLiteStorageType {
             .to_indy(IndyErrorKind::InvalidStructure, "Malformed config json")?;
 
         let db_file_path = SQLiteStorageType::_db_path(id, config.as_ref());
+        let wallet_path = db_file_path.parent().unwrap();
+
+        // Layout of the wallet is chosen on creation, so config may omit shards on open
+        if sharded::exists(wallet_path) {
+            return sharded::open(wallet_path);
+        }
 
         if !db_file_path.exists() {
             return Err(err_msg(IndyErrorKind::WalletNotFound, "No wallet database exists"));
         }
 
-        let conn = rusqlite::Connection::open(db_file_path.as_path())?;
+        let track_changes = config.as_ref().map(|config| config.track_changes).unwrap_or(false);
+        let conn = _open_connection(&db_file_path, track_changes)?;
 
-        // set journal mode to WAL, because it provides better performance.
-        let journal_mode: String = conn.query_row(
-            "PRAGMA journal_mode = WAL",
-            [],
-            |row| { row.get(0) },
-        )?;
-
-        // if journal mode is set to WAL, set synchronous to FULL for safety reasons.
-        // (synchronous = NORMAL with journal_mode = WAL does not guaranties durability).
-        if journal_mode.to_lowercase() == "wal" {
-            conn.execute("PRAGMA synchronous = FULL", [])?;
-        }
-
-        Ok(Box::new(SQLiteStorage { conn: Rc::new(conn) }))
+        Ok(Box::new(SQLiteStorage::new(conn)))
     }
 }
 
@@ -930,6 +1275,49 @@ mod tests {
         _cleanup("sqlite_storage_set_get_works_for_twice");
     }
 
+    #[test]
+    fn sqlite_storage_add_records_works() {
+        _cleanup("sqlite_storage_add_records_works");
+        {
+            let storage = _storage("sqlite_storage_add_records_works");
+
+            let records = vec![
+                StorageRecord::new(_id1(), Some(_value1()), Some(_type1()), Some(_tags())),
+                StorageRecord::new(_id2(), Some(_value2()), Some(_type1()), None),
+            ];
+            storage.add_records(&records).unwrap();
+
+            let record = storage.get(&_type1(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+            assert_eq!(record.value.unwrap(), _value1());
+            assert_eq!(_sort(record.tags.unwrap()), _sort(_tags()));
+
+            let record = storage.get(&_type1(), &_id2(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+            assert_eq!(record.value.unwrap(), _value2());
+            assert!(record.tags.unwrap().is_empty());
+        }
+        _cleanup("sqlite_storage_add_records_works");
+    }
+
+    #[test]
+    fn sqlite_storage_add_records_works_for_duplicate() {
+        _cleanup("sqlite_storage_add_records_works_for_duplicate");
+        {
+            let storage = _storage("sqlite_storage_add_records_works_for_duplicate");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            let records = vec![
+                StorageRecord::new(_id2(), Some(_value2()), Some(_type1()), Some(_tags())),
+                StorageRecord::new(_id1(), Some(_value2()), Some(_type1()), Some(_tags())),
+            ];
+            let res = storage.add_records(&records);
+            assert_kind!(IndyErrorKind::WalletItemAlreadyExists, res);
+
+            let res = storage.get(&_type1(), &_id2(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##);
+            assert_kind!(IndyErrorKind::WalletItemNotFound, res);
+        }
+        _cleanup("sqlite_storage_add_records_works_for_duplicate");
+    }
+
     #[test]
     fn sqlite_storage_set_get_works_for_reopen() {
         _cleanup("sqlite_storage_set_get_works_for_reopen");
@@ -992,6 +1380,50 @@ mod tests {
         _cleanup("sqlite_storage_delete_works_for_non_existing");
     }
 
+    #[test]
+    fn sqlite_storage_delete_records_works() {
+        _cleanup("sqlite_storage_delete_records_works");
+        {
+            let storage = _storage("sqlite_storage_delete_records_works");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+            storage.add(&_type1(), &_id2(), &_value2(), &_new_tags()).unwrap();
+            storage.add(&_type2(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            let query = language::Operator::Eq(language::TagName::PlainTagName(vec![1, 5, 8, 1]),
+                                               language::TargetValue::Unencrypted("Plain value".to_string()));
+
+            let deleted = storage.delete_records(&_type1(), &query).unwrap();
+            assert_eq!(1, deleted);
+
+            let res = storage.get(&_type1(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##);
+            assert_kind!(IndyErrorKind::WalletItemNotFound, res);
+
+            storage.get(&_type1(), &_id2(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+            storage.get(&_type2(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+        }
+        _cleanup("sqlite_storage_delete_records_works");
+    }
+
+    #[test]
+    fn sqlite_storage_delete_records_works_for_empty_query() {
+        _cleanup("sqlite_storage_delete_records_works_for_empty_query");
+        {
+            let storage = _storage("sqlite_storage_delete_records_works_for_empty_query");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+            storage.add(&_type1(), &_id2(), &_value2(), &_tags()).unwrap();
+            storage.add(&_type2(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            let deleted = storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap();
+            assert_eq!(2, deleted);
+
+            let deleted = storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap();
+            assert_eq!(0, deleted);
+
+            storage.get(&_type2(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+        }
+        _cleanup("sqlite_storage_delete_records_works_for_empty_query");
+    }
+
     #[test]
     fn sqlite_storage_delete_returns_error_item_not_found_if_no_such_type() {
         _cleanup("sqlite_storage_delete_returns_error_item_not_found_if_no_such_type");
@@ -1044,6 +1476,187 @@ mod tests {
         _cleanup("sqlite_storage_get_all_works_for_empty");
     }
 
+    #[test]
+    fn sqlite_storage_get_changes_works() {
+        _cleanup("sqlite_storage_get_changes_works");
+        {
+            let storage = _tracked_storage("sqlite_storage_get_changes_works");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            let since = storage.get_change_seq().unwrap().unwrap();
+
+            storage.add(&_type2(), &_id2(), &_value2(), &_tags()).unwrap();
+            storage.update_tags(&_type2(), &_id2(), &_new_tags()).unwrap();
+            storage.delete(&_type1(), &_id1()).unwrap();
+
+            let until = storage.get_change_seq().unwrap().unwrap();
+            assert!(until > since);
+
+            let mut changes = storage.get_changes(since, until).unwrap();
+
+            match changes.next().unwrap().unwrap() {
+                StorageChange::Upserted(record) => {
+                    assert_eq!(record.id, _id2());
+                    assert_eq!(record.type_.unwrap(), _type2());
+                    assert_eq!(record.value.unwrap(), _value2());
+                    assert_eq!(_sort(record.tags.unwrap()), _sort(_new_tags()));
+                }
+                change => panic!("unexpected change: {:?}", change)
+            }
+
+            match changes.next().unwrap().unwrap() {
+                StorageChange::Deleted { type_, id } => {
+                    assert_eq!(type_, _type1());
+                    assert_eq!(id, _id1());
+                }
+                change => panic!("unexpected change: {:?}", change)
+            }
+
+            assert!(changes.next().unwrap().is_none());
+            assert!(storage.get_changes(until, until).unwrap().next().unwrap().is_none());
+        }
+        _cleanup("sqlite_storage_get_changes_works");
+    }
+
+    #[test]
+    fn sqlite_storage_get_changes_works_for_not_tracked_storage() {
+        _cleanup("sqlite_storage_get_changes_works_for_not_tracked_storage");
+        {
+            let storage = _storage("sqlite_storage_get_changes_works_for_not_tracked_storage");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            assert!(storage.get_change_seq().unwrap().is_none());
+            assert_kind!(IndyErrorKind::InvalidState, storage.get_changes(0, 1));
+        }
+        _cleanup("sqlite_storage_get_changes_works_for_not_tracked_storage");
+    }
+
+    #[test]
+    fn sqlite_storage_prune_changes_works() {
+        _cleanup("sqlite_storage_prune_changes_works");
+        {
+            let storage = _tracked_storage("sqlite_storage_prune_changes_works");
+            storage.add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+            storage.add(&_type2(), &_id2(), &_value2(), &_tags()).unwrap();
+            storage.delete(&_type1(), &_id1()).unwrap();
+
+            let until = storage.get_change_seq().unwrap().unwrap();
+            storage.prune_changes(until).unwrap();
+
+            // Sequence number doesn't go back when the latest change is pruned
+            assert_eq!(storage.get_change_seq().unwrap().unwrap(), until);
+            assert_kind!(IndyErrorKind::InvalidState, storage.get_changes(0, until));
+
+            let mut changes = storage.get_changes(until, until).unwrap();
+            assert!(changes.next().unwrap().is_none());
+        }
+        {
+            // Tracking stays enabled when the wallet is opened without track_changes
+            let storage = SQLiteStorageType::new().open_storage("sqlite_storage_prune_changes_works", None, None).unwrap();
+            let since = storage.get_change_seq().unwrap().unwrap();
+
+            storage.delete(&_type2(), &_id2()).unwrap();
+
+            let mut changes = storage.get_changes(since, storage.get_change_seq().unwrap().unwrap()).unwrap();
+
+            match changes.next().unwrap().unwrap() {
+                StorageChange::Deleted { id, .. } => assert_eq!(id, _id2()),
+                change => panic!("unexpected change: {:?}", change)
+            }
+        }
+        _cleanup("sqlite_storage_prune_changes_works");
+    }
+
+    #[test]
+    fn sqlite_storage_type_create_works_for_sharded_tracked_storage() {
+        _cleanup("sqlite_storage_type_create_works_for_sharded_tracked_storage");
+
+        let config = json!({"shards": 2, "track_changes": true}).to_string();
+        let res = SQLiteStorageType::new().create_storage("sqlite_storage_type_create_works_for_sharded_tracked_storage", Some(&config), None, &_metadata());
+        assert_kind!(IndyErrorKind::InvalidStructure, res);
+
+        _cleanup("sqlite_storage_type_create_works_for_sharded_tracked_storage");
+    }
+
+    #[test]
+    fn sqlite_storage_compact_works() {
+        _cleanup("sqlite_storage_compact_works");
+        {
+            let storage = _storage("sqlite_storage_compact_works");
+
+            for i in 0..200 {
+                storage.add(&_type1(), &_id(i), &_large_value(i), &_tags()).unwrap();
+            }
+            storage.add(&_type2(), &_id1(), &_value1(), &_tags()).unwrap();
+            assert_eq!(200, storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap());
+
+            let initial = storage.get_storage_size().unwrap().unwrap();
+            assert!(initial.free > 0);
+
+            let mut steps = 0;
+            let progress = loop {
+                let progress = storage.compact(8).unwrap().unwrap();
+                steps += 1;
+
+                if progress.done {
+                    break progress;
+                }
+            };
+
+            assert!(steps > 1);
+            assert_eq!(0, progress.size.free);
+            assert!(progress.size.size < initial.size);
+
+            let record = storage.get(&_type2(), &_id1(), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+            assert_eq!(record.value.unwrap(), _value1());
+            assert_eq!(_sort(record.tags.unwrap()), _sort(_tags()));
+        }
+        _cleanup("sqlite_storage_compact_works");
+    }
+
+    #[test]
+    fn sqlite_storage_compact_works_for_wallet_without_incremental_vacuum() {
+        _cleanup("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum");
+        {
+            _storage("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum").add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            // Wallets created by the previous versions have no auto vacuum
+            let db_path = SQLiteStorageType::_db_path("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum", None);
+            rusqlite::Connection::open(&db_path).unwrap().execute_batch("PRAGMA auto_vacuum=NONE; VACUUM;").unwrap();
+
+            let storage = SQLiteStorageType::new().open_storage("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum", None, None).unwrap();
+            assert!(storage.compact(8).unwrap().unwrap().done);
+
+            let auto_vacuum: i64 = rusqlite::Connection::open(&db_path).unwrap()
+                .query_row("PRAGMA auto_vacuum", [], |row| row.get(0)).unwrap();
+            assert_eq!(_AUTO_VACUUM_INCREMENTAL, auto_vacuum);
+
+            storage.get(&_type1(), &_id1(), "{}").unwrap();
+        }
+        _cleanup("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum");
+    }
+
+    #[test]
+    fn sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search() {
+        _cleanup("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search");
+        {
+            _storage("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search").add(&_type1(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            let db_path = SQLiteStorageType::_db_path("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search", None);
+            rusqlite::Connection::open(&db_path).unwrap().execute_batch("PRAGMA auto_vacuum=NONE; VACUUM;").unwrap();
+
+            let storage = SQLiteStorageType::new().open_storage("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search", None, None).unwrap();
+
+            let search = storage.get_all().unwrap();
+            let res = storage.compact(8);
+            assert_kind!(IndyErrorKind::InvalidState, res);
+
+            drop(search);
+            assert!(storage.compact(8).unwrap().unwrap().done);
+        }
+        _cleanup("sqlite_storage_compact_works_for_wallet_without_incremental_vacuum_and_open_search");
+    }
+
     #[test]
     fn sqlite_storage_update_works() {
         _cleanup("sqlite_storage_update_works");
@@ -1313,6 +1926,157 @@ mod tests {
         _cleanup("sqlite_storage_delete_tags_works_for_non_existing_id");
     }
 
+    #[test]
+    fn sqlite_sharded_storage_works() {
+        _cleanup("sqlite_sharded_storage_works");
+        {
+            let storage = _sharded_storage("sqlite_sharded_storage_works", "id");
+
+            for i in 0..50 {
+                storage.add(&_type1(), &_id(i), &_value(i), &_tags()).unwrap();
+            }
+            storage.add(&_type2(), &_id1(), &_value1(), &_tags()).unwrap();
+
+            for i in 0..50 {
+                let record = storage.get(&_type1(), &_id(i), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+                assert_eq!(record.value.unwrap(), _value(i));
+                assert_eq!(_sort(record.tags.unwrap()), _sort(_tags()));
+            }
+
+            let mut iterator = storage.search(&_type1(), &_plain_tag_query(), Some(_SEARCH_OPTIONS)).unwrap();
+            assert_eq!(Some(50), iterator.get_total_count().unwrap());
+            assert_eq!(50, _count(&mut iterator));
+
+            assert_eq!(51, _count(&mut storage.get_all().unwrap()));
+
+            // Items of one type are spread across shards
+            let non_empty_shards = (0..4)
+                .map(|idx| rusqlite::Connection::open(_wallet_path("sqlite_sharded_storage_works").join(format!("shard_{}.db", idx))).unwrap())
+                .filter(|conn| conn.query_row("SELECT COUNT(*) FROM items", [], |row| row.get::<_, i64>(0)).unwrap() > 0)
+                .count();
+            assert!(non_empty_shards > 1);
+
+            storage.update(&_type1(), &_id1(), &_value2()).unwrap();
+            storage.delete(&_type1(), &_id2()).unwrap();
+
+            assert_eq!(49, storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap());
+            assert_eq!(1, _count(&mut storage.get_all().unwrap()));
+
+            storage.set_storage_metadata(&[1, 2, 3]).unwrap();
+        }
+        {
+            // Layout is read from the wallet directory on open
+            let storage = SQLiteStorageType::new().open_storage("sqlite_sharded_storage_works", None, None).unwrap();
+            assert_eq!(vec![1, 2, 3], storage.get_storage_metadata().unwrap());
+            storage.get(&_type2(), &_id1(), "{}").unwrap();
+            assert!(storage.get_change_seq().unwrap().is_none());
+        }
+
+        SQLiteStorageType::new().delete_storage("sqlite_sharded_storage_works", None, None).unwrap();
+        assert!(!_wallet_path("sqlite_sharded_storage_works").exists());
+    }
+
+    #[test]
+    fn sqlite_sharded_storage_compact_works() {
+        _cleanup("sqlite_sharded_storage_compact_works");
+        {
+            let storage = _sharded_storage("sqlite_sharded_storage_compact_works", "id");
+
+            for i in 0..100 {
+                storage.add(&_type1(), &_id(i), &_large_value(i), &_tags()).unwrap();
+            }
+            storage.delete_records(&_type1(), &language::Operator::And(vec![])).unwrap();
+
+            let initial = storage.get_storage_size().unwrap().unwrap();
+
+            // Shards are compacted one by one, so a pass takes a step per shard at least
+            let mut steps = 0;
+            let progress = loop {
+                let progress = storage.compact(8).unwrap().unwrap();
+                steps += 1;
+
+                if progress.done {
+                    break progress;
+                }
+            };
+
+            assert!(steps >= 4);
+            assert_eq!(0, progress.size.free);
+            assert!(progress.size.size < initial.size);
+        }
+        _cleanup("sqlite_sharded_storage_compact_works");
+    }
+
+    #[test]
+    fn sqlite_sharded_storage_add_records_works() {
+        _cleanup("sqlite_sharded_storage_add_records_works");
+        {
+            let storage = _sharded_storage("sqlite_sharded_storage_add_records_works", "type");
+
+            let records: Vec<StorageRecord> = (0..100)
+                .map(|i| StorageRecord::new(_id(i), Some(_value(i)), Some(_type(i % 2)), Some(_tags())))
+                .collect();
+            storage.add_records(&records).unwrap();
+
+            for i in 0..100 {
+                let record = storage.get(&_type(i % 2), &_id(i), r##"{"retrieveType": false, "retrieveValue": true, "retrieveTags": true}"##).unwrap();
+                assert_eq!(record.value.unwrap(), _value(i));
+            }
+
+            let mut iterator = storage.search(&_type(1), &_plain_tag_query(), Some(_SEARCH_OPTIONS)).unwrap();
+            assert_eq!(Some(50), iterator.get_total_count().unwrap());
+            assert_eq!(50, _count(&mut iterator));
+
+            let res = storage.add_records(&records[..1]);
+            assert_kind!(IndyErrorKind::WalletItemAlreadyExists, res);
+        }
+        _cleanup("sqlite_sharded_storage_add_records_works");
+    }
+
+    #[test]
+    fn sqlite_sharded_storage_type_create_works_for_twice() {
+        _cleanup("sqlite_sharded_storage_type_create_works_for_twice");
+
+        _sharded_storage("sqlite_sharded_storage_type_create_works_for_twice", "id");
+
+        let storage_type = SQLiteStorageType::new();
+        let res = storage_type.create_storage("sqlite_sharded_storage_type_create_works_for_twice", None, None, &_metadata());
+        assert_kind!(IndyErrorKind::WalletAlreadyExists, res);
+
+        storage_type.delete_storage("sqlite_sharded_storage_type_create_works_for_twice", None, None).unwrap();
+    }
+
+    const _SEARCH_OPTIONS: &str = r#"{"retrieveRecords": true, "retrieveTotalCount": true, "retrieveType": false, "retrieveValue": true, "retrieveTags": false}"#;
+
+    fn _plain_tag_query() -> language::Operator {
+        language::Operator::Eq(language::TagName::PlainTagName(vec![1, 5, 8, 1]),
+                               language::TargetValue::Unencrypted("Plain value".to_string()))
+    }
+
+    fn _count(iterator: &mut Box<dyn StorageIterator>) -> usize {
+        let mut count = 0;
+        while iterator.next().unwrap().is_some() {
+            count += 1;
+        }
+        count
+    }
+
+    fn _sharded_storage(name: &str, shard_by: &str) -> Box<dyn WalletStorage> {
+        let storage_type = SQLiteStorageType::new();
+
+        let config = json!({
+            "shards": 4,
+            "shard_by": shard_by
+        }).to_string();
+
+        storage_type.create_storage(name, Some(&config), None, &_metadata()).unwrap();
+        storage_type.open_storage(name, Some(&config), None).unwrap()
+    }
+
+    fn _wallet_path(name: &str) -> PathBuf {
+        SQLiteStorageType::_wallet_path(name, None)
+    }
+
     fn _cleanup(name: &str) {
         test::cleanup_storage(name)
     }
@@ -1323,6 +2087,17 @@ mod tests {
         storage_type.open_storage(name, None, None).unwrap()
     }
 
+    fn _tracked_storage(name: &str) -> Box<dyn WalletStorage> {
+        let storage_type = SQLiteStorageType::new();
+
+        let config = json!({
+            "track_changes": true
+        }).to_string();
+
+        storage_type.create_storage(name, Some(&config), None, &_metadata()).unwrap();
+        storage_type.open_storage(name, Some(&config), None).unwrap()
+    }
+
     fn _storage_custom(name: &str) -> Box<dyn WalletStorage> {
         let storage_type = SQLiteStorageType::new();
 
@@ -1375,6 +2150,10 @@ mod tests {
         EncryptedValue { data: vec![6 + i, 7 + i, 8 + i], key: vec![9 + i, 10 + i, 11 + i] }
     }
 
+    fn _large_value(i: u8) -> EncryptedValue {
+        EncryptedValue { data: vec![i; 1024], key: vec![9 + i, 10 + i, 11 + i] }
+    }
+
     fn _value1() -> EncryptedValue {
         _value(1)
     }
@@ -37,6 +37,20 @@ pub fn wql_to_sql_count<'a>(class: &'a Vec<u8>, op: &'a Operator) -> Result<(Str
 }
 
 
+pub fn wql_to_sql_delete<'a>(class: &'a Vec<u8>, op: &'a Operator) -> Result<(String, Vec<&'a dyn ToSql>), IndyError> {
+    let mut arguments: Vec<&dyn ToSql> = Vec::new();
+    arguments.push(class);
+    let clause_string = operator_to_sql(op, &mut arguments)?;
+    let mut query_string = "DELETE FROM items WHERE id IN (SELECT i.id FROM items as i WHERE i.type = ?".to_string();
+    if !clause_string.is_empty() {
+        query_string.push_str(" AND ");
+        query_string.push_str(&clause_string);
+    }
+    query_string.push(')');
+    Ok((query_string, arguments))
+}
+
+
 fn operator_to_sql<'a>(op: &'a Operator, arguments: &mut Vec<&'a dyn ToSql>) -> IndyResult<String> {
     match *op {
         Operator::Eq(ref tag_name, ref target_value) => eq_to_sql(tag_name, target_value, arguments),
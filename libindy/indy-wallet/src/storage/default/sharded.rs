@@ -0,0 +1,319 @@
+//! Opt-in sharded layout of the default storage for very large wallets.
+//!
+//! Items are spread across several SQLite files by a stable hash of their type, or of their type
+//! and id. Every shard has its own connection, WAL and writer. Operations on a single item go to
+//! its shard only, searches run on every shard that can hold the type and chain the results,
+//! batches of records are written to all shards in parallel.
+//!
+//! The layout is chosen on wallet creation with `shards` and `shard_by` keys of storage config and
+//! is kept in `shards.json` next to shard files, so wallets are opened without repeating it.
+//! Sharded storage doesn't track changes, so differential export is not available for it.
+//! Shards are compacted one after another, a compaction step works on a single shard.
+
+use std::cell::Cell;
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::thread;
+
+use serde_json;
+
+use indy_api_types::errors::prelude::*;
+use crate::language;
+
+use super::{_add_records, _create_db, _open_connection, SQLiteStorage};
+use super::super::{CompactionProgress, EncryptedValue, StorageIterator, StorageRecord, StorageSize, Tag, TagName, WalletStorage};
+
+const _SHARDS_FILE: &str = "shards.json";
+
+// FNV-1a parameters. Shard of an item is persisted by its file, so the hash must never change
+const _FNV_OFFSET: u64 = 0xcbf2_9ce4_8422_2325;
+const _FNV_PRIME: u64 = 0x0000_0100_0000_01b3;
+
+#[derive(Clone, Copy, Debug, PartialEq, Serialize, Deserialize)]
+#[serde(rename_all = "lowercase")]
+pub enum ShardBy {
+    // Items of a type are spread across all shards, searches run on every shard
+    Id,
+    // All items of a type live in one shard, searches run on that shard only
+    Type,
+}
+
+impl Default for ShardBy {
+    fn default() -> Self {
+        ShardBy::Id
+    }
+}
+
+#[derive(Debug, Serialize, Deserialize)]
+struct Layout {
+    count: usize,
+    shard_by: ShardBy,
+}
+
+struct ShardedSQLiteStorage {
+    shards: Vec<SQLiteStorage>,
+    paths: Vec<PathBuf>,
+    shard_by: ShardBy,
+    // Shard compacted by the current compaction pass
+    compacting: Cell<usize>,
+}
+
+pub fn exists(wallet_path: &Path) -> bool {
+    wallet_path.join(_SHARDS_FILE).exists()
+}
+
+pub fn create(wallet_path: &Path, count: usize, shard_by: ShardBy, metadata: &[u8]) -> IndyResult<()> {
+    let res = _create(wallet_path, count, shard_by, metadata);
+
+    if res.is_err() {
+        for idx in 0..count {
+            let _ = fs::remove_file(_shard_path(wallet_path, idx));
+        }
+        let _ = fs::remove_file(wallet_path.join(_SHARDS_FILE));
+    }
+
+    res
+}
+
+fn _create(wallet_path: &Path, count: usize, shard_by: ShardBy, metadata: &[u8]) -> IndyResult<()> {
+    for idx in 0..count {
+        _create_db(&_shard_path(wallet_path, idx), metadata, false)?;
+    }
+
+    // Layout file is written last, so a wallet is never opened with missing shards
+    let layout = serde_json::to_string(&Layout { count, shard_by })
+        .to_indy(IndyErrorKind::InvalidState, "Can't serialize shards layout")?;
+
+    fs::write(wallet_path.join(_SHARDS_FILE), layout)?;
+    Ok(())
+}
+
+pub fn open(wallet_path: &Path) -> IndyResult<Box<dyn WalletStorage>> {
+    let layout = fs::read_to_string(wallet_path.join(_SHARDS_FILE))?;
+    let layout: Layout = serde_json::from_str(&layout)
+        .to_indy(IndyErrorKind::InvalidState, "Malformed shards layout")?;
+
+    let paths: Vec<PathBuf> = (0..layout.count).map(|idx| _shard_path(wallet_path, idx)).collect();
+
+    let mut shards = Vec::with_capacity(paths.len());
+
+    for path in paths.iter() {
+        if !path.exists() {
+            return Err(err_msg(IndyErrorKind::InvalidState, format!("Wallet shard file isn't found: {:?}", path)));
+        }
+
+        shards.push(SQLiteStorage::new(_open_connection(path, false)?));
+    }
+
+    Ok(Box::new(ShardedSQLiteStorage { shards, paths, shard_by: layout.shard_by, compacting: Cell::new(0) }))
+}
+
+fn _shard_path(wallet_path: &Path, idx: usize) -> PathBuf {
+    wallet_path.join(format!("shard_{}.db", idx))
+}
+
+fn _hash(hash: u64, bytes: &[u8]) -> u64 {
+    bytes.iter().fold(hash, |hash, byte| (hash ^ u64::from(*byte)).wrapping_mul(_FNV_PRIME))
+}
+
+impl ShardedSQLiteStorage {
+    fn _shard_idx(&self, type_: &[u8], id: &[u8]) -> usize {
+        let hash = _hash(_FNV_OFFSET, type_);
+
+        let hash = match self.shard_by {
+            ShardBy::Id => _hash(hash, id),
+            ShardBy::Type => hash,
+        };
+
+        (hash % self.shards.len() as u64) as usize
+    }
+
+    fn _shard(&self, type_: &[u8], id: &[u8]) -> &SQLiteStorage {
+        &self.shards[self._shard_idx(type_, id)]
+    }
+
+    fn _storage_size(&self) -> IndyResult<StorageSize> {
+        let mut size = StorageSize::default();
+
+        for shard in self.shards.iter() {
+            let shard_size = shard._storage_size()?;
+            size.size += shard_size.size;
+            size.free += shard_size.free;
+        }
+
+        Ok(size)
+    }
+
+    // Shards that can hold items of the type
+    fn _type_shards(&self, type_: &[u8]) -> Vec<&SQLiteStorage> {
+        match self.shard_by {
+            ShardBy::Id => self.shards.iter().collect(),
+            ShardBy::Type => vec![self._shard(type_, &[])],
+        }
+    }
+}
+
+impl WalletStorage for ShardedSQLiteStorage {
+    fn get(&self, type_: &[u8], id: &[u8], options: &str) -> IndyResult<StorageRecord> {
+        self._shard(type_, id).get(type_, id, options)
+    }
+
+    fn add(&self, type_: &[u8], id: &[u8], value: &EncryptedValue, tags: &[Tag]) -> IndyResult<()> {
+        self._shard(type_, id).add(type_, id, value, tags)
+    }
+
+    fn update(&self, type_: &[u8], id: &[u8], value: &EncryptedValue) -> IndyResult<()> {
+        self._shard(type_, id).update(type_, id, value)
+    }
+
+    fn add_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> IndyResult<()> {
+        self._shard(type_, id).add_tags(type_, id, tags)
+    }
+
+    fn update_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> IndyResult<()> {
+        self._shard(type_, id).update_tags(type_, id, tags)
+    }
+
+    fn delete_tags(&self, type_: &[u8], id: &[u8], tag_names: &[TagName]) -> IndyResult<()> {
+        self._shard(type_, id).delete_tags(type_, id, tag_names)
+    }
+
+    fn delete(&self, type_: &[u8], id: &[u8]) -> IndyResult<()> {
+        self._shard(type_, id).delete(type_, id)
+    }
+
+    fn get_storage_metadata(&self) -> IndyResult<Vec<u8>> {
+        self.shards[0].get_storage_metadata()
+    }
+
+    // Metadata is read from shard 0 only, so it is written there last: if writing to another shard
+    // fails the wallet keeps its previous metadata.
+    fn set_storage_metadata(&self, metadata: &[u8]) -> IndyResult<()> {
+        for shard in self.shards.iter().skip(1) {
+            shard.set_storage_metadata(metadata)?;
+        }
+
+        self.shards[0].set_storage_metadata(metadata)
+    }
+
+    fn get_all(&self) -> IndyResult<Box<dyn StorageIterator>> {
+        let iterators = self.shards.iter()
+            .map(|shard| shard.get_all())
+            .collect::<IndyResult<Vec<_>>>()?;
+
+        Ok(Box::new(ShardedStorageIterator { iterators, current: 0 }))
+    }
+
+    fn search(&self, type_: &[u8], query: &language::Operator, options: Option<&str>) -> IndyResult<Box<dyn StorageIterator>> {
+        let iterators = self._type_shards(type_).into_iter()
+            .map(|shard| shard.search(type_, query, options))
+            .collect::<IndyResult<Vec<_>>>()?;
+
+        Ok(Box::new(ShardedStorageIterator { iterators, current: 0 }))
+    }
+
+    fn close(&mut self) -> IndyResult<()> {
+        for shard in self.shards.iter_mut() {
+            shard.close()?;
+        }
+
+        Ok(())
+    }
+
+    // Every shard writes its part of the batch in its own thread and transaction, so a failed batch
+    // may be partially added to other shards.
+    fn add_records(&self, records: &[StorageRecord]) -> IndyResult<()> {
+        let mut batches: Vec<Vec<StorageRecord>> = vec![Vec::new(); self.shards.len()];
+
+        for record in records {
+            let type_ = record.type_.as_ref()
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Record to add must contain type and value"))?;
+
+            batches[self._shard_idx(type_, &record.id)].push(record.clone());
+        }
+
+        let writers: Vec<_> = self.paths.iter().cloned()
+            .zip(batches.into_iter())
+            .filter(|&(_, ref batch)| !batch.is_empty())
+            .map(|(path, batch)| thread::spawn(move || {
+                let conn = _open_connection(&path, false)?;
+                _add_records(&conn, &batch)
+            }))
+            .collect();
+
+        let mut res = Ok(());
+
+        for writer in writers {
+            let writer_res = writer.join()
+                .unwrap_or_else(|_| Err(err_msg(IndyErrorKind::InvalidState, "Wallet shard writer panicked")));
+
+            if res.is_ok() {
+                res = writer_res;
+            }
+        }
+
+        res
+    }
+
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> IndyResult<usize> {
+        let mut deleted = 0;
+
+        for shard in self._type_shards(type_) {
+            deleted += shard.delete_records(type_, query)?;
+        }
+
+        Ok(deleted)
+    }
+
+    fn compact(&self, max_pages: usize) -> IndyResult<Option<CompactionProgress>> {
+        let shard = self.compacting.get();
+
+        let shard_done = self.shards[shard].compact(max_pages)?
+            .map(|progress| progress.done)
+            .unwrap_or(true);
+
+        let done = shard_done && shard + 1 == self.shards.len();
+
+        if shard_done {
+            self.compacting.set(if done { 0 } else { shard + 1 });
+        }
+
+        let size = self._storage_size()?;
+        Ok(Some(CompactionProgress { done, size }))
+    }
+
+    fn get_storage_size(&self) -> IndyResult<Option<StorageSize>> {
+        self._storage_size().map(Some)
+    }
+}
+
+struct ShardedStorageIterator {
+    iterators: Vec<Box<dyn StorageIterator>>,
+    current: usize,
+}
+
+impl StorageIterator for ShardedStorageIterator {
+    fn next(&mut self) -> IndyResult<Option<StorageRecord>> {
+        while self.current < self.iterators.len() {
+            if let Some(record) = self.iterators[self.current].next()? {
+                return Ok(Some(record));
+            }
+
+            self.current += 1;
+        }
+
+        Ok(None)
+    }
+
+    fn get_total_count(&self) -> IndyResult<Option<usize>> {
+        let mut total_count = None;
+
+        for iterator in self.iterators.iter() {
+            if let Some(count) = iterator.get_total_count()? {
+                total_count = Some(total_count.unwrap_or(0) + count);
+            }
+        }
+
+        Ok(total_count)
+    }
+}
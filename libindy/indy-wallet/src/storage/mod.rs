@@ -2,6 +2,7 @@ pub mod default;
 pub mod plugged;
 
 use indy_api_types::errors::prelude::*;
+use indy_api_types::wallet::{WalletAddRecords, WalletDeleteRecords};
 use crate::language;
 use crate::wallet::EncryptedValue;
 
@@ -41,6 +42,37 @@ pub trait StorageIterator {
     fn get_total_count(&self) -> Result<Option<usize>, IndyError>;
 }
 
+/// Change of a single item recorded by storages that track changes.
+#[derive(Clone, Debug)]
+pub enum StorageChange {
+    // Item was added or its value or tags were changed. Contains the current state of the item
+    Upserted(StorageRecord),
+    // Item was deleted
+    Deleted { type_: Vec<u8>, id: Vec<u8> },
+}
+
+pub trait StorageChangeIterator {
+    fn next(&mut self) -> Result<Option<StorageChange>, IndyError>;
+}
+
+/// Size of the storage in bytes.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Serialize)]
+pub struct StorageSize {
+    // Total size, including free space
+    pub size: u64,
+    // Space that is allocated, but holds no data and can be reclaimed by compaction
+    pub free: u64,
+}
+
+/// State of the storage after a compaction step.
+#[derive(Clone, Copy, Debug, PartialEq, Serialize)]
+pub struct CompactionProgress {
+    // Compaction pass is finished, the next step starts a new one
+    pub done: bool,
+    #[serde(flatten)]
+    pub size: StorageSize,
+}
+
 pub trait WalletStorage {
     fn get(&self, type_: &[u8], id: &[u8], options: &str) -> Result<StorageRecord, IndyError>;
     fn add(&self, type_: &[u8], id: &[u8], value: &EncryptedValue, tags: &[Tag]) -> Result<(), IndyError>;
@@ -54,10 +86,93 @@ pub trait WalletStorage {
     fn get_all(&self) -> Result<Box<dyn StorageIterator>, IndyError>;
     fn search(&self, type_: &[u8], query: &language::Operator, options: Option<&str>) -> Result<Box<dyn StorageIterator>, IndyError>;
     fn close(&mut self) -> Result<(), IndyError>;
+
+    /// Adds a batch of records (type, value and optional tags must be set).
+    /// Storages that can load data in bulk should override it; default adds records one by one.
+    fn add_records(&self, records: &[StorageRecord]) -> Result<(), IndyError> {
+        add_records_one_by_one(self, records)
+    }
+
+    /// Deletes all records of the type matching the query and returns the number of deleted records.
+    /// Storages that can delete by query in one statement should override it; default searches
+    /// matching records and deletes them one by one.
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> Result<usize, IndyError> {
+        delete_records_one_by_one(self, type_, query)
+    }
+
+    /// Sequence number of the latest tracked change or None if storage doesn't track changes.
+    fn get_change_seq(&self) -> Result<Option<u64>, IndyError> {
+        Ok(None)
+    }
+
+    /// Latest state of items changed after `since` sequence number up to `until` one (inclusive).
+    fn get_changes(&self, _since: u64, _until: u64) -> Result<Box<dyn StorageChangeIterator>, IndyError> {
+        Err(err_msg(IndyErrorKind::InvalidState, "Wallet storage doesn't track changes"))
+    }
+
+    /// Drops changes of deleted items up to `until` sequence number (inclusive) once an export has consumed them.
+    /// Later differential exports must be based on that export.
+    fn prune_changes(&self, _until: u64) -> Result<(), IndyError> {
+        Ok(())
+    }
+
+    /// Runs one bounded step of online compaction, so other operations can run between steps.
+    /// Returns None if storage can't be compacted.
+    fn compact(&self, _max_pages: usize) -> Result<Option<CompactionProgress>, IndyError> {
+        Ok(None)
+    }
+
+    /// Current size of the storage or None if storage doesn't report it.
+    fn get_storage_size(&self) -> Result<Option<StorageSize>, IndyError> {
+        Ok(None)
+    }
+}
+
+fn add_records_one_by_one<S: WalletStorage + ?Sized>(storage: &S, records: &[StorageRecord]) -> Result<(), IndyError> {
+    for record in records {
+        let (type_, value) = match (record.type_.as_ref(), record.value.as_ref()) {
+            (Some(type_), Some(value)) => (type_, value),
+            _ => return Err(err_msg(IndyErrorKind::InvalidStructure, "Record to add must contain type and value"))
+        };
+
+        storage.add(type_, &record.id, value, record.tags.as_ref().map(Vec::as_slice).unwrap_or(&[]))?;
+    }
+
+    Ok(())
+}
+
+fn delete_records_one_by_one<S: WalletStorage + ?Sized>(storage: &S, type_: &[u8], query: &language::Operator) -> Result<usize, IndyError> {
+    let options = r#"{"retrieveRecords": true, "retrieveTotalCount": false, "retrieveType": false, "retrieveValue": false, "retrieveTags": false}"#;
+
+    // Ids are collected first as storage search may not survive deletes of its records
+    let mut ids = Vec::new();
+    {
+        let mut iterator = storage.search(type_, query, Some(options))?;
+
+        while let Some(record) = iterator.next()? {
+            ids.push(record.id);
+        }
+    }
+
+    for id in ids.iter() {
+        storage.delete(type_, id)?;
+    }
+
+    Ok(ids.len())
 }
 
 pub trait WalletStorageType {
     fn create_storage(&self, id: &str, config: Option<&str>, credentials: Option<&str>, metadata: &[u8]) -> Result<(), IndyError>;
     fn open_storage(&self, id: &str, config: Option<&str>, credentials: Option<&str>) -> Result<Box<dyn WalletStorage>, IndyError>;
     fn delete_storage(&self, id: &str, config: Option<&str>, credentials: Option<&str>) -> Result<(), IndyError>;
+
+    /// Sets optional bulk add handler of plugged storage type.
+    fn set_add_records_handler(&self, _add_records: WalletAddRecords) -> Result<(), IndyError> {
+        Err(err_msg(IndyErrorKind::InvalidState, "Only plugged wallet storage types accept handlers"))
+    }
+
+    /// Sets optional delete by query handler of plugged storage type.
+    fn set_delete_records_handler(&self, _delete_records: WalletDeleteRecords) -> Result<(), IndyError> {
+        Err(err_msg(IndyErrorKind::InvalidState, "Only plugged wallet storage types accept handlers"))
+    }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 use std::{slice, str};
+use std::cell::Cell;
 use std::collections::HashMap;
 use std::ffi::{CStr, CString};
 use std::ptr;
@@ -26,6 +27,15 @@ pub struct PluggedWalletJSONValues {
     pub values: Vec<PluggedWalletJSONValue>
 }
 
+#[derive(Debug, Serialize)]
+struct PluggedWalletJSONRecord {
+    #[serde(rename = "type")]
+    type_: String,
+    id: String,
+    value: String,
+    tags: HashMap<String, String>,
+}
+
 // This struct is used as a helper to free the resource even in case of error.
 // It is workaround for Rust's lack of try/catch.
 struct ResourceGuard {
@@ -235,6 +245,8 @@ struct PluggedStorage {
     fetch_search_next_record_handler: WalletFetchSearchNextRecord,
     free_search_handler: WalletFreeSearch,
     close_handler: WalletClose,
+    add_records_handler: Option<WalletAddRecords>,
+    delete_records_handler: Option<WalletDeleteRecords>,
 }
 
 impl PluggedStorage {
@@ -259,7 +271,9 @@ impl PluggedStorage {
            get_search_total_count_handler: WalletGetSearchTotalCount,
            fetch_search_next_record_handler: WalletFetchSearchNextRecord,
            free_search_handler: WalletFreeSearch,
-           close_handler: WalletClose) -> PluggedStorage {
+           close_handler: WalletClose,
+           add_records_handler: Option<WalletAddRecords>,
+           delete_records_handler: Option<WalletDeleteRecords>) -> PluggedStorage {
         PluggedStorage {
             handle,
             add_record_handler,
@@ -283,11 +297,13 @@ impl PluggedStorage {
             fetch_search_next_record_handler,
             free_search_handler,
             close_handler,
+            add_records_handler,
+            delete_records_handler,
         }
     }
 }
 
-fn _tags_to_json(tags: &[Tag]) -> IndyResult<String> {
+fn _tags_to_map(tags: &[Tag]) -> HashMap<String, String> {
     let mut string_tags = HashMap::with_capacity(tags.len());
 
     for tag in tags {
@@ -297,7 +313,11 @@ fn _tags_to_json(tags: &[Tag]) -> IndyResult<String> {
         };
     }
 
-    serde_json::to_string(&string_tags)
+    string_tags
+}
+
+fn _tags_to_json(tags: &[Tag]) -> IndyResult<String> {
+    serde_json::to_string(&_tags_to_map(tags))
         .to_indy(IndyErrorKind::InvalidState, "Unable to serialize tags as json")
 }
 
@@ -434,6 +454,43 @@ impl WalletStorage for PluggedStorage {
         Ok(())
     }
 
+    fn add_records(&self, records: &[StorageRecord]) -> IndyResult<()> {
+        let add_records_handler = match self.add_records_handler {
+            Some(add_records_handler) => add_records_handler,
+            None => return super::add_records_one_by_one(self, records)
+        };
+
+        let mut json_records = Vec::with_capacity(records.len());
+
+        for record in records {
+            let (type_, value) = match (record.type_.as_ref(), record.value.as_ref()) {
+                (Some(type_), Some(value)) => (type_, value),
+                _ => return Err(err_msg(IndyErrorKind::InvalidStructure, "Record to add must contain type and value"))
+            };
+
+            json_records.push(PluggedWalletJSONRecord {
+                type_: base64::encode(type_),
+                id: base64::encode(&record.id),
+                value: base64::encode(&value.to_bytes()),
+                tags: _tags_to_map(record.tags.as_ref().map(Vec::as_slice).unwrap_or(&[])),
+            });
+        }
+
+        let records_json = serde_json::to_string(&json_records)
+            .to_indy(IndyErrorKind::InvalidState, "Unable to serialize records as json")?;
+        let records_json = CString::new(records_json)?;
+
+        let err = (add_records_handler)(self.handle, records_json.as_ptr());
+
+        if err == ErrorCode::WalletItemAlreadyExists {
+            return Err(err_msg(IndyErrorKind::WalletItemAlreadyExists, "Wallet item already exists"));
+        } else if err != ErrorCode::Success {
+            return Err(err.into());
+        }
+
+        Ok(())
+    }
+
     fn add_tags(&self, type_: &[u8], id: &[u8], tags: &[Tag]) -> IndyResult<()> {
         let type_ = CString::new(base64::encode(type_))?;
         let id = CString::new(base64::encode(id))?;
@@ -518,6 +575,28 @@ impl WalletStorage for PluggedStorage {
         Ok(())
     }
 
+    fn delete_records(&self, type_: &[u8], query: &language::Operator) -> IndyResult<usize> {
+        let delete_records_handler = match self.delete_records_handler {
+            Some(delete_records_handler) => delete_records_handler,
+            None => return super::delete_records_one_by_one(self, type_, query)
+        };
+
+        let type_ = CString::new(base64::encode(type_))?;
+        let query = CString::new(query.to_string())?;
+        let mut deleted_count: usize = 0;
+
+        let err = (delete_records_handler)(self.handle,
+                                           type_.as_ptr(),
+                                           query.as_ptr(),
+                                           &mut deleted_count);
+
+        if err != ErrorCode::Success {
+            return Err(err.into());
+        }
+
+        Ok(deleted_count)
+    }
+
     fn get_storage_metadata(&self) -> IndyResult<Vec<u8>> {
         let mut metadata_ptr: *const c_char = ptr::null_mut();
         let mut metadata_handle = -1;
@@ -655,6 +734,8 @@ pub struct PluggedStorageType {
     get_search_total_count_handler: WalletGetSearchTotalCount,
     fetch_search_next_record_handler: WalletFetchSearchNextRecord,
     free_search_handler: WalletFreeSearch,
+    add_records_handler: Cell<Option<WalletAddRecords>>,
+    delete_records_handler: Cell<Option<WalletDeleteRecords>>,
 }
 
 
@@ -708,6 +789,8 @@ impl PluggedStorageType {
             get_search_total_count_handler,
             fetch_search_next_record_handler,
             free_search_handler,
+            add_records_handler: Cell::new(None),
+            delete_records_handler: Cell::new(None),
         }
     }
 }
@@ -781,7 +864,9 @@ impl WalletStorageType for PluggedStorageType {
                 self.get_search_total_count_handler,
                 self.fetch_search_next_record_handler,
                 self.free_search_handler,
-                self.close_handler)))
+                self.close_handler,
+                self.add_records_handler.get(),
+                self.delete_records_handler.get())))
     }
 
     fn delete_storage(&self, id: &str, config: Option<&str>, credentials: Option<&str>) -> IndyResult<()> {
@@ -805,6 +890,16 @@ impl WalletStorageType for PluggedStorageType {
 
         Ok(())
     }
+
+    fn set_add_records_handler(&self, add_records: WalletAddRecords) -> IndyResult<()> {
+        self.add_records_handler.set(Some(add_records));
+        Ok(())
+    }
+
+    fn set_delete_records_handler(&self, delete_records: WalletDeleteRecords) -> IndyResult<()> {
+        self.delete_records_handler.set(Some(delete_records));
+        Ok(())
+    }
 }
 
 #[cfg(test)]
@@ -867,6 +962,8 @@ mod tests {
         GetSearchTotalCountHandler(i32, i32),
         FetchSearchNextRecordHandler(i32, i32),
         FreeSearchHandler(i32, i32),
+        AddRecordsHandler(i32, serde_json::Value),
+        DeleteRecordsHandler(i32, Option<String>, Option<String>),
     }
 
     fn _random_vector(len: usize) -> Vec<u8> {
@@ -1021,6 +1118,37 @@ mod tests {
         ErrorCode::Success
     }
 
+    extern "C" fn _mock_add_records_handler(storage_handle: i32,
+                                            records_json: *const c_char) -> ErrorCode {
+        assert_ne!(records_json, ptr::null());
+
+        DEBUG_VEC.write().unwrap().push(
+            Call::AddRecordsHandler(
+                storage_handle,
+                serde_json::from_str(&_convert_c_string(records_json).unwrap()).unwrap(),
+            )
+        );
+
+        ErrorCode::Success
+    }
+
+    extern "C" fn _mock_delete_records_handler(storage_handle: i32,
+                                               type_: *const c_char,
+                                               query_json: *const c_char,
+                                               deleted_count_p: *mut usize) -> ErrorCode {
+        DEBUG_VEC.write().unwrap().push(
+            Call::DeleteRecordsHandler(
+                storage_handle,
+                _convert_c_string(type_),
+                _convert_c_string(query_json),
+            )
+        );
+
+        unsafe { *deleted_count_p = RETURN_SEARCH_TOTAL_COUNT; }
+
+        ErrorCode::Success
+    }
+
     extern "C" fn _mock_update_record_value_handler(storage_handle: i32,
                                                     type_: *const c_char,
                                                     id: *const c_char,
@@ -1527,6 +1655,100 @@ mod tests {
         assert_eq!(&expected_call, debug.get(0).unwrap());
     }
 
+    #[test]
+    fn plugged_storage_add_records_works() {
+        DEBUG_VEC.write().unwrap().clear();
+
+        let storage_type = _create_storage_type();
+        storage_type.set_add_records_handler(_mock_add_records_handler).unwrap();
+        let storage = storage_type.open_storage("wallet1", None, Some("credentials")).unwrap();
+
+        DEBUG_VEC.write().unwrap().clear();
+
+        let type_ = _random_vector(32);
+        let id = _random_vector(32);
+        let value = EncryptedValue { data: _random_vector(256), key: _random_vector(60) };
+        let tags = vec![Tag::Encrypted(_random_vector(32), _random_vector(64)), Tag::PlainText(_random_vector(32), _random_string(64))];
+
+        let records = vec![StorageRecord::new(id.clone(), Some(value.clone()), Some(type_.clone()), Some(tags.clone()))];
+        storage.add_records(&records).unwrap();
+
+        let expected_call = Call::AddRecordsHandler(
+            RETURN_STORAGE_HANDLE,
+            json!([{
+                "type": base64::encode(&type_),
+                "id": base64::encode(&id),
+                "value": base64::encode(&value.to_bytes()),
+                "tags": serde_json::from_str::<serde_json::Value>(&_tags_to_json(&tags).unwrap()).unwrap(),
+            }]),
+        );
+
+        let debug = DEBUG_VEC.read().unwrap();
+
+        assert_eq!(debug.len(), 1);
+        assert_eq!(&expected_call, debug.get(0).unwrap());
+    }
+
+    #[test]
+    fn plugged_storage_add_records_works_without_handler() {
+        DEBUG_VEC.write().unwrap().clear();
+
+        let storage = _open_storage();
+
+        DEBUG_VEC.write().unwrap().clear();
+
+        let type_ = _random_vector(32);
+        let id = _random_vector(32);
+        let value = EncryptedValue { data: _random_vector(256), key: _random_vector(60) };
+
+        let records = vec![StorageRecord::new(id.clone(), Some(value.clone()), Some(type_.clone()), None)];
+        storage.add_records(&records).unwrap();
+
+        let expected_call = Call::AddRecordHandler(
+            RETURN_STORAGE_HANDLE,
+            Some(base64::encode(&type_)),
+            Some(base64::encode(&id)),
+            value.to_bytes(),
+            HashMap::new(),
+        );
+
+        let debug = DEBUG_VEC.read().unwrap();
+
+        assert_eq!(debug.len(), 1);
+        assert_eq!(&expected_call, debug.get(0).unwrap());
+    }
+
+    #[test]
+    fn plugged_storage_delete_records_works() {
+        DEBUG_VEC.write().unwrap().clear();
+
+        let storage_type = _create_storage_type();
+        storage_type.set_delete_records_handler(_mock_delete_records_handler).unwrap();
+        let storage = storage_type.open_storage("wallet1", None, Some("credentials")).unwrap();
+
+        DEBUG_VEC.write().unwrap().clear();
+
+        let type_ = _random_vector(32);
+        let query = language::Operator::Eq(
+            language::TagName::EncryptedTagName(_random_vector(32)),
+            language::TargetValue::Encrypted(_random_vector(32)),
+        );
+
+        let deleted_count = storage.delete_records(&type_, &query).unwrap();
+        assert_eq!(RETURN_SEARCH_TOTAL_COUNT, deleted_count);
+
+        let expected_call = Call::DeleteRecordsHandler(
+            RETURN_STORAGE_HANDLE,
+            Some(base64::encode(&type_)),
+            Some(query.to_string()),
+        );
+
+        let debug = DEBUG_VEC.read().unwrap();
+
+        assert_eq!(debug.len(), 1);
+        assert_eq!(&expected_call, debug.get(0).unwrap());
+    }
+
     #[test]
     fn plugged_storage_update_record_value_works() {
         DEBUG_VEC.write().unwrap().clear();
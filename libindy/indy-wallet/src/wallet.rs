@@ -4,12 +4,13 @@ use std::rc::Rc;
 use indy_utils::crypto::{hmacsha256, chacha20poly1305_ietf};
 use indy_utils::wql::Query;
 
+use indy_api_types::domain::wallet::{Record, RecordFormat};
 use indy_api_types::errors::prelude::*;
 
 use zeroize::Zeroize;
 
 use super::storage;
-use super::iterator::WalletIterator;
+use super::iterator::{WalletChangeIterator, WalletIterator};
 use super::encryption::*;
 use super::query_encryption::encrypt_query;
 use super::WalletRecord;
@@ -23,10 +24,17 @@ pub(super) struct Keys {
     pub tag_name_key: chacha20poly1305_ietf::Key,
     pub tag_value_key: chacha20poly1305_ietf::Key,
     pub tags_hmac_key: hmacsha256::Key,
+    // Missing in keys of wallets created before record formats were introduced
+    #[serde(default)]
+    pub record_format: RecordFormat,
 }
 
 impl Keys {
     pub fn new() -> Keys {
+        Keys::with_record_format(RecordFormat::default())
+    }
+
+    pub fn with_record_format(record_format: RecordFormat) -> Keys {
         Keys {
             type_key: chacha20poly1305_ietf::gen_key(),
             name_key: chacha20poly1305_ietf::gen_key(),
@@ -35,9 +43,32 @@ impl Keys {
             tag_name_key: chacha20poly1305_ietf::gen_key(),
             tag_value_key: chacha20poly1305_ietf::gen_key(),
             tags_hmac_key: hmacsha256::gen_key(),
+            record_format,
+        }
+    }
+
+    pub fn encrypt_value(&self, ename: &[u8], value: &str) -> EncryptedValue {
+        match self.record_format {
+            RecordFormat::KEY_WRAPPED => EncryptedValue::encrypt(value, &self.value_key),
+            RecordFormat::SINGLE_AEAD => EncryptedValue::encrypt_single(value, &self._item_value_key(ename)),
         }
     }
 
+    pub fn decrypt_value(&self, ename: &[u8], value: &EncryptedValue) -> IndyResult<String> {
+        match self.record_format {
+            RecordFormat::KEY_WRAPPED => value.decrypt(&self.value_key),
+            RecordFormat::SINGLE_AEAD => value.decrypt_single(&self._item_value_key(ename)),
+        }
+    }
+
+    // Single AEAD records: value_key is only used to derive the key of every item from its encrypted name,
+    // values themselves are encrypted with random nonce under the item key.
+    fn _item_value_key(&self, ename: &[u8]) -> chacha20poly1305_ietf::Key {
+        let hmac_key = hmacsha256::Key::from_slice(&self.value_key[..]).unwrap(); // We can safely unwrap here, keys have the same size
+        let tag = hmacsha256::authenticate(ename, &hmac_key);
+        chacha20poly1305_ietf::Key::from_slice(&tag[..]).unwrap() // We can safely unwrap here, tag has the key size
+    }
+
     pub fn serialize_encrypted(&self, master_key: &chacha20poly1305_ietf::Key) -> IndyResult<Vec<u8>> {
         let mut serialized = rmp_serde::to_vec(self)
             .to_indy(IndyErrorKind::InvalidState, "Unable to serialize keys")?;
@@ -80,7 +111,18 @@ impl EncryptedValue {
         )
     }
 
+    pub fn encrypt_single(data: &str, item_key: &chacha20poly1305_ietf::Key) -> Self {
+        EncryptedValue::new(
+            encrypt_as_not_searchable(data.as_bytes(), item_key),
+            Vec::new(),
+        )
+    }
+
     pub fn decrypt(&self, key: &chacha20poly1305_ietf::Key) -> IndyResult<String> {
+        if self.key.len() != ENCRYPTED_KEY_LEN {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Unable to split value_key from value: value too short")); // FIXME: review kind
+        }
+
         let mut value_key_bytes = decrypt_merged(&self.key, key)?;
 
         let value_key = chacha20poly1305_ietf::Key::from_slice(&value_key_bytes)
@@ -94,6 +136,20 @@ impl EncryptedValue {
         Ok(res)
     }
 
+    pub fn decrypt_single(&self, item_key: &chacha20poly1305_ietf::Key) -> IndyResult<String> {
+        // Plugged storages pass value as joined bytes, so it may be split at value key length
+        let joined_data = if self.key.is_empty() { self.data.clone() } else { self.to_bytes() };
+
+        if joined_data.len() < chacha20poly1305_ietf::NONCEBYTES + chacha20poly1305_ietf::TAGBYTES {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Value is too short"));
+        }
+
+        let res = String::from_utf8(decrypt_merged(&joined_data, item_key)?)
+            .to_indy(IndyErrorKind::InvalidState, "Invalid UTF8 string inside of value")?;
+
+        Ok(res)
+    }
+
     pub fn to_bytes(&self) -> Vec<u8> {
         let mut result = self.key.clone();
         result.extend_from_slice(self.data.as_slice());
@@ -102,8 +158,9 @@ impl EncryptedValue {
 
     pub fn from_bytes(joined_data: &[u8]) -> IndyResult<Self> {
         // value_key is stored as NONCE || CYPHERTEXT. Lenth of CYPHERTHEXT is length of DATA + length of TAG.
+        // Single AEAD values have no value_key and can be shorter, decrypt checks the length
         if joined_data.len() < ENCRYPTED_KEY_LEN {
-            return Err(err_msg(IndyErrorKind::InvalidStructure, "Unable to split value_key from value: value too short")); // FIXME: review kind
+            return Ok(EncryptedValue { data: joined_data.to_owned(), key: Vec::new() });
         }
 
         let value_key = joined_data[..ENCRYPTED_KEY_LEN].to_owned();
@@ -126,12 +183,30 @@ impl Wallet {
     pub fn add(&self, type_: &str, name: &str, value: &str, tags: &HashMap<String, String>) -> IndyResult<()> {
         let etype = encrypt_as_searchable(type_.as_bytes(), &self.keys.type_key, &self.keys.item_hmac_key);
         let ename = encrypt_as_searchable(name.as_bytes(), &self.keys.name_key, &self.keys.item_hmac_key);
-        let evalue = EncryptedValue::encrypt(value, &self.keys.value_key);
+        let evalue = self.keys.encrypt_value(&ename, value);
         let etags = encrypt_tags(tags, &self.keys.tag_name_key, &self.keys.tag_value_key, &self.keys.tags_hmac_key);
         self.storage.add(&etype, &ename, &evalue, &etags)?;
         Ok(())
     }
 
+    pub fn add_records(&self, records: &[Record]) -> IndyResult<()> {
+        let records = records
+            .iter()
+            .map(|record| {
+                let ename = encrypt_as_searchable(record.id.as_bytes(), &self.keys.name_key, &self.keys.item_hmac_key);
+                storage::StorageRecord {
+                    value: Some(self.keys.encrypt_value(&ename, &record.value)),
+                    id: ename,
+                    type_: Some(encrypt_as_searchable(record.type_.as_bytes(), &self.keys.type_key, &self.keys.item_hmac_key)),
+                    tags: Some(encrypt_tags(&record.tags, &self.keys.tag_name_key, &self.keys.tag_value_key, &self.keys.tags_hmac_key)),
+                }
+            })
+            .collect::<Vec<storage::StorageRecord>>();
+
+        self.storage.add_records(&records)?;
+        Ok(())
+    }
+
     pub fn add_tags(&self, type_: &str, name: &str, tags: &HashMap<String, String>) -> IndyResult<()> {
         let encrypted_type = encrypt_as_searchable(type_.as_bytes(), &self.keys.type_key, &self.keys.item_hmac_key);
         let encrypted_name = encrypt_as_searchable(name.as_bytes(), &self.keys.name_key, &self.keys.item_hmac_key);
@@ -159,7 +234,7 @@ impl Wallet {
     pub fn update(&self, type_: &str, name: &str, new_value: &str) -> IndyResult<()> {
         let encrypted_type = encrypt_as_searchable(type_.as_bytes(), &self.keys.type_key, &self.keys.item_hmac_key);
         let encrypted_name = encrypt_as_searchable(name.as_bytes(), &self.keys.name_key, &self.keys.item_hmac_key);
-        let encrypted_value = EncryptedValue::encrypt(new_value, &self.keys.value_key);
+        let encrypted_value = self.keys.encrypt_value(&encrypted_name, new_value);
         self.storage.update(&encrypted_type, &encrypted_name, &encrypted_value)?;
         Ok(())
     }
@@ -172,7 +247,7 @@ impl Wallet {
 
         let value = match result.value {
             None => None,
-            Some(encrypted_value) => Some(encrypted_value.decrypt(&self.keys.value_key)?)
+            Some(encrypted_value) => Some(self.keys.decrypt_value(&ename, &encrypted_value)?)
         };
 
         let tags = decrypt_tags(&result.tags, &self.keys.tag_name_key, &self.keys.tag_value_key)?;
@@ -201,6 +276,18 @@ impl Wallet {
         Ok(wallet_iterator)
     }
 
+    pub fn delete_records(&self, type_: &str, query: &str) -> IndyResult<usize> {
+        let parsed_query: Query = ::serde_json::from_str::<Query>(query)
+            .map_err(|err| IndyError::from_msg(IndyErrorKind::WalletQueryError, err))?
+            .optimise()
+            .unwrap_or_default();
+
+        let encrypted_query = encrypt_query(parsed_query, &self.keys)?;
+        let encrypted_type_ = encrypt_as_searchable(type_.as_bytes(), &self.keys.type_key, &self.keys.item_hmac_key);
+        let deleted_count = self.storage.delete_records(&encrypted_type_, &encrypted_query)?;
+        Ok(deleted_count)
+    }
+
     pub fn close(&mut self) -> IndyResult<()> {
         self.storage.close()
             .map_err(IndyError::from)
@@ -211,6 +298,29 @@ impl Wallet {
         Ok(WalletIterator::new(all_items, Rc::clone(&self.keys)))
     }
 
+    /// Sequence number of the latest change or None if the storage doesn't track changes.
+    pub fn get_change_seq(&self) -> IndyResult<Option<u64>> {
+        self.storage.get_change_seq()
+    }
+
+    pub fn get_changes(&self, since: u64, until: u64) -> IndyResult<WalletChangeIterator> {
+        let changes = self.storage.get_changes(since, until)?;
+        Ok(WalletChangeIterator::new(changes, Rc::clone(&self.keys)))
+    }
+
+    pub fn prune_changes(&self, until: u64) -> IndyResult<()> {
+        self.storage.prune_changes(until)
+    }
+
+    /// Runs one compaction step or returns None if the storage can't be compacted.
+    pub fn compact(&self, max_pages: usize) -> IndyResult<Option<storage::CompactionProgress>> {
+        self.storage.compact(max_pages)
+    }
+
+    pub fn get_storage_size(&self) -> IndyResult<Option<storage::StorageSize>> {
+        self.storage.get_storage_size()
+    }
+
     pub fn get_id<'a>(&'a self) -> &'a str {
         &self.id
     }
@@ -350,6 +460,38 @@ mod tests {
         test::cleanup_wallet("wallet_update_works");
     }
 
+    #[test]
+    fn keys_encrypt_decrypt_value_works_for_single_aead_format() {
+        let keys = Keys::with_record_format(RecordFormat::SINGLE_AEAD);
+
+        let evalue = keys.encrypt_value(b"name", "value");
+        assert!(evalue.key.is_empty());
+        assert_eq!(evalue.data.len(), chacha20poly1305_ietf::NONCEBYTES + "value".len() + chacha20poly1305_ietf::TAGBYTES);
+
+        assert_eq!("value", keys.decrypt_value(b"name", &evalue).unwrap());
+        assert_eq!("value", keys.decrypt_value(b"name", &EncryptedValue::from_bytes(&evalue.to_bytes()).unwrap()).unwrap());
+    }
+
+    #[test]
+    fn keys_decrypt_value_works_for_single_aead_format_and_other_name() {
+        let keys = Keys::with_record_format(RecordFormat::SINGLE_AEAD);
+
+        let evalue = keys.encrypt_value(b"name", "value");
+
+        let res = keys.decrypt_value(b"other_name", &evalue);
+        assert_kind!(IndyErrorKind::InvalidStructure, res);
+    }
+
+    #[test]
+    fn keys_decrypt_value_works_for_key_wrapped_format_and_short_value() {
+        let keys = Keys::new();
+
+        let evalue = EncryptedValue::from_bytes(&[1, 2, 3]).unwrap();
+
+        let res = keys.decrypt_value(b"name", &evalue);
+        assert_kind!(IndyErrorKind::InvalidStructure, res);
+    }
+
     #[test]
     fn wallet_update_works_for_non_existing_id() {
         test::cleanup_wallet("wallet_update_works_for_non_existing_id");
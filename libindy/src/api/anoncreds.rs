@@ -7,7 +7,7 @@ use crate::commands::anoncreds::prover::ProverCommand;
 use crate::commands::anoncreds::verifier::VerifierCommand;
 use crate::domain::anoncreds::schema::{Schema, AttributeNames, Schemas};
 use crate::domain::crypto::did::DidValue;
-use crate::domain::anoncreds::credential_definition::{CredentialDefinition, CredentialDefinitionConfig, CredentialDefinitionId, CredentialDefinitions};
+use crate::domain::anoncreds::credential_definition::{CredentialDefinition, CredentialDefinitionConfig, CredentialDefinitionId, CredentialDefinitionKeyPoolConfig, CredentialDefinitions};
 use crate::domain::anoncreds::credential_offer::CredentialOffer;
 use crate::domain::anoncreds::credential_request::{CredentialRequest, CredentialRequestMetadata};
 use crate::domain::anoncreds::credential_attr_tag_policy::CredentialAttrTagPolicy;
@@ -220,6 +220,70 @@ pub extern fn indy_issuer_create_and_store_credential_def(command_handle: Comman
     res
 }
 
+/// Pre-generate credential definition keys for the given schema and keep them in the wallet.
+///
+/// Generating credential definition keys is expensive (safe primes search), so an issuer that creates
+/// credential definitions on demand can fill the key pool in advance.
+/// `indy_issuer_create_and_store_credential_def` takes keys from the pool when there are keys
+/// generated for the same set of schema attributes and the same `support_revocation` flag.
+/// Every key is removed from the pool before use, so it backs only one credential definition.
+/// Each time a key is taken the pool is refilled in the background up to the configured size.
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+/// wallet_handle: wallet handle (created by open_wallet).
+/// schema_json: credential schema as a json
+/// config_json: key pool configuration as json:
+///     {
+///         "support_revocation" - bool (optional, default false) whether keys support revocation
+///         "size" - u32 number of keys to keep in the pool
+///     }
+/// cb: Callback that takes command result as parameter.
+///     Called when the pool contains the requested number of keys.
+///
+/// #Returns
+///
+/// #Errors
+/// Common*
+/// Wallet*
+/// Anoncreds*
+#[no_mangle]
+pub extern fn indy_issuer_fill_credential_def_key_pool(command_handle: CommandHandle,
+                                                       wallet_handle: WalletHandle,
+                                                       schema_json: *const c_char,
+                                                       config_json: *const c_char,
+                                                       cb: Option<extern fn(command_handle_: CommandHandle, err: ErrorCode)>) -> ErrorCode {
+    trace!("indy_issuer_fill_credential_def_key_pool: >>> wallet_handle: {:?}, schema_json: {:?}, config_json: {:?}",
+           wallet_handle, schema_json, config_json);
+
+    check_useful_validatable_json!(schema_json, ErrorCode::CommonInvalidParam3, Schema);
+    check_useful_validatable_json!(config_json, ErrorCode::CommonInvalidParam4, CredentialDefinitionKeyPoolConfig);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam5);
+
+    trace!("indy_issuer_fill_credential_def_key_pool: entities >>> wallet_handle: {:?}, schema_json: {:?}, config_json: {:?}",
+           wallet_handle, schema_json, config_json);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Anoncreds(
+            AnoncredsCommand::Issuer(
+                IssuerCommand::FillCredentialDefinitionKeyPool(
+                    wallet_handle,
+                    schema_json,
+                    config_json,
+                    Box::new(move |result| {
+                        let err = prepare_result!(result);
+                        trace!("indy_issuer_fill_credential_def_key_pool:");
+                        cb(command_handle, err)
+                    })
+                ))));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_issuer_fill_credential_def_key_pool: <<< res: {:?}", res);
+
+    res
+}
+
 /// Generate temporary credential definitional keys for an existing one (owned by the caller of the library).
 ///
 /// Use `indy_issuer_rotate_credential_def_apply` function to set generated temporary keys as the main.
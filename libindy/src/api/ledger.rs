@@ -1,4 +1,4 @@
-use indy_api_types::{CommandHandle, ErrorCode, PoolHandle, WalletHandle};
+use indy_api_types::{CommandHandle, ErrorCode, PoolHandle, RequestHandle, SearchHandle, WalletHandle, INVALID_REQUEST_HANDLE, INVALID_SEARCH_HANDLE};
 use indy_api_types::errors::prelude::*;
 use indy_api_types::validation::Validatable;
 use indy_utils::ctypes;
@@ -995,7 +995,8 @@ pub extern fn indy_build_get_validator_info_request(command_handle: CommandHandl
 /// ledger_type: (Optional) type of the ledger the requested transaction belongs to:
 ///     DOMAIN - used default,
 ///     POOL,
-///     CONFIG
+///     CONFIG,
+///     AUDIT
 ///     any number
 /// seq_no: requested transaction sequence number as it's stored on Ledger.
 /// cb: Callback that takes command result as parameter.
@@ -2502,4 +2503,574 @@ pub extern fn indy_append_request_endorser(command_handle: CommandHandle,
     trace!("indy_append_request_endorser: <<< res: {:?}", res);
 
     res
-}
\ No newline at end of file
+}
+
+/// Builds a NYM request and keeps it in libindy as an opaque request handle.
+///
+/// Request handles allow to build, sign, multi-sign and submit a request without passing request json
+/// through the FFI and parsing it again on every step. Use `indy_request_handle_to_json` if json
+/// representation is needed and `indy_release_request_handle` to free the request.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// submitter_did, target_did, verkey, alias, role: the same as for `indy_build_nym_request`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request handle.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_build_nym_request_handle(command_handle: CommandHandle,
+                                            submitter_did: *const c_char,
+                                            target_did: *const c_char,
+                                            verkey: *const c_char,
+                                            alias: *const c_char,
+                                            role: *const c_char,
+                                            cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                 err: ErrorCode,
+                                                                 request_handle: RequestHandle)>) -> ErrorCode {
+    trace!("indy_build_nym_request_handle: >>> submitter_did: {:?}, target_did: {:?}, verkey: {:?}, alias: {:?}, role: {:?}",
+           submitter_did, target_did, verkey, alias, role);
+
+    check_useful_validatable_string!(submitter_did, ErrorCode::CommonInvalidParam2, DidValue);
+    check_useful_validatable_string!(target_did, ErrorCode::CommonInvalidParam3, DidValue);
+    check_useful_opt_c_str!(verkey, ErrorCode::CommonInvalidParam4);
+    check_useful_opt_c_str!(alias, ErrorCode::CommonInvalidParam5);
+    check_useful_opt_c_str!(role, ErrorCode::CommonInvalidParam6);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam7);
+
+    trace!("indy_build_nym_request_handle: entities >>> submitter_did: {:?}, target_did: {:?}, verkey: {:?}, alias: {:?}, role: {:?}",
+           submitter_did, target_did, verkey, alias, role);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::BuildNymRequestHandle(
+            submitter_did,
+            target_did,
+            verkey,
+            alias,
+            role,
+            Box::new(move |result| {
+                let (err, request_handle) = prepare_result_1!(result, INVALID_REQUEST_HANDLE);
+                trace!("indy_build_nym_request_handle: request_handle: {:?}", request_handle);
+                cb(command_handle, err, request_handle)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_build_nym_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Builds an ATTRIB request and keeps it in libindy as an opaque request handle.
+///
+/// Note: one of the fields `hash`, `raw`, `enc` must be specified.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// submitter_did, target_did, hash, raw, enc: the same as for `indy_build_attrib_request`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request handle.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_build_attrib_request_handle(command_handle: CommandHandle,
+                                               submitter_did: *const c_char,
+                                               target_did: *const c_char,
+                                               hash: *const c_char,
+                                               raw: *const c_char,
+                                               enc: *const c_char,
+                                               cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                    err: ErrorCode,
+                                                                    request_handle: RequestHandle)>) -> ErrorCode {
+    trace!("indy_build_attrib_request_handle: >>> submitter_did: {:?}, target_did: {:?}, hash: {:?}, raw: {:?}, enc: {:?}",
+           submitter_did, target_did, hash, raw, enc);
+
+    check_useful_validatable_string!(submitter_did, ErrorCode::CommonInvalidParam2, DidValue);
+    check_useful_validatable_string!(target_did, ErrorCode::CommonInvalidParam3, DidValue);
+    check_useful_opt_c_str!(hash, ErrorCode::CommonInvalidParam4);
+    check_useful_opt_json!(raw, ErrorCode::CommonInvalidParam5, serde_json::Value);
+    check_useful_opt_c_str!(enc, ErrorCode::CommonInvalidParam6);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam7);
+
+    trace!("indy_build_attrib_request_handle: entities >>> submitter_did: {:?}, target_did: {:?}, hash: {:?}, raw: {:?}, enc: {:?}",
+           submitter_did, target_did, hash, raw, enc);
+
+    if raw.is_none() && hash.is_none() && enc.is_none() {
+        return IndyError::from_msg(IndyErrorKind::InvalidStructure, "Either raw or hash or enc must be specified").into();
+    }
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::BuildAttribRequestHandle(
+            submitter_did,
+            target_did,
+            hash,
+            raw,
+            enc,
+            Box::new(move |result| {
+                let (err, request_handle) = prepare_result_1!(result, INVALID_REQUEST_HANDLE);
+                trace!("indy_build_attrib_request_handle: request_handle: {:?}", request_handle);
+                cb(command_handle, err, request_handle)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_build_attrib_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Parses request json once and keeps it in libindy as an opaque request handle.
+///
+/// Allows to use request handles with requests built by any of `indy_build_*_request` functions.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// request_json: Request data json.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request handle.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_request_handle_from_json(command_handle: CommandHandle,
+                                            request_json: *const c_char,
+                                            cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                 err: ErrorCode,
+                                                                 request_handle: RequestHandle)>) -> ErrorCode {
+    trace!("indy_request_handle_from_json: >>> request_json: {:?}", request_json);
+
+    check_useful_c_str!(request_json, ErrorCode::CommonInvalidParam2);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam3);
+
+    trace!("indy_request_handle_from_json: entities >>> request_json: {:?}", request_json);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::RequestHandleFromJson(
+            request_json,
+            Box::new(move |result| {
+                let (err, request_handle) = prepare_result_1!(result, INVALID_REQUEST_HANDLE);
+                trace!("indy_request_handle_from_json: request_handle: {:?}", request_handle);
+                cb(command_handle, err, request_handle)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_request_handle_from_json: <<< res: {:?}", res);
+
+    res
+}
+
+/// Returns json representation of the request kept by request handle.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request json.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_request_handle_to_json(command_handle: CommandHandle,
+                                          request_handle: RequestHandle,
+                                          cb: Option<extern fn(command_handle_: CommandHandle,
+                                                               err: ErrorCode,
+                                                               request_json: *const c_char)>) -> ErrorCode {
+    trace!("indy_request_handle_to_json: >>> request_handle: {:?}", request_handle);
+
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam3);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::RequestHandleToJson(
+            request_handle,
+            boxed_callback_string!("indy_request_handle_to_json", cb, command_handle)
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_request_handle_to_json: <<< res: {:?}", res);
+
+    res
+}
+
+/// Signs the request kept by request handle in place (see `indy_sign_request`).
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// wallet_handle: wallet handle (created by open_wallet).
+/// submitter_did: Id of Identity stored in secured Wallet.
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Errors
+/// Common*
+/// Wallet*
+/// Ledger*
+/// Crypto*
+#[no_mangle]
+pub extern fn indy_sign_request_handle(command_handle: CommandHandle,
+                                       wallet_handle: WalletHandle,
+                                       submitter_did: *const c_char,
+                                       request_handle: RequestHandle,
+                                       cb: Option<extern fn(command_handle_: CommandHandle,
+                                                            err: ErrorCode)>) -> ErrorCode {
+    trace!("indy_sign_request_handle: >>> wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}", wallet_handle, submitter_did, request_handle);
+
+    check_useful_validatable_string!(submitter_did, ErrorCode::CommonInvalidParam3, DidValue);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam5);
+
+    trace!("indy_sign_request_handle: entities >>> wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}", wallet_handle, submitter_did, request_handle);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::SignRequestHandle(
+            wallet_handle,
+            submitter_did,
+            request_handle,
+            Box::new(move |result| {
+                let err = prepare_result!(result);
+                trace!("indy_sign_request_handle:");
+                cb(command_handle, err)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_sign_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Multi signs the request kept by request handle in place (see `indy_multi_sign_request`).
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// wallet_handle: wallet handle (created by open_wallet).
+/// submitter_did: Id of Identity stored in secured Wallet.
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Errors
+/// Common*
+/// Wallet*
+/// Ledger*
+/// Crypto*
+#[no_mangle]
+pub extern fn indy_multi_sign_request_handle(command_handle: CommandHandle,
+                                             wallet_handle: WalletHandle,
+                                             submitter_did: *const c_char,
+                                             request_handle: RequestHandle,
+                                             cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                  err: ErrorCode)>) -> ErrorCode {
+    trace!("indy_multi_sign_request_handle: >>> wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}", wallet_handle, submitter_did, request_handle);
+
+    check_useful_validatable_string!(submitter_did, ErrorCode::CommonInvalidParam3, DidValue);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam5);
+
+    trace!("indy_multi_sign_request_handle: entities >>> wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}", wallet_handle, submitter_did, request_handle);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::MultiSignRequestHandle(
+            wallet_handle,
+            submitter_did,
+            request_handle,
+            Box::new(move |result| {
+                let err = prepare_result!(result);
+                trace!("indy_multi_sign_request_handle:");
+                cb(command_handle, err)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_multi_sign_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Publishes the request kept by request handle to validator pool (see `indy_submit_request`).
+///
+/// The request is serialized only once, right before it is sent. Request handle stays valid
+/// after submitting, release it with `indy_release_request_handle`.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// pool_handle: pool handle (created by open_pool_ledger).
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request result as json.
+///
+/// #Errors
+/// Common*
+/// Ledger*
+#[no_mangle]
+pub extern fn indy_submit_request_handle(command_handle: CommandHandle,
+                                         pool_handle: PoolHandle,
+                                         request_handle: RequestHandle,
+                                         cb: Option<extern fn(command_handle_: CommandHandle,
+                                                              err: ErrorCode,
+                                                              request_result_json: *const c_char)>) -> ErrorCode {
+    trace!("indy_submit_request_handle: >>> pool_handle: {:?}, request_handle: {:?}", pool_handle, request_handle);
+
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam4);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::SubmitRequestHandle(
+            pool_handle,
+            request_handle,
+            boxed_callback_string!("indy_submit_request_handle", cb, command_handle)
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_submit_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Signs the request kept by request handle and submits it to validator pool
+/// (see `indy_sign_and_submit_request`).
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// pool_handle: pool handle (created by open_pool_ledger).
+/// wallet_handle: wallet handle (created by open_wallet).
+/// submitter_did: Id of Identity stored in secured Wallet.
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Request result as json.
+///
+/// #Errors
+/// Common*
+/// Wallet*
+/// Ledger*
+/// Crypto*
+#[no_mangle]
+pub extern fn indy_sign_and_submit_request_handle(command_handle: CommandHandle,
+                                                  pool_handle: PoolHandle,
+                                                  wallet_handle: WalletHandle,
+                                                  submitter_did: *const c_char,
+                                                  request_handle: RequestHandle,
+                                                  cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                       err: ErrorCode,
+                                                                       request_result_json: *const c_char)>) -> ErrorCode {
+    trace!("indy_sign_and_submit_request_handle: >>> pool_handle: {:?}, wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}",
+           pool_handle, wallet_handle, submitter_did, request_handle);
+
+    check_useful_validatable_string!(submitter_did, ErrorCode::CommonInvalidParam4, DidValue);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam6);
+
+    trace!("indy_sign_and_submit_request_handle: entities >>> pool_handle: {:?}, wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}",
+           pool_handle, wallet_handle, submitter_did, request_handle);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::SignAndSubmitRequestHandle(
+            pool_handle,
+            wallet_handle,
+            submitter_did,
+            request_handle,
+            boxed_callback_string!("indy_sign_and_submit_request_handle", cb, command_handle)
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_sign_and_submit_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Releases the request kept by request handle.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// request_handle: request handle returned by `indy_build_*_request_handle` or `indy_request_handle_from_json`.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_release_request_handle(command_handle: CommandHandle,
+                                          request_handle: RequestHandle,
+                                          cb: Option<extern fn(command_handle_: CommandHandle,
+                                                               err: ErrorCode)>) -> ErrorCode {
+    trace!("indy_release_request_handle: >>> request_handle: {:?}", request_handle);
+
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam3);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::ReleaseRequestHandle(
+            request_handle,
+            Box::new(move |result| {
+                let err = prepare_result!(result);
+                trace!("indy_release_request_handle:");
+                cb(command_handle, err)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_release_request_handle: <<< res: {:?}", res);
+
+    res
+}
+
+/// Opens a range of transactions of the ledger to fetch it by pages (with indy_fetch_ledger_txns_range).
+///
+/// Size and root hash of the ledger are taken from the consistency proof returned by f+1 nodes.
+/// Every fetched page is verified by consistency proof against this root hash,
+/// so the transactions are the same as f+1 nodes store.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// pool_handle: pool handle (created by open_pool_ledger).
+/// ledger_type: (Optional) type of the ledger the requested transactions belong to:
+///     DOMAIN - used default,
+///     POOL,
+///     CONFIG,
+///     AUDIT
+///     any number
+/// from: sequence number of the first transaction of the range (starts from 1).
+/// to: sequence number of the last transaction of the range.
+///     The range is truncated to the current size of the ledger.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// txns_range_handle: Handle of the range that can be used later
+///   to fetch transactions by pages (with indy_fetch_ledger_txns_range)
+///
+/// #Errors
+/// Common*
+/// Ledger*
+/// Pool*
+#[no_mangle]
+pub extern fn indy_open_ledger_txns_range(command_handle: CommandHandle,
+                                          pool_handle: PoolHandle,
+                                          ledger_type: *const c_char,
+                                          from: i32,
+                                          to: i32,
+                                          cb: Option<extern fn(command_handle_: CommandHandle,
+                                                               err: ErrorCode,
+                                                               txns_range_handle: SearchHandle)>) -> ErrorCode {
+    trace!("indy_open_ledger_txns_range: >>> pool_handle: {:?}, ledger_type: {:?}, from: {:?}, to: {:?}", pool_handle, ledger_type, from, to);
+
+    check_useful_opt_c_str!(ledger_type, ErrorCode::CommonInvalidParam3);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam6);
+
+    trace!("indy_open_ledger_txns_range: entities >>> pool_handle: {:?}, ledger_type: {:?}, from: {:?}, to: {:?}", pool_handle, ledger_type, from, to);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::OpenLedgerTxnsRange(
+            pool_handle,
+            ledger_type,
+            from,
+            to,
+            Box::new(move |result| {
+                let (err, txns_range_handle) = prepare_result_1!(result, INVALID_SEARCH_HANDLE);
+                trace!("indy_open_ledger_txns_range: txns_range_handle: {:?}", txns_range_handle);
+                cb(command_handle, err, txns_range_handle)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_open_ledger_txns_range: <<< res: {:?}", res);
+
+    res
+}
+
+/// Fetches next page of transactions of the range opened by indy_open_ledger_txns_range.
+///
+/// Page can contain less transactions than requested if nodes limit the size of the reply.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// txns_range_handle: ledger transactions range handle (created by indy_open_ledger_txns_range).
+/// count: maximal count of transactions to fetch.
+/// cb: Callback that takes command result as parameter.
+///
+/// #Returns
+/// Transactions json ordered by sequence number:
+/// [<ledger transaction>, ...]
+/// Empty list means that all transactions of the range are fetched.
+///
+/// #Errors
+/// Common*
+/// Ledger*
+/// Pool*
+#[no_mangle]
+pub extern fn indy_fetch_ledger_txns_range(command_handle: CommandHandle,
+                                           txns_range_handle: SearchHandle,
+                                           count: usize,
+                                           cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                err: ErrorCode,
+                                                                txns_json: *const c_char)>) -> ErrorCode {
+    trace!("indy_fetch_ledger_txns_range: >>> txns_range_handle: {:?}, count: {:?}", txns_range_handle, count);
+
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam4);
+
+    trace!("indy_fetch_ledger_txns_range: entities >>> txns_range_handle: {:?}, count: {:?}", txns_range_handle, count);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::FetchLedgerTxnsRange(
+            txns_range_handle,
+            count,
+            boxed_callback_string!("indy_fetch_ledger_txns_range", cb, command_handle)
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_fetch_ledger_txns_range: <<< res: {:?}", res);
+
+    res
+}
+
+/// Closes ledger transactions range (make range handle invalid).
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context.
+/// txns_range_handle: ledger transactions range handle (created by indy_open_ledger_txns_range).
+/// cb: Callback that takes command result as parameter.
+///
+/// #Errors
+/// Common*
+#[no_mangle]
+pub extern fn indy_close_ledger_txns_range(command_handle: CommandHandle,
+                                           txns_range_handle: SearchHandle,
+                                           cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                err: ErrorCode)>) -> ErrorCode {
+    trace!("indy_close_ledger_txns_range: >>> txns_range_handle: {:?}", txns_range_handle);
+
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam3);
+
+    let result = CommandExecutor::instance()
+        .send(Command::Ledger(LedgerCommand::CloseLedgerTxnsRange(
+            txns_range_handle,
+            Box::new(move |result| {
+                let err = prepare_result!(result);
+                trace!("indy_close_ledger_txns_range:");
+                cb(command_handle, err)
+            })
+        )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_close_ledger_txns_range: <<< res: {:?}", res);
+
+    res
+}
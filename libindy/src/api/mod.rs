@@ -30,6 +30,20 @@ use indy_utils::ctypes;
 ///     "collect_backtrace": Optional<bool> - whether errors backtrace should be collected.
 ///         Capturing of backtrace can affect library performance.
 ///         NOTE: must be set before invocation of any other API functions.
+///     "key_pool_depth": Optional<int> - number of key pairs pre-generated in background for every opened wallet.
+///         Used by indy_create_key and indy_create_and_store_my_did without seed. (0 (disabled) by default)
+///     "box_key_cache_size": Optional<int> - number of converted Curve25519 keys and of precomputed shared keys cached for every wallet
+///         opened after this call. Used by indy_pack_message and indy_unpack_message. (0 (disabled) by default)
+///     "open_wallets_thread_pool_size": Optional<int> - size of thread pool used by indy_open_wallets for wallet key derivation.
+///         (number of CPU cores, but not more than 8, by default)
+///     "pool_io_threads_count": Optional<int> - number of I/O threads shared by pools opened after this call.
+///         Every thread multiplexes sockets and timeouts of many pools. (0 (dedicated thread for every pool) by default)
+///     "command_queue_size": Optional<int> - max number of API calls waiting for execution. Calls above the limit
+///         fail with CommonCommandQueueFull error. (0 (unlimited) by default)
+///     "command_queue_class_limits": Optional<object> - max number of waiting API calls per command class: {
+///         "<class>": int, ...
+///     } where class is one of anoncreds, blob_storage, crypto, ledger, pool, did, wallet, pairwise,
+///         non_secrets, payments, cache. (0 (unlimited) by default)
 /// }
 ///
 /// #Errors
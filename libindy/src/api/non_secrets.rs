@@ -310,6 +310,60 @@ pub extern fn indy_delete_wallet_record(command_handle: CommandHandle,
     res
 }
 
+/// Delete all wallet records of the type matching the query
+///
+/// Matching records are deleted by wallet storage at once (in one statement or transaction if storage supports it)
+/// instead of searching and deleting records one by one.
+///
+/// #Params
+/// command_handle: command handle to map callback to caller context
+/// wallet_handle: wallet handle (created by open_wallet)
+/// type_: allows to separate different record types collections
+/// query_json: MongoDB style query to wallet record tags (the same as query_json of indy_open_wallet_search):
+///  {
+///    "tagName": "tagValue",
+///    $or: {
+///      "tagName2": { $regex: 'pattern' },
+///      "tagName3": { $gte: '123' },
+///    },
+///  }
+/// #Returns
+/// deleted_count: the number of deleted records
+#[no_mangle]
+pub extern fn indy_delete_wallet_records(command_handle: CommandHandle,
+                                         wallet_handle: WalletHandle,
+                                         type_: *const c_char,
+                                         query_json: *const c_char,
+                                         cb: Option<extern fn(command_handle_: CommandHandle, err: ErrorCode,
+                                                              deleted_count: u32)>) -> ErrorCode {
+    trace!("indy_delete_wallet_records: >>> wallet_handle: {:?}, type_: {:?}, query_json: {:?}", wallet_handle, type_, query_json);
+
+    check_useful_c_str!(type_, ErrorCode::CommonInvalidParam3);
+    check_useful_c_str!(query_json, ErrorCode::CommonInvalidParam4);
+    check_useful_c_callback!(cb, ErrorCode::CommonInvalidParam5);
+
+    trace!("indy_delete_wallet_records: entities >>> wallet_handle: {:?}, type_: {:?}, query_json: {:?}", wallet_handle, type_, query_json);
+
+    let result = CommandExecutor::instance()
+        .send(Command::NonSecrets(
+            NonSecretsCommand::DeleteRecords(
+                wallet_handle,
+                type_,
+                query_json,
+                Box::new(move |result| {
+                    let (err, deleted_count) = prepare_result_1!(result, 0);
+                    trace!("indy_delete_wallet_records: deleted_count: {:?}", deleted_count);
+                    cb(command_handle, err, deleted_count as u32)
+                })
+            )));
+
+    let res = prepare_result!(result);
+
+    trace!("indy_delete_wallet_records: <<< res: {:?}", res);
+
+    res
+}
+
 /// Get an wallet record by id
 ///
 /// #Params
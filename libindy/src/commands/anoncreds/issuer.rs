@@ -21,7 +21,9 @@ use crate::domain::anoncreds::credential_definition::{
     CredentialDefinitionV1,
     SignatureType,
     TemporaryCredentialDefinition,
-    CredentialDefinitionId
+    CredentialDefinitionId,
+    CredentialDefinitionKeyPoolConfig,
+    CredentialDefinitionKeys,
 };
 use crate::domain::anoncreds::credential_offer::CredentialOffer;
 use crate::domain::anoncreds::credential_request::CredentialRequest;
@@ -49,11 +51,11 @@ use crate::domain::crypto::did::DidValue;
 use indy_api_types::domain::wallet::Tags;
 use indy_api_types::errors::prelude::*;
 use crate::services::anoncreds::AnoncredsService;
-use crate::services::anoncreds::helpers::parse_cred_rev_id;
+use crate::services::anoncreds::helpers::{attr_common_view, parse_cred_rev_id};
 use crate::services::blob_storage::BlobStorageService;
 use crate::services::crypto::CryptoService;
 use crate::services::pool::PoolService;
-use indy_wallet::{RecordOptions, WalletService};
+use indy_wallet::{RecordOptions, SearchOptions, WalletService};
 
 use super::tails::{SDKTailsAccessor, store_tails_from_generator};
 use indy_api_types::{WalletHandle, CommandHandle};
@@ -85,6 +87,18 @@ pub enum IssuerCommand {
                     CredentialPrivateKey,
                     CredentialKeyCorrectnessProof)>,
         CommandHandle),
+    FillCredentialDefinitionKeyPool(
+        WalletHandle,
+        Schema, // schema
+        CredentialDefinitionKeyPoolConfig, // config
+        Box<dyn Fn(IndyResult<()>) + Send>),
+    FillCredentialDefinitionKeyPoolContinue(
+        WalletHandle,
+        String, // key pool id
+        IndyResult<(CredentialDefinitionData,
+                    CredentialPrivateKey,
+                    CredentialKeyCorrectnessProof)>,
+        CommandHandle),
     RotateCredentialDefinitionStart(
         WalletHandle,
         CredentialDefinitionId, // cred def id
@@ -151,6 +165,8 @@ pub struct IssuerCommandExecutor {
     pub crypto_service: Rc<CryptoService>,
     pending_str_str_callbacks: RefCell<HashMap<CommandHandle, BoxedCallbackStringStringSend>>,
     pending_str_callbacks: RefCell<HashMap<CommandHandle, Box<dyn Fn(IndyResult<String>) + Send>>>,
+    pending_key_pool_callbacks: RefCell<HashMap<CommandHandle, (usize, IndyResult<()>, Box<dyn Fn(IndyResult<()>) + Send>)>>,
+    key_pool_in_progress: RefCell<HashMap<String, usize>>,
 }
 
 impl IssuerCommandExecutor {
@@ -167,6 +183,8 @@ impl IssuerCommandExecutor {
             crypto_service,
             pending_str_str_callbacks: RefCell::new(HashMap::new()),
             pending_str_callbacks: RefCell::new(HashMap::new()),
+            pending_key_pool_callbacks: RefCell::new(HashMap::new()),
+            key_pool_in_progress: RefCell::new(HashMap::new()),
         }
     }
 
@@ -185,6 +203,14 @@ impl IssuerCommandExecutor {
                 debug!(target: "wallet_command_executor", "CreateAndStoreCredentialDefinitionContinue command received");
                 self._create_and_store_credential_definition_continue(cb_id, wallet_handle, &schema, &schema_id, &cred_def_id, &tag, &signature_type, result)
             }
+            IssuerCommand::FillCredentialDefinitionKeyPool(wallet_handle, schema, config, cb) => {
+                debug!(target: "issuer_command_executor", "FillCredentialDefinitionKeyPool command received");
+                self.fill_credential_definition_key_pool(wallet_handle, &SchemaV1::from(schema), &config, cb);
+            }
+            IssuerCommand::FillCredentialDefinitionKeyPoolContinue(wallet_handle, key_pool_id, result, cb_id) => {
+                debug!(target: "issuer_command_executor", "FillCredentialDefinitionKeyPoolContinue command received");
+                self._fill_credential_definition_key_pool_continue(cb_id, wallet_handle, &key_pool_id, result);
+            }
             IssuerCommand::RotateCredentialDefinitionStart(wallet_handle, cred_def_id, cred_def_config, cb) => {
                 debug!(target: "wallet_command_executor", "RotateCredentialDefinitionStart command received");
                 self.rotate_credential_definition_start(wallet_handle, &cred_def_id, cred_def_config.as_ref(), cb);
@@ -279,6 +305,14 @@ impl IssuerCommandExecutor {
             return cb(Ok((cred_def_id.0, cred_def)));
         }
 
+        let key_pool_id = _key_pool_id(&schema.attr_names, cred_def_config.support_revocation);
+
+        if let Some(keys) = try_cb!(self._take_credential_definition_keys(wallet_handle, &key_pool_id), cb) {
+            let res = (keys.value, keys.cred_def_priv_key.value, keys.cred_def_correctness_proof.value);
+            cb(self._complete_create_and_store_credential_definition(wallet_handle, &schema, &schema_id, &cred_def_id, tag, signature_type, res));
+            return self._refill_credential_definition_key_pool(wallet_handle, &schema.attr_names, &key_pool_id);
+        }
+
         let cb_id = next_command_handle();
         self.pending_str_str_callbacks.borrow_mut().insert(cb_id, cb);
 
@@ -286,7 +320,7 @@ impl IssuerCommandExecutor {
         let attr_names = schema.attr_names.clone();
 
         self._create_credential_definition(&attr_names, cred_def_config.support_revocation, Box::new(move |res| {
-            CommandExecutor::instance().send(
+            CommandExecutor::instance().send_internal(
                 Command::Anoncreds(
                     AnoncredsCommand::Issuer(
                         IssuerCommand::CreateAndStoreCredentialDefinitionContinue(
@@ -409,6 +443,148 @@ impl IssuerCommandExecutor {
         Ok((cred_def_id.0.clone(), cred_def_json))
     }
 
+    fn fill_credential_definition_key_pool(&self,
+                                           wallet_handle: WalletHandle,
+                                           schema: &SchemaV1,
+                                           config: &CredentialDefinitionKeyPoolConfig,
+                                           cb: Box<dyn Fn(IndyResult<()>) + Send>) {
+        debug!("fill_credential_definition_key_pool >>> wallet_handle: {:?}, schema: {:?}, config: {:?}", wallet_handle, schema, config);
+
+        let key_pool_id = _key_pool_id(&schema.attr_names, config.support_revocation);
+
+        try_cb!(self.wallet_service.upsert_indy_object(wallet_handle, &key_pool_id, config), cb);
+
+        self._fill_credential_definition_key_pool(wallet_handle, &schema.attr_names, &key_pool_id, config, cb);
+    }
+
+    fn _refill_credential_definition_key_pool(&self,
+                                              wallet_handle: WalletHandle,
+                                              attr_names: &AttributeNames,
+                                              key_pool_id: &str) {
+        let config = match self.wallet_service.get_indy_opt_object::<CredentialDefinitionKeyPoolConfig>(wallet_handle, key_pool_id, &RecordOptions::id_value()) {
+            Ok(Some(config)) => config,
+            Ok(None) => return,
+            Err(err) => {
+                warn!("Unable to get credential definition key pool config {:?}: {:?}", key_pool_id, err);
+                return;
+            }
+        };
+
+        let key_pool_id_ = key_pool_id.to_string();
+        self._fill_credential_definition_key_pool(wallet_handle, attr_names, key_pool_id, &config, Box::new(move |res| {
+            if let Err(err) = res {
+                warn!("Unable to refill credential definition key pool {:?}: {:?}", key_pool_id_, err);
+            }
+        }));
+    }
+
+    fn _fill_credential_definition_key_pool(&self,
+                                            wallet_handle: WalletHandle,
+                                            attr_names: &AttributeNames,
+                                            key_pool_id: &str,
+                                            config: &CredentialDefinitionKeyPoolConfig,
+                                            cb: Box<dyn Fn(IndyResult<()>) + Send>) {
+        let search = try_cb!(self.wallet_service.search_indy_records::<CredentialDefinitionKeys>(wallet_handle, &_key_pool_query(key_pool_id), &SearchOptions::id_value()), cb);
+        let stored = try_cb!(search.get_total_count(), cb).unwrap_or(0);
+        let in_progress = self.key_pool_in_progress.borrow().get(key_pool_id).cloned().unwrap_or(0);
+
+        let missing = (config.size as usize).saturating_sub(stored + in_progress);
+
+        debug!("_fill_credential_definition_key_pool: key_pool_id: {:?}, stored: {}, in_progress: {}, missing: {}", key_pool_id, stored, in_progress, missing);
+
+        if missing == 0 {
+            return cb(Ok(()));
+        }
+
+        *self.key_pool_in_progress.borrow_mut().entry(key_pool_id.to_string()).or_insert(0) += missing;
+
+        let cb_id = next_command_handle();
+        self.pending_key_pool_callbacks.borrow_mut().insert(cb_id, (missing, Ok(()), cb));
+
+        for _ in 0..missing {
+            let key_pool_id = key_pool_id.to_string();
+            self._create_credential_definition(attr_names, config.support_revocation, Box::new(move |res| {
+                CommandExecutor::instance().send_internal(
+                    Command::Anoncreds(
+                        AnoncredsCommand::Issuer(
+                            IssuerCommand::FillCredentialDefinitionKeyPoolContinue(
+                                wallet_handle,
+                                key_pool_id.clone(),
+                                res,
+                                cb_id,
+                            ))
+                    )).unwrap();
+            }));
+        }
+    }
+
+    fn _fill_credential_definition_key_pool_continue(&self,
+                                                     cb_id: CommandHandle,
+                                                     wallet_handle: WalletHandle,
+                                                     key_pool_id: &str,
+                                                     result: IndyResult<(CredentialDefinitionData,
+                                                                         CredentialPrivateKey,
+                                                                         CredentialKeyCorrectnessProof)>) {
+        if let Some(in_progress) = self.key_pool_in_progress.borrow_mut().get_mut(key_pool_id) {
+            *in_progress = in_progress.saturating_sub(1);
+        }
+
+        let res = result.and_then(|(value, cred_priv_key, cred_key_correctness_proof)| {
+            let keys = CredentialDefinitionKeys {
+                value,
+                cred_def_priv_key: CredentialDefinitionPrivateKey { value: cred_priv_key },
+                cred_def_correctness_proof: CredentialDefinitionCorrectnessProof { value: cred_key_correctness_proof },
+            };
+
+            let mut tags = HashMap::new();
+            tags.insert("key_pool_id".to_string(), key_pool_id.to_string());
+
+            self.wallet_service.add_indy_object(wallet_handle, &uuid::Uuid::new_v4().to_string(), &keys, &tags)
+                .map(|_| ())
+        });
+
+        let done = {
+            let mut callbacks = self.pending_key_pool_callbacks.borrow_mut();
+            let (remaining, pool_res, _) = callbacks.get_mut(&cb_id).expect("FIXME INVALID STATE");
+
+            *remaining -= 1;
+            if pool_res.is_ok() {
+                *pool_res = res;
+            }
+
+            *remaining == 0
+        };
+
+        if done {
+            let (_, res, cb) = self.pending_key_pool_callbacks.borrow_mut().remove(&cb_id).expect("FIXME INVALID STATE");
+            debug!("fill_credential_definition_key_pool <<< key_pool_id: {:?}, res: {:?}", key_pool_id, res);
+            cb(res);
+        }
+    }
+
+    fn _take_credential_definition_keys(&self,
+                                        wallet_handle: WalletHandle,
+                                        key_pool_id: &str) -> IndyResult<Option<CredentialDefinitionKeys>> {
+        let mut search = self.wallet_service.search_indy_records::<CredentialDefinitionKeys>(wallet_handle, &_key_pool_query(key_pool_id), &SearchOptions::id_value())?;
+
+        let record = match search.fetch_next_record()? {
+            Some(record) => record,
+            None => return Ok(None)
+        };
+
+        // Keys are removed before they are used, so the same key material never backs two credential definitions.
+        self.wallet_service.delete_indy_record::<CredentialDefinitionKeys>(wallet_handle, record.get_id())?;
+
+        let keys = record.get_value()
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No value for CredentialDefinitionKeys record"))
+            .and_then(|value| serde_json::from_str(value)
+                .to_indy(IndyErrorKind::InvalidState, "Cannot deserialize CredentialDefinitionKeys"))?;
+
+        debug!("_take_credential_definition_keys: keys taken from key pool {:?}", key_pool_id);
+
+        Ok(Some(keys))
+    }
+
     fn rotate_credential_definition_start(&self,
                                           wallet_handle: WalletHandle,
                                           cred_def_id: &CredentialDefinitionId,
@@ -442,7 +618,7 @@ impl IssuerCommandExecutor {
         let support_revocation = cred_def_config.map(|config| config.support_revocation).unwrap_or_default();
 
         self._create_credential_definition(&schema.attr_names, support_revocation, Box::new(move |res| {
-            CommandExecutor::instance().send(
+            CommandExecutor::instance().send_internal(
                 Command::Anoncreds(
                     AnoncredsCommand::Issuer(
                         IssuerCommand::RotateCredentialDefinitionStartComplete(
@@ -957,3 +1133,14 @@ impl IssuerCommandExecutor {
         self.wallet_service.get_indy_object(wallet_handle, &key.0, &RecordOptions::id_value())
     }
 }
+
+fn _key_pool_id(attr_names: &AttributeNames, support_revocation: bool) -> String {
+    let mut attr_names: Vec<String> = attr_names.0.iter().map(|attr| attr_common_view(attr)).collect();
+    attr_names.sort();
+
+    format!("{}:{}", if support_revocation { "revocable" } else { "non_revocable" }, attr_names.join(","))
+}
+
+fn _key_pool_query(key_pool_id: &str) -> String {
+    json!({"key_pool_id": key_pool_id}).to_string()
+}
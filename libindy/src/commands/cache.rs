@@ -138,14 +138,14 @@ impl CacheCommandExecutor {
         let cb_id = next_command_handle();
         self.pending_callbacks.borrow_mut().insert(cb_id, cb);
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Ledger(
                 LedgerCommand::GetSchema(
                     pool_handle,
                     Some(submitter_did.clone()),
                     id.clone(),
                     Box::new(move |ledger_response| {
-                        CommandExecutor::instance().send(
+                        CommandExecutor::instance().send_internal(
                             Command::Cache(
                                 CacheCommand::GetSchemaContinue(
                                     wallet_handle,
@@ -220,14 +220,14 @@ impl CacheCommandExecutor {
         let cb_id = next_command_handle();
         self.pending_callbacks.borrow_mut().insert(cb_id, cb);
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Ledger(
                 LedgerCommand::GetCredDef(
                     pool_handle,
                     Some(submitter_did.clone()),
                     id.clone(),
                     Box::new(move |ledger_response| {
-                        CommandExecutor::instance().send(
+                        CommandExecutor::instance().send_internal(
                             Command::Cache(
                                 CacheCommand::GetCredDefContinue(
                                     wallet_handle,
@@ -295,24 +295,13 @@ impl CacheCommandExecutor {
         let max_age = options.max_age.unwrap_or(-1);
         let query_json = CacheCommandExecutor::build_query_json(max_age)?;
 
-        let options_json = json!({
-            "retrieveType": false,
-            "retrieveValue": false,
-            "retrieveTags": false,
-        }).to_string();
-
-        let mut search = self.wallet_service.search_records(
+        let deleted_count = self.wallet_service.delete_records(
             wallet_handle,
             SCHEMA_CACHE,
             &query_json,
-            &options_json,
         )?;
 
-        while let Some(record) = search.fetch_next_record()? {
-            self.wallet_service.delete_record(wallet_handle, SCHEMA_CACHE, record.get_id())?;
-        }
-
-        trace!("purge_schema_cache <<< res: ()");
+        trace!("purge_schema_cache <<< res: (), deleted_count: {:?}", deleted_count);
 
         Ok(())
     }
@@ -325,24 +314,13 @@ impl CacheCommandExecutor {
         let max_age = options.max_age.unwrap_or(-1);
         let query_json = CacheCommandExecutor::build_query_json(max_age)?;
 
-        let options_json = json!({
-            "retrieveType": false,
-            "retrieveValue": false,
-            "retrieveTags": false,
-        }).to_string();
-
-        let mut search = self.wallet_service.search_records(
+        let deleted_count = self.wallet_service.delete_records(
             wallet_handle,
             CRED_DEF_CACHE,
             &query_json,
-            &options_json,
         )?;
 
-        while let Some(record) = search.fetch_next_record()? {
-            self.wallet_service.delete_record(wallet_handle, CRED_DEF_CACHE, record.get_id())?;
-        }
-
-        trace!("purge_cred_def_cache <<< res: ()");
+        trace!("purge_cred_def_cache <<< res: (), deleted_count: {:?}", deleted_count);
 
         Ok(())
     }
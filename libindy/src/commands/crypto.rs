@@ -157,7 +157,7 @@ impl CryptoCommandExecutor {
             secret!(key_info)
         );
 
-        let key = self.crypto_service.create_key(key_info)?;
+        let key = self.crypto_service.create_key_for_wallet(wallet_handle, key_info)?;
         self.wallet_service
             .add_indy_object(wallet_handle, &key.verkey, &key, &HashMap::new())?;
 
@@ -382,7 +382,7 @@ impl CryptoCommandExecutor {
             self._prepare_protected_authcrypt(&cek, receiver_list, &sender_vk, wallet_handle)?
         } else {
             //returns anoncrypted pack_message format. See Wire message format HIPE for details
-            self._prepare_protected_anoncrypt(&cek, receiver_list)?
+            self._prepare_protected_anoncrypt(&cek, receiver_list, wallet_handle)?
         };
 
         // Use AEAD to encrypt `message` with "protected" data as "associated data"
@@ -396,12 +396,13 @@ impl CryptoCommandExecutor {
     fn _prepare_protected_anoncrypt(&self,
                                     cek: &chacha20poly1305_ietf::Key,
                                     receiver_list: Vec<String>,
+                                    wallet_handle: WalletHandle,
     ) -> IndyResult<String> {
         let mut encrypted_recipients_struct : Vec<Recipient> = Vec::with_capacity(receiver_list.len());
 
         for their_vk in receiver_list {
             //encrypt sender verkey
-            let enc_cek = self.crypto_service.crypto_box_seal(&their_vk, &cek[..])?;
+            let enc_cek = self.crypto_service.crypto_box_seal_for_wallet(wallet_handle, &their_vk, &cek[..])?;
 
             //create recipient struct and push to encrypted list
             encrypted_recipients_struct.push(Recipient {
@@ -432,9 +433,9 @@ impl CryptoCommandExecutor {
 
         //encrypt cek for recipient
         for their_vk in receiver_list {
-            let (enc_cek, iv) = self.crypto_service.crypto_box(&my_key, &their_vk, &cek[..])?;
+            let (enc_cek, iv) = self.crypto_service.crypto_box_for_wallet(wallet_handle, &my_key, &their_vk, &cek[..])?;
 
-            let enc_sender = self.crypto_service.crypto_box_seal(&their_vk, sender_vk.as_bytes())?;
+            let enc_sender = self.crypto_service.crypto_box_seal_for_wallet(wallet_handle, &their_vk, sender_vk.as_bytes())?;
 
             //create recipient struct and push to encrypted list
             encrypted_recipients_struct.push(Recipient {
@@ -512,13 +513,13 @@ impl CryptoCommandExecutor {
         })?;
 
         //extract recipient that matches a key in the wallet
-        let (recipient, is_auth_recipient) = self._find_correct_recipient(protected_struct, wallet_handle)?;
+        let (recipient, my_key, is_auth_recipient) = self._find_correct_recipient(protected_struct, wallet_handle)?;
 
         //get cek and sender data
         let (sender_verkey_option, cek) = if is_auth_recipient {
-            self._unpack_cek_authcrypt(recipient.clone(), wallet_handle)
+            self._unpack_cek_authcrypt(recipient.clone(), &my_key, wallet_handle)
         } else {
-            self._unpack_cek_anoncrypt(recipient.clone(), wallet_handle)
+            self._unpack_cek_anoncrypt(recipient.clone(), &my_key, wallet_handle)
         }?; //close cek and sender_data match statement
 
         //decrypt message
@@ -545,7 +546,7 @@ impl CryptoCommandExecutor {
         })
     }
 
-    fn _find_correct_recipient(&self, protected_struct: Protected, wallet_handle: WalletHandle) -> IndyResult<(Recipient, bool)>{
+    fn _find_correct_recipient(&self, protected_struct: Protected, wallet_handle: WalletHandle) -> IndyResult<(Recipient, Key, bool)>{
         for recipient in protected_struct.recipients {
             let my_key_res = self.wallet_service.get_indy_object::<Key>(
                 wallet_handle,
@@ -554,33 +555,27 @@ impl CryptoCommandExecutor {
             );
 
 
-            if my_key_res.is_ok() {
-                return Ok((recipient.clone(), recipient.header.sender.is_some()))
+            if let Ok(my_key) = my_key_res {
+                return Ok((recipient.clone(), my_key, recipient.header.sender.is_some()))
             }
         }
         Err(IndyError::from(IndyErrorKind::WalletItemNotFound))
     }
 
-    fn _unpack_cek_authcrypt(&self, recipient: Recipient, wallet_handle: WalletHandle) -> IndyResult<(Option<String>, chacha20poly1305_ietf::Key)> {
+    fn _unpack_cek_authcrypt(&self, recipient: Recipient, my_key: &Key, wallet_handle: WalletHandle) -> IndyResult<(Option<String>, chacha20poly1305_ietf::Key)> {
         let encrypted_key_vec = base64::decode_urlsafe(&recipient.encrypted_key)?;
         let iv = base64::decode_urlsafe(&recipient.header.iv.unwrap())?;
         let enc_sender_vk = base64::decode_urlsafe(&recipient.header.sender.unwrap())?;
 
-        //get my private key
-        let my_key = self.wallet_service.get_indy_object(
-            wallet_handle,
-            &recipient.header.kid,
-            &RecordOptions::id_value(),
-        )?;
-
         //decrypt sender_vk
-        let sender_vk_vec = self.crypto_service.crypto_box_seal_open(&my_key, enc_sender_vk.as_slice())?;
+        let sender_vk_vec = self.crypto_service.crypto_box_seal_open_for_wallet(wallet_handle, my_key, enc_sender_vk.as_slice())?;
         let sender_vk = String::from_utf8(sender_vk_vec)
             .map_err(|err| err_msg(IndyErrorKind::InvalidStructure, format!("Failed to utf-8 encode sender_vk {}", err)))?;
 
         //decrypt cek
-        let cek_as_vec = self.crypto_service.crypto_box_open(
-            &my_key,
+        let cek_as_vec = self.crypto_service.crypto_box_open_for_wallet(
+            wallet_handle,
+            my_key,
             &sender_vk,
             encrypted_key_vec.as_slice(),
             iv.as_slice())?;
@@ -596,19 +591,12 @@ impl CryptoCommandExecutor {
         Ok((Some(sender_vk), cek))
     }
 
-    fn _unpack_cek_anoncrypt(&self, recipient: Recipient, wallet_handle: WalletHandle) -> IndyResult<(Option<String>, chacha20poly1305_ietf::Key)> {
+    fn _unpack_cek_anoncrypt(&self, recipient: Recipient, my_key: &Key, wallet_handle: WalletHandle) -> IndyResult<(Option<String>, chacha20poly1305_ietf::Key)> {
         let encrypted_key_vec = base64::decode_urlsafe(&recipient.encrypted_key)?;
 
-        //get my private key
-        let my_key : Key = self.wallet_service.get_indy_object(
-            wallet_handle,
-            &recipient.header.kid,
-            &RecordOptions::id_value(),
-        )?;
-
         //decrypt cek
         let cek_as_vec = self.crypto_service
-            .crypto_box_seal_open(&my_key, encrypted_key_vec.as_slice())?;
+            .crypto_box_seal_open_for_wallet(wallet_handle, my_key, encrypted_key_vec.as_slice())?;
 
         //convert cek to chacha Key struct
         let cek: chacha20poly1305_ietf::Key =
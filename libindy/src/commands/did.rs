@@ -202,7 +202,7 @@ impl DidCommandExecutor {
                                my_did_info: &MyDidInfo) -> IndyResult<(String, String)> {
         debug!("create_and_store_my_did >>> wallet_handle: {:?}, my_did_info_json: {:?}", wallet_handle, secret!(my_did_info));
 
-        let (did, key) = self.crypto_service.create_my_did(&my_did_info)?;
+        let (did, key) = self.crypto_service.create_my_did_for_wallet(wallet_handle, &my_did_info)?;
 
         if let Ok(current_did) = self._wallet_get_my_did(wallet_handle, &did.did) {
             if did.verkey == current_did.verkey {
@@ -719,12 +719,12 @@ impl DidCommandExecutor {
         let did = did.clone();
 
         CommandExecutor::instance()
-            .send(Command::Ledger(LedgerCommand::SubmitRequest(
+            .send_internal(Command::Ledger(LedgerCommand::SubmitRequest(
                 pool_handle,
                 get_nym_request,
                 Box::new(move |result| {
                     CommandExecutor::instance()
-                        .send(Command::Did(DidCommand::GetNymAck(
+                        .send_internal(Command::Did(DidCommand::GetNymAck(
                             wallet_handle,
                             did.clone(),
                             result,
@@ -745,12 +745,12 @@ impl DidCommandExecutor {
         let get_attrib_request = self.ledger_service.build_get_attrib_request(None, did, Some("endpoint"), None, None).unwrap();
 
         CommandExecutor::instance()
-            .send(Command::Ledger(LedgerCommand::SubmitRequest(
+            .send_internal(Command::Ledger(LedgerCommand::SubmitRequest(
                 pool_handle,
                 get_attrib_request,
                 Box::new(move |result| {
                     CommandExecutor::instance()
-                        .send(Command::Did(DidCommand::GetAttribAck(
+                        .send_internal(Command::Did(DidCommand::GetAttribAck(
                             wallet_handle,
                             result,
                             deferred_cmd_id,
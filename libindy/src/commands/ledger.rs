@@ -1,12 +1,15 @@
 use std::cell::RefCell;
+use std::cmp;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::string::ToString;
 
-use indy_api_types::{CommandHandle, PoolHandle, WalletHandle};
+use failure::Context;
+use indy_api_types::{CommandHandle, PoolHandle, RequestHandle, SearchHandle, WalletHandle};
 use indy_api_types::errors::prelude::*;
-use indy_utils::next_command_handle;
-use rust_base58::ToBase58;
+use indy_utils::{next_command_handle, next_search_handle};
+use rmp_serde;
+use rust_base58::{FromBase58, ToBase58};
 use serde_json;
 use serde_json::Value;
 
@@ -27,8 +30,11 @@ use crate::domain::ledger::pool::Schedule;
 use crate::domain::ledger::request::Request;
 use crate::services::crypto::CryptoService;
 use crate::services::ledger::LedgerService;
+use crate::services::ledger::merkletree::compact::CompactMerkleTree;
 use crate::services::pool::{
     parse_response_metadata,
+    CatchupRep,
+    ConsistencyProof,
     PoolService
 };
 use crate::utils::crypto::signature_serializer::serialize_signature;
@@ -283,6 +289,87 @@ pub enum LedgerCommand {
         DidValue, // submitter did
         Vec<u64>, // ledgers ids
         Box<dyn Fn(IndyResult<String>) + Send>),
+    BuildNymRequestHandle(
+        DidValue, // submitter did
+        DidValue, // target did
+        Option<String>, // verkey
+        Option<String>, // alias
+        Option<String>, // role
+        Box<dyn Fn(IndyResult<RequestHandle>) + Send>),
+    BuildAttribRequestHandle(
+        DidValue, // submitter did
+        DidValue, // target did
+        Option<String>, // hash
+        Option<serde_json::Value>, // raw
+        Option<String>, // enc
+        Box<dyn Fn(IndyResult<RequestHandle>) + Send>),
+    RequestHandleFromJson(
+        String, // request json
+        Box<dyn Fn(IndyResult<RequestHandle>) + Send>),
+    RequestHandleToJson(
+        RequestHandle,
+        Box<dyn Fn(IndyResult<String>) + Send>),
+    SignRequestHandle(
+        WalletHandle,
+        DidValue, // submitter did
+        RequestHandle,
+        Box<dyn Fn(IndyResult<()>) + Send>),
+    MultiSignRequestHandle(
+        WalletHandle,
+        DidValue, // submitter did
+        RequestHandle,
+        Box<dyn Fn(IndyResult<()>) + Send>),
+    SubmitRequestHandle(
+        PoolHandle,
+        RequestHandle,
+        Box<dyn Fn(IndyResult<String>) + Send>),
+    SignAndSubmitRequestHandle(
+        PoolHandle,
+        WalletHandle,
+        DidValue, // submitter did
+        RequestHandle,
+        Box<dyn Fn(IndyResult<String>) + Send>),
+    ReleaseRequestHandle(
+        RequestHandle,
+        Box<dyn Fn(IndyResult<()>) + Send>),
+    OpenLedgerTxnsRange(
+        PoolHandle,
+        Option<String>, // ledger type
+        i32, // from
+        i32, // to
+        Box<dyn Fn(IndyResult<SearchHandle>) + Send>),
+    OpenLedgerTxnsRangeContinue(
+        PoolHandle,
+        u8, // ledger id
+        usize, // from
+        usize, // to
+        IndyResult<String>, // agreed consistency proof
+        CommandHandle,
+    ),
+    FetchLedgerTxnsRange(
+        SearchHandle,
+        usize, // count
+        Box<dyn Fn(IndyResult<String>) + Send>),
+    FetchLedgerTxnsRangeContinue(
+        SearchHandle,
+        usize, // seq no start
+        IndyResult<String>, // catchup reply
+        CommandHandle,
+    ),
+    CloseLedgerTxnsRange(
+        SearchHandle,
+        Box<dyn Fn(IndyResult<()>) + Send>),
+}
+
+/// Verified prefix of the ledger and the position of the next transaction to fetch.
+struct LedgerTxnsRange {
+    pool_handle: PoolHandle,
+    ledger_id: u8,
+    merkle_tree: CompactMerkleTree,
+    target_mt_root: Vec<u8>,
+    target_mt_size: usize,
+    next: usize,
+    to: usize,
 }
 
 pub struct LedgerCommandExecutor {
@@ -293,6 +380,11 @@ pub struct LedgerCommandExecutor {
 
     send_callbacks: RefCell<HashMap<CommandHandle, Box<dyn Fn(IndyResult<String>)>>>,
     pending_callbacks: RefCell<HashMap<CommandHandle, Box<dyn Fn(IndyResult<(String, String)>)>>>,
+    // Requests built or signed through request handles are kept parsed between the steps
+    requests: RefCell<HashMap<RequestHandle, Value>>,
+    txns_ranges: RefCell<HashMap<SearchHandle, LedgerTxnsRange>>,
+    open_txns_range_callbacks: RefCell<HashMap<CommandHandle, Box<dyn Fn(IndyResult<SearchHandle>)>>>,
+    fetch_txns_range_callbacks: RefCell<HashMap<CommandHandle, Box<dyn Fn(IndyResult<String>)>>>,
 }
 
 impl LedgerCommandExecutor {
@@ -307,6 +399,10 @@ impl LedgerCommandExecutor {
             ledger_service,
             send_callbacks: RefCell::new(HashMap::new()),
             pending_callbacks: RefCell::new(HashMap::new()),
+            requests: RefCell::new(HashMap::new()),
+            txns_ranges: RefCell::new(HashMap::new()),
+            open_txns_range_callbacks: RefCell::new(HashMap::new()),
+            fetch_txns_range_callbacks: RefCell::new(HashMap::new()),
         }
     }
 
@@ -543,6 +639,71 @@ impl LedgerCommandExecutor {
                 debug!(target: "ledger_command_executor", "BuildGetFrozenLedgersRequest command received");
                 cb(self.build_get_frozen_ledgers_request(&submitter_did));
             }
+            LedgerCommand::BuildNymRequestHandle(submitter_did, target_did, verkey, alias, role, cb) => {
+                debug!(target: "ledger_command_executor", "BuildNymRequestHandle command received");
+                cb(self.build_nym_request_handle(&submitter_did, &target_did,
+                                                 verkey.as_ref().map(String::as_str),
+                                                 alias.as_ref().map(String::as_str),
+                                                 role.as_ref().map(String::as_str)));
+            }
+            LedgerCommand::BuildAttribRequestHandle(submitter_did, target_did, hash, raw, enc, cb) => {
+                debug!(target: "ledger_command_executor", "BuildAttribRequestHandle command received");
+                cb(self.build_attrib_request_handle(&submitter_did, &target_did,
+                                                    hash.as_ref().map(String::as_str),
+                                                    raw.as_ref(),
+                                                    enc.as_ref().map(String::as_str)));
+            }
+            LedgerCommand::RequestHandleFromJson(request_json, cb) => {
+                debug!(target: "ledger_command_executor", "RequestHandleFromJson command received");
+                cb(self.request_handle_from_json(&request_json));
+            }
+            LedgerCommand::RequestHandleToJson(request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "RequestHandleToJson command received");
+                cb(self.request_handle_to_json(request_handle));
+            }
+            LedgerCommand::SignRequestHandle(wallet_handle, submitter_did, request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "SignRequestHandle command received");
+                cb(self.sign_request_handle(wallet_handle, &submitter_did, request_handle, SignatureType::Single));
+            }
+            LedgerCommand::MultiSignRequestHandle(wallet_handle, submitter_did, request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "MultiSignRequestHandle command received");
+                cb(self.sign_request_handle(wallet_handle, &submitter_did, request_handle, SignatureType::Multi));
+            }
+            LedgerCommand::SubmitRequestHandle(pool_handle, request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "SubmitRequestHandle command received");
+                self.submit_request_handle(pool_handle, request_handle, cb);
+            }
+            LedgerCommand::SignAndSubmitRequestHandle(pool_handle, wallet_handle, submitter_did, request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "SignAndSubmitRequestHandle command received");
+                match self.sign_request_handle(wallet_handle, &submitter_did, request_handle, SignatureType::Single) {
+                    Ok(()) => self.submit_request_handle(pool_handle, request_handle, cb),
+                    Err(err) => cb(Err(err))
+                }
+            }
+            LedgerCommand::ReleaseRequestHandle(request_handle, cb) => {
+                debug!(target: "ledger_command_executor", "ReleaseRequestHandle command received");
+                cb(self.release_request_handle(request_handle));
+            }
+            LedgerCommand::OpenLedgerTxnsRange(pool_handle, ledger_type, from, to, cb) => {
+                debug!(target: "ledger_command_executor", "OpenLedgerTxnsRange command received");
+                self.open_ledger_txns_range(pool_handle, ledger_type.as_ref().map(String::as_str), from, to, cb);
+            }
+            LedgerCommand::OpenLedgerTxnsRangeContinue(pool_handle, ledger_id, from, to, pool_response, cb_id) => {
+                debug!(target: "ledger_command_executor", "OpenLedgerTxnsRangeContinue command received");
+                self._open_ledger_txns_range_continue(pool_handle, ledger_id, from, to, pool_response, cb_id);
+            }
+            LedgerCommand::FetchLedgerTxnsRange(txns_range_handle, count, cb) => {
+                debug!(target: "ledger_command_executor", "FetchLedgerTxnsRange command received");
+                self.fetch_ledger_txns_range(txns_range_handle, count, cb);
+            }
+            LedgerCommand::FetchLedgerTxnsRangeContinue(txns_range_handle, seq_no_start, pool_response, cb_id) => {
+                debug!(target: "ledger_command_executor", "FetchLedgerTxnsRangeContinue command received");
+                self._fetch_ledger_txns_range_continue(txns_range_handle, seq_no_start, pool_response, cb_id);
+            }
+            LedgerCommand::CloseLedgerTxnsRange(txns_range_handle, cb) => {
+                debug!(target: "ledger_command_executor", "CloseLedgerTxnsRange command received");
+                cb(self.close_ledger_txns_range(txns_range_handle));
+            }
         };
     }
 
@@ -577,19 +738,40 @@ impl LedgerCommandExecutor {
                      signature_type: SignatureType) -> IndyResult<String> {
         debug!("_sign_request >>> wallet_handle: {:?}, submitter_did: {:?}, request_json: {:?}", wallet_handle, submitter_did, request_json);
 
+        let (my_did, my_key) = self._get_signer(wallet_handle, submitter_did)?;
+
+        let mut request: Value = serde_json::from_str(request_json)
+            .to_indy(IndyErrorKind::InvalidStructure, "Message is invalid json")?;
+
+        self._sign_request_value(&my_did, &my_key, &mut request, signature_type)?;
+
+        let res: String = serde_json::to_string(&request)
+            .to_indy(IndyErrorKind::InvalidState, "Can't serialize message after signing")?;
+
+        debug!("_sign_request <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
+    fn _get_signer(&self, wallet_handle: WalletHandle, submitter_did: &DidValue) -> IndyResult<(Did, Key)> {
         let my_did: Did = self.wallet_service.get_indy_object(wallet_handle, &submitter_did.0, &RecordOptions::id_value())?;
 
         let my_key: Key = self.wallet_service.get_indy_object(wallet_handle, &my_did.verkey, &RecordOptions::id_value())?;
 
-        let mut request: Value = serde_json::from_str(request_json)
-            .to_indy(IndyErrorKind::InvalidStructure, "Message is invalid json")?;
+        Ok((my_did, my_key))
+    }
 
+    fn _sign_request_value(&self,
+                           my_did: &Did,
+                           my_key: &Key,
+                           request: &mut Value,
+                           signature_type: SignatureType) -> IndyResult<()> {
         if !request.is_object() {
             return Err(err_msg(IndyErrorKind::InvalidStructure, "Message isn't json object"));
         }
 
         let serialized_request = serialize_signature(request.clone())?;
-        let signature = self.crypto_service.sign(&my_key, &serialized_request.as_bytes().to_vec())?;
+        let signature = self.crypto_service.sign(my_key, &serialized_request.as_bytes().to_vec())?;
         let did = my_did.did.to_short();
 
         match signature_type {
@@ -610,12 +792,7 @@ impl LedgerCommandExecutor {
             }
         }
 
-        let res: String = serde_json::to_string(&request)
-            .to_indy(IndyErrorKind::InvalidState, "Can't serialize message after signing")?;
-
-        debug!("_sign_request <<< res: {:?}", res);
-
-        Ok(res)
+        Ok(())
     }
 
     fn submit_request(&self,
@@ -1280,7 +1457,7 @@ impl LedgerCommandExecutor {
         let id = id.clone();
 
         self.submit_request(pool_handle, &request_json, Box::new(move |response| {
-            CommandExecutor::instance().send(
+            CommandExecutor::instance().send_internal(
                 Command::Ledger(
                     LedgerCommand::GetSchemaContinue(
                         id.clone(),
@@ -1306,7 +1483,7 @@ impl LedgerCommandExecutor {
         let id = id.clone();
 
         self.submit_request(pool_handle, &request_json, Box::new(move |response| {
-            CommandExecutor::instance().send(
+            CommandExecutor::instance().send_internal(
                 Command::Ledger(
                     LedgerCommand::GetCredDefContinue(
                         id.clone(),
@@ -1324,6 +1501,355 @@ impl LedgerCommandExecutor {
         cb(self.ledger_service.parse_get_cred_def_response(&pool_response, id.get_method().as_ref().map(String::as_str)))
     }
 
+    fn build_nym_request_handle(&self,
+                                submitter_did: &DidValue,
+                                target_did: &DidValue,
+                                verkey: Option<&str>,
+                                alias: Option<&str>,
+                                role: Option<&str>) -> IndyResult<RequestHandle> {
+        debug!("build_nym_request_handle >>> submitter_did: {:?}, target_did: {:?}, verkey: {:?}, alias: {:?}, role: {:?}",
+               submitter_did, target_did, verkey, alias, role);
+
+        self.crypto_service.validate_did(submitter_did)?;
+        self.crypto_service.validate_did(target_did)?;
+        if let Some(vk) = verkey {
+            self.crypto_service.validate_key(vk)?;
+        }
+
+        let request = self.ledger_service.build_nym_request_value(submitter_did, target_did, verkey, alias, role)?;
+
+        let res = self._add_request(request);
+
+        debug!("build_nym_request_handle <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
+    fn build_attrib_request_handle(&self,
+                                   submitter_did: &DidValue,
+                                   target_did: &DidValue,
+                                   hash: Option<&str>,
+                                   raw: Option<&serde_json::Value>,
+                                   enc: Option<&str>) -> IndyResult<RequestHandle> {
+        debug!("build_attrib_request_handle >>> submitter_did: {:?}, target_did: {:?}, hash: {:?}, raw: {:?}, enc: {:?}",
+               submitter_did, target_did, hash, raw, enc);
+
+        self.crypto_service.validate_did(submitter_did)?;
+        self.crypto_service.validate_did(target_did)?;
+
+        let request = self.ledger_service.build_attrib_request_value(submitter_did, target_did, hash, raw, enc)?;
+
+        let res = self._add_request(request);
+
+        debug!("build_attrib_request_handle <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
+    fn request_handle_from_json(&self, request_json: &str) -> IndyResult<RequestHandle> {
+        debug!("request_handle_from_json >>> request_json: {:?}", request_json);
+
+        let request: Value = serde_json::from_str(request_json)
+            .to_indy(IndyErrorKind::InvalidStructure, "Request is invalid json")?;
+
+        serde_json::from_value::<Request<Value>>(request.clone())
+            .to_indy(IndyErrorKind::InvalidStructure, "Request is invalid json")?;
+
+        let res = self._add_request(request);
+
+        debug!("request_handle_from_json <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
+    fn request_handle_to_json(&self, request_handle: RequestHandle) -> IndyResult<String> {
+        debug!("request_handle_to_json >>> request_handle: {:?}", request_handle);
+
+        let res = self._with_request(request_handle, |request| {
+            serde_json::to_string(request)
+                .to_indy(IndyErrorKind::InvalidState, "Can't serialize request")
+        })?;
+
+        debug!("request_handle_to_json <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
+    fn sign_request_handle(&self,
+                           wallet_handle: WalletHandle,
+                           submitter_did: &DidValue,
+                           request_handle: RequestHandle,
+                           signature_type: SignatureType) -> IndyResult<()> {
+        debug!("sign_request_handle >>> wallet_handle: {:?}, submitter_did: {:?}, request_handle: {:?}", wallet_handle, submitter_did, request_handle);
+
+        let (my_did, my_key) = self._get_signer(wallet_handle, submitter_did)?;
+
+        self._with_request(request_handle, |request| self._sign_request_value(&my_did, &my_key, request, signature_type))?;
+
+        debug!("sign_request_handle <<<");
+
+        Ok(())
+    }
+
+    fn submit_request_handle(&self,
+                             pool_handle: PoolHandle,
+                             request_handle: RequestHandle,
+                             cb: Box<dyn Fn(IndyResult<String>) + Send>) {
+        debug!("submit_request_handle >>> pool_handle: {:?}, request_handle: {:?}", pool_handle, request_handle);
+
+        // requests are validated when handle is created, so request is serialized only once here
+        let request_json = try_cb!(self.request_handle_to_json(request_handle), cb);
+
+        match self.pool_service.send_tx(pool_handle, &request_json) {
+            Ok(cmd_id) => { self.send_callbacks.borrow_mut().insert(cmd_id, cb); }
+            Err(err) => { cb(Err(err)); }
+        };
+    }
+
+    fn release_request_handle(&self, request_handle: RequestHandle) -> IndyResult<()> {
+        debug!("release_request_handle >>> request_handle: {:?}", request_handle);
+
+        self.requests.borrow_mut().remove(&request_handle)
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, format!("Unknown request handle: {:?}", request_handle)))?;
+
+        debug!("release_request_handle <<<");
+
+        Ok(())
+    }
+
+    fn _add_request(&self, request: Value) -> RequestHandle {
+        let request_handle = indy_utils::sequence::get_next_id();
+        self.requests.borrow_mut().insert(request_handle, request);
+        request_handle
+    }
+
+    fn _with_request<F, T>(&self, request_handle: RequestHandle, f: F) -> IndyResult<T> where F: FnOnce(&mut Value) -> IndyResult<T> {
+        let mut requests = self.requests.borrow_mut();
+
+        let request = requests.get_mut(&request_handle)
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, format!("Unknown request handle: {:?}", request_handle)))?;
+
+        f(request)
+    }
+
+    fn open_ledger_txns_range(&self,
+                              pool_handle: PoolHandle,
+                              ledger_type: Option<&str>,
+                              from: i32,
+                              to: i32,
+                              cb: Box<dyn Fn(IndyResult<SearchHandle>) + Send>) {
+        debug!("open_ledger_txns_range >>> pool_handle: {:?}, ledger_type: {:?}, from: {:?}, to: {:?}", pool_handle, ledger_type, from, to);
+
+        let ledger_id = try_cb!(self.ledger_service.parse_ledger_type(ledger_type), cb);
+
+        if ledger_id < 0 || ledger_id > i32::from(u8::max_value()) {
+            return cb(Err(err_msg(IndyErrorKind::InvalidStructure, format!("Invalid Ledger type: {:?}", ledger_type))));
+        }
+
+        if from < 1 || to < from {
+            return cb(Err(err_msg(IndyErrorKind::InvalidStructure, format!("Invalid range of transactions: {}..{}", from, to))));
+        }
+
+        let (ledger_id, from, to) = (ledger_id as u8, from as usize, to as usize);
+
+        // Nodes don't build consistency proof from the empty ledger.
+        // The first transaction is verified by the proof to the target ledger anyway.
+        let txn_seq_no = cmp::max(from - 1, 1);
+
+        let cb_id = next_command_handle();
+
+        match self.pool_service.send_ledger_status(pool_handle, ledger_id, txn_seq_no) {
+            Ok(cmd_id) => {
+                self.open_txns_range_callbacks.borrow_mut().insert(cb_id, cb);
+                self.send_callbacks.borrow_mut().insert(cmd_id, Box::new(move |response| {
+                    CommandExecutor::instance().send_internal(
+                        Command::Ledger(
+                            LedgerCommand::OpenLedgerTxnsRangeContinue(
+                                pool_handle,
+                                ledger_id,
+                                from,
+                                to,
+                                response,
+                                cb_id
+                            )
+                        )
+                    ).unwrap();
+                }));
+            }
+            Err(err) => cb(Err(err))
+        }
+    }
+
+    fn _open_ledger_txns_range_continue(&self, pool_handle: PoolHandle, ledger_id: u8, from: usize, to: usize,
+                                        pool_response: IndyResult<String>, cb_id: CommandHandle) {
+        let cb = self.open_txns_range_callbacks.borrow_mut().remove(&cb_id).expect("FIXME INVALID STATE");
+        let pool_response = try_cb!(pool_response, cb);
+        cb(self._add_ledger_txns_range(pool_handle, ledger_id, from, to, &pool_response))
+    }
+
+    fn _add_ledger_txns_range(&self, pool_handle: PoolHandle, ledger_id: u8, from: usize, to: usize,
+                              pool_response: &str) -> IndyResult<SearchHandle> {
+        debug!("_add_ledger_txns_range >>> pool_handle: {:?}, ledger_id: {:?}, from: {:?}, to: {:?}, pool_response: {:?}",
+               pool_handle, ledger_id, from, to, pool_response);
+
+        let cons_proof: ConsistencyProof = serde_json::from_str(pool_response)
+            .to_indy(IndyErrorKind::InvalidStructure, "Invalid ConsistencyProof json")?;
+
+        let target_mt_root = _decode_hash(&cons_proof.newMerkleRoot)?;
+        let target_mt_size = cons_proof.seqNoEnd;
+        let seq_no_start = from - 1;
+
+        let merkle_tree = if seq_no_start == 0 || target_mt_size <= seq_no_start {
+            CompactMerkleTree::default()
+        } else if cons_proof.seqNoStart == seq_no_start {
+            let old_mt_root = _decode_hash(&cons_proof.oldMerkleRoot)?;
+            let hashes = cons_proof.hashes.iter()
+                .map(|hash| _decode_hash(hash))
+                .collect::<IndyResult<Vec<Vec<u8>>>>()?;
+
+            CompactMerkleTree::from_consistency_proof(seq_no_start, &old_mt_root, &target_mt_root, target_mt_size, &hashes)?
+        } else {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, format!("Unexpected start of ConsistencyProof: {}", cons_proof.seqNoStart)));
+        };
+
+        let txns_range = LedgerTxnsRange {
+            pool_handle,
+            ledger_id,
+            merkle_tree,
+            target_mt_root,
+            target_mt_size,
+            next: from,
+            to: cmp::min(to, target_mt_size),
+        };
+
+        let txns_range_handle = next_search_handle();
+        self.txns_ranges.borrow_mut().insert(txns_range_handle, txns_range);
+
+        debug!("_add_ledger_txns_range <<< txns_range_handle: {:?}", txns_range_handle);
+
+        Ok(txns_range_handle)
+    }
+
+    fn fetch_ledger_txns_range(&self,
+                               txns_range_handle: SearchHandle,
+                               count: usize,
+                               cb: Box<dyn Fn(IndyResult<String>) + Send>) {
+        debug!("fetch_ledger_txns_range >>> txns_range_handle: {:?}, count: {:?}", txns_range_handle, count);
+
+        if count == 0 {
+            return cb(Err(err_msg(IndyErrorKind::InvalidStructure, "Count of transactions to fetch must be positive")));
+        }
+
+        let (pool_handle, ledger_id, seq_no_start, seq_no_end, catchup_till) = {
+            let txns_ranges = self.txns_ranges.borrow();
+            let txns_range = try_cb!(txns_ranges.get(&txns_range_handle)
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, format!("Unknown ledger transactions range handle: {:?}", txns_range_handle))), cb);
+
+            (txns_range.pool_handle,
+             txns_range.ledger_id,
+             txns_range.next,
+             cmp::min(txns_range.next.saturating_add(count - 1), txns_range.to),
+             txns_range.target_mt_size)
+        };
+
+        if seq_no_start > seq_no_end {
+            return cb(Ok("[]".to_string()));
+        }
+
+        let cb_id = next_command_handle();
+
+        match self.pool_service.send_catchup_req(pool_handle, ledger_id as usize, seq_no_start, seq_no_end, catchup_till) {
+            Ok(cmd_id) => {
+                self.fetch_txns_range_callbacks.borrow_mut().insert(cb_id, cb);
+                self.send_callbacks.borrow_mut().insert(cmd_id, Box::new(move |response| {
+                    CommandExecutor::instance().send_internal(
+                        Command::Ledger(
+                            LedgerCommand::FetchLedgerTxnsRangeContinue(
+                                txns_range_handle,
+                                seq_no_start,
+                                response,
+                                cb_id
+                            )
+                        )
+                    ).unwrap();
+                }));
+            }
+            Err(err) => cb(Err(err))
+        }
+    }
+
+    fn _fetch_ledger_txns_range_continue(&self, txns_range_handle: SearchHandle, seq_no_start: usize,
+                                         pool_response: IndyResult<String>, cb_id: CommandHandle) {
+        let cb = self.fetch_txns_range_callbacks.borrow_mut().remove(&cb_id).expect("FIXME INVALID STATE");
+        let pool_response = try_cb!(pool_response, cb);
+        cb(self._apply_ledger_txns(txns_range_handle, seq_no_start, &pool_response))
+    }
+
+    fn _apply_ledger_txns(&self, txns_range_handle: SearchHandle, seq_no_start: usize, pool_response: &str) -> IndyResult<String> {
+        debug!("_apply_ledger_txns >>> txns_range_handle: {:?}, seq_no_start: {:?}", txns_range_handle, seq_no_start);
+
+        let mut txns_ranges = self.txns_ranges.borrow_mut();
+
+        // range can be closed or fetched by another call while waiting for the nodes
+        let txns_range = txns_ranges.get_mut(&txns_range_handle)
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, format!("Ledger transactions range was closed: {:?}", txns_range_handle)))?;
+
+        if txns_range.next != seq_no_start {
+            return Err(err_msg(IndyErrorKind::InvalidState, "Ledger transactions range was fetched concurrently"));
+        }
+
+        let mut catchup_rep: CatchupRep = serde_json::from_str(pool_response)
+            .to_indy(IndyErrorKind::InvalidStructure, "Invalid CatchupRep json")?;
+
+        let txns_count = catchup_rep.txns.len();
+
+        if txns_count == 0 || seq_no_start + txns_count - 1 > txns_range.to {
+            return Err(err_msg(IndyErrorKind::InvalidStructure, "Unexpected transactions in CatchupRep"));
+        }
+
+        let mut merkle_tree = txns_range.merkle_tree.clone();
+        let mut txns = Vec::with_capacity(txns_count);
+
+        for seq_no in seq_no_start..seq_no_start + txns_count {
+            let txn = catchup_rep.txns.remove(&seq_no.to_string())
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, format!("Transaction {} is missed in CatchupRep", seq_no)))?;
+
+            let leaf = rmp_serde::to_vec_named(&txn)
+                .to_indy(IndyErrorKind::InvalidStructure, "Invalid transaction -- can not transform to bytes")?;
+
+            merkle_tree.append(leaf)?;
+            txns.push(txn);
+        }
+
+        let cons_proof = catchup_rep.consProof.iter()
+            .map(|hash| _decode_hash(hash))
+            .collect::<IndyResult<Vec<Vec<u8>>>>()?;
+
+        if !merkle_tree.consistency_proof(&txns_range.target_mt_root, txns_range.target_mt_size, &cons_proof)? {
+            return Err(err_msg(IndyErrorKind::InvalidState, "Consistency proof verification failed"));
+        }
+
+        txns_range.merkle_tree = merkle_tree;
+        txns_range.next = seq_no_start + txns_count;
+
+        let res = Value::Array(txns).to_string();
+
+        debug!("_apply_ledger_txns <<< fetched: {:?}", txns_count);
+
+        Ok(res)
+    }
+
+    fn close_ledger_txns_range(&self, txns_range_handle: SearchHandle) -> IndyResult<()> {
+        debug!("close_ledger_txns_range >>> txns_range_handle: {:?}", txns_range_handle);
+
+        self.txns_ranges.borrow_mut().remove(&txns_range_handle)
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, format!("Unknown ledger transactions range handle: {:?}", txns_range_handle)))?;
+
+        debug!("close_ledger_txns_range <<<");
+
+        Ok(())
+    }
+
     fn build_ledgers_freeze_request(&self, submitter_did: &DidValue, ledgers_ids: Vec<u64>) -> IndyResult<String>{
         debug!("build_ledgers_freeze_request >>> submitter_did: {:?}, ledgers_ids: {:?}", submitter_did, ledgers_ids);
 
@@ -1353,3 +1879,9 @@ enum SignatureType {
     Single,
     Multi
 }
+
+fn _decode_hash(hash: &str) -> IndyResult<Vec<u8>> {
+    hash.from_base58()
+        .map_err(Context::new)
+        .to_indy(IndyErrorKind::InvalidStructure, "Can't decode merkle tree hash from nodes responses")
+}
@@ -1,3 +1,5 @@
+use crate::commands::queue;
+use crate::services::pool::sockets_stats;
 use crate::services::metrics::models::MetricsValue;
 use crate::services::metrics::MetricsService;
 use indy_api_types::errors::prelude::*;
@@ -14,6 +16,13 @@ const OPENED_WALLETS_COUNT: &str = "opened";
 const OPENED_WALLET_IDS_COUNT: &str = "opened_ids";
 const PENDING_FOR_IMPORT_WALLETS_COUNT: &str = "pending_for_import";
 const PENDING_FOR_OPEN_WALLETS_COUNT: &str = "pending_for_open";
+const WALLET_STORAGE_TOTAL_SIZE: &str = "total";
+const WALLET_STORAGE_FREE_SIZE: &str = "free";
+const COMMAND_QUEUE_DEPTH_COUNT: &str = "depth";
+const COMMAND_QUEUE_LIMIT_COUNT: &str = "limit";
+const COMMAND_QUEUE_REJECTED_COUNT: &str = "rejected";
+const POOL_SOCKETS_OPENED_COUNT: &str = "opened";
+const POOL_SOCKETS_REUSED_COUNT: &str = "reused";
 
 pub enum MetricsCommand {
     CollectMetrics(Box<dyn Fn(IndyResult<String>) + Send>),
@@ -49,6 +58,8 @@ impl MetricsCommandExecutor {
         let mut metrics_map = serde_json::Map::new();
         self.append_threapool_metrics(&mut metrics_map)?;
         self.append_wallet_metrics(&mut metrics_map)?;
+        self.append_command_queue_metrics(&mut metrics_map)?;
+        self.append_pool_metrics(&mut metrics_map)?;
         self.metrics_service
             .append_command_metrics(&mut metrics_map)?;
         let res = serde_json::to_string(&metrics_map)
@@ -130,9 +141,70 @@ impl MetricsCommandExecutor {
                 .to_indy(IndyErrorKind::IOError, "Unable to convert json")?,
         );
 
+        // Bytes in storages of opened wallets, free space can be reclaimed by compaction
+        let storage_size = self.wallet_service.get_storage_size()?;
+        let mut wallet_storage_size = Vec::new();
+
+        wallet_storage_size.push(self.get_metric_json(WALLET_STORAGE_TOTAL_SIZE, storage_size.size as usize)?);
+        wallet_storage_size.push(self.get_metric_json(WALLET_STORAGE_FREE_SIZE, storage_size.free as usize)?);
+
+        metrics_map.insert(
+            String::from("wallet_storage_size"),
+            serde_json::to_value(wallet_storage_size)
+                .to_indy(IndyErrorKind::IOError, "Unable to convert json")?,
+        );
+
+        Ok(())
+    }
+
+    fn append_command_queue_metrics(&self, metrics_map: &mut Map<String, Value>) -> IndyResult<()> {
+        let stats = queue::stats();
+        let mut command_queue_count = Vec::new();
+
+        command_queue_count.push(self.get_metric_json(COMMAND_QUEUE_DEPTH_COUNT, stats.depth)?);
+        command_queue_count.push(self.get_metric_json(COMMAND_QUEUE_LIMIT_COUNT, stats.size)?);
+
+        for class in stats.classes {
+            command_queue_count.push(self.get_class_metric_json(COMMAND_QUEUE_DEPTH_COUNT, class.name, class.depth)?);
+            command_queue_count.push(self.get_class_metric_json(COMMAND_QUEUE_LIMIT_COUNT, class.name, class.limit)?);
+            command_queue_count.push(self.get_class_metric_json(COMMAND_QUEUE_REJECTED_COUNT, class.name, class.rejected)?);
+        }
+
+        metrics_map.insert(
+            String::from("command_queue_count"),
+            serde_json::to_value(command_queue_count)
+                .to_indy(IndyErrorKind::IOError, "Unable to convert json")?,
+        );
+
         Ok(())
     }
 
+    fn append_pool_metrics(&self, metrics_map: &mut Map<String, Value>) -> IndyResult<()> {
+        let stats = sockets_stats();
+        let mut pool_sockets_count = Vec::new();
+
+        pool_sockets_count.push(self.get_metric_json(POOL_SOCKETS_OPENED_COUNT, stats.opened)?);
+        pool_sockets_count.push(self.get_metric_json(POOL_SOCKETS_REUSED_COUNT, stats.reused)?);
+
+        metrics_map.insert(
+            String::from("pool_sockets_count"),
+            serde_json::to_value(pool_sockets_count)
+                .to_indy(IndyErrorKind::IOError, "Unable to convert json")?,
+        );
+
+        Ok(())
+    }
+
+    fn get_class_metric_json(&self, label: &str, class: &str, value: usize) -> IndyResult<Value> {
+        let mut tag = HashMap::<String, String>::new();
+        tag.insert(String::from("label"), String::from(label));
+        tag.insert(String::from("class"), String::from(class));
+        let res = serde_json::to_value(MetricsValue::new(value, tag))
+            .to_indy(IndyErrorKind::IOError, "Unable to convert json")?;
+
+        Ok(res)
+    }
+
     fn get_metric_json(&self, label: &str, value: usize) -> IndyResult<Value> {
         let mut tag = HashMap::<String, String>::new();
         tag.insert(String::from("label"), String::from(label));
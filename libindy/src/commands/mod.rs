@@ -24,9 +24,10 @@ use indy_api_types::errors::prelude::*;
 use crate::services::anoncreds::AnoncredsService;
 use crate::services::blob_storage::BlobStorageService;
 use crate::services::crypto::CryptoService;
+use crate::services::crypto::{box_key_cache, key_pool};
 use crate::services::ledger::LedgerService;
 use crate::services::payments::PaymentsService;
-use crate::services::pool::{PoolService, set_freshness_threshold};
+use crate::services::pool::{PoolService, set_freshness_threshold, set_io_threads_count};
 use crate::services::metrics::MetricsService;
 use crate::services::metrics::command_metrics::CommandMetric;
 use indy_wallet::WalletService;
@@ -46,6 +47,7 @@ pub mod non_secrets;
 pub mod payments;
 pub mod cache;
 pub mod metrics;
+pub mod queue;
 
 type BoxedCallbackStringStringSend = Box<dyn Fn(IndyResult<(String, String)>) + Send>;
 
@@ -67,21 +69,29 @@ pub enum Command {
 
 pub struct InstrumentedCommand {
     pub enqueue_ts: u128,
+    pub admitted_class: Option<usize>,
     pub command: Command
 }
 
 impl InstrumentedCommand {
-    pub fn new(command: Command) -> InstrumentedCommand {
+    pub fn new(command: Command, admitted_class: Option<usize>) -> InstrumentedCommand {
         InstrumentedCommand {
             enqueue_ts: get_cur_time(),
+            admitted_class,
             command
         }
     }
 }
 
 
+// Every ARGON2I_MOD derivation takes 256 MiB of memory, so parallel wallet opening is capped
+// even on hosts with many cores.
+const OPEN_WALLETS_MAX_THREADS: usize = 8;
+
 lazy_static! {
     static ref THREADPOOL: Mutex<ThreadPool> = Mutex::new(ThreadPool::new(4));
+    static ref OPEN_WALLETS_THREADPOOL: Mutex<ThreadPool> = Mutex::new(ThreadPool::new(
+        ::std::cmp::min(num_cpus::get(), OPEN_WALLETS_MAX_THREADS)));
 }
 
 pub fn indy_set_runtime_config(config: IndyConfig) {
@@ -96,6 +106,24 @@ pub fn indy_set_runtime_config(config: IndyConfig) {
     if let Some(threshold) = config.freshness_threshold {
         set_freshness_threshold(threshold);
     }
+    if let Some(open_wallets_thread_pool_size) = config.open_wallets_thread_pool_size {
+        OPEN_WALLETS_THREADPOOL.lock().unwrap().set_num_threads(open_wallets_thread_pool_size);
+    }
+    if let Some(depth) = config.key_pool_depth {
+        key_pool::set_depth(depth);
+    }
+    if let Some(size) = config.box_key_cache_size {
+        box_key_cache::set_size(size);
+    }
+    if let Some(pool_io_threads_count) = config.pool_io_threads_count {
+        set_io_threads_count(pool_io_threads_count);
+    }
+    if let Some(size) = config.command_queue_size {
+        queue::set_size(size);
+    }
+    if let Some(ref limits) = config.command_queue_class_limits {
+        queue::set_class_limits(limits);
+    }
 }
 
 fn get_cur_time() -> u128 {
@@ -158,6 +186,9 @@ impl CommandExecutor {
                             panic!("Failed to get command! {:?}", err)
                         }
                     };
+                    if let Some(class) = instrumented_cmd.admitted_class {
+                        queue::release(class);
+                    }
                     let cmd_index: CommandMetric = (&instrumented_cmd.command).into();
                     let start_execution_ts = get_cur_time();
                     metrics_service.cmd_left_queue(cmd_index,
@@ -224,9 +255,24 @@ impl CommandExecutor {
         }
     }
 
+    /// Sends the command of API call. Fails with `CommandQueueFull` if the queue limits are reached.
     pub fn send(&self, cmd: Command) -> IndyResult<()> {
+        let admitted_class = queue::admit(&cmd)?;
+
+        self.sender
+            .send(InstrumentedCommand::new(cmd, admitted_class))
+            .map_err(|err| {
+                if let Some(class) = admitted_class {
+                    queue::release(class);
+                }
+                err_msg(IndyErrorKind::InvalidState, format!("Can't send msg to CommandExecutor: {}", err))
+            })
+    }
+
+    /// Sends the command that continues already admitted work, it bypasses queue limits.
+    pub fn send_internal(&self, cmd: Command) -> IndyResult<()> {
         self.sender
-            .send(InstrumentedCommand::new(cmd))
+            .send(InstrumentedCommand::new(cmd, None))
             .map_err(|err| err_msg(IndyErrorKind::InvalidState, format!("Can't send msg to CommandExecutor: {}", err)))
     }
 }
@@ -234,7 +280,7 @@ impl CommandExecutor {
 impl Drop for CommandExecutor {
     fn drop(&mut self) {
         info!(target: "command_executor", "Drop started");
-        self.send(Command::Exit).unwrap();
+        self.send_internal(Command::Exit).unwrap();
         // Option worker type and this kludge is workaround for rust
         self.worker.take().unwrap().join().unwrap();
         info!(target: "command_executor", "Drop finished");
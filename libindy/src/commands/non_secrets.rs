@@ -40,6 +40,10 @@ pub enum NonSecretsCommand {
                  String, // type
                  String, // id
                  Box<dyn Fn(IndyResult<()>) + Send>),
+    DeleteRecords(WalletHandle,
+                  String, // type
+                  String, // query json
+                  Box<dyn Fn(IndyResult<usize>) + Send>),
     GetRecord(WalletHandle,
               String, // type
               String, // id
@@ -97,6 +101,10 @@ impl NonSecretsCommandExecutor {
                 debug!(target: "non_secrets_command_executor", "DeleteRecord command received");
                 cb(self.delete_record(handle, &type_, &id));
             }
+            NonSecretsCommand::DeleteRecords(handle, type_, query_json, cb) => {
+                debug!(target: "non_secrets_command_executor", "DeleteRecords command received");
+                cb(self.delete_records(handle, &type_, &query_json));
+            }
             NonSecretsCommand::GetRecord(handle, type_, id, options_json, cb) => {
                 debug!(target: "non_secrets_command_executor", "GetRecord command received");
                 cb(self.get_record(handle, &type_, &id, &options_json));
@@ -215,6 +223,21 @@ impl NonSecretsCommandExecutor {
         Ok(())
     }
 
+    fn delete_records(&self,
+                      wallet_handle: WalletHandle,
+                      type_: &str,
+                      query_json: &str) -> IndyResult<usize> {
+        trace!("delete_records >>> wallet_handle: {:?}, type_: {:?}, query_json: {:?}", wallet_handle, type_, query_json);
+
+        self._check_type(type_)?;
+
+        let res = self.wallet_service.delete_records(wallet_handle, type_, query_json)?;
+
+        trace!("delete_records <<< res: {:?}", res);
+
+        Ok(res)
+    }
+
     fn get_record(&self,
                   wallet_handle: WalletHandle,
                   type_: &str,
@@ -0,0 +1,235 @@
+//! Admission control for the command queue of `CommandExecutor`.
+//!
+//! Commands coming from API calls are counted while they wait in the queue, both in total and per
+//! command class (top-level `Command` variant). A command is rejected with `CommandQueueFull` right
+//! away if it would exceed the configured queue size or the limit of its class, so a burst of calls
+//! can't grow the queue without bound and slow down the work that was already admitted.
+//!
+//! Continuation commands sent by libindy itself, `Metrics` and `Exit` are never rejected: they
+//! belong to already admitted work or are needed to observe and stop the executor.
+//!
+//! Limits are disabled (0) until `command_queue_size` or `command_queue_class_limits` is set
+//! with `indy_set_runtime_config`.
+
+use std::collections::HashMap;
+use std::sync::Mutex;
+
+use indy_api_types::errors::prelude::*;
+
+use crate::commands::Command;
+
+const CLASSES_COUNT: usize = 11;
+
+pub const CLASSES: [&str; CLASSES_COUNT] = [
+    "anoncreds",
+    "blob_storage",
+    "crypto",
+    "ledger",
+    "pool",
+    "did",
+    "wallet",
+    "pairwise",
+    "non_secrets",
+    "payments",
+    "cache",
+];
+
+lazy_static! {
+    static ref COMMAND_QUEUE: Mutex<CommandQueue> = Mutex::new(CommandQueue::new());
+}
+
+struct CommandQueue {
+    size: usize,
+    class_limits: [usize; CLASSES_COUNT],
+    depth: usize,
+    class_depths: [usize; CLASSES_COUNT],
+    class_rejected: [usize; CLASSES_COUNT],
+}
+
+impl CommandQueue {
+    fn new() -> CommandQueue {
+        CommandQueue {
+            size: 0,
+            class_limits: [0; CLASSES_COUNT],
+            depth: 0,
+            class_depths: [0; CLASSES_COUNT],
+            class_rejected: [0; CLASSES_COUNT],
+        }
+    }
+}
+
+/// Snapshot of the queue state reported by `indy_collect_metrics`.
+pub struct QueueStats {
+    pub size: usize,
+    pub depth: usize,
+    pub classes: Vec<ClassStats>,
+}
+
+pub struct ClassStats {
+    pub name: &'static str,
+    pub limit: usize,
+    pub depth: usize,
+    pub rejected: usize,
+}
+
+/// Sets max number of API commands waiting in the queue. 0 disables the limit.
+pub fn set_size(size: usize) {
+    COMMAND_QUEUE.lock().unwrap().size = size;
+}
+
+/// Sets max number of waiting API commands per class. Classes that are not listed keep their limits.
+pub fn set_class_limits(limits: &HashMap<String, usize>) {
+    let mut queue = COMMAND_QUEUE.lock().unwrap();
+
+    for (class, limit) in limits {
+        if let Some(index) = class_index(class) {
+            queue.class_limits[index] = *limit;
+        }
+    }
+}
+
+pub fn validate_class_limits(limits: &HashMap<String, usize>) -> Result<(), String> {
+    match limits.keys().find(|class| class_index(class).is_none()) {
+        Some(class) => Err(format!("Unknown command class: {}. Expected one of: {}", class, CLASSES.join(", "))),
+        None => Ok(())
+    }
+}
+
+/// Reserves a place in the queue for the command sent by API call.
+///
+/// Returns the class the place was taken in, it must be released by `release` when the command
+/// leaves the queue. `None` means the command isn't subject to admission control.
+pub fn admit(cmd: &Command) -> IndyResult<Option<usize>> {
+    let index = match command_class(cmd) {
+        Some(index) => index,
+        None => return Ok(None)
+    };
+
+    let mut queue = COMMAND_QUEUE.lock().unwrap();
+
+    if queue.size != 0 && queue.depth >= queue.size {
+        queue.class_rejected[index] += 1;
+        return Err(err_msg(IndyErrorKind::CommandQueueFull,
+                           format!("Command queue is full: {} commands are waiting", queue.depth)));
+    }
+
+    let class_limit = queue.class_limits[index];
+
+    if class_limit != 0 && queue.class_depths[index] >= class_limit {
+        queue.class_rejected[index] += 1;
+        return Err(err_msg(IndyErrorKind::CommandQueueFull,
+                           format!("Command queue is full for class {}: {} commands are waiting", CLASSES[index], class_limit)));
+    }
+
+    queue.depth += 1;
+    queue.class_depths[index] += 1;
+
+    Ok(Some(index))
+}
+
+/// Frees the place taken by `admit`.
+pub fn release(index: usize) {
+    let mut queue = COMMAND_QUEUE.lock().unwrap();
+
+    queue.depth -= 1;
+    queue.class_depths[index] -= 1;
+}
+
+pub fn stats() -> QueueStats {
+    let queue = COMMAND_QUEUE.lock().unwrap();
+
+    QueueStats {
+        size: queue.size,
+        depth: queue.depth,
+        classes: CLASSES.iter().enumerate()
+            .map(|(index, name)| ClassStats {
+                name,
+                limit: queue.class_limits[index],
+                depth: queue.class_depths[index],
+                rejected: queue.class_rejected[index],
+            })
+            .collect(),
+    }
+}
+
+fn class_index(class: &str) -> Option<usize> {
+    CLASSES.iter().position(|name| *name == class)
+}
+
+fn command_class(cmd: &Command) -> Option<usize> {
+    let class = match cmd {
+        Command::Anoncreds(_) => "anoncreds",
+        Command::BlobStorage(_) => "blob_storage",
+        Command::Crypto(_) => "crypto",
+        Command::Ledger(_) => "ledger",
+        Command::Pool(_) => "pool",
+        Command::Did(_) => "did",
+        Command::Wallet(_) => "wallet",
+        Command::Pairwise(_) => "pairwise",
+        Command::NonSecrets(_) => "non_secrets",
+        Command::Payments(_) => "payments",
+        Command::Cache(_) => "cache",
+        Command::Metrics(_) | Command::Exit => return None
+    };
+
+    class_index(class)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use crate::commands::metrics::MetricsCommand;
+    use crate::commands::pairwise::PairwiseCommand;
+    use indy_api_types::WalletHandle;
+
+    // Tests share the global queue state, so all checks live in one test.
+    #[test]
+    fn admission_control_works() {
+        let pairwise = || Command::Pairwise(PairwiseCommand::ListPairwise(WalletHandle(1), Box::new(|_| ())));
+        let metrics = || Command::Metrics(MetricsCommand::CollectMetrics(Box::new(|_| ())));
+
+        set_size(2);
+
+        let first = admit(&pairwise()).unwrap().unwrap();
+        let second = admit(&pairwise()).unwrap().unwrap();
+
+        let err = admit(&pairwise()).unwrap_err();
+        assert_eq!(IndyErrorKind::CommandQueueFull, err.kind());
+
+        assert_eq!(None, admit(&metrics()).unwrap());
+
+        let stats = stats();
+        assert_eq!(2, stats.depth);
+        let class = stats.classes.iter().find(|class| class.name == "pairwise").unwrap();
+        assert_eq!(2, class.depth);
+        assert_eq!(1, class.rejected);
+
+        release(first);
+        release(second);
+        set_size(0);
+
+        let mut limits = HashMap::new();
+        limits.insert("pairwise".to_string(), 1);
+        set_class_limits(&limits);
+
+        let first = admit(&pairwise()).unwrap().unwrap();
+        assert_eq!(IndyErrorKind::CommandQueueFull, admit(&pairwise()).unwrap_err().kind());
+        release(first);
+
+        limits.insert("pairwise".to_string(), 0);
+        set_class_limits(&limits);
+
+        assert_eq!(0, super::stats().depth);
+    }
+
+    #[test]
+    fn validate_class_limits_works() {
+        let mut limits = HashMap::new();
+        limits.insert("wallet".to_string(), 10);
+        assert!(validate_class_limits(&limits).is_ok());
+
+        limits.insert("unknown".to_string(), 10);
+        assert!(validate_class_limits(&limits).is_err());
+    }
+}
@@ -1,16 +1,17 @@
 use std::cell::RefCell;
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::rc::Rc;
 
 use indy_api_types::wallet::*;
 use crate::commands::{Command, CommandExecutor};
-use indy_api_types::domain::wallet::{Config, Credentials, ExportConfig, KeyConfig};
+use indy_api_types::domain::wallet::{CompactConfig, Config, Credentials, ExportConfig, KeyConfig, OpenWalletParams};
 use indy_api_types::errors::prelude::*;
 use crate::services::crypto::CryptoService;
+use crate::services::crypto::{box_key_cache, key_pool};
 use indy_wallet::{KeyDerivationData, WalletService, Metadata};
 use indy_utils::crypto::{chacha20poly1305_ietf, randombytes};
 use indy_utils::crypto::chacha20poly1305_ietf::Key as MasterKey;
-use indy_api_types::{WalletHandle, CallbackHandle};
+use indy_api_types::{WalletHandle, CallbackHandle, ErrorCode};
 use rust_base58::ToBase58;
 
 type DeriveKeyResult<T> = IndyResult<T>;
@@ -42,6 +43,12 @@ pub enum WalletCommand {
                        WalletFetchSearchNextRecord, // fetch search next record
                        WalletFreeSearch, // free search
                        Box<dyn Fn(IndyResult<()>) + Send>),
+    RegisterWalletTypeAddRecords(String, // type_
+                                 WalletAddRecords, // add records
+                                 Box<dyn Fn(IndyResult<()>) + Send>),
+    RegisterWalletTypeDeleteRecords(String, // type_
+                                    WalletDeleteRecords, // delete records
+                                    Box<dyn Fn(IndyResult<()>) + Send>),
     Create(Config, // config
            Credentials, // credentials
            Box<dyn Fn(IndyResult<()>) + Send>),
@@ -56,6 +63,13 @@ pub enum WalletCommand {
     OpenContinue(WalletHandle,
                  DeriveKeyResult<(MasterKey, Option<MasterKey>)>, // derive_key_result
     ),
+    OpenMany(Vec<OpenWalletParams>,
+             Box<dyn Fn(IndyResult<String>) + Send>),
+    OpenManyContinue(CallbackHandle,
+                     usize, // index of the wallet in request
+                     WalletHandle,
+                     DeriveKeyResult<(MasterKey, Option<MasterKey>)>, // derive_key_result
+    ),
     Close(WalletHandle,
           Box<dyn Fn(IndyResult<()>) + Send>),
     Delete(Config, // config
@@ -84,6 +98,9 @@ pub enum WalletCommand {
                    WalletHandle,
                    CallbackHandle
     ),
+    Compact(WalletHandle,
+            Option<CompactConfig>, // compact config
+            Box<dyn Fn(IndyResult<String>) + Send>),
     GenerateKey(Option<KeyConfig>, // config
                 Box<dyn Fn(IndyResult<String>) + Send>),
     DeriveKey(KeyDerivationData,
@@ -97,10 +114,17 @@ macro_rules! get_cb {
     });
 }
 
+struct PendingOpenMany {
+    results: Vec<Option<IndyResult<WalletHandle>>>,
+    pending: usize,
+    cb: Box<dyn Fn(IndyResult<String>) + Send>,
+}
+
 pub struct WalletCommandExecutor {
     wallet_service: Rc<WalletService>,
     crypto_service: Rc<CryptoService>,
     open_callbacks: RefCell<HashMap<WalletHandle, Box<dyn Fn(IndyResult<WalletHandle>) + Send>>>,
+    open_many_pending: RefCell<HashMap<CallbackHandle, PendingOpenMany>>,
     pending_callbacks: RefCell<HashMap<CallbackHandle, Box<dyn Fn(IndyResult<()>) + Send>>>
 }
 
@@ -110,6 +134,7 @@ impl WalletCommandExecutor {
             wallet_service,
             crypto_service,
             open_callbacks: RefCell::new(HashMap::new()),
+            open_many_pending: RefCell::new(HashMap::new()),
             pending_callbacks: RefCell::new(HashMap::new())
         }
     }
@@ -130,6 +155,14 @@ impl WalletCommandExecutor {
                                        free_storage_metadata, search_records, search_all_records, get_search_total_count,
                                        fetch_search_next_record, free_search));
             }
+            WalletCommand::RegisterWalletTypeAddRecords(type_, add_records, cb) => {
+                debug!(target: "wallet_command_executor", "RegisterWalletTypeAddRecords command received");
+                cb(self._register_type_add_records(&type_, add_records));
+            }
+            WalletCommand::RegisterWalletTypeDeleteRecords(type_, delete_records, cb) => {
+                debug!(target: "wallet_command_executor", "RegisterWalletTypeDeleteRecords command received");
+                cb(self._register_type_delete_records(&type_, delete_records));
+            }
             WalletCommand::Create(config, credentials, cb) => {
                 debug!(target: "wallet_command_executor", "Create command received");
                 self._create(&config, &credentials, cb)
@@ -146,6 +179,14 @@ impl WalletCommandExecutor {
                 debug!(target: "wallet_command_executor", "OpenContinue command received");
                 self._open_continue(wallet_handle, key_result)
             }
+            WalletCommand::OpenMany(params, cb) => {
+                debug!(target: "wallet_command_executor", "OpenMany command received");
+                self._open_many(params, cb);
+            }
+            WalletCommand::OpenManyContinue(cb_id, index, wallet_handle, key_result) => {
+                debug!(target: "wallet_command_executor", "OpenManyContinue command received");
+                self._open_many_continue(cb_id, index, wallet_handle, key_result)
+            }
             WalletCommand::Close(handle, cb) => {
                 debug!(target: "wallet_command_executor", "Close command received");
                 cb(self._close(handle));
@@ -174,6 +215,10 @@ impl WalletCommandExecutor {
                 debug!(target: "wallet_command_executor", "ImportContinue command received");
                 self._import_continue(cb_id, wallet_handle, &config, &credential, key_result);
             }
+            WalletCommand::Compact(wallet_handle, config, cb) => {
+                debug!(target: "wallet_command_executor", "Compact command received");
+                cb(self._compact(wallet_handle, config.unwrap_or_default()));
+            }
             WalletCommand::GenerateKey(config, cb) => {
                 debug!(target: "wallet_command_executor", "DeriveKey command received");
                 cb(self._generate_key(config.as_ref()));
@@ -226,6 +271,24 @@ impl WalletCommandExecutor {
         Ok(())
     }
 
+    fn _register_type_add_records(&self, type_: &str, add_records: WalletAddRecords) -> IndyResult<()> {
+        trace!("_register_type_add_records >>> type_: {:?}", type_);
+
+        self.wallet_service.register_wallet_storage_add_records(type_, add_records)?;
+
+        trace!("_register_type_add_records <<< res: ()");
+        Ok(())
+    }
+
+    fn _register_type_delete_records(&self, type_: &str, delete_records: WalletDeleteRecords) -> IndyResult<()> {
+        trace!("_register_type_delete_records >>> type_: {:?}", type_);
+
+        self.wallet_service.register_wallet_storage_delete_records(type_, delete_records)?;
+
+        trace!("_register_type_delete_records <<< res: ()");
+        Ok(())
+    }
+
     fn _create(&self,
                config: &Config,
                credentials: &Credentials,
@@ -240,11 +303,11 @@ impl WalletCommandExecutor {
         let config = config.clone();
         let credentials = credentials.clone();
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 key_data.clone(),
                 Box::new(move |master_key_res| {
-                    CommandExecutor::instance().send(
+                    CommandExecutor::instance().send_internal(
                         Command::Wallet(
                             WalletCommand::CreateContinue(
                                 config.clone(),
@@ -280,7 +343,7 @@ impl WalletCommandExecutor {
 
         self.open_callbacks.borrow_mut().insert(wallet_handle, cb);
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 key_derivation_data,
                 Box::new(move |key_result| {
@@ -303,7 +366,7 @@ impl WalletCommandExecutor {
     }
 
     fn _derive_rekey_and_continue(wallet_handle: WalletHandle, key_result: MasterKey, rekey_data: KeyDerivationData) {
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 rekey_data,
                 Box::new(move |rekey_result| {
@@ -316,7 +379,7 @@ impl WalletCommandExecutor {
     }
 
     fn _send_open_continue(wallet_handle: WalletHandle, key_result: DeriveKeyResult<(MasterKey, Option<MasterKey>)>) {
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::OpenContinue(
                 wallet_handle,
                 key_result,
@@ -328,8 +391,123 @@ impl WalletCommandExecutor {
                       wallet_handle: WalletHandle,
                       key_result: DeriveKeyResult<(MasterKey, Option<MasterKey>)>) {
         let cb = self.open_callbacks.borrow_mut().remove(&wallet_handle).unwrap();
-        cb(key_result
-            .and_then(|(key, rekey)| self.wallet_service.open_wallet_continue(wallet_handle, (&key, rekey.as_ref()))))
+
+        let res = key_result
+            .and_then(|(key, rekey)| self.wallet_service.open_wallet_continue(wallet_handle, (&key, rekey.as_ref())));
+
+        if let Ok(wallet_handle) = res {
+            key_pool::add(wallet_handle);
+            box_key_cache::add(wallet_handle);
+        }
+
+        cb(res)
+    }
+
+    fn _open_many(&self,
+                  params: Vec<OpenWalletParams>,
+                  cb: Box<dyn Fn(IndyResult<String>) + Send>) {
+        trace!("_open_many >>> wallets: {:?}", params.len());
+
+        let cb_id: CallbackHandle = indy_utils::sequence::get_next_id();
+
+        let mut results = Vec::with_capacity(params.len());
+        let mut pending = 0;
+        let mut ids = HashSet::new();
+
+        for (index, OpenWalletParams { config, credentials }) in params.into_iter().enumerate() {
+            if !ids.insert(config.id.clone()) {
+                results.push(Some(Err(err_msg(IndyErrorKind::WalletAlreadyOpened,
+                                              format!("Wallet {} is listed more than once", config.id)))));
+                continue;
+            }
+
+            // Storage is opened and metadata is read here, only key derivation goes to the thread pool
+            match self.wallet_service.open_wallet_prepare(&config, &credentials) {
+                Ok((wallet_handle, key_derivation_data, rekey_data)) => {
+                    results.push(None);
+                    pending += 1;
+
+                    crate::commands::OPEN_WALLETS_THREADPOOL.lock().unwrap().execute(move || {
+                        let key_result = key_derivation_data.calc_master_key()
+                            .and_then(|key| match rekey_data {
+                                Some(rekey_data) => rekey_data.calc_master_key().map(|rekey| (key, Some(rekey))),
+                                None => Ok((key, None))
+                            });
+
+                        CommandExecutor::instance().send_internal(
+                            Command::Wallet(WalletCommand::OpenManyContinue(cb_id, index, wallet_handle, key_result))
+                        ).unwrap();
+                    });
+                }
+                Err(err) => results.push(Some(Err(err)))
+            }
+        }
+
+        let pending_open = PendingOpenMany { results, pending, cb };
+
+        if pending_open.pending == 0 {
+            WalletCommandExecutor::_open_many_finish(pending_open);
+        } else {
+            self.open_many_pending.borrow_mut().insert(cb_id, pending_open);
+        }
+
+        trace!("_open_many <<<");
+    }
+
+    fn _open_many_continue(&self,
+                           cb_id: CallbackHandle,
+                           index: usize,
+                           wallet_handle: WalletHandle,
+                           key_result: DeriveKeyResult<(MasterKey, Option<MasterKey>)>) {
+        let res = match key_result {
+            Ok((key, rekey)) => self.wallet_service.open_wallet_continue(wallet_handle, (&key, rekey.as_ref())),
+            Err(err) => {
+                self.wallet_service.open_wallet_cancel(wallet_handle);
+                Err(err)
+            }
+        };
+
+        if let Ok(wallet_handle) = res {
+            key_pool::add(wallet_handle);
+            box_key_cache::add(wallet_handle);
+        }
+
+        let mut open_many_pending = self.open_many_pending.borrow_mut();
+
+        let finished = match open_many_pending.get_mut(&cb_id) {
+            Some(pending_open) => {
+                pending_open.results[index] = Some(res);
+                pending_open.pending -= 1;
+                pending_open.pending == 0
+            }
+            None => return error!("No pending command for id: {}", cb_id)
+        };
+
+        if finished {
+            let pending_open = open_many_pending.remove(&cb_id).unwrap();
+            drop(open_many_pending);
+            WalletCommandExecutor::_open_many_finish(pending_open);
+        }
+    }
+
+    fn _open_many_finish(pending_open: PendingOpenMany) {
+        let results: Vec<serde_json::Value> = pending_open.results
+            .into_iter()
+            .map(|res| match res.unwrap() {
+                Ok(wallet_handle) => json!({ "wallet_handle": wallet_handle }),
+                Err(err) => json!({
+                    "error_code": ErrorCode::from(err.kind()) as i32,
+                    "message": err.to_string(),
+                }),
+            })
+            .collect();
+
+        let res = serde_json::to_string(&results)
+            .to_indy(IndyErrorKind::InvalidState, "Cannot serialize open wallets results");
+
+        trace!("_open_many_finish <<< res: {:?}", res);
+
+        (pending_open.cb)(res)
     }
 
     fn _close(&self,
@@ -337,6 +515,8 @@ impl WalletCommandExecutor {
         trace!("_close >>> handle: {:?}", wallet_handle);
 
         self.wallet_service.close_wallet(wallet_handle)?;
+        key_pool::remove(wallet_handle);
+        box_key_cache::remove(wallet_handle);
 
         trace!("_close <<< res: ()");
         Ok(())
@@ -356,12 +536,12 @@ impl WalletCommandExecutor {
         let config = config.clone();
         let credentials = credentials.clone();
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 key_derivation_data,
                 Box::new(move |key_result| {
                     let key_result = key_result.clone();
-                    CommandExecutor::instance().send(
+                    CommandExecutor::instance().send_internal(
                         Command::Wallet(WalletCommand::DeleteContinue(
                             config.clone(),
                             credentials.clone(),
@@ -393,18 +573,18 @@ impl WalletCommandExecutor {
                cb: Box<dyn Fn(IndyResult<()>) + Send>) {
         trace!("_export >>> handle: {:?}, export_config: {:?}", wallet_handle, secret!(export_config));
 
-        let key_data = KeyDerivationData::from_passphrase_with_new_salt(&export_config.key, &export_config.key_derivation_method);
+        let key_data = try_cb!(self.wallet_service.export_key_derivation_data(export_config), cb);
 
         let cb_id = indy_utils::sequence::get_next_id();
         self.pending_callbacks.borrow_mut().insert(cb_id, cb);
 
         let export_config = export_config.clone();
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 key_data.clone(),
                 Box::new(move |master_key_res| {
-                    CommandExecutor::instance().send(Command::Wallet(WalletCommand::ExportContinue(
+                    CommandExecutor::instance().send_internal(Command::Wallet(WalletCommand::ExportContinue(
                         wallet_handle,
                         export_config.clone(),
                         key_data.clone(),
@@ -445,19 +625,19 @@ impl WalletCommandExecutor {
         let config = config.clone();
         let credentials = credentials.clone();
 
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Wallet(WalletCommand::DeriveKey(
                 import_key_data,
                 Box::new(move |import_key_result| {
                     let config = config.clone();
                     let credentials = credentials.clone();
 
-                    CommandExecutor::instance().send(
+                    CommandExecutor::instance().send_internal(
                         Command::Wallet(WalletCommand::DeriveKey(
                             key_data.clone(),
                             Box::new(move |key_result| {
                                 let import_key_result = import_key_result.clone();
-                                CommandExecutor::instance().send(Command::Wallet(WalletCommand::ImportContinue(
+                                CommandExecutor::instance().send_internal(Command::Wallet(WalletCommand::ImportContinue(
                                     config.clone(),
                                     credentials.clone(),
                                     import_key_result.and_then(|import_key| key_result.map(|key| (import_key, key))),
@@ -485,6 +665,20 @@ impl WalletCommandExecutor {
             .and_then(|key| self.wallet_service.import_wallet_continue(wallet_handle, &config, &credential, key)))
     }
 
+    fn _compact(&self,
+                wallet_handle: WalletHandle,
+                config: CompactConfig) -> IndyResult<String> {
+        trace!("_compact >>> wallet_handle: {:?}, config: {:?}", wallet_handle, config);
+
+        let progress = self.wallet_service.compact_wallet(wallet_handle, config.max_pages)?;
+
+        let res = serde_json::to_string(&progress)
+            .to_indy(IndyErrorKind::InvalidState, "Cannot serialize compaction progress")?;
+
+        trace!("_compact <<< res: {:?}", res);
+        Ok(res)
+    }
+
     fn _generate_key(&self,
                      config: Option<&KeyConfig>) -> IndyResult<String> {
         trace!("_generate_key >>>config: {:?}", secret!(config));
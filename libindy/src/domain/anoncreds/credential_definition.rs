@@ -76,6 +76,21 @@ pub struct TemporaryCredentialDefinition {
     pub cred_def_correctness_proof: CredentialDefinitionCorrectnessProof
 }
 
+#[derive(Debug, Serialize, Deserialize, Clone)]
+pub struct CredentialDefinitionKeyPoolConfig {
+    #[serde(default)]
+    pub support_revocation: bool,
+    pub size: u32
+}
+
+/// Pre-generated keys kept in the wallet until they are consumed by exactly one credential definition.
+#[derive(Debug, Serialize, Deserialize)]
+pub struct CredentialDefinitionKeys {
+    pub value: CredentialDefinitionData,
+    pub cred_def_priv_key: CredentialDefinitionPrivateKey,
+    pub cred_def_correctness_proof: CredentialDefinitionCorrectnessProof
+}
+
 impl CredentialDefinition {
     pub fn to_unqualified(self) -> CredentialDefinition {
         match self {
@@ -242,6 +257,15 @@ impl Validatable for CredentialDefinitionId {
 
 impl Validatable for CredentialDefinitionConfig {}
 
+impl Validatable for CredentialDefinitionKeyPoolConfig {
+    fn validate(&self) -> Result<(), String> {
+        if self.size == 0 {
+            return Err(String::from("CredentialDefinitionKeyPoolConfig validation failed: `size` must be greater than 0"));
+        }
+        Ok(())
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -73,6 +73,17 @@ impl<T: serde::Serialize> Request<T> {
     }
 
     pub fn build_request(identifier: Option<&DidValue>, operation: T) -> Result<String, String> {
+        serde_json::to_string(&Request::_build(identifier, operation))
+            .map_err(|err| format!("Cannot serialize Request: {:?}", err))
+    }
+
+    /// Builds request as json value that can be signed and serialized later without re-parsing.
+    pub fn build_request_value(identifier: Option<&DidValue>, operation: T) -> Result<serde_json::Value, String> {
+        serde_json::to_value(&Request::_build(identifier, operation))
+            .map_err(|err| format!("Cannot serialize Request: {:?}", err))
+    }
+
+    fn _build(identifier: Option<&DidValue>, operation: T) -> Request<T> {
         let req_id = get_req_id();
 
         let identifier = match identifier {
@@ -80,7 +91,6 @@ impl<T: serde::Serialize> Request<T> {
             None => ShortDidValue(DEFAULT_LIBIDY_DID.to_string())
         };
 
-        serde_json::to_string(&Request::new(req_id, identifier, operation, ProtocolVersion::get()))
-            .map_err(|err| format!("Cannot serialize Request: {:?}", err))
+        Request::new(req_id, identifier, operation, ProtocolVersion::get())
     }
 }
\ No newline at end of file
@@ -23,7 +23,8 @@ impl GetTxnOperation {
 pub enum LedgerType {
     POOL = 0,
     DOMAIN = 1,
-    CONFIG = 2
+    CONFIG = 2,
+    AUDIT = 3
 }
 
 impl LedgerType {
@@ -32,6 +33,7 @@ impl LedgerType {
             LedgerType::POOL => LedgerType::POOL as i32,
             LedgerType::DOMAIN => LedgerType::DOMAIN as i32,
             LedgerType::CONFIG => LedgerType::CONFIG as i32,
+            LedgerType::AUDIT => LedgerType::AUDIT as i32,
         }
     }
 }
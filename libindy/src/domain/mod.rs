@@ -5,13 +5,30 @@ pub mod pairwise;
 pub mod pool;
 pub mod cache;
 
+use std::collections::HashMap;
+
 use indy_api_types::validation::Validatable;
 
+use crate::commands::queue;
+
 #[derive(Debug, Serialize, Deserialize)]
 pub struct IndyConfig {
     pub crypto_thread_pool_size: Option<usize>,
     pub collect_backtrace: Option<bool>,
-    pub freshness_threshold: Option<u64>
+    pub freshness_threshold: Option<u64>,
+    pub key_pool_depth: Option<usize>,
+    pub box_key_cache_size: Option<usize>,
+    pub open_wallets_thread_pool_size: Option<usize>,
+    pub pool_io_threads_count: Option<usize>,
+    pub command_queue_size: Option<usize>,
+    pub command_queue_class_limits: Option<HashMap<String, usize>>,
 }
 
-impl Validatable for IndyConfig {}
\ No newline at end of file
+impl Validatable for IndyConfig {
+    fn validate(&self) -> Result<(), String> {
+        if let Some(ref limits) = self.command_queue_class_limits {
+            queue::validate_class_limits(limits)?;
+        }
+        Ok(())
+    }
+}
\ No newline at end of file
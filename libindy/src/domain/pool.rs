@@ -1,6 +1,7 @@
 use indy_api_types::validation::Validatable;
 
 pub const POOL_CON_ACTIVE_TO: i64 = 5;
+pub const POOL_CON_IDLE_TO: i64 = 10;
 pub const POOL_ACK_TIMEOUT: i64 = 20;
 pub const POOL_REPLY_TIMEOUT: i64 = 60;
 pub const MAX_REQ_PER_POOL_CON: usize = 5;
@@ -29,6 +30,8 @@ pub struct PoolOpenConfig {
     pub conn_limit: usize,
     #[serde(default = "PoolOpenConfig::default_conn_active_timeout")]
     pub conn_active_timeout: i64,
+    #[serde(default = "PoolOpenConfig::default_conn_idle_timeout")]
+    pub conn_idle_timeout: i64,
     #[serde(default = "PoolOpenConfig::default_preordered_nodes")]
     pub preordered_nodes: Vec<String>,
     #[serde(default = "PoolOpenConfig::default_number_read_nodes")]
@@ -51,6 +54,9 @@ impl Validatable for PoolOpenConfig {
         if self.conn_active_timeout <= 0 {
             return Err(String::from("`conn_active_timeout` must be greater than 0"));
         }
+        if self.conn_idle_timeout < 0 {
+            return Err(String::from("`conn_idle_timeout` must not be negative"));
+        }
         if self.number_read_nodes == 0 {
             return Err(String::from("`number_read_nodes` must be greater than 0"));
         }
@@ -65,6 +71,7 @@ impl Default for PoolOpenConfig {
             extended_timeout: PoolOpenConfig::default_extended_timeout(),
             conn_limit: PoolOpenConfig::default_conn_limit(),
             conn_active_timeout: PoolOpenConfig::default_conn_active_timeout(),
+            conn_idle_timeout: PoolOpenConfig::default_conn_idle_timeout(),
             preordered_nodes: PoolOpenConfig::default_preordered_nodes(),
             number_read_nodes: PoolOpenConfig::default_number_read_nodes(),
             socks_proxy: PoolOpenConfig::default_socks_proxy(),
@@ -89,6 +96,10 @@ impl PoolOpenConfig {
         POOL_CON_ACTIVE_TO
     }
 
+    fn default_conn_idle_timeout() -> i64 {
+        POOL_CON_IDLE_TO
+    }
+
     fn default_preordered_nodes() -> Vec<String> {
         Vec::new()
     }
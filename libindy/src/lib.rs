@@ -29,6 +29,7 @@ extern crate lazy_static;
 extern crate ursa;
 extern crate rlp;
 extern crate time;
+extern crate num_cpus;
 extern crate libc;
 extern crate rand;
 extern crate uuid;
@@ -1,22 +1,28 @@
 use std::fs;
 use std::fs::File;
-use std::io::Write;
+use std::io::{BufWriter, Write};
 use std::path::PathBuf;
 
 use serde_json;
+use sha2::Sha256;
+use sha2::digest::{FixedOutput, Update};
 
 use indy_api_types::errors::prelude::*;
-use crate::utils::environment;
 
 use super::{WritableBlob, Writer, WriterType};
 
 use rust_base58::ToBase58;
 
+// Tails are appended one by one, so writes are collected into large sequential chunks.
+const WRITE_BUFFER_SIZE: usize = 1024 * 1024;
+
 #[allow(dead_code)]
 pub struct DefaultWriter {
     base_dir: PathBuf,
     uri_pattern: String,
-    file: File,
+    file: BufWriter<File>,
+    hasher: Sha256,
+    fsync: bool,
     id: i32,
 }
 
@@ -24,6 +30,9 @@ pub struct DefaultWriter {
 struct DefaultWriterConfig {
     base_dir: String,
     uri_pattern: String,
+    /// Sync blob content to disk before it is moved to the final location and the directory after the move (true by default)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    fsync: Option<bool>,
 }
 
 impl WriterType for DefaultWriterType {
@@ -41,15 +50,18 @@ impl Writer for DefaultWriterConfig {
 
         fs::DirBuilder::new()
             .recursive(true)
-            .create(tmp_storage_file(id).parent().unwrap())?;
+            .create(&path)
+            .map_err(map_err_trace!(format!("path: {:?}", path)))?;
 
-        let file = File::create(tmp_storage_file(id))
+        let file = File::create(tmp_storage_file(&path, id))
             .map_err(map_err_trace!())?;
 
         Ok(Box::new(DefaultWriter {
             base_dir: path,
             uri_pattern: self.uri_pattern.clone(),
-            file,
+            file: BufWriter::with_capacity(WRITE_BUFFER_SIZE, file),
+            hasher: Sha256::default(),
+            fsync: self.fsync.unwrap_or(true),
             id,
         }))
     }
@@ -59,42 +71,75 @@ impl WritableBlob for DefaultWriter {
     fn append(&mut self, bytes: &[u8]) -> IndyResult<usize> {
         trace!("append >>>");
 
-        let res = self.file.write(bytes)
+        self.file.write_all(bytes)
             .map_err(map_err_trace!())?;
 
+        self.hasher.update(bytes);
+
+        let res = bytes.len();
+
         trace!("append <<< {}", res);
         Ok(res)
     }
 
-    fn finalize(&mut self, hash: &[u8]) -> IndyResult<String> {
+    fn finalize(&mut self) -> IndyResult<(String, Vec<u8>)> {
         trace!("finalize >>>");
 
         self.file.flush().map_err(map_err_trace!())?;
-        self.file.sync_all().map_err(map_err_trace!())?;
+
+        if self.fsync {
+            self.file.get_ref().sync_all().map_err(map_err_trace!())?;
+        }
+
+        let hash = ::std::mem::replace(&mut self.hasher, Sha256::default()).finalize_fixed().to_vec();
 
         let mut path = self.base_dir.clone();
         path.push(hash.to_base58());
 
-        fs::DirBuilder::new()
-            .recursive(true)
-            .create(path.parent().unwrap())
+        // temporary file lives in the same directory, so the rename is atomic
+        fs::rename(&tmp_storage_file(&self.base_dir, self.id), &path)
             .map_err(map_err_trace!(format!("path: {:?}", path)))?;
 
-        fs::copy(&tmp_storage_file(self.id), &path)
-            .map_err(map_err_trace!())?; //FIXME
-
-        fs::remove_file(&tmp_storage_file(self.id))
-            .map_err(map_err_trace!())?;
+        if self.fsync {
+            sync_dir(&self.base_dir)?;
+        }
 
         let res = path.to_str().unwrap().to_owned();
 
         trace!("finalize <<< {}", res);
-        Ok(res)
+        Ok((res, hash))
     }
 }
 
-fn tmp_storage_file(id: i32) -> PathBuf {
-    environment::tmp_file_path(&format!("def_storage_tmp_{}", id))
+impl Drop for DefaultWriter {
+    fn drop(&mut self) {
+        // Blob was not finalized, don't leave partial content behind
+        let tmp_path = tmp_storage_file(&self.base_dir, self.id);
+        if tmp_path.exists() {
+            let _ = fs::remove_file(&tmp_path);
+        }
+    }
+}
+
+// Renamed entry is durable only when the directory itself is synced
+#[cfg(unix)]
+fn sync_dir(path: &PathBuf) -> IndyResult<()> {
+    let dir = File::open(path)
+        .map_err(map_err_trace!(format!("path: {:?}", path)))?;
+
+    dir.sync_all().map_err(map_err_trace!())?;
+
+    Ok(())
+}
+
+// Directories can't be opened as files on Windows, NTFS journals renames itself
+#[cfg(not(unix))]
+fn sync_dir(_dir: &PathBuf) -> IndyResult<()> {
+    Ok(())
+}
+
+fn tmp_storage_file(base_dir: &PathBuf, id: i32) -> PathBuf {
+    base_dir.join(format!(".def_storage_tmp_{}", id))
 }
 
 pub struct DefaultWriterType {}
@@ -104,3 +149,60 @@ impl DefaultWriterType {
         DefaultWriterType {}
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use indy_utils::environment;
+
+    fn _writer(base_dir: &PathBuf, id: i32) -> Box<dyn WritableBlob> {
+        let config = json!({
+            "base_dir": base_dir.to_str().unwrap(),
+            "uri_pattern": "",
+        }).to_string();
+
+        DefaultWriterType::new().open(&config).unwrap().create(id).unwrap()
+    }
+
+    #[test]
+    fn default_writer_hashes_while_writing() {
+        let base_dir = environment::tmp_path().join("default_writer_hashes_while_writing");
+        let _ = fs::remove_dir_all(&base_dir);
+
+        let mut writer = _writer(&base_dir, 1);
+
+        let chunk = vec![7u8; 1000];
+        let mut expected = Sha256::default();
+
+        for _ in 0..3000 {
+            assert_eq!(chunk.len(), writer.append(&chunk).unwrap());
+            expected.update(&chunk);
+        }
+
+        let (location, hash) = writer.finalize().unwrap();
+
+        assert_eq!(expected.finalize_fixed().to_vec(), hash);
+        assert_eq!(base_dir.join(hash.to_base58()), PathBuf::from(&location));
+        assert_eq!(3_000_000, fs::metadata(&location).unwrap().len());
+        assert!(!tmp_storage_file(&base_dir, 1).exists());
+
+        fs::remove_dir_all(&base_dir).unwrap();
+    }
+
+    #[test]
+    fn default_writer_removes_unfinalized_blob() {
+        let base_dir = environment::tmp_path().join("default_writer_removes_unfinalized_blob");
+        let _ = fs::remove_dir_all(&base_dir);
+
+        {
+            let mut writer = _writer(&base_dir, 2);
+            writer.append(b"partial").unwrap();
+            assert!(tmp_storage_file(&base_dir, 2).exists());
+        }
+
+        assert!(!tmp_storage_file(&base_dir, 2).exists());
+
+        fs::remove_dir_all(&base_dir).unwrap();
+    }
+}
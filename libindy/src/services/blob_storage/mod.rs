@@ -4,9 +4,6 @@ use std::collections::HashMap;
 use indy_api_types::errors::prelude::*;
 use indy_utils::sequence;
 
-use sha2::Sha256;
-use sha2::digest::{FixedOutput, Update};
-
 mod default_writer;
 mod default_reader;
 
@@ -19,8 +16,10 @@ trait Writer {
 }
 
 trait WritableBlob {
+    /// Writes bytes to the blob and feeds them to the blob hash.
     fn append(&mut self, bytes: &[u8]) -> IndyResult<usize>;
-    fn finalize(&mut self, hash: &[u8]) -> IndyResult<String>;
+    /// Completes the blob and returns its location and hash.
+    fn finalize(&mut self) -> IndyResult<(String, Vec<u8>)>;
 }
 
 trait ReaderType {
@@ -40,7 +39,7 @@ trait ReadableBlob {
 pub struct BlobStorageService {
     writer_types: RefCell<HashMap<String, Box<dyn WriterType>>>,
     writer_configs: RefCell<HashMap<i32, Box<dyn Writer>>>,
-    writer_blobs: RefCell<HashMap<i32, (Box<dyn WritableBlob>, Sha256)>>,
+    writer_blobs: RefCell<HashMap<i32, Box<dyn WritableBlob>>>,
 
     reader_types: RefCell<HashMap<String, Box<dyn ReaderType>>>,
     reader_configs: RefCell<HashMap<i32, Box<dyn Reader>>>,
@@ -85,29 +84,22 @@ impl BlobStorageService {
             .get(&config_handle).ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Invalid BlobStorage config handle"))? // FIXME: Review error kind
             .create(blob_handle)?;
 
-        self.writer_blobs.try_borrow_mut()?.insert(blob_handle, (writer, Sha256::default()));
+        self.writer_blobs.try_borrow_mut()?.insert(blob_handle, writer);
 
         Ok(blob_handle)
     }
 
     pub fn append(&self, handle: i32, bytes: &[u8]) -> IndyResult<usize> {
-        let mut writers = self.writer_blobs.try_borrow_mut()?;
-        let &mut (ref mut writer, ref mut hasher) = writers
-            .get_mut(&handle).ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Invalid BlobStorage handle"))?; // FIXME: Review error kind
-
-        hasher.update(bytes);
-        writer.append(bytes)
+        self.writer_blobs.try_borrow_mut()?
+            .get_mut(&handle).ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Invalid BlobStorage handle"))? // FIXME: Review error kind
+            .append(bytes)
     }
 
     pub fn finalize(&self, handle: i32) -> IndyResult<(String, Vec<u8>)> {
-        let mut writers = self.writer_blobs.try_borrow_mut()?;
-        let (mut writer, hasher) = writers
+        let mut writer = self.writer_blobs.try_borrow_mut()?
             .remove(&handle).ok_or_else(|| err_msg(IndyErrorKind::InvalidStructure, "Invalid BlobStorage handle"))?; // FIXME: Review error kind
 
-        let hash = hasher.finalize_fixed().to_vec();
-
-        writer.finalize(hash.as_slice())
-            .map(|location| (location, hash))
+        writer.finalize()
     }
 }
 
@@ -0,0 +1,233 @@
+//! Optional per-wallet caches of Curve25519 keys used by authcrypt and anoncrypt.
+//!
+//! Every crypto_box has to convert ed25519 keys to Curve25519 and run the key agreement between
+//! sender and recipient keys. Agents that exchange many messages over the same pairwise
+//! relationships repeat the same conversions and scalar multiplications for every message, so
+//! every opened wallet can keep the converted public keys and the shared keys precomputed for
+//! pairs of its own verkey and their verkey.
+//!
+//! Caches are bounded: the least recently used entry is evicted when a cache is full. Cached keys
+//! are sodium types that are zeroed on drop, caches of a wallet are dropped when it is closed.
+//!
+//! Caches are disabled until `box_key_cache_size` is set with `indy_set_runtime_config`, only
+//! wallets opened after that get caches.
+
+use std::collections::HashMap;
+use std::hash::Hash;
+use std::sync::Mutex;
+
+use indy_api_types::WalletHandle;
+use indy_api_types::errors::prelude::*;
+use indy_utils::crypto::ed25519_box;
+
+lazy_static! {
+    static ref BOX_KEY_CACHES: Mutex<BoxKeyCaches> = Mutex::new(BoxKeyCaches { size: 0, caches: HashMap::new() });
+}
+
+// Cache size is global, tests that change it take this lock
+#[cfg(test)]
+lazy_static! {
+    pub static ref SIZE_TEST_LOCK: Mutex<()> = Mutex::new(());
+}
+
+struct BoxKeyCaches {
+    size: usize,
+    caches: HashMap<WalletHandle, WalletBoxKeyCache>,
+}
+
+struct WalletBoxKeyCache {
+    public_keys: LruCache<String, ed25519_box::PublicKey>,
+    shared_keys: LruCache<(String, String), ed25519_box::PrecomputedKey>,
+}
+
+struct LruCache<K, V> {
+    size: usize,
+    tick: u64,
+    entries: HashMap<K, (V, u64)>,
+}
+
+impl<K: Eq + Hash + Clone, V: Clone> LruCache<K, V> {
+    fn new(size: usize) -> LruCache<K, V> {
+        LruCache { size, tick: 0, entries: HashMap::with_capacity(size) }
+    }
+
+    fn get(&mut self, key: &K) -> Option<V> {
+        self.tick += 1;
+        let tick = self.tick;
+
+        self.entries.get_mut(key).map(|(value, used)| {
+            *used = tick;
+            value.clone()
+        })
+    }
+
+    fn insert(&mut self, key: K, value: V) {
+        if !self.entries.contains_key(&key) && self.entries.len() >= self.size {
+            let lru_key = self.entries.iter()
+                .min_by_key(|(_, (_, used))| *used)
+                .map(|(key, _)| key.clone());
+
+            if let Some(lru_key) = lru_key {
+                self.entries.remove(&lru_key);
+            }
+        }
+
+        self.tick += 1;
+        self.entries.insert(key, (value, self.tick));
+    }
+
+    fn resize(&mut self, size: usize) {
+        self.size = size;
+
+        while self.entries.len() > size {
+            let lru_key = self.entries.iter()
+                .min_by_key(|(_, (_, used))| *used)
+                .map(|(key, _)| key.clone())
+                .unwrap();
+
+            self.entries.remove(&lru_key);
+        }
+    }
+}
+
+/// Sets max number of converted public keys and of shared keys cached for every opened wallet.
+/// 0 disables caches.
+pub fn set_size(size: usize) {
+    let mut box_key_caches = BOX_KEY_CACHES.lock().unwrap();
+
+    box_key_caches.size = size;
+
+    if size == 0 {
+        box_key_caches.caches.clear();
+    } else {
+        for cache in box_key_caches.caches.values_mut() {
+            cache.public_keys.resize(size);
+            cache.shared_keys.resize(size);
+        }
+    }
+}
+
+/// Creates caches for the opened wallet.
+pub fn add(wallet_handle: WalletHandle) {
+    let mut box_key_caches = BOX_KEY_CACHES.lock().unwrap();
+    let size = box_key_caches.size;
+
+    if size == 0 {
+        return;
+    }
+
+    box_key_caches.caches
+        .entry(wallet_handle)
+        .or_insert_with(|| WalletBoxKeyCache {
+            public_keys: LruCache::new(size),
+            shared_keys: LruCache::new(size),
+        });
+}
+
+/// Drops cached keys of the closed wallet.
+pub fn remove(wallet_handle: WalletHandle) {
+    BOX_KEY_CACHES.lock().unwrap().caches.remove(&wallet_handle);
+}
+
+pub fn is_enabled(wallet_handle: WalletHandle) -> bool {
+    BOX_KEY_CACHES.lock().unwrap().caches.contains_key(&wallet_handle)
+}
+
+/// Returns Curve25519 public key converted from `verkey`, `convert` is called on cache miss.
+///
+/// Returns None if the wallet has no caches.
+pub fn public_key<F>(wallet_handle: WalletHandle, verkey: &str, convert: F) -> IndyResult<Option<ed25519_box::PublicKey>>
+    where F: FnOnce() -> IndyResult<ed25519_box::PublicKey> {
+    _get_or_insert(wallet_handle, verkey.to_string(), convert, |cache| &mut cache.public_keys)
+}
+
+/// Returns the key precomputed for my secret key and their public key, `precompute` is called on cache miss.
+///
+/// Returns None if the wallet has no caches.
+pub fn shared_key<F>(wallet_handle: WalletHandle, my_vk: &str, their_vk: &str, precompute: F) -> IndyResult<Option<ed25519_box::PrecomputedKey>>
+    where F: FnOnce() -> IndyResult<ed25519_box::PrecomputedKey> {
+    _get_or_insert(wallet_handle, (my_vk.to_string(), their_vk.to_string()), precompute, |cache| &mut cache.shared_keys)
+}
+
+fn _get_or_insert<K, V, F, C>(wallet_handle: WalletHandle, key: K, compute: F, cache: C) -> IndyResult<Option<V>>
+    where K: Eq + Hash + Clone,
+          V: Clone,
+          F: FnOnce() -> IndyResult<V>,
+          C: Fn(&mut WalletBoxKeyCache) -> &mut LruCache<K, V> {
+    match BOX_KEY_CACHES.lock().unwrap().caches.get_mut(&wallet_handle) {
+        Some(wallet_cache) => {
+            if let Some(value) = cache(wallet_cache).get(&key) {
+                return Ok(Some(value));
+            }
+        }
+        None => return Ok(None)
+    }
+
+    // Compute outside of the lock, so cache hits of other wallets are never blocked by key agreement
+    let value = compute()?;
+
+    if let Some(wallet_cache) = BOX_KEY_CACHES.lock().unwrap().caches.get_mut(&wallet_handle) {
+        cache(wallet_cache).insert(key, value.clone());
+    }
+
+    Ok(Some(value))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use indy_utils::crypto::ed25519_sign;
+
+    fn _public_key() -> ed25519_box::PublicKey {
+        let (vk, _) = ed25519_sign::create_key_pair_for_signature(None).unwrap();
+        ed25519_sign::vk_to_curve25519(&vk).unwrap()
+    }
+
+    #[test]
+    fn lru_cache_evicts_least_recently_used() {
+        let mut cache = LruCache::new(2);
+
+        cache.insert("a", 1);
+        cache.insert("b", 2);
+        assert_eq!(Some(1), cache.get(&"a"));
+
+        cache.insert("c", 3);
+        assert_eq!(None, cache.get(&"b"));
+        assert_eq!(Some(1), cache.get(&"a"));
+        assert_eq!(Some(3), cache.get(&"c"));
+
+        cache.resize(1);
+        assert_eq!(1, cache.entries.len());
+        assert_eq!(Some(3), cache.get(&"c"));
+    }
+
+    #[test]
+    fn box_key_cache_works() {
+        let _lock = SIZE_TEST_LOCK.lock().unwrap_or_else(|err| err.into_inner());
+
+        let wallet_handle = WalletHandle(-101);
+        let key = _public_key();
+
+        assert!(public_key(wallet_handle, "vk", || Ok(key.clone())).unwrap().is_none());
+
+        set_size(2);
+        add(wallet_handle);
+        assert!(is_enabled(wallet_handle));
+
+        assert_eq!(key, public_key(wallet_handle, "vk", || Ok(key.clone())).unwrap().unwrap());
+        assert_eq!(key, public_key(wallet_handle, "vk", || panic!("cache miss")).unwrap().unwrap());
+
+        let shared = ed25519_box::PrecomputedKey::new([1; ed25519_box::PRECOMPUTEDKEYBYTES]);
+        assert_eq!(shared, shared_key(wallet_handle, "my", "their", || Ok(shared.clone())).unwrap().unwrap());
+        assert_eq!(shared, shared_key(wallet_handle, "my", "their", || panic!("cache miss")).unwrap().unwrap());
+
+        assert!(public_key(wallet_handle, "invalid", || Err(IndyError::from(IndyErrorKind::InvalidStructure))).is_err());
+
+        remove(wallet_handle);
+        assert!(!is_enabled(wallet_handle));
+        assert!(shared_key(wallet_handle, "my", "their", || Ok(shared.clone())).unwrap().is_none());
+
+        set_size(0);
+    }
+}
@@ -49,6 +49,30 @@ impl CryptoType for ED25519CryptoType {
                          &ed25519_sign::sk_to_curve25519(sk)?, doc)
     }
 
+    fn box_public_key(&self, vk: &ed25519_sign::PublicKey) -> Result<ed25519_box::PublicKey, IndyError> {
+        ed25519_sign::vk_to_curve25519(vk)
+    }
+
+    fn box_shared_key(&self, sk: &ed25519_sign::SecretKey, pk: &ed25519_box::PublicKey) -> Result<ed25519_box::PrecomputedKey, IndyError> {
+        Ok(ed25519_box::precompute(&ed25519_sign::sk_to_curve25519(sk)?, pk))
+    }
+
+    fn crypto_box_shared(&self, key: &ed25519_box::PrecomputedKey, doc: &[u8], nonce: &ed25519_box::Nonce) -> Result<Vec<u8>, IndyError> {
+        ed25519_box::encrypt_precomputed(key, doc, nonce)
+    }
+
+    fn crypto_box_shared_open(&self, key: &ed25519_box::PrecomputedKey, doc: &[u8], nonce: &ed25519_box::Nonce) -> Result<Vec<u8>, IndyError> {
+        ed25519_box::decrypt_precomputed(key, doc, nonce)
+    }
+
+    fn crypto_box_seal_box_key(&self, pk: &ed25519_box::PublicKey, doc: &[u8]) -> Result<Vec<u8>, IndyError> {
+        sealedbox::encrypt(pk, doc)
+    }
+
+    fn crypto_box_seal_open_box_key(&self, pk: &ed25519_box::PublicKey, sk: &ed25519_sign::SecretKey, doc: &[u8]) -> Result<Vec<u8>, IndyError> {
+        sealedbox::decrypt(pk, &ed25519_sign::sk_to_curve25519(sk)?, doc)
+    }
+
     fn validate_key(&self, _vk: &ed25519_sign::PublicKey) -> Result<(), IndyError> {
         // TODO: FIXME: Validate key
         Ok(())
@@ -0,0 +1,193 @@
+//! Optional per-wallet pools of pre-generated ed25519 key pairs.
+//!
+//! Key generation for unseeded keys is moved off the command thread: every opened wallet gets
+//! a queue of key pairs that is refilled on the crypto thread pool up to the configured depth.
+//! Pooled secret keys stay in process memory until they are taken, like keys of opened wallets
+//! do. They are sodium types, so they are zeroed when dropped from the pool on depth decrease,
+//! wallet close or take.
+//!
+//! Pools are disabled until `key_pool_depth` is set with `indy_set_runtime_config`. Changing the
+//! depth applies to all opened wallets, setting it to 0 drops all pooled keys.
+
+use std::collections::{HashMap, VecDeque};
+use std::sync::Mutex;
+
+use indy_api_types::WalletHandle;
+use indy_utils::crypto::ed25519_sign;
+
+// Max number of keys generated by one refill job, so refill never holds crypto threads for long
+const REFILL_BATCH_SIZE: usize = 8;
+
+lazy_static! {
+    static ref KEY_POOLS: Mutex<KeyPools> = Mutex::new(KeyPools { depth: 0, pools: HashMap::new() });
+}
+
+struct KeyPools {
+    depth: usize,
+    pools: HashMap<WalletHandle, WalletKeyPool>,
+}
+
+struct WalletKeyPool {
+    keys: VecDeque<(ed25519_sign::PublicKey, ed25519_sign::SecretKey)>,
+    refilling: bool,
+}
+
+/// Sets max number of pre-generated key pairs kept for every opened wallet. 0 disables pools.
+pub fn set_depth(depth: usize) {
+    let wallet_handles: Vec<WalletHandle> = {
+        let mut key_pools = KEY_POOLS.lock().unwrap();
+
+        key_pools.depth = depth;
+
+        for pool in key_pools.pools.values_mut() {
+            pool.keys.truncate(depth);
+        }
+
+        key_pools.pools.keys().cloned().collect()
+    };
+
+    for wallet_handle in wallet_handles {
+        _schedule_refill(wallet_handle);
+    }
+}
+
+/// Creates the pool for the opened wallet and starts to fill it.
+pub fn add(wallet_handle: WalletHandle) {
+    // Pool is created even if pools are disabled, so it is filled when depth is set later
+    KEY_POOLS.lock().unwrap().pools
+        .entry(wallet_handle)
+        .or_insert_with(|| WalletKeyPool { keys: VecDeque::new(), refilling: false });
+
+    _schedule_refill(wallet_handle);
+}
+
+/// Takes a pre-generated key pair for the wallet and schedules refill of the pool.
+///
+/// Returns None if the wallet has no pool or the pool is drained.
+pub fn take(wallet_handle: WalletHandle) -> Option<(ed25519_sign::PublicKey, ed25519_sign::SecretKey)> {
+    let key_pair = KEY_POOLS.lock().unwrap().pools
+        .get_mut(&wallet_handle)
+        .and_then(|pool| pool.keys.pop_front());
+
+    if key_pair.is_some() {
+        _schedule_refill(wallet_handle);
+    }
+
+    key_pair
+}
+
+/// Drops pre-generated key pairs of the closed wallet.
+pub fn remove(wallet_handle: WalletHandle) {
+    KEY_POOLS.lock().unwrap().pools.remove(&wallet_handle);
+}
+
+fn _schedule_refill(wallet_handle: WalletHandle) {
+    {
+        let mut key_pools = KEY_POOLS.lock().unwrap();
+        let depth = key_pools.depth;
+
+        let pool = match key_pools.pools.get_mut(&wallet_handle) {
+            Some(pool) => pool,
+            None => return
+        };
+
+        if pool.refilling || pool.keys.len() >= depth {
+            return;
+        }
+
+        pool.refilling = true;
+    }
+
+    crate::commands::THREADPOOL.lock().unwrap().execute(move || _refill(wallet_handle));
+}
+
+// Adds at most REFILL_BATCH_SIZE keys and schedules the next job to the end of the thread pool
+// queue, so commands sent meanwhile don't wait for the whole pool to be filled.
+fn _refill(wallet_handle: WalletHandle) {
+    trace!("_refill >>> wallet_handle: {:?}", wallet_handle);
+
+    for _ in 0..REFILL_BATCH_SIZE {
+        // Generate outside of the lock, so taking keys is never blocked by generation
+        let key_pair = ed25519_sign::create_key_pair_for_signature(None);
+
+        let mut key_pools = KEY_POOLS.lock().unwrap();
+        let depth = key_pools.depth;
+
+        let pool = match key_pools.pools.get_mut(&wallet_handle) {
+            Some(pool) => pool,
+            None => return // wallet was closed
+        };
+
+        match key_pair {
+            Ok(key_pair) if pool.keys.len() < depth => pool.keys.push_back(key_pair),
+            Ok(_) => break,
+            Err(err) => {
+                warn!("_refill: can't generate key pair: {:?}", err);
+                pool.refilling = false;
+                return;
+            }
+        }
+    }
+
+    match KEY_POOLS.lock().unwrap().pools.get_mut(&wallet_handle) {
+        Some(pool) => pool.refilling = false,
+        None => return
+    }
+
+    _schedule_refill(wallet_handle);
+
+    trace!("_refill <<<");
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::thread;
+    use std::time::Duration;
+
+    fn _wait_pool_size(wallet_handle: WalletHandle, size: usize) {
+        for _ in 0..100 {
+            if KEY_POOLS.lock().unwrap().pools.get(&wallet_handle).map(|pool| pool.keys.len()) == Some(size) {
+                return;
+            }
+            thread::sleep(Duration::from_millis(10));
+        }
+        panic!("key pool was not refilled");
+    }
+
+    // Pool depth is global, so all checks live in one test
+    #[test]
+    fn key_pool_works() {
+        let wallet_handle = WalletHandle(-100);
+
+        assert!(take(wallet_handle).is_none());
+
+        add(wallet_handle);
+        assert!(take(wallet_handle).is_none());
+
+        // pools of opened wallets are filled when depth is set
+        set_depth(3);
+        _wait_pool_size(wallet_handle, 3);
+
+        let (vk, sk) = take(wallet_handle).unwrap();
+        let signature = ed25519_sign::sign(&sk, b"message").unwrap();
+        assert!(ed25519_sign::verify(&vk, b"message", &signature).unwrap());
+
+        let (other_vk, _) = take(wallet_handle).unwrap();
+        assert_ne!(vk, other_vk);
+
+        _wait_pool_size(wallet_handle, 3);
+
+        // more keys than one refill batch
+        set_depth(REFILL_BATCH_SIZE * 2 + 1);
+        _wait_pool_size(wallet_handle, REFILL_BATCH_SIZE * 2 + 1);
+
+        set_depth(0);
+        _wait_pool_size(wallet_handle, 0);
+        assert!(take(wallet_handle).is_none());
+
+        remove(wallet_handle);
+        assert!(KEY_POOLS.lock().unwrap().pools.get(&wallet_handle).is_none());
+    }
+}
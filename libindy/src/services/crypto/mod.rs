@@ -6,6 +6,7 @@ use std::str;
 use crate::domain::crypto::combo_box::ComboBox;
 use crate::domain::crypto::did::{Did, DidValue, MyDidInfo, TheirDid, TheirDidInfo};
 use crate::domain::crypto::key::{Key, KeyInfo};
+use indy_api_types::WalletHandle;
 use indy_api_types::errors::prelude::*;
 use indy_utils::crypto::base64;
 use indy_utils::crypto::ed25519_box;
@@ -19,6 +20,8 @@ use self::hex::FromHex;
 use rust_base58::{FromBase58, ToBase58};
 
 mod ed25519;
+pub mod box_key_cache;
+pub mod key_pool;
 
 pub const DEFAULT_CRYPTO_TYPE: &str = "ed25519";
 
@@ -34,6 +37,12 @@ trait CryptoType {
     fn verify(&self, vk: &ed25519_sign::PublicKey, doc: &[u8], signature: &ed25519_sign::Signature) -> IndyResult<bool>;
     fn crypto_box_seal(&self, vk: &ed25519_sign::PublicKey, doc: &[u8]) -> IndyResult<Vec<u8>>;
     fn crypto_box_seal_open(&self, vk: &ed25519_sign::PublicKey, sk: &ed25519_sign::SecretKey, doc: &[u8]) -> IndyResult<Vec<u8>>;
+    fn box_public_key(&self, vk: &ed25519_sign::PublicKey) -> IndyResult<ed25519_box::PublicKey>;
+    fn box_shared_key(&self, sk: &ed25519_sign::SecretKey, pk: &ed25519_box::PublicKey) -> IndyResult<ed25519_box::PrecomputedKey>;
+    fn crypto_box_shared(&self, key: &ed25519_box::PrecomputedKey, doc: &[u8], nonce: &ed25519_box::Nonce) -> IndyResult<Vec<u8>>;
+    fn crypto_box_shared_open(&self, key: &ed25519_box::PrecomputedKey, doc: &[u8], nonce: &ed25519_box::Nonce) -> IndyResult<Vec<u8>>;
+    fn crypto_box_seal_box_key(&self, pk: &ed25519_box::PublicKey, doc: &[u8]) -> IndyResult<Vec<u8>>;
+    fn crypto_box_seal_open_box_key(&self, pk: &ed25519_box::PublicKey, sk: &ed25519_sign::SecretKey, doc: &[u8]) -> IndyResult<Vec<u8>>;
 }
 
 pub struct CryptoService {
@@ -51,6 +60,15 @@ impl CryptoService {
     }
 
     pub fn create_key(&self, key_info: &KeyInfo) -> IndyResult<Key> {
+        self._create_key(key_info, None)
+    }
+
+    /// Same as `create_key`, but unseeded ed25519 keys are taken from the wallet key pool if it is enabled.
+    pub fn create_key_for_wallet(&self, wallet_handle: WalletHandle, key_info: &KeyInfo) -> IndyResult<Key> {
+        self._create_key(key_info, Some(wallet_handle))
+    }
+
+    fn _create_key(&self, key_info: &KeyInfo, wallet_handle: Option<WalletHandle>) -> IndyResult<Key> {
         trace!("create_key >>> key_info: {:?}", secret!(key_info));
 
         let crypto_type_name = key_info.crypto_type
@@ -62,10 +80,8 @@ impl CryptoService {
             return Err(err_msg(IndyErrorKind::UnknownCrypto, format!("KeyInfo contains unknown crypto: {}", crypto_type_name)));
         }
 
-        let crypto_type = self.crypto_types.get(crypto_type_name).unwrap();
-
         let seed = self.convert_seed(key_info.seed.as_ref().map(String::as_ref))?;
-        let (vk, sk) = crypto_type.create_key(seed.as_ref())?;
+        let (vk, sk) = self._create_key_pair(crypto_type_name, seed.as_ref(), wallet_handle)?;
         let mut vk = vk[..].to_base58();
         let sk = sk[..].to_base58();
         if !crypto_type_name.eq(DEFAULT_CRYPTO_TYPE) {
@@ -81,6 +97,16 @@ impl CryptoService {
     }
 
     pub fn create_my_did(&self, my_did_info: &MyDidInfo) -> IndyResult<(Did, Key)> {
+        self._create_my_did(my_did_info, None)
+    }
+
+    /// Same as `create_my_did`, but keys for unseeded DIDs without fixed value are taken from the wallet key pool if it is enabled.
+    pub fn create_my_did_for_wallet(&self, wallet_handle: WalletHandle, my_did_info: &MyDidInfo) -> IndyResult<(Did, Key)> {
+        let wallet_handle = if my_did_info.did.is_none() { Some(wallet_handle) } else { None };
+        self._create_my_did(my_did_info, wallet_handle)
+    }
+
+    fn _create_my_did(&self, my_did_info: &MyDidInfo, wallet_handle: Option<WalletHandle>) -> IndyResult<(Did, Key)> {
         trace!("create_my_did >>> my_did_info: {:?}", secret!(my_did_info));
 
         let crypto_type_name = my_did_info.crypto_type
@@ -92,10 +118,8 @@ impl CryptoService {
             return Err(err_msg(IndyErrorKind::UnknownCrypto, format!("MyDidInfo contains unknown crypto: {}", crypto_type_name)));
         }
 
-        let crypto_type = self.crypto_types.get(crypto_type_name).unwrap();
-
         let seed = self.convert_seed(my_did_info.seed.as_ref().map(String::as_ref))?;
-        let (vk, sk) = crypto_type.create_key(seed.as_ref())?;
+        let (vk, sk) = self._create_key_pair(crypto_type_name, seed.as_ref(), wallet_handle)?;
         let did = match my_did_info.did {
             Some(ref did) => did.clone(),
             _ if my_did_info.cid == Some(true) =>
@@ -119,6 +143,25 @@ impl CryptoService {
         Ok(did)
     }
 
+    fn _create_key_pair(&self,
+                        crypto_type_name: &str,
+                        seed: Option<&ed25519_sign::Seed>,
+                        wallet_handle: Option<WalletHandle>) -> IndyResult<(ed25519_sign::PublicKey, ed25519_sign::SecretKey)> {
+        let crypto_type = self.crypto_types.get(crypto_type_name)
+            .ok_or_else(|| err_msg(IndyErrorKind::UnknownCrypto, format!("Unknown crypto: {}", crypto_type_name)))?;
+
+        // Seeded keys must be derived from the seed, pool holds only ed25519 keys
+        if let Some(wallet_handle) = wallet_handle {
+            if seed.is_none() && crypto_type_name == DEFAULT_CRYPTO_TYPE {
+                if let Some(key_pair) = key_pool::take(wallet_handle) {
+                    return Ok(key_pair);
+                }
+            }
+        }
+
+        crypto_type.create_key(seed)
+    }
+
     pub fn create_their_did(&self, their_did_info: &TheirDidInfo) -> IndyResult<TheirDid> {
         trace!("create_their_did >>> their_did_info: {:?}", their_did_info);
 
@@ -194,8 +237,19 @@ impl CryptoService {
     }
 
     pub fn crypto_box(&self, my_key: &Key, their_vk: &str, doc: &[u8]) -> IndyResult<(Vec<u8>, Vec<u8>)> {
+        self._crypto_box(my_key, their_vk, doc, None)
+    }
+
+    /// Same as `crypto_box`, but uses the shared key from the wallet box key cache if it is enabled.
+    pub fn crypto_box_for_wallet(&self, wallet_handle: WalletHandle, my_key: &Key, their_vk: &str, doc: &[u8]) -> IndyResult<(Vec<u8>, Vec<u8>)> {
+        self._crypto_box(my_key, their_vk, doc, Some(wallet_handle))
+    }
+
+    fn _crypto_box(&self, my_key: &Key, their_vk: &str, doc: &[u8], wallet_handle: Option<WalletHandle>) -> IndyResult<(Vec<u8>, Vec<u8>)> {
         trace!("crypto_box >>> my_key: {:?}, their_vk: {:?}, doc: {:?}", my_key, their_vk, doc);
 
+        let full_their_vk = their_vk;
+
         let crypto_type_name = verkey_get_cryptoname(&my_key.verkey);
 
         let (their_vk, their_crypto_type_name) = split_verkey(their_vk);
@@ -214,11 +268,16 @@ impl CryptoService {
 
         let crypto_type = self.crypto_types.get(&crypto_type_name).unwrap();
 
-        let my_sk = ed25519_sign::SecretKey::from_slice(my_key.signkey.as_str().from_base58()?.as_slice())?;
-        let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
         let nonce = crypto_type.gen_nonce();
 
-        let encrypted_doc = crypto_type.crypto_box(&my_sk, &their_vk, doc, &nonce)?;
+        let encrypted_doc = match self._shared_key(&**crypto_type, my_key, full_their_vk, wallet_handle)? {
+            Some(shared_key) => crypto_type.crypto_box_shared(&shared_key, doc, &nonce)?,
+            None => {
+                let my_sk = ed25519_sign::SecretKey::from_slice(my_key.signkey.as_str().from_base58()?.as_slice())?;
+                let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
+                crypto_type.crypto_box(&my_sk, &their_vk, doc, &nonce)?
+            }
+        };
         let nonce = nonce[..].to_vec();
 
         trace!("crypto_box <<< encrypted_doc: {:?}, nonce: {:?}", encrypted_doc, nonce);
@@ -227,8 +286,19 @@ impl CryptoService {
     }
 
     pub fn crypto_box_open(&self, my_key: &Key, their_vk: &str, doc: &[u8], nonce: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_open(my_key, their_vk, doc, nonce, None)
+    }
+
+    /// Same as `crypto_box_open`, but uses the shared key from the wallet box key cache if it is enabled.
+    pub fn crypto_box_open_for_wallet(&self, wallet_handle: WalletHandle, my_key: &Key, their_vk: &str, doc: &[u8], nonce: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_open(my_key, their_vk, doc, nonce, Some(wallet_handle))
+    }
+
+    fn _crypto_box_open(&self, my_key: &Key, their_vk: &str, doc: &[u8], nonce: &[u8], wallet_handle: Option<WalletHandle>) -> IndyResult<Vec<u8>> {
         trace!("crypto_box_open >>> my_key: {:?}, their_vk: {:?}, doc: {:?}, nonce: {:?}", my_key, their_vk, doc, nonce);
 
+        let full_their_vk = their_vk;
+
         let crypto_type_name = verkey_get_cryptoname(&my_key.verkey);
 
         let (their_vk, their_crypto_type_name) = split_verkey(their_vk);
@@ -248,11 +318,16 @@ impl CryptoService {
 
         let crypto_type = self.crypto_types.get(crypto_type_name).unwrap();
 
-        let my_sk = ed25519_sign::SecretKey::from_slice(&my_key.signkey.from_base58()?.as_slice())?;
-        let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
         let nonce = ed25519_box::Nonce::from_slice(&nonce)?;
 
-        let decrypted_doc = crypto_type.crypto_box_open(&my_sk, &their_vk, &doc, &nonce)?;
+        let decrypted_doc = match self._shared_key(&**crypto_type, my_key, full_their_vk, wallet_handle)? {
+            Some(shared_key) => crypto_type.crypto_box_shared_open(&shared_key, &doc, &nonce)?,
+            None => {
+                let my_sk = ed25519_sign::SecretKey::from_slice(&my_key.signkey.from_base58()?.as_slice())?;
+                let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
+                crypto_type.crypto_box_open(&my_sk, &their_vk, &doc, &nonce)?
+            }
+        };
 
         trace!("crypto_box_open <<< decrypted_doc: {:?}", decrypted_doc);
 
@@ -260,8 +335,19 @@ impl CryptoService {
     }
 
     pub fn crypto_box_seal(&self, their_vk: &str, doc: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_seal(their_vk, doc, None)
+    }
+
+    /// Same as `crypto_box_seal`, but uses the converted key from the wallet box key cache if it is enabled.
+    pub fn crypto_box_seal_for_wallet(&self, wallet_handle: WalletHandle, their_vk: &str, doc: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_seal(their_vk, doc, Some(wallet_handle))
+    }
+
+    fn _crypto_box_seal(&self, their_vk: &str, doc: &[u8], wallet_handle: Option<WalletHandle>) -> IndyResult<Vec<u8>> {
         trace!("crypto_box_seal >>> their_vk: {:?}, doc: {:?}", their_vk, doc);
 
+        let full_their_vk = their_vk;
+
         let (their_vk, crypto_type_name) = split_verkey(their_vk);
 
         if !self.crypto_types.contains_key(&crypto_type_name) {
@@ -270,9 +356,13 @@ impl CryptoService {
 
         let crypto_type = self.crypto_types.get(crypto_type_name).unwrap();
 
-        let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
-
-        let encrypted_doc = crypto_type.crypto_box_seal(&their_vk, doc)?;
+        let encrypted_doc = match self._box_public_key(&**crypto_type, full_their_vk, wallet_handle)? {
+            Some(their_pk) => crypto_type.crypto_box_seal_box_key(&their_pk, doc)?,
+            None => {
+                let their_vk = ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?;
+                crypto_type.crypto_box_seal(&their_vk, doc)?
+            }
+        };
 
         trace!("crypto_box_seal <<< encrypted_doc: {:?}", encrypted_doc);
 
@@ -280,6 +370,15 @@ impl CryptoService {
     }
 
     pub fn crypto_box_seal_open(&self, my_key: &Key, doc: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_seal_open(my_key, doc, None)
+    }
+
+    /// Same as `crypto_box_seal_open`, but uses the converted key from the wallet box key cache if it is enabled.
+    pub fn crypto_box_seal_open_for_wallet(&self, wallet_handle: WalletHandle, my_key: &Key, doc: &[u8]) -> IndyResult<Vec<u8>> {
+        self._crypto_box_seal_open(my_key, doc, Some(wallet_handle))
+    }
+
+    fn _crypto_box_seal_open(&self, my_key: &Key, doc: &[u8], wallet_handle: Option<WalletHandle>) -> IndyResult<Vec<u8>> {
         trace!("crypto_box_seal_open >>> my_key: {:?}, doc: {:?}", my_key, doc);
 
         let (my_vk, crypto_type_name) = split_verkey(&my_key.verkey);
@@ -291,16 +390,62 @@ impl CryptoService {
 
         let crypto_type = self.crypto_types.get(crypto_type_name).unwrap();
 
-        let my_vk = ed25519_sign::PublicKey::from_slice(my_vk.from_base58()?.as_slice())?;
         let my_sk = ed25519_sign::SecretKey::from_slice(my_key.signkey.as_str().from_base58()?.as_slice())?;
 
-        let decrypted_doc = crypto_type.crypto_box_seal_open(&my_vk, &my_sk, doc)?;
+        let decrypted_doc = match self._box_public_key(&**crypto_type, &my_key.verkey, wallet_handle)? {
+            Some(my_pk) => crypto_type.crypto_box_seal_open_box_key(&my_pk, &my_sk, doc)?,
+            None => {
+                let my_vk = ed25519_sign::PublicKey::from_slice(my_vk.from_base58()?.as_slice())?;
+                crypto_type.crypto_box_seal_open(&my_vk, &my_sk, doc)?
+            }
+        };
 
         trace!("crypto_box_seal_open <<< decrypted_doc: {:?}", decrypted_doc);
 
         Ok(decrypted_doc)
     }
 
+    // Returns None if the wallet has no box key cache
+    fn _box_public_key(&self,
+                       crypto_type: &dyn CryptoType,
+                       vk: &str,
+                       wallet_handle: Option<WalletHandle>) -> IndyResult<Option<ed25519_box::PublicKey>> {
+        let wallet_handle = match wallet_handle {
+            Some(wallet_handle) => wallet_handle,
+            None => return Ok(None)
+        };
+
+        box_key_cache::public_key(wallet_handle, vk, || {
+            let (vk, _) = split_verkey(vk);
+            let vk = ed25519_sign::PublicKey::from_slice(vk.from_base58()?.as_slice())?;
+            crypto_type.box_public_key(&vk)
+        })
+    }
+
+    // Returns None if the wallet has no box key cache
+    fn _shared_key(&self,
+                   crypto_type: &dyn CryptoType,
+                   my_key: &Key,
+                   their_vk: &str,
+                   wallet_handle: Option<WalletHandle>) -> IndyResult<Option<ed25519_box::PrecomputedKey>> {
+        let wallet_handle = match wallet_handle {
+            Some(wallet_handle) => wallet_handle,
+            None => return Ok(None)
+        };
+
+        box_key_cache::shared_key(wallet_handle, &my_key.verkey, their_vk, || {
+            let their_pk = match self._box_public_key(crypto_type, their_vk, Some(wallet_handle))? {
+                Some(their_pk) => their_pk,
+                None => {
+                    let (their_vk, _) = split_verkey(their_vk);
+                    crypto_type.box_public_key(&ed25519_sign::PublicKey::from_slice(their_vk.from_base58()?.as_slice())?)?
+                }
+            };
+            let my_sk = ed25519_sign::SecretKey::from_slice(my_key.signkey.as_str().from_base58()?.as_slice())?;
+            crypto_type.box_shared_key(&my_sk, &their_pk)
+        })
+    }
+
     pub fn convert_seed(&self, seed: Option<&str>) -> IndyResult<Option<ed25519_sign::Seed>> {
         trace!("convert_seed >>> seed: {:?}", secret!(seed));
 
@@ -690,6 +835,43 @@ mod tests {
         assert_eq!(msg, decrypted_message.as_slice());
     }
 
+    #[test]
+    fn crypto_box_for_wallet_works_with_box_key_cache() {
+        let service = CryptoService::new();
+        let wallet_handle = WalletHandle(-102);
+        let msg = "some message".as_bytes();
+        let did_info = MyDidInfo { did: None, cid: None, seed: None, crypto_type: None, method_name: None };
+        let (my_did, my_key) = service.create_my_did(&did_info).unwrap();
+        let (their_did, their_key) = service.create_my_did(&did_info.clone()).unwrap();
+
+        let _lock = box_key_cache::SIZE_TEST_LOCK.lock().unwrap_or_else(|err| err.into_inner());
+
+        box_key_cache::set_size(10);
+        box_key_cache::add(wallet_handle);
+
+        // cached and uncached boxes are interchangeable, the second round goes through cached keys
+        for _ in 0..2 {
+            let (encrypted_message, nonce) = service.crypto_box_for_wallet(wallet_handle, &my_key, &their_did.verkey, msg).unwrap();
+            let decrypted_message = service.crypto_box_open(&their_key, &my_did.verkey, &encrypted_message, &nonce).unwrap();
+            assert_eq!(msg, decrypted_message.as_slice());
+
+            let (encrypted_message, nonce) = service.crypto_box(&their_key, &my_did.verkey, msg).unwrap();
+            let decrypted_message = service.crypto_box_open_for_wallet(wallet_handle, &my_key, &their_did.verkey, &encrypted_message, &nonce).unwrap();
+            assert_eq!(msg, decrypted_message.as_slice());
+
+            let encrypted_message = service.crypto_box_seal_for_wallet(wallet_handle, &their_did.verkey, msg).unwrap();
+            let decrypted_message = service.crypto_box_seal_open(&their_key, &encrypted_message).unwrap();
+            assert_eq!(msg, decrypted_message.as_slice());
+
+            let encrypted_message = service.crypto_box_seal(&my_did.verkey, msg).unwrap();
+            let decrypted_message = service.crypto_box_seal_open_for_wallet(wallet_handle, &my_key, &encrypted_message).unwrap();
+            assert_eq!(msg, decrypted_message.as_slice());
+        }
+
+        box_key_cache::remove(wallet_handle);
+        box_key_cache::set_size(0);
+    }
+
     #[test]
     pub fn test_encrypt_plaintext_and_decrypt_ciphertext_works() {
         let service: CryptoService = CryptoService::new();
@@ -0,0 +1,212 @@
+use indy_api_types::errors::prelude::*;
+use indy_utils::crypto::hash::{Hash, EMPTY_HASH_BYTES};
+
+use crate::services::ledger::merkletree::merkletree::MerkleTree;
+use crate::services::ledger::merkletree::tree::TreeLeafData;
+
+/// A Merkle tree that keeps only roots of its perfect subtrees instead of all leaves.
+/// It allows to append leaves and to check consistency with the bigger tree
+/// without having the whole ledger in memory.
+#[derive(Clone, Debug, Default)]
+pub struct CompactMerkleTree {
+    /// The number of leaf nodes in the tree
+    count: usize,
+
+    /// Roots of perfect subtrees from the biggest one
+    subtrees: Vec<Vec<u8>>,
+}
+
+impl CompactMerkleTree {
+    /// Restores the tree of `old_size` leaves from consistency proof to the tree of `new_size` leaves.
+    pub fn from_consistency_proof(old_size: usize, old_root_hash: &Vec<u8>,
+                                  new_root_hash: &Vec<u8>, new_size: usize,
+                                  proof: &Vec<Vec<u8>>) -> IndyResult<CompactMerkleTree> {
+        if old_size == 0 {
+            return Ok(CompactMerkleTree::default());
+        }
+
+        let mut subtrees = MerkleTree::check_consistency(old_size, old_root_hash, new_root_hash, new_size, proof)?
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "Consistency proof verification failed"))?;
+
+        if subtrees.len() != old_size.count_ones() as usize {
+            return Err(err_msg(IndyErrorKind::InvalidState, "Consistency proof verification failed"));
+        }
+
+        subtrees.reverse();
+
+        Ok(CompactMerkleTree {
+            count: old_size,
+            subtrees,
+        })
+    }
+
+    pub fn count(&self) -> usize {
+        self.count
+    }
+
+    pub fn append(&mut self, node: TreeLeafData) -> IndyResult<()> {
+        let mut hash = Hash::hash_leaf(&node)?;
+        let mut size = self.count;
+
+        // every trailing set bit of the count is a subtree of the same height as the new one
+        while size % 2 != 0 {
+            let left = self.subtrees.pop()
+                .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "Compact merkle tree is corrupted"))?;
+            hash = Hash::hash_nodes(&left, &hash)?;
+            size /= 2;
+        }
+
+        self.subtrees.push(hash);
+        self.count += 1;
+        Ok(())
+    }
+
+    pub fn root_hash(&self) -> IndyResult<Vec<u8>> {
+        let mut subtrees = self.subtrees.iter().rev();
+
+        let mut hash = match subtrees.next() {
+            Some(hash) => hash.clone(),
+            None => return Ok(EMPTY_HASH_BYTES.to_vec()),
+        };
+
+        for left in subtrees {
+            hash = Hash::hash_nodes(left, &hash)?;
+        }
+
+        Ok(hash)
+    }
+
+    pub fn consistency_proof(&self,
+                             new_root_hash: &Vec<u8>, new_size: usize,
+                             proof: &Vec<Vec<u8>>) -> IndyResult<bool> {
+        if self.count == 0 {
+            // empty old tree
+            return Ok(true);
+        }
+
+        let root_hash = self.root_hash()?;
+
+        if self.count == new_size {
+            return Ok(root_hash == *new_root_hash);
+        }
+
+        Ok(MerkleTree::check_consistency(self.count, &root_hash, new_root_hash, new_size, proof)?.is_some())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rust_base58::FromBase58;
+
+    fn _values() -> Vec<Vec<u8>> {
+        (1..=8).map(|i| format!(r#"{{"data":{{"alias":"Node{}"}},"type":"0"}}"#, i).as_bytes().to_vec()).collect()
+    }
+
+    fn _node_values() -> Vec<Vec<u8>> {
+        vec![
+            r#"{"data":{"alias":"Node1","client_ip":"10.0.0.2","client_port":9702,"node_ip":"10.0.0.2","node_port":9701,"services":["VALIDATOR"]},"dest":"Gw6pDLhcBcoQesN72qfotTgFa7cbuqZpkX3Xo6pLhPhv","identifier":"FYmoFw55GeQH7SRFa37dkx1d2dZ3zUF8ckg7wmL7ofN4","txnId":"fea82e10e894419fe2bea7d96296a6d46f50f93f9eeda954ec461b2ed2950b62","type":"0"}"#,
+            r#"{"data":{"alias":"Node2","client_ip":"10.0.0.2","client_port":9704,"node_ip":"10.0.0.2","node_port":9703,"services":["VALIDATOR"]},"dest":"8ECVSk179mjsjKRLWiQtssMLgp6EPhWXtaYyStWPSGAb","identifier":"8QhFxKxyaFsJy4CyxeYX34dFH8oWqyBv1P4HLQCsoeLy","txnId":"1ac8aece2a18ced660fef8694b61aac3af08ba875ce3026a160acbc3a3af35fc","type":"0"}"#,
+            r#"{"data":{"alias":"Node3","client_ip":"10.0.0.2","client_port":9706,"node_ip":"10.0.0.2","node_port":9705,"services":["VALIDATOR"]},"dest":"DKVxG2fXXTU8yT5N7hGEbXB3dfdAnYv1JczDUHpmDxya","identifier":"2yAeV5ftuasWNgQwVYzeHeTuM7LwwNtPR3Zg9N4JiDgF","txnId":"7e9f355dffa78ed24668f0e0e369fd8c224076571c51e2ea8be5f26479edebe4","type":"0"}"#,
+            r#"{"data":{"alias":"Node4","client_ip":"10.0.0.2","client_port":9708,"node_ip":"10.0.0.2","node_port":9707,"services":["VALIDATOR"]},"dest":"4PS3EDQ3dW1tci1Bp6543CfuuebjFrg36kLAUcskGfaA","identifier":"FTE95CVthRtrBnK2PYCBbC9LghTcGwi9Zfi1Gz2dnyNx","txnId":"aa5e817d7cc626170eca175822029339a444eb0ee8f0bd20d3b0b76e566fb008","type":"0"}"#,
+            r#"{"data":{"alias":"Node5","client_ip":"10.0.0.2","client_port":9710,"node_ip":"10.0.0.2","node_port":9709,"services":["VALIDATOR"]},"dest":"4SWokCJWJc69Tn74VvLS6t2G2ucvXqM9FDMsWJjmsUxe","identifier":"5NekXKJvGrxHvfxbXThySmaG8PmpNarXHCf1CkwTLfrg","txnId":"5abef8bc27d85d53753c5b6ed0cd2e197998c21513a379bfcf44d9c7a73c3a7e","type":"0"}"#,
+            r#"{"data":{"alias":"Node6","client_ip":"10.0.0.2","client_port":9712,"node_ip":"10.0.0.2","node_port":9711,"services":["VALIDATOR"]},"dest":"Cv1Ehj43DDM5ttNBmC6VPpEfwXWwfGktHwjDJsTV5Fz8","identifier":"A2yZJTPHZyqJDELb8E1mhxUqWPEW5vgH2ePLTiTDQayp","txnId":"a23059dc16aaf4513f97ca91f272235e809f8bda8c40f6688b88615a2c318ff8","type":"0"}"#,
+            r#"{"data":{"alias":"Node7","client_ip":"10.0.0.2","client_port":9714,"node_ip":"10.0.0.2","node_port":9713,"services":["VALIDATOR"]},"dest":"BM8dTooz5uykCbYSAAFwKNkYfT4koomBHsSWHTDtkjhW","identifier":"6pYGZXnqXLxLAhrEBhVjyvuhnV2LUgM9iw1gHds8JDqT","txnId":"e5f11aa7ec7091ca6c31a826eec885da7fcaa47611d03fdc3562b48247f179cf","type":"0"}"#,
+            r#"{"data":{"alias":"Node8","client_ip":"10.0.0.2","client_port":9716,"node_ip":"10.0.0.2","node_port":9715,"services":["VALIDATOR"]},"dest":"98VysG35LxrutKTNXvhaztPFHnx5u9kHtT7PnUGqDa8x","identifier":"B4xQBURedpCS3r6v8YxTyz5RYh3Nh5Jt2MxsmtAUr1rH","txnId":"2b01e69f89514be94ebf24bfa270abbe1c5abc72415801da3f0d58e71aaa33a2","type":"0"}"#,
+        ].into_iter().map(|x| x.as_bytes().to_vec()).collect()
+    }
+
+    #[test]
+    fn compact_merkle_tree_append_works() {
+        let values = _values();
+
+        let mut compact = CompactMerkleTree::default();
+        assert_eq!(MerkleTree::default().root_hash(), &compact.root_hash().unwrap());
+
+        for (i, value) in values.iter().enumerate() {
+            compact.append(value.clone()).unwrap();
+
+            let mt = MerkleTree::from_vec(values[..i + 1].to_vec()).unwrap();
+            assert_eq!(mt.count(), compact.count());
+            assert_eq!(mt.root_hash(), &compact.root_hash().unwrap());
+        }
+    }
+
+    #[test]
+    fn compact_merkle_tree_from_consistency_proof_works() {
+        let values = _node_values();
+        let full_root_hash = MerkleTree::from_vec(values.clone()).unwrap().root_hash().clone();
+
+        let proofs_for_5: Vec<Vec<u8>> = vec![
+            "9fVeiDkVJ4YrNB1cy9PEeRYXE5BhxapQsGu85WZ8MyiE",
+            "8p6GotiwYFiWgjMvY7KYNYcbz6hCFBJhcD9Sjo1PQANU",
+            "BqHByHYX9gAHye1SoKKiLXLFB7TDntyUoMtZQjMW2w7U",
+            "BhXMcoxZ9eu3Cu85bzr4G4Msrw77BT3R6Mw6P6bM9wQe"
+        ].into_iter().map(|x| x.from_base58().unwrap()).collect();
+
+        let root_hash_5 = MerkleTree::from_vec(values[..5].to_vec()).unwrap().root_hash().clone();
+
+        let mut compact = CompactMerkleTree::from_consistency_proof(5, &root_hash_5, &full_root_hash, 8, &proofs_for_5).unwrap();
+        assert_eq!(5, compact.count());
+        assert_eq!(root_hash_5, compact.root_hash().unwrap());
+
+        for value in values[5..].iter() {
+            compact.append(value.clone()).unwrap();
+        }
+
+        assert_eq!(full_root_hash, compact.root_hash().unwrap());
+    }
+
+    #[test]
+    fn compact_merkle_tree_from_consistency_proof_works_for_power_of_two() {
+        let values = _node_values();
+        let full_root_hash = MerkleTree::from_vec(values.clone()).unwrap().root_hash().clone();
+        let root_hash_4 = MerkleTree::from_vec(values[..4].to_vec()).unwrap().root_hash().clone();
+        let proof = vec![MerkleTree::from_vec(values[4..].to_vec()).unwrap().root_hash().clone()];
+
+        let mut compact = CompactMerkleTree::from_consistency_proof(4, &root_hash_4, &full_root_hash, 8, &proof).unwrap();
+
+        for value in values[4..].iter() {
+            compact.append(value.clone()).unwrap();
+        }
+
+        assert_eq!(full_root_hash, compact.root_hash().unwrap());
+    }
+
+    #[test]
+    fn compact_merkle_tree_from_consistency_proof_works_for_invalid_proof() {
+        let values = _node_values();
+        let full_root_hash = MerkleTree::from_vec(values.clone()).unwrap().root_hash().clone();
+        let root_hash_4 = MerkleTree::from_vec(values[..4].to_vec()).unwrap().root_hash().clone();
+        let proof = vec![MerkleTree::from_vec(values[3..].to_vec()).unwrap().root_hash().clone()];
+
+        let res = CompactMerkleTree::from_consistency_proof(4, &root_hash_4, &full_root_hash, 8, &proof);
+        assert_kind!(IndyErrorKind::InvalidState, res);
+    }
+
+    #[test]
+    fn compact_merkle_tree_consistency_proof_works() {
+        let values = _node_values();
+        let full_root_hash = MerkleTree::from_vec(values.clone()).unwrap().root_hash().clone();
+
+        let proofs_for_6: Vec<Vec<u8>> = vec![
+            "HhkWitSAXG12Ugn4KFtrUyhbZHi9XrP4jnbLuSthynSu",
+            "BqHByHYX9gAHye1SoKKiLXLFB7TDntyUoMtZQjMW2w7U",
+            "BhXMcoxZ9eu3Cu85bzr4G4Msrw77BT3R6Mw6P6bM9wQe"
+        ].into_iter().map(|x| x.from_base58().unwrap()).collect();
+
+        let mut compact = CompactMerkleTree::default();
+        for value in values[..6].iter() {
+            compact.append(value.clone()).unwrap();
+        }
+
+        assert!(compact.consistency_proof(&full_root_hash, 8, &proofs_for_6).unwrap());
+        assert!(!compact.consistency_proof(&full_root_hash, 8, &vec![]).unwrap());
+
+        for value in values[6..].iter() {
+            compact.append(value.clone()).unwrap();
+        }
+
+        assert!(compact.consistency_proof(&full_root_hash, 8, &vec![]).unwrap());
+    }
+}
@@ -1,6 +1,7 @@
 pub mod tree;
 pub mod proof;
 pub mod merkletree;
+pub mod compact;
 
 use self::tree::*;
 use self::merkletree::*;
@@ -74,7 +75,20 @@ impl MerkleTree {
             return Ok(false);
         }
 
-        let mut old_node = self.count - 1;
+        Ok(MerkleTree::check_consistency(self.count, self.root_hash(), new_root_hash, new_size, proof)?.is_some())
+    }
+
+    /// Checks consistency proof between old tree (known only by size and root hash) and new tree.
+    /// Returns roots of perfect subtrees of the old tree (from the smallest one) proven by the proof
+    /// or None if the proof is invalid.
+    pub fn check_consistency(old_size: usize, old_root_hash: &Vec<u8>,
+                             new_root_hash: &Vec<u8>, new_size: usize,
+                             proof: &Vec<Vec<u8>>) -> IndyResult<Option<Vec<Vec<u8>>>> {
+        if old_size == 0 || old_size > new_size {
+            return Ok(None);
+        }
+
+        let mut old_node = old_size - 1;
         let mut new_node = new_size - 1;
 
         while old_node % 2 != 0 {
@@ -87,43 +101,46 @@ impl MerkleTree {
         let mut new_hash: Vec<u8>;
 
         if old_node != 0 {
-            new_hash = unwrap_opt_or_return!(proofs.next(), Ok(false)).to_vec();
+            new_hash = unwrap_opt_or_return!(proofs.next(), Ok(None)).to_vec();
             old_hash = new_hash.clone();
         } else {
-            new_hash = self.root_hash().to_vec();
+            new_hash = old_root_hash.to_vec();
             old_hash = new_hash.clone();
         }
 
+        let mut old_subtrees = vec![old_hash.clone()];
+
         while old_node != 0 {
             if old_node % 2 != 0 {
-                let next_proof = unwrap_opt_or_return!(proofs.next(), Ok(false));
+                let next_proof = unwrap_opt_or_return!(proofs.next(), Ok(None));
                 old_hash = Hash::hash_nodes(next_proof, &old_hash)?.to_vec();
                 new_hash = Hash::hash_nodes(next_proof, &new_hash)?.to_vec();
+                old_subtrees.push(next_proof.to_vec());
             } else if old_node < new_node {
                 new_hash = Hash::hash_nodes(&new_hash,
-                                            unwrap_opt_or_return!(proofs.next(), Ok(false)))?.to_vec();
+                                            unwrap_opt_or_return!(proofs.next(), Ok(None)))?.to_vec();
             }
             old_node /= 2;
             new_node /= 2;
         }
 
         while new_node != 0 {
-            let n = unwrap_opt_or_return!(proofs.next(), Ok(false));
+            let n = unwrap_opt_or_return!(proofs.next(), Ok(None));
             new_hash = Hash::hash_nodes(&new_hash, n)?.to_vec();
             new_node /= 2;
         }
 
         if new_hash != *new_root_hash {
             // new hash differs
-            return Ok(false);
+            return Ok(None);
         }
 
-        if old_hash != *self.root_hash() {
+        if old_hash != *old_root_hash {
             // old hash differs
-            return Ok(false);
+            return Ok(None);
         }
 
-        Ok(true)
+        Ok(Some(old_subtrees))
     }
 
     pub fn append(&mut self, node: TreeLeafData) -> IndyResult<()> {
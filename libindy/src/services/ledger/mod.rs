@@ -48,6 +48,15 @@ macro_rules! build_result {
         })
     }
 
+macro_rules! build_value_result {
+        ($operation:ident, $submitter_did:expr, $($params:tt)*) => ({
+            let operation = $operation::new($($params)*);
+
+            Request::build_request_value($submitter_did, operation)
+                .map_err(|err| IndyError::from_msg(IndyErrorKind::InvalidState, err))
+        })
+    }
+
 pub struct LedgerService {}
 
 impl LedgerService {
@@ -58,6 +67,26 @@ impl LedgerService {
     #[logfn(Info)]
     pub fn build_nym_request(&self, identifier: &DidValue, dest: &DidValue, verkey: Option<&str>,
                              alias: Option<&str>, role: Option<&str>) -> IndyResult<String> {
+        let role = LedgerService::_nym_role(role)?;
+
+        build_result!(NymOperation, Some(identifier), dest.to_short(),
+                                                      verkey.map(String::from),
+                                                      alias.map(String::from),
+                                                      role)
+    }
+
+    #[logfn(Info)]
+    pub fn build_nym_request_value(&self, identifier: &DidValue, dest: &DidValue, verkey: Option<&str>,
+                                   alias: Option<&str>, role: Option<&str>) -> IndyResult<Value> {
+        let role = LedgerService::_nym_role(role)?;
+
+        build_value_result!(NymOperation, Some(identifier), dest.to_short(),
+                                                            verkey.map(String::from),
+                                                            alias.map(String::from),
+                                                            role)
+    }
+
+    fn _nym_role(role: Option<&str>) -> IndyResult<Option<Value>> {
         let role = if let Some(r) = role {
             Some(
                 if r == ROLE_REMOVE {
@@ -77,10 +106,7 @@ impl LedgerService {
             )
         } else { None };
 
-        build_result!(NymOperation, Some(identifier), dest.to_short(),
-                                                      verkey.map(String::from),
-                                                      alias.map(String::from),
-                                                      role)
+        Ok(role)
     }
 
     #[logfn(Info)]
@@ -135,6 +161,15 @@ impl LedgerService {
                                                          enc.map(String::from))
     }
 
+    #[logfn(Info)]
+    pub fn build_attrib_request_value(&self, identifier: &DidValue, dest: &DidValue, hash: Option<&str>,
+                                      raw: Option<&serde_json::Value>, enc: Option<&str>) -> IndyResult<Value> {
+        build_value_result!(AttribOperation, Some(identifier), dest.to_short(),
+                                                               hash.map(String::from),
+                                                               raw.map(serde_json::Value::to_string),
+                                                               enc.map(String::from))
+    }
+
     #[logfn(Info)]
     pub fn build_get_attrib_request(&self, identifier: Option<&DidValue>, dest: &DidValue, raw: Option<&str>, hash: Option<&str>,
                                     enc: Option<&str>) -> IndyResult<String> {
@@ -197,16 +232,22 @@ impl LedgerService {
 
     #[logfn(Info)]
     pub fn build_get_txn_request(&self, identifier: Option<&DidValue>, ledger_type: Option<&str>, seq_no: i32) -> IndyResult<String> {
-        let ledger_id = match ledger_type {
+        let ledger_id = self.parse_ledger_type(ledger_type)?;
+
+        build_result!(GetTxnOperation, identifier, seq_no, ledger_id)
+    }
+
+    /// Resolves ledger id by predefined ledger type name (`DOMAIN`, `POOL`, `CONFIG`, `AUDIT`) or any number.
+    /// `DOMAIN` ledger is used if type isn't set.
+    pub fn parse_ledger_type(&self, ledger_type: Option<&str>) -> IndyResult<i32> {
+        match ledger_type {
             Some(type_) =>
                 serde_json::from_str::<LedgerType>(&format!(r#""{}""#, type_))
                     .map(|type_| type_.to_id())
                     .or_else(|_| type_.parse::<i32>())
-                    .to_indy(IndyErrorKind::InvalidStructure, format!("Invalid Ledger type: {}", type_))?,
-            None => LedgerType::DOMAIN.to_id()
-        };
-
-        build_result!(GetTxnOperation, identifier, seq_no, ledger_id)
+                    .to_indy(IndyErrorKind::InvalidStructure, format!("Invalid Ledger type: {}", type_)),
+            None => Ok(LedgerType::DOMAIN.to_id())
+        }
     }
 
     #[logfn(Info)]
@@ -600,6 +641,21 @@ mod tests {
         check_request(&request, expected_result);
     }
 
+    #[test]
+    fn build_nym_request_value_works() {
+        let ledger_service = LedgerService::new();
+
+        let expected_result = json!({
+            "type": NYM,
+            "dest": DEST,
+            "role": "0"
+        });
+
+        let request = ledger_service.build_nym_request_value(&identifier(), &dest(), None, None, Some("TRUSTEE")).unwrap();
+        assert_eq!(request["operation"], expected_result);
+        assert_eq!(request["identifier"], json!(identifier().to_short().0));
+    }
+
     #[test]
     fn build_nym_request_works_for_empty_role() {
         let ledger_service = LedgerService::new();
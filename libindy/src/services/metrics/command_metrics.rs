@@ -46,6 +46,12 @@ impl From<&IssuerCommand> for CommandMetric {
             IssuerCommand::CreateAndStoreCredentialDefinitionContinue(_, _, _, _, _, _, _, _) => {
                 CommandMetric::IssuerCommandCreateAndStoreCredentialDefinitionContinue
             }
+            IssuerCommand::FillCredentialDefinitionKeyPool(_, _, _, _) => {
+                CommandMetric::IssuerCommandFillCredentialDefinitionKeyPool
+            }
+            IssuerCommand::FillCredentialDefinitionKeyPoolContinue(_, _, _, _) => {
+                CommandMetric::IssuerCommandFillCredentialDefinitionKeyPoolContinue
+            }
             IssuerCommand::RotateCredentialDefinitionStart(_, _, _, _) => {
                 CommandMetric::IssuerCommandRotateCredentialDefinitionStart
             }
@@ -193,6 +199,20 @@ impl From<&Command> for CommandMetric {
                     LedgerCommand::AppendRequestEndorser(_, _, _) => { CommandMetric::LedgerCommandAppendRequestEndorser }
                     LedgerCommand::BuildGetFrozenLedgersRequest(_,_,) => { CommandMetric::LedgerCommandBuildGetFrozenLedgersRequest }
                     LedgerCommand::BuildLedgersFreezeRequest(_,_,_,) => { CommandMetric::LedgerCommandBuildLedgersFreezeRequest }
+                    LedgerCommand::BuildNymRequestHandle(_, _, _, _, _, _) => { CommandMetric::LedgerCommandBuildNymRequestHandle }
+                    LedgerCommand::BuildAttribRequestHandle(_, _, _, _, _, _) => { CommandMetric::LedgerCommandBuildAttribRequestHandle }
+                    LedgerCommand::RequestHandleFromJson(_, _) => { CommandMetric::LedgerCommandRequestHandleFromJson }
+                    LedgerCommand::RequestHandleToJson(_, _) => { CommandMetric::LedgerCommandRequestHandleToJson }
+                    LedgerCommand::SignRequestHandle(_, _, _, _) => { CommandMetric::LedgerCommandSignRequestHandle }
+                    LedgerCommand::MultiSignRequestHandle(_, _, _, _) => { CommandMetric::LedgerCommandMultiSignRequestHandle }
+                    LedgerCommand::SubmitRequestHandle(_, _, _) => { CommandMetric::LedgerCommandSubmitRequestHandle }
+                    LedgerCommand::SignAndSubmitRequestHandle(_, _, _, _, _) => { CommandMetric::LedgerCommandSignAndSubmitRequestHandle }
+                    LedgerCommand::ReleaseRequestHandle(_, _) => { CommandMetric::LedgerCommandReleaseRequestHandle }
+                    LedgerCommand::OpenLedgerTxnsRange(_, _, _, _, _) => { CommandMetric::LedgerCommandOpenLedgerTxnsRange }
+                    LedgerCommand::OpenLedgerTxnsRangeContinue(_, _, _, _, _, _) => { CommandMetric::LedgerCommandOpenLedgerTxnsRangeContinue }
+                    LedgerCommand::FetchLedgerTxnsRange(_, _, _) => { CommandMetric::LedgerCommandFetchLedgerTxnsRange }
+                    LedgerCommand::FetchLedgerTxnsRangeContinue(_, _, _, _) => { CommandMetric::LedgerCommandFetchLedgerTxnsRangeContinue }
+                    LedgerCommand::CloseLedgerTxnsRange(_, _) => { CommandMetric::LedgerCommandCloseLedgerTxnsRange }
                 }
             }
             Command::Pool(cmd) => {
@@ -232,10 +252,14 @@ impl From<&Command> for CommandMetric {
             Command::Wallet(cmd) => {
                 match cmd {
                     WalletCommand::RegisterWalletType(_, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _) => { CommandMetric::WalletCommandRegisterWalletType }
+                    WalletCommand::RegisterWalletTypeAddRecords(_, _, _) => { CommandMetric::WalletCommandRegisterWalletTypeAddRecords }
+                    WalletCommand::RegisterWalletTypeDeleteRecords(_, _, _) => { CommandMetric::WalletCommandRegisterWalletTypeDeleteRecords }
                     WalletCommand::Create(_, _, _) => { CommandMetric::WalletCommandCreate }
                     WalletCommand::CreateContinue(_, _, _, _, _) => { CommandMetric::WalletCommandCreateContinue }
                     WalletCommand::Open(_, _, _) => { CommandMetric::WalletCommandOpen }
                     WalletCommand::OpenContinue(_, _) => { CommandMetric::WalletCommandOpenContinue }
+                    WalletCommand::OpenMany(_, _) => { CommandMetric::WalletCommandOpenMany }
+                    WalletCommand::OpenManyContinue(_, _, _, _) => { CommandMetric::WalletCommandOpenManyContinue }
                     WalletCommand::Close(_, _) => { CommandMetric::WalletCommandClose }
                     WalletCommand::Delete(_, _, _) => { CommandMetric::WalletCommandDelete }
                     WalletCommand::DeleteContinue(_, _, _, _, _) => { CommandMetric::WalletCommandDeleteContinue }
@@ -243,6 +267,7 @@ impl From<&Command> for CommandMetric {
                     WalletCommand::ExportContinue(_, _, _, _, _) => { CommandMetric::WalletCommandExportContinue }
                     WalletCommand::Import(_, _, _, _) => { CommandMetric::WalletCommandImport }
                     WalletCommand::ImportContinue(_, _, _, _, _) => { CommandMetric::WalletCommandImportContinue }
+                    WalletCommand::Compact(_, _, _) => { CommandMetric::WalletCommandCompact }
                     WalletCommand::GenerateKey(_, _) => { CommandMetric::WalletCommandGenerateKey }
                     WalletCommand::DeriveKey(_, _) => { CommandMetric::WalletCommandDeriveKey }
                 }
@@ -264,6 +289,7 @@ impl From<&Command> for CommandMetric {
                     NonSecretsCommand::AddRecordTags(_, _, _, _, _) => { CommandMetric::NonSecretsCommandAddRecordTags }
                     NonSecretsCommand::DeleteRecordTags(_, _, _, _, _) => { CommandMetric::NonSecretsCommandDeleteRecordTags }
                     NonSecretsCommand::DeleteRecord(_, _, _, _) => { CommandMetric::NonSecretsCommandDeleteRecord }
+                    NonSecretsCommand::DeleteRecords(_, _, _, _) => { CommandMetric::NonSecretsCommandDeleteRecords }
                     NonSecretsCommand::GetRecord(_, _, _, _, _) => { CommandMetric::NonSecretsCommandGetRecord }
                     NonSecretsCommand::OpenSearch(_, _, _, _, _) => { CommandMetric::NonSecretsCommandOpenSearch }
                     NonSecretsCommand::FetchSearchNextRecords(_, _, _, _) => { CommandMetric::NonSecretsCommandFetchSearchNextRecords }
@@ -333,6 +359,8 @@ pub enum CommandMetric {
     IssuerCommandCreateSchema,
     IssuerCommandCreateAndStoreCredentialDefinition,
     IssuerCommandCreateAndStoreCredentialDefinitionContinue,
+    IssuerCommandFillCredentialDefinitionKeyPool,
+    IssuerCommandFillCredentialDefinitionKeyPoolContinue,
     IssuerCommandRotateCredentialDefinitionStart,
     IssuerCommandRotateCredentialDefinitionStartComplete,
     IssuerCommandRotateCredentialDefinitionApply,
@@ -431,6 +459,20 @@ pub enum CommandMetric {
     LedgerCommandAppendRequestEndorser,
     LedgerCommandBuildGetFrozenLedgersRequest,
     LedgerCommandBuildLedgersFreezeRequest,
+    LedgerCommandBuildNymRequestHandle,
+    LedgerCommandBuildAttribRequestHandle,
+    LedgerCommandRequestHandleFromJson,
+    LedgerCommandRequestHandleToJson,
+    LedgerCommandSignRequestHandle,
+    LedgerCommandMultiSignRequestHandle,
+    LedgerCommandSubmitRequestHandle,
+    LedgerCommandSignAndSubmitRequestHandle,
+    LedgerCommandReleaseRequestHandle,
+    LedgerCommandOpenLedgerTxnsRange,
+    LedgerCommandOpenLedgerTxnsRangeContinue,
+    LedgerCommandFetchLedgerTxnsRange,
+    LedgerCommandFetchLedgerTxnsRangeContinue,
+    LedgerCommandCloseLedgerTxnsRange,
     // PoolCommand
     PoolCommandCreate,
     PoolCommandDelete,
@@ -461,10 +503,14 @@ pub enum CommandMetric {
     DidCommandQualifyDid,
     // WalletCommand
     WalletCommandRegisterWalletType,
+    WalletCommandRegisterWalletTypeAddRecords,
+    WalletCommandRegisterWalletTypeDeleteRecords,
     WalletCommandCreate,
     WalletCommandCreateContinue,
     WalletCommandOpen,
     WalletCommandOpenContinue,
+    WalletCommandOpenMany,
+    WalletCommandOpenManyContinue,
     WalletCommandClose,
     WalletCommandDelete,
     WalletCommandDeleteContinue,
@@ -472,6 +518,7 @@ pub enum CommandMetric {
     WalletCommandExportContinue,
     WalletCommandImport,
     WalletCommandImportContinue,
+    WalletCommandCompact,
     WalletCommandGenerateKey,
     WalletCommandDeriveKey,
     // PairwiseCommand
@@ -487,6 +534,7 @@ pub enum CommandMetric {
     NonSecretsCommandAddRecordTags,
     NonSecretsCommandDeleteRecordTags,
     NonSecretsCommandDeleteRecord,
+    NonSecretsCommandDeleteRecords,
     NonSecretsCommandGetRecord,
     NonSecretsCommandOpenSearch,
     NonSecretsCommandFetchSearchNextRecords,
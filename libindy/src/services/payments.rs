@@ -717,7 +717,7 @@ mod cbs {
             } else {
                 Err(err.into())
             };
-            CommandExecutor::instance().send(Command::Payments(
+            CommandExecutor::instance().send_internal(Command::Payments(
                 builder(cmd_handle, result))).into()
         }))
     }
@@ -732,7 +732,7 @@ mod cbs {
             } else {
                 Err(err.into())
             };
-            CommandExecutor::instance().send(Command::Payments(
+            CommandExecutor::instance().send_internal(Command::Payments(
                 builder(cmd_handle, result))).into()
         }))
     }
@@ -747,7 +747,7 @@ mod cbs {
                 } else {
                     Err(err.into())
                 };
-                CommandExecutor::instance().send(Command::Payments(builder(cmd_handle, result))).into()
+                CommandExecutor::instance().send_internal(Command::Payments(builder(cmd_handle, result))).into()
             }))
     }
 
@@ -760,7 +760,7 @@ mod cbs {
             } else {
                 Err(err.into())
             };
-            CommandExecutor::instance().send(Command::Payments(builder(cmd_handle, result))).into()
+            CommandExecutor::instance().send_internal(Command::Payments(builder(cmd_handle, result))).into()
         }))
     }
 
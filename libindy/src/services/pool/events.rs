@@ -154,6 +154,14 @@ pub enum RequestEvent {
         ConsistencyProof,
         String, //node alias
     ),
+    LedgerTxnsTargetRequest(
+        String, // message
+        String, // req_id
+    ),
+    LedgerTxnsRequest(
+        String, // message
+        String, // req_id
+    ),
     Reply(
         Reply,
         String, //raw_msg
@@ -194,9 +202,34 @@ impl RequestEvent {
             RequestEvent::ReqACK(_, _, _, ref id) => id.to_string(),
             RequestEvent::ReqNACK(_, _, _, ref id) => id.to_string(),
             RequestEvent::Reject(_, _, _, ref id) => id.to_string(),
+            RequestEvent::LedgerTxnsTargetRequest(_, ref id) => id.to_string(),
+            RequestEvent::LedgerTxnsRequest(_, ref id) => id.to_string(),
+            RequestEvent::LedgerStatus(ref ls, Some(_), None) => ledger_status_req_id(ls.ledgerId as usize),
+            RequestEvent::ConsistencyProof(ref cp, _) => ledger_status_req_id(cp.ledgerId),
+            RequestEvent::CatchupRep(ref cr, _) => cr.min_tx()
+                .map(|seq_no_start| catchup_req_id(cr.ledgerId, seq_no_start))
+                .unwrap_or_default(),
             _ => "".to_string()
         }
     }
+
+    /// Only one request of this kind for a ledger and position can be in progress
+    /// as replies of the nodes don't contain request id.
+    pub fn is_ledger_txns_request(&self) -> bool {
+        match *self {
+            RequestEvent::LedgerTxnsTargetRequest(_, _) |
+            RequestEvent::LedgerTxnsRequest(_, _) => true,
+            _ => false
+        }
+    }
+}
+
+pub fn ledger_status_req_id(ledger_id: usize) -> String {
+    format!("LEDGER_STATUS:{}", ledger_id)
+}
+
+pub fn catchup_req_id(ledger_id: usize, seq_no_start: usize) -> String {
+    format!("CATCHUP_REQ:{}:{}", ledger_id, seq_no_start)
 }
 
 impl Into<Option<RequestEvent>> for PoolEvent {
@@ -250,6 +283,8 @@ impl Into<Option<RequestEvent>> for PoolEvent {
                     } else {
                         Some(RequestEvent::CustomConsensusRequest(msg, req_id.clone()))
                     }
+                } else if let Some(event) = _parse_ledger_txns_request(&msg) {
+                    Some(event)
                 } else {
                     error!("Can't parse parsed_req or op from message {}", msg);
                     None
@@ -281,6 +316,20 @@ fn _parse_timestamp_from_req_for_builtin_sp(req: &SJsonValue, op: &str) -> (Opti
     }
 }
 
+fn _parse_ledger_txns_request(msg: &str) -> Option<RequestEvent> {
+    match Message::from_raw_str(msg).ok()? {
+        Message::LedgerStatus(ls) => {
+            let req_id = ledger_status_req_id(ls.ledgerId as usize);
+            Some(RequestEvent::LedgerTxnsTargetRequest(msg.to_string(), req_id))
+        }
+        Message::CatchupReq(cr) => {
+            let req_id = catchup_req_id(cr.ledgerId, cr.seqNoStart);
+            Some(RequestEvent::LedgerTxnsRequest(msg.to_string(), req_id))
+        }
+        _ => None
+    }
+}
+
 fn _parse_msg(msg: &str) -> Option<Message> {
     Message::from_raw_str(msg).map_err(map_err_trace!()).ok()
 }
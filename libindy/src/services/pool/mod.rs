@@ -20,6 +20,7 @@ use serde::de::DeserializeOwned;
 use crate::api::ledger::{CustomFree, CustomTransactionParser};
 use crate::domain::{
     pool::{PoolConfig, PoolOpenConfig},
+    ledger::request::ProtocolVersion,
     ledger::response::{
         Message,
         Reply,
@@ -27,12 +28,18 @@ use crate::domain::{
     }
 };
 use indy_api_types::errors::*;
-use crate::services::pool::pool::{Pool, ZMQPool};
+use crate::services::pool::pool::{io_threads_count, Pool, ZMQPool};
 use crate::utils::environment;
 use crate::services::pool::events::{COMMAND_EXIT, COMMAND_CONNECT, COMMAND_REFRESH};
 use indy_api_types::{CommandHandle, PoolHandle};
 use indy_utils::{next_command_handle, next_pool_handle};
 use ursa::bls::VerKey;
+use indy_utils::crypto::hash::EMPTY_HASH_BYTES;
+use rust_base58::ToBase58;
+
+pub use self::networker::sockets_stats;
+pub use self::pool::set_io_threads_count;
+pub use self::types::{CatchupRep, ConsistencyProof};
 
 mod catchup;
 mod commander;
@@ -158,7 +165,11 @@ impl PoolService {
 
         let (send_cmd_sock, recv_cmd_sock) = pool_create_pair_of_sockets(&format!("pool_{}", name));
 
-        new_pool.work(recv_cmd_sock);
+        if io_threads_count() > 0 {
+            new_pool.work_shared(recv_cmd_sock)?;
+        } else {
+            new_pool.work(recv_cmd_sock);
+        }
         self._send_msg(pool_handle, COMMAND_CONNECT, &send_cmd_sock, None, None)?;
 
         self.pending_pools.try_borrow_mut()?
@@ -193,6 +204,43 @@ impl PoolService {
         }
     }
 
+    /// Sends LEDGER_STATUS of the ledger with `txn_seq_no` transactions to all nodes.
+    /// The reply is ConsistencyProof json from `txn_seq_no` to the current ledger size agreed by f+1 nodes.
+    pub fn send_ledger_status(&self, handle: PoolHandle, ledger_id: u8, txn_seq_no: usize) -> IndyResult<CommandHandle> {
+        let protocol_version = ProtocolVersion::get();
+
+        // nodes build consistency proof from their own ledger, so the root isn't known here
+        let ledger_status = types::LedgerStatus {
+            txnSeqNo: txn_seq_no,
+            merkleRoot: EMPTY_HASH_BYTES.to_base58(),
+            ledgerId: ledger_id,
+            ppSeqNo: None,
+            viewNo: None,
+            protocolVersion: if protocol_version > 1 { Some(protocol_version) } else { None },
+        };
+
+        let msg = serde_json::to_string(&types::Message::LedgerStatus(ledger_status))
+            .to_indy(IndyErrorKind::InvalidState, "Cannot serialize LedgerStatus")?;
+
+        self.send_tx(handle, &msg)
+    }
+
+    /// Sends CATCHUP_REQ for transactions `seq_no_start..=seq_no_end` of the ledger to one of the nodes.
+    /// The reply is CatchupRep json with consistency proof to the ledger of `catchup_till` size.
+    pub fn send_catchup_req(&self, handle: PoolHandle, ledger_id: usize, seq_no_start: usize, seq_no_end: usize, catchup_till: usize) -> IndyResult<CommandHandle> {
+        let catchup_req = types::CatchupReq {
+            ledgerId: ledger_id,
+            seqNoStart: seq_no_start,
+            seqNoEnd: seq_no_end,
+            catchupTill: catchup_till,
+        };
+
+        let msg = serde_json::to_string(&types::Message::CatchupReq(catchup_req))
+            .to_indy(IndyErrorKind::InvalidState, "Cannot serialize CatchupReq")?;
+
+        self.send_tx(handle, &msg)
+    }
+
     pub fn register_sp_parser(txn_type: &str,
                               parser: CustomTransactionParser, free: CustomFree) -> IndyResult<()> {
         if events::REQUESTS_FOR_STATE_PROOFS.contains(&txn_type) {
@@ -1,5 +1,6 @@
 use std::cell::RefCell;
 use std::collections::{BTreeMap, HashMap, HashSet};
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 use rand::thread_rng;
 use rand::prelude::SliceRandom;
@@ -16,8 +17,27 @@ use super::time::Duration;
 use super::zmq::PollItem;
 use super::zmq::Socket as ZSocket;
 
+static SOCKETS_OPENED: AtomicUsize = AtomicUsize::new(0);
+static SOCKETS_REUSED: AtomicUsize = AtomicUsize::new(0);
+
+pub struct SocketsStats {
+    pub opened: usize,
+    pub reused: usize,
+}
+
+/// Returns how many node sockets were opened and how many were handed over to a new pool connection
+/// by all networkers since start.
+pub fn sockets_stats() -> SocketsStats {
+    SocketsStats {
+        opened: SOCKETS_OPENED.load(Ordering::Relaxed),
+        reused: SOCKETS_REUSED.load(Ordering::Relaxed),
+    }
+}
+
+type IdleSockets = HashMap<RemoteNode, Vec<(ZSocket, Tm)>>;
+
 pub trait Networker {
-    fn new(active_timeout: i64, conn_limit: usize, preordered_nodes: Vec<String>, socks_proxy: String) -> Self;
+    fn new(active_timeout: i64, conn_limit: usize, preordered_nodes: Vec<String>, socks_proxy: String, idle_timeout: i64) -> Self;
     fn fetch_events(&self, poll_items: &[PollItem]) -> Vec<PoolEvent>;
     fn process_event(&mut self, pe: Option<NetworkerEvent>) -> Option<RequestEvent>;
     fn get_timeout(&self) -> ((String, String), i64);
@@ -32,10 +52,15 @@ pub struct ZMQNetworker {
     conn_limit: usize,
     preordered_nodes: Vec<String>,
     socks_proxy: String,
+    idle_timeout: i64,
+    ctx: zmq::Context,
+    // Connected sockets of retired pool connections with their expiration time, new connections take them
+    // instead of opening new sockets and passing CurveZMQ handshakes again
+    idle_sockets: IdleSockets,
 }
 
 impl Networker for ZMQNetworker {
-    fn new(active_timeout: i64, conn_limit: usize, preordered_nodes: Vec<String>, socks_proxy: String) -> Self {
+    fn new(active_timeout: i64, conn_limit: usize, preordered_nodes: Vec<String>, socks_proxy: String, idle_timeout: i64) -> Self {
         ZMQNetworker {
             req_id_mappings: HashMap::new(),
             pool_connections: BTreeMap::new(),
@@ -44,6 +69,9 @@ impl Networker for ZMQNetworker {
             conn_limit,
             preordered_nodes,
             socks_proxy,
+            idle_timeout,
+            ctx: zmq::Context::new(),
+            idle_sockets: HashMap::new(),
         }
     }
 
@@ -57,6 +85,8 @@ impl Networker for ZMQNetworker {
     }
 
     fn process_event(&mut self, pe: Option<NetworkerEvent>) -> Option<RequestEvent> {
+        self._drop_expired_sockets();
+
         match pe.clone() {
             Some(NetworkerEvent::SendAllRequest(_, req_id, _, _)) | Some(NetworkerEvent::SendOneRequest(_, req_id, _)) | Some(NetworkerEvent::Resend(req_id, _)) => {
                 let num = self.req_id_mappings.get(&req_id).copied().or_else(|| {
@@ -86,7 +116,8 @@ impl Networker for ZMQNetworker {
                     None => {
                         trace!("send request in new conn");
                         let pc_id = sequence::get_next_id();
-                        let mut pc = PoolConnection::new(self.nodes.clone(), self.active_timeout, self.preordered_nodes.clone(), self.socks_proxy.clone());
+                        let mut pc = PoolConnection::new(self.nodes.clone(), self.active_timeout, self.preordered_nodes.clone(), self.socks_proxy.clone(), self.ctx.clone());
+                        pc.reuse_sockets(&mut self.idle_sockets);
                         pc.send_request(pe).expect("FIXME");
                         self.pool_connections.insert(pc_id, pc);
                         self.req_id_mappings.insert(req_id.clone(), pc_id);
@@ -97,6 +128,8 @@ impl Networker for ZMQNetworker {
             Some(NetworkerEvent::NodesStateUpdated(nodes)) => {
                 trace!("ZMQNetworker::process_event: nodes_updated {:?}", nodes);
                 self.nodes = nodes;
+                let nodes = &self.nodes;
+                self.idle_sockets.retain(|node, _| nodes.contains(node));
                 None
             }
             Some(NetworkerEvent::ExtendTimeout(req_id, node_alias, timeout)) => {
@@ -127,9 +160,8 @@ impl Networker for ZMQNetworker {
                             }
                         }
                     );
-                    if let Some(idx) = idx_pc_to_delete {
-                        trace!("removing pool connection {}", idx);
-                        self.pool_connections.remove(idx);
+                    if let Some(idx) = idx_pc_to_delete.copied() {
+                        self._remove_connection(idx);
                     }
                 }
 
@@ -144,10 +176,7 @@ impl Networker for ZMQNetworker {
                     .filter(|(_, v)| v.is_orphaned())
                     .map(|(k, _)| *k)
                     .collect();
-                pc_to_delete.iter().for_each(|idx| {
-                    trace!("removing pool connection {}", idx);
-                    self.pool_connections.remove(idx);
-                });
+                pc_to_delete.into_iter().for_each(|idx| self._remove_connection(idx));
                 None
             }
             _ => None
@@ -155,8 +184,13 @@ impl Networker for ZMQNetworker {
     }
 
     fn get_timeout(&self) -> ((String, String), i64) {
+        let idle_timeouts = self.idle_sockets.values()
+            .flat_map(|sockets| sockets.iter())
+            .map(|&(_, expires)| (("".to_string(), "".to_string()), (expires - time::now()).num_milliseconds()));
+
         self.pool_connections.values()
             .map(PoolConnection::get_timeout)
+            .chain(idle_timeouts)
             .min_by(|&(_, val1), &(_, val2)| val1.cmp(&val2))
             .unwrap_or((("".to_string(), "".to_string()), ::std::i64::MAX))
     }
@@ -167,6 +201,39 @@ impl Networker for ZMQNetworker {
     }
 }
 
+impl ZMQNetworker {
+    fn _remove_connection(&mut self, idx: i32) {
+        trace!("removing pool connection {}", idx);
+
+        let pc = match self.pool_connections.remove(&idx) {
+            Some(pc) => pc,
+            None => return
+        };
+
+        if self.idle_timeout <= 0 {
+            return;
+        }
+
+        let expires = time::now() + Duration::seconds(self.idle_timeout);
+
+        for (node, socket) in pc.nodes.into_iter().zip(pc.sockets.into_iter()) {
+            if let Some(socket) = socket {
+                if self.nodes.contains(&node) {
+                    self.idle_sockets.entry(node).or_insert_with(Vec::new).push((socket, expires));
+                }
+            }
+        }
+    }
+
+    fn _drop_expired_sockets(&mut self) {
+        let now = time::now();
+        for sockets in self.idle_sockets.values_mut() {
+            sockets.retain(|&(_, expires)| expires > now);
+        }
+        self.idle_sockets.retain(|_, sockets| !sockets.is_empty());
+    }
+}
+
 pub struct PoolConnection {
     nodes: Vec<RemoteNode>,
     sockets: Vec<Option<ZSocket>>,
@@ -181,7 +248,7 @@ pub struct PoolConnection {
 }
 
 impl PoolConnection {
-    fn new(mut nodes: Vec<RemoteNode>, active_timeout: i64, preordered_nodes: Vec<String>, socks_proxy: String) -> Self {
+    fn new(mut nodes: Vec<RemoteNode>, active_timeout: i64, preordered_nodes: Vec<String>, socks_proxy: String, ctx: zmq::Context) -> Self {
         trace!("PoolConnection::new: from nodes {:?}", nodes);
 
         nodes.shuffle(&mut thread_rng());
@@ -201,7 +268,7 @@ impl PoolConnection {
         PoolConnection {
             nodes,
             sockets,
-            ctx: zmq::Context::new(),
+            ctx,
             key_pair: zmq::CurveKeyPair::new().expect("FIXME"),
             resend: RefCell::new(HashMap::new()),
             time_created: time::now(),
@@ -212,6 +279,19 @@ impl PoolConnection {
         }
     }
 
+    /// Takes the most recently released idle sockets to nodes of this connection.
+    fn reuse_sockets(&mut self, idle_sockets: &mut IdleSockets) {
+        for (node, socket) in self.nodes.iter().zip(self.sockets.iter_mut()) {
+            if let Some((s, _)) = idle_sockets.get_mut(node).and_then(|sockets| sockets.pop()) {
+                // Late replies to requests of the retired connection are not expected by anyone
+                while s.recv_bytes(zmq::DONTWAIT).is_ok() {}
+                debug!("reuse_sockets: reuse idle socket for node {}", node.name);
+                SOCKETS_REUSED.fetch_add(1, Ordering::Relaxed);
+                *socket = Some(s);
+            }
+        }
+    }
+
     fn fetch_events(&self, poll_items: &[zmq::PollItem]) -> Vec<PoolEvent> {
         let mut vec = Vec::new();
         let mut pi_idx = 0;
@@ -336,6 +416,7 @@ impl PoolConnection {
         if self.sockets[idx].is_none() {
             debug!("_get_socket: open new socket for node {}", idx);
             let s: ZSocket = self.nodes[idx].connect(&self.ctx, &self.key_pair, self.socks_proxy.clone())?;
+            SOCKETS_OPENED.fetch_add(1, Ordering::Relaxed);
             self.sockets[idx] = Some(s)
         }
         Ok(self.sockets[idx].as_ref().unwrap())
@@ -375,14 +456,14 @@ pub struct MockNetworker {
 
 #[cfg(test)]
 impl Networker for MockNetworker {
-    fn new(_active_timeout: i64, _conn_limit: usize, _preordered_nodes: Vec<String>, _socks_proxy: String) -> Self {
+    fn new(_active_timeout: i64, _conn_limit: usize, _preordered_nodes: Vec<String>, _socks_proxy: String, _idle_timeout: i64) -> Self {
         MockNetworker {
             events: Vec::new(),
         }
     }
 
     fn fetch_events(&self, _poll_items: &[zmq::PollItem]) -> Vec<PoolEvent> {
-        unimplemented!()
+        Vec::new()
     }
 
     fn process_event(&mut self, pe: Option<NetworkerEvent>) -> Option<RequestEvent> {
@@ -391,11 +472,11 @@ impl Networker for MockNetworker {
     }
 
     fn get_timeout(&self) -> ((String, String), i64) {
-        unimplemented!()
+        (("".to_string(), "".to_string()), ::std::i64::MAX)
     }
 
     fn get_poll_items(&self) -> Vec<PollItem> {
-        unimplemented!()
+        Vec::new()
     }
 }
 
@@ -405,7 +486,7 @@ pub mod networker_tests {
     use std;
     use std::thread;
 
-    use crate::domain::pool::{MAX_REQ_PER_POOL_CON, POOL_ACK_TIMEOUT, POOL_CON_ACTIVE_TO, POOL_REPLY_TIMEOUT};
+    use crate::domain::pool::{MAX_REQ_PER_POOL_CON, POOL_ACK_TIMEOUT, POOL_CON_ACTIVE_TO, POOL_CON_IDLE_TO, POOL_REPLY_TIMEOUT};
     use crate::services::pool::tests::nodes_emulator;
     use indy_utils::crypto::ed25519_sign;
 
@@ -433,12 +514,12 @@ pub mod networker_tests {
 
         #[test]
         pub fn networker_new_works() {
-            ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
         }
 
         #[test]
         pub fn networker_process_event_works() {
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(None);
         }
 
@@ -447,7 +528,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             assert_eq!(0, networker.nodes.len());
 
@@ -462,7 +543,7 @@ pub mod networker_tests {
             let handle = nodes_emulator::start(&mut txn);
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
             assert!(networker.pool_connections.is_empty());
@@ -488,7 +569,7 @@ pub mod networker_tests {
             let handle_2 = nodes_emulator::start(&mut txn_2);
             let rn_2 = _remote_node(&txn_2);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn_1, rn_2])));
             networker.process_event(Some(NetworkerEvent::SendAllRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT, None)));
@@ -511,7 +592,7 @@ pub mod networker_tests {
 
             let send_cnt = 2;
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec!["n2".to_string(), "n1".to_string()], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec!["n2".to_string(), "n1".to_string()], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn_1, rn_2])));
 
@@ -541,7 +622,7 @@ pub mod networker_tests {
             let handle_2 = nodes_emulator::start(&mut txn_2);
             let rn_2 = _remote_node(&txn_2);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn_1, rn_2])));
             networker.process_event(Some(NetworkerEvent::SendAllRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT, Some(vec![NODE_NAME.to_string()]))));
@@ -557,7 +638,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
@@ -580,7 +661,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
@@ -603,7 +684,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
             networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
@@ -630,9 +711,9 @@ pub mod networker_tests {
         fn networker_process_timeout_event_works() {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
-            let conn = PoolConnection::new(vec![rn.clone()], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let conn = PoolConnection::new(vec![rn.clone()], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
             networker.pool_connections.insert(1, conn);
@@ -649,7 +730,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
             networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
 
@@ -660,12 +741,67 @@ pub mod networker_tests {
             assert!(networker.pool_connections.is_empty());
         }
 
+        #[test]
+        fn networker_reuses_sockets_of_removed_connection() {
+            let mut txn = nodes_emulator::node();
+            let handle = nodes_emulator::start(&mut txn);
+            let rn = _remote_node(&txn);
+
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
+            networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn.clone()])));
+            networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
+
+            _roll_back_timeout(&mut networker);
+
+            networker.process_event(Some(NetworkerEvent::CleanTimeout(REQ_ID.to_string(), None)));
+
+            assert!(networker.pool_connections.is_empty());
+            assert_eq!(1, networker.idle_sockets[&rn].len());
+            assert_ne!(::std::i64::MAX, networker.get_timeout().1);
+
+            networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), "2".to_string(), POOL_ACK_TIMEOUT)));
+
+            assert_eq!(1, networker.pool_connections.len());
+            assert!(networker.idle_sockets.is_empty());
+
+            assert_eq!(MESSAGE.to_string(), nodes_emulator::next(&handle).unwrap());
+            assert_eq!(MESSAGE.to_string(), nodes_emulator::next(&handle).unwrap());
+            assert!(nodes_emulator::next(&handle).is_none());
+        }
+
+        #[test]
+        fn networker_drops_idle_sockets_for_disabled_reuse_and_removed_nodes() {
+            let txn = nodes_emulator::node();
+            let rn = _remote_node(&txn);
+
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), 0);
+            networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn.clone()])));
+            networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
+            _roll_back_timeout(&mut networker);
+            networker.process_event(Some(NetworkerEvent::CleanTimeout(REQ_ID.to_string(), None)));
+
+            assert!(networker.pool_connections.is_empty());
+            assert!(networker.idle_sockets.is_empty());
+
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
+            networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn.clone()])));
+            networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
+            _roll_back_timeout(&mut networker);
+            networker.process_event(Some(NetworkerEvent::CleanTimeout(REQ_ID.to_string(), None)));
+
+            assert_eq!(1, networker.idle_sockets.len());
+
+            networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![])));
+
+            assert!(networker.idle_sockets.is_empty());
+        }
+
         #[test]
         fn networker_process_second_request_after_cleaning_timeout_works() {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
             networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
@@ -683,7 +819,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
             networker.process_event(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
@@ -702,7 +838,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new());
+            let mut networker = ZMQNetworker::new(POOL_CON_ACTIVE_TO, MAX_REQ_PER_POOL_CON, vec![], String::new(), POOL_CON_IDLE_TO);
 
             networker.process_event(Some(NetworkerEvent::NodesStateUpdated(vec![rn])));
 
@@ -764,7 +900,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
         }
 
         #[test]
@@ -780,7 +916,7 @@ pub mod networker_tests {
                 nodes.push(_remote_node(&txn));
             }
 
-            let pc = PoolConnection::new(nodes, POOL_CON_ACTIVE_TO, vec![], String::new());
+            let pc = PoolConnection::new(nodes, POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             let act_names: Vec<String> = pc.nodes.iter().map(|n| n.name.to_string()).collect();
 
@@ -809,7 +945,8 @@ pub mod networker_tests {
             let pc = PoolConnection::new(vec![rn_1.clone(), rn_2.clone(), rn_3.clone(), rn_4.clone(), rn_5.clone()],
                                          POOL_CON_ACTIVE_TO,
                                          vec![rn_2.name.clone(), rn_1.name.clone(), rn_5.name.clone()],
-                                         String::new());
+                                         String::new(),
+                                         zmq::Context::new());
 
             assert_eq!(rn_2.name, pc.nodes[0].name);
             assert_eq!(rn_1.name, pc.nodes[1].name);
@@ -821,7 +958,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             assert!(conn.is_active());
 
@@ -835,7 +972,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             assert!(!conn.has_active_requests());
 
@@ -849,7 +986,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             let ((req_id, node_alias), timeout) = conn.get_timeout();
             assert_eq!(req_id, "".to_string());
@@ -870,7 +1007,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
 
@@ -890,7 +1027,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
 
@@ -906,7 +1043,7 @@ pub mod networker_tests {
             let txn = nodes_emulator::node();
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             let _socket = conn._get_socket(0).unwrap();
         }
@@ -917,7 +1054,7 @@ pub mod networker_tests {
             let mut rn = _remote_node(&txn);
             rn.zaddr = "invalid_address".to_string();
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             let res = conn._get_socket(0);
             assert_kind!(IndyErrorKind::IOError, res);
@@ -929,7 +1066,7 @@ pub mod networker_tests {
             let handle = nodes_emulator::start(&mut txn);
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
             conn.send_request(Some(NetworkerEvent::SendOneRequest("msg2".to_string(), "12".to_string(), POOL_ACK_TIMEOUT))).unwrap();
@@ -949,7 +1086,7 @@ pub mod networker_tests {
             let handle_2 = nodes_emulator::start(&mut txn_2);
             let rn_2 = _remote_node(&txn_2);
 
-            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec!["n1".to_string(), "n2".to_string()], String::new());
+            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec!["n1".to_string(), "n2".to_string()], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
 
@@ -969,7 +1106,7 @@ pub mod networker_tests {
             let handle_2 = nodes_emulator::start(&mut txn_2);
             let rn_2 = _remote_node(&txn_2);
 
-            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendAllRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT, None))).unwrap();
 
@@ -985,7 +1122,7 @@ pub mod networker_tests {
             let handle = nodes_emulator::start(&mut txn);
             let rn = _remote_node(&txn);
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
 
@@ -1006,7 +1143,7 @@ pub mod networker_tests {
             let handle_2 = nodes_emulator::start(&mut txn_2);
             let rn_2 = _remote_node(&txn_2);
 
-            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn_1, rn_2], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT))).unwrap();
 
@@ -1024,7 +1161,7 @@ pub mod networker_tests {
             let mut rn = _remote_node(&txn);
             rn.zaddr = "invalid_address".to_string();
 
-            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new());
+            let mut conn = PoolConnection::new(vec![rn], POOL_CON_ACTIVE_TO, vec![], String::new(), zmq::Context::new());
 
             let res = conn.send_request(Some(NetworkerEvent::SendOneRequest(MESSAGE.to_string(), REQ_ID.to_string(), POOL_ACK_TIMEOUT)));
             assert_kind!(IndyErrorKind::IOError, res);
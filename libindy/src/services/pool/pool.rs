@@ -2,7 +2,11 @@ use std::cell::RefCell;
 use std::collections::HashMap;
 use std::collections::VecDeque;
 use std::marker::PhantomData;
+use std::panic::{self, AssertUnwindSafe};
 use std::rc::Rc;
+use std::sync::{Arc, Mutex};
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+use std::sync::mpsc::{channel, Receiver, Sender, TryRecvError};
 use std::thread;
 use std::thread::JoinHandle;
 
@@ -18,7 +22,7 @@ use indy_api_types::errors::prelude::*;
 use crate::services::ledger::merkletree::merkletree::MerkleTree;
 use crate::services::pool::commander::Commander;
 use crate::services::pool::events::*;
-use crate::services::pool::{merkle_tree_factory, Nodes};
+use crate::services::pool::{merkle_tree_factory, pool_create_pair_of_sockets, state_proof, Nodes};
 use crate::services::pool::networker::{Networker, ZMQNetworker};
 use crate::services::pool::request_handler::{RequestHandler, RequestHandlerImpl};
 use rust_base58::{FromBase58, ToBase58};
@@ -26,6 +30,7 @@ use crate::services::pool::types::{LedgerStatus, RemoteNode};
 use indy_utils::crypto::ed25519_sign;
 
 use super::ursa::bls::VerKey;
+use super::time;
 use super::zmq;
 use indy_api_types::{PoolHandle, CommandHandle};
 
@@ -281,7 +286,7 @@ impl<T: Networker, R: RequestHandler<T>> PoolSM<T, R> {
                         match _get_request_handler_with_ledger_status_sent(state.networker.clone(), &pool_name, timeout, extended_timeout, number_read_nodes) {
                             Ok(request_handler) => PoolState::GettingCatchupTarget((request_handler, cmd_id, state).into()),
                             Err(err) => {
-                                CommandExecutor::instance().send(
+                                CommandExecutor::instance().send_internal(
                                     Command::Pool(
                                         PoolCommand::OpenAck(cmd_id, id, Err(err)))
                                 ).unwrap();
@@ -382,8 +387,12 @@ impl<T: Networker, R: RequestHandler<T>> PoolSM<T, R> {
                     PoolEvent::SendRequest(cmd_id, _, _, _) => {
                         trace!("received request to send");
                         let re: Option<RequestEvent> = pe.into();
-                        match re.as_ref().map(|r| r.get_req_id()) {
-                            Some(req_id) => {
+                        match re.as_ref().map(|r| (r.get_req_id(), r.is_ledger_txns_request())) {
+                            Some((ref req_id, true)) if state.request_handlers.contains_key(req_id) => {
+                                let res = Err(err_msg(IndyErrorKind::InvalidState, "The same request to the ledger is already in progress"));
+                                _send_submit_ack(cmd_id, res)
+                            }
+                            Some((req_id, _)) => {
                                 let mut request_handler = R::new(state.networker.clone(), _get_f(state.nodes.len()), &[cmd_id], &state.nodes, &pool_name, timeout, extended_timeout, number_read_nodes);
                                 request_handler.process_event(re);
                                 state.request_handlers.insert(req_id.to_string(), request_handler); //FIXME check already exists
@@ -466,7 +475,7 @@ impl<T: Networker, R: RequestHandler<T>> PoolSM<T, R> {
 
 pub struct Pool<S: Networker, R: RequestHandler<S>> {
     _pd: PhantomData<(S, R)>,
-    worker: Option<JoinHandle<()>>,
+    worker: Option<PoolWorker>,
     name: String,
     id: PoolHandle,
     timeout: i64,
@@ -476,6 +485,22 @@ pub struct Pool<S: Networker, R: RequestHandler<S>> {
     preordered_nodes: Vec<String>,
     number_read_nodes: u8,
     socks_proxy: String,
+    idle_timeout: i64,
+}
+
+enum PoolWorker {
+    Dedicated(JoinHandle<()>),
+    Shared(Receiver<()>),
+}
+
+impl PoolWorker {
+    fn join(self) {
+        match self {
+            PoolWorker::Dedicated(worker) => worker.join().unwrap(),
+            // Sender is dropped by I/O thread on pool finish even if pool panicked
+            PoolWorker::Shared(done) => { let _ = done.recv(); }
+        }
+    }
 }
 
 impl<S: Networker, R: RequestHandler<S>> Pool<S, R> {
@@ -493,28 +518,18 @@ impl<S: Networker, R: RequestHandler<S>> Pool<S, R> {
             preordered_nodes: config.preordered_nodes,
             number_read_nodes: config.number_read_nodes,
             socks_proxy: config.socks_proxy,
+            idle_timeout: config.conn_idle_timeout,
         }
     }
 
     pub fn work(&mut self, cmd_socket: zmq::Socket) {
-        let name = self.name.as_str().to_string();
-        let id = self.id;
-        let timeout = self.timeout;
-        let extended_timeout = self.extended_timeout;
-        let active_timeout = self.active_timeout;
-        let conn_limit = self.conn_limit;
-        let preordered_nodes = self.preordered_nodes.clone();
-        let number_read_nodes = self.number_read_nodes;
-        let socks_proxy = self.socks_proxy.clone();
-        self.worker = Some(thread::spawn(move || {
-            let mut pool_thread: PoolThread<S, R> = PoolThread::new(cmd_socket, name, id,
-                                                                    timeout, extended_timeout,
-                                                                    active_timeout, conn_limit,
-                                                                    preordered_nodes,
-                                                                    number_read_nodes,
-                                                                    socks_proxy);
+        let params = self._thread_params(cmd_socket);
+        self.worker = Some(PoolWorker::Dedicated(thread::spawn(move || {
+            let name = params.name.clone();
+            let mut pool_thread: PoolThread<S, R> = params.into_thread();
             pool_thread.work();
-        }));
+            state_proof::invalidate_signature_cache(&name);
+        })));
     }
 
     pub fn get_name(&self) -> &str {
@@ -524,6 +539,61 @@ impl<S: Networker, R: RequestHandler<S>> Pool<S, R> {
     pub fn get_id(&self) -> PoolHandle {
         self.id
     }
+
+    fn _thread_params(&self, cmd_socket: zmq::Socket) -> PoolThreadParams {
+        PoolThreadParams {
+            cmd_socket,
+            name: self.name.clone(),
+            id: self.id,
+            timeout: self.timeout,
+            extended_timeout: self.extended_timeout,
+            active_timeout: self.active_timeout,
+            conn_limit: self.conn_limit,
+            preordered_nodes: self.preordered_nodes.clone(),
+            number_read_nodes: self.number_read_nodes,
+            socks_proxy: self.socks_proxy.clone(),
+            idle_timeout: self.idle_timeout,
+        }
+    }
+}
+
+impl Pool<ZMQNetworker, RequestHandlerImpl<ZMQNetworker>> {
+    /// Hands the pool over to one of shared I/O threads instead of starting a dedicated one.
+    pub fn work_shared(&mut self, cmd_socket: zmq::Socket) -> IndyResult<()> {
+        let (done_sender, done_receiver) = channel();
+        let params = self._thread_params(cmd_socket);
+
+        IO_THREADS.lock().unwrap().assign(SharedPoolParams { params, done: done_sender })?;
+
+        self.worker = Some(PoolWorker::Shared(done_receiver));
+        Ok(())
+    }
+}
+
+struct PoolThreadParams {
+    cmd_socket: zmq::Socket,
+    name: String,
+    id: PoolHandle,
+    timeout: i64,
+    extended_timeout: i64,
+    active_timeout: i64,
+    conn_limit: usize,
+    preordered_nodes: Vec<String>,
+    number_read_nodes: u8,
+    socks_proxy: String,
+    idle_timeout: i64,
+}
+
+impl PoolThreadParams {
+    fn into_thread<S: Networker, R: RequestHandler<S>>(self) -> PoolThread<S, R> {
+        PoolThread::new(self.cmd_socket, self.name, self.id,
+                        self.timeout, self.extended_timeout,
+                        self.active_timeout, self.conn_limit,
+                        self.preordered_nodes,
+                        self.number_read_nodes,
+                        self.socks_proxy,
+                        self.idle_timeout)
+    }
 }
 
 struct PoolThread<S: Networker, R: RequestHandler<S>> {
@@ -535,8 +605,8 @@ struct PoolThread<S: Networker, R: RequestHandler<S>> {
 
 impl<S: Networker, R: RequestHandler<S>> PoolThread<S, R> {
     pub fn new(cmd_socket: zmq::Socket, name: String, id: PoolHandle, timeout: i64, extended_timeout: i64, active_timeout: i64, conn_limit: usize,
-               preordered_nodes: Vec<String>, number_read_nodes: u8, socks_proxy: String) -> Self {
-        let networker = Rc::new(RefCell::new(S::new(active_timeout, conn_limit, preordered_nodes, socks_proxy)));
+               preordered_nodes: Vec<String>, number_read_nodes: u8, socks_proxy: String, idle_timeout: i64) -> Self {
+        let networker = Rc::new(RefCell::new(S::new(active_timeout, conn_limit, preordered_nodes, socks_proxy, idle_timeout)));
         PoolThread {
             pool_sm: Some(PoolSM::new(networker.clone(), &name, id, timeout, extended_timeout, number_read_nodes)),
             events: VecDeque::new(),
@@ -603,6 +673,286 @@ impl<S: Networker, R: RequestHandler<S>> PoolThread<S, R> {
     }
 }
 
+const COMMAND_WAKE: &str = "wake";
+
+lazy_static! {
+    static ref IO_THREADS: Mutex<PoolIoThreads> = Mutex::new(PoolIoThreads { count: 0, threads: Vec::new() });
+}
+
+/// Sets number of I/O threads shared by pools opened after this call. 0 starts a dedicated thread for every pool.
+pub fn set_io_threads_count(count: usize) {
+    IO_THREADS.lock().unwrap().count = count;
+}
+
+pub fn io_threads_count() -> usize {
+    IO_THREADS.lock().unwrap().count
+}
+
+struct PoolIoThreads {
+    count: usize,
+    threads: Vec<PoolIoThread>,
+}
+
+struct PoolIoThread {
+    sender: Sender<SharedPoolParams>,
+    wake_socket: zmq::Socket,
+    pools_count: Arc<AtomicUsize>,
+    finished: Arc<AtomicBool>,
+}
+
+struct SharedPoolParams {
+    params: PoolThreadParams,
+    done: Sender<()>,
+}
+
+impl PoolIoThreads {
+    fn assign(&mut self, pool: SharedPoolParams) -> IndyResult<()> {
+        while self.threads.len() < self.count {
+            let index = self.threads.len();
+            self.threads.push(PoolIoThread::start::<ZMQNetworker, RequestHandlerImpl<ZMQNetworker>>(index));
+        }
+
+        // Thread that has died never takes pools again, so it is replaced
+        for (index, thread) in self.threads.iter_mut().enumerate() {
+            if thread.finished.load(Ordering::SeqCst) {
+                warn!("Pool I/O thread {} is finished, restarting it", index);
+                *thread = PoolIoThread::start::<ZMQNetworker, RequestHandlerImpl<ZMQNetworker>>(index);
+            }
+        }
+
+        let thread = self.threads.iter()
+            .take(::std::cmp::max(self.count, 1))
+            .min_by_key(|thread| thread.pools_count.load(Ordering::SeqCst))
+            .ok_or_else(|| err_msg(IndyErrorKind::InvalidState, "No pool I/O threads are started"))?;
+
+        thread.pools_count.fetch_add(1, Ordering::SeqCst);
+
+        thread.sender.send(pool)
+            .to_indy(IndyErrorKind::InvalidState, "Pool I/O thread is finished")?;
+
+        thread.wake_socket.send(COMMAND_WAKE.as_bytes(), zmq::DONTWAIT)
+            .to_indy(IndyErrorKind::IOError, "Can't wake pool I/O thread")
+    }
+}
+
+impl PoolIoThread {
+    fn start<S: Networker + 'static, R: RequestHandler<S> + 'static>(index: usize) -> PoolIoThread {
+        let (sender, receiver) = channel();
+        let (wake_socket, wake_recv_socket) = pool_create_pair_of_sockets(&format!("pool_io_thread_{}", index));
+        let pools_count = Arc::new(AtomicUsize::new(0));
+        let finished = Arc::new(AtomicBool::new(false));
+
+        let thread_pools_count = pools_count.clone();
+        let thread_finished = finished.clone();
+
+        thread::spawn(move || {
+            let mut thread = SharedPoolThread::<S, R>::new(receiver, wake_recv_socket, thread_pools_count);
+
+            // Panics of pools are caught by the thread itself, this only guards the thread bookkeeping
+            if panic::catch_unwind(AssertUnwindSafe(|| thread.work())).is_err() {
+                error!("Pool I/O thread {} panicked, finishing {} pools", index, thread.pools.len());
+            }
+
+            thread_finished.store(true, Ordering::SeqCst);
+        });
+
+        PoolIoThread { sender, wake_socket, pools_count, finished }
+    }
+}
+
+struct SharedPool<S: Networker, R: RequestHandler<S>> {
+    thread: PoolThread<S, R>,
+    name: String,
+    _done: Sender<()>,
+}
+
+/// Multiplexes sockets and timers of many pools in one zmq poll loop.
+///
+/// Every pool keeps its own state machine, networker and command socket, a panic in one pool
+/// finishes only this pool.
+struct SharedPoolThread<S: Networker, R: RequestHandler<S>> {
+    pools: Vec<SharedPool<S, R>>,
+    receiver: Receiver<SharedPoolParams>,
+    wake_socket: zmq::Socket,
+    pools_count: Arc<AtomicUsize>,
+}
+
+impl<S: Networker, R: RequestHandler<S>> SharedPoolThread<S, R> {
+    fn new(receiver: Receiver<SharedPoolParams>, wake_socket: zmq::Socket, pools_count: Arc<AtomicUsize>) -> Self {
+        SharedPoolThread {
+            pools: Vec::new(),
+            receiver,
+            wake_socket,
+            pools_count,
+        }
+    }
+
+    fn work(&mut self) {
+        loop {
+            match self._poll() {
+                Ok(true) => {
+                    if !self._add_pools() {
+                        break;
+                    }
+                }
+                Ok(false) => {}
+                Err(err) => {
+                    // A dedicated thread stops on poll error, so all pools polled together are finished
+                    error!("Pool I/O thread can't poll sockets, finishing {} pools: {}", self.pools.len(), err);
+                    while let Some(pool) = self.pools.pop() {
+                        self._finish_pool(pool);
+                    }
+                }
+            }
+
+            self._loop();
+        }
+    }
+
+    fn _add_pools(&mut self) -> bool {
+        while let Ok(_) = self.wake_socket.recv_bytes(zmq::DONTWAIT) {}
+
+        loop {
+            match self.receiver.try_recv() {
+                Ok(SharedPoolParams { params, done }) => {
+                    let name = params.name.clone();
+                    self.pools.push(SharedPool { thread: params.into_thread(), name, _done: done });
+                }
+                Err(TryRecvError::Empty) => return true,
+                Err(TryRecvError::Disconnected) => return !self.pools.is_empty()
+            }
+        }
+    }
+
+    fn _loop(&mut self) {
+        let mut idx = 0;
+
+        while idx < self.pools.len() {
+            let finished = {
+                let thread = &mut self.pools[idx].thread;
+                panic::catch_unwind(AssertUnwindSafe(|| thread._loop())).unwrap_or_else(|_| {
+                    error!("Pool {} worker panicked", self.pools[idx].name);
+                    true
+                })
+            };
+
+            if finished {
+                let pool = self.pools.swap_remove(idx);
+                self._finish_pool(pool);
+            } else {
+                idx += 1;
+            }
+        }
+    }
+
+    fn _finish_pool(&self, pool: SharedPool<S, R>) {
+        state_proof::invalidate_signature_cache(&pool.name);
+        self.pools_count.fetch_sub(1, Ordering::SeqCst);
+    }
+
+    /// Polls sockets of all pools at once, returns true if new pools were assigned to the thread.
+    ///
+    /// Pools whose networker or commander panicked are finished.
+    fn _poll(&mut self) -> Result<bool, zmq::Error> {
+        let mut panicked = vec![false; self.pools.len()];
+
+        let (events, wake) = {
+            let networkers: Vec<_> = self.pools.iter().map(|pool| pool.thread.networker.borrow()).collect();
+
+            let mut poll_items = Vec::new();
+            let mut pools_items = Vec::with_capacity(self.pools.len());
+
+            for (idx, (pool, networker)) in self.pools.iter().zip(networkers.iter()).enumerate() {
+                let items = panic::catch_unwind(AssertUnwindSafe(|| {
+                    (networker.get_poll_items(), pool.thread.commander.get_poll_item(), networker.get_timeout())
+                }));
+
+                match items {
+                    Ok((items, cmd_item, timeout)) => {
+                        let start = poll_items.len();
+                        poll_items.extend(items);
+                        poll_items.push(cmd_item);
+                        pools_items.push(Some((start..poll_items.len(), timeout)));
+                    }
+                    Err(_) => {
+                        error!("Pool {} worker panicked", pool.name);
+                        panicked[idx] = true;
+                        pools_items.push(None);
+                    }
+                }
+            }
+
+            poll_items.push(self.wake_socket.as_poll_item(zmq::POLLIN));
+
+            let timeout = pools_items.iter()
+                .filter_map(|items| items.as_ref().map(|&(_, (_, timeout))| timeout))
+                .min()
+                .unwrap_or(::std::i64::MAX);
+
+            let started = time::now();
+
+            match zmq::poll(&mut poll_items, ::std::cmp::max(timeout, 0)) {
+                Ok(_) | Err(zmq::Error::EINTR) => {}
+                Err(err) => return Err(err)
+            }
+
+            let elapsed = (time::now() - started).num_milliseconds();
+
+            let mut events: Vec<Vec<PoolEvent>> = Vec::with_capacity(self.pools.len());
+
+            for (idx, ((pool, networker), items)) in self.pools.iter().zip(networkers.iter()).zip(pools_items.into_iter()).enumerate() {
+                let (range, ((req_id, alias), timeout)) = match items {
+                    Some(items) => items,
+                    None => {
+                        events.push(Vec::new());
+                        continue;
+                    }
+                };
+
+                let pool_items = &poll_items[range];
+
+                let pool_events = panic::catch_unwind(AssertUnwindSafe(|| {
+                    let cmd_item = &pool_items[pool_items.len() - 1];
+
+                    let mut events = Vec::new();
+
+                    if timeout <= elapsed && !pool_items.iter().any(|item| item.is_readable()) {
+                        events.push(PoolEvent::Timeout(req_id, alias));
+                    }
+
+                    events.extend(networker.fetch_events(pool_items));
+
+                    if cmd_item.is_readable() {
+                        events.extend(pool.thread.commander.fetch_events());
+                    }
+
+                    events
+                }));
+
+                events.push(pool_events.unwrap_or_else(|_| {
+                    error!("Pool {} worker panicked", pool.name);
+                    panicked[idx] = true;
+                    Vec::new()
+                }));
+            }
+
+            (events, poll_items[poll_items.len() - 1].is_readable())
+        };
+
+        for (pool, events) in self.pools.iter_mut().zip(events.into_iter()) {
+            pool.thread.events.extend(events);
+        }
+
+        // Remove from the end, so indexes of the pools still to be removed stay valid
+        for idx in (0..panicked.len()).rev().filter(|&idx| panicked[idx]) {
+            let pool = self.pools.swap_remove(idx);
+            self._finish_pool(pool);
+        }
+
+        Ok(wake)
+    }
+}
+
 fn _get_f(cnt: usize) -> usize {
     if cnt < 4 {
         return 0;
@@ -717,12 +1067,12 @@ fn _get_nodes_and_remotes(merkle: &MerkleTree) -> IndyResult<(Nodes, Vec<RemoteN
 
 fn _close_pool_ack(cmd_id: CommandHandle) {
     let pc = PoolCommand::CloseAck(cmd_id, Ok(()));
-    CommandExecutor::instance().send(Command::Pool(pc)).unwrap();
+    CommandExecutor::instance().send_internal(Command::Pool(pc)).unwrap();
 }
 
 fn _send_submit_ack(cmd_id: CommandHandle, res: IndyResult<String>) {
     let lc = LedgerCommand::SubmitAck(cmd_id, res);
-    CommandExecutor::instance().send(Command::Ledger(lc)).unwrap();
+    CommandExecutor::instance().send_internal(Command::Ledger(lc)).unwrap();
 }
 
 fn _send_open_refresh_ack(cmd_id: CommandHandle, id: PoolHandle, is_refresh: bool, res: IndyResult<()>) {
@@ -732,7 +1082,7 @@ fn _send_open_refresh_ack(cmd_id: CommandHandle, id: PoolHandle, is_refresh: boo
     } else {
         PoolCommand::OpenAck(cmd_id, id, res)
     };
-    CommandExecutor::instance().send(Command::Pool(pc)).unwrap();
+    CommandExecutor::instance().send_internal(Command::Pool(pc)).unwrap();
 }
 
 pub struct ZMQPool {
@@ -760,7 +1110,7 @@ impl Drop for ZMQPool {
         // Option worker type and this kludge is workaround for rust
         if let Some(worker) = self.pool.worker.take() {
             info!("Drop wait worker");
-            worker.join().unwrap();
+            worker.join();
         }
         info!("Drop finished");
     }
@@ -814,7 +1164,7 @@ mod tests {
 
         #[test]
         pub fn pool_wrapper_new_initialization_works() {
-            let _p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "name", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+            let _p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "name", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
         }
 
         #[test]
@@ -824,7 +1174,7 @@ mod tests {
             ProtocolVersion::set(2);
             _write_genesis_txns("pool_wrapper_check_cache_works");
 
-            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_check_cache_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_check_cache_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
             assert_match!(PoolState::GettingCatchupTarget(_), p.state);
@@ -835,7 +1185,7 @@ mod tests {
         #[test]
         pub fn pool_wrapper_check_cache_works_for_no_pool_created() {
             let p: PoolSM<MockNetworker, MockRequestHandler> =
-                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))),
+                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))),
                             "pool_wrapper_check_cache_works_for_no_pool_created", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
@@ -844,7 +1194,7 @@ mod tests {
 
         #[test]
         pub fn pool_wrapper_terminated_close_works() {
-            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_terminated_close_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_terminated_close_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
             let cmd_id: CommandHandle = next_command_handle();
@@ -855,7 +1205,7 @@ mod tests {
         #[test]
         pub fn pool_wrapper_terminated_refresh_works() {
             test::cleanup_pool("pool_wrapper_terminated_refresh_works");
-            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_terminated_refresh_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_terminated_refresh_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
 
@@ -874,7 +1224,7 @@ mod tests {
                 pool_name: "pool_wrapper_terminated_timeout_works".to_string(),
                 id: next_pool_handle(),
                 state: PoolState::Terminated(TerminatedState {
-                    networker: Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))),
+                    networker: Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))),
                 }),
                 timeout: 0,
                 extended_timeout: 0,
@@ -895,7 +1245,7 @@ mod tests {
 
         #[test]
         pub fn pool_wrapper_cloe_works_from_initialization() {
-            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_cloe_works_from_initialization", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_cloe_works_from_initialization", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::Close(cmd_id));
             assert_match!(PoolState::Closed(_), p.state);
@@ -909,7 +1259,7 @@ mod tests {
             _write_genesis_txns("pool_wrapper_close_works_from_getting_catchup_target");
 
             let p: PoolSM<MockNetworker, MockRequestHandler> =
-                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_close_works_from_getting_catchup_target", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_close_works_from_getting_catchup_target", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
             let cmd_id: CommandHandle = next_command_handle();
@@ -927,7 +1277,7 @@ mod tests {
             _write_genesis_txns("pool_wrapper_catchup_target_not_found_works");
 
             let p: PoolSM<MockNetworker, MockRequestHandler> =
-                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_catchup_target_not_found_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_catchup_target_not_found_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
             let p = p.handle_event(PoolEvent::CatchupTargetNotFound(err_msg(IndyErrorKind::PoolTimeout, "Pool timeout")));
@@ -944,7 +1294,7 @@ mod tests {
             _write_genesis_txns("pool_wrapper_getting_catchup_target_synced_works");
 
             let p: PoolSM<MockNetworker, MockRequestHandler> =
-                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new()))), "pool_wrapper_getting_catchup_target_synced_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
+                PoolSM::new(Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0))), "pool_wrapper_getting_catchup_target_synced_works", next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
             let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
             let p = p.handle_event(PoolEvent::Synced(MerkleTree::from_vec(vec![]).unwrap()));
@@ -963,7 +1313,7 @@ mod tests {
             let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(
                 Rc::new(RefCell::new(
                     MockNetworker::new(0,
-                                       0, vec![], String::new()))),
+                                       0, vec![], String::new(), 0))),
                 "pool_wrapper_getting_catchup_target_synced_works_for_node_state_error",
                 next_pool_handle(),
                 0,
@@ -991,7 +1341,7 @@ mod tests {
                     MockNetworker::new(0,
                                        0,
                                        vec![],
-                                       String::new()))),
+                                       String::new(), 0))),
                 "pool_wrapper_getting_catchup_target_catchup_target_found_works",
                 next_pool_handle(),
                 0,
@@ -1015,7 +1365,7 @@ mod tests {
 
             let p: PoolSM<MockNetworker, MockRequestHandler> =
                 PoolSM::new(Rc::new(RefCell::new(
-                    MockNetworker::new(0, 0, vec![], String::new()))),
+                    MockNetworker::new(0, 0, vec![], String::new(), 0))),
                             "pool_wrapper_getting_catchup_target_catchup_target_found_works_for_node_state_error",
                             next_pool_handle(),
                             0,
@@ -1044,7 +1394,7 @@ mod tests {
                         MockNetworker::new(0,
                                            0,
                                            vec![],
-                                           String::new()))),
+                                           String::new(), 0))),
                             "pool_wrapper_sync_catchup_close_works",
                             next_pool_handle(),
                             0,
@@ -1073,7 +1423,7 @@ mod tests {
                     MockNetworker::new(0,
                                        0,
                                        vec![],
-                                       String::new()))),
+                                       String::new(), 0))),
                 "pool_wrapper_sync_catchup_synced_works",
                 next_pool_handle(),
                 0,
@@ -1101,7 +1451,7 @@ mod tests {
                     MockNetworker::new(0,
                                        0,
                                        vec![],
-                                       String::new()))),
+                                       String::new(), 0))),
                 "pool_wrapper_sync_catchup_synced_works_for_node_state_error",
                 next_pool_handle(),
                 0,
@@ -1134,7 +1484,7 @@ mod tests {
                 RefCell::new(MockNetworker::new(0,
                                                 0,
                                                 vec![],
-                                                String::new()))),
+                                                String::new(), 0))),
                                                                            "pool_wrapper_active_send_request_works",
                                                                            next_pool_handle(),
                                                                            0,
@@ -1156,6 +1506,49 @@ mod tests {
             test::cleanup_storage("pool_wrapper_active_send_request_works");
         }
 
+        #[test]
+        pub fn pool_wrapper_active_send_request_works_for_ledger_txns_request_in_progress() {
+            test::cleanup_storage("pool_wrapper_active_send_request_works_for_ledger_txns_request_in_progress");
+
+            ProtocolVersion::set(2);
+            _write_genesis_txns("pool_wrapper_active_send_request_works_for_ledger_txns_request_in_progress");
+
+            let req = json!({
+                "op": "CATCHUP_REQ",
+                "ledgerId": 1,
+                "seqNoStart": 1,
+                "seqNoEnd": 10,
+                "catchupTill": 10
+            }).to_string();
+
+            let p: PoolSM<MockNetworker, MockRequestHandler> = PoolSM::new(Rc::new(
+                RefCell::new(MockNetworker::new(0,
+                                                0,
+                                                vec![],
+                                                String::new(), 0))),
+                                                                           "pool_wrapper_active_send_request_works_for_ledger_txns_request_in_progress",
+                                                                           next_pool_handle(),
+                                                                           0,
+                                                                           0, NUMBER_READ_NODES);
+            let cmd_id: CommandHandle = next_command_handle();
+            let p = p.handle_event(PoolEvent::CheckCache(cmd_id));
+            let p = p.handle_event(PoolEvent::Synced(MerkleTree::from_vec(vec![]).unwrap()));
+            let cmd_id: CommandHandle = next_command_handle();
+            let p = p.handle_event(PoolEvent::SendRequest(cmd_id, req.clone(), None, None));
+            let cmd_id: CommandHandle = next_command_handle();
+            let p = p.handle_event(PoolEvent::SendRequest(cmd_id, req, None, None));
+            assert_match!(PoolState::Active(_), p.state);
+            match p.state {
+                PoolState::Active(state) => {
+                    assert_eq!(state.request_handlers.len(), 1);
+                    assert!(state.request_handlers.contains_key("CATCHUP_REQ:1:1"));
+                }
+                _ => assert!(false)
+            };
+
+            test::cleanup_storage("pool_wrapper_active_send_request_works_for_ledger_txns_request_in_progress");
+        }
+
         #[test]
         pub fn pool_wrapper_active_send_request_works_for_no_req_id() {
             test::cleanup_storage("pool_wrapper_active_send_request_works_for_no_req_id");
@@ -1175,7 +1568,7 @@ mod tests {
                         0,
                         0,
                         vec![],
-                        String::new()))),
+                        String::new(), 0))),
                             "pool_wrapper_active_send_request_works_for_no_req_id",
                             next_pool_handle(),
                             0,
@@ -1229,7 +1622,7 @@ mod tests {
                     MockNetworker::new(0,
                                        0,
                                        vec![],
-                                       String::new()))),
+                                       String::new(), 0))),
                 "pool_wrapper_active_node_reply_works",
                 next_pool_handle(),
                 0,
@@ -1270,7 +1663,7 @@ mod tests {
                     MockNetworker::new(0,
                                        0,
                                        vec![],
-                                       String::new()))),
+                                       String::new(), 0))),
                             "pool_wrapper_sends_requests_to_two_nodes",
                             next_pool_handle(), 0, 0, NUMBER_READ_NODES);
             let cmd_id: CommandHandle = next_command_handle();
@@ -1321,7 +1714,7 @@ mod tests {
                 RefCell::new(MockNetworker::new(0,
                                                 0,
                                                 vec![],
-                                                String::new()))),
+                                                String::new(), 0))),
                                                                            "pool_wrapper_active_node_reply_works_for_no_request",
                                                                            next_pool_handle(),
                                                                            0,
@@ -1365,7 +1758,7 @@ mod tests {
                     0,
                     0,
                     vec![],
-                    String::new()))),
+                    String::new(), 0))),
                             "pool_wrapper_active_node_reply_works_for_invalid_reply",
                             next_pool_handle(),
                             0,
@@ -1397,6 +1790,110 @@ mod tests {
         }
     }
 
+    mod shared_pool_thread {
+        use super::*;
+        use std::time::Duration;
+        use std::sync::mpsc::RecvTimeoutError;
+        use indy_utils::next_pool_handle;
+
+        #[test]
+        fn shared_pool_thread_serves_and_finishes_pools() {
+            let (sender, receiver) = channel();
+            let (wake_socket, wake_recv_socket) = pool_create_pair_of_sockets("shared_pool_thread_serves_and_finishes_pools");
+            let pools_count = Arc::new(AtomicUsize::new(0));
+
+            let thread_pools_count = pools_count.clone();
+            let worker = thread::spawn(move || {
+                SharedPoolThread::<MockNetworker, MockRequestHandler>::new(receiver, wake_recv_socket, thread_pools_count).work();
+            });
+
+            let mut cmd_sockets = Vec::new();
+            let mut dones = Vec::new();
+
+            for i in 0..3 {
+                let name = format!("shared_pool_thread_serves_and_finishes_pools_{}", i);
+                let (send_cmd_sock, recv_cmd_sock) = pool_create_pair_of_sockets(&name);
+                let pool: Pool<MockNetworker, MockRequestHandler> = Pool::new(&name, next_pool_handle(), PoolOpenConfig::default());
+                let (done_sender, done_receiver) = channel();
+
+                pools_count.fetch_add(1, Ordering::SeqCst);
+                sender.send(SharedPoolParams { params: pool._thread_params(recv_cmd_sock), done: done_sender }).unwrap();
+
+                cmd_sockets.push(send_cmd_sock);
+                dones.push(done_receiver);
+            }
+
+            wake_socket.send(COMMAND_WAKE.as_bytes(), zmq::DONTWAIT).unwrap();
+
+            for cmd_socket in cmd_sockets.iter() {
+                cmd_socket.send(COMMAND_EXIT.as_bytes(), zmq::DONTWAIT).unwrap();
+            }
+
+            for done in dones {
+                assert_eq!(Err(RecvTimeoutError::Disconnected), done.recv_timeout(Duration::from_secs(10)));
+            }
+
+            assert_eq!(0, pools_count.load(Ordering::SeqCst));
+
+            drop(sender);
+            wake_socket.send(COMMAND_WAKE.as_bytes(), zmq::DONTWAIT).unwrap();
+            worker.join().unwrap();
+        }
+
+        struct PanickingNetworker {}
+
+        impl Networker for PanickingNetworker {
+            fn new(_active_timeout: i64, _conn_limit: usize, _preordered_nodes: Vec<String>, _socks_proxy: String, _idle_timeout: i64) -> Self {
+                PanickingNetworker {}
+            }
+
+            fn fetch_events(&self, _poll_items: &[zmq::PollItem]) -> Vec<PoolEvent> {
+                Vec::new()
+            }
+
+            fn process_event(&mut self, _pe: Option<NetworkerEvent>) -> Option<RequestEvent> {
+                None
+            }
+
+            fn get_timeout(&self) -> ((String, String), i64) {
+                (("".to_string(), "".to_string()), ::std::i64::MAX)
+            }
+
+            fn get_poll_items(&self) -> Vec<zmq::PollItem> {
+                panic!("get_poll_items")
+            }
+        }
+
+        #[test]
+        fn shared_pool_thread_finishes_pool_panicked_in_poll() {
+            let (sender, receiver) = channel();
+            let (wake_socket, wake_recv_socket) = pool_create_pair_of_sockets("shared_pool_thread_finishes_pool_panicked_in_poll");
+            let pools_count = Arc::new(AtomicUsize::new(0));
+
+            let thread_pools_count = pools_count.clone();
+            let worker = thread::spawn(move || {
+                SharedPoolThread::<PanickingNetworker, MockRequestHandler>::new(receiver, wake_recv_socket, thread_pools_count).work();
+            });
+
+            let name = "shared_pool_thread_finishes_pool_panicked_in_poll_0";
+            let (_send_cmd_sock, recv_cmd_sock) = pool_create_pair_of_sockets(name);
+            let pool: Pool<PanickingNetworker, MockRequestHandler> = Pool::new(name, next_pool_handle(), PoolOpenConfig::default());
+            let (done_sender, done_receiver) = channel();
+
+            pools_count.fetch_add(1, Ordering::SeqCst);
+            sender.send(SharedPoolParams { params: pool._thread_params(recv_cmd_sock), done: done_sender }).unwrap();
+            wake_socket.send(COMMAND_WAKE.as_bytes(), zmq::DONTWAIT).unwrap();
+
+            // The pool is finished, the thread survives and stops normally
+            assert_eq!(Err(RecvTimeoutError::Disconnected), done_receiver.recv_timeout(Duration::from_secs(10)));
+            assert_eq!(0, pools_count.load(Ordering::SeqCst));
+
+            drop(sender);
+            wake_socket.send(COMMAND_WAKE.as_bytes(), zmq::DONTWAIT).unwrap();
+            worker.join().unwrap();
+        }
+    }
+
     mod other {
         use super::*;
 
@@ -17,6 +17,7 @@ use crate::commands::ledger::LedgerCommand;
 use indy_api_types::errors::prelude::*;
 use crate::services::ledger::merkletree::merkletree::MerkleTree;
 use crate::services::pool::catchup::{build_catchup_req, CatchupProgress, check_cons_proofs, check_nodes_responses_on_status};
+use crate::services::pool::events::ledger_status_req_id;
 use crate::services::pool::events::NetworkerEvent;
 use crate::services::pool::events::PoolEvent;
 use crate::services::pool::events::RequestEvent;
@@ -25,6 +26,7 @@ use crate::services::pool::merkle_tree_factory;
 use crate::services::pool::networker::Networker;
 use crate::services::pool::state_proof;
 use crate::services::pool::types::CatchupRep;
+use crate::services::pool::types::ConsistencyProof;
 use crate::services::pool::types::HashableValue;
 
 use super::ursa::bls::Generator;
@@ -47,12 +49,13 @@ struct RequestSM<T: Networker> {
 }
 
 /// Transitions of request state
-/// Start -> Start, Single, Consensus, CatchupSingle, CatchupConsensus, Full, Finish
+/// Start -> Start, Single, Consensus, CatchupSingle, CatchupConsensus, Full, LedgerTxns, Finish
 /// Single -> Single, Finish
 /// Consensus -> Consensus, Finish
 /// CatchupSingle -> CatchupSingle, Finish
 /// CatchupConsensus -> CatchupConsensus, Finish
 /// Full -> Full, Finish
+/// LedgerTxns -> LedgerTxns, Finish
 /// Finish -> Finish
 enum RequestState<T: Networker> {
     Start(StartState<T>),
@@ -61,6 +64,7 @@ enum RequestState<T: Networker> {
     CatchupSingle(CatchupSingleState<T>),
     CatchupConsensus(CatchupConsensusState<T>),
     Full(FullState<T>),
+    LedgerTxns(LedgerTxnsState<T>),
     Finish(FinishState),
 }
 
@@ -155,6 +159,12 @@ struct FullState<T: Networker> {
     networker: Rc<RefCell<T>>,
 }
 
+struct LedgerTxnsState<T: Networker> {
+    req_id: String,
+    failed_nodes: HashSet<String>,
+    networker: Rc<RefCell<T>>,
+}
+
 struct FinishState {}
 
 impl<T: Networker> From<(StartState<T>, Option<Vec<u8>>, (Option<u64>, Option<u64>))> for SingleState<T> {
@@ -223,6 +233,16 @@ impl<T: Networker> From<(Option<Vec<String>>, StartState<T>)> for FullState<T> {
     }
 }
 
+impl<T: Networker> From<(StartState<T>, String)> for LedgerTxnsState<T> {
+    fn from((state, req_id): (StartState<T>, String)) -> Self {
+        LedgerTxnsState {
+            req_id,
+            failed_nodes: HashSet::new(),
+            networker: state.networker.clone(),
+        }
+    }
+}
+
 impl<T: Networker> RequestState<T> {
     fn finish() -> RequestState<T> {
         RequestState::Finish(FinishState {})
@@ -315,10 +335,15 @@ impl<T: Networker> RequestSM<T> {
                             (RequestState::Full((None, state).into()), None)
                         }
                     }
-                    RequestEvent::CustomConsensusRequest(msg, req_id) => {
+                    RequestEvent::CustomConsensusRequest(msg, req_id) |
+                    RequestEvent::LedgerTxnsTargetRequest(msg, req_id) => {
                         state.networker.borrow_mut().process_event(Some(NetworkerEvent::SendAllRequest(msg, req_id, timeout, None)));
                         (RequestState::Consensus(state.into()), None)
                     }
+                    RequestEvent::LedgerTxnsRequest(msg, req_id) => {
+                        state.networker.borrow_mut().process_event(Some(NetworkerEvent::SendOneRequest(msg, req_id.clone(), timeout)));
+                        (RequestState::LedgerTxns((state, req_id).into()), None)
+                    }
                     _ => {
                         (RequestState::Start(state), None)
                     }
@@ -332,26 +357,7 @@ impl<T: Networker> RequestSM<T> {
                     => {
                         if let Ok((_, result_without_proof)) = _get_msg_result_without_state_proof(&raw_msg) {
                             let hashable = HashableValue { inner: result_without_proof };
-
-                            let cnt = {
-                                let set = state.replies.entry(hashable).or_insert_with(HashSet::new);
-                                set.insert(node_alias.clone());
-                                set.len()
-                            };
-
-                            if cnt > f {
-                                _send_ok_replies(&cmd_ids, &raw_msg);
-                                state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, None)));
-                                (RequestState::finish(), None)
-                            } else if state.is_consensus_reachable(f, nodes.len()) {
-                                state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, Some(node_alias))));
-                                (RequestState::Consensus(state), None)
-                            } else {
-                                //TODO: maybe we should change the error, but it was made to escape changing of ErrorCode returned to client
-                                _send_replies(&cmd_ids, Err(err_msg(IndyErrorKind::PoolTimeout, "Consensus is impossible")));
-                                state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, None)));
-                                (RequestState::finish(), None)
-                            }
+                            (RequestSM::_consensus_handle_reply(state, hashable, raw_msg, node_alias, req_id, f, &cmd_ids, &nodes), None)
                         } else {
                             state.denied_nodes.insert(node_alias.clone());
                             if state.denied_nodes.len() + state.replies.len() == nodes.len() {
@@ -362,6 +368,17 @@ impl<T: Networker> RequestSM<T> {
                             }
                         }
                     }
+                    RequestEvent::LedgerStatus(ls, Some(node_alias), _) => {
+                        let req_id = ledger_status_req_id(ls.ledgerId as usize);
+                        let cp = _ledger_status_to_consistency_proof(ls);
+                        let (hashable, raw_msg) = _ledger_txns_target(&cp);
+                        (RequestSM::_consensus_handle_reply(state, hashable, raw_msg, node_alias, req_id, f, &cmd_ids, &nodes), None)
+                    }
+                    RequestEvent::ConsistencyProof(cp, node_alias) => {
+                        let req_id = ledger_status_req_id(cp.ledgerId);
+                        let (hashable, raw_msg) = _ledger_txns_target(&cp);
+                        (RequestSM::_consensus_handle_reply(state, hashable, raw_msg, node_alias, req_id, f, &cmd_ids, &nodes), None)
+                    }
                     RequestEvent::ReqACK(_, _, node_alias, req_id) => {
                         state.networker.borrow_mut().process_event(Some(NetworkerEvent::ExtendTimeout(req_id, node_alias, extended_timeout)));
                         (RequestState::Consensus(state), None)
@@ -407,7 +424,7 @@ impl<T: Networker> RequestSM<T> {
                             };
 
                             if cnt > f
-                                || _check_state_proof(&result, f, &generator, &nodes, &raw_msg, state.sp_key.as_ref().map(Vec::as_slice), state.timestamps, last_write_time) {
+                                || _check_state_proof(&result, f, &generator, &nodes, &pool_name, &raw_msg, state.sp_key.as_ref().map(Vec::as_slice), state.timestamps, last_write_time) {
                                 state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, None)));
                                 _send_ok_replies(&cmd_ids, if cnt > f { &soonest } else { &raw_msg });
                                 (RequestState::finish(), None)
@@ -507,6 +524,25 @@ impl<T: Networker> RequestSM<T> {
                     _ => (RequestState::Full(state), None),
                 }
             }
+            RequestState::LedgerTxns(state) => {
+                match re {
+                    RequestEvent::CatchupRep(cr, _) => {
+                        let reply = serde_json::to_string(&cr)
+                            .to_indy(IndyErrorKind::InvalidState, "Cannot serialize CatchupRep");
+                        state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(state.req_id.clone(), None)));
+                        _send_replies(&cmd_ids, reply);
+                        (RequestState::finish(), None)
+                    }
+                    RequestEvent::Timeout(_, node_alias) => {
+                        (state.try_next_node(node_alias, &cmd_ids, nodes.len(), timeout), None)
+                    }
+                    RequestEvent::Terminate => {
+                        _finish_request(&cmd_ids);
+                        (RequestState::finish(), None)
+                    }
+                    _ => (RequestState::LedgerTxns(state), None)
+                }
+            }
             RequestState::Finish(state) => (RequestState::Finish(state), None)
         };
         (RequestSM::step(f, cmd_ids, nodes, generator, pool_name, timeout, extended_timeout, number_read_nodes, state), event)
@@ -519,7 +555,8 @@ impl<T: Networker> RequestSM<T> {
             RequestState::Single(_) |
             RequestState::CatchupSingle(_) |
             RequestState::CatchupConsensus(_) |
-            RequestState::Full(_) => false,
+            RequestState::Full(_) |
+            RequestState::LedgerTxns(_) => false,
             RequestState::Finish(_) => true
         }
     }
@@ -555,6 +592,32 @@ impl<T: Networker> RequestSM<T> {
         }
     }
 
+    fn _consensus_handle_reply(mut state: ConsensusState<T>,
+                               hashable: HashableValue, raw_msg: String,
+                               node_alias: String, req_id: String,
+                               f: usize, cmd_ids: &[CommandHandle],
+                               nodes: &Nodes) -> RequestState<T> {
+        let cnt = {
+            let set = state.replies.entry(hashable).or_insert_with(HashSet::new);
+            set.insert(node_alias.clone());
+            set.len()
+        };
+
+        if cnt > f {
+            _send_ok_replies(&cmd_ids, &raw_msg);
+            state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, None)));
+            RequestState::finish()
+        } else if state.is_consensus_reachable(f, nodes.len()) {
+            state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, Some(node_alias))));
+            RequestState::Consensus(state)
+        } else {
+            //TODO: maybe we should change the error, but it was made to escape changing of ErrorCode returned to client
+            _send_replies(&cmd_ids, Err(err_msg(IndyErrorKind::PoolTimeout, "Consensus is impossible")));
+            state.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(req_id, None)));
+            RequestState::finish()
+        }
+    }
+
     fn _catchup_target_handle_consensus_state(mut state: CatchupConsensusState<T>,
                                               mt_root: String, sz: usize, cons_proof: Option<Vec<String>>,
                                               node_alias: String, req_id: String,
@@ -677,6 +740,47 @@ impl<T: Networker> ConsensusState<T> {
     }
 }
 
+impl<T: Networker> LedgerTxnsState<T> {
+    fn try_next_node(mut self, node_alias: String, cmd_ids: &[CommandHandle], nodes_cnt: usize, timeout: i64) -> RequestState<T> {
+        self.failed_nodes.insert(node_alias.clone());
+
+        if self.failed_nodes.len() < nodes_cnt {
+            self.networker.borrow_mut().process_event(Some(NetworkerEvent::Resend(self.req_id.clone(), timeout)));
+            self.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(self.req_id.clone(), Some(node_alias))));
+            RequestState::LedgerTxns(self)
+        } else {
+            _send_replies(cmd_ids, Err(err_msg(IndyErrorKind::PoolTimeout, "No node returned requested transactions")));
+            self.networker.borrow_mut().process_event(Some(NetworkerEvent::CleanTimeout(self.req_id.clone(), None)));
+            RequestState::finish()
+        }
+    }
+}
+
+/// LEDGER_STATUS reply means that the node has no transactions after requested one.
+fn _ledger_status_to_consistency_proof(ls: super::types::LedgerStatus) -> ConsistencyProof {
+    ConsistencyProof {
+        seqNoEnd: ls.txnSeqNo,
+        seqNoStart: ls.txnSeqNo,
+        ledgerId: ls.ledgerId as usize,
+        hashes: Vec::new(),
+        oldMerkleRoot: ls.merkleRoot.clone(),
+        newMerkleRoot: ls.merkleRoot,
+    }
+}
+
+fn _ledger_txns_target(cp: &ConsistencyProof) -> (HashableValue, String) {
+    let value = json!({
+        "seqNoStart": cp.seqNoStart,
+        "seqNoEnd": cp.seqNoEnd,
+        "ledgerId": cp.ledgerId,
+        "hashes": cp.hashes,
+        "oldMerkleRoot": cp.oldMerkleRoot,
+        "newMerkleRoot": cp.newMerkleRoot,
+    });
+    let raw_msg = value.to_string();
+    (HashableValue { inner: value }, raw_msg)
+}
+
 fn _parse_nack(denied_nodes: &mut HashSet<String>, f: usize, raw_msg: &str, cmd_ids: &[CommandHandle], node_alias: &str) -> bool {
     if denied_nodes.len() == f {
         _send_ok_replies(cmd_ids, raw_msg);
@@ -717,7 +821,7 @@ fn _finish_request(cmd_ids: &[CommandHandle]) {
 
 fn _send_replies(cmd_ids: &[CommandHandle], msg: IndyResult<String>) {
     cmd_ids.iter().for_each(|id| {
-        CommandExecutor::instance().send(
+        CommandExecutor::instance().send_internal(
             Command::Ledger(
                 LedgerCommand::SubmitAck(*id, msg.clone()))
         ).unwrap();
@@ -740,13 +844,13 @@ fn _get_msg_result_without_state_proof(msg: &str) -> IndyResult<(SJsonValue, SJs
     Ok((msg_result, msg_result_without_proof))
 }
 
-fn _check_state_proof(msg_result: &SJsonValue, f: usize, gen: &Generator, bls_keys: &Nodes, raw_msg: &str, sp_key: Option<&[u8]>, requested_timestamps: (Option<u64>, Option<u64>), last_write_time: u64) -> bool {
+fn _check_state_proof(msg_result: &SJsonValue, f: usize, gen: &Generator, bls_keys: &Nodes, pool_name: &str, raw_msg: &str, sp_key: Option<&[u8]>, requested_timestamps: (Option<u64>, Option<u64>), last_write_time: u64) -> bool {
     debug!("TransactionHandler::process_reply: Try to verify proof and signature >>");
 
     let proof_checking_res = match state_proof::parse_generic_reply_for_proof_checking(&msg_result, raw_msg, sp_key) {
         Some(parsed_sps) => {
             debug!("TransactionHandler::process_reply: Proof and signature are present");
-            state_proof::verify_parsed_sp(parsed_sps, bls_keys, f, gen)
+            state_proof::verify_parsed_sp(parsed_sps, bls_keys, f, gen, pool_name)
         }
         None => false
     };
@@ -924,7 +1028,7 @@ pub mod tests {
     }
 
     fn _request_handler(pool_name: &str, f: usize, nodes_cnt: usize) -> RequestHandlerImpl<MockNetworker> {
-        let networker = Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new())));
+        let networker = Rc::new(RefCell::new(MockNetworker::new(0, 0, vec![], String::new(), 0)));
 
         let mut default_nodes: Nodes = HashMap::new();
         default_nodes.insert(NODE.to_string(), None);
@@ -1037,6 +1141,20 @@ pub mod tests {
             assert_match!(RequestState::Consensus(_), request_handler.request_wrapper.unwrap().state);
         }
 
+        #[test]
+        fn request_handler_process_ledger_txns_target_req_event_from_start_works() {
+            let mut request_handler = _request_handler("request_handler_process_ledger_txns_target_req_event_from_start_works", 0, 1);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsTargetRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            assert_match!(RequestState::Consensus(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_ledger_txns_req_event_from_start_works() {
+            let mut request_handler = _request_handler("request_handler_process_ledger_txns_req_event_from_start_works", 0, 1);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            assert_match!(RequestState::LedgerTxns(_), request_handler.request_wrapper.unwrap().state);
+        }
+
         #[test]
         fn request_handler_process_other_event_from_start_works() {
             let mut request_handler = _request_handler("request_handler_process_other_event_from_start_works", 0, 1);
@@ -1125,6 +1243,33 @@ pub mod tests {
             assert_match!(RequestState::Consensus(_), request_handler.request_wrapper.unwrap().state);
         }
 
+        #[test]
+        fn request_handler_process_consistency_proof_event_from_consensus_state_works_for_consensus_reached() {
+            let mut request_handler = _request_handler("request_handler_process_consistency_proof_event_from_consensus_state_works_for_consensus_reached", 1, 4);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsTargetRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::ConsistencyProof(ConsistencyProof::default(), NODE.to_string())));
+            request_handler.process_event(Some(RequestEvent::ConsistencyProof(ConsistencyProof::default(), NODE_2.to_string())));
+            assert_match!(RequestState::Finish(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_ledger_status_event_from_consensus_state_works_for_consensus_reached_with_consistency_proof() {
+            let mut request_handler = _request_handler("request_handler_process_ledger_status_event_from_consensus_state_works_for_consensus_reached_with_consistency_proof", 1, 4);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsTargetRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::ConsistencyProof(ConsistencyProof::default(), NODE.to_string())));
+            request_handler.process_event(Some(RequestEvent::LedgerStatus(LedgerStatus::default(), Some(NODE_2.to_string()), None)));
+            assert_match!(RequestState::Finish(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_consistency_proof_event_from_consensus_state_works_for_consensus_reachable() {
+            let mut request_handler = _request_handler("request_handler_process_consistency_proof_event_from_consensus_state_works_for_consensus_reachable", 1, 4);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsTargetRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::ConsistencyProof(ConsistencyProof::default(), NODE.to_string())));
+            request_handler.process_event(Some(RequestEvent::ConsistencyProof(ConsistencyProof { seqNoEnd: 1, ..ConsistencyProof::default() }, NODE_2.to_string())));
+            assert_match!(RequestState::Consensus(_), request_handler.request_wrapper.unwrap().state);
+        }
+
         #[test]
         fn request_handler_process_reqack_event_from_consensus_state_works() {
             let mut request_handler = _request_handler("request_handler_process_reqack_event_from_consensus_state_works", 1, 4);
@@ -1765,6 +1910,57 @@ pub mod tests {
         }
     }
 
+    mod ledger_txns {
+        use super::*;
+
+        fn _catchup_rep() -> CatchupRep {
+            let mut txns: HashMap<String, SJsonValue> = HashMap::new();
+            txns.insert("1".to_string(), json!({"txn": {}}));
+            CatchupRep { ledgerId: 1, consProof: Vec::new(), txns }
+        }
+
+        #[test]
+        fn request_handler_process_catchup_reply_event_from_ledger_txns_state_works() {
+            let mut request_handler = _request_handler("request_handler_process_catchup_reply_event_from_ledger_txns_state_works", 0, 1);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::CatchupRep(_catchup_rep(), NODE.to_string())));
+            assert_match!(RequestState::Finish(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_timeout_event_from_ledger_txns_state_works() {
+            let mut request_handler = _request_handler("request_handler_process_timeout_event_from_ledger_txns_state_works", 0, 2);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::Timeout(REQ_ID.to_string(), NODE.to_string())));
+            assert_match!(RequestState::LedgerTxns(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_timeout_event_from_ledger_txns_state_works_for_all_nodes_failed() {
+            let mut request_handler = _request_handler("request_handler_process_timeout_event_from_ledger_txns_state_works_for_all_nodes_failed", 0, 2);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::Timeout(REQ_ID.to_string(), NODE.to_string())));
+            request_handler.process_event(Some(RequestEvent::Timeout(REQ_ID.to_string(), NODE_2.to_string())));
+            assert_match!(RequestState::Finish(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_terminate_event_from_ledger_txns_state_works() {
+            let mut request_handler = _request_handler("request_handler_process_terminate_event_from_ledger_txns_state_works", 0, 1);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::Terminate));
+            assert_match!(RequestState::Finish(_), request_handler.request_wrapper.unwrap().state);
+        }
+
+        #[test]
+        fn request_handler_process_other_event_from_ledger_txns_state_works() {
+            let mut request_handler = _request_handler("request_handler_process_other_event_from_ledger_txns_state_works", 0, 1);
+            request_handler.process_event(Some(RequestEvent::LedgerTxnsRequest(MESSAGE.to_string(), REQ_ID.to_string())));
+            request_handler.process_event(Some(RequestEvent::Pong));
+            assert_match!(RequestState::LedgerTxns(_), request_handler.request_wrapper.unwrap().state);
+        }
+    }
+
     mod finish {
         use super::*;
 
@@ -1,7 +1,7 @@
 extern crate log_derive;
 extern crate rmp_serde;
 
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::ffi::{CStr, CString};
 use indy_utils::crypto::hash::{Hash};
 use rust_base58::ToBase58;
@@ -27,6 +27,7 @@ use rust_base58::FromBase58;
 use crate::services::pool::Nodes;
 
 mod node;
+mod signature_cache;
 
 pub fn parse_generic_reply_for_proof_checking(json_msg: &SJsonValue, raw_msg: &str, sp_key: Option<&[u8]>) -> Option<Vec<ParsedSP>> {
     let type_ = if let Some(type_) = json_msg["type"].as_str() {
@@ -78,7 +79,8 @@ pub fn parse_generic_reply_for_proof_checking(json_msg: &SJsonValue, raw_msg: &s
 pub fn verify_parsed_sp(parsed_sps: Vec<ParsedSP>,
                         nodes: &Nodes,
                         f: usize,
-                        gen: &Generator) -> bool {
+                        gen: &Generator,
+                        pool_name: &str) -> bool {
     for parsed_sp in parsed_sps {
         if parsed_sp.multi_signature["value"]["state_root_hash"].as_str().ne(
             &Some(&parsed_sp.root_hash)) && parsed_sp.multi_signature["value"]["txn_root_hash"].as_str().ne(
@@ -93,7 +95,7 @@ pub fn verify_parsed_sp(parsed_sps: Vec<ParsedSP>,
         if !_verify_proof_signature(signature,
                                     participants.as_slice(),
                                     &value,
-                                    nodes, f, gen)
+                                    nodes, f, gen, pool_name)
             .map_err(|err| warn!("{:?}", err)).unwrap_or(false) {
             return false;
         }
@@ -706,15 +708,18 @@ fn _verify_proof_signature(signature: &str,
                            value: &[u8],
                            nodes: &Nodes,
                            f: usize,
-                           gen: &Generator) -> IndyResult<bool> {
+                           gen: &Generator,
+                           pool_name: &str) -> IndyResult<bool> {
     trace!("verify_proof_signature: >>> signature: {:?}, participants: {:?}, pool_state_root: {:?}", signature, participants, value);
 
-    let mut ver_keys: Vec<&VerKey> = Vec::with_capacity(nodes.len());
+    let participants: HashSet<&str> = participants.iter().cloned().collect();
+
+    let mut ver_keys: Vec<(&str, &VerKey)> = Vec::with_capacity(participants.len());
 
     for (name, verkey) in nodes {
-        if participants.contains(&name.as_str()) {
+        if participants.contains(name.as_str()) {
             match *verkey {
-                Some(ref blskey) => ver_keys.push(blskey),
+                Some(ref blskey) => ver_keys.push((name.as_str(), blskey)),
                 _ => return Err(err_msg(IndyErrorKind::InvalidState, format!("Blskey not found for node: {:?}", name)))
             };
         }
@@ -726,28 +731,43 @@ fn _verify_proof_signature(signature: &str,
         return Ok(false);
     }
 
-    let signature =
+    if signature_cache::is_verified(pool_name, nodes, signature, value, &ver_keys) {
+        debug!("verify_proof_signature: <<< res: true (cached)");
+        return Ok(true);
+    }
+
+    let multi_signature =
         if let Ok(signature) = signature.from_base58() {
             signature
         } else {
             return Ok(false);
         };
 
-    let signature =
-        if let Ok(signature) = MultiSignature::from_bytes(signature.as_slice()) {
+    let multi_signature =
+        if let Ok(signature) = MultiSignature::from_bytes(multi_signature.as_slice()) {
             signature
         } else {
             return Ok(false);
         };
 
-    debug!("verify_proof_signature: signature: {:?}", signature);
+    debug!("verify_proof_signature: signature: {:?}", multi_signature);
+
+    let bls_keys: Vec<&VerKey> = ver_keys.iter().map(|&(_, ver_key)| ver_key).collect();
 
-    let res = Bls::verify_multi_sig(&signature, value, ver_keys.as_slice(), gen).unwrap_or(false);
+    let res = Bls::verify_multi_sig(&multi_signature, value, bls_keys.as_slice(), gen).unwrap_or(false);
+
+    if res {
+        signature_cache::mark_verified(pool_name, nodes, signature, value, &ver_keys);
+    }
 
     debug!("verify_proof_signature: <<< res: {:?}", res);
     Ok(res)
 }
 
+pub fn invalidate_signature_cache(pool_name: &str) {
+    signature_cache::invalidate(pool_name)
+}
+
 fn _parse_reply_for_proof_value(json_msg: &SJsonValue, data: Option<&str>, parsed_data: &SJsonValue, xtype: &str, sp_key: &[u8]) -> Result<Option<String>, String> {
     if let Some(data) = data {
         let mut value = json!({});
@@ -0,0 +1,241 @@
+//! Per-pool cache of already verified BLS multi-signatures.
+//!
+//! Between write batches the pool signs a single state root, so every state proof reply
+//! received in that window carries the same multi-signature over the same value.
+//! Verifying it costs a pairing check, while the result depends only on the signature,
+//! the signed value and the BLS keys of the participants, so it can be remembered.
+//!
+//! Entries are bounded per pool and the whole pool cache is dropped as soon as the set of
+//! node BLS keys known from the pool ledger changes.
+
+use std::collections::{HashMap, HashSet, VecDeque};
+use std::sync::Mutex;
+
+use ursa::bls::VerKey;
+
+use indy_utils::crypto::hash::{hash, HASHBYTES};
+use crate::services::pool::Nodes;
+
+/// Max number of verified signatures remembered for one pool.
+pub const SIGNATURE_CACHE_CAPACITY: usize = 256;
+
+lazy_static! {
+    static ref SIGNATURE_CACHES: Mutex<HashMap<String, PoolSignatureCache>> = Mutex::new(HashMap::new());
+}
+
+type CacheKey = [u8; HASHBYTES];
+
+struct PoolSignatureCache {
+    nodes_fingerprint: CacheKey,
+    verified: HashSet<CacheKey>,
+    order: VecDeque<CacheKey>,
+}
+
+impl PoolSignatureCache {
+    fn new(nodes_fingerprint: CacheKey) -> PoolSignatureCache {
+        PoolSignatureCache {
+            nodes_fingerprint,
+            verified: HashSet::new(),
+            order: VecDeque::new(),
+        }
+    }
+
+    fn insert(&mut self, key: CacheKey) {
+        if !self.verified.insert(key) {
+            return;
+        }
+
+        self.order.push_back(key);
+
+        while self.order.len() > SIGNATURE_CACHE_CAPACITY {
+            if let Some(oldest) = self.order.pop_front() {
+                self.verified.remove(&oldest);
+            }
+        }
+    }
+}
+
+/// Returns true if this exact (signature, value, participants) tuple was already verified
+/// for the pool with the current node BLS keys.
+pub fn is_verified(pool_name: &str, nodes: &Nodes, signature: &str, value: &[u8], ver_keys: &[(&str, &VerKey)]) -> bool {
+    let (nodes_fingerprint, key) = match (_nodes_fingerprint(nodes), _entry_key(signature, value, ver_keys)) {
+        (Some(nodes_fingerprint), Some(key)) => (nodes_fingerprint, key),
+        _ => return false
+    };
+
+    let mut caches = SIGNATURE_CACHES.lock().unwrap();
+
+    let up_to_date = caches.get(pool_name)
+        .map(|cache| cache.nodes_fingerprint == nodes_fingerprint);
+
+    match up_to_date {
+        Some(true) => caches.get(pool_name).map(|cache| cache.verified.contains(&key)).unwrap_or(false),
+        Some(false) => {
+            trace!("signature_cache: node BLS keys changed for pool {:?}, invalidate", pool_name);
+            caches.remove(pool_name);
+            false
+        }
+        None => false
+    }
+}
+
+/// Remembers successful verification of (signature, value, participants) tuple for the pool.
+pub fn mark_verified(pool_name: &str, nodes: &Nodes, signature: &str, value: &[u8], ver_keys: &[(&str, &VerKey)]) {
+    let (nodes_fingerprint, key) = match (_nodes_fingerprint(nodes), _entry_key(signature, value, ver_keys)) {
+        (Some(nodes_fingerprint), Some(key)) => (nodes_fingerprint, key),
+        _ => return
+    };
+
+    let mut caches = SIGNATURE_CACHES.lock().unwrap();
+
+    let cache = caches
+        .entry(pool_name.to_string())
+        .or_insert_with(|| PoolSignatureCache::new(nodes_fingerprint));
+
+    if cache.nodes_fingerprint != nodes_fingerprint {
+        *cache = PoolSignatureCache::new(nodes_fingerprint);
+    }
+
+    cache.insert(key);
+}
+
+/// Drops everything remembered for the pool.
+pub fn invalidate(pool_name: &str) {
+    SIGNATURE_CACHES.lock().unwrap().remove(pool_name);
+}
+
+fn _nodes_fingerprint(nodes: &Nodes) -> Option<CacheKey> {
+    let mut names: Vec<&String> = nodes.keys().collect();
+    names.sort();
+
+    let mut buf: Vec<u8> = Vec::new();
+
+    for name in names {
+        buf.extend_from_slice(name.as_bytes());
+        buf.push(0x00);
+        if let Some(Some(ref ver_key)) = nodes.get(name) {
+            buf.extend_from_slice(ver_key.as_bytes());
+        }
+        buf.push(0x00);
+    }
+
+    _digest(&buf)
+}
+
+fn _entry_key(signature: &str, value: &[u8], ver_keys: &[(&str, &VerKey)]) -> Option<CacheKey> {
+    let mut ver_keys = ver_keys.to_vec();
+    ver_keys.sort_by_key(|&(name, _)| name);
+
+    let mut buf: Vec<u8> = Vec::new();
+
+    buf.extend_from_slice(signature.as_bytes());
+    buf.push(0x00);
+    buf.extend_from_slice(value);
+    buf.push(0x00);
+
+    for (name, ver_key) in ver_keys {
+        buf.extend_from_slice(name.as_bytes());
+        buf.push(0x00);
+        buf.extend_from_slice(ver_key.as_bytes());
+    }
+
+    _digest(&buf)
+}
+
+fn _digest(buf: &[u8]) -> Option<CacheKey> {
+    let digest = hash(buf).ok()?;
+
+    let mut key = [0u8; HASHBYTES];
+    key.copy_from_slice(&digest[..HASHBYTES]);
+    Some(key)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use ursa::bls::{Generator, SignKey};
+
+    fn _nodes(names: &[&str]) -> Nodes {
+        let gen = Generator::new().unwrap();
+
+        names.iter()
+            .map(|name| {
+                let sign_key = SignKey::new(None).unwrap();
+                (name.to_string(), Some(VerKey::new(&gen, &sign_key).unwrap()))
+            })
+            .collect()
+    }
+
+    fn _ver_keys(nodes: &Nodes) -> Vec<(&str, &VerKey)> {
+        nodes.iter()
+            .map(|(name, ver_key)| (name.as_str(), ver_key.as_ref().unwrap()))
+            .collect()
+    }
+
+    #[test]
+    fn signature_cache_works() {
+        let pool_name = "signature_cache_works";
+        let nodes = _nodes(&["Node1", "Node2", "Node3", "Node4"]);
+        let ver_keys = _ver_keys(&nodes);
+
+        assert!(!is_verified(pool_name, &nodes, "sig", b"value", &ver_keys));
+
+        mark_verified(pool_name, &nodes, "sig", b"value", &ver_keys);
+
+        assert!(is_verified(pool_name, &nodes, "sig", b"value", &ver_keys));
+        assert!(!is_verified(pool_name, &nodes, "sig", b"other_value", &ver_keys));
+        assert!(!is_verified(pool_name, &nodes, "other_sig", b"value", &ver_keys));
+        assert!(!is_verified(pool_name, &nodes, "sig", b"value", &ver_keys[1..]));
+        assert!(!is_verified("other_pool", &nodes, "sig", b"value", &ver_keys));
+
+        invalidate(pool_name);
+    }
+
+    #[test]
+    fn signature_cache_works_for_participants_order() {
+        let pool_name = "signature_cache_works_for_participants_order";
+        let nodes = _nodes(&["Node1", "Node2", "Node3", "Node4"]);
+        let ver_keys = _ver_keys(&nodes);
+
+        mark_verified(pool_name, &nodes, "sig", b"value", &ver_keys);
+
+        let mut reversed = ver_keys.clone();
+        reversed.reverse();
+        assert!(is_verified(pool_name, &nodes, "sig", b"value", &reversed));
+
+        invalidate(pool_name);
+    }
+
+    #[test]
+    fn signature_cache_invalidated_on_node_keys_change() {
+        let pool_name = "signature_cache_invalidated_on_node_keys_change";
+        let nodes = _nodes(&["Node1", "Node2", "Node3", "Node4"]);
+        let ver_keys = _ver_keys(&nodes);
+
+        mark_verified(pool_name, &nodes, "sig", b"value", &ver_keys);
+
+        let mut rotated = nodes.clone();
+        rotated.insert("Node4".to_string(), _nodes(&["Node4"]).remove("Node4").unwrap());
+
+        assert!(!is_verified(pool_name, &rotated, "sig", b"value", &ver_keys));
+        assert!(!is_verified(pool_name, &nodes, "sig", b"value", &ver_keys));
+    }
+
+    #[test]
+    fn signature_cache_is_bounded() {
+        let pool_name = "signature_cache_is_bounded";
+        let nodes = _nodes(&["Node1", "Node2", "Node3", "Node4"]);
+        let ver_keys = _ver_keys(&nodes);
+
+        for i in 0..SIGNATURE_CACHE_CAPACITY + 1 {
+            mark_verified(pool_name, &nodes, &format!("sig_{}", i), b"value", &ver_keys);
+        }
+
+        assert!(!is_verified(pool_name, &nodes, "sig_0", b"value", &ver_keys));
+        assert!(is_verified(pool_name, &nodes, "sig_1", b"value", &ver_keys));
+        assert!(is_verified(pool_name, &nodes, &format!("sig_{}", SIGNATURE_CACHE_CAPACITY), b"value", &ver_keys));
+
+        invalidate(pool_name);
+    }
+}
@@ -3742,6 +3742,53 @@ mod high_cases {
         }
     }
 
+    mod issuer_fill_credential_def_key_pool {
+        use super::*;
+
+        #[test]
+        fn issuer_fill_credential_def_key_pool_works() {
+            let setup = Setup::wallet();
+
+            anoncreds::issuer_fill_credential_def_key_pool(setup.wallet_handle,
+                                                           &anoncreds::gvt_schema_json(),
+                                                           &anoncreds::cred_def_key_pool_config(2)).unwrap();
+
+            // filling the already full pool does nothing
+            anoncreds::issuer_fill_credential_def_key_pool(setup.wallet_handle,
+                                                           &anoncreds::gvt_schema_json(),
+                                                           &anoncreds::cred_def_key_pool_config(2)).unwrap();
+        }
+
+        #[test]
+        fn issuer_create_and_store_credential_def_works_for_filled_key_pool() {
+            let setup = Setup::wallet();
+
+            anoncreds::issuer_fill_credential_def_key_pool(setup.wallet_handle,
+                                                           &anoncreds::gvt_schema_json(),
+                                                           &anoncreds::cred_def_key_pool_config(2)).unwrap();
+
+            let (_, cred_def_json_1) = anoncreds::issuer_create_credential_definition(setup.wallet_handle,
+                                                                                      ISSUER_DID,
+                                                                                      &anoncreds::gvt_schema_json(),
+                                                                                      TAG_1,
+                                                                                      None,
+                                                                                      Some(&anoncreds::default_cred_def_config())).unwrap();
+
+            let (_, cred_def_json_2) = anoncreds::issuer_create_credential_definition(setup.wallet_handle,
+                                                                                      ISSUER_DID,
+                                                                                      &anoncreds::gvt_schema_json(),
+                                                                                      TAG_2,
+                                                                                      None,
+                                                                                      Some(&anoncreds::default_cred_def_config())).unwrap();
+
+            let cred_def_1: serde_json::Value = serde_json::from_str(&cred_def_json_1).unwrap();
+            let cred_def_2: serde_json::Value = serde_json::from_str(&cred_def_json_2).unwrap();
+
+            // pooled keys are never shared between credential definitions
+            assert_ne!(cred_def_1["value"], cred_def_2["value"]);
+        }
+    }
+
     mod to_unqualified {
         use super::*;
         use utils::domain::anoncreds::schema::SchemaV1;
@@ -3995,6 +4042,30 @@ mod medium_cases {
         }
     }
 
+    mod issuer_fill_credential_def_key_pool {
+        use super::*;
+
+        #[test]
+        fn issuer_fill_credential_def_key_pool_works_for_zero_size() {
+            let setup = Setup::wallet();
+
+            let res = anoncreds::issuer_fill_credential_def_key_pool(setup.wallet_handle,
+                                                                     &anoncreds::gvt_schema_json(),
+                                                                     &anoncreds::cred_def_key_pool_config(0));
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn issuer_fill_credential_def_key_pool_works_for_invalid_wallet_handle() {
+            let _setup = Setup::empty();
+
+            let res = anoncreds::issuer_fill_credential_def_key_pool(INVALID_WALLET_HANDLE,
+                                                                     &anoncreds::gvt_schema_json(),
+                                                                     &anoncreds::cred_def_key_pool_config(1));
+            assert_code!(ErrorCode::WalletInvalidHandle, res);
+        }
+    }
+
     mod issuer_create_credential_offer {
         use super::*;
 
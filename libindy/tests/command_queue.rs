@@ -0,0 +1,112 @@
+#[macro_use]
+mod utils;
+
+inject_indy_dependencies!();
+
+extern crate indyrs as indy;
+extern crate indyrs as api;
+extern crate futures;
+extern crate indy_sys;
+
+use std::collections::HashMap;
+use std::sync::Mutex;
+
+use serde_json::Value;
+
+use crate::utils::{metrics, pairwise};
+use crate::utils::Setup;
+
+use self::futures::Future;
+use self::indy::{CommandHandle, ErrorCode};
+use self::libc::c_char;
+
+const QUEUE_SIZE: usize = 16;
+const BURST_SIZE: usize = 5000;
+
+lazy_static! {
+    // Command handles and results of list_pairwise callbacks in the order they were called
+    static ref COMPLETED: Mutex<Vec<(CommandHandle, ErrorCode)>> = Default::default();
+}
+
+extern fn _list_pairwise_cb(command_handle: CommandHandle, err: indy_sys::Error, _pairwise_list: *const c_char) {
+    COMPLETED.lock().unwrap().push((command_handle, ErrorCode::from(err)));
+}
+
+// Queue limits are global, so all checks run in the single test of this binary.
+#[test]
+fn command_queue_rejects_overload_and_keeps_order_of_admitted_commands() {
+    let setup = Setup::wallet();
+    let wallet_handle = setup.wallet_handle;
+
+    assert_eq!(ErrorCode::Success, indy::set_runtime_config(&json!({"command_queue_size": QUEUE_SIZE}).to_string()));
+
+    let results: Vec<(CommandHandle, ErrorCode)> = (1..=BURST_SIZE as CommandHandle)
+        .map(|command_handle| (command_handle, ErrorCode::from(unsafe {
+            indy_sys::pairwise::indy_list_pairwise(command_handle, wallet_handle, Some(_list_pairwise_cb))
+        })))
+        .collect();
+
+    let depth = _command_queue_value("depth", None);
+
+    // Rejected calls fail immediately and never call back
+    assert!(results.iter().all(|&(_, err)| err == ErrorCode::Success || err == ErrorCode::CommonCommandQueueFull));
+
+    let admitted: Vec<CommandHandle> = results.iter()
+        .filter(|&&(_, err)| err == ErrorCode::Success)
+        .map(|&(command_handle, _)| command_handle)
+        .collect();
+    let rejected = BURST_SIZE - admitted.len();
+
+    // The queue is empty before the burst, so its first commands are admitted.
+    assert!(admitted.len() >= QUEUE_SIZE);
+    assert_eq!((1..=QUEUE_SIZE as CommandHandle).collect::<Vec<_>>(), admitted[..QUEUE_SIZE].to_vec());
+
+    // The queue never holds more API commands than configured and the rest of the burst is rejected.
+    assert!(depth <= QUEUE_SIZE);
+    assert!(rejected > 0);
+    assert!(_command_queue_value("rejected", Some("pairwise")) >= rejected);
+
+    // Commands are executed in order, so a command admitted after the burst completes after all of it.
+    loop {
+        match pairwise::list_pairwise(wallet_handle) {
+            Ok(_) => break,
+            Err(err) => assert_eq!(ErrorCode::CommonCommandQueueFull, err.error_code)
+        }
+    }
+
+    let completed = COMPLETED.lock().unwrap().clone();
+    assert!(completed.iter().all(|&(_, err)| err == ErrorCode::Success));
+    assert_eq!(admitted, completed.into_iter().map(|(command_handle, _)| command_handle).collect::<Vec<_>>());
+
+    assert_eq!(0, _command_queue_value("depth", None));
+
+    assert_eq!(ErrorCode::Success, indy::set_runtime_config(r#"{"command_queue_size": 0, "command_queue_class_limits": {"pairwise": 1}}"#));
+
+    let first = indy::pairwise::list_pairwise(wallet_handle);
+    let second = indy::pairwise::list_pairwise(wallet_handle);
+    first.wait().unwrap();
+
+    if let Err(err) = second.wait() {
+        assert_eq!(ErrorCode::CommonCommandQueueFull, err.error_code);
+    }
+
+    assert_eq!(ErrorCode::Success, indy::set_runtime_config(r#"{"command_queue_class_limits": {"pairwise": 0}}"#));
+    assert_eq!(ErrorCode::CommonInvalidParam1, indy::set_runtime_config(r#"{"command_queue_class_limits": {"unknown": 1}}"#));
+
+    pairwise::list_pairwise(wallet_handle).unwrap();
+}
+
+fn _command_queue_value(label: &str, class: Option<&str>) -> usize {
+    let metrics = metrics::collect_metrics().unwrap();
+    let metrics = serde_json::from_str::<HashMap<String, Value>>(&metrics).unwrap();
+
+    let tags = match class {
+        Some(class) => json!({"label": label, "class": class}),
+        None => json!({"label": label})
+    };
+
+    metrics["command_queue_count"].as_array().unwrap()
+        .iter()
+        .find(|metric| metric["tags"] == tags)
+        .unwrap()["value"].as_u64().unwrap() as usize
+}
@@ -916,6 +916,66 @@ mod high_cases {
         }
     }
 
+    mod ledger_txns_range {
+        use super::*;
+
+        #[test]
+        #[cfg(feature = "local_nodes_pool")]
+        fn indy_ledger_txns_range_works() {
+            let setup = Setup::pool();
+
+            let txns_range_handle = ledger::open_ledger_txns_range(setup.pool_handle, Some("POOL"), 1, 4).unwrap();
+
+            let txns = ledger::fetch_ledger_txns_range(txns_range_handle, 3).unwrap();
+            let txns: Vec<serde_json::Value> = serde_json::from_str(&txns).unwrap();
+            assert_eq!(3, txns.len());
+            assert_eq!(1, txns[0]["txnMetadata"]["seqNo"].as_u64().unwrap());
+
+            let txns = ledger::fetch_ledger_txns_range(txns_range_handle, 3).unwrap();
+            let txns: Vec<serde_json::Value> = serde_json::from_str(&txns).unwrap();
+            assert_eq!(1, txns.len());
+            assert_eq!(4, txns[0]["txnMetadata"]["seqNo"].as_u64().unwrap());
+
+            let txns = ledger::fetch_ledger_txns_range(txns_range_handle, 3).unwrap();
+            assert_eq!("[]", txns);
+
+            ledger::close_ledger_txns_range(txns_range_handle).unwrap();
+        }
+
+        #[test]
+        #[cfg(feature = "local_nodes_pool")]
+        fn indy_ledger_txns_range_works_for_range_from_middle() {
+            let setup = Setup::pool();
+
+            let txns_range_handle = ledger::open_ledger_txns_range(setup.pool_handle, Some("POOL"), 3, 100).unwrap();
+
+            let txns = ledger::fetch_ledger_txns_range(txns_range_handle, 100).unwrap();
+            let txns: Vec<serde_json::Value> = serde_json::from_str(&txns).unwrap();
+            assert_eq!(2, txns.len());
+            assert_eq!(3, txns[0]["txnMetadata"]["seqNo"].as_u64().unwrap());
+
+            ledger::close_ledger_txns_range(txns_range_handle).unwrap();
+        }
+
+        #[test]
+        #[cfg(feature = "local_nodes_pool")]
+        fn indy_open_ledger_txns_range_works_for_invalid_range() {
+            let setup = Setup::pool();
+
+            let res = ledger::open_ledger_txns_range(setup.pool_handle, None, 0, 10);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+
+            let res = ledger::open_ledger_txns_range(setup.pool_handle, None, 10, 1);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_close_ledger_txns_range_works_for_unknown_handle() {
+            let res = ledger::close_ledger_txns_range(-1);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+    }
+
     mod pool_config {
         use super::*;
 
@@ -2932,6 +2992,148 @@ mod high_cases {
         }
     }
 
+    mod request_handles {
+        use super::*;
+
+        #[test]
+        fn indy_request_handle_from_json_works() {
+            Setup::empty();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+
+            let request = ledger::request_handle_to_json(request_handle).unwrap();
+            let request: serde_json::Value = serde_json::from_str(&request).unwrap();
+            assert_eq!(request, serde_json::from_str::<serde_json::Value>(REQUEST).unwrap());
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_build_nym_request_handle_works() {
+            Setup::empty();
+
+            let expected_result = json!({
+                "alias": "some_alias",
+                "dest": DEST,
+                "role": "2",
+                "type": constants::NYM,
+                "verkey": VERKEY_TRUSTEE
+            });
+
+            let request_handle = ledger::build_nym_request_handle(IDENTIFIER, DEST, Some(VERKEY_TRUSTEE), Some("some_alias"), Some("STEWARD")).unwrap();
+
+            let request = ledger::request_handle_to_json(request_handle).unwrap();
+            check_request(&request, expected_result, IDENTIFIER);
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_build_attrib_request_handle_works() {
+            Setup::empty();
+
+            let expected_result = json!({
+                "type": constants::ATTRIB,
+                "dest": DEST,
+                "raw": ATTRIB_RAW_DATA
+            });
+
+            let request_handle = ledger::build_attrib_request_handle(IDENTIFIER, DEST, None, Some(ATTRIB_RAW_DATA), None).unwrap();
+
+            let request = ledger::request_handle_to_json(request_handle).unwrap();
+            check_request_operation(&request, expected_result);
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_sign_request_handle_works() {
+            let setup = Setup::wallet();
+
+            let (did, _) = did::create_and_store_my_did(setup.wallet_handle, Some(TRUSTEE_SEED)).unwrap();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::sign_request_handle(setup.wallet_handle, &did, request_handle).unwrap();
+
+            // request is signed in place, json is the same as for indy_sign_request
+            let request = ledger::request_handle_to_json(request_handle).unwrap();
+            let expected_request = ledger::sign_request(setup.wallet_handle, &did, REQUEST).unwrap();
+            assert_eq!(serde_json::from_str::<serde_json::Value>(&request).unwrap(),
+                       serde_json::from_str::<serde_json::Value>(&expected_request).unwrap());
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_multi_sign_request_handle_works() {
+            let setup = Setup::wallet();
+
+            let (did1, _) = did::create_and_store_my_did(setup.wallet_handle, Some(TRUSTEE_SEED)).unwrap();
+            let (did2, _) = did::create_and_store_my_did(setup.wallet_handle, Some(MY1_SEED)).unwrap();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::multi_sign_request_handle(setup.wallet_handle, &did1, request_handle).unwrap();
+            ledger::multi_sign_request_handle(setup.wallet_handle, &did2, request_handle).unwrap();
+
+            let request = ledger::request_handle_to_json(request_handle).unwrap();
+            let request: serde_json::Value = serde_json::from_str(&request).unwrap();
+            let signatures = request["signatures"].as_object().unwrap();
+
+            assert_eq!(signatures[DID_TRUSTEE], r#"65hzs4nsdQsTUqLCLy2qisbKLfwYKZSWoyh1C6CU59p5pfG3EHQXGAsjW4Qw4QdwkrvjSgQuyv8qyABcXRBznFKW"#);
+            assert_eq!(signatures[DID_MY1], r#"49aXkbrtTE3e522AefE76J51WzUiakw3ZbxxWzf44cv7RS21n8mMr4vJzi4TymuqDupzCz7wEtuGz6rA94Y73kKR"#);
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        #[cfg(feature = "local_nodes_pool")]
+        fn indy_sign_and_submit_request_handle_works() {
+            let setup = Setup::trustee();
+
+            let (my_did, my_verkey) = did::create_and_store_my_did(setup.wallet_handle, None).unwrap();
+
+            let request_handle = ledger::build_nym_request_handle(&setup.did, &my_did, Some(&my_verkey), None, None).unwrap();
+            let nym_resp = ledger::sign_and_submit_request_handle(setup.pool_handle, setup.wallet_handle, &setup.did, request_handle).unwrap();
+            pool::check_response_type(&nym_resp, ResponseType::REPLY);
+            ledger::release_request_handle(request_handle).unwrap();
+
+            let get_nym_request = ledger::build_get_nym_request(Some(&my_did), &my_did).unwrap();
+            let get_nym_response = ledger::submit_request_with_retries(setup.pool_handle, &get_nym_request, &nym_resp).unwrap();
+            let data = ledger::parse_get_nym_response(&get_nym_response).unwrap();
+
+            let nym_data: NymData = serde_json::from_str(&data).unwrap();
+            assert_eq!(my_did, nym_data.did.0);
+            assert_eq!(my_verkey, nym_data.verkey.unwrap());
+        }
+
+        #[test]
+        #[cfg(feature = "local_nodes_pool")]
+        fn indy_submit_request_handle_works() {
+            let setup = Setup::trustee();
+
+            let get_nym_request = ledger::build_get_nym_request(Some(&setup.did), &setup.did).unwrap();
+
+            let request_handle = ledger::request_handle_from_json(&get_nym_request).unwrap();
+            let get_nym_response = ledger::submit_request_handle(setup.pool_handle, request_handle).unwrap();
+            ledger::parse_get_nym_response(&get_nym_response).unwrap();
+
+            // request handle stays valid after submitting
+            ledger::submit_request_handle(setup.pool_handle, request_handle).unwrap();
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_release_request_handle_works() {
+            Setup::empty();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::release_request_handle(request_handle).unwrap();
+
+            let res = ledger::request_handle_to_json(request_handle);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+    }
+
     mod append_request_endorser {
         use super::*;
 
@@ -3057,6 +3259,94 @@ mod medium_cases {
         }
     }
 
+    mod request_handles {
+        use super::*;
+
+        #[test]
+        fn indy_request_handle_from_json_works_for_invalid_json() {
+            Setup::empty();
+
+            let res = ledger::request_handle_from_json("request");
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_build_nym_request_handle_works_for_invalid_did() {
+            Setup::empty();
+
+            let res = ledger::build_nym_request_handle(IDENTIFIER, INVALID_IDENTIFIER, None, None, None);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_request_handle_to_json_works_for_unknown_handle() {
+            Setup::empty();
+
+            let res = ledger::request_handle_to_json(-1);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_sign_request_handle_works_for_released_handle() {
+            let setup = Setup::wallet();
+
+            let (did, _) = did::create_and_store_my_did(setup.wallet_handle, Some(TRUSTEE_SEED)).unwrap();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::release_request_handle(request_handle).unwrap();
+
+            let res = ledger::sign_request_handle(setup.wallet_handle, &did, request_handle);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+
+            let res = ledger::multi_sign_request_handle(setup.wallet_handle, &did, request_handle);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_sign_request_handle_works_for_unknown_signer() {
+            let setup = Setup::wallet();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+
+            let res = ledger::sign_request_handle(setup.wallet_handle, DID, request_handle);
+            assert_code!(ErrorCode::WalletItemNotFound, res);
+
+            ledger::release_request_handle(request_handle).unwrap();
+        }
+
+        #[test]
+        fn indy_submit_request_handle_works_for_unknown_handle() {
+            Setup::empty();
+
+            let res = ledger::submit_request_handle(INVALID_POOL_HANDLE, -1);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_sign_and_submit_request_handle_works_for_released_handle() {
+            let setup = Setup::wallet();
+
+            let (did, _) = did::create_and_store_my_did(setup.wallet_handle, Some(TRUSTEE_SEED)).unwrap();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::release_request_handle(request_handle).unwrap();
+
+            let res = ledger::sign_and_submit_request_handle(INVALID_POOL_HANDLE, setup.wallet_handle, &did, request_handle);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+
+        #[test]
+        fn indy_release_request_handle_works_twice() {
+            Setup::empty();
+
+            let request_handle = ledger::request_handle_from_json(REQUEST).unwrap();
+            ledger::release_request_handle(request_handle).unwrap();
+
+            let res = ledger::release_request_handle(request_handle);
+            assert_code!(ErrorCode::CommonInvalidStructure, res);
+        }
+    }
+
     mod submit_action {
         use super::*;
 
@@ -73,6 +73,66 @@ mod collect {
         assert!(threadpool_threads_count.contains(&json!({"tags":{"label":"panic"},"value":0})));
     }
 
+    #[test]
+    fn collect_metrics_contains_command_queue_statistics() {
+        let result_metrics = metrics::collect_metrics().unwrap();
+        let metrics_map = serde_json::from_str::<HashMap<String, Value>>(&result_metrics).unwrap();
+
+        assert!(metrics_map.contains_key("command_queue_count"));
+
+        let command_queue_count = metrics_map
+            .get("command_queue_count")
+            .unwrap()
+            .as_array()
+            .unwrap();
+
+        assert!(command_queue_count.contains(&json!({"tags":{"label":"limit"},"value":0})));
+        assert!(command_queue_count.contains(&json!({"tags":{"label":"limit","class":"wallet"},"value":0})));
+        assert!(command_queue_count.contains(&json!({"tags":{"label":"rejected","class":"pairwise"},"value":0})));
+    }
+
+    #[test]
+    fn collect_metrics_contains_pool_sockets_statistics() {
+        let result_metrics = metrics::collect_metrics().unwrap();
+        let metrics_map = serde_json::from_str::<HashMap<String, Value>>(&result_metrics).unwrap();
+
+        assert!(metrics_map.contains_key("pool_sockets_count"));
+
+        let labels: Vec<&Value> = metrics_map
+            .get("pool_sockets_count")
+            .unwrap()
+            .as_array()
+            .unwrap()
+            .iter()
+            .map(|metric| &metric["tags"]["label"])
+            .collect();
+
+        assert_eq!(vec![&json!("opened"), &json!("reused")], labels);
+    }
+
+    #[test]
+    fn collect_metrics_contains_wallet_storage_size() {
+        let _setup = Setup::wallet();
+
+        let result_metrics = metrics::collect_metrics().unwrap();
+        let metrics_map = serde_json::from_str::<HashMap<String, Value>>(&result_metrics).unwrap();
+
+        assert!(metrics_map.contains_key("wallet_storage_size"));
+
+        let wallet_storage_size = metrics_map
+            .get("wallet_storage_size")
+            .unwrap()
+            .as_array()
+            .unwrap();
+
+        let total = wallet_storage_size.iter()
+            .find(|metric| metric["tags"] == json!({"label": "total"}))
+            .unwrap()["value"].as_u64().unwrap();
+
+        assert!(total > 0);
+        assert!(wallet_storage_size.iter().any(|metric| metric["tags"] == json!({"label": "free"})));
+    }
+
     #[test]
     fn collect_metrics_includes_commands_count() {
         let setup = Setup::empty();
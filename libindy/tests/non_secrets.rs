@@ -232,6 +232,58 @@ mod high_cases {
         }
     }
 
+    mod delete_records {
+        use super::*;
+
+        #[test]
+        fn indy_delete_wallet_records_works() {
+            let setup = Setup::wallet();
+
+            add_wallet_record(setup.wallet_handle, TYPE, ID, VALUE, Some(TAGS)).unwrap();
+            add_wallet_record(setup.wallet_handle, TYPE, ID_2, VALUE_2, Some(TAGS_2)).unwrap();
+            add_wallet_record(setup.wallet_handle, TYPE, ID_3, VALUE_3, Some(TAGS_3)).unwrap();
+            add_wallet_record(setup.wallet_handle, TYPE_2, ID, VALUE, Some(TAGS)).unwrap();
+
+            let deleted_count = delete_wallet_records(setup.wallet_handle, TYPE, r#"{"tagName1": "str1"}"#).unwrap();
+            assert_eq!(2, deleted_count);
+
+            let res = get_wallet_record(setup.wallet_handle, TYPE, ID, OPTIONS_EMPTY);
+            assert_code!(ErrorCode::WalletItemNotFound, res);
+
+            let res = get_wallet_record(setup.wallet_handle, TYPE, ID_3, OPTIONS_EMPTY);
+            assert_code!(ErrorCode::WalletItemNotFound, res);
+
+            get_wallet_record(setup.wallet_handle, TYPE, ID_2, OPTIONS_EMPTY).unwrap();
+            get_wallet_record(setup.wallet_handle, TYPE_2, ID, OPTIONS_EMPTY).unwrap();
+        }
+
+        #[test]
+        fn indy_delete_wallet_records_works_for_plain_tag_range() {
+            let setup = Setup::wallet();
+
+            add_wallet_record(setup.wallet_handle, TYPE, ID, VALUE, Some(TAGS)).unwrap();
+            add_wallet_record(setup.wallet_handle, TYPE, ID_2, VALUE_2, Some(TAGS_2)).unwrap();
+            add_wallet_record(setup.wallet_handle, TYPE, ID_4, VALUE_4, Some(TAGS_4)).unwrap();
+
+            let deleted_count = delete_wallet_records(setup.wallet_handle, TYPE, r#"{"~tagName3": {"$lt": "6"}}"#).unwrap();
+            assert_eq!(2, deleted_count);
+
+            get_wallet_record(setup.wallet_handle, TYPE, ID, OPTIONS_EMPTY).unwrap();
+        }
+
+        #[test]
+        fn indy_delete_wallet_records_works_for_no_matching_records() {
+            let setup = Setup::wallet();
+
+            add_wallet_record(setup.wallet_handle, TYPE, ID, VALUE, Some(TAGS)).unwrap();
+
+            let deleted_count = delete_wallet_records(setup.wallet_handle, TYPE_2, QUERY_EMPTY).unwrap();
+            assert_eq!(0, deleted_count);
+
+            get_wallet_record(setup.wallet_handle, TYPE, ID, OPTIONS_EMPTY).unwrap();
+        }
+    }
+
     mod get_record {
         use super::*;
 
@@ -1121,6 +1173,34 @@ mod medium_cases {
         }
     }
 
+    mod delete_records {
+        use super::*;
+
+        #[test]
+        fn indy_delete_wallet_records_works_for_invalid_handle() {
+            Setup::empty();
+
+            let res = delete_wallet_records(INVALID_WALLET_HANDLE, TYPE, QUERY_EMPTY);
+            assert_code!(ErrorCode::WalletInvalidHandle, res);
+        }
+
+        #[test]
+        fn indy_delete_wallet_records_works_for_invalid_query() {
+            let setup = Setup::wallet();
+
+            let res = delete_wallet_records(setup.wallet_handle, TYPE, "not_json");
+            assert_code!(ErrorCode::WalletQueryError, res);
+        }
+
+        #[test]
+        fn indy_delete_wallet_records_works_for_invalid_type() {
+            let setup = Setup::wallet();
+
+            let res = delete_wallet_records(setup.wallet_handle, FORBIDDEN_TYPE, QUERY_EMPTY);
+            assert_code!(ErrorCode::WalletAccessFailed, res);
+        }
+    }
+
     mod get_record {
         use super::*;
 
@@ -57,6 +57,10 @@ pub fn issuer_create_credential_definition(wallet_handle: WalletHandle, issuer_d
     anoncreds::issuer_create_and_store_credential_def(wallet_handle, issuer_did, schema, tag, signature_type, config.unwrap_or("{}")).wait() // TODO: FIXME OPTIONAL CONFIG
 }
 
+pub fn issuer_fill_credential_def_key_pool(wallet_handle: WalletHandle, schema: &str, config_json: &str) -> Result<(), IndyError> {
+    anoncreds::issuer_fill_credential_def_key_pool(wallet_handle, schema, config_json).wait()
+}
+
 pub fn issuer_rotate_credential_def_start(wallet_handle: WalletHandle, cred_def_id: &str, config_json: Option<&str>) -> Result<String, IndyError> {
     anoncreds::issuer_rotate_credential_def_start(wallet_handle, cred_def_id, config_json).wait()
 }
@@ -191,6 +195,10 @@ pub fn revocation_cred_def_config() -> String {
     serde_json::to_string(&CredentialDefinitionConfig { support_revocation: true }).unwrap()
 }
 
+pub fn cred_def_key_pool_config(size: u32) -> String {
+    json!({"support_revocation": false, "size": size}).to_string()
+}
+
 pub fn issuance_on_demand_rev_reg_config() -> String {
     serde_json::to_string(&RevocationRegistryConfig { max_cred_num: Some(5), issuance_type: None }).unwrap()
 }
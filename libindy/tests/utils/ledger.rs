@@ -11,10 +11,13 @@ use crate::utils::{timeout, anoncreds, blob_storage, did, wallet, pool, callback
 use crate::utils::constants::*;
 
 use std::sync::{Once};
+use std::sync::mpsc::Receiver;
 use std::mem;
+use std::ptr;
 use std::ffi::CString;
+use super::libc::c_char;
 
-use indy::{WalletHandle, PoolHandle};
+use indy::{WalletHandle, PoolHandle, CommandHandle};
 
 pub static mut SCHEMA_ID: &'static str = "";
 pub static mut SCHEMA_ID_V2: &'static str = "";
@@ -427,4 +430,301 @@ pub fn build_ledgers_freeze_request(submitter_did: &str, ledgers_ids: Vec<u64>)
 
 pub fn get_frozen_ledgers_request(submitter_did: &str) -> Result<String, IndyError> {
     ledger::build_get_frozen_ledgers_request(submitter_did).wait()
-}
\ No newline at end of file
+}
+pub fn open_ledger_txns_range(pool_handle: PoolHandle, ledger_type: Option<&str>, from: i32, to: i32) -> Result<i32, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_i32();
+
+    let ledger_type = ledger_type.map(|ledger_type| CString::new(ledger_type).unwrap());
+
+    let err = unsafe {
+        indy_open_ledger_txns_range(command_handle, pool_handle,
+                                    ledger_type.as_ref().map(|ledger_type| ledger_type.as_ptr()).unwrap_or(ptr::null()),
+                                    from, to, cb)
+    };
+
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, txns_range_handle) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(txns_range_handle),
+        err => Err(err)
+    }
+}
+
+pub fn fetch_ledger_txns_range(txns_range_handle: i32, count: usize) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let err = unsafe { indy_fetch_ledger_txns_range(command_handle, txns_range_handle, count, cb) };
+
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, txns_json) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(txns_json),
+        err => Err(err)
+    }
+}
+
+pub fn close_ledger_txns_range(txns_range_handle: i32) -> Result<(), ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec();
+
+    let err = unsafe { indy_close_ledger_txns_range(command_handle, txns_range_handle, cb) };
+
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    match ErrorCode::from(receiver.recv().unwrap()) {
+        ErrorCode::Success => Ok(()),
+        err => Err(err)
+    }
+}
+
+fn _opt_c_str(value: Option<&str>) -> Option<CString> {
+    value.map(|value| CString::new(value).unwrap())
+}
+
+fn _opt_c_ptr(value: &Option<CString>) -> *const c_char {
+    value.as_ref().map(|value| value.as_ptr()).unwrap_or(ptr::null())
+}
+
+fn _result_request_handle(err: ErrorCode, receiver: Receiver<(ErrorCode, i32)>) -> Result<i32, ErrorCode> {
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, request_handle) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(request_handle),
+        err => Err(err)
+    }
+}
+
+fn _result_string(err: ErrorCode, receiver: Receiver<(ErrorCode, String)>) -> Result<String, ErrorCode> {
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, res) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(res),
+        err => Err(err)
+    }
+}
+
+fn _result_empty(err: ErrorCode, receiver: Receiver<ErrorCode>) -> Result<(), ErrorCode> {
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    match ErrorCode::from(receiver.recv().unwrap()) {
+        ErrorCode::Success => Ok(()),
+        err => Err(err)
+    }
+}
+
+pub fn build_nym_request_handle(submitter_did: &str, target_did: &str, verkey: Option<&str>, alias: Option<&str>, role: Option<&str>) -> Result<i32, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_i32();
+
+    let submitter_did = CString::new(submitter_did).unwrap();
+    let target_did = CString::new(target_did).unwrap();
+    let (verkey, alias, role) = (_opt_c_str(verkey), _opt_c_str(alias), _opt_c_str(role));
+
+    let err = unsafe {
+        indy_build_nym_request_handle(command_handle, submitter_did.as_ptr(), target_did.as_ptr(),
+                                      _opt_c_ptr(&verkey), _opt_c_ptr(&alias), _opt_c_ptr(&role), cb)
+    };
+
+    _result_request_handle(err, receiver)
+}
+
+pub fn build_attrib_request_handle(submitter_did: &str, target_did: &str, hash: Option<&str>, raw: Option<&str>, enc: Option<&str>) -> Result<i32, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_i32();
+
+    let submitter_did = CString::new(submitter_did).unwrap();
+    let target_did = CString::new(target_did).unwrap();
+    let (hash, raw, enc) = (_opt_c_str(hash), _opt_c_str(raw), _opt_c_str(enc));
+
+    let err = unsafe {
+        indy_build_attrib_request_handle(command_handle, submitter_did.as_ptr(), target_did.as_ptr(),
+                                         _opt_c_ptr(&hash), _opt_c_ptr(&raw), _opt_c_ptr(&enc), cb)
+    };
+
+    _result_request_handle(err, receiver)
+}
+
+pub fn request_handle_from_json(request_json: &str) -> Result<i32, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_i32();
+
+    let request_json = CString::new(request_json).unwrap();
+
+    let err = unsafe { indy_request_handle_from_json(command_handle, request_json.as_ptr(), cb) };
+
+    _result_request_handle(err, receiver)
+}
+
+pub fn request_handle_to_json(request_handle: i32) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let err = unsafe { indy_request_handle_to_json(command_handle, request_handle, cb) };
+
+    _result_string(err, receiver)
+}
+
+pub fn sign_request_handle(wallet_handle: WalletHandle, submitter_did: &str, request_handle: i32) -> Result<(), ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec();
+
+    let submitter_did = CString::new(submitter_did).unwrap();
+
+    let err = unsafe { indy_sign_request_handle(command_handle, wallet_handle, submitter_did.as_ptr(), request_handle, cb) };
+
+    _result_empty(err, receiver)
+}
+
+pub fn multi_sign_request_handle(wallet_handle: WalletHandle, submitter_did: &str, request_handle: i32) -> Result<(), ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec();
+
+    let submitter_did = CString::new(submitter_did).unwrap();
+
+    let err = unsafe { indy_multi_sign_request_handle(command_handle, wallet_handle, submitter_did.as_ptr(), request_handle, cb) };
+
+    _result_empty(err, receiver)
+}
+
+pub fn submit_request_handle(pool_handle: PoolHandle, request_handle: i32) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let err = unsafe { indy_submit_request_handle(command_handle, pool_handle, request_handle, cb) };
+
+    _result_string(err, receiver)
+}
+
+pub fn sign_and_submit_request_handle(pool_handle: PoolHandle, wallet_handle: WalletHandle, submitter_did: &str, request_handle: i32) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let submitter_did = CString::new(submitter_did).unwrap();
+
+    let err = unsafe {
+        indy_sign_and_submit_request_handle(command_handle, pool_handle, wallet_handle, submitter_did.as_ptr(), request_handle, cb)
+    };
+
+    _result_string(err, receiver)
+}
+
+pub fn release_request_handle(request_handle: i32) -> Result<(), ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec();
+
+    let err = unsafe { indy_release_request_handle(command_handle, request_handle, cb) };
+
+    _result_empty(err, receiver)
+}
+
+extern {
+    #[no_mangle]
+    pub fn indy_open_ledger_txns_range(command_handle: CommandHandle,
+                                       pool_handle: PoolHandle,
+                                       ledger_type: *const c_char,
+                                       from: i32,
+                                       to: i32,
+                                       cb: Option<extern fn(command_handle_: CommandHandle,
+                                                            err: i32,
+                                                            txns_range_handle: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_fetch_ledger_txns_range(command_handle: CommandHandle,
+                                        txns_range_handle: i32,
+                                        count: usize,
+                                        cb: Option<extern fn(command_handle_: CommandHandle,
+                                                             err: i32,
+                                                             txns_json: *const c_char)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_close_ledger_txns_range(command_handle: CommandHandle,
+                                        txns_range_handle: i32,
+                                        cb: Option<extern fn(command_handle_: CommandHandle,
+                                                             err: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_build_nym_request_handle(command_handle: CommandHandle,
+                                         submitter_did: *const c_char,
+                                         target_did: *const c_char,
+                                         verkey: *const c_char,
+                                         alias: *const c_char,
+                                         role: *const c_char,
+                                         cb: Option<extern fn(command_handle_: CommandHandle,
+                                                              err: i32,
+                                                              request_handle: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_build_attrib_request_handle(command_handle: CommandHandle,
+                                            submitter_did: *const c_char,
+                                            target_did: *const c_char,
+                                            hash: *const c_char,
+                                            raw: *const c_char,
+                                            enc: *const c_char,
+                                            cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                 err: i32,
+                                                                 request_handle: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_request_handle_from_json(command_handle: CommandHandle,
+                                         request_json: *const c_char,
+                                         cb: Option<extern fn(command_handle_: CommandHandle,
+                                                              err: i32,
+                                                              request_handle: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_request_handle_to_json(command_handle: CommandHandle,
+                                       request_handle: i32,
+                                       cb: Option<extern fn(command_handle_: CommandHandle,
+                                                            err: i32,
+                                                            request_json: *const c_char)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_sign_request_handle(command_handle: CommandHandle,
+                                    wallet_handle: WalletHandle,
+                                    submitter_did: *const c_char,
+                                    request_handle: i32,
+                                    cb: Option<extern fn(command_handle_: CommandHandle,
+                                                         err: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_multi_sign_request_handle(command_handle: CommandHandle,
+                                          wallet_handle: WalletHandle,
+                                          submitter_did: *const c_char,
+                                          request_handle: i32,
+                                          cb: Option<extern fn(command_handle_: CommandHandle,
+                                                               err: i32)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_submit_request_handle(command_handle: CommandHandle,
+                                      pool_handle: PoolHandle,
+                                      request_handle: i32,
+                                      cb: Option<extern fn(command_handle_: CommandHandle,
+                                                           err: i32,
+                                                           request_result_json: *const c_char)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_sign_and_submit_request_handle(command_handle: CommandHandle,
+                                               pool_handle: PoolHandle,
+                                               wallet_handle: WalletHandle,
+                                               submitter_did: *const c_char,
+                                               request_handle: i32,
+                                               cb: Option<extern fn(command_handle_: CommandHandle,
+                                                                    err: i32,
+                                                                    request_result_json: *const c_char)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_release_request_handle(command_handle: CommandHandle,
+                                       request_handle: i32,
+                                       cb: Option<extern fn(command_handle_: CommandHandle,
+                                                            err: i32)>) -> ErrorCode;
+}
@@ -62,6 +62,10 @@ pub fn delete_wallet_record(wallet_handle: WalletHandle, type_: &str, id: &str)
     wallet::delete_wallet_record(wallet_handle, type_, id).wait()
 }
 
+pub fn delete_wallet_records(wallet_handle: WalletHandle, type_: &str, query_json: &str) -> Result<u32, IndyError> {
+    wallet::delete_wallet_records(wallet_handle, type_, query_json).wait()
+}
+
 pub fn get_wallet_record(wallet_handle: WalletHandle, type_: &str, id: &str, options_json: &str) -> Result<String, IndyError> {
     wallet::get_wallet_record(wallet_handle, type_, id, options_json).wait()
 }
@@ -73,6 +73,18 @@ pub fn register_wallet_storage(xtype: &str, force_create: bool) -> Result<(), Er
     super::results::result_to_empty(err as i32, receiver)
 }
 
+pub fn register_wallet_storage_add_records(xtype: &str, add_records: WalletAddRecords) -> Result<(), ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec();
+
+    let xtype = CString::new(xtype).unwrap();
+
+    let err = unsafe {
+        indy_register_wallet_storage_add_records(command_handle, xtype.as_ptr(), Some(add_records), cb)
+    };
+
+    super::results::result_to_empty(err as i32, receiver)
+}
+
 pub fn create_wallet(config: &str, credentials: &str) -> Result<(), IndyError> {
     wallet::create_wallet(config, credentials).wait()
 }
@@ -117,6 +129,49 @@ pub fn close_and_delete_wallet(wallet_handle: WalletHandle, wallet_config: &str)
     delete_wallet(wallet_config, WALLET_CREDENTIALS)
 }
 
+pub fn open_wallets(wallets: &str) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let wallets = CString::new(wallets).unwrap();
+
+    let err = unsafe { indy_open_wallets(command_handle, wallets.as_ptr(), cb) };
+
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, results) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(results),
+        err => Err(err)
+    }
+}
+
+pub fn compact_wallet(wallet_handle: WalletHandle, config: Option<&str>) -> Result<String, ErrorCode> {
+    let (receiver, command_handle, cb) = callback::_closure_to_cb_ec_string();
+
+    let config = config.map(|config| CString::new(config).unwrap());
+
+    let err = unsafe {
+        indy_compact_wallet(command_handle,
+                            wallet_handle,
+                            config.as_ref().map(|config| config.as_ptr()).unwrap_or(::std::ptr::null()),
+                            cb)
+    };
+
+    if err != ErrorCode::Success {
+        return Err(err);
+    }
+
+    let (err, progress) = receiver.recv().unwrap();
+
+    match ErrorCode::from(err) {
+        ErrorCode::Success => Ok(progress),
+        err => Err(err)
+    }
+}
+
 pub fn export_wallet(wallet_handle: WalletHandle, export_config_json: &str) -> Result<(), IndyError> {
     wallet::export_wallet(wallet_handle, export_config_json).wait()
 }
@@ -142,6 +197,21 @@ pub fn generate_wallet_key(config: Option<&str>) -> Result<String, IndyError> {
 }
 
 extern {
+    #[no_mangle]
+    pub fn indy_compact_wallet(command_handle: CommandHandle,
+                               wallet_handle: WalletHandle,
+                               config: *const c_char,
+                               cb: Option<extern fn(command_handle_: CommandHandle,
+                                                    err: i32,
+                                                    progress_json: *const c_char)>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_open_wallets(command_handle: CommandHandle,
+                             wallets: *const c_char,
+                             cb: Option<extern fn(command_handle_: CommandHandle,
+                                                  err: i32,
+                                                  results_json: *const c_char)>) -> ErrorCode;
+
     #[no_mangle]
     pub fn indy_register_wallet_storage(command_handle: CommandHandle,
                                         type_: *const c_char,
@@ -170,6 +240,12 @@ extern {
                                         fetch_search_next_record: Option<WalletFetchSearchNextRecord>,
                                         free_search: Option<WalletFreeSearch>,
                                         cb: Option<ResponseEmptyCB>) -> ErrorCode;
+
+    #[no_mangle]
+    pub fn indy_register_wallet_storage_add_records(command_handle: CommandHandle,
+                                                    type_: *const c_char,
+                                                    add_records: Option<WalletAddRecords>,
+                                                    cb: Option<ResponseEmptyCB>) -> ErrorCode;
 }
 
 pub type WalletCreate = extern fn(name: *const c_char,
@@ -190,6 +266,8 @@ pub type WalletAddRecord = extern fn(storage_handle: i32,
                                      value: *const u8,
                                      value_len: usize,
                                      tags_json: *const c_char) -> ErrorCode;
+pub type WalletAddRecords = extern fn(storage_handle: i32,
+                                      records_json: *const c_char) -> ErrorCode;
 pub type WalletUpdateRecordValue = extern fn(storage_handle: i32,
                                              type_: *const c_char,
                                              id: *const c_char,
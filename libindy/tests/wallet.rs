@@ -7,7 +7,7 @@ extern crate indyrs as indy;
 extern crate indyrs as api;
 
 use crate::utils::inmem_wallet::InmemWallet;
-use crate::utils::{environment, wallet, test, did};
+use crate::utils::{environment, wallet, test, did, non_secrets};
 use crate::utils::constants::*;
 use crate::utils::Setup;
 
@@ -188,6 +188,71 @@ mod high_cases {
         }
     }
 
+    mod open_wallets {
+        use super::*;
+
+        #[test]
+        fn indy_open_wallets_works() {
+            let setup = Setup::empty();
+
+            let configs: Vec<String> = (0..3).map(|i| config(&format!("{}_{}", setup.name, i))).collect();
+            for config in configs.iter() {
+                wallet::create_wallet(config, WALLET_CREDENTIALS).unwrap();
+            }
+
+            let results = wallet::open_wallets(&_open_wallets_params(&configs)).unwrap();
+            let results: Vec<serde_json::Value> = serde_json::from_str(&results).unwrap();
+            assert_eq!(3, results.len());
+
+            for (result, config) in results.iter().zip(configs.iter()) {
+                let wallet_handle = indy::WalletHandle(result["wallet_handle"].as_i64().unwrap() as i32);
+                wallet::close_wallet(wallet_handle).unwrap();
+                wallet::delete_wallet(config, WALLET_CREDENTIALS).unwrap();
+            }
+        }
+
+        #[test]
+        fn indy_open_wallets_works_for_partial_failure() {
+            let setup = Setup::empty();
+
+            let created = config(&format!("{}_created", setup.name));
+            let not_created = config(&format!("{}_not_created", setup.name));
+            wallet::create_wallet(&created, WALLET_CREDENTIALS).unwrap();
+
+            let params = _open_wallets_params(&[not_created, created.clone(), created.clone()]);
+            let results = wallet::open_wallets(&params).unwrap();
+            let results: Vec<serde_json::Value> = serde_json::from_str(&results).unwrap();
+
+            assert_eq!(ErrorCode::WalletNotFoundError as i64, results[0]["error_code"].as_i64().unwrap());
+            assert_eq!(ErrorCode::WalletAlreadyOpenedError as i64, results[2]["error_code"].as_i64().unwrap());
+
+            let wallet_handle = indy::WalletHandle(results[1]["wallet_handle"].as_i64().unwrap() as i32);
+            wallet::close_wallet(wallet_handle).unwrap();
+            wallet::delete_wallet(&created, WALLET_CREDENTIALS).unwrap();
+        }
+
+        #[test]
+        fn indy_open_wallets_works_for_empty_list() {
+            Setup::empty();
+
+            let res = wallet::open_wallets("[]");
+            assert_eq!(ErrorCode::CommonInvalidStructure, res.unwrap_err());
+        }
+
+        fn _open_wallets_params(configs: &[String]) -> String {
+            let credentials: serde_json::Value = serde_json::from_str(WALLET_CREDENTIALS).unwrap();
+
+            let params: Vec<serde_json::Value> = configs.iter()
+                .map(|config| json!({
+                    "config": serde_json::from_str::<serde_json::Value>(config).unwrap(),
+                    "credentials": credentials,
+                }))
+                .collect();
+
+            json!(params).to_string()
+        }
+    }
+
     mod close_wallet {
         use super::*;
 
@@ -224,6 +289,53 @@ mod high_cases {
         }
     }
 
+    mod compact_wallet {
+        use super::*;
+
+        #[test]
+        fn indy_compact_wallet_works() {
+            let setup = Setup::wallet();
+
+            let value = "x".repeat(1024);
+            for i in 0..200 {
+                non_secrets::add_wallet_record(setup.wallet_handle, TYPE, &format!("{}", i), &value, None).unwrap();
+            }
+            for i in 0..200 {
+                non_secrets::delete_wallet_record(setup.wallet_handle, TYPE, &format!("{}", i)).unwrap();
+            }
+
+            let config = json!({"max_pages": 16}).to_string();
+
+            let mut steps = Vec::new();
+            loop {
+                let progress = wallet::compact_wallet(setup.wallet_handle, Some(&config)).unwrap();
+                let progress: serde_json::Value = serde_json::from_str(&progress).unwrap();
+
+                steps.push(progress.clone());
+                if progress["done"].as_bool().unwrap() {
+                    break;
+                }
+            }
+
+            let last = steps.last().unwrap();
+            assert!(steps.len() > 1);
+            assert_eq!(0, last["free"].as_u64().unwrap());
+            assert!(last["size"].as_u64().unwrap() < steps[0]["size"].as_u64().unwrap());
+
+            did::create_my_did(setup.wallet_handle, "{}").unwrap();
+        }
+
+        #[test]
+        fn indy_compact_wallet_works_for_default_config() {
+            let setup = Setup::wallet();
+
+            let progress = wallet::compact_wallet(setup.wallet_handle, None).unwrap();
+            let progress: serde_json::Value = serde_json::from_str(&progress).unwrap();
+
+            assert!(progress["size"].as_u64().unwrap() > 0);
+        }
+    }
+
     mod export_wallet {
         use super::*;
 
@@ -248,6 +360,8 @@ mod high_cases {
 
     mod import_wallet {
         use super::*;
+        use std::os::raw::c_char;
+        use std::sync::atomic::{AtomicUsize, Ordering};
 
         #[test]
         fn indy_import_wallet_works() {
@@ -281,6 +395,53 @@ mod high_cases {
             wallet::close_and_delete_wallet(wallet_handle, &config).unwrap();
             cleanup_file(&path);
         }
+
+        static ADD_RECORDS_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+        extern fn _add_records(storage_handle: i32, records_json: *const c_char) -> ErrorCode {
+            ADD_RECORDS_CALLS.fetch_add(1, Ordering::SeqCst);
+            InmemWallet::add_records(storage_handle, records_json)
+        }
+
+        #[test]
+        fn indy_import_wallet_works_for_plugged_add_records() {
+            let setup = Setup::empty();
+            InmemWallet::cleanup();
+
+            let path = wallet::export_wallet_path(&setup.name);
+            let config_json = wallet::prepare_export_wallet_config(&path);
+
+            let (wallet_handle, wallet_config) = wallet::create_and_open_default_wallet(&setup.name).unwrap();
+
+            let (did, _) = did::create_my_did(wallet_handle, "{}").unwrap();
+            did::set_did_metadata(wallet_handle, &did, METADATA).unwrap();
+
+            let did_with_meta = did::get_my_did_with_metadata(wallet_handle, &did).unwrap();
+
+            cleanup_file(&path);
+            wallet::export_wallet(wallet_handle, &config_json).unwrap();
+
+            wallet::close_wallet(wallet_handle).unwrap();
+            wallet::delete_wallet(&wallet_config, WALLET_CREDENTIALS).unwrap();
+
+            wallet::register_wallet_storage(INMEM_TYPE, false).unwrap();
+            wallet::register_wallet_storage_add_records(INMEM_TYPE, _add_records).unwrap();
+
+            let config = json!({"id": setup.name, "storage_type": INMEM_TYPE}).to_string();
+            wallet::import_wallet(&config, WALLET_CREDENTIALS, &config_json).unwrap();
+
+            assert!(ADD_RECORDS_CALLS.load(Ordering::SeqCst) > 0);
+
+            let wallet_handle = wallet::open_wallet(&config, WALLET_CREDENTIALS).unwrap();
+
+            let did_with_meta_after_import = did::get_my_did_with_metadata(wallet_handle, &did).unwrap();
+
+            assert_eq!(did_with_meta, did_with_meta_after_import);
+
+            wallet::close_and_delete_wallet(wallet_handle, &config).unwrap();
+            cleanup_file(&path);
+            InmemWallet::cleanup();
+        }
     }
 
     mod generate_wallet_key {
@@ -594,6 +755,34 @@ mod medium_cases {
         }
     }
 
+    mod compact_wallet {
+        use super::*;
+
+        #[test]
+        fn indy_compact_wallet_works_for_invalid_handle() {
+            Setup::empty();
+
+            let res = wallet::compact_wallet(INVALID_WALLET_HANDLE, None);
+            assert_eq!(ErrorCode::WalletInvalidHandle, res.unwrap_err());
+        }
+
+        #[test]
+        fn indy_compact_wallet_works_for_zero_max_pages() {
+            let setup = Setup::wallet();
+
+            let res = wallet::compact_wallet(setup.wallet_handle, Some(r#"{"max_pages": 0}"#));
+            assert_eq!(ErrorCode::CommonInvalidParam3, res.unwrap_err());
+        }
+
+        #[test]
+        fn indy_compact_wallet_works_for_plugged() {
+            let setup = Setup::plugged_wallet();
+
+            let res = wallet::compact_wallet(setup.wallet_handle, None);
+            assert_eq!(ErrorCode::CommonInvalidState, res.unwrap_err());
+        }
+    }
+
     mod export_wallet {
         use super::*;
         use std::fs;
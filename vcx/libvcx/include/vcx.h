@@ -17,6 +17,7 @@ typedef unsigned int vcx_credential_handle_t;
 typedef unsigned int vcx_proof_handle_t;
 typedef unsigned int vcx_command_handle_t;
 typedef unsigned int vcx_payment_handle_t;
+typedef unsigned int vcx_context_handle_t;
 typedef unsigned int vcx_wallet_search_handle_t;
 typedef unsigned bool vcx_bool_t;
 typedef unsigned int count_t;
@@ -751,6 +752,38 @@ vcx_error_t vcx_credentialdef_get_state(vcx_command_handle_t command_handle,
                                         credentialdef_handle connection_handle,
                                         void (*cb)(vcx_command_handle_t, vcx_error_t, vcx_state_t));
 
+/// Publishes all revocations made with vcx_issuer_revoke_credential_local for the credential definition's
+/// revocation registry to the ledger as a single revocation registry delta
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// credentialdef_handle: Credentialdef handle that was provided during creation. Used to access credentialdef object
+///
+/// cb: Callback that provides error status of publishing. Payment transaction, if any, is kept in the
+/// serialized credential definition.
+///
+/// #Returns
+/// Error code as a u32
+vcx_error_t vcx_credentialdef_publish_revocations(vcx_command_handle_t command_handle,
+                                                  vcx_credential_handle_t credentialdef_handle,
+                                                  void (*cb)(vcx_command_handle_t, vcx_error_t));
+
+/// Returns revocations made locally for the credential definition's revocation registry but not published yet
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// credentialdef_handle: Credentialdef handle that was provided during creation. Used to access credentialdef object
+///
+/// cb: Callback that provides json array of pending credential revocation ids: ["1", "5"]
+///
+/// #Returns
+/// Error code as a u32
+vcx_error_t vcx_credentialdef_get_pending_revocations(vcx_command_handle_t command_handle,
+                                                      vcx_credential_handle_t credentialdef_handle,
+                                                      void (*cb)(vcx_command_handle_t, vcx_error_t, const char*));
+
 // Create a proof for fulfilling a corresponding proof request
 //
 // #Params
@@ -1166,6 +1199,48 @@ vcx_error_t vcx_init_with_config(vcx_command_handle_t command_handle,
                               const char *config,
                               void (*cb)(vcx_command_handle_t, vcx_error_t));
 
+// Creates a new VCX context with its own settings, wallet and agency configuration.
+//
+// Settings and the wallet of a context are used by every call made from a thread the context
+// was entered on (see vcx_context_enter). The pool connection is shared by all contexts.
+//
+// #Params
+// command_handle: command handle to map callback to user context.
+//
+// config: config as json, the same options as for vcx_init_with_config are supported.
+//
+// cb: Callback that provides context handle and error status of creation
+//
+// #Returns
+// Error code as a u32
+vcx_error_t vcx_context_create_with_config(vcx_command_handle_t command_handle,
+                                           const char *config,
+                                           void (*cb)(vcx_command_handle_t, vcx_error_t, vcx_context_handle_t));
+
+// Enters the context on the calling thread.
+//
+// #Params
+// context_handle: handle of the context received from vcx_context_create_with_config
+//
+// #Returns
+// Error code as a u32
+vcx_error_t vcx_context_enter(vcx_context_handle_t context_handle);
+
+// Leaves the context entered on the calling thread.
+//
+// #Returns
+// Error code as a u32
+vcx_error_t vcx_context_exit();
+
+// Closes the wallet of the context and releases it.
+//
+// #Params
+// context_handle: handle of the context received from vcx_context_create_with_config
+//
+// #Returns
+// Error code as a u32
+vcx_error_t vcx_context_release(vcx_context_handle_t context_handle);
+
 // Create a Issuer Credential object that provides a credential for an enterprise's user
 // Assumes a credential definition has been written to the ledger.
 //
@@ -1381,6 +1456,22 @@ vcx_error_t vcx_issuer_get_credential_msg(vcx_command_handle_t command_handle,
                                           const char *my_pw_did,
                                           void (*cb)(vcx_command_handle_t, vcx_error_t, const char*));
 
+// Revokes the credential in the wallet without writing to the ledger.
+// Pending revocations are published with vcx_credentialdef_publish_revocations
+//
+// #Params
+// command_handle: command handle to map callback to user context.
+//
+// credential_handle: Credential handle that was provided during creation. Used to identify credential object
+//
+// cb: Callback that provides error status of revoking the credential
+//
+// #Returns
+// Error code as a u32
+vcx_error_t vcx_issuer_revoke_credential_local(vcx_command_handle_t command_handle,
+                                               vcx_issuer_credential_handle_t credential_handle,
+                                               void (*cb)(vcx_command_handle_t, vcx_error_t));
+
 
 // Get ledger fees from the sovrin network
 //
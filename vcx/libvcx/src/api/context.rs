@@ -0,0 +1,249 @@
+use libc::c_char;
+use utils::cstring::CStringUtils;
+use utils::libindy::{wallet, pool};
+use utils::error;
+use settings;
+use context;
+use utils::threadpool::spawn;
+use error::prelude::*;
+use indy::{INVALID_WALLET_HANDLE, CommandHandle};
+
+/// Creates a new VCX context with its own settings, wallet and agency configuration.
+///
+/// Contexts allow one process to serve several institutions. Settings and the wallet of a context
+/// are used by every call made from a thread the context was entered on (see vcx_context_enter),
+/// so all existing object APIs can be used with it. The pool connection is shared by all contexts:
+/// it is opened by the first context (or vcx_init) providing genesis_path and reused afterwards.
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// config: config as json, the same options as for vcx_init_with_config are supported.
+///
+/// cb: Callback that provides context handle and error status of creation
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_context_create_with_config(command_handle: CommandHandle,
+                                             config: *const c_char,
+                                             cb: Option<extern fn(xcommand_handle: CommandHandle, err: u32, context_handle: u32)>) -> u32 {
+    info!("vcx_context_create_with_config >>>");
+
+    check_useful_c_str!(config, VcxErrorKind::InvalidOption);
+    check_useful_c_callback!(cb, VcxErrorKind::InvalidOption);
+
+    trace!("vcx_context_create_with_config(command_handle: {})", command_handle);
+
+    let context_handle = match context::create().and_then(|handle| Ok((handle, context::get(handle)?))) {
+        Ok((handle, ctx)) => {
+            let res = context::with_context(Some(ctx), || settings::process_config_string(&config, true));
+
+            if let Err(e) = res {
+                error!("Invalid configuration specified: {}", e);
+                context::release(handle).ok();
+                return e.into();
+            }
+
+            handle
+        }
+        Err(e) => return e.into()
+    };
+
+    ::utils::threadpool::init();
+
+    spawn(move || {
+        let ctx = match context::get(context_handle) {
+            Ok(ctx) => ctx,
+            Err(e) => {
+                cb(command_handle, e.into(), 0);
+                return Ok(());
+            }
+        };
+
+        match context::with_context(Some(ctx), _open_context) {
+            Ok(()) => {
+                trace!("vcx_context_create_with_config_cb(command_handle: {}, rc: {}, context_handle: {})",
+                       command_handle, error::SUCCESS.message, context_handle);
+                cb(command_handle, error::SUCCESS.code_num, context_handle);
+            }
+            Err(e) => {
+                error!("vcx_context_create_with_config_cb(command_handle: {}, rc: {}, context_handle: {})",
+                       command_handle, e, 0);
+                context::release(context_handle).ok();
+                cb(command_handle, e.into(), 0);
+            }
+        }
+
+        Ok(())
+    });
+
+    error::SUCCESS.code_num
+}
+
+fn _open_context() -> VcxResult<()> {
+    if pool::get_pool_handle().is_err() && settings::get_config_value(settings::CONFIG_GENESIS_PATH).is_ok() {
+        pool::init_pool()?;
+    }
+
+    let wallet_name = settings::get_config_value(settings::CONFIG_WALLET_NAME)
+        .unwrap_or_else(|_| {
+            settings::set_config_value(settings::CONFIG_WALLET_NAME, settings::DEFAULT_WALLET_NAME);
+            settings::DEFAULT_WALLET_NAME.to_string()
+        });
+
+    let wallet_type = settings::get_config_value(settings::CONFIG_WALLET_TYPE).ok();
+    let storage_config = settings::get_config_value(settings::CONFIG_WALLET_STORAGE_CONFIG).ok();
+    let storage_creds = settings::get_config_value(settings::CONFIG_WALLET_STORAGE_CREDS).ok();
+
+    wallet::open_wallet(&wallet_name, wallet_type.as_ref().map(String::as_str),
+                        storage_config.as_ref().map(String::as_str), storage_creds.as_ref().map(String::as_str))?;
+
+    if let Ok(webhook_url) = settings::get_config_value(settings::CONFIG_WEBHOOK_URL) {
+        ::messages::agent_utils::update_agent_webhook(&webhook_url)?;
+    }
+
+    Ok(())
+}
+
+/// Enters the context on the calling thread.
+///
+/// All following calls made from this thread use settings and wallet of the context until
+/// vcx_context_exit is called or another context is entered.
+///
+/// #Params
+/// context_handle: handle of the context received from vcx_context_create_with_config
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_context_enter(context_handle: u32) -> u32 {
+    info!("vcx_context_enter >>>");
+    trace!("vcx_context_enter(context_handle: {})", context_handle);
+
+    match context::get(context_handle) {
+        Ok(ctx) => {
+            context::set_current(Some(ctx));
+            error::SUCCESS.code_num
+        }
+        Err(e) => e.into()
+    }
+}
+
+/// Leaves the context entered on the calling thread and returns to the settings set by vcx_init.
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_context_exit() -> u32 {
+    info!("vcx_context_exit >>>");
+
+    context::set_current(None);
+    error::SUCCESS.code_num
+}
+
+/// Closes the wallet of the context and releases it.
+///
+/// Objects created within the context are released as well.
+///
+/// #Params
+/// context_handle: handle of the context received from vcx_context_create_with_config
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_context_release(context_handle: u32) -> u32 {
+    info!("vcx_context_release >>>");
+    trace!("vcx_context_release(context_handle: {})", context_handle);
+
+    let ctx = match context::get(context_handle) {
+        Ok(ctx) => ctx,
+        Err(e) => return e.into()
+    };
+
+    context::with_context(Some(ctx.clone()), || {
+        if ctx.get_wallet_handle() != INVALID_WALLET_HANDLE {
+            wallet::close_wallet().ok();
+        }
+
+        ::schema::release_all();
+        ::connection::release_all();
+        ::issuer_credential::release_all();
+        ::credential_def::release_all();
+        ::proof::release_all();
+        ::disclosed_proof::release_all();
+        ::credential::release_all();
+    });
+
+    if context::current().map(|current| ::std::sync::Arc::ptr_eq(&current, &ctx)).unwrap_or(false) {
+        context::set_current(None);
+    }
+
+    match context::release(context_handle) {
+        Ok(()) => error::SUCCESS.code_num,
+        Err(e) => e.into()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::ffi::CString;
+    use utils::devsetup::SetupDefaults;
+    use utils::libindy::wallet::get_wallet_handle;
+    use utils::timeout::TimeoutUtils;
+    use api::return_types_u32;
+
+    fn _config(institution_name: &str) -> String {
+        json!({
+            "enable_test_mode": "true",
+            "institution_name": institution_name,
+            "wallet_name": institution_name,
+            "wallet_key": settings::DEFAULT_WALLET_KEY,
+        }).to_string()
+    }
+
+    fn _create_context(institution_name: &str) -> u32 {
+        let cb = return_types_u32::Return_U32_U32::new().unwrap();
+        let rc = vcx_context_create_with_config(cb.command_handle,
+                                                CString::new(_config(institution_name)).unwrap().into_raw(),
+                                                Some(cb.get_callback()));
+        assert_eq!(rc, error::SUCCESS.code_num);
+        cb.receive(TimeoutUtils::some_medium()).unwrap()
+    }
+
+    #[test]
+    fn test_context_create_with_config() {
+        let _setup = SetupDefaults::init();
+
+        let first = _create_context("first");
+        let second = _create_context("second");
+        assert_ne!(first, second);
+
+        assert_eq!(vcx_context_enter(first), error::SUCCESS.code_num);
+        assert_eq!(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap(), "first");
+        assert_ne!(get_wallet_handle(), INVALID_WALLET_HANDLE);
+
+        assert_eq!(vcx_context_enter(second), error::SUCCESS.code_num);
+        assert_eq!(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap(), "second");
+
+        assert_eq!(vcx_context_exit(), error::SUCCESS.code_num);
+        assert_eq!(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap(), settings::DEFAULT_DEFAULT);
+
+        assert_eq!(vcx_context_release(first), error::SUCCESS.code_num);
+        assert_eq!(vcx_context_release(second), error::SUCCESS.code_num);
+        assert_eq!(vcx_context_enter(first), error::INVALID_OBJ_HANDLE.code_num);
+
+    }
+
+    #[test]
+    fn test_context_create_with_config_fails_for_invalid_config() {
+        let _setup = SetupDefaults::init();
+
+        let cb = return_types_u32::Return_U32_U32::new().unwrap();
+        let rc = vcx_context_create_with_config(cb.command_handle,
+                                                CString::new("{}}").unwrap().into_raw(),
+                                                Some(cb.get_callback()));
+        assert_eq!(rc, error::INVALID_JSON.code_num);
+    }
+}
@@ -529,6 +529,105 @@ pub extern fn vcx_credentialdef_get_state(command_handle: CommandHandle,
     error::SUCCESS.code_num
 }
 
+/// Publishes all revocations made with vcx_issuer_revoke_credential_local for the credential definition's
+/// revocation registry to the ledger as a single revocation registry delta.
+/// Does nothing if there are no pending revocations.
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// credentialdef_handle: Credentialdef handle that was provided during creation. Used to access credentialdef object
+///
+/// cb: Callback that provides error status of publishing. Payment transaction, if any, is kept in the
+/// serialized credential definition.
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_credentialdef_publish_revocations(command_handle: CommandHandle,
+                                                    credentialdef_handle: u32,
+                                                    cb: Option<extern fn(xcommand_handle: CommandHandle, err: u32)>) -> u32 {
+    info!("vcx_credentialdef_publish_revocations >>>");
+
+    check_useful_c_callback!(cb, VcxErrorKind::InvalidOption);
+
+    let source_id = credential_def::get_source_id(credentialdef_handle).unwrap_or_default();
+    trace!("vcx_credentialdef_publish_revocations(command_handle: {}, credentialdef_handle: {}) source_id: {}",
+           command_handle, credentialdef_handle, source_id);
+
+    if !credential_def::is_valid_handle(credentialdef_handle) {
+        return VcxError::from(VcxErrorKind::InvalidCredDefHandle).into();
+    }
+
+    spawn(move || {
+        match credential_def::publish_revocations(credentialdef_handle) {
+            Ok(()) => {
+                trace!("vcx_credentialdef_publish_revocations(command_handle: {}, rc: {}) source_id: {}",
+                       command_handle, error::SUCCESS.message, source_id);
+                cb(command_handle, error::SUCCESS.code_num);
+            }
+            Err(x) => {
+                warn!("vcx_credentialdef_publish_revocations(command_handle: {}, rc: {}) source_id: {}",
+                      command_handle, x, source_id);
+                cb(command_handle, x.into());
+            }
+        };
+
+        Ok(())
+    });
+
+    error::SUCCESS.code_num
+}
+
+/// Returns revocations made locally for the credential definition's revocation registry but not published yet
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// credentialdef_handle: Credentialdef handle that was provided during creation. Used to access credentialdef object
+///
+/// cb: Callback that provides json array of pending credential revocation ids: ["1", "5"]
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_credentialdef_get_pending_revocations(command_handle: CommandHandle,
+                                                        credentialdef_handle: u32,
+                                                        cb: Option<extern fn(xcommand_handle: CommandHandle, err: u32, cred_rev_ids: *const c_char)>) -> u32 {
+    info!("vcx_credentialdef_get_pending_revocations >>>");
+
+    check_useful_c_callback!(cb, VcxErrorKind::InvalidOption);
+
+    let source_id = credential_def::get_source_id(credentialdef_handle).unwrap_or_default();
+    trace!("vcx_credentialdef_get_pending_revocations(command_handle: {}, credentialdef_handle: {}) source_id: {}",
+           command_handle, credentialdef_handle, source_id);
+
+    if !credential_def::is_valid_handle(credentialdef_handle) {
+        return VcxError::from(VcxErrorKind::InvalidCredDefHandle).into();
+    }
+
+    spawn(move || {
+        match credential_def::get_pending_revocations(credentialdef_handle) {
+            Ok(x) => {
+                let x = json!(x).to_string();
+                trace!("vcx_credentialdef_get_pending_revocations(command_handle: {}, rc: {}, cred_rev_ids: {}) source_id: {}",
+                       command_handle, error::SUCCESS.message, x, source_id);
+                let msg = CStringUtils::string_to_cstring(x);
+                cb(command_handle, error::SUCCESS.code_num, msg.as_ptr());
+            }
+            Err(x) => {
+                warn!("vcx_credentialdef_get_pending_revocations(command_handle: {}, rc: {}, cred_rev_ids: {}) source_id: {}",
+                      command_handle, x, "null", source_id);
+                cb(command_handle, x.into(), ptr::null_mut());
+            }
+        };
+
+        Ok(())
+    });
+
+    error::SUCCESS.code_num
+}
+
 #[cfg(test)]
 mod tests {
     extern crate serde_json;
@@ -630,6 +729,27 @@ mod tests {
 
     }
 
+    #[test]
+    fn test_vcx_credentialdef_publish_and_get_pending_revocations() {
+        let _setup = SetupMocks::init();
+
+        let cb = return_types_u32::Return_U32_U32::new().unwrap();
+
+        let original = r#"{"version":"1.0", "data": {"id":"2hoqvcwupRTUNkXn6ArYzs:3:CL:1697","issuer_did":"2hoqvcwupRTUNkXn6ArYzs","tag":"tag","name":"Test Credential Definition","rev_ref_def":null,"rev_reg_entry":null,"rev_reg_id":"2hoqvcwupRTUNkXn6ArYzs:4:2hoqvcwupRTUNkXn6ArYzs:3:CL:1697:tag:CL_ACCUM:tag1","source_id":"SourceId"}}"#;
+        assert_eq!(vcx_credentialdef_deserialize(cb.command_handle,
+                                                 CString::new(original).unwrap().into_raw(),
+                                                 Some(cb.get_callback())), error::SUCCESS.code_num);
+        let handle = cb.receive(TimeoutUtils::some_short()).unwrap();
+
+        let cb = return_types_u32::Return_U32::new().unwrap();
+        assert_eq!(vcx_credentialdef_publish_revocations(cb.command_handle, handle, Some(cb.get_callback())), error::SUCCESS.code_num);
+        cb.receive(TimeoutUtils::some_medium()).unwrap();
+
+        let cb = return_types_u32::Return_U32_STR::new().unwrap();
+        assert_eq!(vcx_credentialdef_get_pending_revocations(cb.command_handle, handle, Some(cb.get_callback())), error::SUCCESS.code_num);
+        let pending = cb.receive(TimeoutUtils::some_medium()).unwrap().unwrap();
+        assert_eq!(pending, "[]");
+    }
 
     #[test]
     fn test_vcx_credentialdef_release() {
@@ -746,6 +746,8 @@ pub extern fn vcx_issuer_credential_get_payment_txn(command_handle: CommandHandl
 
 /// Revoke Credential
 ///
+/// Revocations made with vcx_issuer_revoke_credential_local and not published yet are published together with it.
+///
 /// #Params
 /// command_handle: command handle to map callback to user context.
 ///
@@ -791,6 +793,54 @@ pub extern fn vcx_issuer_revoke_credential(command_handle: CommandHandle,
     error::SUCCESS.code_num
 }
 
+/// Revoke Credential locally, without writing to the ledger.
+/// Revocations are accumulated per revocation registry and published with vcx_credentialdef_publish_revocations
+///
+/// #Params
+/// command_handle: command handle to map callback to user context.
+///
+/// credential_handle: Credential handle that was provided during creation. Used to identify credential object
+///
+/// cb: Callback that provides error status of revoking the credential
+///
+/// #Returns
+/// Error code as a u32
+#[no_mangle]
+pub extern fn vcx_issuer_revoke_credential_local(command_handle: CommandHandle,
+                                                 credential_handle: u32,
+                                                 cb: Option<extern fn(xcommand_handle: CommandHandle, err: u32)>) -> u32 {
+    check_useful_c_callback!(cb, VcxErrorKind::InvalidOption);
+
+    if !issuer_credential::is_valid_handle(credential_handle) {
+        return VcxError::from(VcxErrorKind::InvalidIssuerCredentialHandle).into()
+    }
+
+    let source_id = issuer_credential::get_source_id(credential_handle).unwrap_or_default();
+    info!("vcx_issuer_revoke_credential_local(command_handle: {}, credential_handle: {}) source_id: {}",
+          command_handle, credential_handle, source_id);
+
+    spawn(move || {
+        let err = match issuer_credential::revoke_credential_local(credential_handle) {
+            Ok(()) => {
+                info!("vcx_issuer_revoke_credential_local_cb(command_handle: {}, credential_handle: {}, rc: {}) source_id: {}",
+                      command_handle, credential_handle, error::SUCCESS.message, source_id);
+                error::SUCCESS.code_num
+            }
+            Err(x) => {
+                warn!("vcx_issuer_revoke_credential_local_cb(command_handle: {}, credential_handle: {}, rc: {}) source_id: {}",
+                      command_handle, credential_handle, x, source_id);
+                x.into()
+            }
+        };
+
+        cb(command_handle, err);
+
+        Ok(())
+    });
+
+    error::SUCCESS.code_num
+}
+
 #[cfg(test)]
 pub mod tests {
     extern crate serde_json;
@@ -1087,6 +1137,25 @@ pub mod tests {
         cb.receive(TimeoutUtils::some_medium()).unwrap();
     }
 
+    #[test]
+    fn test_vcx_issuer_revoke_credential_local() {
+        let _setup = SetupMocks::init();
+
+        let handle = issuer_credential::from_string(&issuer_credential_state_accepted()).unwrap();
+
+        let cb = return_types_u32::Return_U32::new().unwrap();
+        assert_eq!(vcx_issuer_revoke_credential_local(cb.command_handle,
+                                                      handle,
+                                                      Some(cb.get_callback())),
+                   error::SUCCESS.code_num);
+        cb.receive(TimeoutUtils::some_medium()).unwrap();
+
+        assert_eq!(vcx_issuer_revoke_credential_local(cb.command_handle,
+                                                      handle + 1,
+                                                      Some(cb.get_callback())),
+                   error::INVALID_ISSUER_CREDENTIAL_HANDLE.code_num);
+    }
+
     #[test]
     fn test_vcx_issuer_credential_release() {
         let _setup = SetupMocks::init();
@@ -1,4 +1,5 @@
 pub mod vcx;
+pub mod context;
 pub mod connection;
 pub mod issuer_credential;
 pub mod utils;
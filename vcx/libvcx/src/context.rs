@@ -0,0 +1,214 @@
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::sync::{Arc, RwLock};
+
+use indy::{WalletHandle, INVALID_WALLET_HANDLE};
+use rand::Rng;
+
+use error::prelude::*;
+
+/// Settings, wallet and agency configuration of a single tenant.
+///
+/// While a context is entered on a thread, settings and the wallet handle are read from and
+/// written to the context instead of the process-wide defaults. The pool connection is shared
+/// between all contexts.
+pub struct VcxContext {
+    id: u32,
+    pub settings: Arc<RwLock<HashMap<String, String>>>,
+    wallet_handle: RwLock<WalletHandle>,
+}
+
+impl VcxContext {
+    fn new(id: u32) -> VcxContext {
+        VcxContext {
+            id,
+            settings: Arc::new(RwLock::new(HashMap::new())),
+            wallet_handle: RwLock::new(INVALID_WALLET_HANDLE),
+        }
+    }
+
+    /// Handle the context was created with. Objects created while it is entered are bound to it.
+    pub fn id(&self) -> u32 {
+        self.id
+    }
+
+    pub fn get_wallet_handle(&self) -> WalletHandle {
+        *self.wallet_handle.read().unwrap()
+    }
+
+    pub fn set_wallet_handle(&self, handle: WalletHandle) {
+        *self.wallet_handle.write().unwrap() = handle;
+    }
+}
+
+lazy_static! {
+    static ref CONTEXTS: RwLock<HashMap<u32, Arc<VcxContext>>> = Default::default();
+}
+
+thread_local! {
+    static CURRENT_CONTEXT: RefCell<Option<Arc<VcxContext>>> = RefCell::new(None);
+}
+
+/// Creates a new empty context and returns its handle.
+pub fn create() -> VcxResult<u32> {
+    let mut contexts = CONTEXTS.write()
+        .map_err(|_| VcxError::from_msg(VcxErrorKind::InvalidState, "Cannot lock contexts"))?;
+
+    let mut handle = rand::thread_rng().gen::<u32>();
+    while handle == 0 || contexts.contains_key(&handle) {
+        handle = rand::thread_rng().gen::<u32>();
+    }
+
+    contexts.insert(handle, Arc::new(VcxContext::new(handle)));
+    Ok(handle)
+}
+
+pub fn get(handle: u32) -> VcxResult<Arc<VcxContext>> {
+    CONTEXTS.read()
+        .map_err(|_| VcxError::from_msg(VcxErrorKind::InvalidState, "Cannot lock contexts"))?
+        .get(&handle)
+        .cloned()
+        .ok_or(VcxError::from_msg(VcxErrorKind::InvalidHandle, format!("Context not found for handle: {}", handle)))
+}
+
+pub fn release(handle: u32) -> VcxResult<()> {
+    CONTEXTS.write()
+        .map_err(|_| VcxError::from_msg(VcxErrorKind::InvalidState, "Cannot lock contexts"))?
+        .remove(&handle)
+        .map(|_| ())
+        .ok_or(VcxError::from_msg(VcxErrorKind::InvalidHandle, format!("Context not found for handle: {}", handle)))
+}
+
+/// Context entered on the current thread, if any.
+pub fn current() -> Option<Arc<VcxContext>> {
+    CURRENT_CONTEXT.with(|current| current.borrow().clone())
+}
+
+/// Id of the context entered on the current thread, `0` for the process-wide defaults.
+pub fn current_id() -> u32 {
+    CURRENT_CONTEXT.with(|current| current.borrow().as_ref().map(|context| context.id()).unwrap_or(0))
+}
+
+/// Makes the context current for the calling thread. `None` returns to the process-wide defaults.
+pub fn set_current(context: Option<Arc<VcxContext>>) -> Option<Arc<VcxContext>> {
+    CURRENT_CONTEXT.with(|current| current.replace(context))
+}
+
+/// Runs the closure with the context entered on the current thread and restores the previous one.
+pub fn with_context<F, R>(context: Option<Arc<VcxContext>>, f: F) -> R where F: FnOnce() -> R {
+    struct Restore(Option<Option<Arc<VcxContext>>>);
+
+    impl Drop for Restore {
+        fn drop(&mut self) {
+            if let Some(previous) = self.0.take() {
+                set_current(previous);
+            }
+        }
+    }
+
+    let _restore = Restore(Some(set_current(context)));
+    f()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use settings;
+    use utils::devsetup::SetupDefaults;
+
+    #[test]
+    fn test_context_settings_are_isolated() {
+        let _setup = SetupDefaults::init();
+
+        let handle = create().unwrap();
+        let context = get(handle).unwrap();
+
+        with_context(Some(context.clone()), || {
+            settings::set_config_value(settings::CONFIG_INSTITUTION_NAME, "tenant");
+            assert_eq!(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap(), "tenant");
+        });
+
+        assert_ne!(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap(), "tenant");
+        assert_eq!(context.settings.read().unwrap().get(settings::CONFIG_INSTITUTION_NAME).unwrap(), "tenant");
+
+        release(handle).unwrap();
+        assert!(get(handle).is_err());
+    }
+
+    #[test]
+    fn test_context_wallet_handle_is_isolated() {
+        let _setup = SetupDefaults::init();
+
+        let handle = create().unwrap();
+        let context = get(handle).unwrap();
+
+        let global_handle = ::utils::libindy::wallet::get_wallet_handle();
+
+        with_context(Some(context.clone()), || {
+            ::utils::libindy::wallet::set_wallet_handle(WalletHandle(42));
+            assert_eq!(::utils::libindy::wallet::get_wallet_handle(), WalletHandle(42));
+        });
+
+        assert_eq!(::utils::libindy::wallet::get_wallet_handle(), global_handle);
+        assert_eq!(context.get_wallet_handle(), WalletHandle(42));
+
+        release(handle).unwrap();
+    }
+
+    #[test]
+    fn test_context_is_propagated_to_spawned_work() {
+        let _setup = SetupDefaults::init();
+
+        let handle = create().unwrap();
+        let context = get(handle).unwrap();
+
+        let (sender, receiver) = ::std::sync::mpsc::channel();
+
+        with_context(Some(context), || {
+            settings::set_config_value(settings::CONFIG_INSTITUTION_NAME, "spawned");
+
+            ::utils::threadpool::spawn(move || {
+                sender.send(settings::get_config_value(settings::CONFIG_INSTITUTION_NAME).unwrap()).unwrap();
+                Ok(())
+            });
+        });
+
+        assert_eq!(receiver.recv().unwrap(), "spawned");
+
+        release(handle).unwrap();
+    }
+
+    #[test]
+    fn test_context_objects_are_isolated() {
+        let _setup = SetupDefaults::init();
+
+        let cache: ::object_cache::ObjectCache<u32> = Default::default();
+
+        let handle = create().unwrap();
+        let context = get(handle).unwrap();
+        let other_handle = create().unwrap();
+        let other_context = get(other_handle).unwrap();
+
+        let object = with_context(Some(context.clone()), || cache.add(42).unwrap());
+
+        with_context(Some(context.clone()), || {
+            assert!(cache.has_handle(object));
+            assert_eq!(cache.get(object, |obj| Ok(*obj)).unwrap(), 42);
+        });
+
+        with_context(Some(other_context), || {
+            assert!(!cache.has_handle(object));
+            assert_eq!(cache.get(object, |obj| Ok(*obj)).unwrap_err().kind(), VcxErrorKind::InvalidHandle);
+            assert_eq!(cache.get_mut(object, |obj| Ok(*obj)).unwrap_err().kind(), VcxErrorKind::InvalidHandle);
+            assert_eq!(cache.release(object).unwrap_err().kind(), VcxErrorKind::InvalidHandle);
+        });
+
+        assert!(!cache.has_handle(object));
+        assert_eq!(cache.get(object, |obj| Ok(*obj)).unwrap_err().kind(), VcxErrorKind::InvalidHandle);
+
+        with_context(Some(context), || cache.release(object).unwrap());
+
+        release(handle).unwrap();
+        release(other_handle).unwrap();
+    }
+}
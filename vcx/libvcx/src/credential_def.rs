@@ -307,6 +307,30 @@ pub fn get_rev_reg_delta_payment_txn(handle: u32) -> VcxResult<Option<PaymentTxn
     })
 }
 
+fn _get_rev_reg_id_required(cred_def: &CredentialDef) -> VcxResult<String> {
+    cred_def.get_rev_reg_id()
+        .cloned()
+        .ok_or(VcxError::from_msg(VcxErrorKind::InvalidRevocationDetails, "Credential Definition does not support revocation"))
+}
+
+pub fn publish_revocations(handle: u32) -> VcxResult<()> {
+    CREDENTIALDEF_MAP.get_mut(handle, |c| {
+        let rev_reg_id = _get_rev_reg_id_required(c)?;
+        let (payment, delta) = anoncreds::publish_local_revocations(&rev_reg_id)?;
+        if delta.is_some() {
+            c.rev_reg_delta_payment_txn = payment;
+        }
+        Ok(())
+    })
+}
+
+pub fn get_pending_revocations(handle: u32) -> VcxResult<Vec<String>> {
+    CREDENTIALDEF_MAP.get(handle, |c| {
+        let rev_reg_id = _get_rev_reg_id_required(c)?;
+        anoncreds::get_pending_revocations(&rev_reg_id)
+    })
+}
+
 pub fn release(handle: u32) -> VcxResult<()> {
     CREDENTIALDEF_MAP.release(handle)
         .or(Err(VcxError::from(VcxErrorKind::InvalidCredDefHandle)))
@@ -407,6 +431,24 @@ pub mod tests {
         assert!(rev_reg_id.is_some());
     }
 
+    #[test]
+    fn test_publish_revocations() {
+        let _setup = SetupMocks::init();
+
+        let handle = create_cred_def_fake();
+        assert_eq!(publish_revocations(handle).unwrap_err().kind(), VcxErrorKind::InvalidRevocationDetails);
+        assert_eq!(get_pending_revocations(handle).unwrap_err().kind(), VcxErrorKind::InvalidRevocationDetails);
+
+        CREDENTIALDEF_MAP.get_mut(handle, |c| {
+            c.rev_reg_id = Some(::utils::constants::REV_REG_ID.to_string());
+            Ok(())
+        }).unwrap();
+
+        publish_revocations(handle).unwrap();
+        assert!(get_pending_revocations(handle).unwrap().is_empty());
+        assert!(get_rev_reg_delta_payment_txn(handle).unwrap().is_some());
+    }
+
     #[test]
     fn test_create_cred_def() {
         let _setup = SetupMocks::init();
@@ -482,6 +482,21 @@ impl IssuerCredential {
     }
 
     fn revoke_cred(&mut self) -> VcxResult<()> {
+        let (tails_file, rev_reg_id, cred_rev_id) = self.get_revocation_info()?;
+
+        let (payment, _) = anoncreds::revoke_credential(tails_file, rev_reg_id, cred_rev_id)?;
+
+        self.rev_cred_payment_txn = payment;
+        Ok(())
+    }
+
+    fn revoke_cred_local(&self) -> VcxResult<()> {
+        let (tails_file, rev_reg_id, cred_rev_id) = self.get_revocation_info()?;
+
+        anoncreds::revoke_credential_local(tails_file, rev_reg_id, cred_rev_id)
+    }
+
+    fn get_revocation_info(&self) -> VcxResult<(&String, &String, &String)> {
         let tails_file = self.tails_file
             .as_ref()
             .ok_or(VcxError::from_msg(VcxErrorKind::InvalidRevocationDetails, "Invalid RevocationInfo: `tails_file` field not found"))?;
@@ -494,10 +509,7 @@ impl IssuerCredential {
             .as_ref()
             .ok_or(VcxError::from_msg(VcxErrorKind::InvalidRevocationDetails, "Invalid RevocationInfo: `cred_rev_id` field not found"))?;
 
-        let (payment, _) = anoncreds::revoke_credential(tails_file, rev_reg_id, cred_rev_id)?;
-
-        self.rev_cred_payment_txn = payment;
-        Ok(())
+        Ok((tails_file, rev_reg_id, cred_rev_id))
     }
 
     fn generate_payment_info(&mut self) -> VcxResult<Option<PaymentInfo>> {
@@ -817,6 +829,16 @@ pub fn revoke_credential(handle: u32) -> VcxResult<()> {
     })
 }
 
+pub fn revoke_credential_local(handle: u32) -> VcxResult<()> {
+    ISSUER_CREDENTIAL_MAP.get(handle, |obj| {
+        match obj {
+            IssuerCredentials::Pending(ref obj) => obj.revoke_cred_local(),
+            IssuerCredentials::V1(ref obj) => obj.revoke_cred_local(),
+            IssuerCredentials::V3(ref obj) => obj.revoke_credential_local()
+        }
+    })
+}
+
 pub fn convert_to_map(s: &str) -> VcxResult<serde_json::Map<String, serde_json::Value>> {
     serde_json::from_str(s)
         .map_err(|_| {
@@ -1334,6 +1356,24 @@ pub mod tests {
         assert!(credential.rev_cred_payment_txn.is_some());
     }
 
+    #[test]
+    fn test_revoke_credential_local() {
+        let _setup = SetupMocks::init();
+
+        let mut credential = create_standard_issuer_credential(None);
+
+        credential.tails_file = Some(get_temp_dir_path(TEST_TAILS_FILE).to_str().unwrap().to_string());
+        credential.cred_rev_id = None;
+        credential.rev_reg_id = Some(REV_REG_ID.to_string());
+        assert_eq!(credential.revoke_cred_local().unwrap_err().kind(), VcxErrorKind::InvalidRevocationDetails);
+
+        credential.cred_rev_id = Some(CRED_REV_ID.to_string());
+        credential.rev_cred_payment_txn = None;
+
+        credential.revoke_cred_local().unwrap();
+        assert!(credential.rev_cred_payment_txn.is_none());
+    }
+
 
     #[test]
     fn test_encode_with_several_attributes_success() {
@@ -46,6 +46,7 @@ extern crate chrono;
 #[macro_use]
 pub mod utils;
 pub mod settings;
+pub mod context;
 #[macro_use]
 pub mod messages;
 
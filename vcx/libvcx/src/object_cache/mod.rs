@@ -5,10 +5,29 @@ use std::collections::HashMap;
 use std::ops::Deref;
 use std::ops::DerefMut;
 
+use context;
 use error::prelude::*;
 
+/// Cached object together with the id of the context it was created in.
+///
+/// Objects are only visible from the context that owns them, see `context::current_id`.
+pub struct Owned<T> {
+    context: u32,
+    obj: Mutex<T>,
+}
+
+impl<T> Owned<T> {
+    fn new(obj: T) -> Owned<T> {
+        Owned { context: context::current_id(), obj: Mutex::new(obj) }
+    }
+
+    fn is_visible(&self) -> bool {
+        self.context == context::current_id()
+    }
+}
+
 pub struct ObjectCache<T> {
-    pub store: Mutex<HashMap<u32, Mutex<T>>>,
+    pub store: Mutex<HashMap<u32, Owned<T>>>,
 }
 
 impl<T> Default for ObjectCache<T> {
@@ -21,7 +40,7 @@ impl<T> Default for ObjectCache<T> {
 }
 
 impl<T> ObjectCache<T> {
-    fn _lock_store(&self) -> VcxResult<MutexGuard<HashMap<u32, Mutex<T>>>> {
+    fn _lock_store(&self) -> VcxResult<MutexGuard<HashMap<u32, Owned<T>>>> {
         match self.store.lock() {
             Ok(g) => Ok(g),
             Err(e) => {
@@ -36,14 +55,14 @@ impl<T> ObjectCache<T> {
             Ok(g) => g,
             Err(_) => return false
         };
-        store.contains_key(&handle)
+        store.get(&handle).map(Owned::is_visible).unwrap_or(false)
     }
 
     pub fn get<F, R>(&self, handle: u32, closure: F) -> VcxResult<R>
         where F: Fn(&T) -> VcxResult<R> {
         let store = self._lock_store()?;
-        match store.get(&handle) {
-            Some(m) => match m.lock() {
+        match store.get(&handle).filter(|m| m.is_visible()) {
+            Some(m) => match m.obj.lock() {
                 Ok(obj) => closure(obj.deref()),
                 Err(_) => Err(VcxError::from_msg(VcxErrorKind::Common(10), "Unable to lock Object Store")) //TODO better error
             },
@@ -54,8 +73,8 @@ impl<T> ObjectCache<T> {
     pub fn get_mut<F, R>(&self, handle: u32, closure: F) -> VcxResult<R>
         where F: Fn(&mut T) -> VcxResult<R> {
         let mut store = self._lock_store()?;
-        match store.get_mut(&handle) {
-            Some(m) => match m.lock() {
+        match store.get_mut(&handle).filter(|m| m.is_visible()) {
+            Some(m) => match m.obj.lock() {
                 Ok(mut obj) => closure(obj.deref_mut()),
                 Err(_) => Err(VcxError::from_msg(VcxErrorKind::Common(10), "Unable to lock Object Store")) //TODO better error
             },
@@ -74,7 +93,7 @@ impl<T> ObjectCache<T> {
             new_handle = rand::thread_rng().gen::<u32>();
         }
 
-        match store.insert(new_handle, Mutex::new(obj)) {
+        match store.insert(new_handle, Owned::new(obj)) {
             Some(_) => Ok(new_handle),
             None => Ok(new_handle)
         }
@@ -83,22 +102,30 @@ impl<T> ObjectCache<T> {
     pub fn insert(&self, handle: u32, obj: T) -> VcxResult<()> {
         let mut store = self._lock_store()?;
 
-        match store.insert(handle, Mutex::new(obj)) {
+        match store.insert(handle, Owned::new(obj)) {
             _ => Ok(()),
         }
     }
 
     pub fn release(&self, handle: u32) -> VcxResult<()> {
         let mut store = self._lock_store()?;
-        match store.remove(&handle) {
-            Some(_) => Ok(()),
-            None => Err(VcxError::from_msg(VcxErrorKind::InvalidHandle, format!("Object not found for handle: {}", handle)))
+        match store.get(&handle).map(Owned::is_visible) {
+            Some(true) => {
+                store.remove(&handle);
+                Ok(())
+            }
+            _ => Err(VcxError::from_msg(VcxErrorKind::InvalidHandle, format!("Object not found for handle: {}", handle)))
         }
     }
 
+    /// Releases the objects of the current context, or every object when no context is entered.
     pub fn drain(&self) -> VcxResult<()> {
         let mut store = self._lock_store()?;
-        Ok(store.clear())
+        match context::current_id() {
+            0 => store.clear(),
+            id => store.retain(|_, m| m.context != id),
+        }
+        Ok(())
     }
 }
 
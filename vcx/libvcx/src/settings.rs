@@ -2,7 +2,7 @@ extern crate url;
 extern crate serde_json;
 
 use std::collections::HashMap;
-use std::sync::RwLock;
+use std::sync::{Arc, RwLock};
 use utils::{get_temp_dir_path, error};
 use std::path::Path;
 use url::Url;
@@ -14,6 +14,7 @@ use std::borrow::Borrow;
 use error::prelude::*;
 use utils::file::read_file;
 use indy_sys::INVALID_WALLET_HANDLE;
+use context;
 
 pub static CONFIG_POOL_NAME: &str = "pool_name";
 pub static CONFIG_PROTOCOL_TYPE: &str = "protocol_type";
@@ -82,7 +83,15 @@ pub static MAX_THREADPOOL_SIZE: usize = 128;
 pub static MOCK_DEFAULT_INDY_PROOF_VALIDATION: &str = "true";
 
 lazy_static! {
-    static ref SETTINGS: RwLock<HashMap<String, String>> = RwLock::new(HashMap::new());
+    static ref SETTINGS: Arc<RwLock<HashMap<String, String>>> = Arc::new(RwLock::new(HashMap::new()));
+}
+
+// Settings of the context entered on the current thread or the process-wide ones.
+fn _settings() -> Arc<RwLock<HashMap<String, String>>> {
+    match context::current() {
+        Some(context) => context.settings.clone(),
+        None => SETTINGS.clone()
+    }
 }
 
 trait ToString {
@@ -101,7 +110,8 @@ pub fn set_defaults() -> u32 {
     trace!("set_defaults >>>");
 
     // if this fails the program should exit
-    let mut settings = SETTINGS.write().unwrap();
+    let settings = _settings();
+    let mut settings = settings.write().unwrap();
 
     settings.insert(CONFIG_POOL_NAME.to_string(), DEFAULT_POOL_NAME.to_string());
     settings.insert(CONFIG_WALLET_NAME.to_string(), DEFAULT_WALLET_NAME.to_string());
@@ -187,12 +197,14 @@ pub fn validate_payment_method() -> VcxResult<u32> {
 }
 
 pub fn log_settings() {
-    let settings = SETTINGS.read().unwrap();
+    let settings = _settings();
+    let settings = settings.read().unwrap();
     trace!("loaded settings: {:?}", settings.to_string());
 }
 
 pub fn indy_mocks_enabled() -> bool {
-    let config = SETTINGS.read().unwrap();
+    let config = _settings();
+    let config = config.read().unwrap();
 
     match config.get(CONFIG_ENABLE_TEST_MODE) {
         None => false,
@@ -201,7 +213,8 @@ pub fn indy_mocks_enabled() -> bool {
 }
 
 pub fn agency_mocks_enabled() -> bool {
-    let config = SETTINGS.read().unwrap();
+    let config = _settings();
+    let config = config.read().unwrap();
 
     match config.get(CONFIG_ENABLE_TEST_MODE) {
         None => false,
@@ -228,7 +241,8 @@ pub fn process_config_string(config: &str, do_validation: bool) -> VcxResult<u32
     }
 
     if do_validation {
-        let setting = SETTINGS.read()
+        let setting = _settings();
+        let setting = setting.read()
             .or(Err(VcxError::from(VcxErrorKind::InvalidConfiguration)))?;
         validate_config(&setting.borrow())
     } else {
@@ -251,7 +265,7 @@ pub fn process_config_file(path: &str) -> VcxResult<u32> {
 pub fn get_config_value(key: &str) -> VcxResult<String> {
     trace!("get_config_value >>> key: {}", key);
 
-    SETTINGS
+    _settings()
         .read()
         .or(Err(VcxError::from_msg(VcxErrorKind::InvalidConfiguration, "Cannot read settings")))?
         .get(key)
@@ -261,7 +275,7 @@ pub fn get_config_value(key: &str) -> VcxResult<String> {
 
 pub fn set_config_value(key: &str, value: &str) {
     trace!("set_config_value >>> key: {}, value: {}", key, value);
-    SETTINGS
+    _settings()
         .write().unwrap()
         .insert(key.to_string(), value.to_string());
 }
@@ -306,7 +320,7 @@ pub fn get_protocol_version() -> usize {
 
 pub fn get_opt_config_value(key: &str) -> Option<String> {
     trace!("get_opt_config_value >>> key: {}", key);
-    match SETTINGS.read() {
+    match _settings().read() {
         Ok(x) => x,
         Err(_) => return None
     }
@@ -450,7 +464,8 @@ pub fn get_protocol_type() -> ProtocolTypes {
 
 pub fn clear_config() {
     trace!("clear_config >>>");
-    let mut config = SETTINGS.write().unwrap();
+    let config = _settings();
+    let mut config = config.write().unwrap();
     config.clear();
 }
 
@@ -4,10 +4,14 @@ use serde_json::{map::Map, Value};
 use indy::{anoncreds, blob_storage, ledger};
 use time;
 
+use std::collections::HashMap;
+use std::sync::{Arc, Mutex};
+
 use settings;
 use utils::constants::{LIBINDY_CRED_OFFER, REQUESTED_ATTRIBUTES, PROOF_REQUESTED_PREDICATES, ATTRS, REV_STATE_JSON};
 use utils::libindy::{wallet::get_wallet_handle, LibindyMock};
 use utils::libindy::payments::{send_transaction, PaymentTxn};
+use utils::libindy::cache::{get_rev_reg_delta_cache, set_rev_reg_delta_cache, clear_rev_reg_delta_cache, RevRegDeltaCache};
 use utils::libindy::ledger::*;
 use utils::constants::{SCHEMA_ID, SCHEMA_JSON, SCHEMA_TXN, CREATE_SCHEMA_ACTION, CRED_DEF_ID, CRED_DEF_JSON, CRED_DEF_REQ, CREATE_CRED_DEF_ACTION, CREATE_REV_REG_DEF_ACTION, CREATE_REV_REG_DELTA_ACTION, REVOC_REG_TYPE, rev_def_json, REV_REG_ID, REV_REG_DELTA_JSON, REV_REG_JSON};
 use error::prelude::*;
@@ -15,6 +19,51 @@ use error::prelude::*;
 const BLOB_STORAGE_TYPE: &str = "default";
 const REVOCATION_REGISTRY_TYPE: &str = "ISSUANCE_BY_DEFAULT";
 
+lazy_static! {
+    static ref REV_REG_LOCKS: Mutex<HashMap<String, Arc<Mutex<()>>>> = Default::default();
+    static ref REV_REG_DELTA_LEDGER_MOCK: Mutex<HashMap<String, RevRegDeltaLedgerMock>> = Default::default();
+}
+
+// Revoking reads the pending delta of the registry from the wallet and writes it back,
+// so revocations and publishing of the same registry must not interleave.
+fn _rev_reg_lock(rev_reg_id: &str) -> Arc<Mutex<()>> {
+    let mut locks = REV_REG_LOCKS.lock().unwrap_or_else(|err| err.into_inner());
+    locks.entry(rev_reg_id.to_string()).or_default().clone()
+}
+
+///
+/// Ledger stand-in for entries of the registries it is enabled for. Revocations still go through
+/// the wallet and the tails file, only publishing of deltas is recorded or failed.
+///
+#[derive(Default, Clone)]
+pub struct RevRegDeltaLedgerMock {
+    pub deltas: Vec<String>,
+    pub fail: bool,
+}
+
+impl RevRegDeltaLedgerMock {
+    pub fn set(rev_reg_id: &str, fail: bool) {
+        let mut mocks = REV_REG_DELTA_LEDGER_MOCK.lock().unwrap();
+        mocks.entry(rev_reg_id.to_string()).or_default().fail = fail;
+    }
+
+    pub fn get(rev_reg_id: &str) -> Option<RevRegDeltaLedgerMock> {
+        REV_REG_DELTA_LEDGER_MOCK.lock().unwrap().get(rev_reg_id).cloned()
+    }
+
+    fn publish(rev_reg_id: &str, rev_reg_entry_json: &str) -> Option<VcxResult<(Option<PaymentTxn>, String)>> {
+        let mut mocks = REV_REG_DELTA_LEDGER_MOCK.lock().unwrap();
+        let mock = mocks.get_mut(rev_reg_id)?;
+
+        if mock.fail {
+            return Some(Err(VcxError::from_msg(VcxErrorKind::PoolLedgerConnect, "Mocked ledger rejected revocation registry entry")));
+        }
+
+        mock.deltas.push(rev_reg_entry_json.to_string());
+        Some(Ok((None, String::new())))
+    }
+}
+
 pub fn libindy_verifier_verify_proof(proof_req_json: &str,
                                      proof_json: &str,
                                      schemas_json: &str,
@@ -285,6 +334,12 @@ pub fn libindy_issuer_revoke_credential(tails_file: &str, rev_reg_id: &str, cred
         .map_err(VcxError::from)
 }
 
+pub fn libindy_issuer_merge_revocation_registry_deltas(old_delta: &str, new_delta: &str) -> VcxResult<String> {
+    anoncreds::issuer_merge_revocation_registry_deltas(old_delta, new_delta)
+        .wait()
+        .map_err(VcxError::from)
+}
+
 pub fn libindy_build_revoc_reg_def_request(submitter_did: &str,
                                            rev_reg_def_json: &str) -> VcxResult<String> {
     if settings::indy_mocks_enabled() { return Ok("".to_string()); }
@@ -502,6 +557,8 @@ pub fn build_rev_reg_delta_request(issuer_did: &str, rev_reg_id: &str, rev_reg_e
 
 pub fn publish_rev_reg_delta(issuer_did: &str, rev_reg_id: &str, rev_reg_entry_json: &str)
                              -> VcxResult<(Option<PaymentTxn>, String)> {
+    if let Some(res) = RevRegDeltaLedgerMock::publish(rev_reg_id, rev_reg_entry_json) { return res; }
+
     let request = build_rev_reg_delta_request(issuer_did, rev_reg_id, rev_reg_entry_json)?;
     send_transaction(&request, CREATE_REV_REG_DELTA_ACTION)
 }
@@ -538,10 +595,106 @@ pub fn revoke_credential(tails_file: &str, rev_reg_id: &str, cred_rev_id: &str)
 
     let submitter_did = settings::get_config_value(settings::CONFIG_INSTITUTION_DID)?;
 
+    let lock = _rev_reg_lock(rev_reg_id);
+    let _guard = lock.lock().unwrap_or_else(|err| err.into_inner());
+
+    let mut cache = get_rev_reg_delta_cache(rev_reg_id)?;
+
+    let delta = libindy_issuer_revoke_credential(tails_file, rev_reg_id, cred_rev_id)?;
+
+    // The ledger accepts only a delta starting from its current accumulator,
+    // so unpublished local revocations go out together with this one.
+    let delta = match cache.rev_reg_delta {
+        Some(ref pending_delta) => libindy_issuer_merge_revocation_registry_deltas(pending_delta, &delta)?,
+        None => delta
+    };
+
+    match publish_rev_reg_delta(&submitter_did, rev_reg_id, &delta) {
+        Ok((payment, _)) => {
+            if cache.rev_reg_delta.is_some() {
+                clear_rev_reg_delta_cache(rev_reg_id)?;
+            }
+
+            Ok((payment, delta))
+        }
+        Err(err) => {
+            // The registry is already updated in the wallet, so the revocation becomes pending
+            // and is published by `publish_local_revocations`
+            cache.rev_reg_delta = Some(delta);
+            cache.cred_rev_ids.push(cred_rev_id.to_string());
+            set_rev_reg_delta_cache(rev_reg_id, &cache)?;
+
+            Err(err)
+        }
+    }
+}
+
+///
+/// Revokes credential in the wallet without writing to the ledger.
+/// The revocation is merged into the pending delta of the registry and published by `publish_local_revocations`.
+///
+pub fn revoke_credential_local(tails_file: &str, rev_reg_id: &str, cred_rev_id: &str) -> VcxResult<()> {
+    if settings::indy_mocks_enabled() { return Ok(()); }
+
+    let lock = _rev_reg_lock(rev_reg_id);
+    let _guard = lock.lock().unwrap_or_else(|err| err.into_inner());
+
+    let mut cache = get_rev_reg_delta_cache(rev_reg_id)?;
+
+    if cache.cred_rev_ids.iter().any(|id| id == cred_rev_id) {
+        return Err(VcxError::from_msg(VcxErrorKind::InvalidRevocationDetails, format!("Credential {} is already revoked locally in {}", cred_rev_id, rev_reg_id)));
+    }
+
     let delta = libindy_issuer_revoke_credential(tails_file, rev_reg_id, cred_rev_id)?;
+
+    let delta = match cache.rev_reg_delta {
+        Some(ref old_delta) => libindy_issuer_merge_revocation_registry_deltas(old_delta, &delta)?,
+        None => delta
+    };
+
+    cache.rev_reg_delta = Some(delta);
+    cache.cred_rev_ids.push(cred_rev_id.to_string());
+
+    set_rev_reg_delta_cache(rev_reg_id, &cache)
+}
+
+///
+/// Publishes all revocations accumulated by `revoke_credential_local` for the registry as a single delta.
+/// Returns `None` payment when there was nothing to publish.
+///
+pub fn publish_local_revocations(rev_reg_id: &str) -> VcxResult<(Option<PaymentTxn>, Option<String>)> {
+    if settings::indy_mocks_enabled() {
+        let inputs = vec!["pay:null:9UFgyjuJxi1i1HD".to_string()];
+        let outputs = serde_json::from_str::<Vec<::utils::libindy::payments::Output>>(r#"[{"amount":4,"extra":null,"recipient":"pay:null:xkIsxem0YNtHrRO"}]"#).unwrap();
+        return Ok((Some(PaymentTxn::from_parts(inputs, outputs, 1, false)), Some(REV_REG_DELTA_JSON.to_string())));
+    }
+
+    let lock = _rev_reg_lock(rev_reg_id);
+    let _guard = lock.lock().unwrap_or_else(|err| err.into_inner());
+
+    let delta = match get_rev_reg_delta_cache(rev_reg_id)?.rev_reg_delta {
+        Some(delta) => delta,
+        None => return Ok((None, None))
+    };
+
+    let submitter_did = settings::get_config_value(settings::CONFIG_INSTITUTION_DID)?;
+
+    // The delta stays pending until it is published, so a failed publish can be retried
     let (payment, _) = publish_rev_reg_delta(&submitter_did, rev_reg_id, &delta)?;
 
-    Ok((payment, delta))
+    clear_rev_reg_delta_cache(rev_reg_id)?;
+
+    Ok((payment, Some(delta)))
+}
+
+///
+/// Returns ids of credentials revoked locally in the registry but not published to the ledger yet.
+///
+pub fn get_pending_revocations(rev_reg_id: &str) -> VcxResult<Vec<String>> {
+    if settings::indy_mocks_enabled() { return Ok(Vec::new()); }
+
+    get_rev_reg_delta_cache(rev_reg_id)
+        .map(|cache: RevRegDeltaCache| cache.cred_rev_ids)
 }
 
 pub fn libindy_to_unqualified(entity: &str) -> VcxResult<String> {
@@ -1072,4 +1225,197 @@ pub mod tests {
         assert!(payment.is_some());
         assert_ne!(first_rev_reg_delta, second_rev_reg_delta);
     }
+
+    #[test]
+    fn test_revoke_credential_local_and_publish_with_mocks() {
+        let _setup = SetupMocks::init();
+
+        revoke_credential_local(TEST_TAILS_FILE, REV_REG_ID, "1").unwrap();
+        assert!(get_pending_revocations(REV_REG_ID).unwrap().is_empty());
+
+        let (payment, delta) = publish_local_revocations(REV_REG_ID).unwrap();
+        assert!(payment.is_some());
+        assert_eq!(delta.unwrap(), REV_REG_DELTA_JSON);
+    }
+
+    // Issues credentials of a new revocation registry kept in the wallet only
+    fn _issue_revocable_credentials(count: usize) -> (String, String, Vec<String>) {
+        let institution_did = settings::get_config_value(settings::CONFIG_INSTITUTION_DID).unwrap();
+        let tails_file = get_temp_dir_path(TEST_TAILS_FILE).to_str().unwrap().to_string();
+
+        let (_, schema_json) = create_schema(DEFAULT_SCHEMA_ATTRS);
+        let (cred_def_id, cred_def_json) = libindy_create_and_store_credential_def(&institution_did, &schema_json, "tag1", None, r#"{"support_revocation":true}"#).unwrap();
+        let (rev_reg_id, _, _) = libindy_create_and_store_revoc_reg(&institution_did, &cred_def_id, &tails_file, 10).unwrap();
+
+        libindy_prover_create_master_secret(settings::DEFAULT_LINK_SECRET_ALIAS).unwrap();
+
+        let credential_data = r#"{"address1": ["123 Main St"], "address2": ["Suite 3"], "city": ["Draper"], "state": ["UT"], "zip": ["84000"]}"#;
+        let encoded_attributes = ::issuer_credential::encode_attributes(&credential_data).unwrap();
+
+        let cred_rev_ids = (0..count).map(|_| {
+            let offer = libindy_issuer_create_credential_offer(&cred_def_id).unwrap();
+            let (req, _) = libindy_prover_create_credential_req(&institution_did, &offer, &cred_def_json).unwrap();
+            let (_, cred_rev_id, _) = libindy_issuer_create_credential(&offer, &req, &encoded_attributes, Some(rev_reg_id.clone()), Some(tails_file.clone())).unwrap();
+            cred_rev_id.unwrap()
+        }).collect();
+
+        (tails_file, rev_reg_id, cred_rev_ids)
+    }
+
+    #[test]
+    fn test_revoke_credential_local_merges_pending_delta() {
+        let _setup = SetupLibraryWallet::init();
+
+        let (tails_file, rev_reg_id, cred_rev_ids) = _issue_revocable_credentials(2);
+
+        revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_ids[0]).unwrap();
+        let first_delta: serde_json::Value = serde_json::from_str(&get_rev_reg_delta_cache(&rev_reg_id).unwrap().rev_reg_delta.unwrap()).unwrap();
+
+        revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_ids[1]).unwrap();
+        assert_eq!(get_pending_revocations(&rev_reg_id).unwrap(), cred_rev_ids);
+
+        let delta: serde_json::Value = serde_json::from_str(&get_rev_reg_delta_cache(&rev_reg_id).unwrap().rev_reg_delta.unwrap()).unwrap();
+
+        // the merged delta starts from the accumulator known to the ledger
+        assert_eq!(delta["value"]["prevAccum"], first_delta["value"]["prevAccum"]);
+        assert_ne!(delta["value"]["accum"], first_delta["value"]["accum"]);
+
+        let mut revoked: Vec<String> = delta["value"]["revoked"].as_array().unwrap().iter().map(|idx| idx.to_string()).collect();
+        revoked.sort();
+        assert_eq!(revoked, cred_rev_ids);
+    }
+
+    fn _revoked(delta: &str) -> Vec<String> {
+        let delta: serde_json::Value = serde_json::from_str(delta).unwrap();
+        let mut revoked: Vec<String> = delta["value"]["revoked"].as_array().unwrap().iter().map(|idx| idx.to_string()).collect();
+        revoked.sort();
+        revoked
+    }
+
+    #[test]
+    fn test_revoke_credential_keeps_delta_pending_when_publish_fails() {
+        let _setup = SetupLibraryWallet::init();
+
+        let (tails_file, rev_reg_id, cred_rev_ids) = _issue_revocable_credentials(2);
+        RevRegDeltaLedgerMock::set(&rev_reg_id, true);
+
+        revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_ids[0]).unwrap();
+        assert_eq!(revoke_credential(&tails_file, &rev_reg_id, &cred_rev_ids[1]).unwrap_err().kind(), VcxErrorKind::PoolLedgerConnect);
+
+        // both revocations are kept for retry in one delta
+        assert_eq!(get_pending_revocations(&rev_reg_id).unwrap(), cred_rev_ids);
+        assert_eq!(_revoked(&get_rev_reg_delta_cache(&rev_reg_id).unwrap().rev_reg_delta.unwrap()), cred_rev_ids);
+
+        assert_eq!(publish_local_revocations(&rev_reg_id).unwrap_err().kind(), VcxErrorKind::PoolLedgerConnect);
+        assert_eq!(get_pending_revocations(&rev_reg_id).unwrap(), cred_rev_ids);
+
+        RevRegDeltaLedgerMock::set(&rev_reg_id, false);
+
+        let (_, delta) = publish_local_revocations(&rev_reg_id).unwrap();
+        assert_eq!(_revoked(&delta.unwrap()), cred_rev_ids);
+        assert!(get_pending_revocations(&rev_reg_id).unwrap().is_empty());
+        assert_eq!(RevRegDeltaLedgerMock::get(&rev_reg_id).unwrap().deltas.len(), 1);
+    }
+
+    // Ledger writes needed to revoke the same number of credentials immediately and in a batch
+    #[test]
+    fn test_local_revocations_are_published_in_one_ledger_write() {
+        let _setup = SetupLibraryWallet::init();
+
+        let count = 4;
+        let (tails_file, rev_reg_id, cred_rev_ids) = _issue_revocable_credentials(count * 2);
+        RevRegDeltaLedgerMock::set(&rev_reg_id, false);
+
+        for cred_rev_id in &cred_rev_ids[..count] {
+            revoke_credential(&tails_file, &rev_reg_id, cred_rev_id).unwrap();
+        }
+        assert_eq!(RevRegDeltaLedgerMock::get(&rev_reg_id).unwrap().deltas.len(), count);
+
+        for cred_rev_id in &cred_rev_ids[count..] {
+            revoke_credential_local(&tails_file, &rev_reg_id, cred_rev_id).unwrap();
+        }
+        assert_eq!(RevRegDeltaLedgerMock::get(&rev_reg_id).unwrap().deltas.len(), count);
+
+        let (_, delta) = publish_local_revocations(&rev_reg_id).unwrap();
+
+        let deltas = RevRegDeltaLedgerMock::get(&rev_reg_id).unwrap().deltas;
+        assert_eq!(deltas.len(), count + 1);
+        assert_eq!(deltas.last(), delta.as_ref());
+        assert_eq!(_revoked(&delta.unwrap()).len(), count);
+    }
+
+    #[test]
+    fn test_publish_local_revocations_does_nothing_without_pending() {
+        let _setup = SetupLibraryWallet::init();
+
+        let (payment, delta) = publish_local_revocations(REV_REG_ID).unwrap();
+        assert!(payment.is_none());
+        assert!(delta.is_none());
+        assert!(get_pending_revocations(REV_REG_ID).unwrap().is_empty());
+    }
+
+    #[cfg(feature = "pool_tests")]
+    #[test]
+    fn test_revoke_credential_local_then_publish() {
+        let _setup = SetupLibraryWalletPool::init();
+
+        let (_, _, _, _, _, _, _, _, rev_reg_id, cred_rev_id)
+            = ::utils::libindy::anoncreds::tests::create_and_store_credential(::utils::constants::DEFAULT_SCHEMA_ATTRS, true);
+
+        let rev_reg_id = rev_reg_id.unwrap();
+        let cred_rev_id = cred_rev_id.unwrap();
+        let tails_file = get_temp_dir_path(TEST_TAILS_FILE).to_str().unwrap().to_string();
+        let (_, first_rev_reg_delta, first_timestamp) = get_rev_reg_delta_json(&rev_reg_id, None, None).unwrap();
+
+        revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_id).unwrap();
+        assert_eq!(get_pending_revocations(&rev_reg_id).unwrap(), vec![cred_rev_id.clone()]);
+
+        // revoking the same credential twice is rejected before touching the wallet
+        assert!(revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_id).is_err());
+
+        // nothing is written to the ledger yet
+        let (_, rev_reg_delta, _) = get_rev_reg_delta_json(&rev_reg_id, None, None).unwrap();
+        assert_eq!(first_rev_reg_delta, rev_reg_delta);
+
+        let (_, delta) = publish_local_revocations(&rev_reg_id).unwrap();
+        assert!(get_pending_revocations(&rev_reg_id).unwrap().is_empty());
+
+        let (_, second_rev_reg_delta, _) = get_rev_reg_delta_json(&rev_reg_id, Some(first_timestamp + 1), None).unwrap();
+        assert_ne!(first_rev_reg_delta, second_rev_reg_delta);
+
+        // the ledger accumulator is the one of the published pending delta
+        let delta: serde_json::Value = serde_json::from_str(&delta.unwrap()).unwrap();
+        let second_rev_reg_delta: serde_json::Value = serde_json::from_str(&second_rev_reg_delta).unwrap();
+        assert_eq!(delta["value"]["accum"], second_rev_reg_delta["value"]["accum"]);
+    }
+
+    #[cfg(feature = "pool_tests")]
+    #[test]
+    fn test_revoke_credential_publishes_pending_local_revocations() {
+        let _setup = SetupLibraryWalletPool::init();
+
+        let (_, _, _, _, offer, req, _, _, rev_reg_id, cred_rev_id)
+            = ::utils::libindy::anoncreds::tests::create_and_store_credential(::utils::constants::DEFAULT_SCHEMA_ATTRS, true);
+
+        let rev_reg_id = rev_reg_id.unwrap();
+        let cred_rev_id = cred_rev_id.unwrap();
+        let tails_file = get_temp_dir_path(TEST_TAILS_FILE).to_str().unwrap().to_string();
+
+        let credential_data = r#"{"address1": ["123 Main St"], "address2": ["Suite 3"], "city": ["Draper"], "state": ["UT"], "zip": ["84000"]}"#;
+        let encoded_attributes = ::issuer_credential::encode_attributes(&credential_data).unwrap();
+        let (_, second_cred_rev_id, _) = libindy_issuer_create_credential(&offer, &req, &encoded_attributes, Some(rev_reg_id.clone()), Some(tails_file.clone())).unwrap();
+        let second_cred_rev_id = second_cred_rev_id.unwrap();
+
+        revoke_credential_local(&tails_file, &rev_reg_id, &cred_rev_id).unwrap();
+
+        // the immediate revocation carries the pending one, otherwise its delta wouldn't match the ledger accumulator
+        let (_, delta) = revoke_credential(&tails_file, &rev_reg_id, &second_cred_rev_id).unwrap();
+        assert!(get_pending_revocations(&rev_reg_id).unwrap().is_empty());
+
+        let (_, rev_reg_delta, _) = get_rev_reg_delta_json(&rev_reg_id, None, None).unwrap();
+        let delta: serde_json::Value = serde_json::from_str(&delta).unwrap();
+        let rev_reg_delta: serde_json::Value = serde_json::from_str(&rev_reg_delta).unwrap();
+        assert_eq!(delta["value"]["accum"], rev_reg_delta["value"]["accum"]);
+        assert_eq!(delta["value"]["revoked"].as_array().unwrap().len(), 2);
+    }
 }
@@ -1,9 +1,11 @@
 use serde_json;
 
-use utils::libindy::wallet::{add_record, get_record, update_record_value};
+use utils::libindy::wallet::{add_record, get_record, update_record_value, delete_record};
+use error::prelude::*;
 
 static CACHE_TYPE: &str = "cache";
 static REV_REG_CACHE_PREFIX: &str = "rev_reg:";
+static REV_REG_DELTA_CACHE_PREFIX: &str = "rev_reg_delta:";
 
 ///
 /// Cache object for rev reg cache
@@ -76,6 +78,66 @@ pub fn set_rev_reg_cache(rev_reg_id: &str, cache: &RevRegCache) {
     }
 }
 
+///
+/// Cache object for revocations made locally but not published to the ledger yet
+///
+#[derive(Serialize, Deserialize, Debug, Default, PartialEq)]
+pub struct RevRegDeltaCache {
+    pub rev_reg_delta: Option<String>,
+    pub cred_rev_ids: Vec<String>,
+}
+
+///
+/// Returns the pending rev reg delta cache.
+/// Unlike the rev reg cache, errors are not ignored: losing this record means losing unpublished revocations.
+///
+/// # Arguments
+/// `rev_reg_id`: revocation registry id
+///
+pub fn get_rev_reg_delta_cache(rev_reg_id: &str) -> VcxResult<RevRegDeltaCache> {
+    let wallet_id = format!("{}{}", REV_REG_DELTA_CACHE_PREFIX, rev_reg_id);
+    match get_record(CACHE_TYPE, &wallet_id, &json!({"retrieveType": false, "retrieveValue": true, "retrieveTags": false}).to_string()) {
+        Ok(json) => {
+            serde_json::from_str(&json)
+                .and_then(|x: serde_json::Value| {
+                    serde_json::from_str(x.get("value").unwrap_or(&serde_json::Value::Null).as_str().unwrap_or(""))
+                })
+                .map_err(|err| VcxError::from_msg(VcxErrorKind::InvalidJson, format!("Cannot deserialize rev reg delta cache for rev_reg_id: {}, error: {}", rev_reg_id, err)))
+        }
+        Err(ref err) if err.kind() == VcxErrorKind::WalletRecordNotFound => Ok(RevRegDeltaCache::default()),
+        Err(err) => Err(err)
+    }
+}
+
+///
+/// Saves pending rev reg delta cache.
+///
+/// # Arguments
+/// `rev_reg_id`: revocation registry id.
+/// `cache`: Cache object.
+///
+pub fn set_rev_reg_delta_cache(rev_reg_id: &str, cache: &RevRegDeltaCache) -> VcxResult<()> {
+    let json = serde_json::to_string(cache)
+        .map_err(|err| VcxError::from_msg(VcxErrorKind::SerializationError, format!("Cannot serialize rev reg delta cache: {:?}", err)))?;
+
+    let wallet_id = format!("{}{}", REV_REG_DELTA_CACHE_PREFIX, rev_reg_id);
+    update_record_value(CACHE_TYPE, &wallet_id, &json)
+        .or(add_record(CACHE_TYPE, &wallet_id, &json, None))
+}
+
+///
+/// Removes pending rev reg delta cache once it has been published.
+///
+/// # Arguments
+/// `rev_reg_id`: revocation registry id.
+///
+pub fn clear_rev_reg_delta_cache(rev_reg_id: &str) -> VcxResult<()> {
+    let wallet_id = format!("{}{}", REV_REG_DELTA_CACHE_PREFIX, rev_reg_id);
+    match delete_record(CACHE_TYPE, &wallet_id) {
+        Err(ref err) if err.kind() == VcxErrorKind::WalletRecordNotFound => Ok(()),
+        res => res
+    }
+}
 
 #[cfg(test)]
 pub mod tests {
@@ -170,4 +232,40 @@ pub mod tests {
         assert_eq!(result, data2);
     }
 
-}
\ No newline at end of file
+    #[test]
+    fn test_rev_reg_delta_cache_returns_default_when_not_exists_in_wallet() {
+        let _setup = SetupLibraryWallet::init();
+
+        let result = get_rev_reg_delta_cache(_rev_reg_id()).unwrap();
+        assert_eq!(result, RevRegDeltaCache::default());
+    }
+
+    #[test]
+    fn test_rev_reg_delta_cache_fails_when_invalid_data_in_the_wallet() {
+        let _setup = SetupLibraryWallet::init();
+
+        add_record(CACHE_TYPE, &format!("{}{}", REV_REG_DELTA_CACHE_PREFIX, _rev_reg_id()), "some invalid json", None).unwrap();
+
+        let err = get_rev_reg_delta_cache(_rev_reg_id()).unwrap_err();
+        assert_eq!(err.kind(), VcxErrorKind::InvalidJson);
+    }
+
+    #[test]
+    fn test_rev_reg_delta_cache_set_get_clear_works() {
+        let _setup = SetupLibraryWallet::init();
+
+        let data = RevRegDeltaCache {
+            rev_reg_delta: Some(r#"{"key": "value1"}"#.to_string()),
+            cred_rev_ids: vec!["1".to_string(), "2".to_string()],
+        };
+
+        set_rev_reg_delta_cache(_rev_reg_id(), &data).unwrap();
+        assert_eq!(get_rev_reg_delta_cache(_rev_reg_id()).unwrap(), data);
+
+        clear_rev_reg_delta_cache(_rev_reg_id()).unwrap();
+        assert_eq!(get_rev_reg_delta_cache(_rev_reg_id()).unwrap(), RevRegDeltaCache::default());
+
+        // clearing twice is not an error
+        clear_rev_reg_delta_cache(_rev_reg_id()).unwrap();
+    }
+}
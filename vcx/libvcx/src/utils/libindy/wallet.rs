@@ -2,6 +2,7 @@ use futures::Future;
 use indy::{wallet, ErrorCode};
 
 use settings;
+use context;
 
 use error::prelude::*;
 use indy::{WalletHandle, INVALID_WALLET_HANDLE};
@@ -52,11 +53,22 @@ impl RestoreWalletConfigs {
 pub static mut WALLET_HANDLE: WalletHandle = INVALID_WALLET_HANDLE;
 
 pub fn set_wallet_handle(handle: WalletHandle) -> WalletHandle {
+    if let Some(context) = context::current() {
+        context.set_wallet_handle(handle);
+        return handle;
+    }
+
     unsafe { WALLET_HANDLE = handle; }
     unsafe { WALLET_HANDLE }
 }
 
-pub fn get_wallet_handle() -> WalletHandle { unsafe { WALLET_HANDLE } }
+pub fn get_wallet_handle() -> WalletHandle {
+    if let Some(context) = context::current() {
+        return context.get_wallet_handle();
+    }
+
+    unsafe { WALLET_HANDLE }
+}
 
 pub fn reset_wallet_handle() { set_wallet_handle(INVALID_WALLET_HANDLE); }
 
@@ -37,6 +37,10 @@ pub fn init() {
 pub fn spawn<F>(future: F)
 where
     F: FnOnce() -> Result<(), ()> + Send + 'static {
+        // run the work within the context of the caller
+        let context = ::context::current();
+        let future = move || ::context::with_context(context, future);
+
         let handle;
         unsafe { handle = TP_HANDLE; }
         if ::settings::get_threadpool_size() == 0 || handle == 0{
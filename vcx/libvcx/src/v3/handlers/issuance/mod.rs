@@ -47,7 +47,11 @@ impl Issuer {
     }
 
     pub fn revoke_credential(&self) -> VcxResult<()> {
-        self.issuer_sm.revoke()
+        self.issuer_sm.revoke(true)
+    }
+
+    pub fn revoke_credential_local(&self) -> VcxResult<()> {
+        self.issuer_sm.revoke(false)
     }
 
     pub fn update_status(&mut self, msg: Option<String>) -> VcxResult<()> {
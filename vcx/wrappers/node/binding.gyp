@@ -0,0 +1,13 @@
+{
+  "targets": [
+    {
+      "target_name": "vcxnodejs",
+      "include_dirs": [
+        "<!(node -e \"require('nan')\")"
+      ],
+      "sources": [
+        "src/vcx.cc"
+      ]
+    }
+  ]
+}
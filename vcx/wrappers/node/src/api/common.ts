@@ -120,6 +120,8 @@ export enum StateType {
 
 export interface IInitVCXOptions {
   libVCXPath?: string
+  // false forces calls through node-ffi, by default the native addon is used if it's built
+  native?: boolean
 }
 
 export interface IUTXO {
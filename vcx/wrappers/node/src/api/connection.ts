@@ -1,8 +1,7 @@
-import * as ffi from 'ffi'
 import * as ref from 'ref'
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData, StateType } from './common'
 import { VCXBaseWithState } from './vcx-base-with-state'
 
@@ -223,6 +222,10 @@ export function voidPtrToUint8Array (origPtr: any, length: number): Buffer {
   /**
    * Read the contents of the pointer and copy it into a new Buffer
    */
+  if (Buffer.isBuffer(origPtr)) {
+    // the native addon passes a copy of the data already
+    return origPtr
+  }
   const ptrType = ref.refType('uint8 *')
   const pointerBuf = ref.alloc(ptrType, origPtr)
   const newPtr = ref.readPointer(pointerBuf, 0, length)
@@ -318,7 +321,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             resolve(StateType.None)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: any, state: StateType) => {
@@ -352,7 +355,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32'],
           (xcommandHandle: number, err: number) => {
@@ -387,7 +390,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, details: string) => {
@@ -432,7 +435,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, details: string) => {
@@ -466,7 +469,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'pointer', 'uint32'],
             (xHandle: number, err: number, details: any, length: number) => {
@@ -506,7 +509,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'bool'],
             (xHandle: number, err: number, valid: boolean) => {
@@ -542,7 +545,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'string'],
           (handle: number, err: number, details: string) => {
@@ -579,7 +582,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32','uint32'],
           (xhandle: number, err: number) => {
@@ -611,7 +614,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32','uint32'],
           (xhandle: number, err: number) => {
@@ -640,7 +643,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, details: string) => {
@@ -673,7 +676,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, details: string) => {
@@ -719,7 +722,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32'],
             (xcommandHandle: number, err: number) => {
@@ -768,7 +771,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
           }
         },
         (resolve, reject) =>
-          ffi.Callback(
+          Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, details: string) => {
@@ -805,7 +808,7 @@ export class Connection extends VCXBaseWithState<IConnectionData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'string'],
           (handle: number, err: number, info: string) => {
@@ -1,7 +1,6 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData } from './common'
 import { VCXBase } from './vcx-base'
 import { PaymentManager } from './vcx-payment-txn'
@@ -190,7 +189,7 @@ export class CredentialDef extends VCXBase<ICredentialDefData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'uint32', 'string', 'string', 'string'],
             (handle: number, err: number, _handle: number, _credDefTxn: string, _revocRegDefTxn: string,
@@ -291,7 +290,7 @@ export class CredentialDef extends VCXBase<ICredentialDefData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xcommandHandle: number, err: number, credDefIdVal: string) => {
@@ -328,7 +327,7 @@ export class CredentialDef extends VCXBase<ICredentialDefData> {
               reject(rc)
             }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: any, state: CredentialDefState) => {
@@ -361,7 +360,7 @@ export class CredentialDef extends VCXBase<ICredentialDefData> {
               reject(rc)
             }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: number, state: CredentialDefState) => {
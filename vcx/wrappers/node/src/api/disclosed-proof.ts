@@ -1,8 +1,6 @@
-import { Callback } from 'ffi'
-
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData } from './common'
 import { Connection } from './connection'
 import { VCXBaseWithState } from './vcx-base-with-state'
@@ -1,8 +1,6 @@
-import { Callback } from 'ffi'
-
 import { VCXInternalError } from '../errors'
 import { initRustAPI, rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { IInitVCXOptions } from './common'
 
 /**
@@ -16,7 +14,7 @@ import { IInitVCXOptions } from './common'
  * ```
  */
 export async function initVcx (configPath: string, options: IInitVCXOptions = {}): Promise<void> {
-  initRustAPI(options.libVCXPath)
+  initRustAPI(options.libVCXPath, options.native)
   let rc = null
   try {
     return await createFFICallbackPromise<void>(
@@ -66,7 +64,7 @@ export async function initVcx (configPath: string, options: IInitVCXOptions = {}
  * ```
  */
 export async function initVcxWithConfig (config: string, options: IInitVCXOptions = {}): Promise<void> {
-  initRustAPI(options.libVCXPath)
+  initRustAPI(options.libVCXPath, options.native)
   let rc = null
   try {
     return await createFFICallbackPromise<void>(
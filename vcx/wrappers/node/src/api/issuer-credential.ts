@@ -1,7 +1,6 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData, StateType } from './common'
 import { Connection } from './connection'
 import { VCXBaseWithState } from './vcx-base-with-state'
@@ -258,7 +257,7 @@ export class IssuerCredential extends VCXBaseWithState<IIssuerCredentialData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32'],
             (xcommandHandle: number, err: number) => {
@@ -293,7 +292,7 @@ export class IssuerCredential extends VCXBaseWithState<IIssuerCredentialData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, message: string) => {
@@ -335,7 +334,7 @@ export class IssuerCredential extends VCXBaseWithState<IIssuerCredentialData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32'],
           (xcommandHandle: number, err: number) => {
@@ -373,7 +372,7 @@ export class IssuerCredential extends VCXBaseWithState<IIssuerCredentialData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, message: string) => {
@@ -416,7 +415,7 @@ export class IssuerCredential extends VCXBaseWithState<IIssuerCredentialData> {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32'],
           (xcommandHandle: number, err: number) => {
@@ -1,7 +1,6 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData, StateType } from './common'
 import { Connection } from './connection'
 import { VCXBaseWithState } from './vcx-base-with-state'
@@ -385,7 +384,7 @@ export class Proof extends VCXBaseWithState<IProofData> {
             resolve(StateType.None)
           }
         },
-      (resolve, reject) => ffi.Callback(
+      (resolve, reject) => Callback(
         'void',
         ['uint32', 'uint32', 'uint32'],
         (handle: number, err: any, state: StateType) => {
@@ -425,7 +424,7 @@ export class Proof extends VCXBaseWithState<IProofData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32'],
             (xcommandHandle: number, err: number) => {
@@ -465,7 +464,7 @@ export class Proof extends VCXBaseWithState<IProofData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xHandle: number, err: number, message: string) => {
@@ -511,7 +510,7 @@ export class Proof extends VCXBaseWithState<IProofData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'uint32', 'string'],
             (xcommandHandle: number, err: number, proofState: ProofState, proofData: string) => {
@@ -1,8 +1,6 @@
-
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { ISerializedData } from './common'
 import { VCXBase } from './vcx-base'
 import { PaymentManager } from './vcx-payment-txn'
@@ -178,7 +176,7 @@ export class Schema extends VCXBase<ISchemaSerializedData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'uint32', 'string'],
             (handle: number, err: number, _schemaHandle: number, _transaction: string) => {
@@ -266,7 +264,7 @@ export class Schema extends VCXBase<ISchemaSerializedData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'uint32', 'string'],
             (handle: number, err: number, _schemaHandle: number, _schemaData: string) => {
@@ -334,7 +332,7 @@ export class Schema extends VCXBase<ISchemaSerializedData> {
               reject(rc)
             }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: any, state: SchemaState) => {
@@ -367,7 +365,7 @@ export class Schema extends VCXBase<ISchemaSerializedData> {
               reject(rc)
             }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: number, state: SchemaState) => {
@@ -412,7 +410,7 @@ export class Schema extends VCXBase<ISchemaSerializedData> {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback(
+          (resolve, reject) => Callback(
             'void',
             ['uint32', 'uint32', 'string'],
             (xcommandHandle: number, err: number, schemaIdVal: string) => {
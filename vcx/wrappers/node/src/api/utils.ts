@@ -1,8 +1,6 @@
-import { Callback } from 'ffi'
-
 import { VCXInternalError } from '../errors'
 import { initRustAPI, rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { IInitVCXOptions } from './common'
 // import { resolve } from 'url';
 
@@ -24,7 +22,7 @@ export async function provisionAgent (configAgent: string, options: IInitVCXOpti
    * vcxConfig = await provisionAgent(JSON.stringify(enterprise_config))
    */
   try {
-    initRustAPI(options.libVCXPath)
+    initRustAPI(options.libVCXPath, options.native)
     return await createFFICallbackPromise<string>(
       (resolve, reject, cb) => {
         const rc = rustAPI().vcx_agent_provision_async(0, configAgent, cb)
@@ -1,6 +1,5 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
-import { createFFICallbackPromise, ICbRef } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise, ICbRef } from '../utils/ffi-helpers'
 import { StateType } from './common'
 import { VCXBase } from './vcx-base'
 
@@ -30,7 +29,7 @@ export abstract class VCXBaseWithState<SerializedData> extends VCXBase<Serialize
             resolve(StateType.None)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: any, state: StateType) => {
@@ -65,7 +64,7 @@ export abstract class VCXBaseWithState<SerializedData> extends VCXBase<Serialize
             resolve(StateType.None)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: any, state: StateType) => {
@@ -99,7 +98,7 @@ export abstract class VCXBaseWithState<SerializedData> extends VCXBase<Serialize
             resolve(StateType.None)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (handle: number, err: number, state: StateType) => {
@@ -1,6 +1,5 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
-import { createFFICallbackPromise, ICbRef } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise, ICbRef } from '../utils/ffi-helpers'
 import { GCWatcher } from '../utils/memory-management-helpers'
 import { ISerializedData } from './common'
 
@@ -52,7 +51,7 @@ export abstract class VCXBase<SerializedData> extends GCWatcher {
             return
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'string'],
           (handle: string, err: any, serializedData?: string) => {
@@ -87,7 +86,7 @@ export abstract class VCXBase<SerializedData> extends GCWatcher {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (xHandle: number, err: number, handle: number) => {
@@ -110,7 +109,7 @@ export abstract class VCXBase<SerializedData> extends GCWatcher {
             reject(rc)
           }
         },
-        (resolve, reject) => ffi.Callback(
+        (resolve, reject) => Callback(
           'void',
           ['uint32', 'uint32', 'uint32'],
           (xHandle: number, err: number, handle: number) => {
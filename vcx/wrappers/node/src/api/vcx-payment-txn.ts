@@ -1,6 +1,5 @@
-import * as ffi from 'ffi'
 import { VCXInternalError } from '../errors'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { IPaymentOutput } from './common'
 
 export interface IPaymentTxn {
@@ -27,7 +26,7 @@ export abstract class PaymentManager {
               reject(rc)
             }
           },
-          (resolve, reject) => ffi.Callback('void', ['uint32', 'uint32', 'string'],
+          (resolve, reject) => Callback('void', ['uint32', 'uint32', 'string'],
           (xcommandHandle: number, err: number, info: any) => {
             if (err) {
               reject(err)
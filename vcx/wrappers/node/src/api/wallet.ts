@@ -1,9 +1,8 @@
-import { Callback } from 'ffi'
 import * as ref from 'ref'
 
 import { VCXInternalError } from '../errors'
 import { rustAPI } from '../rustlib'
-import { createFFICallbackPromise } from '../utils/ffi-helpers'
+import { Callback, createFFICallbackPromise } from '../utils/ffi-helpers'
 import { IUTXO } from './common'
 import { voidPtrToUint8Array } from './connection'
 
@@ -443,5 +443,13 @@ export const FFIConfiguration: { [ Key in keyof IFFIEntryPoint ]: any } = {
 }
 
 let _rustAPI: IFFIEntryPoint
-export const initRustAPI = (path?: string) => _rustAPI = new VCXRuntime({ basepath: path }).ffi
+let _isNativeAPI = false
+export const initRustAPI = (path?: string, native?: boolean) => {
+  const runtime = new VCXRuntime({ basepath: path, native })
+  _isNativeAPI = runtime.native !== undefined
+  _rustAPI = runtime.native || runtime.ffi
+  return _rustAPI
+}
 export const rustAPI = () => _rustAPI
+// true if libvcx is called through the native addon, callbacks are then plain JS functions
+export const isNativeAPI = () => _isNativeAPI
@@ -1,3 +1,7 @@
+import * as ffi from 'ffi'
+
+import { isNativeAPI } from '../rustlib'
+
 const maxTimeout = 2147483647
 
 export type ICbRef = Buffer
@@ -14,22 +18,33 @@ export type ICreateFFICallbackPromiseCb<T> = (
   reject: (reason?: any) => void
 ) => ICbRef
 
+// Creates the callback passed to libvcx. The native addon completes calls with its static
+// callbacks and takes the JS function as is, node-ffi needs a closure created for every call.
+export const Callback = (retType: any, argTypes: any[], fn: (...args: any[]) => any): ICbRef =>
+  isNativeAPI() ? fn as any : ffi.Callback(retType, argTypes, fn)
+
 export const createFFICallbackPromise = <T>(fn: ICreateFFICallbackPromiseFn<T>, cb: ICreateFFICallbackPromiseCb<T>) => {
   // @ts-ignore
   let cbRef = null
   // TODO: Research why registering a callback doesn't keep parent thread alive https://github.com/node-ffi/node-ffi
-  const processKeepAliveTimer = setTimeout(() => undefined, maxTimeout)
+  // The native addon keeps the loop alive while it waits for libvcx callbacks
+  const processKeepAliveTimer = isNativeAPI() ? undefined : setTimeout(() => undefined, maxTimeout)
+  const clearKeepAliveTimer = () => {
+    if (processKeepAliveTimer) {
+      clearTimeout(processKeepAliveTimer)
+    }
+  }
   return (new Promise<T>(
       (resolve, reject) => fn(resolve, reject, cbRef = cb(resolve, reject)))
     )
     .then((res) => {
       cbRef = null
-      clearTimeout(processKeepAliveTimer)
+      clearKeepAliveTimer()
       return res
     })
     .catch((err) => {
       cbRef = null
-      clearTimeout(processKeepAliveTimer)
+      clearKeepAliveTimer()
       throw err
     })
 }
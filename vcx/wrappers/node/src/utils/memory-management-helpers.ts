@@ -1,5 +1,8 @@
 import * as weak from 'weak'
 
+import { isNativeAPI } from '../rustlib'
+import { nativeAddon } from '../vcx'
+
 export abstract class GCWatcher {
   protected abstract _releaseFn: any
   // LibVCX handles invalid handles
@@ -20,6 +23,12 @@ export abstract class GCWatcher {
   // _clearOnExit creates a callback that will release the Rust Object
   // when the node Connection object is Garbage collected
   protected _clearOnExit () {
+    // The native addon releases the object from the GC callback itself, its functions are named
+    // after the libvcx functions they call
+    const addon = isNativeAPI() ? nativeAddon() : undefined
+    if (addon && addon.registerRelease(this, this._releaseFn.name, this._handleRef)) {
+      return
+    }
     const weakRef = weak(this)
     const release = this._releaseFn
     const handle = this._handleRef
@@ -0,0 +1,2747 @@
+#include <string>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <string.h>
+#include <nan.h>
+
+// libvcx is loaded at runtime by `load` from the path resolved by VCXRuntime (libVCXPath option,
+// LIBVCX_PATH or the system library dir), so the addon and node-ffi always call the same library.
+
+typedef uint32_t vcx_error_t;
+typedef uint32_t vcx_command_handle_t;
+typedef uint32_t vcx_u32_t;
+typedef int32_t vcx_i32_t;
+typedef uint64_t vcx_u64_t;
+typedef uint8_t vcx_u8_t;
+
+typedef void (*vcx_cb_none_t)(vcx_command_handle_t, vcx_error_t);
+typedef void (*vcx_cb_handle_t)(vcx_command_handle_t, vcx_error_t, vcx_u32_t);
+typedef void (*vcx_cb_string_t)(vcx_command_handle_t, vcx_error_t, const char*);
+typedef void (*vcx_cb_boolean_t)(vcx_command_handle_t, vcx_error_t, bool);
+typedef void (*vcx_cb_buffer_t)(vcx_command_handle_t, vcx_error_t, const vcx_u8_t*, vcx_u32_t);
+typedef void (*vcx_cb_handle_string_t)(vcx_command_handle_t, vcx_error_t, vcx_u32_t, const char*);
+typedef void (*vcx_cb_handle_string_string_string_t)(vcx_command_handle_t, vcx_error_t, vcx_u32_t, const char*, const char*, const char*);
+
+char* copyCStr(const char* original){
+    if(original == nullptr){
+        return nullptr;
+    }
+    size_t len = strlen(original);
+    char* dest = new char[len + 1];
+    strncpy(dest, original, len);
+    dest[len] = '\0';
+    return dest;
+}
+
+v8::Local<v8::Value> toJSString(const char* str){
+    if(str == nullptr){
+        return Nan::Null();
+    }
+    return Nan::New<v8::String>(str).ToLocalChecked();
+}
+
+enum VcxCallbackType {
+    CB_NONE,
+    CB_HANDLE,
+    CB_STRING,
+    CB_BOOLEAN,
+    CB_BUFFER,
+    CB_HANDLE_STRING,
+    CB_HANDLE_STRING_STRING_STRING
+};
+
+/**
+ * Result of a libvcx call. It's created on the libvcx thread that completes the call and
+ * is handed over to the main loop, so it owns copies of everything libvcx passed.
+ */
+struct VcxResult {
+    VcxResult(vcx_command_handle_t handle_, vcx_error_t err_, VcxCallbackType type_) {
+        handle = handle_;
+        err = err_;
+        type = type_;
+        handle0 = 0;
+        bool0 = false;
+        str0 = nullptr;
+        str1 = nullptr;
+        str2 = nullptr;
+        buffer0len = 0;
+    }
+
+    ~VcxResult() {
+        delete[] str0;
+        delete[] str1;
+        delete[] str2;
+    }
+
+    vcx_command_handle_t handle;
+    vcx_error_t err;
+    VcxCallbackType type;
+    vcx_u32_t handle0;
+    bool bool0;
+    const char* str0;
+    const char* str1;
+    const char* str2;
+    std::vector<char> buffer0;
+    vcx_u32_t buffer0len;
+};
+
+/**
+ * Pending libvcx call.
+ *
+ * node-ffi creates a closure for every call and libvcx threads reenter the loop through it.
+ * Here libvcx gets one of the static callbacks below, they queue results and wake up the main
+ * loop with the single shared uv_async_t, which then completes every queued call. The async
+ * handle is referenced only while calls are pending, so it keeps the process alive exactly as
+ * long as libvcx owes a callback.
+ */
+class VcxCallback : public Nan::AsyncResource {
+  public:
+    VcxCallback(vcx_u32_t commandHandle_, v8::Local<v8::Function> callback_) : Nan::AsyncResource("VcxCallback") {
+        callback.Reset(callback_);
+        commandHandle = commandHandle_;
+        next_handle++;
+        handle = next_handle;
+        vcbmap[handle] = this;
+        updateLoopRef();
+    }
+
+    ~VcxCallback() {
+        callback.Reset();
+    }
+
+    vcx_command_handle_t handle;
+
+    static void init(uv_loop_t* loop){
+        uv_async_init(loop, &uvHandle, onMainLoopReentry);
+        uv_unref(reinterpret_cast<uv_handle_t*>(&uvHandle));
+    }
+
+    // Called on libvcx threads.
+    static void complete(VcxResult* result){
+        {
+            std::lock_guard<std::mutex> lock(completedMutex);
+            completed.push_back(result);
+        }
+        uv_async_send(&uvHandle);
+    }
+
+    // Drops the call libvcx has rejected, it will never call back.
+    static void cancel(VcxCallback* vcb){
+        vcbmap.erase(vcb->handle);
+        delete vcb;
+        updateLoopRef();
+    }
+
+  private:
+
+    static vcx_command_handle_t next_handle;
+    static std::map<vcx_command_handle_t, VcxCallback*> vcbmap;
+    static uv_async_t uvHandle;
+    static std::mutex completedMutex;
+    static std::vector<VcxResult*> completed;
+
+    Nan::Persistent<v8::Function> callback;
+    // command handle passed from JS, it's passed back as the first callback argument as node-ffi does
+    vcx_u32_t commandHandle;
+
+    static void updateLoopRef(){
+        if(vcbmap.empty()){
+            uv_unref(reinterpret_cast<uv_handle_t*>(&uvHandle));
+        } else {
+            uv_ref(reinterpret_cast<uv_handle_t*>(&uvHandle));
+        }
+    }
+
+    void call(VcxResult* result){
+        v8::Local<v8::Value> argv[6];
+        int argc = 2;
+        argv[0] = Nan::New<v8::Number>(commandHandle);
+        argv[1] = Nan::New<v8::Number>(result->err);
+        switch(result->type){
+            case CB_NONE:
+                break;
+            case CB_HANDLE:
+                argv[argc++] = Nan::New<v8::Number>(result->handle0);
+                break;
+            case CB_STRING:
+                argv[argc++] = toJSString(result->str0);
+                break;
+            case CB_BOOLEAN:
+                argv[argc++] = Nan::New<v8::Boolean>(result->bool0);
+                break;
+            case CB_BUFFER:
+                if(result->buffer0.empty()){
+                    argv[argc++] = Nan::Null();
+                } else {
+                    argv[argc++] = Nan::CopyBuffer(result->buffer0.data(), result->buffer0.size()).ToLocalChecked();
+                }
+                argv[argc++] = Nan::New<v8::Number>(result->buffer0len);
+                break;
+            case CB_HANDLE_STRING:
+                argv[argc++] = Nan::New<v8::Number>(result->handle0);
+                argv[argc++] = toJSString(result->str0);
+                break;
+            case CB_HANDLE_STRING_STRING_STRING:
+                argv[argc++] = Nan::New<v8::Number>(result->handle0);
+                argv[argc++] = toJSString(result->str0);
+                argv[argc++] = toJSString(result->str1);
+                argv[argc++] = toJSString(result->str2);
+                break;
+        }
+
+        v8::Local<v8::Object> target = Nan::New<v8::Object>();
+        v8::Local<v8::Function> fn = Nan::New(callback);
+        runInAsyncScope(target, fn, argc, argv);
+    }
+
+    inline static NAUV_WORK_CB(onMainLoopReentry) {
+        std::vector<VcxResult*> results;
+        {
+            std::lock_guard<std::mutex> lock(completedMutex);
+            results.swap(completed);
+        }
+
+        for(VcxResult* result : results){
+            Nan::HandleScope scope;
+            auto it = vcbmap.find(result->handle);
+            if(it != vcbmap.end()){
+                VcxCallback* vcb = it->second;
+                vcbmap.erase(it);
+                vcb->call(result);
+                delete vcb;
+            }
+            delete result;
+        }
+
+        updateLoopRef();
+    }
+};
+
+std::map<vcx_command_handle_t, VcxCallback*> VcxCallback::vcbmap;
+vcx_command_handle_t VcxCallback::next_handle = 0;
+uv_async_t VcxCallback::uvHandle;
+std::mutex VcxCallback::completedMutex;
+std::vector<VcxResult*> VcxCallback::completed;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Static callbacks passed to libvcx, one per result signature.
+//
+
+void cbNone(vcx_command_handle_t handle, vcx_error_t xerr){
+    VcxCallback::complete(new VcxResult(handle, xerr, CB_NONE));
+}
+
+void cbHandle(vcx_command_handle_t handle, vcx_error_t xerr, vcx_u32_t h){
+    VcxResult* result = new VcxResult(handle, xerr, CB_HANDLE);
+    result->handle0 = h;
+    VcxCallback::complete(result);
+}
+
+void cbString(vcx_command_handle_t handle, vcx_error_t xerr, const char* str){
+    VcxResult* result = new VcxResult(handle, xerr, CB_STRING);
+    result->str0 = copyCStr(str);
+    VcxCallback::complete(result);
+}
+
+void cbBoolean(vcx_command_handle_t handle, vcx_error_t xerr, bool b){
+    VcxResult* result = new VcxResult(handle, xerr, CB_BOOLEAN);
+    result->bool0 = b;
+    VcxCallback::complete(result);
+}
+
+void cbBuffer(vcx_command_handle_t handle, vcx_error_t xerr, const vcx_u8_t* data, vcx_u32_t len){
+    VcxResult* result = new VcxResult(handle, xerr, CB_BUFFER);
+    if(data != nullptr){
+        result->buffer0.assign(data, data + len);
+    }
+    result->buffer0len = len;
+    VcxCallback::complete(result);
+}
+
+void cbHandleString(vcx_command_handle_t handle, vcx_error_t xerr, vcx_u32_t h, const char* str){
+    VcxResult* result = new VcxResult(handle, xerr, CB_HANDLE_STRING);
+    result->handle0 = h;
+    result->str0 = copyCStr(str);
+    VcxCallback::complete(result);
+}
+
+void cbHandleStringStringString(vcx_command_handle_t handle, vcx_error_t xerr, vcx_u32_t h, const char* strA, const char* strB, const char* strC){
+    VcxResult* result = new VcxResult(handle, xerr, CB_HANDLE_STRING_STRING_STRING);
+    result->handle0 = h;
+    result->str0 = copyCStr(strA);
+    result->str1 = copyCStr(strB);
+    result->str2 = copyCStr(strC);
+    VcxCallback::complete(result);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Utils for asserting types and converting JS args to cpp values.
+//
+
+#define VCX_ASSERT_NARGS(FNAME, N) \
+  if(info.Length() != N){ \
+    return Nan::ThrowError(Nan::New(""#FNAME" expects "#N" arguments").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_STRING(FNAME, I, ARGNAME) \
+  if(!info[I]->IsString() && !info[I]->IsNull() && !info[I]->IsUndefined()){ \
+    return Nan::ThrowTypeError(Nan::New(""#FNAME" expects String or null for "#ARGNAME"").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_NUMBER(FNAME, I, ARGNAME) \
+  if(!info[I]->IsNumber()){ \
+    return Nan::ThrowTypeError(Nan::New(""#FNAME" expects Number for "#ARGNAME"").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_OBJECT(FNAME, I, ARGNAME) \
+  if(!info[I]->IsObject()){ \
+    return Nan::ThrowTypeError(Nan::New(""#FNAME" expects Object for "#ARGNAME"").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_BUFFER(FNAME, I, ARGNAME) \
+  if(!node::Buffer::HasInstance(info[I]) && !info[I]->IsNumber()){ \
+    return Nan::ThrowTypeError(Nan::New(""#FNAME" expects Buffer or address for "#ARGNAME"").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_FUNCTION(FNAME, I) \
+  if(!info[I]->IsFunction()){ \
+    return Nan::ThrowTypeError(Nan::New(""#FNAME" expects Function for arg "#I"").ToLocalChecked()); \
+  }
+
+#define VCX_ASSERT_LOADED(FNAME) \
+  if(FNAME##_fn == nullptr){ \
+    return Nan::ThrowError(Nan::New(""#FNAME" is called before libvcx is loaded").ToLocalChecked()); \
+  }
+
+/**
+ * String argument, null and undefined are passed to libvcx as NULL.
+ * libvcx copies strings before returning, so they live only for the call.
+ */
+class CStringArg {
+  public:
+    CStringArg(v8::Local<v8::Value> arg) : utf(arg), isString(arg->IsString()) {}
+
+    operator const char*() const {
+        return isString ? *utf : nullptr;
+    }
+
+  private:
+    Nan::Utf8String utf;
+    bool isString;
+};
+
+int32_t argToInt32(v8::Local<v8::Value> arg){
+  v8::Maybe<int32_t> v = arg->Int32Value(Nan::GetCurrentContext());
+  return v.FromJust();
+}
+
+uint32_t argToUInt32(v8::Local<v8::Value> arg){
+  v8::Maybe<uint32_t> v = arg->Uint32Value(Nan::GetCurrentContext());
+  return v.FromJust();
+}
+
+vcx_u64_t argToUInt64(v8::Local<v8::Value> arg){
+  return static_cast<vcx_u64_t>(Nan::To<int64_t>(arg).FromJust());
+}
+
+/**
+ * Buffer data, the wrapper may also pass the address of the data returned by ref.address().
+ */
+const vcx_u8_t* argToBufferData(v8::Local<v8::Value> arg){
+  if(node::Buffer::HasInstance(arg)){
+    return reinterpret_cast<const vcx_u8_t*>(node::Buffer::Data(arg));
+  }
+  return reinterpret_cast<const vcx_u8_t*>(static_cast<uintptr_t>(Nan::To<double>(arg).FromJust()));
+}
+
+VcxCallback* argToVcxCb(v8::Local<v8::Value> commandHandle, v8::Local<v8::Value> arg){
+  return new VcxCallback(argToUInt32(commandHandle), Nan::To<v8::Function>(arg).ToLocalChecked());
+}
+
+/**
+ * libvcx calls back only if it has accepted the call, so the callback of a rejected call is dropped.
+ * The error code is returned to JS as node-ffi does.
+ */
+void vcxCalled(VcxCallback* vcb, vcx_error_t res) {
+    if(res != 0) {
+        VcxCallback::cancel(vcb);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// libvcx functions, resolved by `load`.
+//
+
+typedef vcx_error_t (*vcx_init_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_init_t vcx_init_fn = nullptr;
+typedef vcx_error_t (*vcx_init_with_config_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_init_with_config_t vcx_init_with_config_fn = nullptr;
+typedef vcx_error_t (*vcx_init_minimal_t)(const char*);
+static vcx_init_minimal_t vcx_init_minimal_fn = nullptr;
+typedef vcx_error_t (*vcx_shutdown_t)(bool);
+static vcx_shutdown_t vcx_shutdown_fn = nullptr;
+typedef const char* (*vcx_error_c_message_t)(vcx_u32_t);
+static vcx_error_c_message_t vcx_error_c_message_fn = nullptr;
+typedef const char* (*vcx_version_t)();
+static vcx_version_t vcx_version_fn = nullptr;
+typedef vcx_error_t (*vcx_agent_provision_async_t)(vcx_command_handle_t, const char*, vcx_cb_string_t);
+static vcx_agent_provision_async_t vcx_agent_provision_async_fn = nullptr;
+typedef vcx_error_t (*vcx_agent_update_info_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_agent_update_info_t vcx_agent_update_info_fn = nullptr;
+typedef vcx_error_t (*vcx_update_institution_info_t)(const char*, const char*);
+static vcx_update_institution_info_t vcx_update_institution_info_fn = nullptr;
+typedef vcx_error_t (*vcx_update_webhook_url_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_update_webhook_url_t vcx_update_webhook_url_fn = nullptr;
+typedef void (*vcx_mint_tokens_t)(const char*, const char*);
+static vcx_mint_tokens_t vcx_mint_tokens_fn = nullptr;
+typedef vcx_error_t (*vcx_messages_download_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_string_t);
+static vcx_messages_download_t vcx_messages_download_fn = nullptr;
+typedef vcx_error_t (*vcx_messages_update_status_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_none_t);
+static vcx_messages_update_status_t vcx_messages_update_status_fn = nullptr;
+typedef vcx_error_t (*vcx_get_ledger_author_agreement_t)(vcx_command_handle_t, vcx_cb_string_t);
+static vcx_get_ledger_author_agreement_t vcx_get_ledger_author_agreement_fn = nullptr;
+typedef vcx_error_t (*vcx_set_active_txn_author_agreement_meta_t)(const char*, const char*, const char*, const char*, vcx_u64_t);
+static vcx_set_active_txn_author_agreement_meta_t vcx_set_active_txn_author_agreement_meta_fn = nullptr;
+typedef vcx_error_t (*vcx_endorse_transaction_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_endorse_transaction_t vcx_endorse_transaction_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_get_token_info_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_wallet_get_token_info_t vcx_wallet_get_token_info_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_create_payment_address_t)(vcx_command_handle_t, const char*, vcx_cb_string_t);
+static vcx_wallet_create_payment_address_t vcx_wallet_create_payment_address_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_sign_with_address_t)(vcx_command_handle_t, const char*, const vcx_u8_t*, vcx_u32_t, vcx_cb_buffer_t);
+static vcx_wallet_sign_with_address_t vcx_wallet_sign_with_address_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_verify_with_address_t)(vcx_command_handle_t, const char*, const vcx_u8_t*, vcx_u32_t, const vcx_u8_t*, vcx_u32_t, vcx_cb_boolean_t);
+static vcx_wallet_verify_with_address_t vcx_wallet_verify_with_address_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_send_tokens_t)(vcx_command_handle_t, vcx_u32_t, const char*, const char*, vcx_cb_string_t);
+static vcx_wallet_send_tokens_t vcx_wallet_send_tokens_fn = nullptr;
+typedef vcx_i32_t (*vcx_wallet_set_handle_t)(vcx_i32_t);
+static vcx_wallet_set_handle_t vcx_wallet_set_handle_fn = nullptr;
+typedef vcx_i32_t (*vcx_pool_set_handle_t)(vcx_i32_t);
+static vcx_pool_set_handle_t vcx_pool_set_handle_fn = nullptr;
+typedef vcx_error_t (*vcx_ledger_get_fees_t)(vcx_command_handle_t, vcx_cb_string_t);
+static vcx_ledger_get_fees_t vcx_ledger_get_fees_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_add_record_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_add_record_t vcx_wallet_add_record_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_update_record_value_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_update_record_value_t vcx_wallet_update_record_value_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_update_record_tags_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_update_record_tags_t vcx_wallet_update_record_tags_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_add_record_tags_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_add_record_tags_t vcx_wallet_add_record_tags_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_delete_record_tags_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_delete_record_tags_t vcx_wallet_delete_record_tags_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_delete_record_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_delete_record_t vcx_wallet_delete_record_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_get_record_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_string_t);
+static vcx_wallet_get_record_t vcx_wallet_get_record_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_open_search_t)(vcx_command_handle_t, const char*, const char*, const char*, vcx_cb_handle_t);
+static vcx_wallet_open_search_t vcx_wallet_open_search_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_close_search_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_wallet_close_search_t vcx_wallet_close_search_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_search_next_records_t)(vcx_command_handle_t, vcx_i32_t, size_t, vcx_cb_string_t);
+static vcx_wallet_search_next_records_t vcx_wallet_search_next_records_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_import_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_wallet_import_t vcx_wallet_import_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_export_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_none_t);
+static vcx_wallet_export_t vcx_wallet_export_fn = nullptr;
+typedef vcx_error_t (*vcx_wallet_validate_payment_address_t)(vcx_command_handle_t, const char*, vcx_cb_none_t);
+static vcx_wallet_validate_payment_address_t vcx_wallet_validate_payment_address_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_delete_connection_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_connection_delete_connection_t vcx_connection_delete_connection_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_connect_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_string_t);
+static vcx_connection_connect_t vcx_connection_connect_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_create_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_connection_create_t vcx_connection_create_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_create_with_invite_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_handle_t);
+static vcx_connection_create_with_invite_t vcx_connection_create_with_invite_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_connection_deserialize_t vcx_connection_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_release_t)(vcx_u32_t);
+static vcx_connection_release_t vcx_connection_release_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_connection_serialize_t vcx_connection_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_connection_update_state_t vcx_connection_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_update_state_with_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_handle_t);
+static vcx_connection_update_state_with_message_t vcx_connection_update_state_with_message_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_connection_get_state_t vcx_connection_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_invite_details_t)(vcx_command_handle_t, vcx_u32_t, bool, vcx_cb_string_t);
+static vcx_connection_invite_details_t vcx_connection_invite_details_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_send_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, const char*, vcx_cb_string_t);
+static vcx_connection_send_message_t vcx_connection_send_message_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_sign_data_t)(vcx_command_handle_t, vcx_u32_t, const vcx_u8_t*, vcx_u32_t, vcx_cb_buffer_t);
+static vcx_connection_sign_data_t vcx_connection_sign_data_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_verify_signature_t)(vcx_command_handle_t, vcx_u32_t, const vcx_u8_t*, vcx_u32_t, const vcx_u8_t*, vcx_u32_t, vcx_cb_boolean_t);
+static vcx_connection_verify_signature_t vcx_connection_verify_signature_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_send_ping_t)(vcx_u32_t, vcx_u32_t, const char*, vcx_cb_none_t);
+static vcx_connection_send_ping_t vcx_connection_send_ping_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_send_discovery_features_t)(vcx_u32_t, vcx_u32_t, const char*, const char*, vcx_cb_none_t);
+static vcx_connection_send_discovery_features_t vcx_connection_send_discovery_features_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_get_pw_did_t)(vcx_u32_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_connection_get_pw_did_t vcx_connection_get_pw_did_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_get_their_pw_did_t)(vcx_u32_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_connection_get_their_pw_did_t vcx_connection_get_their_pw_did_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_redirect_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_connection_redirect_t vcx_connection_redirect_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_get_redirect_details_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_connection_get_redirect_details_t vcx_connection_get_redirect_details_fn = nullptr;
+typedef vcx_error_t (*vcx_connection_info_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_connection_info_t vcx_connection_info_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_issuer_credential_deserialize_t vcx_issuer_credential_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_issuer_credential_serialize_t vcx_issuer_credential_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_issuer_credential_update_state_t vcx_issuer_credential_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_update_state_with_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_handle_t);
+static vcx_issuer_credential_update_state_with_message_t vcx_issuer_credential_update_state_with_message_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_issuer_credential_get_state_t vcx_issuer_credential_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_create_credential_t)(vcx_command_handle_t, const char*, vcx_u32_t, const char*, const char*, const char*, const char*, vcx_cb_handle_t);
+static vcx_issuer_create_credential_t vcx_issuer_create_credential_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_revoke_credential_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_issuer_revoke_credential_t vcx_issuer_revoke_credential_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_send_credential_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_issuer_send_credential_t vcx_issuer_send_credential_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_get_credential_msg_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_string_t);
+static vcx_issuer_get_credential_msg_t vcx_issuer_get_credential_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_send_credential_offer_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_issuer_send_credential_offer_t vcx_issuer_send_credential_offer_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_get_credential_offer_msg_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_issuer_get_credential_offer_msg_t vcx_issuer_get_credential_offer_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_release_t)(vcx_u32_t);
+static vcx_issuer_credential_release_t vcx_issuer_credential_release_fn = nullptr;
+typedef vcx_error_t (*vcx_issuer_credential_get_payment_txn_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_issuer_credential_get_payment_txn_t vcx_issuer_credential_get_payment_txn_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_create_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, const char*, vcx_cb_handle_t);
+static vcx_proof_create_t vcx_proof_create_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_proof_deserialize_t vcx_proof_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_get_proof_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_handle_string_t);
+static vcx_get_proof_t vcx_get_proof_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_release_t)(vcx_u32_t);
+static vcx_proof_release_t vcx_proof_release_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_send_request_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_proof_send_request_t vcx_proof_send_request_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_get_request_msg_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_proof_get_request_msg_t vcx_proof_get_request_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_proof_serialize_t vcx_proof_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_proof_update_state_t vcx_proof_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_update_state_with_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_handle_t);
+static vcx_proof_update_state_with_message_t vcx_proof_update_state_with_message_fn = nullptr;
+typedef vcx_error_t (*vcx_proof_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_proof_get_state_t vcx_proof_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_create_with_request_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_handle_t);
+static vcx_disclosed_proof_create_with_request_t vcx_disclosed_proof_create_with_request_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_create_with_msgid_t)(vcx_command_handle_t, const char*, vcx_u32_t, const char*, vcx_cb_handle_string_t);
+static vcx_disclosed_proof_create_with_msgid_t vcx_disclosed_proof_create_with_msgid_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_release_t)(vcx_u32_t);
+static vcx_disclosed_proof_release_t vcx_disclosed_proof_release_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_send_proof_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_disclosed_proof_send_proof_t vcx_disclosed_proof_send_proof_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_reject_proof_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_disclosed_proof_reject_proof_t vcx_disclosed_proof_reject_proof_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_get_proof_msg_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_disclosed_proof_get_proof_msg_t vcx_disclosed_proof_get_proof_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_get_reject_msg_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_disclosed_proof_get_reject_msg_t vcx_disclosed_proof_get_reject_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_disclosed_proof_serialize_t vcx_disclosed_proof_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_disclosed_proof_deserialize_t vcx_disclosed_proof_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_disclosed_proof_update_state_t vcx_disclosed_proof_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_update_state_with_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_handle_t);
+static vcx_disclosed_proof_update_state_with_message_t vcx_disclosed_proof_update_state_with_message_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_disclosed_proof_get_state_t vcx_disclosed_proof_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_get_requests_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_disclosed_proof_get_requests_t vcx_disclosed_proof_get_requests_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_retrieve_credentials_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_disclosed_proof_retrieve_credentials_t vcx_disclosed_proof_retrieve_credentials_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_generate_proof_t)(vcx_command_handle_t, vcx_u32_t, const char*, const char*, vcx_cb_none_t);
+static vcx_disclosed_proof_generate_proof_t vcx_disclosed_proof_generate_proof_fn = nullptr;
+typedef vcx_error_t (*vcx_disclosed_proof_decline_presentation_request_t)(vcx_u32_t, vcx_u32_t, vcx_u32_t, const char*, const char*, vcx_cb_none_t);
+static vcx_disclosed_proof_decline_presentation_request_t vcx_disclosed_proof_decline_presentation_request_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_create_with_offer_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_handle_t);
+static vcx_credential_create_with_offer_t vcx_credential_create_with_offer_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_create_with_msgid_t)(vcx_command_handle_t, const char*, vcx_u32_t, const char*, vcx_cb_handle_string_t);
+static vcx_credential_create_with_msgid_t vcx_credential_create_with_msgid_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_release_t)(vcx_u32_t);
+static vcx_credential_release_t vcx_credential_release_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_send_request_t)(vcx_command_handle_t, vcx_u32_t, vcx_u32_t, vcx_u32_t, vcx_cb_none_t);
+static vcx_credential_send_request_t vcx_credential_send_request_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_get_request_msg_t)(vcx_command_handle_t, vcx_u32_t, const char*, const char*, vcx_u32_t, vcx_cb_string_t);
+static vcx_credential_get_request_msg_t vcx_credential_get_request_msg_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credential_serialize_t vcx_credential_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_credential_deserialize_t vcx_credential_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_credential_update_state_t vcx_credential_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_update_state_with_message_t)(vcx_command_handle_t, vcx_u32_t, const char*, vcx_cb_handle_t);
+static vcx_credential_update_state_with_message_t vcx_credential_update_state_with_message_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_credential_get_state_t vcx_credential_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_get_offers_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credential_get_offers_t vcx_credential_get_offers_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_get_payment_info_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credential_get_payment_info_t vcx_credential_get_payment_info_fn = nullptr;
+typedef vcx_error_t (*vcx_credential_get_payment_txn_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credential_get_payment_txn_t vcx_credential_get_payment_txn_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_create_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, const char*, const char*, vcx_u32_t, vcx_cb_handle_t);
+static vcx_credentialdef_create_t vcx_credentialdef_create_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_prepare_for_endorser_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, const char*, const char*, const char*, vcx_cb_handle_string_string_string_t);
+static vcx_credentialdef_prepare_for_endorser_t vcx_credentialdef_prepare_for_endorser_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_credentialdef_deserialize_t vcx_credentialdef_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_release_t)(vcx_u32_t);
+static vcx_credentialdef_release_t vcx_credentialdef_release_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credentialdef_serialize_t vcx_credentialdef_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_get_cred_def_id_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credentialdef_get_cred_def_id_t vcx_credentialdef_get_cred_def_id_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_get_payment_txn_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_credentialdef_get_payment_txn_t vcx_credentialdef_get_payment_txn_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_credentialdef_update_state_t vcx_credentialdef_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_credentialdef_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_credentialdef_get_state_t vcx_credentialdef_get_state_fn = nullptr;
+typedef vcx_error_t (*vcx_set_default_logger_t)(const char*);
+static vcx_set_default_logger_t vcx_set_default_logger_fn = nullptr;
+typedef void (*vcx_set_next_agency_response_t)(vcx_u32_t);
+static vcx_set_next_agency_response_t vcx_set_next_agency_response_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_get_attributes_t)(vcx_command_handle_t, const char*, const char*, vcx_cb_handle_string_t);
+static vcx_schema_get_attributes_t vcx_schema_get_attributes_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_create_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, vcx_u32_t, vcx_cb_handle_t);
+static vcx_schema_create_t vcx_schema_create_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_prepare_for_endorser_t)(vcx_command_handle_t, const char*, const char*, const char*, const char*, const char*, vcx_cb_handle_string_t);
+static vcx_schema_prepare_for_endorser_t vcx_schema_prepare_for_endorser_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_get_schema_id_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_schema_get_schema_id_t vcx_schema_get_schema_id_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_deserialize_t)(vcx_command_handle_t, const char*, vcx_cb_handle_t);
+static vcx_schema_deserialize_t vcx_schema_deserialize_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_release_t)(vcx_u32_t);
+static vcx_schema_release_t vcx_schema_release_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_serialize_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_schema_serialize_t vcx_schema_serialize_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_get_payment_txn_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_string_t);
+static vcx_schema_get_payment_txn_t vcx_schema_get_payment_txn_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_update_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_schema_update_state_t vcx_schema_update_state_fn = nullptr;
+typedef vcx_error_t (*vcx_schema_get_state_t)(vcx_command_handle_t, vcx_u32_t, vcx_cb_handle_t);
+static vcx_schema_get_state_t vcx_schema_get_state_fn = nullptr;
+
+struct VcxSymbol {
+    const char* name;
+    void** fn;
+};
+
+static const VcxSymbol symbols[] = {
+    { "vcx_init", (void**) &vcx_init_fn },
+    { "vcx_init_with_config", (void**) &vcx_init_with_config_fn },
+    { "vcx_init_minimal", (void**) &vcx_init_minimal_fn },
+    { "vcx_shutdown", (void**) &vcx_shutdown_fn },
+    { "vcx_error_c_message", (void**) &vcx_error_c_message_fn },
+    { "vcx_version", (void**) &vcx_version_fn },
+    { "vcx_agent_provision_async", (void**) &vcx_agent_provision_async_fn },
+    { "vcx_agent_update_info", (void**) &vcx_agent_update_info_fn },
+    { "vcx_update_institution_info", (void**) &vcx_update_institution_info_fn },
+    { "vcx_update_webhook_url", (void**) &vcx_update_webhook_url_fn },
+    { "vcx_mint_tokens", (void**) &vcx_mint_tokens_fn },
+    { "vcx_messages_download", (void**) &vcx_messages_download_fn },
+    { "vcx_messages_update_status", (void**) &vcx_messages_update_status_fn },
+    { "vcx_get_ledger_author_agreement", (void**) &vcx_get_ledger_author_agreement_fn },
+    { "vcx_set_active_txn_author_agreement_meta", (void**) &vcx_set_active_txn_author_agreement_meta_fn },
+    { "vcx_endorse_transaction", (void**) &vcx_endorse_transaction_fn },
+    { "vcx_wallet_get_token_info", (void**) &vcx_wallet_get_token_info_fn },
+    { "vcx_wallet_create_payment_address", (void**) &vcx_wallet_create_payment_address_fn },
+    { "vcx_wallet_sign_with_address", (void**) &vcx_wallet_sign_with_address_fn },
+    { "vcx_wallet_verify_with_address", (void**) &vcx_wallet_verify_with_address_fn },
+    { "vcx_wallet_send_tokens", (void**) &vcx_wallet_send_tokens_fn },
+    { "vcx_wallet_set_handle", (void**) &vcx_wallet_set_handle_fn },
+    { "vcx_pool_set_handle", (void**) &vcx_pool_set_handle_fn },
+    { "vcx_ledger_get_fees", (void**) &vcx_ledger_get_fees_fn },
+    { "vcx_wallet_add_record", (void**) &vcx_wallet_add_record_fn },
+    { "vcx_wallet_update_record_value", (void**) &vcx_wallet_update_record_value_fn },
+    { "vcx_wallet_update_record_tags", (void**) &vcx_wallet_update_record_tags_fn },
+    { "vcx_wallet_add_record_tags", (void**) &vcx_wallet_add_record_tags_fn },
+    { "vcx_wallet_delete_record_tags", (void**) &vcx_wallet_delete_record_tags_fn },
+    { "vcx_wallet_delete_record", (void**) &vcx_wallet_delete_record_fn },
+    { "vcx_wallet_get_record", (void**) &vcx_wallet_get_record_fn },
+    { "vcx_wallet_open_search", (void**) &vcx_wallet_open_search_fn },
+    { "vcx_wallet_close_search", (void**) &vcx_wallet_close_search_fn },
+    { "vcx_wallet_search_next_records", (void**) &vcx_wallet_search_next_records_fn },
+    { "vcx_wallet_import", (void**) &vcx_wallet_import_fn },
+    { "vcx_wallet_export", (void**) &vcx_wallet_export_fn },
+    { "vcx_wallet_validate_payment_address", (void**) &vcx_wallet_validate_payment_address_fn },
+    { "vcx_connection_delete_connection", (void**) &vcx_connection_delete_connection_fn },
+    { "vcx_connection_connect", (void**) &vcx_connection_connect_fn },
+    { "vcx_connection_create", (void**) &vcx_connection_create_fn },
+    { "vcx_connection_create_with_invite", (void**) &vcx_connection_create_with_invite_fn },
+    { "vcx_connection_deserialize", (void**) &vcx_connection_deserialize_fn },
+    { "vcx_connection_release", (void**) &vcx_connection_release_fn },
+    { "vcx_connection_serialize", (void**) &vcx_connection_serialize_fn },
+    { "vcx_connection_update_state", (void**) &vcx_connection_update_state_fn },
+    { "vcx_connection_update_state_with_message", (void**) &vcx_connection_update_state_with_message_fn },
+    { "vcx_connection_get_state", (void**) &vcx_connection_get_state_fn },
+    { "vcx_connection_invite_details", (void**) &vcx_connection_invite_details_fn },
+    { "vcx_connection_send_message", (void**) &vcx_connection_send_message_fn },
+    { "vcx_connection_sign_data", (void**) &vcx_connection_sign_data_fn },
+    { "vcx_connection_verify_signature", (void**) &vcx_connection_verify_signature_fn },
+    { "vcx_connection_send_ping", (void**) &vcx_connection_send_ping_fn },
+    { "vcx_connection_send_discovery_features", (void**) &vcx_connection_send_discovery_features_fn },
+    { "vcx_connection_get_pw_did", (void**) &vcx_connection_get_pw_did_fn },
+    { "vcx_connection_get_their_pw_did", (void**) &vcx_connection_get_their_pw_did_fn },
+    { "vcx_connection_redirect", (void**) &vcx_connection_redirect_fn },
+    { "vcx_connection_get_redirect_details", (void**) &vcx_connection_get_redirect_details_fn },
+    { "vcx_connection_info", (void**) &vcx_connection_info_fn },
+    { "vcx_issuer_credential_deserialize", (void**) &vcx_issuer_credential_deserialize_fn },
+    { "vcx_issuer_credential_serialize", (void**) &vcx_issuer_credential_serialize_fn },
+    { "vcx_issuer_credential_update_state", (void**) &vcx_issuer_credential_update_state_fn },
+    { "vcx_issuer_credential_update_state_with_message", (void**) &vcx_issuer_credential_update_state_with_message_fn },
+    { "vcx_issuer_credential_get_state", (void**) &vcx_issuer_credential_get_state_fn },
+    { "vcx_issuer_create_credential", (void**) &vcx_issuer_create_credential_fn },
+    { "vcx_issuer_revoke_credential", (void**) &vcx_issuer_revoke_credential_fn },
+    { "vcx_issuer_send_credential", (void**) &vcx_issuer_send_credential_fn },
+    { "vcx_issuer_get_credential_msg", (void**) &vcx_issuer_get_credential_msg_fn },
+    { "vcx_issuer_send_credential_offer", (void**) &vcx_issuer_send_credential_offer_fn },
+    { "vcx_issuer_get_credential_offer_msg", (void**) &vcx_issuer_get_credential_offer_msg_fn },
+    { "vcx_issuer_credential_release", (void**) &vcx_issuer_credential_release_fn },
+    { "vcx_issuer_credential_get_payment_txn", (void**) &vcx_issuer_credential_get_payment_txn_fn },
+    { "vcx_proof_create", (void**) &vcx_proof_create_fn },
+    { "vcx_proof_deserialize", (void**) &vcx_proof_deserialize_fn },
+    { "vcx_get_proof", (void**) &vcx_get_proof_fn },
+    { "vcx_proof_release", (void**) &vcx_proof_release_fn },
+    { "vcx_proof_send_request", (void**) &vcx_proof_send_request_fn },
+    { "vcx_proof_get_request_msg", (void**) &vcx_proof_get_request_msg_fn },
+    { "vcx_proof_serialize", (void**) &vcx_proof_serialize_fn },
+    { "vcx_proof_update_state", (void**) &vcx_proof_update_state_fn },
+    { "vcx_proof_update_state_with_message", (void**) &vcx_proof_update_state_with_message_fn },
+    { "vcx_proof_get_state", (void**) &vcx_proof_get_state_fn },
+    { "vcx_disclosed_proof_create_with_request", (void**) &vcx_disclosed_proof_create_with_request_fn },
+    { "vcx_disclosed_proof_create_with_msgid", (void**) &vcx_disclosed_proof_create_with_msgid_fn },
+    { "vcx_disclosed_proof_release", (void**) &vcx_disclosed_proof_release_fn },
+    { "vcx_disclosed_proof_send_proof", (void**) &vcx_disclosed_proof_send_proof_fn },
+    { "vcx_disclosed_proof_reject_proof", (void**) &vcx_disclosed_proof_reject_proof_fn },
+    { "vcx_disclosed_proof_get_proof_msg", (void**) &vcx_disclosed_proof_get_proof_msg_fn },
+    { "vcx_disclosed_proof_get_reject_msg", (void**) &vcx_disclosed_proof_get_reject_msg_fn },
+    { "vcx_disclosed_proof_serialize", (void**) &vcx_disclosed_proof_serialize_fn },
+    { "vcx_disclosed_proof_deserialize", (void**) &vcx_disclosed_proof_deserialize_fn },
+    { "vcx_disclosed_proof_update_state", (void**) &vcx_disclosed_proof_update_state_fn },
+    { "vcx_disclosed_proof_update_state_with_message", (void**) &vcx_disclosed_proof_update_state_with_message_fn },
+    { "vcx_disclosed_proof_get_state", (void**) &vcx_disclosed_proof_get_state_fn },
+    { "vcx_disclosed_proof_get_requests", (void**) &vcx_disclosed_proof_get_requests_fn },
+    { "vcx_disclosed_proof_retrieve_credentials", (void**) &vcx_disclosed_proof_retrieve_credentials_fn },
+    { "vcx_disclosed_proof_generate_proof", (void**) &vcx_disclosed_proof_generate_proof_fn },
+    { "vcx_disclosed_proof_decline_presentation_request", (void**) &vcx_disclosed_proof_decline_presentation_request_fn },
+    { "vcx_credential_create_with_offer", (void**) &vcx_credential_create_with_offer_fn },
+    { "vcx_credential_create_with_msgid", (void**) &vcx_credential_create_with_msgid_fn },
+    { "vcx_credential_release", (void**) &vcx_credential_release_fn },
+    { "vcx_credential_send_request", (void**) &vcx_credential_send_request_fn },
+    { "vcx_credential_get_request_msg", (void**) &vcx_credential_get_request_msg_fn },
+    { "vcx_credential_serialize", (void**) &vcx_credential_serialize_fn },
+    { "vcx_credential_deserialize", (void**) &vcx_credential_deserialize_fn },
+    { "vcx_credential_update_state", (void**) &vcx_credential_update_state_fn },
+    { "vcx_credential_update_state_with_message", (void**) &vcx_credential_update_state_with_message_fn },
+    { "vcx_credential_get_state", (void**) &vcx_credential_get_state_fn },
+    { "vcx_credential_get_offers", (void**) &vcx_credential_get_offers_fn },
+    { "vcx_credential_get_payment_info", (void**) &vcx_credential_get_payment_info_fn },
+    { "vcx_credential_get_payment_txn", (void**) &vcx_credential_get_payment_txn_fn },
+    { "vcx_credentialdef_create", (void**) &vcx_credentialdef_create_fn },
+    { "vcx_credentialdef_prepare_for_endorser", (void**) &vcx_credentialdef_prepare_for_endorser_fn },
+    { "vcx_credentialdef_deserialize", (void**) &vcx_credentialdef_deserialize_fn },
+    { "vcx_credentialdef_release", (void**) &vcx_credentialdef_release_fn },
+    { "vcx_credentialdef_serialize", (void**) &vcx_credentialdef_serialize_fn },
+    { "vcx_credentialdef_get_cred_def_id", (void**) &vcx_credentialdef_get_cred_def_id_fn },
+    { "vcx_credentialdef_get_payment_txn", (void**) &vcx_credentialdef_get_payment_txn_fn },
+    { "vcx_credentialdef_update_state", (void**) &vcx_credentialdef_update_state_fn },
+    { "vcx_credentialdef_get_state", (void**) &vcx_credentialdef_get_state_fn },
+    { "vcx_set_default_logger", (void**) &vcx_set_default_logger_fn },
+    { "vcx_set_next_agency_response", (void**) &vcx_set_next_agency_response_fn },
+    { "vcx_schema_get_attributes", (void**) &vcx_schema_get_attributes_fn },
+    { "vcx_schema_create", (void**) &vcx_schema_create_fn },
+    { "vcx_schema_prepare_for_endorser", (void**) &vcx_schema_prepare_for_endorser_fn },
+    { "vcx_schema_get_schema_id", (void**) &vcx_schema_get_schema_id_fn },
+    { "vcx_schema_deserialize", (void**) &vcx_schema_deserialize_fn },
+    { "vcx_schema_release", (void**) &vcx_schema_release_fn },
+    { "vcx_schema_serialize", (void**) &vcx_schema_serialize_fn },
+    { "vcx_schema_get_payment_txn", (void**) &vcx_schema_get_payment_txn_fn },
+    { "vcx_schema_update_state", (void**) &vcx_schema_update_state_fn },
+    { "vcx_schema_get_state", (void**) &vcx_schema_get_state_fn },
+};
+
+static const size_t symbolsCount = sizeof(symbols) / sizeof(symbols[0]);
+
+typedef vcx_error_t (*vcx_release_t)(vcx_u32_t);
+
+struct VcxReleaseFn {
+    const char* name;
+    vcx_release_t* fn;
+};
+
+static const VcxReleaseFn releaseFns[] = {
+    { "vcx_connection_release", &vcx_connection_release_fn },
+    { "vcx_issuer_credential_release", &vcx_issuer_credential_release_fn },
+    { "vcx_proof_release", &vcx_proof_release_fn },
+    { "vcx_disclosed_proof_release", &vcx_disclosed_proof_release_fn },
+    { "vcx_credential_release", &vcx_credential_release_fn },
+    { "vcx_credentialdef_release", &vcx_credentialdef_release_fn },
+    { "vcx_schema_release", &vcx_schema_release_fn },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Below are wrappers for each libvcx function call. They take the same arguments as the
+// node-ffi functions, but callbacks are plain JS functions.
+//
+
+NAN_METHOD(vcxInit) {
+  VCX_ASSERT_NARGS(vcx_init, 3)
+  VCX_ASSERT_NUMBER(vcx_init, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_init, 1, configPath)
+  VCX_ASSERT_FUNCTION(vcx_init, 2)
+  VCX_ASSERT_LOADED(vcx_init)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_init_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxInitWithConfig) {
+  VCX_ASSERT_NARGS(vcx_init_with_config, 3)
+  VCX_ASSERT_NUMBER(vcx_init_with_config, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_init_with_config, 1, config)
+  VCX_ASSERT_FUNCTION(vcx_init_with_config, 2)
+  VCX_ASSERT_LOADED(vcx_init_with_config)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_init_with_config_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxInitMinimal) {
+  VCX_ASSERT_NARGS(vcx_init_minimal, 1)
+  VCX_ASSERT_STRING(vcx_init_minimal, 0, config)
+  VCX_ASSERT_LOADED(vcx_init_minimal)
+  CStringArg arg0(info[0]);
+  info.GetReturnValue().Set(vcx_init_minimal_fn(arg0));
+}
+
+NAN_METHOD(vcxShutdown) {
+  VCX_ASSERT_NARGS(vcx_shutdown, 1)
+  VCX_ASSERT_LOADED(vcx_shutdown)
+  info.GetReturnValue().Set(vcx_shutdown_fn(Nan::To<bool>(info[0]).FromJust()));
+}
+
+NAN_METHOD(vcxErrorCMessage) {
+  VCX_ASSERT_NARGS(vcx_error_c_message, 1)
+  VCX_ASSERT_NUMBER(vcx_error_c_message, 0, errorCode)
+  VCX_ASSERT_LOADED(vcx_error_c_message)
+  info.GetReturnValue().Set(toJSString(vcx_error_c_message_fn(argToUInt32(info[0]))));
+}
+
+NAN_METHOD(vcxVersion) {
+  VCX_ASSERT_NARGS(vcx_version, 0)
+  VCX_ASSERT_LOADED(vcx_version)
+  info.GetReturnValue().Set(toJSString(vcx_version_fn()));
+}
+
+NAN_METHOD(vcxAgentProvisionAsync) {
+  VCX_ASSERT_NARGS(vcx_agent_provision_async, 3)
+  VCX_ASSERT_NUMBER(vcx_agent_provision_async, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_agent_provision_async, 1, config)
+  VCX_ASSERT_FUNCTION(vcx_agent_provision_async, 2)
+  VCX_ASSERT_LOADED(vcx_agent_provision_async)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_agent_provision_async_fn(vcb->handle, arg1, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxAgentUpdateInfo) {
+  VCX_ASSERT_NARGS(vcx_agent_update_info, 3)
+  VCX_ASSERT_NUMBER(vcx_agent_update_info, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_agent_update_info, 1, json)
+  VCX_ASSERT_FUNCTION(vcx_agent_update_info, 2)
+  VCX_ASSERT_LOADED(vcx_agent_update_info)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_agent_update_info_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxUpdateInstitutionInfo) {
+  VCX_ASSERT_NARGS(vcx_update_institution_info, 2)
+  VCX_ASSERT_STRING(vcx_update_institution_info, 0, name)
+  VCX_ASSERT_STRING(vcx_update_institution_info, 1, logoUrl)
+  VCX_ASSERT_LOADED(vcx_update_institution_info)
+  CStringArg arg0(info[0]);
+  CStringArg arg1(info[1]);
+  info.GetReturnValue().Set(vcx_update_institution_info_fn(arg0, arg1));
+}
+
+NAN_METHOD(vcxUpdateWebhookUrl) {
+  VCX_ASSERT_NARGS(vcx_update_webhook_url, 3)
+  VCX_ASSERT_NUMBER(vcx_update_webhook_url, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_update_webhook_url, 1, notificationWebhookUrl)
+  VCX_ASSERT_FUNCTION(vcx_update_webhook_url, 2)
+  VCX_ASSERT_LOADED(vcx_update_webhook_url)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_update_webhook_url_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxMintTokens) {
+  VCX_ASSERT_NARGS(vcx_mint_tokens, 2)
+  VCX_ASSERT_STRING(vcx_mint_tokens, 0, seed)
+  VCX_ASSERT_STRING(vcx_mint_tokens, 1, fees)
+  VCX_ASSERT_LOADED(vcx_mint_tokens)
+  CStringArg arg0(info[0]);
+  CStringArg arg1(info[1]);
+  vcx_mint_tokens_fn(arg0, arg1);
+}
+
+NAN_METHOD(vcxMessagesDownload) {
+  VCX_ASSERT_NARGS(vcx_messages_download, 5)
+  VCX_ASSERT_NUMBER(vcx_messages_download, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_messages_download, 1, messageStatus)
+  VCX_ASSERT_STRING(vcx_messages_download, 2, uids)
+  VCX_ASSERT_STRING(vcx_messages_download, 3, pwDids)
+  VCX_ASSERT_FUNCTION(vcx_messages_download, 4)
+  VCX_ASSERT_LOADED(vcx_messages_download)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_messages_download_fn(vcb->handle, arg1, arg2, arg3, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxMessagesUpdateStatus) {
+  VCX_ASSERT_NARGS(vcx_messages_update_status, 4)
+  VCX_ASSERT_NUMBER(vcx_messages_update_status, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_messages_update_status, 1, messageStatus)
+  VCX_ASSERT_STRING(vcx_messages_update_status, 2, msgJson)
+  VCX_ASSERT_FUNCTION(vcx_messages_update_status, 3)
+  VCX_ASSERT_LOADED(vcx_messages_update_status)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_messages_update_status_fn(vcb->handle, arg1, arg2, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxGetLedgerAuthorAgreement) {
+  VCX_ASSERT_NARGS(vcx_get_ledger_author_agreement, 2)
+  VCX_ASSERT_NUMBER(vcx_get_ledger_author_agreement, 0, commandHandle)
+  VCX_ASSERT_FUNCTION(vcx_get_ledger_author_agreement, 1)
+  VCX_ASSERT_LOADED(vcx_get_ledger_author_agreement)
+  VcxCallback* vcb = argToVcxCb(info[0], info[1]);
+  vcx_error_t res = vcx_get_ledger_author_agreement_fn(vcb->handle, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSetActiveTxnAuthorAgreementMeta) {
+  VCX_ASSERT_NARGS(vcx_set_active_txn_author_agreement_meta, 5)
+  VCX_ASSERT_STRING(vcx_set_active_txn_author_agreement_meta, 0, text)
+  VCX_ASSERT_STRING(vcx_set_active_txn_author_agreement_meta, 1, version)
+  VCX_ASSERT_STRING(vcx_set_active_txn_author_agreement_meta, 2, hash)
+  VCX_ASSERT_STRING(vcx_set_active_txn_author_agreement_meta, 3, accMechType)
+  VCX_ASSERT_NUMBER(vcx_set_active_txn_author_agreement_meta, 4, timeOfAcceptance)
+  VCX_ASSERT_LOADED(vcx_set_active_txn_author_agreement_meta)
+  CStringArg arg0(info[0]);
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  info.GetReturnValue().Set(vcx_set_active_txn_author_agreement_meta_fn(arg0, arg1, arg2, arg3, argToUInt64(info[4])));
+}
+
+NAN_METHOD(vcxEndorseTransaction) {
+  VCX_ASSERT_NARGS(vcx_endorse_transaction, 3)
+  VCX_ASSERT_NUMBER(vcx_endorse_transaction, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_endorse_transaction, 1, transaction)
+  VCX_ASSERT_FUNCTION(vcx_endorse_transaction, 2)
+  VCX_ASSERT_LOADED(vcx_endorse_transaction)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_endorse_transaction_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletGetTokenInfo) {
+  VCX_ASSERT_NARGS(vcx_wallet_get_token_info, 3)
+  VCX_ASSERT_NUMBER(vcx_wallet_get_token_info, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_wallet_get_token_info, 1, paymentHandle)
+  VCX_ASSERT_FUNCTION(vcx_wallet_get_token_info, 2)
+  VCX_ASSERT_LOADED(vcx_wallet_get_token_info)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_wallet_get_token_info_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletCreatePaymentAddress) {
+  VCX_ASSERT_NARGS(vcx_wallet_create_payment_address, 3)
+  VCX_ASSERT_NUMBER(vcx_wallet_create_payment_address, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_create_payment_address, 1, seed)
+  VCX_ASSERT_FUNCTION(vcx_wallet_create_payment_address, 2)
+  VCX_ASSERT_LOADED(vcx_wallet_create_payment_address)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_wallet_create_payment_address_fn(vcb->handle, arg1, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletSignWithAddress) {
+  VCX_ASSERT_NARGS(vcx_wallet_sign_with_address, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_sign_with_address, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_sign_with_address, 1, paymentAddress)
+  VCX_ASSERT_BUFFER(vcx_wallet_sign_with_address, 2, messageRaw)
+  VCX_ASSERT_NUMBER(vcx_wallet_sign_with_address, 3, messageLen)
+  VCX_ASSERT_FUNCTION(vcx_wallet_sign_with_address, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_sign_with_address)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_sign_with_address_fn(vcb->handle, arg1, argToBufferData(info[2]), argToUInt32(info[3]), cbBuffer);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletVerifyWithAddress) {
+  VCX_ASSERT_NARGS(vcx_wallet_verify_with_address, 7)
+  VCX_ASSERT_NUMBER(vcx_wallet_verify_with_address, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_verify_with_address, 1, paymentAddress)
+  VCX_ASSERT_BUFFER(vcx_wallet_verify_with_address, 2, messageRaw)
+  VCX_ASSERT_NUMBER(vcx_wallet_verify_with_address, 3, messageLen)
+  VCX_ASSERT_BUFFER(vcx_wallet_verify_with_address, 4, signatureRaw)
+  VCX_ASSERT_NUMBER(vcx_wallet_verify_with_address, 5, signatureLen)
+  VCX_ASSERT_FUNCTION(vcx_wallet_verify_with_address, 6)
+  VCX_ASSERT_LOADED(vcx_wallet_verify_with_address)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[6]);
+  vcx_error_t res = vcx_wallet_verify_with_address_fn(vcb->handle, arg1, argToBufferData(info[2]), argToUInt32(info[3]), argToBufferData(info[4]), argToUInt32(info[5]), cbBoolean);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletSendTokens) {
+  VCX_ASSERT_NARGS(vcx_wallet_send_tokens, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_send_tokens, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_wallet_send_tokens, 1, paymentHandle)
+  VCX_ASSERT_STRING(vcx_wallet_send_tokens, 2, tokens)
+  VCX_ASSERT_STRING(vcx_wallet_send_tokens, 3, recipient)
+  VCX_ASSERT_FUNCTION(vcx_wallet_send_tokens, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_send_tokens)
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_send_tokens_fn(vcb->handle, argToUInt32(info[1]), arg2, arg3, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletSetHandle) {
+  VCX_ASSERT_NARGS(vcx_wallet_set_handle, 1)
+  VCX_ASSERT_NUMBER(vcx_wallet_set_handle, 0, handle)
+  VCX_ASSERT_LOADED(vcx_wallet_set_handle)
+  info.GetReturnValue().Set(vcx_wallet_set_handle_fn(argToInt32(info[0])));
+}
+
+NAN_METHOD(vcxPoolSetHandle) {
+  VCX_ASSERT_NARGS(vcx_pool_set_handle, 1)
+  VCX_ASSERT_NUMBER(vcx_pool_set_handle, 0, handle)
+  VCX_ASSERT_LOADED(vcx_pool_set_handle)
+  info.GetReturnValue().Set(vcx_pool_set_handle_fn(argToInt32(info[0])));
+}
+
+NAN_METHOD(vcxLedgerGetFees) {
+  VCX_ASSERT_NARGS(vcx_ledger_get_fees, 2)
+  VCX_ASSERT_NUMBER(vcx_ledger_get_fees, 0, commandHandle)
+  VCX_ASSERT_FUNCTION(vcx_ledger_get_fees, 1)
+  VCX_ASSERT_LOADED(vcx_ledger_get_fees)
+  VcxCallback* vcb = argToVcxCb(info[0], info[1]);
+  vcx_error_t res = vcx_ledger_get_fees_fn(vcb->handle, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletAddRecord) {
+  VCX_ASSERT_NARGS(vcx_wallet_add_record, 6)
+  VCX_ASSERT_NUMBER(vcx_wallet_add_record, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_add_record, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_add_record, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_add_record, 3, value)
+  VCX_ASSERT_STRING(vcx_wallet_add_record, 4, tagsJson)
+  VCX_ASSERT_FUNCTION(vcx_wallet_add_record, 5)
+  VCX_ASSERT_LOADED(vcx_wallet_add_record)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[5]);
+  vcx_error_t res = vcx_wallet_add_record_fn(vcb->handle, arg1, arg2, arg3, arg4, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletUpdateRecordValue) {
+  VCX_ASSERT_NARGS(vcx_wallet_update_record_value, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_update_record_value, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_value, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_value, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_value, 3, value)
+  VCX_ASSERT_FUNCTION(vcx_wallet_update_record_value, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_update_record_value)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_update_record_value_fn(vcb->handle, arg1, arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletUpdateRecordTags) {
+  VCX_ASSERT_NARGS(vcx_wallet_update_record_tags, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_update_record_tags, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_tags, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_tags, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_update_record_tags, 3, tags)
+  VCX_ASSERT_FUNCTION(vcx_wallet_update_record_tags, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_update_record_tags)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_update_record_tags_fn(vcb->handle, arg1, arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletAddRecordTags) {
+  VCX_ASSERT_NARGS(vcx_wallet_add_record_tags, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_add_record_tags, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_add_record_tags, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_add_record_tags, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_add_record_tags, 3, tags)
+  VCX_ASSERT_FUNCTION(vcx_wallet_add_record_tags, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_add_record_tags)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_add_record_tags_fn(vcb->handle, arg1, arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletDeleteRecordTags) {
+  VCX_ASSERT_NARGS(vcx_wallet_delete_record_tags, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_delete_record_tags, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_delete_record_tags, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_delete_record_tags, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_delete_record_tags, 3, tags)
+  VCX_ASSERT_FUNCTION(vcx_wallet_delete_record_tags, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_delete_record_tags)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_delete_record_tags_fn(vcb->handle, arg1, arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletDeleteRecord) {
+  VCX_ASSERT_NARGS(vcx_wallet_delete_record, 4)
+  VCX_ASSERT_NUMBER(vcx_wallet_delete_record, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_delete_record, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_delete_record, 2, id)
+  VCX_ASSERT_FUNCTION(vcx_wallet_delete_record, 3)
+  VCX_ASSERT_LOADED(vcx_wallet_delete_record)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_wallet_delete_record_fn(vcb->handle, arg1, arg2, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletGetRecord) {
+  VCX_ASSERT_NARGS(vcx_wallet_get_record, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_get_record, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_get_record, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_get_record, 2, id)
+  VCX_ASSERT_STRING(vcx_wallet_get_record, 3, optionsJson)
+  VCX_ASSERT_FUNCTION(vcx_wallet_get_record, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_get_record)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_get_record_fn(vcb->handle, arg1, arg2, arg3, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletOpenSearch) {
+  VCX_ASSERT_NARGS(vcx_wallet_open_search, 5)
+  VCX_ASSERT_NUMBER(vcx_wallet_open_search, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_open_search, 1, type)
+  VCX_ASSERT_STRING(vcx_wallet_open_search, 2, queryJson)
+  VCX_ASSERT_STRING(vcx_wallet_open_search, 3, optionsJson)
+  VCX_ASSERT_FUNCTION(vcx_wallet_open_search, 4)
+  VCX_ASSERT_LOADED(vcx_wallet_open_search)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_wallet_open_search_fn(vcb->handle, arg1, arg2, arg3, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletCloseSearch) {
+  VCX_ASSERT_NARGS(vcx_wallet_close_search, 3)
+  VCX_ASSERT_NUMBER(vcx_wallet_close_search, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_wallet_close_search, 1, searchHandle)
+  VCX_ASSERT_FUNCTION(vcx_wallet_close_search, 2)
+  VCX_ASSERT_LOADED(vcx_wallet_close_search)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_wallet_close_search_fn(vcb->handle, argToUInt32(info[1]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletSearchNextRecords) {
+  VCX_ASSERT_NARGS(vcx_wallet_search_next_records, 4)
+  VCX_ASSERT_NUMBER(vcx_wallet_search_next_records, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_wallet_search_next_records, 1, walletSearchHandle)
+  VCX_ASSERT_NUMBER(vcx_wallet_search_next_records, 2, count)
+  VCX_ASSERT_FUNCTION(vcx_wallet_search_next_records, 3)
+  VCX_ASSERT_LOADED(vcx_wallet_search_next_records)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_wallet_search_next_records_fn(vcb->handle, argToInt32(info[1]), (size_t) argToUInt32(info[2]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletImport) {
+  VCX_ASSERT_NARGS(vcx_wallet_import, 3)
+  VCX_ASSERT_NUMBER(vcx_wallet_import, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_import, 1, config)
+  VCX_ASSERT_FUNCTION(vcx_wallet_import, 2)
+  VCX_ASSERT_LOADED(vcx_wallet_import)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_wallet_import_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletExport) {
+  VCX_ASSERT_NARGS(vcx_wallet_export, 4)
+  VCX_ASSERT_NUMBER(vcx_wallet_export, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_export, 1, path)
+  VCX_ASSERT_STRING(vcx_wallet_export, 2, backupKey)
+  VCX_ASSERT_FUNCTION(vcx_wallet_export, 3)
+  VCX_ASSERT_LOADED(vcx_wallet_export)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_wallet_export_fn(vcb->handle, arg1, arg2, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxWalletValidatePaymentAddress) {
+  VCX_ASSERT_NARGS(vcx_wallet_validate_payment_address, 3)
+  VCX_ASSERT_NUMBER(vcx_wallet_validate_payment_address, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_wallet_validate_payment_address, 1, paymentAddress)
+  VCX_ASSERT_FUNCTION(vcx_wallet_validate_payment_address, 2)
+  VCX_ASSERT_LOADED(vcx_wallet_validate_payment_address)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_wallet_validate_payment_address_fn(vcb->handle, arg1, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionDeleteConnection) {
+  VCX_ASSERT_NARGS(vcx_connection_delete_connection, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_delete_connection, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_delete_connection, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_delete_connection, 2)
+  VCX_ASSERT_LOADED(vcx_connection_delete_connection)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_delete_connection_fn(vcb->handle, argToUInt32(info[1]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionConnect) {
+  VCX_ASSERT_NARGS(vcx_connection_connect, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_connect, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_connect, 1, connectionHandle)
+  VCX_ASSERT_STRING(vcx_connection_connect, 2, connectionOptions)
+  VCX_ASSERT_FUNCTION(vcx_connection_connect, 3)
+  VCX_ASSERT_LOADED(vcx_connection_connect)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_connect_fn(vcb->handle, argToUInt32(info[1]), arg2, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionCreate) {
+  VCX_ASSERT_NARGS(vcx_connection_create, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_create, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_connection_create, 1, sourceId)
+  VCX_ASSERT_FUNCTION(vcx_connection_create, 2)
+  VCX_ASSERT_LOADED(vcx_connection_create)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_create_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionCreateWithInvite) {
+  VCX_ASSERT_NARGS(vcx_connection_create_with_invite, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_create_with_invite, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_connection_create_with_invite, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_connection_create_with_invite, 2, inviteDetails)
+  VCX_ASSERT_FUNCTION(vcx_connection_create_with_invite, 3)
+  VCX_ASSERT_LOADED(vcx_connection_create_with_invite)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_create_with_invite_fn(vcb->handle, arg1, arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionDeserialize) {
+  VCX_ASSERT_NARGS(vcx_connection_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_connection_deserialize, 1, connectionData)
+  VCX_ASSERT_FUNCTION(vcx_connection_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_connection_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionRelease) {
+  VCX_ASSERT_NARGS(vcx_connection_release, 1)
+  VCX_ASSERT_NUMBER(vcx_connection_release, 0, connectionHandle)
+  VCX_ASSERT_LOADED(vcx_connection_release)
+  info.GetReturnValue().Set(vcx_connection_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxConnectionSerialize) {
+  VCX_ASSERT_NARGS(vcx_connection_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_serialize, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_connection_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionUpdateState) {
+  VCX_ASSERT_NARGS(vcx_connection_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_update_state, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_connection_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionUpdateStateWithMessage) {
+  VCX_ASSERT_NARGS(vcx_connection_update_state_with_message, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_update_state_with_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_update_state_with_message, 1, connectionHandle)
+  VCX_ASSERT_STRING(vcx_connection_update_state_with_message, 2, message)
+  VCX_ASSERT_FUNCTION(vcx_connection_update_state_with_message, 3)
+  VCX_ASSERT_LOADED(vcx_connection_update_state_with_message)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_update_state_with_message_fn(vcb->handle, argToUInt32(info[1]), arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionGetState) {
+  VCX_ASSERT_NARGS(vcx_connection_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_get_state, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_connection_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionInviteDetails) {
+  VCX_ASSERT_NARGS(vcx_connection_invite_details, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_invite_details, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_invite_details, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_invite_details, 3)
+  VCX_ASSERT_LOADED(vcx_connection_invite_details)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_invite_details_fn(vcb->handle, argToUInt32(info[1]), Nan::To<bool>(info[2]).FromJust(), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionSendMessage) {
+  VCX_ASSERT_NARGS(vcx_connection_send_message, 5)
+  VCX_ASSERT_NUMBER(vcx_connection_send_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_send_message, 1, connectionHandle)
+  VCX_ASSERT_STRING(vcx_connection_send_message, 2, msg)
+  VCX_ASSERT_STRING(vcx_connection_send_message, 3, sendMsgOptions)
+  VCX_ASSERT_FUNCTION(vcx_connection_send_message, 4)
+  VCX_ASSERT_LOADED(vcx_connection_send_message)
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_connection_send_message_fn(vcb->handle, argToUInt32(info[1]), arg2, arg3, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionSignData) {
+  VCX_ASSERT_NARGS(vcx_connection_sign_data, 5)
+  VCX_ASSERT_NUMBER(vcx_connection_sign_data, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_sign_data, 1, connectionHandle)
+  VCX_ASSERT_BUFFER(vcx_connection_sign_data, 2, dataRaw)
+  VCX_ASSERT_NUMBER(vcx_connection_sign_data, 3, dataLen)
+  VCX_ASSERT_FUNCTION(vcx_connection_sign_data, 4)
+  VCX_ASSERT_LOADED(vcx_connection_sign_data)
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_connection_sign_data_fn(vcb->handle, argToUInt32(info[1]), argToBufferData(info[2]), argToUInt32(info[3]), cbBuffer);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionVerifySignature) {
+  VCX_ASSERT_NARGS(vcx_connection_verify_signature, 7)
+  VCX_ASSERT_NUMBER(vcx_connection_verify_signature, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_verify_signature, 1, connectionHandle)
+  VCX_ASSERT_BUFFER(vcx_connection_verify_signature, 2, dataRaw)
+  VCX_ASSERT_NUMBER(vcx_connection_verify_signature, 3, dataLen)
+  VCX_ASSERT_BUFFER(vcx_connection_verify_signature, 4, signatureRaw)
+  VCX_ASSERT_NUMBER(vcx_connection_verify_signature, 5, signatureLen)
+  VCX_ASSERT_FUNCTION(vcx_connection_verify_signature, 6)
+  VCX_ASSERT_LOADED(vcx_connection_verify_signature)
+  VcxCallback* vcb = argToVcxCb(info[0], info[6]);
+  vcx_error_t res = vcx_connection_verify_signature_fn(vcb->handle, argToUInt32(info[1]), argToBufferData(info[2]), argToUInt32(info[3]), argToBufferData(info[4]), argToUInt32(info[5]), cbBoolean);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionSendPing) {
+  VCX_ASSERT_NARGS(vcx_connection_send_ping, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_send_ping, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_send_ping, 1, connectionHandle)
+  VCX_ASSERT_STRING(vcx_connection_send_ping, 2, comment)
+  VCX_ASSERT_FUNCTION(vcx_connection_send_ping, 3)
+  VCX_ASSERT_LOADED(vcx_connection_send_ping)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_send_ping_fn(vcb->handle, argToUInt32(info[1]), arg2, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionSendDiscoveryFeatures) {
+  VCX_ASSERT_NARGS(vcx_connection_send_discovery_features, 5)
+  VCX_ASSERT_NUMBER(vcx_connection_send_discovery_features, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_send_discovery_features, 1, connectionHandle)
+  VCX_ASSERT_STRING(vcx_connection_send_discovery_features, 2, query)
+  VCX_ASSERT_STRING(vcx_connection_send_discovery_features, 3, comment)
+  VCX_ASSERT_FUNCTION(vcx_connection_send_discovery_features, 4)
+  VCX_ASSERT_LOADED(vcx_connection_send_discovery_features)
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_connection_send_discovery_features_fn(vcb->handle, argToUInt32(info[1]), arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionGetPwDid) {
+  VCX_ASSERT_NARGS(vcx_connection_get_pw_did, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_get_pw_did, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_get_pw_did, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_get_pw_did, 2)
+  VCX_ASSERT_LOADED(vcx_connection_get_pw_did)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_get_pw_did_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionGetTheirPwDid) {
+  VCX_ASSERT_NARGS(vcx_connection_get_their_pw_did, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_get_their_pw_did, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_get_their_pw_did, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_get_their_pw_did, 2)
+  VCX_ASSERT_LOADED(vcx_connection_get_their_pw_did)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_get_their_pw_did_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionRedirect) {
+  VCX_ASSERT_NARGS(vcx_connection_redirect, 4)
+  VCX_ASSERT_NUMBER(vcx_connection_redirect, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_redirect, 1, connectionHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_redirect, 2, redirectConnectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_redirect, 3)
+  VCX_ASSERT_LOADED(vcx_connection_redirect)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_connection_redirect_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionGetRedirectDetails) {
+  VCX_ASSERT_NARGS(vcx_connection_get_redirect_details, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_get_redirect_details, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_get_redirect_details, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_get_redirect_details, 2)
+  VCX_ASSERT_LOADED(vcx_connection_get_redirect_details)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_get_redirect_details_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxConnectionInfo) {
+  VCX_ASSERT_NARGS(vcx_connection_info, 3)
+  VCX_ASSERT_NUMBER(vcx_connection_info, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_connection_info, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_connection_info, 2)
+  VCX_ASSERT_LOADED(vcx_connection_info)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_connection_info_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialDeserialize) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_issuer_credential_deserialize, 1, credentialData)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_credential_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialSerialize) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_serialize, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_credential_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialUpdateState) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_update_state, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_credential_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialUpdateStateWithMessage) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_update_state_with_message, 4)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_update_state_with_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_update_state_with_message, 1, credentialHandle)
+  VCX_ASSERT_STRING(vcx_issuer_credential_update_state_with_message, 2, message)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_update_state_with_message, 3)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_update_state_with_message)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_issuer_credential_update_state_with_message_fn(vcb->handle, argToUInt32(info[1]), arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialGetState) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_get_state, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_credential_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCreateCredential) {
+  VCX_ASSERT_NARGS(vcx_issuer_create_credential, 8)
+  VCX_ASSERT_NUMBER(vcx_issuer_create_credential, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_issuer_create_credential, 1, sourceId)
+  VCX_ASSERT_NUMBER(vcx_issuer_create_credential, 2, credDefHandle)
+  VCX_ASSERT_STRING(vcx_issuer_create_credential, 3, issuerDid)
+  VCX_ASSERT_STRING(vcx_issuer_create_credential, 4, credentialData)
+  VCX_ASSERT_STRING(vcx_issuer_create_credential, 5, credentialName)
+  VCX_ASSERT_STRING(vcx_issuer_create_credential, 6, price)
+  VCX_ASSERT_FUNCTION(vcx_issuer_create_credential, 7)
+  VCX_ASSERT_LOADED(vcx_issuer_create_credential)
+  CStringArg arg1(info[1]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  CStringArg arg5(info[5]);
+  CStringArg arg6(info[6]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[7]);
+  vcx_error_t res = vcx_issuer_create_credential_fn(vcb->handle, arg1, argToUInt32(info[2]), arg3, arg4, arg5, arg6, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerRevokeCredential) {
+  VCX_ASSERT_NARGS(vcx_issuer_revoke_credential, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_revoke_credential, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_revoke_credential, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_revoke_credential, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_revoke_credential)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_revoke_credential_fn(vcb->handle, argToUInt32(info[1]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerSendCredential) {
+  VCX_ASSERT_NARGS(vcx_issuer_send_credential, 4)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential, 1, credentialHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential, 2, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_send_credential, 3)
+  VCX_ASSERT_LOADED(vcx_issuer_send_credential)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_issuer_send_credential_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerGetCredentialMsg) {
+  VCX_ASSERT_NARGS(vcx_issuer_get_credential_msg, 4)
+  VCX_ASSERT_NUMBER(vcx_issuer_get_credential_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_get_credential_msg, 1, credentialHandle)
+  VCX_ASSERT_STRING(vcx_issuer_get_credential_msg, 2, myPwDid)
+  VCX_ASSERT_FUNCTION(vcx_issuer_get_credential_msg, 3)
+  VCX_ASSERT_LOADED(vcx_issuer_get_credential_msg)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_issuer_get_credential_msg_fn(vcb->handle, argToUInt32(info[1]), arg2, cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerSendCredentialOffer) {
+  VCX_ASSERT_NARGS(vcx_issuer_send_credential_offer, 4)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential_offer, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential_offer, 1, credentialHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_send_credential_offer, 2, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_send_credential_offer, 3)
+  VCX_ASSERT_LOADED(vcx_issuer_send_credential_offer)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_issuer_send_credential_offer_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerGetCredentialOfferMsg) {
+  VCX_ASSERT_NARGS(vcx_issuer_get_credential_offer_msg, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_get_credential_offer_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_get_credential_offer_msg, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_get_credential_offer_msg, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_get_credential_offer_msg)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_get_credential_offer_msg_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxIssuerCredentialRelease) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_release, 1)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_release, 0, credentialHandle)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_release)
+  info.GetReturnValue().Set(vcx_issuer_credential_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxIssuerCredentialGetPaymentTxn) {
+  VCX_ASSERT_NARGS(vcx_issuer_credential_get_payment_txn, 3)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_get_payment_txn, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_issuer_credential_get_payment_txn, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_issuer_credential_get_payment_txn, 2)
+  VCX_ASSERT_LOADED(vcx_issuer_credential_get_payment_txn)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_issuer_credential_get_payment_txn_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofCreate) {
+  VCX_ASSERT_NARGS(vcx_proof_create, 7)
+  VCX_ASSERT_NUMBER(vcx_proof_create, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_proof_create, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_proof_create, 2, requestedAttrs)
+  VCX_ASSERT_STRING(vcx_proof_create, 3, requestedPredicates)
+  VCX_ASSERT_STRING(vcx_proof_create, 4, revocationInterval)
+  VCX_ASSERT_STRING(vcx_proof_create, 5, name)
+  VCX_ASSERT_FUNCTION(vcx_proof_create, 6)
+  VCX_ASSERT_LOADED(vcx_proof_create)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  CStringArg arg5(info[5]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[6]);
+  vcx_error_t res = vcx_proof_create_fn(vcb->handle, arg1, arg2, arg3, arg4, arg5, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofDeserialize) {
+  VCX_ASSERT_NARGS(vcx_proof_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_proof_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_proof_deserialize, 1, proofData)
+  VCX_ASSERT_FUNCTION(vcx_proof_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_proof_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_proof_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxGetProof) {
+  VCX_ASSERT_NARGS(vcx_get_proof, 4)
+  VCX_ASSERT_NUMBER(vcx_get_proof, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_get_proof, 1, proofHandle)
+  VCX_ASSERT_NUMBER(vcx_get_proof, 2, unusedConnectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_get_proof, 3)
+  VCX_ASSERT_LOADED(vcx_get_proof)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_get_proof_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbHandleString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofRelease) {
+  VCX_ASSERT_NARGS(vcx_proof_release, 1)
+  VCX_ASSERT_NUMBER(vcx_proof_release, 0, proofHandle)
+  VCX_ASSERT_LOADED(vcx_proof_release)
+  info.GetReturnValue().Set(vcx_proof_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxProofSendRequest) {
+  VCX_ASSERT_NARGS(vcx_proof_send_request, 4)
+  VCX_ASSERT_NUMBER(vcx_proof_send_request, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_send_request, 1, proofHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_send_request, 2, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_proof_send_request, 3)
+  VCX_ASSERT_LOADED(vcx_proof_send_request)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_proof_send_request_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofGetRequestMsg) {
+  VCX_ASSERT_NARGS(vcx_proof_get_request_msg, 3)
+  VCX_ASSERT_NUMBER(vcx_proof_get_request_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_get_request_msg, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_proof_get_request_msg, 2)
+  VCX_ASSERT_LOADED(vcx_proof_get_request_msg)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_proof_get_request_msg_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofSerialize) {
+  VCX_ASSERT_NARGS(vcx_proof_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_proof_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_serialize, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_proof_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_proof_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_proof_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofUpdateState) {
+  VCX_ASSERT_NARGS(vcx_proof_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_proof_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_update_state, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_proof_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_proof_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_proof_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofUpdateStateWithMessage) {
+  VCX_ASSERT_NARGS(vcx_proof_update_state_with_message, 4)
+  VCX_ASSERT_NUMBER(vcx_proof_update_state_with_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_update_state_with_message, 1, proofHandle)
+  VCX_ASSERT_STRING(vcx_proof_update_state_with_message, 2, message)
+  VCX_ASSERT_FUNCTION(vcx_proof_update_state_with_message, 3)
+  VCX_ASSERT_LOADED(vcx_proof_update_state_with_message)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_proof_update_state_with_message_fn(vcb->handle, argToUInt32(info[1]), arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxProofGetState) {
+  VCX_ASSERT_NARGS(vcx_proof_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_proof_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_proof_get_state, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_proof_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_proof_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_proof_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofCreateWithRequest) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_create_with_request, 4)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_create_with_request, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_create_with_request, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_create_with_request, 2, proofReq)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_create_with_request, 3)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_create_with_request)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_disclosed_proof_create_with_request_fn(vcb->handle, arg1, arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofCreateWithMsgid) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_create_with_msgid, 5)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_create_with_msgid, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_create_with_msgid, 1, sourceId)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_create_with_msgid, 2, connectionHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_create_with_msgid, 3, msgId)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_create_with_msgid, 4)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_create_with_msgid)
+  CStringArg arg1(info[1]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_disclosed_proof_create_with_msgid_fn(vcb->handle, arg1, argToUInt32(info[2]), arg3, cbHandleString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofRelease) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_release, 1)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_release, 0, handle)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_release)
+  info.GetReturnValue().Set(vcx_disclosed_proof_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxDisclosedProofSendProof) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_send_proof, 4)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_send_proof, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_send_proof, 1, proofHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_send_proof, 2, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_send_proof, 3)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_send_proof)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_disclosed_proof_send_proof_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofRejectProof) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_reject_proof, 4)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_reject_proof, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_reject_proof, 1, proofHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_reject_proof, 2, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_reject_proof, 3)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_reject_proof)
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_disclosed_proof_reject_proof_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofGetProofMsg) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_get_proof_msg, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_proof_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_proof_msg, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_get_proof_msg, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_get_proof_msg)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_get_proof_msg_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofGetRejectMsg) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_get_reject_msg, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_reject_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_reject_msg, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_get_reject_msg, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_get_reject_msg)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_get_reject_msg_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofSerialize) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_serialize, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofDeserialize) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_deserialize, 1, proofData)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofUpdateState) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_update_state, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofUpdateStateWithMessage) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_update_state_with_message, 4)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_update_state_with_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_update_state_with_message, 1, proofHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_update_state_with_message, 2, message)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_update_state_with_message, 3)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_update_state_with_message)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_disclosed_proof_update_state_with_message_fn(vcb->handle, argToUInt32(info[1]), arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofGetState) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_state, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofGetRequests) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_get_requests, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_requests, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_get_requests, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_get_requests, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_get_requests)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_get_requests_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofRetrieveCredentials) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_retrieve_credentials, 3)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_retrieve_credentials, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_retrieve_credentials, 1, proofHandle)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_retrieve_credentials, 2)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_retrieve_credentials)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_disclosed_proof_retrieve_credentials_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofGenerateProof) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_generate_proof, 5)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_generate_proof, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_generate_proof, 1, proofHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_generate_proof, 2, selectedCredentials)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_generate_proof, 3, selfAttestedAttrs)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_generate_proof, 4)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_generate_proof)
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_disclosed_proof_generate_proof_fn(vcb->handle, argToUInt32(info[1]), arg2, arg3, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxDisclosedProofDeclinePresentationRequest) {
+  VCX_ASSERT_NARGS(vcx_disclosed_proof_decline_presentation_request, 6)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_decline_presentation_request, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_decline_presentation_request, 1, proofHandle)
+  VCX_ASSERT_NUMBER(vcx_disclosed_proof_decline_presentation_request, 2, connectionHandle)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_decline_presentation_request, 3, reason)
+  VCX_ASSERT_STRING(vcx_disclosed_proof_decline_presentation_request, 4, proposal)
+  VCX_ASSERT_FUNCTION(vcx_disclosed_proof_decline_presentation_request, 5)
+  VCX_ASSERT_LOADED(vcx_disclosed_proof_decline_presentation_request)
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[5]);
+  vcx_error_t res = vcx_disclosed_proof_decline_presentation_request_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), arg3, arg4, cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialCreateWithOffer) {
+  VCX_ASSERT_NARGS(vcx_credential_create_with_offer, 4)
+  VCX_ASSERT_NUMBER(vcx_credential_create_with_offer, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credential_create_with_offer, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_credential_create_with_offer, 2, offer)
+  VCX_ASSERT_FUNCTION(vcx_credential_create_with_offer, 3)
+  VCX_ASSERT_LOADED(vcx_credential_create_with_offer)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_credential_create_with_offer_fn(vcb->handle, arg1, arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialCreateWithMsgid) {
+  VCX_ASSERT_NARGS(vcx_credential_create_with_msgid, 5)
+  VCX_ASSERT_NUMBER(vcx_credential_create_with_msgid, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credential_create_with_msgid, 1, sourceId)
+  VCX_ASSERT_NUMBER(vcx_credential_create_with_msgid, 2, connectionHandle)
+  VCX_ASSERT_STRING(vcx_credential_create_with_msgid, 3, msgId)
+  VCX_ASSERT_FUNCTION(vcx_credential_create_with_msgid, 4)
+  VCX_ASSERT_LOADED(vcx_credential_create_with_msgid)
+  CStringArg arg1(info[1]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_credential_create_with_msgid_fn(vcb->handle, arg1, argToUInt32(info[2]), arg3, cbHandleString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialRelease) {
+  VCX_ASSERT_NARGS(vcx_credential_release, 1)
+  VCX_ASSERT_NUMBER(vcx_credential_release, 0, handle)
+  VCX_ASSERT_LOADED(vcx_credential_release)
+  info.GetReturnValue().Set(vcx_credential_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxCredentialSendRequest) {
+  VCX_ASSERT_NARGS(vcx_credential_send_request, 5)
+  VCX_ASSERT_NUMBER(vcx_credential_send_request, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_send_request, 1, credentialHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_send_request, 2, connectionHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_send_request, 3, paymentHandle)
+  VCX_ASSERT_FUNCTION(vcx_credential_send_request, 4)
+  VCX_ASSERT_LOADED(vcx_credential_send_request)
+  VcxCallback* vcb = argToVcxCb(info[0], info[4]);
+  vcx_error_t res = vcx_credential_send_request_fn(vcb->handle, argToUInt32(info[1]), argToUInt32(info[2]), argToUInt32(info[3]), cbNone);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialGetRequestMsg) {
+  VCX_ASSERT_NARGS(vcx_credential_get_request_msg, 6)
+  VCX_ASSERT_NUMBER(vcx_credential_get_request_msg, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_get_request_msg, 1, credentialHandle)
+  VCX_ASSERT_STRING(vcx_credential_get_request_msg, 2, myPwDid)
+  VCX_ASSERT_STRING(vcx_credential_get_request_msg, 3, theirPwDid)
+  VCX_ASSERT_NUMBER(vcx_credential_get_request_msg, 4, paymentHandle)
+  VCX_ASSERT_FUNCTION(vcx_credential_get_request_msg, 5)
+  VCX_ASSERT_LOADED(vcx_credential_get_request_msg)
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[5]);
+  vcx_error_t res = vcx_credential_get_request_msg_fn(vcb->handle, argToUInt32(info[1]), arg2, arg3, argToUInt32(info[4]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialSerialize) {
+  VCX_ASSERT_NARGS(vcx_credential_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_serialize, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_credential_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_credential_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialDeserialize) {
+  VCX_ASSERT_NARGS(vcx_credential_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credential_deserialize, 1, credentialData)
+  VCX_ASSERT_FUNCTION(vcx_credential_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_credential_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialUpdateState) {
+  VCX_ASSERT_NARGS(vcx_credential_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_update_state, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_credential_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_credential_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialUpdateStateWithMessage) {
+  VCX_ASSERT_NARGS(vcx_credential_update_state_with_message, 4)
+  VCX_ASSERT_NUMBER(vcx_credential_update_state_with_message, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_update_state_with_message, 1, credentialHandle)
+  VCX_ASSERT_STRING(vcx_credential_update_state_with_message, 2, message)
+  VCX_ASSERT_FUNCTION(vcx_credential_update_state_with_message, 3)
+  VCX_ASSERT_LOADED(vcx_credential_update_state_with_message)
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_credential_update_state_with_message_fn(vcb->handle, argToUInt32(info[1]), arg2, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialGetState) {
+  VCX_ASSERT_NARGS(vcx_credential_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_get_state, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_credential_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_credential_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialGetOffers) {
+  VCX_ASSERT_NARGS(vcx_credential_get_offers, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_get_offers, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_get_offers, 1, connectionHandle)
+  VCX_ASSERT_FUNCTION(vcx_credential_get_offers, 2)
+  VCX_ASSERT_LOADED(vcx_credential_get_offers)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_get_offers_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialGetPaymentInfo) {
+  VCX_ASSERT_NARGS(vcx_credential_get_payment_info, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_get_payment_info, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_get_payment_info, 1, credentialHandle)
+  VCX_ASSERT_FUNCTION(vcx_credential_get_payment_info, 2)
+  VCX_ASSERT_LOADED(vcx_credential_get_payment_info)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_get_payment_info_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialGetPaymentTxn) {
+  VCX_ASSERT_NARGS(vcx_credential_get_payment_txn, 3)
+  VCX_ASSERT_NUMBER(vcx_credential_get_payment_txn, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credential_get_payment_txn, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_credential_get_payment_txn, 2)
+  VCX_ASSERT_LOADED(vcx_credential_get_payment_txn)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credential_get_payment_txn_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefCreate) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_create, 9)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_create, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 2, credentialdefName)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 3, schemaId)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 4, issuerDid)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 5, tag)
+  VCX_ASSERT_STRING(vcx_credentialdef_create, 6, revocationDetails)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_create, 7, paymentHandle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_create, 8)
+  VCX_ASSERT_LOADED(vcx_credentialdef_create)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  CStringArg arg5(info[5]);
+  CStringArg arg6(info[6]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[8]);
+  vcx_error_t res = vcx_credentialdef_create_fn(vcb->handle, arg1, arg2, arg3, arg4, arg5, arg6, argToUInt32(info[7]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefPrepareForEndorser) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_prepare_for_endorser, 9)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_prepare_for_endorser, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 2, credentialdefName)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 3, schemaId)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 4, issuerDid)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 5, tag)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 6, revocationDetails)
+  VCX_ASSERT_STRING(vcx_credentialdef_prepare_for_endorser, 7, endorser)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_prepare_for_endorser, 8)
+  VCX_ASSERT_LOADED(vcx_credentialdef_prepare_for_endorser)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  CStringArg arg5(info[5]);
+  CStringArg arg6(info[6]);
+  CStringArg arg7(info[7]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[8]);
+  vcx_error_t res = vcx_credentialdef_prepare_for_endorser_fn(vcb->handle, arg1, arg2, arg3, arg4, arg5, arg6, arg7, cbHandleStringStringString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefDeserialize) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_credentialdef_deserialize, 1, credentialdefData)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefRelease) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_release, 1)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_release, 0, credentialdefHandle)
+  VCX_ASSERT_LOADED(vcx_credentialdef_release)
+  info.GetReturnValue().Set(vcx_credentialdef_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxCredentialdefSerialize) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_serialize, 1, credentialdefHandle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefGetCredDefId) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_get_cred_def_id, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_cred_def_id, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_cred_def_id, 1, credDefHandle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_get_cred_def_id, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_get_cred_def_id)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_get_cred_def_id_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefGetPaymentTxn) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_get_payment_txn, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_payment_txn, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_payment_txn, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_get_payment_txn, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_get_payment_txn)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_get_payment_txn_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefUpdateState) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_update_state, 1, credentialdefHandle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxCredentialdefGetState) {
+  VCX_ASSERT_NARGS(vcx_credentialdef_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_credentialdef_get_state, 1, credentialdefHandle)
+  VCX_ASSERT_FUNCTION(vcx_credentialdef_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_credentialdef_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_credentialdef_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSetDefaultLogger) {
+  VCX_ASSERT_NARGS(vcx_set_default_logger, 1)
+  VCX_ASSERT_STRING(vcx_set_default_logger, 0, pattern)
+  VCX_ASSERT_LOADED(vcx_set_default_logger)
+  CStringArg arg0(info[0]);
+  info.GetReturnValue().Set(vcx_set_default_logger_fn(arg0));
+}
+
+NAN_METHOD(vcxSetNextAgencyResponse) {
+  VCX_ASSERT_NARGS(vcx_set_next_agency_response, 1)
+  VCX_ASSERT_NUMBER(vcx_set_next_agency_response, 0, messageIndex)
+  VCX_ASSERT_LOADED(vcx_set_next_agency_response)
+  vcx_set_next_agency_response_fn(argToUInt32(info[0]));
+}
+
+NAN_METHOD(vcxSchemaGetAttributes) {
+  VCX_ASSERT_NARGS(vcx_schema_get_attributes, 4)
+  VCX_ASSERT_NUMBER(vcx_schema_get_attributes, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_schema_get_attributes, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_schema_get_attributes, 2, schemaId)
+  VCX_ASSERT_FUNCTION(vcx_schema_get_attributes, 3)
+  VCX_ASSERT_LOADED(vcx_schema_get_attributes)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[3]);
+  vcx_error_t res = vcx_schema_get_attributes_fn(vcb->handle, arg1, arg2, cbHandleString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaCreate) {
+  VCX_ASSERT_NARGS(vcx_schema_create, 7)
+  VCX_ASSERT_NUMBER(vcx_schema_create, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_schema_create, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_schema_create, 2, schemaName)
+  VCX_ASSERT_STRING(vcx_schema_create, 3, version)
+  VCX_ASSERT_STRING(vcx_schema_create, 4, schemaData)
+  VCX_ASSERT_NUMBER(vcx_schema_create, 5, paymentHandle)
+  VCX_ASSERT_FUNCTION(vcx_schema_create, 6)
+  VCX_ASSERT_LOADED(vcx_schema_create)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[6]);
+  vcx_error_t res = vcx_schema_create_fn(vcb->handle, arg1, arg2, arg3, arg4, argToUInt32(info[5]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaPrepareForEndorser) {
+  VCX_ASSERT_NARGS(vcx_schema_prepare_for_endorser, 7)
+  VCX_ASSERT_NUMBER(vcx_schema_prepare_for_endorser, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_schema_prepare_for_endorser, 1, sourceId)
+  VCX_ASSERT_STRING(vcx_schema_prepare_for_endorser, 2, schemaName)
+  VCX_ASSERT_STRING(vcx_schema_prepare_for_endorser, 3, version)
+  VCX_ASSERT_STRING(vcx_schema_prepare_for_endorser, 4, schemaData)
+  VCX_ASSERT_STRING(vcx_schema_prepare_for_endorser, 5, endorser)
+  VCX_ASSERT_FUNCTION(vcx_schema_prepare_for_endorser, 6)
+  VCX_ASSERT_LOADED(vcx_schema_prepare_for_endorser)
+  CStringArg arg1(info[1]);
+  CStringArg arg2(info[2]);
+  CStringArg arg3(info[3]);
+  CStringArg arg4(info[4]);
+  CStringArg arg5(info[5]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[6]);
+  vcx_error_t res = vcx_schema_prepare_for_endorser_fn(vcb->handle, arg1, arg2, arg3, arg4, arg5, cbHandleString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaGetSchemaId) {
+  VCX_ASSERT_NARGS(vcx_schema_get_schema_id, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_get_schema_id, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_schema_get_schema_id, 1, schemaHandle)
+  VCX_ASSERT_FUNCTION(vcx_schema_get_schema_id, 2)
+  VCX_ASSERT_LOADED(vcx_schema_get_schema_id)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_get_schema_id_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaDeserialize) {
+  VCX_ASSERT_NARGS(vcx_schema_deserialize, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_deserialize, 0, commandHandle)
+  VCX_ASSERT_STRING(vcx_schema_deserialize, 1, schemaData)
+  VCX_ASSERT_FUNCTION(vcx_schema_deserialize, 2)
+  VCX_ASSERT_LOADED(vcx_schema_deserialize)
+  CStringArg arg1(info[1]);
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_deserialize_fn(vcb->handle, arg1, cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaRelease) {
+  VCX_ASSERT_NARGS(vcx_schema_release, 1)
+  VCX_ASSERT_NUMBER(vcx_schema_release, 0, schemaHandle)
+  VCX_ASSERT_LOADED(vcx_schema_release)
+  info.GetReturnValue().Set(vcx_schema_release_fn(argToUInt32(info[0])));
+}
+
+NAN_METHOD(vcxSchemaSerialize) {
+  VCX_ASSERT_NARGS(vcx_schema_serialize, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_serialize, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_schema_serialize, 1, schemaHandle)
+  VCX_ASSERT_FUNCTION(vcx_schema_serialize, 2)
+  VCX_ASSERT_LOADED(vcx_schema_serialize)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_serialize_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaGetPaymentTxn) {
+  VCX_ASSERT_NARGS(vcx_schema_get_payment_txn, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_get_payment_txn, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_schema_get_payment_txn, 1, handle)
+  VCX_ASSERT_FUNCTION(vcx_schema_get_payment_txn, 2)
+  VCX_ASSERT_LOADED(vcx_schema_get_payment_txn)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_get_payment_txn_fn(vcb->handle, argToUInt32(info[1]), cbString);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaUpdateState) {
+  VCX_ASSERT_NARGS(vcx_schema_update_state, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_update_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_schema_update_state, 1, schemaHandle)
+  VCX_ASSERT_FUNCTION(vcx_schema_update_state, 2)
+  VCX_ASSERT_LOADED(vcx_schema_update_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_update_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+NAN_METHOD(vcxSchemaGetState) {
+  VCX_ASSERT_NARGS(vcx_schema_get_state, 3)
+  VCX_ASSERT_NUMBER(vcx_schema_get_state, 0, commandHandle)
+  VCX_ASSERT_NUMBER(vcx_schema_get_state, 1, schemaHandle)
+  VCX_ASSERT_FUNCTION(vcx_schema_get_state, 2)
+  VCX_ASSERT_LOADED(vcx_schema_get_state)
+  VcxCallback* vcb = argToVcxCb(info[0], info[2]);
+  vcx_error_t res = vcx_schema_get_state_fn(vcb->handle, argToUInt32(info[1]), cbHandle);
+  vcxCalled(vcb, res);
+  info.GetReturnValue().Set(res);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Library loading and releasing of libvcx objects
+//
+
+static std::string libvcxPath;
+
+/**
+ * Loads libvcx from the path and resolves all functions.
+ * Returns the error message if it fails, functions loaded before are kept.
+ */
+NAN_METHOD(load) {
+  VCX_ASSERT_NARGS(load, 1)
+  VCX_ASSERT_STRING(load, 0, path)
+  Nan::Utf8String path(info[0]);
+  if(!libvcxPath.empty() && libvcxPath == *path){
+    return;
+  }
+
+  // The library is never closed: libvcx threads may still call back into it.
+  uv_lib_t* lib = new uv_lib_t;
+  if(uv_dlopen(*path, lib) != 0){
+    info.GetReturnValue().Set(toJSString(uv_dlerror(lib)));
+    uv_dlclose(lib);
+    delete lib;
+    return;
+  }
+
+  std::vector<void*> fns(symbolsCount);
+  for(size_t i = 0; i < symbolsCount; i++){
+    if(uv_dlsym(lib, symbols[i].name, &fns[i]) != 0){
+      info.GetReturnValue().Set(toJSString(uv_dlerror(lib)));
+      uv_dlclose(lib);
+      delete lib;
+      return;
+    }
+  }
+
+  for(size_t i = 0; i < symbolsCount; i++){
+    *symbols[i].fn = fns[i];
+  }
+  libvcxPath = *path;
+}
+
+/**
+ * Releases the libvcx object when its JS object is garbage collected.
+ * It replaces `weak` callbacks: release is called from the GC callback, no JS code is run for it.
+ */
+class VcxReleaseOnGC {
+  public:
+    VcxReleaseOnGC(v8::Local<v8::Object> object, vcx_release_t* fn_, vcx_u32_t handle_) {
+        fn = fn_;
+        handle = handle_;
+        persistent.Reset(object);
+        persistent.SetWeak(this, onGC, Nan::WeakCallbackType::kParameter);
+    }
+
+  private:
+    Nan::Persistent<v8::Object> persistent;
+    vcx_release_t* fn;
+    vcx_u32_t handle;
+
+    static void onGC(const Nan::WeakCallbackInfo<VcxReleaseOnGC>& data) {
+        VcxReleaseOnGC* release = data.GetParameter();
+        if(*release->fn != nullptr){
+            (*release->fn)(release->handle);
+        }
+        delete release;
+    }
+};
+
+/**
+ * Registers release of the object handle by the named vcx_*_release function.
+ * Returns false if the function isn't known.
+ */
+NAN_METHOD(registerRelease) {
+  VCX_ASSERT_NARGS(registerRelease, 3)
+  VCX_ASSERT_OBJECT(registerRelease, 0, object)
+  VCX_ASSERT_STRING(registerRelease, 1, releaseFn)
+  VCX_ASSERT_NUMBER(registerRelease, 2, handle)
+  Nan::Utf8String name(info[1]);
+  for(const VcxReleaseFn& releaseFn : releaseFns){
+    if(strcmp(releaseFn.name, *name) == 0){
+      new VcxReleaseOnGC(Nan::To<v8::Object>(info[0]).ToLocalChecked(), releaseFn.fn, argToUInt32(info[2]));
+      info.GetReturnValue().Set(true);
+      return;
+    }
+  }
+  info.GetReturnValue().Set(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Exports. Functions are set with their libvcx names, the same as in FFIConfiguration.
+//
+
+NAN_MODULE_INIT(InitAll) {
+  VcxCallback::init(uv_default_loop());
+  Nan::Export(target, "load", load);
+  Nan::Export(target, "registerRelease", registerRelease);
+  Nan::SetMethod(target, "vcx_init", vcxInit);
+  Nan::SetMethod(target, "vcx_init_with_config", vcxInitWithConfig);
+  Nan::SetMethod(target, "vcx_init_minimal", vcxInitMinimal);
+  Nan::SetMethod(target, "vcx_shutdown", vcxShutdown);
+  Nan::SetMethod(target, "vcx_error_c_message", vcxErrorCMessage);
+  Nan::SetMethod(target, "vcx_version", vcxVersion);
+  Nan::SetMethod(target, "vcx_agent_provision_async", vcxAgentProvisionAsync);
+  Nan::SetMethod(target, "vcx_agent_update_info", vcxAgentUpdateInfo);
+  Nan::SetMethod(target, "vcx_update_institution_info", vcxUpdateInstitutionInfo);
+  Nan::SetMethod(target, "vcx_update_webhook_url", vcxUpdateWebhookUrl);
+  Nan::SetMethod(target, "vcx_mint_tokens", vcxMintTokens);
+  Nan::SetMethod(target, "vcx_messages_download", vcxMessagesDownload);
+  Nan::SetMethod(target, "vcx_messages_update_status", vcxMessagesUpdateStatus);
+  Nan::SetMethod(target, "vcx_get_ledger_author_agreement", vcxGetLedgerAuthorAgreement);
+  Nan::SetMethod(target, "vcx_set_active_txn_author_agreement_meta", vcxSetActiveTxnAuthorAgreementMeta);
+  Nan::SetMethod(target, "vcx_endorse_transaction", vcxEndorseTransaction);
+  Nan::SetMethod(target, "vcx_wallet_get_token_info", vcxWalletGetTokenInfo);
+  Nan::SetMethod(target, "vcx_wallet_create_payment_address", vcxWalletCreatePaymentAddress);
+  Nan::SetMethod(target, "vcx_wallet_sign_with_address", vcxWalletSignWithAddress);
+  Nan::SetMethod(target, "vcx_wallet_verify_with_address", vcxWalletVerifyWithAddress);
+  Nan::SetMethod(target, "vcx_wallet_send_tokens", vcxWalletSendTokens);
+  Nan::SetMethod(target, "vcx_wallet_set_handle", vcxWalletSetHandle);
+  Nan::SetMethod(target, "vcx_pool_set_handle", vcxPoolSetHandle);
+  Nan::SetMethod(target, "vcx_ledger_get_fees", vcxLedgerGetFees);
+  Nan::SetMethod(target, "vcx_wallet_add_record", vcxWalletAddRecord);
+  Nan::SetMethod(target, "vcx_wallet_update_record_value", vcxWalletUpdateRecordValue);
+  Nan::SetMethod(target, "vcx_wallet_update_record_tags", vcxWalletUpdateRecordTags);
+  Nan::SetMethod(target, "vcx_wallet_add_record_tags", vcxWalletAddRecordTags);
+  Nan::SetMethod(target, "vcx_wallet_delete_record_tags", vcxWalletDeleteRecordTags);
+  Nan::SetMethod(target, "vcx_wallet_delete_record", vcxWalletDeleteRecord);
+  Nan::SetMethod(target, "vcx_wallet_get_record", vcxWalletGetRecord);
+  Nan::SetMethod(target, "vcx_wallet_open_search", vcxWalletOpenSearch);
+  Nan::SetMethod(target, "vcx_wallet_close_search", vcxWalletCloseSearch);
+  Nan::SetMethod(target, "vcx_wallet_search_next_records", vcxWalletSearchNextRecords);
+  Nan::SetMethod(target, "vcx_wallet_import", vcxWalletImport);
+  Nan::SetMethod(target, "vcx_wallet_export", vcxWalletExport);
+  Nan::SetMethod(target, "vcx_wallet_validate_payment_address", vcxWalletValidatePaymentAddress);
+  Nan::SetMethod(target, "vcx_connection_delete_connection", vcxConnectionDeleteConnection);
+  Nan::SetMethod(target, "vcx_connection_connect", vcxConnectionConnect);
+  Nan::SetMethod(target, "vcx_connection_create", vcxConnectionCreate);
+  Nan::SetMethod(target, "vcx_connection_create_with_invite", vcxConnectionCreateWithInvite);
+  Nan::SetMethod(target, "vcx_connection_deserialize", vcxConnectionDeserialize);
+  Nan::SetMethod(target, "vcx_connection_release", vcxConnectionRelease);
+  Nan::SetMethod(target, "vcx_connection_serialize", vcxConnectionSerialize);
+  Nan::SetMethod(target, "vcx_connection_update_state", vcxConnectionUpdateState);
+  Nan::SetMethod(target, "vcx_connection_update_state_with_message", vcxConnectionUpdateStateWithMessage);
+  Nan::SetMethod(target, "vcx_connection_get_state", vcxConnectionGetState);
+  Nan::SetMethod(target, "vcx_connection_invite_details", vcxConnectionInviteDetails);
+  Nan::SetMethod(target, "vcx_connection_send_message", vcxConnectionSendMessage);
+  Nan::SetMethod(target, "vcx_connection_sign_data", vcxConnectionSignData);
+  Nan::SetMethod(target, "vcx_connection_verify_signature", vcxConnectionVerifySignature);
+  Nan::SetMethod(target, "vcx_connection_send_ping", vcxConnectionSendPing);
+  Nan::SetMethod(target, "vcx_connection_send_discovery_features", vcxConnectionSendDiscoveryFeatures);
+  Nan::SetMethod(target, "vcx_connection_get_pw_did", vcxConnectionGetPwDid);
+  Nan::SetMethod(target, "vcx_connection_get_their_pw_did", vcxConnectionGetTheirPwDid);
+  Nan::SetMethod(target, "vcx_connection_redirect", vcxConnectionRedirect);
+  Nan::SetMethod(target, "vcx_connection_get_redirect_details", vcxConnectionGetRedirectDetails);
+  Nan::SetMethod(target, "vcx_connection_info", vcxConnectionInfo);
+  Nan::SetMethod(target, "vcx_issuer_credential_deserialize", vcxIssuerCredentialDeserialize);
+  Nan::SetMethod(target, "vcx_issuer_credential_serialize", vcxIssuerCredentialSerialize);
+  Nan::SetMethod(target, "vcx_issuer_credential_update_state", vcxIssuerCredentialUpdateState);
+  Nan::SetMethod(target, "vcx_issuer_credential_update_state_with_message", vcxIssuerCredentialUpdateStateWithMessage);
+  Nan::SetMethod(target, "vcx_issuer_credential_get_state", vcxIssuerCredentialGetState);
+  Nan::SetMethod(target, "vcx_issuer_create_credential", vcxIssuerCreateCredential);
+  Nan::SetMethod(target, "vcx_issuer_revoke_credential", vcxIssuerRevokeCredential);
+  Nan::SetMethod(target, "vcx_issuer_send_credential", vcxIssuerSendCredential);
+  Nan::SetMethod(target, "vcx_issuer_get_credential_msg", vcxIssuerGetCredentialMsg);
+  Nan::SetMethod(target, "vcx_issuer_send_credential_offer", vcxIssuerSendCredentialOffer);
+  Nan::SetMethod(target, "vcx_issuer_get_credential_offer_msg", vcxIssuerGetCredentialOfferMsg);
+  Nan::SetMethod(target, "vcx_issuer_credential_release", vcxIssuerCredentialRelease);
+  Nan::SetMethod(target, "vcx_issuer_credential_get_payment_txn", vcxIssuerCredentialGetPaymentTxn);
+  Nan::SetMethod(target, "vcx_proof_create", vcxProofCreate);
+  Nan::SetMethod(target, "vcx_proof_deserialize", vcxProofDeserialize);
+  Nan::SetMethod(target, "vcx_get_proof", vcxGetProof);
+  Nan::SetMethod(target, "vcx_proof_release", vcxProofRelease);
+  Nan::SetMethod(target, "vcx_proof_send_request", vcxProofSendRequest);
+  Nan::SetMethod(target, "vcx_proof_get_request_msg", vcxProofGetRequestMsg);
+  Nan::SetMethod(target, "vcx_proof_serialize", vcxProofSerialize);
+  Nan::SetMethod(target, "vcx_proof_update_state", vcxProofUpdateState);
+  Nan::SetMethod(target, "vcx_proof_update_state_with_message", vcxProofUpdateStateWithMessage);
+  Nan::SetMethod(target, "vcx_proof_get_state", vcxProofGetState);
+  Nan::SetMethod(target, "vcx_disclosed_proof_create_with_request", vcxDisclosedProofCreateWithRequest);
+  Nan::SetMethod(target, "vcx_disclosed_proof_create_with_msgid", vcxDisclosedProofCreateWithMsgid);
+  Nan::SetMethod(target, "vcx_disclosed_proof_release", vcxDisclosedProofRelease);
+  Nan::SetMethod(target, "vcx_disclosed_proof_send_proof", vcxDisclosedProofSendProof);
+  Nan::SetMethod(target, "vcx_disclosed_proof_reject_proof", vcxDisclosedProofRejectProof);
+  Nan::SetMethod(target, "vcx_disclosed_proof_get_proof_msg", vcxDisclosedProofGetProofMsg);
+  Nan::SetMethod(target, "vcx_disclosed_proof_get_reject_msg", vcxDisclosedProofGetRejectMsg);
+  Nan::SetMethod(target, "vcx_disclosed_proof_serialize", vcxDisclosedProofSerialize);
+  Nan::SetMethod(target, "vcx_disclosed_proof_deserialize", vcxDisclosedProofDeserialize);
+  Nan::SetMethod(target, "vcx_disclosed_proof_update_state", vcxDisclosedProofUpdateState);
+  Nan::SetMethod(target, "vcx_disclosed_proof_update_state_with_message", vcxDisclosedProofUpdateStateWithMessage);
+  Nan::SetMethod(target, "vcx_disclosed_proof_get_state", vcxDisclosedProofGetState);
+  Nan::SetMethod(target, "vcx_disclosed_proof_get_requests", vcxDisclosedProofGetRequests);
+  Nan::SetMethod(target, "vcx_disclosed_proof_retrieve_credentials", vcxDisclosedProofRetrieveCredentials);
+  Nan::SetMethod(target, "vcx_disclosed_proof_generate_proof", vcxDisclosedProofGenerateProof);
+  Nan::SetMethod(target, "vcx_disclosed_proof_decline_presentation_request", vcxDisclosedProofDeclinePresentationRequest);
+  Nan::SetMethod(target, "vcx_credential_create_with_offer", vcxCredentialCreateWithOffer);
+  Nan::SetMethod(target, "vcx_credential_create_with_msgid", vcxCredentialCreateWithMsgid);
+  Nan::SetMethod(target, "vcx_credential_release", vcxCredentialRelease);
+  Nan::SetMethod(target, "vcx_credential_send_request", vcxCredentialSendRequest);
+  Nan::SetMethod(target, "vcx_credential_get_request_msg", vcxCredentialGetRequestMsg);
+  Nan::SetMethod(target, "vcx_credential_serialize", vcxCredentialSerialize);
+  Nan::SetMethod(target, "vcx_credential_deserialize", vcxCredentialDeserialize);
+  Nan::SetMethod(target, "vcx_credential_update_state", vcxCredentialUpdateState);
+  Nan::SetMethod(target, "vcx_credential_update_state_with_message", vcxCredentialUpdateStateWithMessage);
+  Nan::SetMethod(target, "vcx_credential_get_state", vcxCredentialGetState);
+  Nan::SetMethod(target, "vcx_credential_get_offers", vcxCredentialGetOffers);
+  Nan::SetMethod(target, "vcx_credential_get_payment_info", vcxCredentialGetPaymentInfo);
+  Nan::SetMethod(target, "vcx_credential_get_payment_txn", vcxCredentialGetPaymentTxn);
+  Nan::SetMethod(target, "vcx_credentialdef_create", vcxCredentialdefCreate);
+  Nan::SetMethod(target, "vcx_credentialdef_prepare_for_endorser", vcxCredentialdefPrepareForEndorser);
+  Nan::SetMethod(target, "vcx_credentialdef_deserialize", vcxCredentialdefDeserialize);
+  Nan::SetMethod(target, "vcx_credentialdef_release", vcxCredentialdefRelease);
+  Nan::SetMethod(target, "vcx_credentialdef_serialize", vcxCredentialdefSerialize);
+  Nan::SetMethod(target, "vcx_credentialdef_get_cred_def_id", vcxCredentialdefGetCredDefId);
+  Nan::SetMethod(target, "vcx_credentialdef_get_payment_txn", vcxCredentialdefGetPaymentTxn);
+  Nan::SetMethod(target, "vcx_credentialdef_update_state", vcxCredentialdefUpdateState);
+  Nan::SetMethod(target, "vcx_credentialdef_get_state", vcxCredentialdefGetState);
+  Nan::SetMethod(target, "vcx_set_default_logger", vcxSetDefaultLogger);
+  Nan::SetMethod(target, "vcx_set_next_agency_response", vcxSetNextAgencyResponse);
+  Nan::SetMethod(target, "vcx_schema_get_attributes", vcxSchemaGetAttributes);
+  Nan::SetMethod(target, "vcx_schema_create", vcxSchemaCreate);
+  Nan::SetMethod(target, "vcx_schema_prepare_for_endorser", vcxSchemaPrepareForEndorser);
+  Nan::SetMethod(target, "vcx_schema_get_schema_id", vcxSchemaGetSchemaId);
+  Nan::SetMethod(target, "vcx_schema_deserialize", vcxSchemaDeserialize);
+  Nan::SetMethod(target, "vcx_schema_release", vcxSchemaRelease);
+  Nan::SetMethod(target, "vcx_schema_serialize", vcxSchemaSerialize);
+  Nan::SetMethod(target, "vcx_schema_get_payment_txn", vcxSchemaGetPaymentTxn);
+  Nan::SetMethod(target, "vcx_schema_update_state", vcxSchemaUpdateState);
+  Nan::SetMethod(target, "vcx_schema_get_state", vcxSchemaGetState);
+}
+NODE_MODULE(vcxnodejs, InitAll)
@@ -5,6 +5,14 @@ import { FFIConfiguration, IFFIEntryPoint } from './rustlib'
 
 export interface IVCXRuntimeConfig {
   basepath?: string
+  // set to false to call libvcx through node-ffi even if the native addon is built
+  native?: boolean
+}
+
+export interface IVCXNativeAddon {
+  load: (path: string) => string | undefined
+  registerRelease: (object: object, releaseFn: string, handle: number) => boolean
+  [fn: string]: any
 }
 
 // VCXRuntime is the object that interfaces with the vcx sdk functions
@@ -15,8 +23,26 @@ export interface IVCXRuntimeConfig {
 const extension = { darwin: '.dylib', linux: '.so', win32: '.dll' }
 const libPath = { darwin: '/usr/local/lib/', linux: '/usr/lib/', win32: 'c:\\windows\\system32\\' }
 
+let _nativeAddon: IVCXNativeAddon | null | undefined
+
+// The addon is built by `npm install` if the toolchain is available, it's optional
+export const nativeAddon = (): IVCXNativeAddon | undefined => {
+  if (_nativeAddon === undefined) {
+    try {
+      _nativeAddon = require('bindings')('vcxnodejs') as IVCXNativeAddon
+    } catch (err) {
+      _nativeAddon = null
+    }
+  }
+  return _nativeAddon || undefined
+}
+
 export class VCXRuntime {
   public readonly ffi: IFFIEntryPoint
+  // Functions called through the native addon, it completes calls with static callbacks instead
+  // of creating ffi closures. Functions the addon doesn't implement are taken from node-ffi.
+  // Undefined if the addon isn't built or is disabled.
+  public readonly native?: IFFIEntryPoint
   private _config: IVCXRuntimeConfig
 
   constructor (config: IVCXRuntimeConfig = {}) {
@@ -24,6 +50,9 @@ export class VCXRuntime {
     // initialize FFI
     const libraryPath = this._initializeBasepath()
     this.ffi = ffi.Library(libraryPath, FFIConfiguration)
+    if (this._config.native !== false) {
+      this.native = this._initializeNative(libraryPath)
+    }
   }
 
   private _initializeBasepath = (): string => {
@@ -36,4 +65,18 @@ export class VCXRuntime {
     const customPath = process.env.LIBVCX_PATH ? process.env.LIBVCX_PATH + library : undefined
     return customPath || this._config.basepath || `${libDir}${library}`
   }
+
+  private _initializeNative = (libraryPath: string): IFFIEntryPoint | undefined => {
+    const addon = nativeAddon()
+    if (!addon || addon.load(libraryPath)) {
+      return undefined
+    }
+    const native: any = { ...this.ffi }
+    for (const fn of Object.keys(FFIConfiguration)) {
+      if (typeof addon[fn] === 'function') {
+        native[fn] = addon[fn]
+      }
+    }
+    return native
+  }
 }
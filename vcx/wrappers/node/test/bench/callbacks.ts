@@ -0,0 +1,55 @@
+import '../module-resolver-helper'
+
+import { VCX_CONFIG_TEST_MODE } from 'helpers/test-constants'
+import { Connection, initRustAPI, initVcx, isNativeAPI, nativeAddon } from 'src'
+
+// Compares libvcx calls completed by the native addon with calls completed through node-ffi
+// closures. libvcx runs in test mode, so the time is mostly spent crossing into libvcx and back.
+
+const CALLS_COUNT = 20000
+const WARMUP_CALLS_COUNT = 2000
+const CONCURRENCY = 100
+
+const calls = async (connection: Connection, count: number) => {
+  for (let i = 0; i < count; i += CONCURRENCY) {
+    await Promise.all(new Array(CONCURRENCY).fill(0).map((_, j) =>
+      j % 2 ? connection.getState() : connection.serialize()))
+  }
+}
+
+const bench = async (native: boolean) => {
+  initRustAPI(undefined, native)
+  if (isNativeAPI() !== native) {
+    throw new Error(`Runtime is not switched to ${native ? 'native addon' : 'node-ffi'}`)
+  }
+
+  const connection = await Connection.create({ id: 'bench' })
+  await calls(connection, WARMUP_CALLS_COUNT)
+
+  const cpuUsage = process.cpuUsage()
+  const started = process.hrtime()
+  await calls(connection, CALLS_COUNT)
+  const [seconds, nanoseconds] = process.hrtime(started)
+  const cpu = process.cpuUsage(cpuUsage)
+  await connection.release()
+
+  const elapsed = seconds + nanoseconds / 1e9
+  console.log(`${native ? 'native addon' : 'node-ffi    '}: ` +
+    `${Math.round(CALLS_COUNT / elapsed)} calls/s, ` +
+    `${((cpu.user + cpu.system) / CALLS_COUNT).toFixed(1)} us of CPU per call`)
+}
+
+const run = async () => {
+  if (!nativeAddon()) {
+    console.log('Native addon is not built, run `npm run rebuild` first')
+    return
+  }
+  await initVcx(VCX_CONFIG_TEST_MODE)
+  await bench(false)
+  await bench(true)
+}
+
+run().catch((err) => {
+  console.error(err)
+  process.exit(1)
+})
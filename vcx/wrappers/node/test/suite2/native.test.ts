@@ -0,0 +1,46 @@
+import '../module-resolver-helper'
+
+import { assert } from 'chai'
+import { connectionCreate } from 'helpers/entities'
+import { initVcxTestMode, shouldThrow } from 'helpers/utils'
+import { Connection, isNativeAPI, nativeAddon, rustAPI, VCXCode } from 'src'
+
+describe('Native addon:', () => {
+  // tslint:disable-next-line only-arrow-functions
+  before(async function () {
+    if (!nativeAddon()) {
+      this.skip()
+    }
+    await initVcxTestMode()
+  })
+
+  it('is used when built', () => {
+    assert.ok(isNativeAPI())
+  })
+
+  it('success: completes parallel calls', async () => {
+    const connections = await Promise.all(new Array(50).fill(0).map(() => connectionCreate()))
+    const serialized = await Promise.all(connections.map((connection) => connection.serialize()))
+    serialized.forEach((data, i) => assert.equal(data.data.source_id, connections[i].sourceId))
+  })
+
+  it('success: passes buffers', async () => {
+    const connection = await connectionCreate()
+    await connection.connect({ data: '{"connection_type":"QR"}' })
+    const data = Buffer.from('random string')
+    const signature = await connection.signData(data)
+    assert.ok(Buffer.isBuffer(signature))
+    assert.ok(await connection.verifySignature({ data, signature }))
+  })
+
+  it('throws: error code returned by libvcx', async () => {
+    const connection = new (Connection as any)()
+    const err = await shouldThrow(async () => connection.connect({ data: '{"connection_type":"QR"}' }))
+    assert.equal(err.vcxCode, VCXCode.INVALID_CONNECTION_HANDLE)
+  })
+
+  it('throws: invalid arguments', () => {
+    assert.throws(() => rustAPI().vcx_connection_release('1' as any), TypeError)
+    assert.throws(() => rustAPI().vcx_connection_serialize(0, 1, null as any), TypeError)
+  })
+})
@@ -1,6 +1,9 @@
 ﻿using Hyperledger.Indy.DidApi;
 using Hyperledger.Indy.Test.Util.Base58Check;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
 
 namespace Hyperledger.Indy.Test.DidTests
@@ -95,5 +98,34 @@ namespace Hyperledger.Indy.Test.DidTests
             Assert.AreEqual(VERKEY_MY1, result.VerKey);
         }
 
+        [TestMethod]
+        public async Task TestCreateMyDidContinuationDoesNotRunOnLibindyThread()
+        {
+            await Did.CreateAndStoreMyDidAsync(wallet, "{}");
+
+            Assert.IsTrue(Thread.CurrentThread.IsThreadPoolThread);
+        }
+
+        [TestMethod]
+        public async Task TestCreateMyDidBlockingContinuationsDoNotSerializeCommands()
+        {
+            const int count = 4;
+
+            // Every continuation blocks until all of them have started.  Continuations run inline
+            // on libindy's callback thread would keep the remaining commands from completing,
+            // so the wait would only end with the timeout.
+            var started = new CountdownEvent(count);
+
+            var tasks = Enumerable.Range(0, count).Select(async i =>
+            {
+                await Did.CreateAndStoreMyDidAsync(wallet, "{}");
+                started.Signal();
+                return started.Wait(TimeSpan.FromSeconds(30));
+            });
+
+            var results = await Task.WhenAll(tasks);
+
+            Assert.IsTrue(results.All(allStarted => allStarted));
+        }
     }
 }
@@ -437,7 +437,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(version, nameof(version));
             ParamGuard.NotNullOrWhiteSpace(attrs, nameof(attrs));
 
-            var taskCompletionSource = new TaskCompletionSource<IssuerCreateSchemaResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<IssuerCreateSchemaResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_create_schema(
@@ -482,7 +482,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(issuerDid, "issuerDid");
             ParamGuard.NotNullOrWhiteSpace(schemaJson, "schemaJson");
 
-            var taskCompletionSource = new TaskCompletionSource<IssuerCreateAndStoreCredentialDefResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<IssuerCreateAndStoreCredentialDefResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_create_and_store_credential_def(
@@ -539,7 +539,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(credDefId, "credDefId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_rotate_credential_def_start(
@@ -568,7 +568,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(credDefId, "credDefId");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_rotate_credential_def_apply(
@@ -629,7 +629,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(credDefId, "credDefId");
             ParamGuard.NotNullOrWhiteSpace(configJson, "configJson");
 
-            var taskCompletionSource = new TaskCompletionSource<IssuerCreateAndStoreRevocRegResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<IssuerCreateAndStoreRevocRegResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_create_and_store_revoc_reg(
@@ -671,7 +671,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(credDefId, "credDefId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_create_credential_offer(
@@ -731,7 +731,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(credValuesJson, "credValuesJson");
 
 
-            var taskCompletionSource = new TaskCompletionSource<IssuerCreateCredentialResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<IssuerCreateCredentialResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_create_credential(
@@ -771,7 +771,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(revRegId, "revRegId");
             ParamGuard.NotNullOrWhiteSpace(credRevocId, "credRevocId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_revoke_credential(
@@ -800,7 +800,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(revRegDelta, "revRegDelta");
             ParamGuard.NotNullOrWhiteSpace(otherRevRegDelta, "otherRevRegDelta");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_issuer_merge_revocation_registry_deltas(
@@ -828,7 +828,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         {
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_create_master_secret(
@@ -876,7 +876,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(credDefJson, "credDefJson");
             ParamGuard.NotNullOrWhiteSpace(masterSecretId, "masterSecretId");
 
-            var taskCompletionSource = new TaskCompletionSource<ProverCreateCredentialRequestResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ProverCreateCredentialRequestResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_create_credential_req(
@@ -912,7 +912,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(credJson, "credJson");
             ParamGuard.NotNullOrWhiteSpace(credDefJson, "credDefJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_store_credential(
@@ -950,7 +950,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(credentialId, "credentialId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_get_credential(
@@ -994,7 +994,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(filterJson, "filterJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_get_credentials(
@@ -1020,7 +1020,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(credentialId, "credentialId");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_delete_credential(
@@ -1053,7 +1053,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(queryJson, "queryJson");
 
-            var taskCompletionSource = new TaskCompletionSource<CredentialSearch>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<CredentialSearch>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_search_credentials(
@@ -1091,7 +1091,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         {
             ParamGuard.NotNull(search, "search");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_fetch_credentials(
@@ -1115,7 +1115,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         {
             ParamGuard.NotNull(search, "search");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_close_credentials_search(
@@ -1211,7 +1211,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(proofRequestJson, "proofRequestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_get_credentials_for_proof_req(
@@ -1266,7 +1266,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(proofRequestJson, "proofRequestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<CredentialSearchForProofRequest>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<CredentialSearchForProofRequest>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_search_credentials_for_proof_req(
@@ -1318,7 +1318,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNull(search, "search");
             ParamGuard.NotNullOrWhiteSpace(itemReferent, "itemReferent");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_fetch_credentials_for_proof_req(
@@ -1343,7 +1343,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         {
             ParamGuard.NotNull(search, "search");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_close_credentials_search_for_proof_req(
@@ -1503,7 +1503,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(credentialDefs, "credentialDefs");
             ParamGuard.NotNullOrWhiteSpace(revStates, "revStates");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_prover_create_proof(
@@ -1615,7 +1615,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(revocRegDefs, "revocRegDefs");
             ParamGuard.NotNullOrWhiteSpace(revocRegs, "revocRegs");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_verifier_verify_proof(
@@ -1656,7 +1656,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(revRegDelta, "revRegDelta");
             ParamGuard.NotNullOrWhiteSpace(credRevId, "credRevId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_create_revocation_state(
@@ -1699,7 +1699,7 @@ namespace Hyperledger.Indy.AnonCredsApi
             ParamGuard.NotNullOrWhiteSpace(revRegDelta, "revRegDelta");
             ParamGuard.NotNullOrWhiteSpace(credRevId, "credRevId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_update_revocation_state(
@@ -1724,7 +1724,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         /// <returns>Generated number as a string</returns>
         public static Task<string> GenerateNonceAsync()
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_generate_nonce(
@@ -1757,7 +1757,7 @@ namespace Hyperledger.Indy.AnonCredsApi
         /// <returns></returns>
         public static Task<string> ToUnqualifiedAsync(string entity)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_to_unqualified(
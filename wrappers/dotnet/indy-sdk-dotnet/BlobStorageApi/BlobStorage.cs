@@ -51,7 +51,7 @@ namespace Hyperledger.Indy.BlobStorageApi
             ParamGuard.NotNullOrWhiteSpace(type, "type");
             ParamGuard.NotNullOrWhiteSpace(configJson, "configJson");
 
-            var taskCompletionSource = new TaskCompletionSource<BlobStorageReader>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<BlobStorageReader>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_open_blob_storage_reader(
@@ -77,7 +77,7 @@ namespace Hyperledger.Indy.BlobStorageApi
             ParamGuard.NotNullOrWhiteSpace(type, "type");
             ParamGuard.NotNullOrWhiteSpace(configJson, "configJson");
 
-            var taskCompletionSource = new TaskCompletionSource<BlobStorageWriter>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<BlobStorageWriter>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_open_blob_storage_writer(
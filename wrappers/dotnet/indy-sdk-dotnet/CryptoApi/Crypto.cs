@@ -208,7 +208,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(keyJson, "keyJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_create_key(
@@ -239,7 +239,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(verKey, "verKey");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_set_key_metadata(
@@ -269,7 +269,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(verKey, "verKey");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_get_key_metadata(
@@ -306,7 +306,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(myVk, "myVk");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_sign(
@@ -340,7 +340,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNull(message, "message");
             ParamGuard.NotNull(signature, "signature");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_verify(
@@ -382,7 +382,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(theirVk, "theirVk");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_auth_crypt(
@@ -423,7 +423,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(myVk, "myVk");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<AuthDecryptResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<AuthDecryptResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_auth_decrypt(
@@ -458,7 +458,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(theirVk, "theirVk");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_anon_crypt(
@@ -501,7 +501,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(myVk, "myVk");
             ParamGuard.NotNull(encryptedMessage, "encryptedMessage");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_crypto_anon_decrypt(
@@ -585,7 +585,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNullOrWhiteSpace(recipientVk, "recipientVk");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_pack_message(
@@ -630,7 +630,7 @@ namespace Hyperledger.Indy.CryptoApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNull(message, "message");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_unpack_message(
@@ -225,7 +225,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(didJson, "didJson");
 
-            var taskCompletionSource = new TaskCompletionSource<CreateAndStoreMyDidResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<CreateAndStoreMyDidResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_create_and_store_my_did(
@@ -271,7 +271,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNullOrWhiteSpace(did, "did");
             ParamGuard.NotNullOrWhiteSpace(identityJson, "identityJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_replace_keys_start(
@@ -297,7 +297,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_replace_keys_apply(
@@ -342,7 +342,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(identityJson, "identityJson");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_store_their_did(
@@ -379,7 +379,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_key_for_did(
@@ -416,7 +416,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_key_for_local_did(
@@ -447,7 +447,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNullOrWhiteSpace(address, "address");
             ParamGuard.NotNullOrWhiteSpace(transportKey, "transportKey");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_set_endpoint_for_did(
@@ -483,7 +483,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(pool, "pool");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<EndpointForDidResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<EndpointForDidResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_get_endpoint_for_did(
@@ -516,7 +516,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_set_did_metadata(
@@ -545,7 +545,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(did, "did");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_get_did_metadata(
@@ -571,7 +571,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(myDid, "myDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_get_my_did_with_meta(
@@ -595,7 +595,7 @@ namespace Hyperledger.Indy.DidApi
         {
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_list_my_dids_with_meta(
@@ -620,7 +620,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNullOrWhiteSpace(did, "did");
             ParamGuard.NotNullOrWhiteSpace(fullVerkey, "fullVerkey");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_abbreviate_verkey(
@@ -651,7 +651,7 @@ namespace Hyperledger.Indy.DidApi
             ParamGuard.NotNullOrWhiteSpace(did, "did");
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var commandResult = NativeMethods.indy_qualify_did(
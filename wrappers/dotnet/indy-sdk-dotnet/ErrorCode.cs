@@ -162,6 +162,11 @@
         /// </summary>
         CommonInvalidParam27 = 129,
 
+        /// <summary>
+        /// Command was rejected because the command queue is full
+        /// </summary>
+        CommonCommandQueueFull = 130,
+
         // Wallet errors
 
         /// <summary>
@@ -145,7 +145,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_sign_request(
@@ -179,7 +179,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_multi_sign_request(
@@ -216,7 +216,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_sign_and_submit_request(
@@ -252,7 +252,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNull(pool, "pool");
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_submit_request(
@@ -285,7 +285,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNull(pool, "pool");
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_submit_action(
@@ -322,7 +322,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(targetDid, "targetDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_ddo_request(
@@ -367,7 +367,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(targetDid, "targetDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_nym_request(
@@ -413,7 +413,7 @@ namespace Hyperledger.Indy.LedgerApi
             if (string.IsNullOrWhiteSpace(hash) && string.IsNullOrWhiteSpace(submitterDid) && string.IsNullOrWhiteSpace(enc))
                 throw new ArgumentException("At least one of the 'hash', 'submitterDid' or 'enc' parameters must have a value.");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_attrib_request(
@@ -451,7 +451,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(targetDid, "targetDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_attrib_request(
@@ -486,7 +486,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(targetDid, "targetDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_nym_request(
@@ -534,7 +534,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(data, "data");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_schema_request(
@@ -559,7 +559,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(schemaId, "schemaId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_schema_request(
@@ -591,7 +591,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(getSchemaResponse, "getSchemaResponse");
 
-            var taskCompletionSource = new TaskCompletionSource<ParseResponseResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ParseResponseResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_schema_response(
@@ -617,7 +617,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(data, "data");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_cred_def_request(
@@ -643,7 +643,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(id, "id");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_cred_def_request(
@@ -667,7 +667,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(getCredDefResponse, "getCredDefResponse");
 
-            var taskCompletionSource = new TaskCompletionSource<ParseResponseResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ParseResponseResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_cred_def_response(
@@ -695,7 +695,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(targetDid, "targetDid");
             ParamGuard.NotNullOrWhiteSpace(data, "data");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_node_request(
@@ -721,7 +721,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_validator_info_request(
@@ -749,7 +749,7 @@ namespace Hyperledger.Indy.LedgerApi
         /// </remarks>
         public static Task<string> BuildGetTxnRequestAsync(string submitterDid, string ledgerType, int seqNo)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_txn_request(
@@ -777,7 +777,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_pool_config_request(
@@ -808,7 +808,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(action, "action");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_pool_restart_request(
@@ -846,7 +846,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(action, "action");
             ParamGuard.NotNullOrWhiteSpace(sha256, "sha256");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_pool_upgrade_request(
@@ -896,7 +896,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitterDid, "submitterDid");
             ParamGuard.NotNullOrWhiteSpace(data, "data");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_revoc_reg_def_request(
@@ -921,7 +921,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(id, "id");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_revoc_reg_def_request(
@@ -960,7 +960,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(getRevocRegDefResponse, "getRevocRegDefResponse");
 
-            var taskCompletionSource = new TaskCompletionSource<ParseResponseResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ParseResponseResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_revoc_reg_def_response(
@@ -1001,7 +1001,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(revDefType, "revDefType");
             ParamGuard.NotNullOrWhiteSpace(value, "value");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_revoc_reg_entry_request(
@@ -1029,7 +1029,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(revocRegDefId, "revocRegDefId");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_revoc_reg_request(
@@ -1061,7 +1061,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(getRevocRegResponse, "getRevocRegResponse");
 
-            var taskCompletionSource = new TaskCompletionSource<ParseRegistryResponseResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ParseRegistryResponseResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_revoc_reg_response(
@@ -1088,7 +1088,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(revocRegDefId, "id");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_revoc_reg_delta_request(
@@ -1123,7 +1123,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(getRevocRegDeltaResponse, "getRevocRegDeltaResponse");
 
-            var taskCompletionSource = new TaskCompletionSource<ParseRegistryResponseResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<ParseRegistryResponseResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_revoc_reg_delta_response(
@@ -1167,7 +1167,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(response, "response");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_get_response_metadata(
@@ -1219,7 +1219,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(field, "field");
             ParamGuard.NotNullOrWhiteSpace(constraint, "constraint");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_auth_rule_request(
@@ -1265,7 +1265,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitter_did, "submitter_did");
             ParamGuard.NotNullOrWhiteSpace(rules, "rules");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_auth_rules_request(
@@ -1296,7 +1296,7 @@ namespace Hyperledger.Indy.LedgerApi
         /// <returns>Request result as json.</returns>
         public static Task<string> BuildGetAuthRuleRequestAsync(string submitter_did, string txn_type, string action, string field, string old_value, string new_value)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_auth_rule_request(
@@ -1332,7 +1332,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(submitter_did, "submitter_did");
             ParamGuard.NotNullOrWhiteSpace(version, "version");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_txn_author_agreement_request(
@@ -1361,7 +1361,7 @@ namespace Hyperledger.Indy.LedgerApi
         {
             ParamGuard.NotNullOrWhiteSpace(submitter_did, "submitter_did");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_disable_all_txn_author_agreements_request(
@@ -1393,7 +1393,7 @@ namespace Hyperledger.Indy.LedgerApi
         /// <returns></returns>
         public static Task<string> BuildGetTxnAuthorAgreementRequestAsync(string submitter_did, string data)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_txn_author_agreement_request(
@@ -1429,7 +1429,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(aml, "aml");
             ParamGuard.NotNullOrWhiteSpace(version, "version");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_acceptance_mechanisms_request(
@@ -1460,7 +1460,7 @@ namespace Hyperledger.Indy.LedgerApi
         /// <returns>Request result as json.</returns>
         public static Task<string> BuildGetAcceptanceMechanismsRequestAsync(string submitter_did, long timestamp, string version)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_acceptance_mechanisms_request(
@@ -1506,7 +1506,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(request_json, "request_json");
             ParamGuard.NotNullOrWhiteSpace(mechanism, "mechanism");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_append_txn_author_agreement_acceptance_to_request(
@@ -1546,7 +1546,7 @@ namespace Hyperledger.Indy.LedgerApi
             ParamGuard.NotNullOrWhiteSpace(requestJson, "requestJson");
             ParamGuard.NotNullOrWhiteSpace(endorserDid, "endorserDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_append_request_endorser(
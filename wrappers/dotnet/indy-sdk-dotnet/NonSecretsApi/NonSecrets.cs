@@ -91,7 +91,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(id, "id");
             ParamGuard.NotNullOrWhiteSpace(value, "value");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_add_wallet_record(
@@ -121,7 +121,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(id, "id");
             ParamGuard.NotNullOrWhiteSpace(value, "value");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_update_wallet_record_value(
@@ -164,7 +164,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(id, "id");
             ParamGuard.NotNullOrWhiteSpace(tagsJson, "tagsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_update_wallet_record_tags(
@@ -207,7 +207,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(id, "id");
             ParamGuard.NotNullOrWhiteSpace(tagsJson, "tagsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_add_wallet_record_tags(
@@ -237,7 +237,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(id, "id");
             ParamGuard.NotNullOrWhiteSpace(tagsJson, "tagsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_delete_wallet_record_tags(
@@ -264,7 +264,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(type, "type");
             ParamGuard.NotNullOrWhiteSpace(id, "id");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_delete_wallet_record(
@@ -299,7 +299,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(type, "type");
             ParamGuard.NotNullOrWhiteSpace(id, "id");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_get_wallet_record(
@@ -352,7 +352,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNullOrWhiteSpace(queryJson, "queryJson");
             ParamGuard.NotNullOrWhiteSpace(optionsJson, "optionsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<WalletSearch>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<WalletSearch>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_open_wallet_search(
@@ -390,7 +390,7 @@ namespace Hyperledger.Indy.NonSecretsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNull(walletSearch, "walletSearch");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_fetch_wallet_search_next_records(
@@ -412,7 +412,7 @@ namespace Hyperledger.Indy.NonSecretsApi
         {
             ParamGuard.NotNull(walletSearch, "walletSearch");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_close_wallet_search(
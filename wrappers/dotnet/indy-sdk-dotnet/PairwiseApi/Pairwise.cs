@@ -81,7 +81,7 @@ namespace Hyperledger.Indy.PairwiseApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(theirDid, "theirDid");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_is_pairwise_exists(
@@ -109,7 +109,7 @@ namespace Hyperledger.Indy.PairwiseApi
             ParamGuard.NotNullOrWhiteSpace(theirDid, "theirDid");
             ParamGuard.NotNullOrWhiteSpace(myDid, "myDid");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_create_pairwise(
@@ -151,7 +151,7 @@ namespace Hyperledger.Indy.PairwiseApi
         {
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_list_pairwise(
@@ -191,7 +191,7 @@ namespace Hyperledger.Indy.PairwiseApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(theirDid, "theirDid");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_get_pairwise(
@@ -222,7 +222,7 @@ namespace Hyperledger.Indy.PairwiseApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(theirDid, "theirDid");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             int result = NativeMethods.indy_set_pairwise_metadata(
@@ -295,7 +295,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_create_payment_address(
@@ -322,7 +322,7 @@ namespace Hyperledger.Indy.PaymentsApi
         {
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_list_payment_addresses(
@@ -351,7 +351,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(implementation, "implementation");
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_register_payment_method(
@@ -415,7 +415,7 @@ namespace Hyperledger.Indy.PaymentsApi
         {
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<PaymentResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<PaymentResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_add_request_fees(
@@ -454,7 +454,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
             ParamGuard.NotNullOrWhiteSpace(responseJson, "responseJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_response_with_fees(
@@ -484,7 +484,7 @@ namespace Hyperledger.Indy.PaymentsApi
         {
             ParamGuard.NotNullOrWhiteSpace(paymentAddress, "paymentAddress");
 
-            var taskCompletionSource = new TaskCompletionSource<PaymentResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<PaymentResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_payment_sources_request(
@@ -519,7 +519,7 @@ namespace Hyperledger.Indy.PaymentsApi
         {
             ParamGuard.NotNullOrWhiteSpace(responseJson, "responseJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_payment_sources_response(
@@ -564,7 +564,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(inputsJson, "inputsJson");
             ParamGuard.NotNullOrWhiteSpace(outputsJson, "outputsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<PaymentResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<PaymentResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_payment_req(
@@ -602,7 +602,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
             ParamGuard.NotNullOrWhiteSpace(responseJson, "responseJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_payment_response(
@@ -643,7 +643,7 @@ namespace Hyperledger.Indy.PaymentsApi
         {
             ParamGuard.NotNullOrWhiteSpace(mechanism, "mechanism");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_prepare_payment_extra_with_acceptance_data(
@@ -683,7 +683,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(outputsJson, "outputsJson");
 
-            var taskCompletionSource = new TaskCompletionSource<PaymentResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<PaymentResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_mint_req(
@@ -722,7 +722,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
             ParamGuard.NotNullOrWhiteSpace(feesJson, "feesJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_set_txn_fees_req(
@@ -753,7 +753,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_get_txn_fees_req(
@@ -787,7 +787,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
             ParamGuard.NotNullOrWhiteSpace(responseJson, "responseJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_get_txn_fees_response(
@@ -813,7 +813,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(wallet, "wallet");
             ParamGuard.NotNullOrWhiteSpace(receipt, "receipt");
 
-            var taskCompletionSource = new TaskCompletionSource<PaymentResult>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<PaymentResult>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_build_verify_payment_req(
@@ -847,7 +847,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(paymentMethod, "paymentMethod");
             ParamGuard.NotNullOrWhiteSpace(responseJson, "responseJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_parse_verify_payment_response(
@@ -896,7 +896,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNullOrWhiteSpace(requesterInfoJson, "requesterInfoJson");
             ParamGuard.NotNullOrWhiteSpace(feesJson, "feesJson");
 
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_get_request_info(
@@ -924,7 +924,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(message, "message");
             ParamGuard.NotNull(wallet, "wallet");
 
-            var taskCompletionSource = new TaskCompletionSource<byte[]>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<byte[]>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_sign_with_address(
@@ -953,7 +953,7 @@ namespace Hyperledger.Indy.PaymentsApi
             ParamGuard.NotNull(message, "message");
             ParamGuard.NotNull(signature, "signature");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_verify_with_address(
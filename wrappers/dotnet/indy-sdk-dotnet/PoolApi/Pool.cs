@@ -80,7 +80,7 @@ namespace Hyperledger.Indy.PoolApi
         {
             ParamGuard.NotNullOrWhiteSpace(configName, "configName");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_create_pool_ledger_config(
@@ -106,7 +106,7 @@ namespace Hyperledger.Indy.PoolApi
         {
             ParamGuard.NotNullOrWhiteSpace(configName, "configName");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_delete_pool_ledger_config(
@@ -152,7 +152,7 @@ namespace Hyperledger.Indy.PoolApi
         {
             ParamGuard.NotNullOrWhiteSpace(configName, "configName");
 
-            var taskCompletionSource = new TaskCompletionSource<Pool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<Pool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_open_pool_ledger(
@@ -173,7 +173,7 @@ namespace Hyperledger.Indy.PoolApi
         /// <returns>The pools json.</returns>
         public static Task<string> ListPoolsAsync()
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_list_pools(
@@ -212,7 +212,7 @@ namespace Hyperledger.Indy.PoolApi
         /// <returns>An asynchronous <see cref="Task"/> that completes when the operation completes.</returns>
         public Task RefreshAsync()
         {
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_refresh_pool_ledger(
@@ -238,7 +238,7 @@ namespace Hyperledger.Indy.PoolApi
         {
             _requiresClose = false;
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_close_pool_ledger(
@@ -269,7 +269,7 @@ namespace Hyperledger.Indy.PoolApi
         /// </c></param> 
         public static Task SetProtocolVersionAsync(int protocolVersion)
         {
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_set_protocol_version(
@@ -1,5 +1,4 @@
 ﻿using System.Collections.Concurrent;
-using System.Collections.Generic;
 using System.Diagnostics;
 using System.Threading;
 using System.Threading.Tasks;
@@ -26,9 +25,36 @@ namespace Hyperledger.Indy.Utils
         }
 
         /// <summary>
-        /// Gets the map of command handles and their task completion sources.
+        /// Map of command handles and their task completion sources for a single result type.
         /// </summary>
-        private static IDictionary<int, object> _taskCompletionSources = new ConcurrentDictionary<int, object>();
+        /// <remarks>
+        /// Keeping one map per result type lets callbacks get the strongly typed source back
+        /// with a single lookup and without casting.
+        /// </remarks>
+        /// <typeparam name="T">The type of the TaskCompletionSource result.</typeparam>
+        private static class Pending<T>
+        {
+            public static readonly ConcurrentDictionary<int, TaskCompletionSource<T>> TaskCompletionSources = new ConcurrentDictionary<int, TaskCompletionSource<T>>();
+        }
+
+        /// <summary>
+        /// Creates a new TaskCompletionSource for a command.
+        /// </summary>
+        /// <remarks>
+        /// Commands are completed from callbacks invoked on libindy's own threads.  The returned
+        /// source runs continuations asynchronously so code awaiting the task never executes on,
+        /// and never blocks, the libindy thread that completed it.
+        /// </remarks>
+        /// <typeparam name="T">The type of the TaskCompletionSource result.</typeparam>
+        /// <returns>A new TaskCompletionSource.</returns>
+        public static TaskCompletionSource<T> CreateTaskCompletionSource<T>()
+        {
+#if NET452
+            return new TaskCompletionSource<T>();
+#else
+            return new TaskCompletionSource<T>(TaskCreationOptions.RunContinuationsAsynchronously);
+#endif
+        }
 
         /// <summary>
         /// Adds a new TaskCompletionSource to track.
@@ -41,7 +67,7 @@ namespace Hyperledger.Indy.Utils
             Debug.Assert(taskCompletionSource != null, "A task completion source is required.");
 
             var commandHandle = GetNextCommandHandle();
-            _taskCompletionSources.Add(commandHandle, taskCompletionSource);
+            Pending<T>.TaskCompletionSources[commandHandle] = taskCompletionSource;
             return commandHandle;
         }
 
@@ -53,13 +79,10 @@ namespace Hyperledger.Indy.Utils
         /// <returns>The TaskCompletionResult associated with the command handle.</returns>
         public static TaskCompletionSource<T> Remove<T>(int commandHandle)
         {
-            Debug.Assert(_taskCompletionSources.ContainsKey(commandHandle), string.Format("No task completion source is currently registered for the command with the handle '{0}'.", commandHandle));
-
-            var taskCompletionSource = _taskCompletionSources[commandHandle];
-            _taskCompletionSources.Remove(commandHandle);
-            var result = taskCompletionSource as TaskCompletionSource<T>;
+            TaskCompletionSource<T> result;
+            var removed = Pending<T>.TaskCompletionSources.TryRemove(commandHandle, out result);
 
-            Debug.Assert(result != null, string.Format("No  task completion source of the specified type is registered for the command with the handle '{0}'.", commandHandle));
+            Debug.Assert(removed, string.Format("No task completion source of the specified type is registered for the command with the handle '{0}'.", commandHandle));
 
             return result;
         }
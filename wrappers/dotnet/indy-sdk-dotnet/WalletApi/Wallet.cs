@@ -88,7 +88,7 @@ namespace Hyperledger.Indy.WalletApi
             ParamGuard.NotNullOrWhiteSpace(config, "config");
             ParamGuard.NotNullOrWhiteSpace(credentials, "credentials");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_create_wallet(
@@ -145,7 +145,7 @@ namespace Hyperledger.Indy.WalletApi
             ParamGuard.NotNullOrWhiteSpace(config, "config");
             ParamGuard.NotNullOrWhiteSpace(credentials, "credentials");
 
-            var taskCompletionSource = new TaskCompletionSource<Wallet>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<Wallet>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_open_wallet(
@@ -180,7 +180,7 @@ namespace Hyperledger.Indy.WalletApi
         {
             ParamGuard.NotNullOrWhiteSpace(exportConfig, "exportConfig");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_export_wallet(
@@ -250,7 +250,7 @@ namespace Hyperledger.Indy.WalletApi
             ParamGuard.NotNullOrWhiteSpace(credentials, "credentials");
             ParamGuard.NotNullOrWhiteSpace(importConfig, "importConfig");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_import_wallet(
@@ -286,7 +286,7 @@ namespace Hyperledger.Indy.WalletApi
             ParamGuard.NotNullOrWhiteSpace(config, "config");
             ParamGuard.NotNullOrWhiteSpace(credentials, "credentials");
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_delete_wallet(
@@ -314,7 +314,7 @@ namespace Hyperledger.Indy.WalletApi
         /// }</param>
         public static Task<string> GenerateWalletKeyAsync(string config)
         {
-            var taskCompletionSource = new TaskCompletionSource<string>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<string>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_generate_wallet_key(
@@ -356,7 +356,7 @@ namespace Hyperledger.Indy.WalletApi
         {
             IsOpen = false;
 
-            var taskCompletionSource = new TaskCompletionSource<bool>();
+            var taskCompletionSource = PendingCommands.CreateTaskCompletionSource<bool>();
             var commandHandle = PendingCommands.Add(taskCompletionSource);
 
             var result = NativeMethods.indy_close_wallet(
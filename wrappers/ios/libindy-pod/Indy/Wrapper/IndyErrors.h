@@ -55,6 +55,9 @@ typedef NS_ENUM(NSInteger, IndyErrorCode)
     // Caller passed invalid value as param 14 (null, invalid json and etc..)
     CommonInvalidParam14 = 116,
 
+    // Command was rejected because the command queue is full
+    CommonCommandQueueFull = 130,
+
     // Wallet errors
     // Caller passed invalid wallet handle
     WalletInvalidHandle = 200,
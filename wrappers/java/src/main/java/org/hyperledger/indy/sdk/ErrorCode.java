@@ -100,6 +100,11 @@ public enum ErrorCode {
 	 */
 	CommonInvalidParam14(116),
 
+	/**
+	 * Command was rejected because the command queue is full
+	 */
+	CommonCommandQueueFull(130),
+
 	// Wallet errors
 	 
 	/**
@@ -5,6 +5,9 @@ import java.util.Iterator;
 import java.util.Map;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.RejectedExecutionException;
 import java.util.concurrent.atomic.AtomicInteger;
 
 import org.apache.commons.lang3.builder.EqualsBuilder;
@@ -33,6 +36,17 @@ public class IndyJava {
 
 		private static AtomicInteger atomicInteger = new AtomicInteger();
 		private static Map<Integer, CompletableFuture<?>> futures = new ConcurrentHashMap<Integer, CompletableFuture<?>>();
+		private static volatile Executor completionExecutor = ForkJoinPool.commonPool();
+
+		/**
+		 * Sets the executor used to complete futures returned by the API.
+		 *
+		 * @param executor The executor, or null to complete futures directly on the libindy callback thread.
+		 */
+		static void setCompletionExecutor(Executor executor) {
+
+			completionExecutor = executor;
+		}
 
 		/**
 		 * Generates and returns a new command handle.
@@ -70,7 +84,45 @@ public class IndyJava {
 			CompletableFuture<?> future = futures.remove(Integer.valueOf(xcommand_handle));
 			assert (future != null);
 
-			return future;
+			Executor executor = completionExecutor;
+			if (executor == null) return future;
+
+			return relay(future, executor);
+		}
+
+		/**
+		 * Returns a future that, once completed, completes the target future on the executor.
+		 *
+		 * Callbacks run on libindy's command thread. Completing the caller's future there would also run
+		 * every synchronous stage the caller chained to it and stall all other libindy commands.
+		 *
+		 * @param target   The future returned to the caller.
+		 * @param executor The executor to complete the target future on.
+		 * @return The future for the callback to complete.
+		 */
+		@SuppressWarnings("unchecked")
+		private static CompletableFuture<?> relay(CompletableFuture<?> target, Executor executor) {
+
+			CompletableFuture<Object> source = new CompletableFuture<Object>();
+			CompletableFuture<Object> future = (CompletableFuture<Object>) target;
+
+			source.whenComplete((result, ex) -> {
+
+				Runnable complete = () -> {
+					if (ex != null) future.completeExceptionally(ex);
+					else future.complete(result);
+				};
+
+				try {
+
+					executor.execute(complete);
+				} catch (RejectedExecutionException e) {
+
+					complete.run();
+				}
+			});
+
+			return source;
 		}
 
 		/*
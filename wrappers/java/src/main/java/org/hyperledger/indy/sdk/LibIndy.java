@@ -6,6 +6,7 @@ import com.sun.jna.ptr.PointerByReference;
 import java.io.File;
 import java.util.HashMap;
 import java.util.Map;
+import java.util.concurrent.Executor;
 
 import static com.sun.jna.Native.detach;
 
@@ -220,6 +221,37 @@ public abstract class LibIndy {
 		}
 	}
 
+	/**
+	 * Direct mapped signatures for the most frequently called SDK functions.
+	 *
+	 * Calls through {@link API} go through a JNA proxy that resolves the method and converts every
+	 * argument reflectively on each call. Direct mapped methods are bound once at initialization.
+	 */
+	public static class Direct {
+
+		// ledger.rs
+
+		public static native int indy_sign_and_submit_request(int command_handle, int pool_handle, int wallet_handle, String submitter_did, String request_json, Callback cb);
+		public static native int indy_submit_request(int command_handle, int pool_handle, String request_json, Callback cb);
+		public static native int indy_sign_request(int command_handle, int wallet_handle, String submitter_did, String request_json, Callback cb);
+		public static native int indy_multi_sign_request(int command_handle, int wallet_handle, String submitter_did, String request_json, Callback cb);
+		public static native int indy_build_nym_request(int command_handle, String submitter_did, String target_did, String verkey, String alias, String role, Callback cb);
+		public static native int indy_build_attrib_request(int command_handle, String submitter_did, String target_did, String hash, String raw, String enc, Callback cb);
+		public static native int indy_build_get_nym_request(int command_handle, String submitter_did, String target_did, Callback cb);
+
+		// did.rs
+
+		public static native int indy_create_and_store_my_did(int command_handle, int wallet_handle, String did_json, Callback cb);
+		public static native int indy_key_for_local_did(int command_handle, int wallet_handle, String did, Callback cb);
+
+		// crypto.rs
+
+		public static native int indy_create_key(int command_handle, int wallet_handle, String key_json, Callback cb);
+		public static native int indy_crypto_sign(int command_handle, int wallet_handle, String my_vk, byte[] message_raw, int message_len, Callback cb);
+		public static native int indy_pack_message(int command_handle, int wallet_handle, byte[] message, int message_len, String receiver_keys, String sender, Callback cb);
+		public static native int indy_unpack_message(int command_handle, int wallet_handle, byte[] jwe_data, int jwe_len, Callback cb);
+	}
+
 	/*
 	 * Initialization
 	 */
@@ -261,6 +293,7 @@ public abstract class LibIndy {
 		options.put(Library.OPTION_TYPE_MAPPER, MAPPER);
 
 		api = Native.loadLibrary(file.getAbsolutePath(), API.class, options);
+		Native.register(Direct.class, NativeLibrary.getInstance(file.getAbsolutePath(), options));
 		initLogger();
 	}
 
@@ -272,6 +305,7 @@ public abstract class LibIndy {
 		options.put(Library.OPTION_TYPE_MAPPER, MAPPER);
 
 		api = Native.loadLibrary(LIBRARY_NAME, API.class, options);
+		Native.register(Direct.class, NativeLibrary.getInstance(LIBRARY_NAME, options));
 		initLogger();
 	}
 
@@ -342,6 +376,19 @@ public abstract class LibIndy {
 		api.indy_set_logger_with_max_lvl(null, Logger.enabled, Logger.log, Logger.flush, logLevel);
 	}
 
+	/**
+	 * Sets the executor used to complete the futures returned by the API.
+	 *
+	 * By default futures are completed on {@link java.util.concurrent.ForkJoinPool#commonPool()}, so stages
+	 * chained to them never run on libindy's command thread. Passing null completes futures directly on
+	 * the libindy callback thread.
+	 *
+	 * @param executor The executor to complete futures on.
+	 */
+	public static void setCompletionExecutor(Executor executor) {
+		IndyJava.API.setCompletionExecutor(executor);
+	}
+
 	/**
 	 * Set libindy runtime configuration. Can be optionally called to change current params.
 	 *
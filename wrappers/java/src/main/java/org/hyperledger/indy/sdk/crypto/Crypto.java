@@ -215,7 +215,7 @@ public class Crypto extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_create_key(
+		int result = LibIndy.Direct.indy_create_key(
 				commandHandle,
 				walletHandle,
 				keyJson,
@@ -318,7 +318,7 @@ public class Crypto extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_crypto_sign(
+		int result = LibIndy.Direct.indy_crypto_sign(
 				commandHandle,
 				walletHandle,
 				signerVk,
@@ -585,7 +585,7 @@ public class Crypto extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_pack_message(
+		int result = LibIndy.Direct.indy_pack_message(
 				commandHandle,
 				walletHandle,
 				message,
@@ -636,7 +636,7 @@ public class Crypto extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_unpack_message(
+		int result = LibIndy.Direct.indy_unpack_message(
 				commandHandle,
 				walletHandle,
 				jwe_data,
@@ -263,7 +263,7 @@ public class Did extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_create_and_store_my_did(
+		int result = LibIndy.Direct.indy_create_and_store_my_did(
 				commandHandle,
 				walletHandle,
 				didJson,
@@ -454,7 +454,7 @@ public class Did extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_key_for_local_did(
+		int result = LibIndy.Direct.indy_key_for_local_did(
 				commandHandle,
 				walletHandle,
 				did,
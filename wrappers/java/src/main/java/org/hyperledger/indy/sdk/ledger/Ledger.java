@@ -179,7 +179,7 @@ public class Ledger extends IndyJava.API {
 		int poolHandle = pool.getPoolHandle();
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_sign_and_submit_request(
+		int result = LibIndy.Direct.indy_sign_and_submit_request(
 				commandHandle,
 				poolHandle,
 				walletHandle,
@@ -214,7 +214,7 @@ public class Ledger extends IndyJava.API {
 
 		int poolHandle = pool.getPoolHandle();
 
-		int result = LibIndy.api.indy_submit_request(
+		int result = LibIndy.Direct.indy_submit_request(
 				commandHandle,
 				poolHandle,
 				requestJson,
@@ -296,7 +296,7 @@ public class Ledger extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_sign_request(
+		int result = LibIndy.Direct.indy_sign_request(
 				commandHandle,
 				walletHandle,
 				submitterDid,
@@ -334,7 +334,7 @@ public class Ledger extends IndyJava.API {
 
 		int walletHandle = wallet.getWalletHandle();
 
-		int result = LibIndy.api.indy_multi_sign_request(
+		int result = LibIndy.Direct.indy_multi_sign_request(
 				commandHandle,
 				walletHandle,
 				submitterDid,
@@ -406,7 +406,7 @@ public class Ledger extends IndyJava.API {
 		CompletableFuture<String> future = new CompletableFuture<String>();
 		int commandHandle = addFuture(future);
 
-		int result = LibIndy.api.indy_build_nym_request(
+		int result = LibIndy.Direct.indy_build_nym_request(
 				commandHandle,
 				submitterDid,
 				targetDid,
@@ -445,7 +445,7 @@ public class Ledger extends IndyJava.API {
 		CompletableFuture<String> future = new CompletableFuture<String>();
 		int commandHandle = addFuture(future);
 
-		int result = LibIndy.api.indy_build_attrib_request(
+		int result = LibIndy.Direct.indy_build_attrib_request(
 				commandHandle,
 				submitterDid,
 				targetDid,
@@ -513,7 +513,7 @@ public class Ledger extends IndyJava.API {
 		CompletableFuture<String> future = new CompletableFuture<String>();
 		int commandHandle = addFuture(future);
 
-		int result = LibIndy.api.indy_build_get_nym_request(
+		int result = LibIndy.Direct.indy_build_get_nym_request(
 				commandHandle,
 				submitterDid,
 				targetDid,
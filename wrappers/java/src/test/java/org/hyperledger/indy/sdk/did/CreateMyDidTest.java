@@ -2,6 +2,7 @@ package org.hyperledger.indy.sdk.did;
 
 import org.hyperledger.indy.sdk.IndyIntegrationTestWithSingleWallet;
 import org.hyperledger.indy.sdk.InvalidStructureException;
+import org.hyperledger.indy.sdk.LibIndy;
 import org.hyperledger.indy.sdk.crypto.UnknownCryptoException;
 import org.hyperledger.indy.sdk.did.DidResults.CreateAndStoreMyDidResult;
 
@@ -11,7 +12,12 @@ import static org.junit.Assert.assertEquals;
 import org.bitcoinj.core.Base58;
 import org.junit.Test;
 
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ForkJoinPool;
 
 public class CreateMyDidTest extends IndyIntegrationTestWithSingleWallet {
 
@@ -51,4 +57,33 @@ public class CreateMyDidTest extends IndyIntegrationTestWithSingleWallet {
 		String didJson = new DidJSONParameters.CreateAndStoreMyDidJSONParameter(result.getDid(), null, null, null).toJson();
 		Did.createAndStoreMyDid(this.wallet, didJson).get();
 	}
+
+	@Test
+	public void testCreateMyDidCompletesOffLibindyThread() throws Exception {
+		ExecutorService executor = Executors.newSingleThreadExecutor();
+		CountDownLatch attached = new CountDownLatch(1);
+
+		try {
+			Thread executorThread = executor.submit(() -> Thread.currentThread()).get();
+
+			// Completion is queued behind this task, so the stage below is attached before the future completes
+			executor.execute(() -> {
+				try {
+					attached.await();
+				} catch (InterruptedException e) {
+					Thread.currentThread().interrupt();
+				}
+			});
+			LibIndy.setCompletionExecutor(executor);
+
+			CompletableFuture<Thread> completionThread = new CompletableFuture<Thread>();
+			Did.createAndStoreMyDid(this.wallet, "{}").whenComplete((result, ex) -> completionThread.complete(Thread.currentThread()));
+			attached.countDown();
+
+			assertEquals(executorThread, completionThread.get());
+		} finally {
+			LibIndy.setCompletionExecutor(ForkJoinPool.commonPool());
+			executor.shutdown();
+		}
+	}
 }
@@ -18,6 +18,7 @@ const errors = {
   114: 'CommonIOError',
   115: 'CommonInvalidParam13',
   116: 'CommonInvalidParam14',
+  130: 'CommonCommandQueueFull',
   200: 'WalletInvalidHandle',
   201: 'WalletUnknownTypeError',
   202: 'WalletTypeAlreadyRegisteredError',
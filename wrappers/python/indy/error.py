@@ -53,6 +53,9 @@ class ErrorCode(IntEnum):
     # IO Error
     CommonIOError = 114
 
+    # Command was rejected because the command queue is full
+    CommonCommandQueueFull = 130
+
     # Wallet errors
     # Caller passed invalid wallet handle
     WalletInvalidHandle = 200
@@ -239,6 +242,9 @@ class CommonInvalidStructure(IndyError):
 class CommonIOError(IndyError):
     """ IO Error """
 
+class CommonCommandQueueFull(IndyError):
+    """ Command was rejected because the command queue is full """
+
 # Wallet errors
 class WalletInvalidHandle(IndyError):
     """ Caller passed invalid wallet handle """
@@ -383,6 +389,7 @@ def errorcode_to_exception(errorcode):
         ErrorCode.CommonInvalidState: CommonInvalidState,
         ErrorCode.CommonInvalidStructure: CommonInvalidStructure,
         ErrorCode.CommonIOError: CommonIOError,
+        ErrorCode.CommonCommandQueueFull: CommonCommandQueueFull,
         # Wallet Errors
         ErrorCode.WalletInvalidHandle: WalletInvalidHandle,
         ErrorCode.WalletUnknownTypeError: WalletUnknownTypeError,
@@ -23,6 +23,13 @@ extern {
                                                        config_json: CString,
                                                        cb: Option<ResponseStringStringCB>) -> Error;
 
+    #[no_mangle]
+    pub fn indy_issuer_fill_credential_def_key_pool(command_handle: CommandHandle,
+                                                    wallet_handle: WalletHandle,
+                                                    schema_json: CString,
+                                                    config_json: CString,
+                                                    cb: Option<ResponseEmptyCB>) -> Error;
+
     #[no_mangle]
     pub fn indy_issuer_rotate_credential_def_start(command_handle: CommandHandle,
                                                    wallet_handle: WalletHandle,
@@ -52,6 +52,13 @@ extern {
                                      id: CString,
                                      cb: Option<ResponseEmptyCB>) -> Error;
 
+    #[no_mangle]
+    pub fn indy_delete_wallet_records(command_handle: CommandHandle,
+                                      wallet_handle: WalletHandle,
+                                      type_: CString,
+                                      query_json: CString,
+                                      cb: Option<ResponseU32CB>) -> Error;
+
     #[no_mangle]
     pub fn indy_get_wallet_record(command_handle: CommandHandle,
                                   wallet_handle: WalletHandle,
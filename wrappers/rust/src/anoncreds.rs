@@ -139,6 +139,40 @@ fn _issuer_create_and_store_credential_def(command_handle: CommandHandle, wallet
     })
 }
 
+/// Pre-generate credential definition keys for the given schema and keep them in the wallet.
+///
+/// `issuer_create_and_store_credential_def` takes keys from the pool when there are keys generated
+/// for the same schema attributes and `support_revocation` flag. The pool is refilled in the background.
+///
+/// # Arguments
+/// * `wallet_handle`: wallet handle (created by Wallet::open_wallet).
+/// * `schema_json`: credential schema as a json
+/// * `config_json`: key pool configuration as json:
+///     - support_revocation: whether keys support revocation (optional, default false)
+///     - size: number of keys to keep in the pool
+pub fn issuer_fill_credential_def_key_pool(wallet_handle: WalletHandle, schema_json: &str, config_json: &str) -> Box<dyn Future<Item=(), Error=IndyError>> {
+    let (receiver, command_handle, cb) = ClosureHandler::cb_ec();
+
+    let err = _issuer_fill_credential_def_key_pool(command_handle, wallet_handle, schema_json, config_json, cb);
+
+    ResultHandler::empty(command_handle, err, receiver)
+}
+
+fn _issuer_fill_credential_def_key_pool(command_handle: CommandHandle, wallet_handle: WalletHandle, schema_json: &str, config_json: &str, cb: Option<ResponseEmptyCB>) -> ErrorCode {
+    let schema_json = c_str!(schema_json);
+    let config_json = c_str!(config_json);
+
+    ErrorCode::from(unsafe {
+        anoncreds::indy_issuer_fill_credential_def_key_pool(
+            command_handle,
+            wallet_handle,
+            schema_json.as_ptr(),
+            config_json.as_ptr(),
+            cb
+        )
+    })
+}
+
 /// Generate temporary credential definitional keys for an existing one (owned by the caller of the library).
 ///
 /// Use `issuer_rotate_credential_def_apply` function to set generated temporary keys as the main.
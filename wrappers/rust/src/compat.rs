@@ -0,0 +1,47 @@
+//! Adapters for using the wrapper from `async`/`await` code.
+//!
+//! Every API function returns a futures 0.1 `Future`. `into_std` turns any of them into a
+//! `std::future::Future`, e.g.
+//!
+//! ```ignore
+//! let verkey = compat::into_std(did::key_for_local_did(wallet_handle, &did)).await?;
+//! ```
+
+use std::pin::Pin;
+use std::sync::Arc;
+use std::task::{Context, Poll, Waker};
+
+use futures::{Async, Future};
+use futures::executor::{self, Notify, NotifyHandle, Spawn};
+
+/// `std::future::Future` driving a futures 0.1 `Future`.
+pub struct StdFuture<F: Future> {
+    inner: Spawn<F>,
+}
+
+/// Converts a future returned by the wrapper into a `std::future::Future`.
+pub fn into_std<F: Future>(future: F) -> StdFuture<F> {
+    StdFuture { inner: executor::spawn(future) }
+}
+
+struct WakerNotify(Waker);
+
+impl Notify for WakerNotify {
+    fn notify(&self, _id: usize) {
+        self.0.wake_by_ref();
+    }
+}
+
+impl<F: Future + Unpin> ::std::future::Future for StdFuture<F> {
+    type Output = Result<F::Item, F::Error>;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context) -> Poll<Self::Output> {
+        let notify = NotifyHandle::from(Arc::new(WakerNotify(cx.waker().clone())));
+
+        match self.inner.poll_future_notify(&notify, 0) {
+            Ok(Async::Ready(item)) => Poll::Ready(Ok(item)),
+            Ok(Async::NotReady) => Poll::Pending,
+            Err(err) => Poll::Ready(Err(err))
+        }
+    }
+}
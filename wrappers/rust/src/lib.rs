@@ -31,6 +31,7 @@ pub mod pairwise;
 pub mod pool;
 pub mod wallet;
 pub mod cache;
+pub mod compat;
 pub mod metrics;
 mod utils;
 
@@ -179,6 +180,9 @@ pub enum ErrorCode
     // Caller passed invalid value as param 27 (null, invalid json and etc..)
     #[fail(display = "CommonInvalidParam27")]
     CommonInvalidParam27 = 129,
+    // Command was rejected because the command queue is full
+    #[fail(display = "CommonCommandQueueFull")]
+    CommonCommandQueueFull = 130,
     // Wallet errors
     // Caller passed invalid wallet handle
     #[fail(display = "WalletInvalidHandle")]
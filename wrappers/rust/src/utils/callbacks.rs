@@ -5,58 +5,50 @@ use ffi::{WalletHandle, CommandHandle};
 
 use libc::c_char;
 
-use std::collections::HashMap;
 use std::ffi::CStr;
-use std::sync::Mutex;
 
 use futures::*;
-use futures::sync::oneshot;
+
+use utils::completion::{CommandFuture, CommandSlots, NO_SLOT_HANDLE};
 
 lazy_static! {
-    static ref CALLBACKS_EMPTY: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(), IndyError>>>> = Default::default();
-    static ref CALLBACKS_SLICE: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<Vec<u8>, IndyError>>>> = Default::default();
-    static ref CALLBACKS_HANDLE: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<CommandHandle, IndyError>>>> = Default::default();
-    static ref CALLBACKS_WALLETHANDLE: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<WalletHandle, IndyError>>>> = Default::default();
-    static ref CALLBACKS_BOOL: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<bool, IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_SLICE: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, Vec<u8>), IndyError>>>> = Default::default();
-    static ref CALLBACKS_HANDLE_USIZE: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(CommandHandle, usize), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_STR_U64: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, String, u64), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<String, IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_I64: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, i64), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_STR: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, String), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_OPTSTR: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, Option<String>), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_STR_STR: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, String, String), IndyError>>>> = Default::default();
-    static ref CALLBACKS_STR_OPTSTR_OPTSTR: Mutex<HashMap<CommandHandle, oneshot::Sender<Result<(String, Option<String>, Option<String>), IndyError>>>> = Default::default();
+    static ref CALLBACKS_EMPTY: CommandSlots<()> = CommandSlots::new();
+    static ref CALLBACKS_SLICE: CommandSlots<Vec<u8>> = CommandSlots::new();
+    static ref CALLBACKS_HANDLE: CommandSlots<CommandHandle> = CommandSlots::new();
+    static ref CALLBACKS_WALLETHANDLE: CommandSlots<WalletHandle> = CommandSlots::new();
+    static ref CALLBACKS_BOOL: CommandSlots<bool> = CommandSlots::new();
+    static ref CALLBACKS_U32: CommandSlots<u32> = CommandSlots::new();
+    static ref CALLBACKS_STR_SLICE: CommandSlots<(String, Vec<u8>)> = CommandSlots::new();
+    static ref CALLBACKS_HANDLE_USIZE: CommandSlots<(CommandHandle, usize)> = CommandSlots::new();
+    static ref CALLBACKS_STR_STR_U64: CommandSlots<(String, String, u64)> = CommandSlots::new();
+    static ref CALLBACKS_STR: CommandSlots<String> = CommandSlots::new();
+    static ref CALLBACKS_STR_I64: CommandSlots<(String, i64)> = CommandSlots::new();
+    static ref CALLBACKS_STR_STR: CommandSlots<(String, String)> = CommandSlots::new();
+    static ref CALLBACKS_STR_OPTSTR: CommandSlots<(String, Option<String>)> = CommandSlots::new();
+    static ref CALLBACKS_STR_STR_STR: CommandSlots<(String, String, String)> = CommandSlots::new();
+    static ref CALLBACKS_STR_OPTSTR_OPTSTR: CommandSlots<(String, Option<String>, Option<String>)> = CommandSlots::new();
 }
 
 macro_rules! cb_ec {
     ($name:ident($($cr:ident:$crt:ty),*)->$rrt:ty, $cbs:ident, $res:expr) => (
-    pub fn $name() -> (sync::oneshot::Receiver<Result<$rrt, IndyError>>,
+    pub fn $name() -> (CommandFuture<$rrt>,
                           CommandHandle,
                           Option<extern fn(command_handle: CommandHandle, err: i32, $($crt),*)>) {
         extern fn callback(command_handle: CommandHandle, err: i32, $($cr:$crt),*) {
-            let tx = {
-                let mut callbacks = $cbs.lock().unwrap();
-                callbacks.remove(&command_handle).unwrap()
-            };
-
             let res = if err != 0 {
                 Err(IndyError::new(ErrorCode::from(err)))
             } else {
                 Ok($res)
             };
 
-            tx.send(res).unwrap();
+            $cbs.complete(command_handle, res);
         }
 
-        let (rx, command_handle) = {
-            let (tx, rx) = oneshot::channel();
-            let command_handle : CommandHandle = ::utils::sequence::SequenceUtils::get_next_id();
-            let mut callbacks = $cbs.lock().unwrap();
-            callbacks.insert(command_handle, tx);
-            (rx, command_handle)
-        };
-        (rx, command_handle, Some(callback))
+        let (rx, command_handle) = $cbs.register();
+
+        // Without a callback libindy rejects the command before it is executed
+        let cb = if command_handle != NO_SLOT_HANDLE { Some(callback as extern fn(CommandHandle, i32, $($crt),*)) } else { None };
+        (rx, command_handle, cb)
     }
     )
 }
@@ -107,21 +99,23 @@ impl ClosureHandler {
            (rust_str!(str), rust_slice!(data, len).to_owned()));
 
     cb_ec!(cb_ec_bool(b: bool)->bool, CALLBACKS_BOOL, b);
+
+    cb_ec!(cb_ec_u32(u: u32)->u32, CALLBACKS_U32, u);
 }
 
 macro_rules! result_handler {
     ($name:ident($res_type:ty), $map:ident) => (
     pub fn $name(command_handle: CommandHandle,
                  err: ErrorCode,
-                 rx: sync::oneshot::Receiver<Result<$res_type, IndyError>>) -> Box<dyn Future<Item=$res_type, Error= IndyError>> {
-        if err != ErrorCode::Success {
-            let mut callbacks = $map.lock().unwrap();
-            callbacks.remove(&command_handle).unwrap();
+                 rx: CommandFuture<$res_type>) -> Box<dyn Future<Item=$res_type, Error= IndyError>> {
+        if command_handle == NO_SLOT_HANDLE {
+            // The future already holds CommonCommandQueueFull
+            Box::new(rx)
+        } else if err != ErrorCode::Success {
+            $map.remove(command_handle);
             Box::new(future::err(IndyError::new(err)))
         } else {
-            Box::new(rx
-                .map_err(|_| panic!("channel error!"))
-                .and_then(|res| res))
+            Box::new(rx)
         }
     }
     )
@@ -135,6 +129,7 @@ impl ResultHandler {
     result_handler!(wallethandle(WalletHandle), CALLBACKS_WALLETHANDLE);
     result_handler!(slice(Vec<u8>), CALLBACKS_SLICE);
     result_handler!(bool(bool), CALLBACKS_BOOL);
+    result_handler!(u32(u32), CALLBACKS_U32);
     result_handler!(str(String), CALLBACKS_STR);
     result_handler!(str_i64((String, i64)), CALLBACKS_STR_I64);
     result_handler!(handle_usize((CommandHandle, usize)), CALLBACKS_HANDLE_USIZE);
@@ -161,7 +156,7 @@ mod test {
         let callback = cb.unwrap();
         callback(command_handle, 0, test_vec.as_ptr(), test_vec.len() as u32);
 
-        let slice1 = receiver.wait().unwrap().unwrap();
+        let slice1 = receiver.wait().unwrap();
         assert_eq!(test_vec, slice1);
     }
 
@@ -172,7 +167,7 @@ mod test {
         let callback = cb.unwrap();
         callback(command_handle, 0, CString::new("This is a test").unwrap().as_ptr(), null());
 
-        let (str1, str2) = receiver.wait().unwrap().unwrap();
+        let (str1, str2) = receiver.wait().unwrap();
         assert_eq!(str1, "This is a test".to_string());
         assert_eq!(str2, None);
     }
@@ -184,7 +179,7 @@ mod test {
         let callback = cb.unwrap();
         callback(command_handle, 0, CString::new("This is a test").unwrap().as_ptr(), CString::new("The second string has something").unwrap().as_ptr());
 
-        let (str1, str2) = receiver.wait().unwrap().unwrap();
+        let (str1, str2) = receiver.wait().unwrap();
         assert_eq!(str1, "This is a test".to_string());
         assert_eq!(str2, Some("The second string has something".to_string()));
     }
@@ -0,0 +1,402 @@
+//! Lock-free routing of libindy callbacks to the futures waiting for them.
+//!
+//! Each result shape owns a fixed table of slots. A pending command claims a free slot with a
+//! single compare-and-swap and the command handle passed to libindy encodes the slot index
+//! together with a generation counter, so the callback finds its future without any shared map
+//! or global lock. The only lock left is the per-command one shared by the callback and the
+//! single future waiting for it.
+//!
+//! Every slot keeps the generation of its command in an atomic tag. A callback owns the slot only
+//! after it swaps the tag of its own generation, so late or duplicate callbacks for a recycled
+//! handle never touch the command state of another command.
+//!
+//! Slots are allocated in pages when the pages allocated so far are all busy, so a table costs
+//! only its page pointers until commands of its shape are actually used. Pages live as long as
+//! the table.
+
+use {ErrorCode, IndyError};
+use ffi::CommandHandle;
+
+use std::pin::Pin;
+use std::ptr;
+use std::sync::{Arc, Mutex};
+use std::sync::atomic::{AtomicPtr, AtomicUsize, Ordering};
+use std::task::{Context, Poll, Waker};
+
+use futures::{Async, Future, Poll as Poll01};
+use futures::task::{self as task01, Task};
+
+const SLOT_INDEX_BITS: u32 = 15;
+const PAGE_BITS: u32 = 8;
+const PAGE_SIZE: usize = 1 << PAGE_BITS;
+const PAGES_COUNT: usize = SLOTS_COUNT / PAGE_SIZE;
+const SLOT_INDEX_MASK: usize = (1 << SLOT_INDEX_BITS) - 1;
+const GENERATION_MASK: usize = 0xFFFF;
+
+// Tags of slots that aren't bound to a generation. Generations are in 1..=GENERATION_MASK
+const FREE: usize = 0;
+const BUSY: usize = usize::MAX;
+
+/// Handle of a command that got no slot. Its future fails at once and no callback is passed to libindy.
+pub const NO_SLOT_HANDLE: CommandHandle = 0;
+
+/// Max number of commands of one result shape that may be pending at the same time.
+pub const SLOTS_COUNT: usize = 1 << SLOT_INDEX_BITS;
+
+enum Waiter {
+    Std(Waker),
+    Legacy(Task),
+}
+
+impl Waiter {
+    fn wake(self) {
+        match self {
+            Waiter::Std(waker) => waker.wake(),
+            Waiter::Legacy(task) => task.notify(),
+        }
+    }
+}
+
+struct CommandState<T> {
+    inner: Mutex<(Option<Result<T, IndyError>>, Option<Waiter>)>,
+}
+
+impl<T> CommandState<T> {
+    fn complete(&self, res: Result<T, IndyError>) {
+        let waiter = {
+            let mut inner = self.inner.lock().unwrap();
+            inner.0 = Some(res);
+            inner.1.take()
+        };
+
+        if let Some(waiter) = waiter {
+            waiter.wake();
+        }
+    }
+
+    fn take_or_wait(&self, waiter: Waiter) -> Option<Result<T, IndyError>> {
+        let mut inner = self.inner.lock().unwrap();
+
+        match inner.0.take() {
+            Some(res) => Some(res),
+            None => {
+                inner.1 = Some(waiter);
+                None
+            }
+        }
+    }
+}
+
+struct Slot<T> {
+    tag: AtomicUsize,
+    state: AtomicPtr<CommandState<T>>,
+}
+
+struct Page<T> {
+    slots: Box<[Slot<T>]>,
+}
+
+impl<T> Page<T> {
+    fn new() -> Page<T> {
+        Page {
+            slots: (0..PAGE_SIZE)
+                .map(|_| Slot { tag: AtomicUsize::new(FREE), state: AtomicPtr::new(ptr::null_mut()) })
+                .collect::<Vec<_>>()
+                .into_boxed_slice(),
+        }
+    }
+}
+
+/// Table of pending commands for a single result shape.
+pub struct CommandSlots<T> {
+    // Pages below `pages_count` are always allocated
+    pages: Box<[AtomicPtr<Page<T>>]>,
+    pages_count: AtomicUsize,
+    cursor: AtomicUsize,
+    generation: AtomicUsize,
+}
+
+impl<T> CommandSlots<T> {
+    pub fn new() -> CommandSlots<T> {
+        CommandSlots {
+            pages: (0..PAGES_COUNT)
+                .map(|_| AtomicPtr::new(ptr::null_mut()))
+                .collect::<Vec<_>>()
+                .into_boxed_slice(),
+            pages_count: AtomicUsize::new(0),
+            cursor: AtomicUsize::new(0),
+            generation: AtomicUsize::new(0),
+        }
+    }
+
+    /// Registers a new pending command and returns the future for its result together with
+    /// the command handle to pass to libindy.
+    ///
+    /// If all slots are taken by pending commands, returns `NO_SLOT_HANDLE` and the future that
+    /// fails with `CommonCommandQueueFull`.
+    pub fn register(&self) -> (CommandFuture<T>, CommandHandle) {
+        let generation = self.generation.fetch_add(1, Ordering::Relaxed) % GENERATION_MASK + 1;
+
+        let state = Arc::new(CommandState {
+            inner: Mutex::new((None, None)),
+        });
+
+        loop {
+            let pages_count = self.pages_count.load(Ordering::Acquire);
+            let capacity = pages_count * PAGE_SIZE;
+            let start = self.cursor.fetch_add(1, Ordering::Relaxed);
+
+            for i in 0..capacity {
+                let index = start.wrapping_add(i) % capacity;
+                let slot = self.slot(index).unwrap();
+
+                if slot.tag.compare_exchange(FREE, BUSY, Ordering::Acquire, Ordering::Relaxed).is_ok() {
+                    slot.state.store(Arc::into_raw(state.clone()) as *mut CommandState<T>, Ordering::Relaxed);
+                    slot.tag.store(generation, Ordering::Release);
+
+                    let command_handle = ((generation << SLOT_INDEX_BITS) | index) as CommandHandle;
+                    return (CommandFuture { state }, command_handle);
+                }
+            }
+
+            if pages_count == PAGES_COUNT {
+                break;
+            }
+
+            self.add_page(pages_count);
+        }
+
+        state.complete(Err(IndyError::new(ErrorCode::CommonCommandQueueFull)));
+        (CommandFuture { state }, NO_SLOT_HANDLE)
+    }
+
+    fn add_page(&self, pages_count: usize) {
+        let page = Box::into_raw(Box::new(Page::new()));
+
+        // Threads that found the same pages full race to add the next one, only one page is kept
+        if self.pages[pages_count].compare_exchange(ptr::null_mut(), page, Ordering::AcqRel, Ordering::Acquire).is_err() {
+            drop(unsafe { Box::from_raw(page) });
+        }
+
+        let _ = self.pages_count.compare_exchange(pages_count, pages_count + 1, Ordering::AcqRel, Ordering::Acquire);
+    }
+
+    fn slot(&self, index: usize) -> Option<&Slot<T>> {
+        let page = self.pages.get(index >> PAGE_BITS)?.load(Ordering::Acquire);
+
+        if page.is_null() {
+            return None;
+        }
+
+        unsafe { &*page }.slots.get(index & (PAGE_SIZE - 1))
+    }
+
+    /// Completes the pending command registered for the handle.
+    pub fn complete(&self, command_handle: CommandHandle, res: Result<T, IndyError>) {
+        if let Some(state) = self.take(command_handle) {
+            state.complete(res);
+        }
+    }
+
+    /// Forgets the pending command registered for the handle without completing it.
+    pub fn remove(&self, command_handle: CommandHandle) {
+        self.take(command_handle);
+    }
+
+    fn take(&self, command_handle: CommandHandle) -> Option<Arc<CommandState<T>>> {
+        let command_handle = command_handle as usize;
+        let index = command_handle & SLOT_INDEX_MASK;
+        let generation = command_handle >> SLOT_INDEX_BITS;
+
+        if generation == FREE || generation > GENERATION_MASK {
+            return None;
+        }
+
+        let slot = self.slot(index)?;
+
+        // Only one caller can swap the tag of the generation, it owns the slot till the tag is freed
+        slot.tag.compare_exchange(generation, BUSY, Ordering::Acquire, Ordering::Relaxed).ok()?;
+
+        let raw = slot.state.swap(ptr::null_mut(), Ordering::Relaxed);
+        slot.tag.store(FREE, Ordering::Release);
+
+        Some(unsafe { Arc::from_raw(raw) })
+    }
+}
+
+impl<T> Drop for CommandSlots<T> {
+    fn drop(&mut self) {
+        for page in self.pages.iter() {
+            let page = page.load(Ordering::Acquire);
+
+            if page.is_null() {
+                continue;
+            }
+
+            let page = unsafe { Box::from_raw(page) };
+
+            for slot in page.slots.iter() {
+                let raw = slot.state.load(Ordering::Acquire);
+
+                if !raw.is_null() {
+                    drop(unsafe { Arc::from_raw(raw) });
+                }
+            }
+        }
+    }
+}
+
+/// Result of a single pending libindy command.
+///
+/// Can be awaited as a `std::future::Future` or driven as a futures 0.1 `Future`.
+pub struct CommandFuture<T> {
+    state: Arc<CommandState<T>>,
+}
+
+impl<T> ::std::future::Future for CommandFuture<T> {
+    type Output = Result<T, IndyError>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context) -> Poll<Self::Output> {
+        match self.state.take_or_wait(Waiter::Std(cx.waker().clone())) {
+            Some(res) => Poll::Ready(res),
+            None => Poll::Pending
+        }
+    }
+}
+
+impl<T> Future for CommandFuture<T> {
+    type Item = T;
+    type Error = IndyError;
+
+    fn poll(&mut self) -> Poll01<T, IndyError> {
+        match self.state.take_or_wait(Waiter::Legacy(task01::current())) {
+            Some(res) => res.map(Async::Ready),
+            None => Ok(Async::NotReady)
+        }
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+
+    use std::thread;
+
+    #[test]
+    fn command_slots_complete_works() {
+        let slots: CommandSlots<u64> = CommandSlots::new();
+
+        let (future, command_handle) = slots.register();
+        assert!(command_handle > 0);
+
+        slots.complete(command_handle, Ok(42));
+
+        assert_eq!(42, future.wait().unwrap());
+    }
+
+    #[test]
+    fn command_slots_complete_works_for_error() {
+        let slots: CommandSlots<u64> = CommandSlots::new();
+
+        let (future, command_handle) = slots.register();
+
+        slots.complete(command_handle, Err(IndyError::new(ErrorCode::CommonInvalidStructure)));
+
+        assert_eq!(ErrorCode::CommonInvalidStructure, future.wait().unwrap_err().error_code);
+    }
+
+    #[test]
+    fn command_slots_complete_works_for_stale_handle() {
+        let slots: CommandSlots<u64> = CommandSlots::new();
+
+        let (_future, command_handle) = slots.register();
+        slots.remove(command_handle);
+
+        let (future, other_command_handle) = slots.register();
+        assert_ne!(command_handle, other_command_handle);
+
+        slots.complete(command_handle, Ok(1));
+        slots.complete(other_command_handle, Ok(2));
+
+        assert_eq!(2, future.wait().unwrap());
+    }
+
+    #[test]
+    fn command_slots_complete_works_for_duplicate_callbacks() {
+        let slots: Arc<CommandSlots<usize>> = Arc::new(CommandSlots::new());
+
+        let (_future, command_handle) = slots.register();
+
+        let threads: Vec<_> = (0..8).map(|i| {
+            let slots = slots.clone();
+            thread::spawn(move || slots.complete(command_handle, Ok(i)))
+        }).collect();
+
+        for thread in threads {
+            thread.join().unwrap();
+        }
+
+        assert!(slots.take(command_handle).is_none());
+        assert!(slots.take(NO_SLOT_HANDLE).is_none());
+    }
+
+    #[test]
+    fn command_slots_register_works_for_pages_allocated_on_demand() {
+        let slots: CommandSlots<u64> = CommandSlots::new();
+        assert_eq!(0, slots.pages_count.load(Ordering::Relaxed));
+
+        let pending: Vec<_> = (0..PAGE_SIZE).map(|_| slots.register()).collect();
+        assert_eq!(1, slots.pages_count.load(Ordering::Relaxed));
+
+        let (_future, command_handle) = slots.register();
+        assert_eq!(2, slots.pages_count.load(Ordering::Relaxed));
+        slots.remove(command_handle);
+
+        // freed slots are reused before another page is added
+        for (_future, command_handle) in pending {
+            slots.remove(command_handle);
+        }
+
+        let _pending: Vec<_> = (0..PAGE_SIZE * 2).map(|_| slots.register()).collect();
+        assert_eq!(2, slots.pages_count.load(Ordering::Relaxed));
+    }
+
+    #[test]
+    fn command_slots_register_works_for_full_table() {
+        let slots: CommandSlots<u64> = CommandSlots::new();
+
+        let pending: Vec<_> = (0..SLOTS_COUNT).map(|_| slots.register()).collect();
+
+        let (future, command_handle) = slots.register();
+        assert_eq!(NO_SLOT_HANDLE, command_handle);
+        assert_eq!(ErrorCode::CommonCommandQueueFull, future.wait().unwrap_err().error_code);
+
+        slots.complete(pending[0].1, Ok(1));
+        let (_future, command_handle) = slots.register();
+        assert_ne!(NO_SLOT_HANDLE, command_handle);
+    }
+
+    #[test]
+    fn command_slots_complete_works_for_concurrent_commands() {
+        let slots: Arc<CommandSlots<usize>> = Arc::new(CommandSlots::new());
+
+        let threads: Vec<_> = (0..8).map(|t| {
+            let slots = slots.clone();
+            thread::spawn(move || {
+                for i in 0..1_000 {
+                    let (future, command_handle) = slots.register();
+
+                    let completer = slots.clone();
+                    let value = t * 1_000 + i;
+                    thread::spawn(move || completer.complete(command_handle, Ok(value)));
+
+                    assert_eq!(value, future.wait().unwrap());
+                }
+            })
+        }).collect();
+
+        for thread in threads {
+            thread.join().unwrap();
+        }
+    }
+}
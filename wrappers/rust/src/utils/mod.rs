@@ -1,3 +1,3 @@
 pub mod callbacks;
+pub mod completion;
 pub mod ctypes;
-pub mod sequence;
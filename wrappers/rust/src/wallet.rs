@@ -11,6 +11,7 @@ use ffi::{wallet, non_secrets};
 use ffi::{ResponseEmptyCB,
           ResponseStringCB,
           ResponseI32CB,
+          ResponseU32CB,
           ResponseWalletHandleCB};
 use {CommandHandle, WalletHandle, SearchHandle};
 
@@ -499,6 +500,32 @@ fn _delete_wallet_record(command_handle: CommandHandle, wallet_handle: WalletHan
     })
 }
 
+/// Delete all wallet records of the type matching the query
+///
+/// # Arguments
+/// * `wallet_handle` - wallet handle (created by open_wallet)
+/// * `xtype` - record type
+/// * `query_json` - MongoDB style query to wallet record tags (the same as for open_search)
+///
+/// # Returns
+/// The number of deleted records
+pub fn delete_wallet_records(wallet_handle: WalletHandle, xtype: &str, query_json: &str) -> Box<dyn Future<Item=u32, Error=IndyError>> {
+    let (receiver, command_handle, cb) = ClosureHandler::cb_ec_u32();
+
+    let err = _delete_wallet_records(command_handle, wallet_handle, xtype, query_json, cb);
+
+    ResultHandler::u32(command_handle, err, receiver)
+}
+
+fn _delete_wallet_records(command_handle: CommandHandle, wallet_handle: WalletHandle, xtype: &str, query_json: &str, cb: Option<ResponseU32CB>) -> ErrorCode {
+    let xtype = c_str!(xtype);
+    let query_json = c_str!(query_json);
+
+    ErrorCode::from(unsafe {
+      non_secrets::indy_delete_wallet_records(command_handle, wallet_handle, xtype.as_ptr(), query_json.as_ptr(), cb)
+    })
+}
+
 /// Get an wallet record by id
 ///
 /// # Arguments